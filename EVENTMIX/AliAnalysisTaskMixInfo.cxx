@@ -131,6 +131,10 @@ void AliAnalysisTaskMixInfo::UserExecMix(Option_t *)
       AliError("Mix entry is -1 and it should not happen !!!!!");
       return ;
    }
+   if (!fInputEHMix->GetMixedEvent(0)) {
+      AliError("Mixed event is not available !!!!!");
+      return ;
+   }
    AliDebug(AliLog::kDebug, Form("Mixing %lld %d [%lld,%lld] %d", fInputEHMix->CurrentEntry(), fInputEHMix->CurrentBinIndex(), fInputEHMix->CurrentEntryMain(), fInputEHMix->CurrentEntryMix(), fInputEHMix->NumberMixed()));
    if (AliLog::GetDebugLevel("", IsA()->GetName()) > AliLog::kDebug) PrintEventInfo();
    // Post output data.
@@ -229,12 +233,10 @@ void AliAnalysisTaskMixInfo::PrintEventInfo()
       TObjArrayIter next(fInputEHMix->GetEventPool()->GetListOfEventCuts());
       AliMixEventCutObj *cut;
       AliInputEventHandler *ihMain = fInputEHMain->GetFirstInputEventHandler();
-      AliMultiInputEventHandler *ihMultiMix = fInputEHMix->GetFirstMultiInputHandler();
-      AliInputEventHandler *ihMix = 0;
-      if (ihMultiMix) ihMix = ihMultiMix->GetFirstInputEventHandler();
-      if (!ihMix) return;
+      AliVEvent *evMix = fInputEHMix->GetMixedEvent(0);
+      if (!evMix) return;
       while ((cut = (AliMixEventCutObj *) next())) {
-         cut->PrintValues(ihMain->GetEvent(), ihMix->GetEvent());
+         cut->PrintValues(ihMain->GetEvent(), evMix);
       }
    }
 }
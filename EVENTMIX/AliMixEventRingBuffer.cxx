@@ -0,0 +1,238 @@
+//
+// Class AliMixEventRingBuffer
+//
+// Ring buffer of slim copies of events used for mixing.
+// Only the objects (branches) of the event which are
+// requested are copied. Events are identified by their
+// entry number as stored in the event pool entry lists.
+// Copies are self-contained: references (TRef, TRefArray)
+// to objects of the input event are cleared and pointers
+// of tracks to their event are set to the slim event.
+//
+
+#include <map>
+#include <vector>
+
+#include <TClass.h>
+#include <TClonesArray.h>
+#include <TCollection.h>
+#include <TDataMember.h>
+#include <TList.h>
+#include <TRealData.h>
+#include <TRef.h>
+#include <TRefArray.h>
+
+#include "AliLog.h"
+#include "AliVEvent.h"
+#include "AliAODEvent.h"
+#include "AliAODTrack.h"
+#include "AliESDEvent.h"
+
+#include "AliMixEventRingBuffer.h"
+
+ClassImp(AliMixEventRingBuffer)
+
+namespace {
+   enum EReferenceType { kRef, kRefArray, kRefArrayPointer };
+   typedef std::vector<std::pair<Long_t, Int_t> > ReferenceMembers_t;
+
+   const ReferenceMembers_t &GetReferenceMembers(TClass *cl)
+   {
+      //
+      // Returns offsets and types of all reference members (TRef, TRefArray)
+      // of class 'cl', including base classes and embedded objects
+      //
+      static std::map<TClass *, ReferenceMembers_t> members;
+      std::map<TClass *, ReferenceMembers_t>::iterator found = members.find(cl);
+      if (found != members.end()) return found->second;
+      ReferenceMembers_t &refs = members[cl];
+      if (!cl->GetListOfRealData()) cl->BuildRealData();
+      TIter next(cl->GetListOfRealData());
+      TRealData *rd = 0;
+      while ((rd = (TRealData *) next())) {
+         TDataMember *dm = rd->GetDataMember();
+         if (!dm) continue;
+         TString type = dm->GetTypeName();
+         Int_t type_id = -1;
+         if (type == "TRef" && !dm->IsaPointer()) type_id = kRef;
+         else if (type == "TRefArray") type_id = dm->IsaPointer() ? kRefArrayPointer : kRefArray;
+         if (type_id < 0) continue;
+         Int_t n = 1;
+         for (Int_t i = 0; i < dm->GetArrayDim(); i++) n *= dm->GetMaxIndex(i);
+         Long_t size = dm->IsaPointer() ? sizeof(TRefArray *) : (type_id == kRef ? sizeof(TRef) : sizeof(TRefArray));
+         for (Int_t i = 0; i < n; i++) refs.push_back(std::make_pair(rd->GetThisOffset() + i * size, type_id));
+      }
+      return refs;
+   }
+}
+
+//_________________________________________________________________________________________________
+AliMixEventRingBuffer::AliMixEventRingBuffer(Int_t depth) : TObject(),
+   fDepth(depth > 0 ? depth : 1),
+   fN(0),
+   fNext(0),
+   fEvents(depth > 0 ? depth : 1),
+   fEntries(depth > 0 ? depth : 1)
+{
+   //
+   // Default constructor.
+   //
+   fEvents.SetOwner(kTRUE);
+   fEntries.Reset(-1);
+}
+
+//_________________________________________________________________________________________________
+AliMixEventRingBuffer::~AliMixEventRingBuffer()
+{
+   //
+   // Destructor
+   //
+   fEvents.Delete();
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRingBuffer::Clear(Option_t *)
+{
+   //
+   // Removes all events
+   //
+   fEvents.Delete();
+   fEntries.Reset(-1);
+   fN = 0;
+   fNext = 0;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRingBuffer::AddEvent(const AliVEvent *ev, Long64_t entry, const TCollection *branches)
+{
+   //
+   // Adds slim copy of event with given entry number.
+   // The oldest event is dropped when buffer is full.
+   //
+   if (!ev) return;
+   AliVEvent *slim = CreateSlimEvent(ev, branches);
+   if (!slim) return;
+
+   delete fEvents.RemoveAt(fNext);
+   fEvents.AddAt(slim, fNext);
+   fEntries.SetAt(entry, fNext);
+   fNext = (fNext + 1) % fDepth;
+   if (fN < fDepth) fN++;
+   AliDebug(AliLog::kDebug + 5, Form("Added entry %lld (%d/%d events)", entry, fN, fDepth));
+}
+
+//_________________________________________________________________________________________________
+AliVEvent *AliMixEventRingBuffer::FindEvent(Long64_t entry) const
+{
+   //
+   // Returns slim event with given entry number (0 if not in buffer)
+   //
+   if (entry < 0) return 0;
+   // search from the newest event, since partners are usually recent
+   for (Int_t i = 1; i <= fN; i++) {
+      Int_t slot = (fNext - i + fDepth) % fDepth;
+      if (fEntries.At(slot) == entry) return (AliVEvent *) fEvents.At(slot);
+   }
+   return 0;
+}
+
+//_________________________________________________________________________________________________
+AliVEvent *AliMixEventRingBuffer::CreateSlimEvent(const AliVEvent *ev, const TCollection *branches)
+{
+   //
+   // Creates event of the same type containing copies of the objects
+   // of event 'ev' whose names are in 'branches' (all objects if 'branches'
+   // is empty). Standard content pointers are set for the copied objects
+   // and tracks are connected to the slim event (see CloneSelfContained).
+   //
+   if (!ev || !ev->GetList()) return 0;
+   AliVEvent *slim = (AliVEvent *) ev->IsA()->New();
+   if (!slim) return 0;
+
+   TIter next(ev->GetList());
+   TObject *obj = 0;
+   while ((obj = next())) {
+      if (branches && branches->GetEntries() > 0 && !branches->FindObject(obj->GetName())) continue;
+      slim->AddObject(CloneSelfContained(obj));
+   }
+   slim->GetStdContent();
+   ConnectEvent(slim);
+   return slim;
+}
+
+//_________________________________________________________________________________________________
+TObject *AliMixEventRingBuffer::CloneSelfContained(const TObject *obj)
+{
+   //
+   // Returns copy of 'obj' which does not refer to objects of the input event.
+   // Objects referenced by TRef are cloned without being registered in the
+   // process table (the copy would take the place of the referenced original
+   // there), and references in the copy (TRef, TRefArray, also in elements
+   // of collections) are cleared, since their targets are not copied with it.
+   //
+   if (!obj) return 0;
+
+   // objects (and elements) which are referenced, their bit is restored after cloning
+   TObjArray referenced;
+   if (obj->TestBit(kIsReferenced)) referenced.Add(const_cast<TObject *>(obj));
+   if (obj->InheritsFrom(TCollection::Class())) {
+      TIter next((const TCollection *) obj);
+      TObject *el = 0;
+      while ((el = next())) {
+         if (el->TestBit(kIsReferenced)) referenced.Add(el);
+      }
+   }
+   for (Int_t i = 0; i < referenced.GetEntriesFast(); i++) referenced.UncheckedAt(i)->ResetBit(kIsReferenced);
+   TObject *copy = obj->Clone();
+   for (Int_t i = 0; i < referenced.GetEntriesFast(); i++) referenced.UncheckedAt(i)->SetBit(kIsReferenced);
+
+   ClearReferences(copy);
+   if (copy && copy->InheritsFrom(TCollection::Class())) {
+      TIter next((TCollection *) copy);
+      TObject *el = 0;
+      while ((el = next())) ClearReferences(el);
+   }
+   return copy;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRingBuffer::ClearReferences(TObject *obj)
+{
+   //
+   // Clears all TRef and TRefArray members of 'obj'
+   //
+   if (!obj) return;
+   const ReferenceMembers_t &refs = GetReferenceMembers(obj->IsA());
+   for (UInt_t i = 0; i < refs.size(); i++) {
+      char *address = (char *) obj + refs[i].first;
+      switch (refs[i].second) {
+         case kRef:
+            *((TRef *) address) = (TObject *) 0;
+            break;
+         case kRefArray:
+            ((TRefArray *) address)->Clear();
+            break;
+         case kRefArrayPointer:
+            if (*((TRefArray **) address)) (*((TRefArray **) address))->Clear();
+            break;
+      }
+   }
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRingBuffer::ConnectEvent(AliVEvent *ev)
+{
+   //
+   // Sets pointers of the copied tracks to the slim event
+   // (they point to no event after cloning)
+   //
+   AliAODEvent *aod = dynamic_cast<AliAODEvent *>(ev);
+   if (aod && aod->FindListObject("tracks")) {
+      for (Int_t i = 0; i < aod->GetNumberOfTracks(); i++) {
+         AliAODTrack *track = dynamic_cast<AliAODTrack *>(aod->GetTrack(i));
+         if (track) track->SetAODEvent(aod);
+      }
+   }
+   AliESDEvent *esd = dynamic_cast<AliESDEvent *>(ev);
+   if (esd && esd->FindListObject("Tracks")) esd->ConnectTracks();
+}
@@ -0,0 +1,53 @@
+//
+// Class AliMixEventRingBuffer
+//
+// Ring buffer of slim copies of events used for mixing.
+// Only the objects (branches) of the event which are
+// requested are copied. Events are identified by their
+// entry number as stored in the event pool entry lists.
+// Copies are self-contained: references (TRef, TRefArray)
+// to objects of the input event are cleared and pointers
+// of tracks to their event are set to the slim event.
+//
+#ifndef ALIMIXEVENTRINGBUFFER_H
+#define ALIMIXEVENTRINGBUFFER_H
+
+#include <TObject.h>
+#include <TObjArray.h>
+#include <TArrayL64.h>
+
+class TCollection;
+class AliVEvent;
+class AliMixEventRingBuffer : public TObject {
+
+public:
+   AliMixEventRingBuffer(Int_t depth = 10);
+   virtual ~AliMixEventRingBuffer();
+
+   void        AddEvent(const AliVEvent *ev, Long64_t entry, const TCollection *branches = 0);
+   AliVEvent  *FindEvent(Long64_t entry) const;
+   virtual void Clear(Option_t *opt = "");
+
+   Int_t       GetDepth() const { return fDepth; }
+   Int_t       GetN() const { return fN; }
+
+   static AliVEvent *CreateSlimEvent(const AliVEvent *ev, const TCollection *branches = 0);
+   static TObject   *CloneSelfContained(const TObject *obj);
+
+private:
+   Int_t       fDepth;       // maximum number of events kept
+   Int_t       fN;           // number of events currently kept
+   Int_t       fNext;        // slot which will be filled next (oldest event)
+   TObjArray   fEvents;      //! slim events (owned)
+   TArrayL64   fEntries;     // entry numbers of the events
+
+   static void       ClearReferences(TObject *obj);
+   static void       ConnectEvent(AliVEvent *ev);
+
+   AliMixEventRingBuffer(const AliMixEventRingBuffer &buffer);
+   AliMixEventRingBuffer &operator=(const AliMixEventRingBuffer &buffer);
+
+   ClassDef(AliMixEventRingBuffer, 1); // Ring buffer of slim events for mixing
+};
+
+#endif // ALIMIXEVENTRINGBUFFER_H
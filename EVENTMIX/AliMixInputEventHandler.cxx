@@ -11,12 +11,16 @@
 #include <TChain.h>
 #include <TChainElement.h>
 #include <TSystem.h>
+#include <TObjString.h>
+#include <TClass.h>
+#include <TMethod.h>
 
 #include "AliLog.h"
 #include "AliAnalysisManager.h"
 #include "AliInputEventHandler.h"
 
 #include "AliMixEventPool.h"
+#include "AliMixEventRingBuffer.h"
 #include "AliMixInputEventHandler.h"
 #include "AliMixInputHandlerInfo.h"
 
@@ -43,12 +47,23 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fCurrentBinIndex(-1),
    fOfflineTriggerMask(0),
    fCurrentMixEntry(),
-   fCurrentEntryMainTree(0)
+   fCurrentEntryMainTree(0),
+   fUseMixEventCache(kFALSE),
+   fMixEventCacheDepth(0),
+   fMixEventCacheBranches(),
+   fMixEventCache(),
+   fMixedEventsFromCache(),
+   fMixEventCacheHits(0),
+   fMixEventCacheMisses(0),
+   fMixEventCacheChecked(kFALSE),
+   fMixedEventRequested(kFALSE)
 {
    //
    // Default constructor.
    //
    AliDebug(AliLog::kDebug + 10, "<-");
+   fMixEventCacheBranches.SetOwner(kTRUE);
+   fMixEventCache.SetOwner(kTRUE);
    SetMixNumber(mixNum);
    AliDebug(AliLog::kDebug + 10, "->");
 }
@@ -59,6 +74,8 @@ AliMixInputEventHandler::~AliMixInputEventHandler() {
    // Destructor
    //
    fMixTrees.Clear();
+   fMixEventCache.Delete();
+   if (fUseMixEventCache) AliInfo(Form("Mixed events from cache: %lld, read from input: %lld", fMixEventCacheHits, fMixEventCacheMisses));
 }
 
 //_____________________________________________________________________________
@@ -192,6 +209,8 @@ Bool_t AliMixInputEventHandler::GetEntry()
    //
    AliDebug(AliLog::kDebug + 5, Form("<-"));
 
+   fMixedEventsFromCache.Clear();
+
    if (!fEventPool) {
       MixStd();
    }
@@ -229,6 +248,9 @@ Bool_t AliMixInputEventHandler::MixStd()
    // check for PhysSelection
    if (!IsEventCurrentSelected()) return kFALSE;
 
+   // keeps current event for mixing with next events (no pool -> one bin)
+   AddToMixEventCache(0, fEntryCounter, inEvHMain->GetEvent());
+
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
       AliDebug(AliLog::kDebug + 3, Form("-> fEntryCounter == 0"));
@@ -245,7 +267,6 @@ Bool_t AliMixInputEventHandler::MixStd()
    AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
    // reset mix number
    fNumberMixed = 0;
-   AliMixInputHandlerInfo *mihi = 0;
    Long64_t entryMix = 0, entryMixReal = 0;
    Int_t counter = 0;
    for (counter = 0; counter < mixNum; counter++) {
@@ -253,16 +274,16 @@ Bool_t AliMixInputEventHandler::MixStd()
       AliDebug(AliLog::kDebug + 5, Form("Handler[%d] entryMix %lld ", counter, entryMix));
       if (entryMix < 0) break;
       entryMixReal = entryMix;
-      mihi = (AliMixInputHandlerInfo *) fMixTrees.At(0);
       TChainElement *te = fMixIntupHandlerInfoTmp->GetEntryInTree(entryMix);
       if (!te) {
          AliError("te is null. this is error. tell to developer (#1)");
       } else {
-         if (fDoMixEventGetEntryAuto) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(0), fAnalysisType);
+         Bool_t fromCache = kFALSE;
+         if (fDoMixEventGetEntryAuto) fromCache = PrepareMixedEvent(0, 0, te, entryMix, entryMixReal);
          // runs UserExecMix for all tasks
          fNumberMixed++;
          UserExecMixAllTasks(fEntryCounter, 1, fEntryCounter, entryMixReal, fNumberMixed);
-         InputEventHandler(0)->FinishEvent();
+         if (!fromCache) InputEventHandler(0)->FinishEvent();
       }
    }
    AliDebug(AliLog::kDebug + 3, Form("fEntryCounter=%lld fMixEventNumber=%d", fEntryCounter, fNumberMixed));
@@ -307,6 +328,7 @@ Bool_t AliMixInputEventHandler::MixBuffer()
    TEntryList *el = 0;
    Int_t idEntryList = -1;
    if (fEventPool) el = fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList);
+   if (el) AddToMixEventCache(idEntryList, currentMainEntry, inEvHMain->GetEvent());
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
       AliDebug(AliLog::kDebug + 3, Form("-> fEntryCounter == 0"));
@@ -328,7 +350,6 @@ Bool_t AliMixInputEventHandler::MixBuffer()
       }
    }
 
-   AliMixInputHandlerInfo *mihi = 0;
    Long64_t entryMix = 0, entryMixReal = 0;
    Int_t counter = 0;
    AliInputEventHandler *eh = 0;
@@ -348,14 +369,13 @@ Bool_t AliMixInputEventHandler::MixBuffer()
          break;
       }
       entryMixReal = entryMix;
-      mihi = (AliMixInputHandlerInfo *) fMixTrees.At(counter);
       TChainElement *te = fMixIntupHandlerInfoTmp->GetEntryInTree(entryMix);
       if (!te) {
          AliError("te is null. this is error. tell to developer (#1)");
       } else {
          fCurrentMixEntry.Enter(entryMixReal);
          AliDebug(AliLog::kDebug + 3, Form("Preparing InputEventHandler(%d)", counter));
-         if (fDoMixEventGetEntryAuto) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(counter), fAnalysisType);
+         if (fDoMixEventGetEntryAuto) PrepareMixedEvent(idEntryList, counter, te, entryMix, entryMixReal);
          fNumberMixed++;
       }
       counter++;
@@ -407,6 +427,7 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
    Int_t idEntryList = -1;
    TEntryList *el = 0;
    if (fEventPool) el = fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList);
+   if (el) AddToMixEventCache(idEntryList, currentMainEntry, inEvHMain->GetEvent());
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
       // runs UserExecMix for all tasks, if needed
@@ -452,10 +473,8 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
    if (fDoMixExtra) {
       if (elNum <= 2 * fMixNumber + 1) mixNum = elNum + 1;
    }
-   AliMixInputHandlerInfo *mihi = 0;
    Long64_t entryMix = 0, entryMixReal = 0;
    Int_t counter = 0;
-   mihi = (AliMixInputHandlerInfo *) fMixTrees.At(0);
    // fills num for main events
    for (counter = 0; counter < mixNum; counter++) {
       fCurrentMixEntry.Reset();
@@ -471,11 +490,12 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
          AliError("te is null. this is error. tell to developer (#2)");
       } else {
          fCurrentMixEntry.Enter(entryMixReal);
-         if (fDoMixEventGetEntryAuto) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(0), fAnalysisType);
+         Bool_t fromCache = kFALSE;
+         if (fDoMixEventGetEntryAuto) fromCache = PrepareMixedEvent(idEntryList, 0, te, entryMix, entryMixReal);
          // runs UserExecMix for all tasks
          fNumberMixed++;
          UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, entryMixReal, fNumberMixed);
-         InputEventHandler(0)->FinishEvent();
+         if (!fromCache) InputEventHandler(0)->FinishEvent();
       }
    }
    AliDebug(AliLog::kDebug + 3, Form("fEntryCounter=%lld fMixEventNumber=%d", fEntryCounter, fNumberMixed));
@@ -491,6 +511,8 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithBuffer()
    //
    // Mix more events in buffer with mixing with history
    //
+   // not implemented, no mixed event may be taken from the mixing cache
+   fMixedEventsFromCache.Clear();
    AliWarning("Not implemented");
    return kFALSE;
 }
@@ -524,6 +546,9 @@ void AliMixInputEventHandler::UserExecMixAllTasks(Long64_t entryCounter, Int_t i
    //
    // Execute all task and sets mixing parameters
    //
+   // Tasks which do not take the mixed event via GetMixedEvent() would read
+   // the input handlers, which are not filled for events from the mixing cache.
+   Bool_t checkTasks = IsMixedEventFromCache();
    AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
    AliAnalysisTaskSE *mixTask = 0;
    TObjArrayIter next(mgr->GetTasks());
@@ -533,8 +558,33 @@ void AliMixInputEventHandler::UserExecMixAllTasks(Long64_t entryCounter, Int_t i
       fCurrentEntryMain = entryMainReal;
       fCurrentEntryMix = entryMixReal;
       fCurrentBinIndex = idEntryList;
-      if (entryMixReal >= 0) mixTask->UserExecMix("");
+      if (entryMixReal < 0) continue;
+      fMixedEventRequested = kFALSE;
+      mixTask->UserExecMix("");
+      if (!checkTasks || fMixedEventRequested) continue;
+      // task without own UserExecMix does not use mixed events
+      TMethod *userExecMix = mixTask->IsA()->GetMethodAllAny("UserExecMix");
+      if (!userExecMix || userExecMix->GetClass() == AliAnalysisTaskSE::Class()) continue;
+      AliError("=========================================================================================");
+      AliError(Form("Task %s (%s) does not take mixed events via AliMixInputEventHandler::GetMixedEvent().", mixTask->GetName(), mixTask->ClassName()));
+      AliError("Events from the mixing cache are not available in the input handlers.");
+      AliError(fMixEventCacheChecked ? "Mixing cache is switched off, mixed events of this entry may be wrong !!!" : "Mixing cache is switched off.");
+      AliError("=========================================================================================");
+      fUseMixEventCache = kFALSE;
+      fMixEventCache.Delete();
+      fMixedEventsFromCache.Clear();
+      checkTasks = kFALSE;
    }
+   if (checkTasks) fMixEventCacheChecked = kTRUE;
+}
+
+//_____________________________________________________________________________
+Bool_t AliMixInputEventHandler::IsMixedEventFromCache() const
+{
+   //
+   // Returns kTRUE if any of the current mixed events is taken from the mixing cache
+   //
+   return fUseMixEventCache && fMixedEventsFromCache.GetEntries() > 0;
 }
 
 //_____________________________________________________________________________
@@ -625,3 +675,86 @@ Bool_t AliMixInputEventHandler::GetEntryMixedEvent(Int_t id) {
 
    return kTRUE;
 }
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::AddMixEventCacheBranch(const char *name)
+{
+   //
+   // Adds name of event object (e.g. "header", "tracks", "vertices") which
+   // is copied to the mixing cache. If no name is added, all objects are copied.
+   //
+   if (!fMixEventCacheBranches.FindObject(name)) fMixEventCacheBranches.Add(new TObjString(name));
+}
+
+//_____________________________________________________________________________
+Int_t AliMixInputEventHandler::GetMixEventCacheDepth() const
+{
+   //
+   // Returns number of events kept per pool bin. Automatic depth
+   // covers all partners requested by the mixing methods (including
+   // extra mixing) and the current event.
+   //
+   if (fMixEventCacheDepth > 0) return fMixEventCacheDepth;
+   Int_t depth = 2 * fMixNumber + 2;
+   if (fBufferSize > depth) depth = fBufferSize;
+   return depth + 1;
+}
+
+//_____________________________________________________________________________
+AliVEvent *AliMixInputEventHandler::GetMixedEvent(Int_t id)
+{
+   //
+   // Returns mixed event with id (Should be used in UserExecMix() only).
+   // It is the event from the mixing cache when available, otherwise
+   // the event read by the input handler with id.
+   //
+   fMixedEventRequested = kTRUE;
+   if (fUseMixEventCache) {
+      AliVEvent *ev = (AliVEvent *) fMixedEventsFromCache.At(id);
+      if (ev) return ev;
+   }
+   AliInputEventHandler *ih = (AliInputEventHandler *) InputEventHandler(id);
+   return ih ? ih->GetEvent() : 0;
+}
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::AddToMixEventCache(Int_t binIndex, Long64_t entry, const AliVEvent *ev)
+{
+   //
+   // Adds slim copy of event to ring buffer of pool bin
+   //
+   if (!fUseMixEventCache || !fDoMixEventGetEntryAuto || !ev || binIndex < 0) return;
+   AliMixEventRingBuffer *buffer = (AliMixEventRingBuffer *) fMixEventCache.At(binIndex);
+   if (!buffer) {
+      buffer = new AliMixEventRingBuffer(GetMixEventCacheDepth());
+      fMixEventCache.AddAtAndExpand(buffer, binIndex);
+   }
+   buffer->AddEvent(ev, entry, &fMixEventCacheBranches);
+}
+
+//_____________________________________________________________________________
+Bool_t AliMixInputEventHandler::PrepareMixedEvent(Int_t binIndex, Int_t idHandler, TChainElement *te, Long64_t entryMix, Long64_t entryMixReal)
+{
+   //
+   // Prepares mixed event for input handler with id. Event is taken from
+   // mixing cache when it is there, otherwise it is read from input
+   // (entryMix is entry in tree, entryMixReal is entry in full chain).
+   // Until all mixing tasks are checked to take mixed events via
+   // GetMixedEvent(), the event is read from input as well.
+   // Returns kTRUE if event was taken from cache only (input handler not used).
+   //
+   if (fUseMixEventCache) {
+      AliMixEventRingBuffer *buffer = (binIndex >= 0) ? (AliMixEventRingBuffer *) fMixEventCache.At(binIndex) : 0;
+      AliVEvent *ev = buffer ? buffer->FindEvent(entryMixReal) : 0;
+      fMixedEventsFromCache.AddAtAndExpand(ev, idHandler);
+      if (ev) {
+         fMixEventCacheHits++;
+         if (fMixEventCacheChecked) return kTRUE;
+      } else {
+         fMixEventCacheMisses++;
+      }
+   }
+   AliMixInputHandlerInfo *mihi = (AliMixInputHandlerInfo *) fMixTrees.At(idHandler);
+   mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(idHandler), fAnalysisType);
+   return kFALSE;
+}
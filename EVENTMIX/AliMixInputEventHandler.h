@@ -13,6 +13,7 @@
 #include <TObjArray.h>
 #include <TEntryList.h>
 #include <TArrayI.h>
+#include <TList.h>
 
 #include <AliVEvent.h>
 
@@ -73,6 +74,15 @@ public:
 
    Bool_t                  GetEntryMainEvent();
    Bool_t                  GetEntryMixedEvent(Int_t idHandler=0);
+
+   // in-memory cache of slim events (tasks have to use GetMixedEvent(), otherwise the cache is switched off)
+   void                    SetUseMixEventCache(Bool_t b = kTRUE, Int_t depth = 0) { fUseMixEventCache = b; fMixEventCacheDepth = depth; }
+   void                    AddMixEventCacheBranch(const char *name);
+   Bool_t                  IsUsingMixEventCache() const { return fUseMixEventCache; }
+   Int_t                   GetMixEventCacheDepth() const;
+   Long64_t                GetNMixEventCacheHits() const { return fMixEventCacheHits; }
+   Long64_t                GetNMixEventCacheMisses() const { return fMixEventCacheMisses; }
+   AliVEvent              *GetMixedEvent(Int_t idHandler=0);
 protected:
 
    TObjArray               fMixTrees;              // buffer of input handlers
@@ -100,17 +110,30 @@ private:
    TEntryList fCurrentMixEntry;    //! array of mix entries currently used (user should touch)
    Long64_t fCurrentEntryMainTree; //! current entry in current tree (main event)
 
+   Bool_t    fUseMixEventCache;       // keep slim copies of events in memory instead of reading mixed events again
+   Int_t     fMixEventCacheDepth;     // number of events kept per pool bin (0 = automatic)
+   TList     fMixEventCacheBranches;  // names of event objects copied to the cache (empty = all)
+   TObjArray fMixEventCache;          //! ring buffers of slim events (one per pool bin)
+   TObjArray fMixedEventsFromCache;   //! mixed events taken from the cache (one per input handler)
+   Long64_t  fMixEventCacheHits;      //! number of mixed events taken from the cache
+   Long64_t  fMixEventCacheMisses;    //! number of mixed events read from input
+   Bool_t    fMixEventCacheChecked;   //! all mixing tasks were checked to take mixed events via GetMixedEvent()
+   Bool_t    fMixedEventRequested;    //! GetMixedEvent() was called by the current task
+
    virtual Bool_t          MixStd();
    virtual Bool_t          MixBuffer();
    virtual Bool_t          MixEventsMoreTimesWithOneEvent();
    virtual Bool_t          MixEventsMoreTimesWithBuffer();
 
    void                    UserExecMixAllTasks(Long64_t entryCounter, Int_t idEntryList, Long64_t entryMainReal, Long64_t entryMixReal, Int_t numMixed);
+   Bool_t                  IsMixedEventFromCache() const;
+   void                    AddToMixEventCache(Int_t binIndex, Long64_t entry, const AliVEvent *ev);
+   Bool_t                  PrepareMixedEvent(Int_t binIndex, Int_t idHandler, TChainElement *te, Long64_t entryMix, Long64_t entryMixReal);
 
    AliMixInputEventHandler(const AliMixInputEventHandler &handler);
    AliMixInputEventHandler &operator=(const AliMixInputEventHandler &handler);
 
-   ClassDef(AliMixInputEventHandler, 5)
+   ClassDef(AliMixInputEventHandler, 7)
 };
 
 #endif
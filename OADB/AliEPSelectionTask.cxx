@@ -54,7 +54,7 @@
 #include "AliAnalysisTaskSE.h"
 #include "AliBackgroundSelection.h"
 #include "AliESDUtils.h"
-#include "AliOADBContainer.h"
+#include "AliOADBCache.h"
 #include "AliAODMCHeader.h"
 #include "AliAODTrack.h"
 #include "AliVTrack.h"
@@ -84,9 +84,8 @@ AliAnalysisTaskSE(),
   fEtaGap(0.),
   fSplitMethod(0),
   fESDtrackCuts(0),
-  fEPContainer(0),
-  fQxContainer(0),
-  fQyContainer(0),
+  fEPFileName(),
+  fQFileName(),
   fSparseDist(0),
   fHruns(0),
   fQVector(0),
@@ -135,9 +134,8 @@ AliEPSelectionTask::AliEPSelectionTask(const char *name):
   fEtaGap(0.),
   fSplitMethod(0),
   fESDtrackCuts(0),
-  fEPContainer(0),
-  fQxContainer(0),
-  fQyContainer(0),
+  fEPFileName(),
+  fQFileName(),
   fSparseDist(0),
   fHruns(0),
   fQVector(0),
@@ -180,16 +178,12 @@ AliEPSelectionTask::~AliEPSelectionTask()
       delete fESDtrackCuts;
       fESDtrackCuts = 0;
   }
-  if (fUserphidist) {
+  if (fUserphidist || fPeriod.CompareTo("LHC10h")==0) {
     if (fPhiDist[0]) {
       delete fPhiDist[0];
       fPhiDist[0] = 0;
     }
   }
-  if (fEPContainer){
-      delete fEPContainer;
-      fEPContainer = 0;
-  }
   if (fPeriod.CompareTo("LHC11h")==0){
       for(Int_t i = 0; i < 4; i++) {
         if(fPhiDist[i]){
@@ -198,6 +192,7 @@ AliEPSelectionTask::~AliEPSelectionTask()
         }
       }
       if(fHruns) delete fHruns;
+      if(fSparseDist) delete fSparseDist;
   }
   if(fQDist[0] && fQDist[1]) {
     for(Int_t i = 0; i < 2; i++) {
@@ -745,7 +740,11 @@ void AliEPSelectionTask::SetPhiDist()
 
     if (fPeriod.CompareTo("LHC10h")==0)
        {
-        fPhiDist[0] = (TH1F*) fEPContainer->GetObject(fRunNumber, "Default");}
+        // the shared OADB object is rebinned below, work on a copy
+        const TObject* phiDist = AliOADBCache::Instance()->GetObject(fEPFileName, "epphidist", fRunNumber, "Default");
+        delete fPhiDist[0];
+        fPhiDist[0] = phiDist ? (TH1F*) phiDist->Clone() : 0;
+        if (fPhiDist[0]) fPhiDist[0]->SetDirectory(0);}
         else if(fPeriod.CompareTo("LHC11h")==0){
             Int_t runbin=fHruns->FindBin(fRunNumber);
             if (fHruns->GetBinContent(runbin) > 1){
@@ -821,8 +820,14 @@ void AliEPSelectionTask::SetQvectorDist()
 {
   if(!fUseRecentering) return;
   AliInfo(Form("Setting q vector distributions"));
-  fQDist[0] = (TProfile*) fQxContainer->GetObject(fRunNumber, "Default");
-  fQDist[1] = (TProfile*) fQyContainer->GetObject(fRunNumber, "Default");
+  // the shared OADB objects are rebinned below, work on copies
+  const TObject* qDist[2] = {AliOADBCache::Instance()->GetObject(fQFileName, "eprecentering.Qx", fRunNumber, "Default"),
+                             AliOADBCache::Instance()->GetObject(fQFileName, "eprecentering.Qy", fRunNumber, "Default")};
+  for(Int_t i = 0; i < 2; i++) {
+    delete fQDist[i];
+    fQDist[i] = qDist[i] ? (TProfile*) qDist[i]->Clone() : 0;
+    if (fQDist[i]) fQDist[i]->SetDirectory(0);
+  }
 
   if (!fQDist[0] || !fQDist[1]) {
     AliError(Form("Cannot find OADB q-vector distributions for run %d. Using default values (mean=0,rms=1).", fRunNumber));
@@ -918,13 +923,11 @@ void AliEPSelectionTask::SetOADBandPeriod()
            oadbfilename = (Form("%s/COMMON/EVENTPLANE/data/epphidist.root", AliAnalysisManager::GetOADBPath()));
            }
 
-       TFile foadb(oadbfilename);
-       if(!foadb.IsOpen()) AliFatal(Form("Cannot open OADB file %s", oadbfilename.Data()));
+       if(!AliOADBCache::Instance()->HasFile(oadbfilename)) AliFatal(Form("Cannot open OADB file %s", oadbfilename.Data()));
 
        AliInfo("Using Standard OADB");
-       fEPContainer = (AliOADBContainer*) foadb.Get("epphidist");
-       if (!fEPContainer) AliFatal("Cannot fetch OADB container for EP selection");
-       foadb.Close();
+       if (!AliOADBCache::Instance()->GetContainer(oadbfilename, "epphidist")) AliFatal("Cannot fetch OADB container for EP selection");
+       fEPFileName = oadbfilename;
        }
      }
 
@@ -934,13 +937,15 @@ void AliEPSelectionTask::SetOADBandPeriod()
       // if it's already set and custom class is required, we use the one provided by the user
 
       oadbfilename = (Form("%s/COMMON/EVENTPLANE/data/epphidist2011.root", AliAnalysisManager::GetOADBPath()));
-      TFile *foadb = TFile::Open(oadbfilename);
-      if(!foadb->IsOpen()) AliFatal(Form("Cannot open OADB file %s", oadbfilename.Data()));
+      if(!AliOADBCache::Instance()->HasFile(oadbfilename)) AliFatal(Form("Cannot open OADB file %s", oadbfilename.Data()));
 
       AliInfo("Using Standard OADB");
-      fSparseDist = (THnSparse*) foadb->Get("Default");
-      if (!fSparseDist) AliFatal("Cannot fetch OADB container for EP selection");
-      foadb->Close();
+      if (!fSparseDist) {
+        // the axis ranges of the THnSparse are changed in SetPhiDist, work on a copy
+        const TObject* sparseDist = AliOADBCache::Instance()->GetFileObject(oadbfilename, "Default");
+        if (!sparseDist) AliFatal("Cannot fetch OADB container for EP selection");
+        fSparseDist = (THnSparse*) sparseDist->Clone();
+      }
       if(!fHruns){
            fHruns = (TH1F*)fSparseDist->Projection(0); //projection on run axis;
            fHruns->SetName("runsHisto");
@@ -949,14 +954,12 @@ void AliEPSelectionTask::SetOADBandPeriod()
 
       if(fUseRecentering) {
 	oadbfilename = (Form("%s/COMMON/EVENTPLANE/data/eprecentering.root", AliAnalysisManager::GetOADBPath()));
-	TFile *foadb = TFile::Open(oadbfilename);
-	if(!foadb->IsOpen()) AliFatal(Form("Cannot open OADB file %s", oadbfilename.Data()));
+	if(!AliOADBCache::Instance()->HasFile(oadbfilename)) AliFatal(Form("Cannot open OADB file %s", oadbfilename.Data()));
 
 	AliInfo("Using Standard OADB");
-	fQxContainer = (AliOADBContainer*) foadb->Get("eprecentering.Qx");
-	fQyContainer = (AliOADBContainer*) foadb->Get("eprecentering.Qy");
-	if (!fQxContainer || !fQyContainer) AliFatal("Cannot fetch OADB container for EP recentering");
-	foadb->Close();
+	if (!AliOADBCache::Instance()->GetContainer(oadbfilename, "eprecentering.Qx") ||
+	    !AliOADBCache::Instance()->GetContainer(oadbfilename, "eprecentering.Qy")) AliFatal("Cannot fetch OADB container for EP recentering");
+	fQFileName = oadbfilename;
       }
 
      }
@@ -22,7 +22,6 @@ class AliESDEvent;
 class AliESDtrackCuts;
 class AliESDtrack;
 class AliEventplane;
-class AliOADBContainer;
 class AliVTrack;
 class THnSparse;
 class TProfile;
@@ -93,9 +92,8 @@ class AliEPSelectionTask : public AliAnalysisTaskSE {
 
   AliESDtrackCuts* fESDtrackCuts;       // track cuts
   
-  AliOADBContainer* fEPContainer;	//! OADB Container
-  AliOADBContainer* fQxContainer;	//! OADB Container for Q_x vector
-  AliOADBContainer* fQyContainer;	//! OADB Container for Q_y vector
+  TString fEPFileName;			//! OADB file with the phi distributions, read through AliOADBCache
+  TString fQFileName;			//! OADB file with the Q_x and Q_y vector distributions, read through AliOADBCache
   TH1F*	 fPhiDist[4];			// array of Phi distributions used to calculate phi weights
   THnSparse *fSparseDist;               //! THn for eta-charge phi-weighting
   TProfile* fQDist[2];			// array of TProfiles with mean+rms for recentering
@@ -119,7 +117,7 @@ class AliEPSelectionTask : public AliAnalysisTaskSE {
   TH2F*	 fHOutDiff;			//! control histogram: Difference of MC RP and EP - only filled if fUseMCRP is true!
   TH2F*  fHOutleadPTPsi;		//! control histogram: emission angle of leading pT track vs EP angle
 
-  ClassDef(AliEPSelectionTask,4); 
+  ClassDef(AliEPSelectionTask,5); 
 };
 
 #endif
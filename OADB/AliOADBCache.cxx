@@ -0,0 +1,274 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/* $Id$ */
+
+//-------------------------------------------------------------------------
+//     Process-wide cache of OADB objects
+//
+//     Many tasks of a train read the same OADB files at every run change.
+//     Through this class each file is opened once per process, each
+//     container is streamed once, and the run dependent objects are
+//     looked up once per (file, container, run, default, pass):
+//
+//       const TObject* obj = AliOADBCache::Instance()->GetObject(fileName, "physSel", run, "Default");
+//
+//     The returned objects are owned by the cache and shared between all
+//     users: they must be treated as read-only. Users that modify or own
+//     the object they get (e.g. to delete it in their destructor) have to
+//     clone it.
+//     Prefetch(run) resolves all the run dependent lookups seen so far for
+//     a new run, so that it can be called when a new input file is
+//     notified, before the first event of the run is processed.
+//-------------------------------------------------------------------------
+
+#include <TFile.h>
+#include <TH1.h>
+#include <TObjArray.h>
+#include <TObjString.h>
+#include <TString.h>
+#include "AliOADBContainer.h"
+#include "AliOADBCache.h"
+#include "AliLog.h"
+
+ClassImp(AliOADBCache);
+
+AliOADBCache* AliOADBCache::fgInstance = 0;
+
+//______________________________________________________________________________
+AliOADBCache::AliOADBCache() :
+  TObject(),
+  fFiles(),
+  fFileObjects(),
+  fRunObjects(),
+  fQueries(),
+  fPrefetchRun(-1),
+  fNHits(0),
+  fNMisses(0),
+  fNPrefetched(0),
+  fNFilesOpened(0)
+{
+  // Default constructor, use Instance()
+}
+//______________________________________________________________________________
+AliOADBCache::~AliOADBCache()
+{
+  // Destructor
+  Reset();
+  if (fgInstance == this) fgInstance = 0;
+}
+//______________________________________________________________________________
+AliOADBCache* AliOADBCache::Instance()
+{
+  // Returns the process-wide instance
+  if (!fgInstance) fgInstance = new AliOADBCache();
+  return fgInstance;
+}
+//______________________________________________________________________________
+std::string AliOADBCache::MakeKey(const char* a, const char* b, const char* c, const char* d)
+{
+  // Key made of the given fields, separated by a character which cannot appear in them
+  std::string key(a ? a : "");
+  key += '\n';
+  key += (b ? b : "");
+  if (c || d) {
+    key += '\n';
+    key += (c ? c : "");
+    key += '\n';
+    key += (d ? d : "");
+  }
+  return key;
+}
+//______________________________________________________________________________
+TFile* AliOADBCache::OpenFile(const char* fileName)
+{
+  // Opens the file once, failures are remembered as well
+  std::map<std::string, TFile*>::iterator it = fFiles.find(fileName);
+  if (it != fFiles.end()) return it->second;
+  //
+  TDirectory::TContext context;
+  TFile* file = TFile::Open(fileName);
+  if (file && !file->IsOpen()) {
+    delete file;
+    file = 0;
+  }
+  if (file) fNFilesOpened++;
+  else AliError(Form("Cannot open OADB file %s", fileName));
+  fFiles[fileName] = file;
+  return file;
+}
+//______________________________________________________________________________
+TObject* AliOADBCache::LoadFileObject(const char* fileName, const char* key)
+{
+  // Returns the object read from the file, reading it the first time
+  std::string objKey = MakeKey(fileName, key);
+  std::map<std::string, TObject*>::iterator it = fFileObjects.find(objKey);
+  if (it != fFileObjects.end()) return it->second;
+  //
+  TObject* obj = 0;
+  TFile* file = OpenFile(fileName);
+  if (file) {
+    // histograms, also inside containers, must not be attached to the file
+    Bool_t oldStatus = TH1::AddDirectoryStatus();
+    TH1::AddDirectory(kFALSE);
+    obj = file->Get(key);
+    TH1::AddDirectory(oldStatus);
+    if (obj && obj->InheritsFrom(TH1::Class())) ((TH1*)obj)->SetDirectory(0);
+  }
+  fFileObjects[objKey] = obj;
+  return obj;
+}
+//______________________________________________________________________________
+TObject* AliOADBCache::LookUpObject(const ObjectQuery& query, Int_t run)
+{
+  // Resolves a run dependent object in its container
+  TObject* obj = LoadFileObject(query.fFile.c_str(), query.fContainer.c_str());
+  if (!obj || !obj->InheritsFrom(AliOADBContainer::Class())) return 0;
+  return ((AliOADBContainer*)obj)->GetObject(run, query.fDef.c_str(), query.fPass.c_str());
+}
+//______________________________________________________________________________
+Bool_t AliOADBCache::HasFile(const char* fileName)
+{
+  // Checks whether the file can be opened
+  return OpenFile(fileName) != 0;
+}
+//______________________________________________________________________________
+const TObject* AliOADBCache::GetFileObject(const char* fileName, const char* key)
+{
+  // Returns the object stored under key in the file, 0 if not found
+  if (fFileObjects.find(MakeKey(fileName, key)) != fFileObjects.end()) fNHits++;
+  else fNMisses++;
+  return LoadFileObject(fileName, key);
+}
+//______________________________________________________________________________
+const AliOADBContainer* AliOADBCache::GetContainer(const char* fileName, const char* containerName)
+{
+  // Returns the container stored in the file, 0 if not found
+  const TObject* obj = GetFileObject(fileName, containerName);
+  if (!obj || !obj->InheritsFrom(AliOADBContainer::Class())) return 0;
+  return (const AliOADBContainer*)obj;
+}
+//______________________________________________________________________________
+const TObject* AliOADBCache::GetObject(const char* fileName, const char* containerName, Int_t run,
+                                       const char* def, const char* passName)
+{
+  // Returns the object valid for run, see AliOADBContainer::GetObject
+  std::string queryKey = MakeKey(fileName, containerName, def, passName);
+  std::map<std::string, ObjectQuery>::iterator query = fQueries.find(queryKey);
+  if (query == fQueries.end()) {
+    ObjectQuery newQuery;
+    newQuery.fFile = fileName;
+    newQuery.fContainer = containerName;
+    newQuery.fDef = def ? def : "";
+    newQuery.fPass = passName ? passName : "";
+    query = fQueries.insert(std::make_pair(queryKey, newQuery)).first;
+  }
+  //
+  std::string runKey = queryKey + Form("\n%d", run);
+  std::map<std::string, TObject*>::iterator it = fRunObjects.find(runKey);
+  if (it != fRunObjects.end()) {
+    fNHits++;
+    return it->second;
+  }
+  fNMisses++;
+  TObject* obj = LookUpObject(query->second, run);
+  fRunObjects[runKey] = obj;
+  return obj;
+}
+//______________________________________________________________________________
+const TObject* AliOADBCache::GetDefaultObject(const char* fileName, const char* containerName, const char* key)
+{
+  // Returns the default object stored under key in the container
+  std::string defKey = MakeKey(fileName, containerName, key, "\001default");
+  std::map<std::string, TObject*>::iterator it = fRunObjects.find(defKey);
+  if (it != fRunObjects.end()) {
+    fNHits++;
+    return it->second;
+  }
+  fNMisses++;
+  TObject* obj = LoadFileObject(fileName, containerName);
+  if (obj && obj->InheritsFrom(AliOADBContainer::Class())) obj = ((AliOADBContainer*)obj)->GetDefaultObject(key);
+  else obj = 0;
+  fRunObjects[defKey] = obj;
+  return obj;
+}
+//______________________________________________________________________________
+void AliOADBCache::Prefetch(Int_t run)
+{
+  // Resolves all the run dependent lookups done so far for the given run
+  if (run < 0 || run == fPrefetchRun) return;
+  fPrefetchRun = run;
+  for (std::map<std::string, ObjectQuery>::iterator query = fQueries.begin(); query != fQueries.end(); ++query) {
+    std::string runKey = query->first + Form("\n%d", run);
+    if (fRunObjects.find(runKey) != fRunObjects.end()) continue;
+    fRunObjects[runKey] = LookUpObject(query->second, run);
+    fNPrefetched++;
+  }
+}
+//______________________________________________________________________________
+Int_t AliOADBCache::PrefetchForFile(const char* path)
+{
+  // Prefetches the objects for the run the input file belongs to.
+  // Returns the run number, -1 if it cannot be extracted from the path
+  Int_t run = GetRunFromPath(path);
+  if (run > 0) Prefetch(run);
+  return run;
+}
+//______________________________________________________________________________
+Int_t AliOADBCache::GetRunFromPath(const char* path)
+{
+  // Extracts the run number from an input file path, following the
+  // AliEn conventions: /alice/data/2015/LHC15o/000246087/pass1/... and
+  // /alice/sim/2016/LHC16g1/246087/...
+  // Returns -1 if no directory looks like a run number
+  if (!path) return -1;
+  Int_t run = -1;
+  TObjArray* tokens = TString(path).Tokenize("/");
+  for (Int_t i = 0; i < tokens->GetEntriesFast() && run < 0; i++) {
+    const TString& token = ((TObjString*)tokens->UncheckedAt(i))->String();
+    if ((token.Length() != 6 && token.Length() != 9) || !token.IsDigit()) continue;
+    if (token.Length() == 9 && !token.BeginsWith("000")) continue;
+    run = token.Atoi();
+  }
+  delete tokens;
+  return run;
+}
+//______________________________________________________________________________
+void AliOADBCache::Reset()
+{
+  // Deletes all the cached objects and closes the files.
+  // Invalidates all the pointers handed out so far
+  for (std::map<std::string, TObject*>::iterator it = fFileObjects.begin(); it != fFileObjects.end(); ++it) delete it->second;
+  for (std::map<std::string, TFile*>::iterator it = fFiles.begin(); it != fFiles.end(); ++it) {
+    if (!it->second) continue;
+    it->second->Close();
+    delete it->second;
+  }
+  fFiles.clear();
+  fFileObjects.clear();
+  fRunObjects.clear();
+  fQueries.clear();
+  fPrefetchRun = -1;
+}
+//______________________________________________________________________________
+void AliOADBCache::PrintStatistics() const
+{
+  // Prints the cache usage
+  Long64_t lookups = fNHits + fNMisses;
+  Printf("AliOADBCache: %d files opened, %d objects read, %d run dependent objects (%lld prefetched)",
+         fNFilesOpened, (Int_t)fFileObjects.size(), (Int_t)fRunObjects.size(), fNPrefetched);
+  Printf("AliOADBCache: %lld lookups, %lld hits, %lld misses, hit rate %.1f%%",
+         lookups, fNHits, fNMisses, lookups > 0 ? 100. * fNHits / lookups : 0.);
+}
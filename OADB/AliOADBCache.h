@@ -0,0 +1,79 @@
+#ifndef ALIOADBCACHE_H
+#define ALIOADBCACHE_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+
+//-------------------------------------------------------------------------
+//     Process-wide cache of OADB objects
+//     OADB files are opened once per process and the objects read from
+//     them (containers or plain objects) are shared by all users.
+//     Lookups are keyed by (file, container, run[, default, pass]).
+//     The objects handed out are owned by the cache and must not be
+//     modified or deleted: users that need to change them clone them.
+//-------------------------------------------------------------------------
+
+#include <map>
+#include <string>
+#include <TObject.h>
+
+class TFile;
+class AliOADBContainer;
+
+class AliOADBCache : public TObject
+{
+ public :
+  static AliOADBCache* Instance();
+  virtual ~AliOADBCache();
+  //
+  Bool_t                  HasFile(const char* fileName);
+  const TObject*          GetFileObject(const char* fileName, const char* key);
+  const AliOADBContainer* GetContainer(const char* fileName, const char* containerName);
+  const TObject*          GetObject(const char* fileName, const char* containerName, Int_t run,
+                                    const char* def = "", const char* passName = "");
+  const TObject*          GetDefaultObject(const char* fileName, const char* containerName, const char* key);
+  //
+  void     Prefetch(Int_t run);
+  Int_t    PrefetchForFile(const char* path);
+  static Int_t GetRunFromPath(const char* path);
+  //
+  void     Reset();
+  void     PrintStatistics() const;
+  Long64_t GetNHits()        const {return fNHits;}
+  Long64_t GetNMisses()      const {return fNMisses;}
+  Long64_t GetNPrefetched()  const {return fNPrefetched;}
+  Int_t    GetNFilesOpened() const {return fNFilesOpened;}
+  //
+ private:
+  AliOADBCache();
+  AliOADBCache(const AliOADBCache& cache);
+  AliOADBCache& operator=(const AliOADBCache& cache);
+  //
+  struct ObjectQuery {
+    std::string fFile;        // OADB file name
+    std::string fContainer;   // container name
+    std::string fDef;         // default object name
+    std::string fPass;        // pass name
+  };
+  //
+  TFile*     OpenFile(const char* fileName);
+  TObject*   LoadFileObject(const char* fileName, const char* key);
+  TObject*   LookUpObject(const ObjectQuery& query, Int_t run);
+  static std::string MakeKey(const char* a, const char* b, const char* c = 0, const char* d = 0);
+  //
+  std::map<std::string, TFile*>      fFiles;        //! opened OADB files, 0 if the file could not be opened
+  std::map<std::string, TObject*>    fFileObjects;  //! objects read from the files, owned by the cache
+  std::map<std::string, TObject*>    fRunObjects;   //! run dependent objects, pointing into the containers
+  std::map<std::string, ObjectQuery> fQueries;      //! distinct run dependent lookups, replayed by Prefetch
+  Int_t      fPrefetchRun;                          //! run for which the last prefetch was done
+  Long64_t   fNHits;                                //! lookups served from the cache
+  Long64_t   fNMisses;                              //! lookups that had to be resolved
+  Long64_t   fNPrefetched;                          //! run dependent objects resolved by Prefetch
+  Int_t      fNFilesOpened;                         //! number of OADB files opened
+  //
+  static AliOADBCache* fgInstance;                  //! singleton
+  //
+  ClassDef(AliOADBCache, 1);
+};
+
+#endif
@@ -22,7 +22,10 @@
 #include "AliESDUtils.h"
 #include "AliESDtrackCuts.h"
 #include "AliPPVsMultUtils.h"
+#include "AliOADBCache.h"
 #include <TFile.h>
+#include <TH1F.h>
+#include <TH1D.h>
 #include "AliAODHeader.h"
 #include "AliInputEventHandler.h"
 #include "AliAnalysisManager.h"
@@ -297,206 +300,48 @@ Bool_t AliPPVsMultUtils::LoadCalibration(Int_t lLoadThisCalibration)
     }
 
     AliInfo(Form( "Loading calibration file for run %i",lLoadThisCalibration) );
-    TFile *lCalibFile_V0M = 0x0;
-    TFile *lCalibFile_V0A = 0x0;
-    TFile *lCalibFile_V0C = 0x0;
-    TFile *lCalibFile_V0MEq = 0x0;
-    TFile *lCalibFile_V0AEq = 0x0;
-    TFile *lCalibFile_V0CEq = 0x0;
-    TFile *lCalibFile_V0B = 0x0;
-    TFile *lCalibFile_V0Apartial = 0x0;
-    TFile *lCalibFile_V0Cpartial = 0x0;
-    TFile *lCalibFile_V0S = 0x0;
-    TFile *lCalibFile_V0SB = 0x0;
-    TFile *lCalibFile_Averages = 0x0;
-
-    //AliInfo("Calling TFile::Open");
-    lCalibFile_V0M = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0M.root");
-    lCalibFile_V0A = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0A.root");
-    lCalibFile_V0C = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0C.root");
-    lCalibFile_V0MEq = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0MEq.root");
-    lCalibFile_V0AEq = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0AEq.root");
-    lCalibFile_V0CEq = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0CEq.root");
-    lCalibFile_V0B = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0B.root");
-    lCalibFile_V0Apartial = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0Apartial.root");
-    lCalibFile_V0Cpartial = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0Cpartial.root");
-    lCalibFile_V0S = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0S.root");
-    lCalibFile_V0SB = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0SB.root");
-    lCalibFile_Averages = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calib-averages.root");
-
-    //AliInfo("Casting");
-    fBoundaryHisto_V0M        = dynamic_cast<TH1F *>(lCalibFile_V0M  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0A        = dynamic_cast<TH1F *>(lCalibFile_V0A  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0C        = dynamic_cast<TH1F *>(lCalibFile_V0C  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0MEq      = dynamic_cast<TH1F *>(lCalibFile_V0MEq  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0AEq      = dynamic_cast<TH1F *>(lCalibFile_V0AEq  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0CEq      = dynamic_cast<TH1F *>(lCalibFile_V0CEq  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0B        = dynamic_cast<TH1F *>(lCalibFile_V0B  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0Apartial = dynamic_cast<TH1F *>(lCalibFile_V0Apartial  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0Cpartial = dynamic_cast<TH1F *>(lCalibFile_V0Cpartial  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0S        = dynamic_cast<TH1F *>(lCalibFile_V0S  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0SB       = dynamic_cast<TH1F *>(lCalibFile_V0SB  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
+    //Calibration files are opened and read once per process through the shared OADB
+    //cache; the histograms are renamed and owned by this object, so work on copies
+    AliOADBCache *lOADBCache = AliOADBCache::Instance();
+    const Int_t lNBoundaryHistos = 11;
+    const char *lEstimatorNames[lNBoundaryHistos] = {
+        "V0M", "V0A", "V0C", "V0MEq", "V0AEq", "V0CEq", "V0B", "V0Apartial", "V0Cpartial", "V0S", "V0SB"
+    };
+    TH1F **lBoundaryHistos[lNBoundaryHistos] = {
+        &fBoundaryHisto_V0M, &fBoundaryHisto_V0A, &fBoundaryHisto_V0C, &fBoundaryHisto_V0MEq, &fBoundaryHisto_V0AEq,
+        &fBoundaryHisto_V0CEq, &fBoundaryHisto_V0B, &fBoundaryHisto_V0Apartial, &fBoundaryHisto_V0Cpartial,
+        &fBoundaryHisto_V0S, &fBoundaryHisto_V0SB
+    };
+    Bool_t lCalibrationFound = kTRUE;
+    for( Int_t iHisto = 0; iHisto < lNBoundaryHistos; iHisto++ ) {
+        const TH1F *lCachedHisto = dynamic_cast<const TH1F *>( lOADBCache->GetFileObject(
+            Form("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_%s.root",lEstimatorNames[iHisto]),
+            Form("histocalib%i",lLoadThisCalibration) ) );
+        if ( !lCachedHisto ) {
+            lCalibrationFound = kFALSE;
+            continue;
+        }
+        *lBoundaryHistos[iHisto] = (TH1F *) lCachedHisto->Clone( Form("fBoundaryHisto_%s",lEstimatorNames[iHisto]) );
+        (*lBoundaryHistos[iHisto])->SetDirectory(0);
+    }
 
     //Average Amplitudes for weighting
-    fAverageAmplitudes       = dynamic_cast<TH1D *>(lCalibFile_Averages  -> Get(Form("hcalib_averages_%i",lLoadThisCalibration)) );
+    const TH1D *lCachedAverages = dynamic_cast<const TH1D *>( lOADBCache->GetFileObject(
+        "$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calib-averages.root",
+        Form("hcalib_averages_%i",lLoadThisCalibration) ) );
+    if ( lCachedAverages ) {
+        fAverageAmplitudes = (TH1D *) lCachedAverages->Clone("fBoundaryHisto_V0SB");
+        fAverageAmplitudes->SetDirectory(0);
+    } else {
+        lCalibrationFound = kFALSE;
+    }
 
-    if ( !fBoundaryHisto_V0M   || !fBoundaryHisto_V0A   || !fBoundaryHisto_V0C ||
-            !fBoundaryHisto_V0MEq || !fBoundaryHisto_V0AEq || !fBoundaryHisto_V0CEq || !fBoundaryHisto_V0B || !fBoundaryHisto_V0Apartial || !fBoundaryHisto_V0Cpartial ||
-            !fBoundaryHisto_V0S || !fBoundaryHisto_V0SB || !fAverageAmplitudes ) {
+    if ( !lCalibrationFound ) {
         AliInfo(Form("No calibration for run %i exists at the moment!",lLoadThisCalibration));
-        if( lCalibFile_V0M ) {
-            lCalibFile_V0M->Close();
-            lCalibFile_V0M->Delete();
-            delete lCalibFile_V0M;
-        }
-        if( lCalibFile_V0A ) {
-            lCalibFile_V0A->Close();
-            lCalibFile_V0A->Delete();
-            delete lCalibFile_V0A;
-        }
-        if( lCalibFile_V0C ) {
-            lCalibFile_V0C->Close();
-            lCalibFile_V0C->Delete();
-            delete lCalibFile_V0C;
-        }
-        if( lCalibFile_V0MEq ) {
-            lCalibFile_V0MEq->Close();
-            lCalibFile_V0MEq->Delete();
-            delete lCalibFile_V0MEq;
-        }
-        if( lCalibFile_V0AEq ) {
-            lCalibFile_V0AEq->Close();
-            lCalibFile_V0AEq->Delete();
-            delete lCalibFile_V0AEq;
-        }
-        if( lCalibFile_V0CEq ) {
-            lCalibFile_V0CEq->Close();
-            lCalibFile_V0CEq->Delete();
-            delete lCalibFile_V0CEq;
-        }
-        if( lCalibFile_V0B ) {
-            lCalibFile_V0B->Close();
-            lCalibFile_V0B->Delete();
-            delete lCalibFile_V0B;
-        }
-        if( lCalibFile_V0Apartial ) {
-            lCalibFile_V0Apartial->Close();
-            lCalibFile_V0Apartial->Delete();
-            delete lCalibFile_V0Apartial;
-        }
-        if( lCalibFile_V0Cpartial ) {
-            lCalibFile_V0Cpartial->Close();
-            lCalibFile_V0Cpartial->Delete();
-            delete lCalibFile_V0Cpartial;
-        }
-        if( lCalibFile_V0S ) {
-            lCalibFile_V0S->Close();
-            lCalibFile_V0S->Delete();
-            delete lCalibFile_V0S;
-        }
-        if( lCalibFile_V0SB ) {
-            lCalibFile_V0SB->Close();
-            lCalibFile_V0SB->Delete();
-            delete lCalibFile_V0SB;
-        }
-        if( lCalibFile_Averages ) {
-            lCalibFile_Averages->Close();
-            lCalibFile_Averages->Delete();
-            delete lCalibFile_Averages;
-        }
         fRunNumber = lLoadThisCalibration;
         return kFALSE; //return denial
     }
 
-    fBoundaryHisto_V0M->SetName("fBoundaryHisto_V0M");
-    fBoundaryHisto_V0A->SetName("fBoundaryHisto_V0A");
-    fBoundaryHisto_V0C->SetName("fBoundaryHisto_V0C");
-    fBoundaryHisto_V0MEq->SetName("fBoundaryHisto_V0MEq");
-    fBoundaryHisto_V0AEq->SetName("fBoundaryHisto_V0AEq");
-    fBoundaryHisto_V0CEq->SetName("fBoundaryHisto_V0CEq");
-    fBoundaryHisto_V0B->SetName("fBoundaryHisto_V0B");
-    fBoundaryHisto_V0Apartial->SetName("fBoundaryHisto_V0Apartial");
-    fBoundaryHisto_V0Cpartial->SetName("fBoundaryHisto_V0Cpartial");
-    fBoundaryHisto_V0S->SetName("fBoundaryHisto_V0S");
-    fBoundaryHisto_V0SB->SetName("fBoundaryHisto_V0SB");
-    fAverageAmplitudes->SetName("fBoundaryHisto_V0SB");
-
-    //Careful with manual cleanup if needed: to be implemented
-    fBoundaryHisto_V0M->SetDirectory(0);
-    fBoundaryHisto_V0A->SetDirectory(0);
-    fBoundaryHisto_V0C->SetDirectory(0);
-    fBoundaryHisto_V0MEq->SetDirectory(0);
-    fBoundaryHisto_V0AEq->SetDirectory(0);
-    fBoundaryHisto_V0CEq->SetDirectory(0);
-    fBoundaryHisto_V0B->SetDirectory(0);
-    fBoundaryHisto_V0Apartial->SetDirectory(0);
-    fBoundaryHisto_V0Cpartial->SetDirectory(0);
-    fBoundaryHisto_V0S->SetDirectory(0);
-    fBoundaryHisto_V0SB->SetDirectory(0);
-    fAverageAmplitudes->SetDirectory(0);
-
-    //AliInfo("Closing");
-    if( lCalibFile_V0M ) {
-        lCalibFile_V0M->Close();
-        lCalibFile_V0M->Delete();
-        delete lCalibFile_V0M;
-    }
-    if( lCalibFile_V0A ) {
-        lCalibFile_V0A->Close();
-        lCalibFile_V0A->Delete();
-        delete lCalibFile_V0A;
-    }
-    if( lCalibFile_V0C ) {
-        lCalibFile_V0C->Close();
-        lCalibFile_V0C->Delete();
-        delete lCalibFile_V0C;
-    }
-    if( lCalibFile_V0MEq ) {
-        lCalibFile_V0MEq->Close();
-        lCalibFile_V0MEq->Delete();
-        delete lCalibFile_V0MEq;
-    }
-    if( lCalibFile_V0AEq ) {
-        lCalibFile_V0AEq->Close();
-        lCalibFile_V0AEq->Delete();
-        delete lCalibFile_V0AEq;
-    }
-    if( lCalibFile_V0CEq ) {
-        lCalibFile_V0CEq->Close();
-        lCalibFile_V0CEq->Delete();
-        delete lCalibFile_V0CEq;
-    }
-    if( lCalibFile_V0B ) {
-        lCalibFile_V0B->Close();
-        lCalibFile_V0B->Delete();
-        delete lCalibFile_V0B;
-    }
-    if( lCalibFile_V0Apartial ) {
-        lCalibFile_V0Apartial->Close();
-        lCalibFile_V0Apartial->Delete();
-        delete lCalibFile_V0Apartial;
-    }
-    if( lCalibFile_V0Cpartial ) {
-        lCalibFile_V0Cpartial->Close();
-        lCalibFile_V0Cpartial->Delete();
-        delete lCalibFile_V0Cpartial;
-    }
-    if( lCalibFile_V0S ) {
-        lCalibFile_V0S->Close();
-        lCalibFile_V0S->Delete();
-        delete lCalibFile_V0S;
-    }
-    if( lCalibFile_V0SB ) {
-        lCalibFile_V0SB->Close();
-        lCalibFile_V0SB->Delete();
-        delete lCalibFile_V0SB;
-    }
-    if( lCalibFile_Averages ) {
-        lCalibFile_Averages->Close();
-        lCalibFile_Averages->Delete();
-        delete lCalibFile_Averages;
-    }
-
     fRunNumber = lLoadThisCalibration; //Loaded!
     AliInfo(Form("Finished loading calibration for run %i",lLoadThisCalibration));
     return kTRUE;
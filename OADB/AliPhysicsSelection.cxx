@@ -66,6 +66,9 @@
 //           Michele Floris, CERN
 //-------------------------------------------------------------------------
 #include <vector>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 
 #include <Riostream.h>
 #include <TH1F.h>
@@ -96,6 +99,7 @@
 #include "TPRegexp.h"
 #include "TFile.h"
 #include "AliOADBContainer.h"
+#include "AliOADBCache.h"
 #include "AliOADBPhysicsSelection.h"
 #include "AliOADBFillingScheme.h"
 #include "AliOADBTriggerAnalysis.h"
@@ -111,6 +115,169 @@
 
 class StringToRegexp : public std::map<std::string, TPRegexp> {};
 
+/// Trigger logic compiled into a postfix program. The operands are the
+/// trigger inputs in the order in which they appear in the logic string,
+/// i.e. the parameters of the corresponding TFormula.
+class TriggerLogicProgram {
+public:
+  enum { kMaxInputs = 64, kMaxDepth = 32, kNChecks = 100 };
+  enum OpCode { kLoad, kConst, kNot, kNeg, kOr, kAnd, kBitOr, kBitAnd,
+                kEq, kNe, kLt, kGt, kLe, kGe, kAdd, kSub, kMul, kDiv };
+
+  TriggerLogicProgram() : fCode(), fConstants(), fNInputs(0), fValid(kFALSE), fNChecks(0), fPos(0), fDepth(0), fMaxDepth(0) {}
+
+  Bool_t Compile(const char* logic);
+  Double_t Run(const Double_t* inputs) const;
+
+  std::vector<Int_t> fCode;          // op codes, followed by the operand index for kLoad and kConst
+  std::vector<Double_t> fConstants;  // numeric constants
+  Int_t fNInputs;                    // number of trigger inputs
+  Bool_t fValid;                     // program compiled and consistent with the TFormula
+  Int_t fNChecks;                    // number of evaluations cross-checked with the TFormula
+
+private:
+  Bool_t ParseBinary(Int_t level);
+  Bool_t ParseUnary();
+  Bool_t ParsePrimary();
+  Int_t MatchOperator(Int_t level);
+  void SkipSpaces() { while (fLogic[fPos] == ' ' || fLogic[fPos] == '\t') fPos++; }
+  void Emit(Int_t op, Int_t stackChange) { fCode.push_back(op); fDepth += stackChange; if (fDepth > fMaxDepth) fMaxDepth = fDepth; }
+
+  std::string fLogic;                // logic string being compiled
+  size_t fPos;                       // parser position
+  Int_t fDepth;                      // stack depth at the parser position
+  Int_t fMaxDepth;                   // maximum stack depth of the program
+};
+
+class StringToTriggerProgram : public std::map<std::string, TriggerLogicProgram> {};
+
+Bool_t TriggerLogicProgram::Compile(const char* logic) {
+  // Parse the logic with C operator precedence; returns kFALSE for anything not supported
+  fLogic = logic;
+  fPos = 0;
+  fDepth = 0;
+  fMaxDepth = 0;
+  fCode.clear();
+  fConstants.clear();
+  fNInputs = 0;
+  fValid = ParseBinary(0);
+  SkipSpaces();
+  if (fPos != fLogic.size() || fDepth != 1 || fMaxDepth > kMaxDepth || fNInputs > kMaxInputs) fValid = kFALSE;
+  return fValid;
+}
+
+Int_t TriggerLogicProgram::MatchOperator(Int_t level) {
+  // Returns the op code of the binary operator of the given precedence level at the parser position, -1 if none
+  SkipSpaces();
+  const char* c = fLogic.c_str() + fPos;
+  switch (level) {
+    case 0: if (c[0] == '|' && c[1] == '|') { fPos += 2; return kOr; } break;
+    case 1: if (c[0] == '&' && c[1] == '&') { fPos += 2; return kAnd; } break;
+    case 2: if (c[0] == '|' && c[1] != '|') { fPos += 1; return kBitOr; } break;
+    case 3: if (c[0] == '&' && c[1] != '&') { fPos += 1; return kBitAnd; } break;
+    case 4:
+      if (c[0] == '=' && c[1] == '=') { fPos += 2; return kEq; }
+      if (c[0] == '!' && c[1] == '=') { fPos += 2; return kNe; }
+      break;
+    case 5:
+      if (c[0] == '<' && c[1] == '=') { fPos += 2; return kLe; }
+      if (c[0] == '>' && c[1] == '=') { fPos += 2; return kGe; }
+      if (c[0] == '<') { fPos += 1; return kLt; }
+      if (c[0] == '>') { fPos += 1; return kGt; }
+      break;
+    case 6:
+      if (c[0] == '+') { fPos += 1; return kAdd; }
+      if (c[0] == '-') { fPos += 1; return kSub; }
+      break;
+    case 7:
+      if (c[0] == '*') { fPos += 1; return kMul; }
+      if (c[0] == '/') { fPos += 1; return kDiv; }
+      break;
+  }
+  return -1;
+}
+
+Bool_t TriggerLogicProgram::ParseBinary(Int_t level) {
+  if (level > 7) return ParseUnary();
+  if (!ParseBinary(level+1)) return kFALSE;
+  Int_t op = -1;
+  while ((op = MatchOperator(level)) >= 0) {
+    if (!ParseBinary(level+1)) return kFALSE;
+    Emit(op, -1);
+  }
+  return kTRUE;
+}
+
+Bool_t TriggerLogicProgram::ParseUnary() {
+  SkipSpaces();
+  char c = fLogic[fPos];
+  if (c == '!' && fLogic[fPos+1] != '=') { fPos++; if (!ParseUnary()) return kFALSE; Emit(kNot, 0); return kTRUE; }
+  if (c == '-') { fPos++; if (!ParseUnary()) return kFALSE; Emit(kNeg, 0); return kTRUE; }
+  if (c == '+') { fPos++; return ParseUnary(); }
+  return ParsePrimary();
+}
+
+Bool_t TriggerLogicProgram::ParsePrimary() {
+  SkipSpaces();
+  char c = fLogic[fPos];
+  if (c == '(') {
+    fPos++;
+    if (!ParseBinary(0)) return kFALSE;
+    SkipSpaces();
+    if (fLogic[fPos] != ')') return kFALSE;
+    fPos++;
+    return kTRUE;
+  }
+  if (isalpha(c)) {
+    // trigger input; same token definition as in AliPhysicsSelection::FindForumla
+    while (isalnum(fLogic[fPos])) fPos++;
+    Emit(kLoad, 1);
+    fCode.push_back(fNInputs++);
+    return kTRUE;
+  }
+  if (isdigit(c) || c == '.') {
+    size_t begin = fPos;
+    while (isdigit(fLogic[fPos]) || fLogic[fPos] == '.') fPos++;
+    Emit(kConst, 1);
+    fCode.push_back(fConstants.size());
+    fConstants.push_back(atof(fLogic.substr(begin, fPos-begin).c_str()));
+    return kTRUE;
+  }
+  return kFALSE;
+}
+
+Double_t TriggerLogicProgram::Run(const Double_t* inputs) const {
+  Double_t stack[kMaxDepth];
+  Int_t sp = 0;
+  const Int_t n = fCode.size();
+  for (Int_t pc = 0; pc < n; pc++) {
+    Int_t op = fCode[pc];
+    if (op == kLoad)  { stack[sp++] = inputs[fCode[++pc]]; continue; }
+    if (op == kConst) { stack[sp++] = fConstants[fCode[++pc]]; continue; }
+    if (op == kNot)   { stack[sp-1] = (stack[sp-1] == 0); continue; }
+    if (op == kNeg)   { stack[sp-1] = -stack[sp-1]; continue; }
+    Double_t b = stack[--sp];
+    Double_t& a = stack[sp-1];
+    switch (op) {
+      case kOr:     a = (a != 0 || b != 0); break;
+      case kAnd:    a = (a != 0 && b != 0); break;
+      case kBitOr:  a = (Long64_t) a | (Long64_t) b; break;
+      case kBitAnd: a = (Long64_t) a & (Long64_t) b; break;
+      case kEq:     a = (a == b); break;
+      case kNe:     a = (a != b); break;
+      case kLt:     a = (a < b); break;
+      case kGt:     a = (a > b); break;
+      case kLe:     a = (a <= b); break;
+      case kGe:     a = (a >= b); break;
+      case kAdd:    a = a + b; break;
+      case kSub:    a = a - b; break;
+      case kMul:    a = a * b; break;
+      case kDiv:    a = a / b; break;
+    }
+  }
+  return stack[0];
+}
+
 ClassImp(AliPhysicsSelection)
 
 AliPhysicsSelection::AliPhysicsSelection() :
@@ -123,6 +290,7 @@ fIsPP(kFALSE),
 fReadOCDB(kFALSE),
 fUseBXNumbers(0),
 fUsingCustomClasses(0),
+fCacheTriggerDecisions(kTRUE),
 fCollTrigClasses(),
 fBGTrigClasses(),
 fTriggerAnalysis(),
@@ -132,7 +300,16 @@ fPSOADB(0),
 fFillOADB(0),
 fTriggerOADB(0),
 fTriggerToFormula(new StringToFormula()),
-fTriggerToRegexp(new StringToRegexp())
+fTriggerToRegexp(new StringToRegexp()),
+fTriggerToProgram(new StringToTriggerProgram()),
+fTriggerValues(),
+fTriggerValuesFilled(),
+fTriggerValuesOwner(0),
+fUseTriggerValues(kFALSE),
+fRunTimer(),
+fRunEvents(0),
+fRunRealTime(0),
+fRunCpuTime(0)
 {
   // constructor
   fCollTrigClasses.SetOwner(1);
@@ -153,6 +330,7 @@ AliPhysicsSelection::AliPhysicsSelection(const char *name) :
  fReadOCDB(kFALSE),
  fUseBXNumbers(0),
  fUsingCustomClasses(0),
+ fCacheTriggerDecisions(kTRUE),
  fCollTrigClasses(),
  fBGTrigClasses(),
  fTriggerAnalysis(),
@@ -162,7 +340,16 @@ AliPhysicsSelection::AliPhysicsSelection(const char *name) :
  fFillOADB(0),
  fTriggerOADB(0),
  fTriggerToFormula(new StringToFormula()),
- fTriggerToRegexp(new StringToRegexp())
+ fTriggerToRegexp(new StringToRegexp()),
+ fTriggerToProgram(new StringToTriggerProgram()),
+ fTriggerValues(),
+ fTriggerValuesFilled(),
+ fTriggerValuesOwner(0),
+ fUseTriggerValues(kFALSE),
+ fRunTimer(),
+ fRunEvents(0),
+ fRunRealTime(0),
+ fRunCpuTime(0)
  {
    // constructor
    fCollTrigClasses.SetOwner(1);
@@ -179,6 +366,7 @@ AliPhysicsSelection::~AliPhysicsSelection(){
   if (fTriggerOADB)  delete fTriggerOADB;
   delete fTriggerToFormula;
   delete fTriggerToRegexp;
+  delete fTriggerToProgram;
 }
 
 UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char* trigger, Int_t& triggerLogic) const {
@@ -270,22 +458,69 @@ UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char
 Bool_t AliPhysicsSelection::EvaluateTriggerLogic(const AliVEvent* event,
 						 AliTriggerAnalysis* triggerAnalysis,
 						 const char* triggerLogic, Bool_t offline){
+  if (!fCacheTriggerDecisions)
+    return EvaluateTriggerFormula(event, triggerAnalysis, triggerLogic, offline);
+
+  TriggerLogicProgram& program = FindProgram(triggerLogic);
+  if (!program.fValid)
+    return EvaluateTriggerFormula(event, triggerAnalysis, triggerLogic, offline);
+
+  // The inputs are evaluated in the same order as the TFormula parameters
+  const std::vector<AliTriggerAnalysis::Trigger>& bits = FindForumla(triggerLogic).second;
+  Double_t inputs[TriggerLogicProgram::kMaxInputs];
+  for (Int_t i = 0; i < program.fNInputs; ++i)
+    inputs[i] = GetTriggerValue(event, triggerAnalysis, bits[i], offline);
+  Bool_t decision = program.Run(inputs);
+
+  // Cross-check the first decisions of each program with the TFormula (inputs are cached by now)
+  if (program.fNChecks < TriggerLogicProgram::kNChecks) {
+    Bool_t formulaDecision = EvaluateTriggerFormula(event, triggerAnalysis, triggerLogic, offline);
+    if (decision != formulaDecision) {
+      AliError(Form("Compiled trigger logic \"%s\" disagrees with TFormula, using TFormula from now on", triggerLogic));
+      program.fValid = kFALSE;
+      return formulaDecision;
+    }
+    program.fNChecks++;
+  }
+  return decision;
+}
+
+/// Evaluate the trigger logic with the TFormula built in FindForumla()
+Bool_t AliPhysicsSelection::EvaluateTriggerFormula(const AliVEvent* event,
+						   AliTriggerAnalysis* triggerAnalysis,
+						   const char* triggerLogic, Bool_t offline){
   auto& formula_and_bits = FindForumla(triggerLogic);
   auto& trg_formula = formula_and_bits.first;
   auto& bits = formula_and_bits.second;
   // Get the values for each individual trigger in the trigger logic string;
   // These values are the parameters of the TFormula
   std::vector<Double_t> paras(bits.size());
-  auto offline_flag = offline ? AliTriggerAnalysis::kOfflineFlag : 0;
   for (size_t i = 0; i < bits.size(); ++i) {
-    typedef AliTriggerAnalysis::Trigger Trigger;
-    Trigger bit = static_cast<Trigger>(bits[i] | offline_flag);
-    paras[i] = triggerAnalysis->EvaluateTrigger(event, bit);
+    paras[i] = GetTriggerValue(event, triggerAnalysis, bits[i], offline);
   }
   Double_t dummy_val[] = {0};
   return trg_formula.EvalPar(dummy_val, paras.data());
 }
 
+/// Value of a single trigger input for the current event. With fCacheTriggerDecisions
+/// each input is evaluated only once per event and shared by all trigger classes whose
+/// AliTriggerAnalysis objects have the same configuration (see IsCollisionCandidate).
+Int_t AliPhysicsSelection::GetTriggerValue(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis,
+                                           AliTriggerAnalysis::Trigger trigger, Bool_t offline){
+  typedef AliTriggerAnalysis::Trigger Trigger;
+  Trigger bit = static_cast<Trigger>(trigger | (offline ? AliTriggerAnalysis::kOfflineFlag : 0));
+  if (!fCacheTriggerDecisions || !fUseTriggerValues || trigger >= AliTriggerAnalysis::kStartOfFlags)
+    return triggerAnalysis->EvaluateTrigger(event, bit);
+
+  Int_t slot = (offline ? AliTriggerAnalysis::kStartOfFlags : 0) + trigger;
+  ULong64_t mask = ULong64_t(1) << (slot % 64);
+  if (!(fTriggerValuesFilled[slot / 64] & mask)) {
+    fTriggerValues[slot] = triggerAnalysis->EvaluateTrigger(event, bit);
+    fTriggerValuesFilled[slot / 64] |= mask;
+  }
+  return fTriggerValues[slot];
+}
+
 //______________________________________________________________________________
 UInt_t AliPhysicsSelection::IsCollisionCandidate(const AliVEvent* event){
   // checks if the given event is a collision candidate
@@ -293,15 +528,26 @@ UInt_t AliPhysicsSelection::IsCollisionCandidate(const AliVEvent* event){
   if (fCurrentRun != event->GetRunNumber()) {
     if (!Initialize(event)) AliFatal(Form("Could not initialize for run %d", event->GetRunNumber()));
   }
+  fRunTimer.Start(kTRUE);
+  fRunEvents++;
   
   // check event type; should be PHYSICS = 7 for data and 0 for MC
   Int_t eventType = event->GetHeader()->GetEventType();
   if (fMC) {
     if (eventType != 0) AliFatal(Form("Invalid event type for MC: %d",eventType));
   } else {
-    if (eventType != 7) return kFALSE;
+    if (eventType != 7) {
+      fRunTimer.Stop();
+      fRunRealTime += fRunTimer.RealTime();
+      fRunCpuTime += fRunTimer.CpuTime();
+      return kFALSE;
+    }
   }
   
+  // new event: forget the cached trigger inputs
+  memset(fTriggerValuesFilled, 0, sizeof(fTriggerValuesFilled));
+  fTriggerValuesOwner = 0;
+  
   UInt_t accept = 0;
   Int_t nColl = fCollTrigClasses.GetEntries();
   Int_t nBG   = fBGTrigClasses.GetEntries();
@@ -312,6 +558,13 @@ UInt_t AliPhysicsSelection::IsCollisionCandidate(const AliVEvent* event){
     AliTriggerAnalysis* triggerAnalysis = static_cast<AliTriggerAnalysis*> (fTriggerAnalysis.At(i));
     triggerAnalysis->FillTriggerClasses(event);
     
+    // cached inputs are used only for objects configured like the one they were evaluated with,
+    // others (e.g. with an individual SPD FO efficiency) evaluate their inputs themselves
+    if (fCacheTriggerDecisions) {
+      if (!fTriggerValuesOwner) fTriggerValuesOwner = triggerAnalysis;
+      fUseTriggerValues = triggerAnalysis->HasSameConfiguration(fTriggerValuesOwner);
+    }
+    
     Int_t triggerLogic = 0;
     UInt_t singleTriggerResult = CheckTriggerClass(event, triggerClass, triggerLogic);
     if (!singleTriggerResult) continue;
@@ -324,6 +577,9 @@ UInt_t AliPhysicsSelection::IsCollisionCandidate(const AliVEvent* event){
   }
   
   if (accept) AliDebug(AliLog::kDebug, Form("Accepted event as collision candidate with bit mask %d", accept));
+  fRunTimer.Stop();
+  fRunRealTime += fRunTimer.RealTime();
+  fRunCpuTime += fRunTimer.CpuTime();
   return accept;
 }
 
@@ -353,37 +609,44 @@ Bool_t AliPhysicsSelection::Initialize(const AliVEvent* event){
 
 Bool_t AliPhysicsSelection::Initialize(Int_t runNumber){
   // initializes the object for the given run  
+  PrintTiming(); // for the previous run
+  fRunEvents = 0;
+  fRunRealTime = 0;
+  fRunCpuTime = 0;
   AliInfo(Form("Initializing for run %d", runNumber));
 
   Bool_t oldStatus = TH1::AddDirectoryStatus();
   TH1::AddDirectory(kFALSE);
   
-  /// Open OADB file and fetch OADB objects
+  /// Fetch OADB objects through the process-wide cache: the shared objects are cloned
+  /// since they are modified (e.g. from OCDB) and owned by this object
   TString oadbfilename = AliPhysicsSelection::GetOADBFileName();
-  
-  TFile * foadb = TFile::Open(oadbfilename);
-  if(!foadb->IsOpen()) AliFatal(Form("Cannot open OADB file %s", oadbfilename.Data()));
+  AliOADBCache* oadbCache = AliOADBCache::Instance();
+  if(!oadbCache->HasFile(oadbfilename)) AliFatal(Form("Cannot open OADB file %s", oadbfilename.Data()));
   
   if(!fPSOADB || !fUsingCustomClasses) { // if it's already set and custom class is required, we use the one provided by the user
     AliInfo("Using Standard OADB");
-    AliOADBContainer * psContainer = (AliOADBContainer*) foadb->Get("physSel");
-    if (!psContainer) AliFatal("Cannot fetch OADB container for Physics selection");
-    fPSOADB = (AliOADBPhysicsSelection*) psContainer->GetObject(runNumber, fIsPP ? "oadbDefaultPP" : "oadbDefaultPbPb",fPassName);
-    if (!fPSOADB) AliFatal(Form("Cannot find physics selection object for run %d", runNumber));
+    if (!oadbCache->GetContainer(oadbfilename, "physSel")) AliFatal("Cannot fetch OADB container for Physics selection");
+    const TObject* psObject = oadbCache->GetObject(oadbfilename, "physSel", runNumber, fIsPP ? "oadbDefaultPP" : "oadbDefaultPbPb",fPassName);
+    if (!psObject) AliFatal(Form("Cannot find physics selection object for run %d", runNumber));
+    delete fPSOADB;
+    fPSOADB = (AliOADBPhysicsSelection*) psObject->Clone();
   } else {
     AliInfo("Using Custom OADB");
   }
   if(!fFillOADB || !fUsingCustomClasses) { // if it's already set and custom class is required, we use the one provided by the user
-    AliOADBContainer * fillContainer = (AliOADBContainer*) foadb->Get("fillScheme");
-    if (!fillContainer) AliFatal("Cannot fetch OADB container for filling scheme");
-    fFillOADB = (AliOADBFillingScheme*) fillContainer->GetObject(runNumber, "Default",fPassName);
-    if (!fFillOADB) AliFatal(Form("Cannot find  filling scheme object for run %d", runNumber));
+    if (!oadbCache->GetContainer(oadbfilename, "fillScheme")) AliFatal("Cannot fetch OADB container for filling scheme");
+    const TObject* fillObject = oadbCache->GetObject(oadbfilename, "fillScheme", runNumber, "Default",fPassName);
+    if (!fillObject) AliFatal(Form("Cannot find  filling scheme object for run %d", runNumber));
+    delete fFillOADB;
+    fFillOADB = (AliOADBFillingScheme*) fillObject->Clone();
   }
   if(!fTriggerOADB || !fUsingCustomClasses) { // if it's already set and custom class is required, we use the one provided by the user
-    AliOADBContainer * triggerContainer = (AliOADBContainer*) foadb->Get("trigAnalysis");
-    if (!triggerContainer) AliFatal("Cannot fetch OADB container for trigger analysis");
-    fTriggerOADB = (AliOADBTriggerAnalysis*) triggerContainer->GetObject(runNumber, "Default",fPassName);
-    if (!fTriggerOADB) AliFatal(Form("Cannot find  trigger analysis object for run %d", runNumber));
+    if (!oadbCache->GetContainer(oadbfilename, "trigAnalysis")) AliFatal("Cannot fetch OADB container for trigger analysis");
+    const TObject* triggerObject = oadbCache->GetObject(oadbfilename, "trigAnalysis", runNumber, "Default",fPassName);
+    if (!triggerObject) AliFatal(Form("Cannot find  trigger analysis object for run %d", runNumber));
+    delete fTriggerOADB;
+    fTriggerOADB = (AliOADBTriggerAnalysis*) triggerObject->Clone();
     fTriggerOADB->Print();
   }
   
@@ -683,6 +946,7 @@ void AliPhysicsSelection::Print(const Option_t *option) const{
   }
   
   if (fUsingCustomClasses) AliWarning("Using custom trigger classes!");
+  PrintTiming();
   TString opt(option);
   opt.ToUpper();
   if (opt == "STAT") {
@@ -876,6 +1140,35 @@ FormulaAndBits& AliPhysicsSelection::FindForumla(const char* triggerLogic) {
   return it->second;
 }
 
+TriggerLogicProgram& AliPhysicsSelection::FindProgram(const char* triggerLogic) {
+  // Compiled version of the trigger logic; compiled on first use and validated
+  // against the TFormula for all combinations of boolean inputs
+  auto it = fTriggerToProgram->find(triggerLogic);
+  if (it != fTriggerToProgram->end())
+    return it->second;
+
+  TriggerLogicProgram& program = (*fTriggerToProgram)[triggerLogic];
+  auto& formula_and_bits = FindForumla(triggerLogic);
+  if (!program.Compile(triggerLogic) || program.fNInputs != (Int_t) formula_and_bits.second.size()) {
+    AliInfo(Form("Trigger logic \"%s\" cannot be compiled, using TFormula", triggerLogic));
+    program.fValid = kFALSE;
+    return program;
+  }
+  if (program.fNInputs <= 10) {
+    Double_t dummy_val[] = {0};
+    Double_t inputs[TriggerLogicProgram::kMaxInputs];
+    for (Int_t comb = 0; comb < (1 << program.fNInputs); comb++) {
+      for (Int_t i = 0; i < program.fNInputs; i++) inputs[i] = (comb >> i) & 1;
+      if ((Bool_t) program.Run(inputs) != (Bool_t) formula_and_bits.first.EvalPar(dummy_val, inputs)) {
+        AliInfo(Form("Compiled trigger logic \"%s\" disagrees with TFormula, using TFormula", triggerLogic));
+        program.fValid = kFALSE;
+        break;
+      }
+    }
+  }
+  return program;
+}
+
 TPRegexp& AliPhysicsSelection::FindRegexp(const std::string& triggers) const {
   auto it = fTriggerToRegexp->find(triggers);
   if (it != fTriggerToRegexp->end())
@@ -907,3 +1200,10 @@ TPRegexp& AliPhysicsSelection::FindRegexp(const std::string& triggers) const {
 
   return fTriggerToRegexp->emplace(triggers, std::move(re)).first->second;
 }
+
+void AliPhysicsSelection::PrintTiming() const {
+  // print the time spent in IsCollisionCandidate for the current run
+  if (fRunEvents == 0) return;
+  AliInfo(Form("Run %d: %lld events, real time %.3f s, CPU time %.3f s (%.2f us/event)",
+               fCurrentRun, fRunEvents, fRunRealTime, fRunCpuTime, 1e6 * fRunCpuTime / fRunEvents));
+}
@@ -24,6 +24,7 @@
 #include "AliLog.h"
 #include "AliAnalysisManager.h"
 #include "AliTriggerAnalysis.h"
+#include <TStopwatch.h>
 // In case of ROOT6 it is necessary to stay for the moment with the v5
 // version of TFormula as the v6 version produces a large amount of
 // warnings at runtime.
@@ -45,6 +46,8 @@ class AliOADBFillingScheme;
 class AliOADBTriggerAnalysis;
 class TPRegexp;
 class StringToRegexp;
+class TriggerLogicProgram;
+class StringToTriggerProgram;
 
 typedef std::pair<R5TFormula, std::vector<AliTriggerAnalysis::Trigger>> FormulaAndBits;
 typedef std::map<std::string, FormulaAndBits> StringToFormula;
@@ -53,6 +56,7 @@ class AliPhysicsSelection : public AliAnalysisCuts{
 public:
   // These enums are deprecated
   enum {kStatRowAllB=0, kStatRowAllAC, kStatRowAllE, kStatRowBG, kStatRowAcc,kStatRowGood};
+  enum {kNTriggerSlots = 2*AliTriggerAnalysis::kStartOfFlags}; // cached trigger inputs: online and offline for each trigger
   
   typedef Bool_t (*Bin0Callback_t)(const AliESDEvent *);
 
@@ -99,9 +103,17 @@ public:
   void DetectPassName();
   void ReadOCDB(Bool_t val) { fReadOCDB=val; }
   Bool_t IsMC() const { return fMC; }
+  // Evaluate each trigger input once per event and use the compiled trigger logic (default).
+  // Inputs are shared only between AliTriggerAnalysis objects with the same configuration
+  void SetCacheTriggerDecisions(Bool_t flag = kTRUE) { fCacheTriggerDecisions = flag; }
+  Long64_t GetRunNEvents() const { return fRunEvents; }
+  Double_t GetRunCpuTime() const { return fRunCpuTime; }
+  void PrintTiming() const;
 protected:
   UInt_t CheckTriggerClass(const AliVEvent* event, const char* trigger, Int_t& triggerLogic) const;
   Bool_t EvaluateTriggerLogic(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, const char* triggerLogic, Bool_t offline);
+  Bool_t EvaluateTriggerFormula(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, const char* triggerLogic, Bool_t offline);
+  Int_t GetTriggerValue(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, AliTriggerAnalysis::Trigger trigger, Bool_t offline);
   const char * GetTriggerString(TObjString * obj);
 
   TString fPassName;          // pass name for current run
@@ -112,6 +124,7 @@ protected:
   Bool_t fReadOCDB;           // Flag to read thresholds from OCDB
   Bool_t fUseBXNumbers;       // Explicitly select "good" bunch crossing numbers
   Bool_t fUsingCustomClasses; // flag that is set if custom trigger classes are defined
+  Bool_t fCacheTriggerDecisions; // evaluate each trigger input once per event and use the compiled trigger logic
   TList fCollTrigClasses;     // trigger class identifying collision candidates
   TList fBGTrigClasses;       // trigger classes identifying background events
   TList fTriggerAnalysis;     // list of AliTriggerAnalysis objects (several are needed to keep the control histograms separate per trigger class)
@@ -128,7 +141,20 @@ protected:
   StringToRegexp* fTriggerToRegexp; //!
   TPRegexp& FindRegexp(const std::string& triggers) const;
 
-  ClassDef(AliPhysicsSelection, 24)
+  StringToTriggerProgram* fTriggerToProgram; //! Map trigger strings to compiled trigger logic
+  TriggerLogicProgram& FindProgram(const char* triggerLogic);
+
+  Int_t     fTriggerValues[kNTriggerSlots];         //! trigger inputs of the current event (online, offline)
+  ULong64_t fTriggerValuesFilled[kNTriggerSlots/64]; //! bit mask of the inputs already evaluated for the current event
+  AliTriggerAnalysis* fTriggerValuesOwner;           //! AliTriggerAnalysis object with which the cached inputs are evaluated
+  Bool_t    fUseTriggerValues;                       //! current AliTriggerAnalysis object has the configuration of fTriggerValuesOwner
+
+  TStopwatch fRunTimer;       //! timer for IsCollisionCandidate
+  Long64_t fRunEvents;        //! events processed in the current run
+  Double_t fRunRealTime;      //! real time spent in IsCollisionCandidate for the current run
+  Double_t fRunCpuTime;       //! CPU time spent in IsCollisionCandidate for the current run
+
+  ClassDef(AliPhysicsSelection, 25)
 private:
   AliPhysicsSelection(const AliPhysicsSelection&);
   AliPhysicsSelection& operator=(const AliPhysicsSelection&);
@@ -1,5 +1,6 @@
 #include "AliPhysicsSelectionTask.h"
 #include "AliPhysicsSelection.h"
+#include "AliOADBCache.h"
 #include "AliAnalysisManager.h"
 #include "AliInputEventHandler.h"
 #include "TFile.h"
@@ -88,12 +89,21 @@ void AliPhysicsSelectionTask::UserExec(Option_t*){
   PostData(1, fOutput);
 }
 
+Bool_t AliPhysicsSelectionTask::UserNotify(){
+  // called when a new input file is opened: preload the OADB objects for its run,
+  // so that the run change of the physics selection and of the other tasks using
+  // the shared OADB cache does not need to look them up
+  AliOADBCache::Instance()->PrefetchForFile(CurrentFileName());
+  return kTRUE;
+}
+
 void AliPhysicsSelectionTask::FinishTaskOutput(){
 // This gets called at the end of the processing on the worker. It allows dumping
 // statistics printed by the physics selection object to the statistics message
 // handled by the analysis manager.
    if (!fPhysicsSelection) return;
    fPhysicsSelection->FillStatistics();
+   AliOADBCache::Instance()->PrintStatistics();
 //   fPhysicsSelection->Print("STAT");
 }
 
@@ -22,6 +22,10 @@
 // Current support and development: Evgeny Kryshen, PNPI
 //-------------------------------------------------------------------------
 
+#include <cstring>
+#include <vector>
+#include "TClass.h"
+#include "TDataMember.h"
 #include "TF1.h"
 #include "TH1F.h"
 #include "TH2F.h"
@@ -175,6 +179,37 @@ void AliTriggerAnalysis::SetParameters(AliOADBTriggerAnalysis* oadb){
   fTRDnHJT              = oadb->GetTRDnHJT();
 }
 
+//-------------------------------------------------------------------------------------------------
+Bool_t AliTriggerAnalysis::HasSameConfiguration(const AliTriggerAnalysis* other) const {
+  // checks if the other object evaluates the triggers with the same settings
+  // (all parameters of AliOADBTriggerAnalysis, FO efficiency, flags), i.e. if
+  // trigger inputs evaluated with one of the objects are valid for the other one
+  if (!other) return kFALSE;
+  if (other == this) return kTRUE;
+  if (fSPDGFOEfficiency != other->fSPDGFOEfficiency || fDoFMD != other->fDoFMD ||
+      fMC != other->fMC || fPileupCutsEnabled != other->fPileupCutsEnabled) return kFALSE;
+
+  // location of the parameters in AliOADBTriggerAnalysis, size -1 for members which cannot be compared
+  static std::vector<std::pair<Long_t, Int_t> > parameters;
+  if (parameters.empty()) {
+    TIter next(AliOADBTriggerAnalysis::Class()->GetListOfDataMembers());
+    TDataMember* member = 0;
+    while ((member = static_cast<TDataMember*>(next()))) {
+      if (!member->IsPersistent()) continue;
+      Int_t size = member->GetUnitSize();
+      for (Int_t i = 0; i < member->GetArrayDim(); i++) size *= member->GetMaxIndex(i);
+      parameters.push_back(std::make_pair(member->GetOffset(), member->IsBasic() && !member->IsaPointer() ? size : -1));
+    }
+  }
+  const char* thisParameters  = reinterpret_cast<const char*>(static_cast<const AliOADBTriggerAnalysis*>(this));
+  const char* otherParameters = reinterpret_cast<const char*>(static_cast<const AliOADBTriggerAnalysis*>(other));
+  for (UInt_t i = 0; i < parameters.size(); i++) {
+    if (parameters[i].second < 0) return kFALSE;
+    if (memcmp(thisParameters + parameters[i].first, otherParameters + parameters[i].first, parameters[i].second)) return kFALSE;
+  }
+  return kTRUE;
+}
+
 //-------------------------------------------------------------------------------------------------
 AliTriggerAnalysis::~AliTriggerAnalysis(){
   delete fHistList;
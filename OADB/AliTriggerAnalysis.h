@@ -48,6 +48,7 @@ public:
   void SetAnalyzeMC(Bool_t flag = kTRUE) { fMC = flag; }
   void ApplyPileupCuts(Bool_t val = kTRUE) { fPileupCutsEnabled = val; }
   void SetParameters(AliOADBTriggerAnalysis* oadb);
+  Bool_t HasSameConfiguration(const AliTriggerAnalysis* other) const;
   Bool_t IsTriggerFired(const AliVEvent* event, Trigger trigger);
   Int_t EvaluateTrigger(const AliVEvent* event, Trigger trigger);
   Bool_t IsTriggerBitFired(const AliVEvent* event, ULong64_t tclass) const;
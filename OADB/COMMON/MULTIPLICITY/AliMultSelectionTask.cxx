@@ -82,6 +82,7 @@ class AliESDAD; //AD
 
 //For MultSelection Framework
 #include "AliOADBContainer.h"
+#include "AliOADBCache.h"
 #include "AliOADBMultSelection.h"
 #include "AliMultEstimator.h"
 #include "AliMultVariable.h"
@@ -2003,20 +2004,19 @@ Int_t AliMultSelectionTask::SetupRun(const AliVEvent* const esd)
         lOADBref = Form("BYPASS: %s", fAlternateOADBFullManualBypass.Data());
     }
 
-    //Open File without calling InitFromFile, don't load it all!
-    TFile * foadb = TFile::Open(fileName);
-    if(!foadb->IsOpen()) AliFatal(Form("Cannot open OADB file %s", fileName.Data()));
+    //Open File through the shared OADB cache: opened and read once per process
+    AliOADBCache *lOADBCache = AliOADBCache::Instance();
+    if(!lOADBCache->HasFile(fileName)) AliFatal(Form("Cannot open OADB file %s", fileName.Data()));
 
     //Managed to open, save name of opened OADB file
     lHistTitle.Append(Form(", OADB: %s",lOADBref.Data()));
     
-    AliOADBContainer * MultContainer = (AliOADBContainer*) foadb->Get("MultSel");
-    if(!MultContainer) AliFatal(Form("OADB file %s does not contain OADBContainer named MultSel, stopping here", fileName.Data()));
+    if(!lOADBCache->GetContainer(fileName, "MultSel")) AliFatal(Form("OADB file %s does not contain OADBContainer named MultSel, stopping here", fileName.Data()));
     
     //Get Object for this run!
-    TObject *lObjAcquired = 0x0;
+    const TObject *lObjAcquired = 0x0;
 
-    lObjAcquired = MultContainer->GetObject(fCurrentRun, "Default");
+    lObjAcquired = lOADBCache->GetObject(fileName, "MultSel", fCurrentRun, "Default");
 
     if (!lObjAcquired) {
         if ( fkUseDefaultCalib ) {
@@ -2025,7 +2025,7 @@ Int_t AliMultSelectionTask::SetupRun(const AliVEvent* const esd)
             AliWarning(" This is only a 'good guess'! Use with Care! ");
             AliWarning(" To Switch off this good guess, use SetUseDefaultCalib(kFALSE)");
             AliWarning("======================================================================");
-            lObjAcquired  = MultContainer->GetDefaultObject("oadbDefault");
+            lObjAcquired  = lOADBCache->GetDefaultObject(fileName, "MultSel", "oadbDefault");
         } else {
             AliWarning("======================================================================");
             AliWarning(Form(" Multiplicity OADB does not exist for run %d, will return kNoCalib!",fCurrentRun ));
@@ -2043,7 +2043,8 @@ Int_t AliMultSelectionTask::SetupRun(const AliVEvent* const esd)
         AliFatal("Really cannot find any OADB object - giving up!");
     }
 
-    AliOADBMultSelection *lObjTypecast = (AliOADBMultSelection*) lObjAcquired;
+    //The cached object is shared: work on a copy
+    const AliOADBMultSelection *lObjTypecast = (const AliOADBMultSelection*) lObjAcquired;
 
     fOadbMultSelection = new AliOADBMultSelection(*lObjTypecast);
     // De-couple histograms from the underlying file
@@ -2080,20 +2081,14 @@ Int_t AliMultSelectionTask::SetupRun(const AliVEvent* const esd)
         //Managed to open, save name of opened OADB file
         lHistTitle.Append(Form(", muOADB: %s",lmuOADBref.Data()));
         
-        //Open fileNameAlter
-        TFile * foadbAlter = 0x0;
-        foadbAlter = TFile::Open(fileNameAlter);
+        //Open fileNameAlter through the shared OADB cache
+        if(!lOADBCache->HasFile(fileNameAlter)) AliFatal(Form("Cannot open OADB file %s", fileNameAlter.Data()));
         
-        //Check existence, please
-        if(!foadbAlter) AliFatal(Form("Cannot open OADB file %s", fileNameAlter.Data()));
-        if(!foadbAlter->IsOpen()) AliFatal(Form("Cannot open OADB file %s", fileNameAlter.Data()));
-        
-        AliOADBContainer * MultContainerAlter = (AliOADBContainer*) foadbAlter->Get("MultSel");
-        if(!MultContainerAlter) AliFatal(Form("OADB file %s does not contain OADBContainer named MultSel, stopping here", fileNameAlter.Data()));
+        if(!lOADBCache->GetContainer(fileNameAlter, "MultSel")) AliFatal(Form("OADB file %s does not contain OADBContainer named MultSel, stopping here", fileNameAlter.Data()));
 
         //Get Object for this run
-        TObject *lObjAcquiredAlter = 0x0;
-        lObjAcquiredAlter = MultContainerAlter->GetObject(fCurrentRun, "Default");
+        const TObject *lObjAcquiredAlter = 0x0;
+        lObjAcquiredAlter = lOADBCache->GetObject(fileNameAlter, "MultSel", fCurrentRun, "Default");
         if (!lObjAcquiredAlter) {
             if ( fkUseDefaultMCCalib ) {
                 AliWarning("======================================================================");
@@ -2101,7 +2096,7 @@ Int_t AliMultSelectionTask::SetupRun(const AliVEvent* const esd)
                 AliWarning(" This is usually only approximately OK! Use with Care! ");
                 AliWarning(" To Switch off this good guess, use SetUseDefaultMCCalib(kFALSE)");
                 AliWarning("======================================================================");
-                lObjAcquiredAlter  = MultContainerAlter->GetDefaultObject("oadbDefault");
+                lObjAcquiredAlter  = lOADBCache->GetDefaultObject(fileNameAlter, "MultSel", "oadbDefault");
             } else {
                 AliWarning("======================================================================");
                 AliWarning(Form(" MC Multiplicity OADB does not exist for run %d, will return kNoCalib!",fCurrentRun ));
@@ -2120,7 +2115,7 @@ Int_t AliMultSelectionTask::SetupRun(const AliVEvent* const esd)
 
         //Actually, it's not required that we keep a copy of this object in memory. We only need to grab
         //the definitions... This can be much optimized!
-        AliOADBMultSelection *fOadbMultSelectionAlter = (AliOADBMultSelection*) lObjAcquiredAlter;
+        const AliOADBMultSelection *fOadbMultSelectionAlter = (const AliOADBMultSelection*) lObjAcquiredAlter;
         AliMultSelection* selAlter = fOadbMultSelectionAlter->GetMultSelection();
 
         //Sweep all estimators from standard OADB and replace their definitions...
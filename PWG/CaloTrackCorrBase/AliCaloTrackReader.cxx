@@ -44,6 +44,7 @@
 // ---- CaloTrackCorr ---
 #include "AliCalorimeterUtils.h"
 #include "AliCaloTrackReader.h"
+#include "AliIsolationConeIndex.h"
 
 // ---- Jets ----
 #include "AliAODJet.h"
@@ -132,7 +133,9 @@ fNonStandardJets(new TClonesArray("AliAODJet",100)),          fInputNonStandardJ
 fFillInputBackgroundJetBranch(kFALSE), 
 fBackgroundJets(0x0),fInputBackgroundJetBranchName("jets"),
 fAcceptEventsWithBit(0),     fRejectEventsWithBit(0),         fRejectEMCalTriggerEventsWith2Tresholds(0),
-fMomentum(),                 fOutputContainer(0x0),           
+fMomentum(),                 
+fUseIsolationConeIndex(kTRUE), fIsolationConeIndex(0x0),
+fOutputContainer(0x0),           
 fhEMCALClusterEtaPhi(0),     fhEMCALClusterEtaPhiFidCut(0),     
 fhEMCALClusterTimeE(0),
 fEnergyHistogramNbins(0),
@@ -215,6 +218,8 @@ void AliCaloTrackReader::DeletePointers()
     delete fNonStandardJets ;
   }
   delete fBackgroundJets ;
+  
+  delete fIsolationConeIndex ;
 
   fRejectEventsWithBit.Reset();
   fAcceptEventsWithBit.Reset();
@@ -1020,6 +1025,20 @@ Int_t AliCaloTrackReader::GetTrackID(AliVTrack* track)
   return track->GetID();
 }
 
+//_____________________________________________________
+/// \return eta-phi index of the track and cluster lists of
+/// this event, shared by the isolation cut of all the analyses
+/// using this reader. Null if switched off.
+//_____________________________________________________
+AliIsolationConeIndex * AliCaloTrackReader::GetIsolationConeIndex()
+{
+  if ( !fUseIsolationConeIndex ) return 0x0 ;
+  
+  if ( !fIsolationConeIndex ) fIsolationConeIndex = new AliIsolationConeIndex() ;
+  
+  return fIsolationConeIndex ;
+}
+
 //_____________________________
 /// Init the reader. 
 /// Method to be called in AliAnaCaloTrackCorrMaker.
@@ -1278,6 +1297,9 @@ Bool_t AliCaloTrackReader::FillInputEvent(Int_t iEntry, const char * /*curFileNa
   fIsTriggerMatchOpenCut[1] = kFALSE ;
   fIsTriggerMatchOpenCut[2] = kFALSE ;
   
+  // Lists of previous event are not valid anymore
+  if(fIsolationConeIndex) fIsolationConeIndex->Reset();
+  
   //fCurrentFileName = TString(currentFileName);
   if(!fInputEvent)
   {
@@ -51,6 +51,7 @@ class AliVCluster;
 // --- CaloTrackCorr / EMCAL ---
 #include "AliFiducialCut.h"
 class AliCalorimeterUtils;
+class AliIsolationConeIndex;
 #include "AliAnaWeights.h"
 
 // Jets
@@ -669,6 +670,12 @@ public:
   virtual AliMCEvent*       GetMC()                  const { return fMC                    ; }
   virtual AliMixedEvent*    GetMixedEvent()          const { return fMixedEvent            ; }
   virtual Int_t             GetNMixedEvent()         const { return fNMixedEvent           ; } 
+
+  // Eta-phi index of the lists, shared by the isolation cuts of the analyses
+  
+  AliIsolationConeIndex *   GetIsolationConeIndex() ;
+  void             SwitchOnIsolationConeIndex()            { fUseIsolationConeIndex = kTRUE  ; }
+  void             SwitchOffIsolationConeIndex()           { fUseIsolationConeIndex = kFALSE ; }
   
   void             SwitchOnStack()                         { AliError("Obsolete, remove this setting in AddTask") ; }
   void             SwitchOffStack()                        { AliError("Obsolete, remove this setting in AddTask") ; }
@@ -968,6 +975,9 @@ public:
   Bool_t           fRejectEMCalTriggerEventsWith2Tresholds; ///< Reject events EG2 also triggered by EG1 or EJ2 also triggered by EJ1.
   
   TLorentzVector   fMomentum;                      //!<! Temporal TLorentzVector container, avoid declaration of TLorentzVectors per event.
+
+  Bool_t           fUseIsolationConeIndex;         ///<  Index the lists in eta-phi for the isolation cone sums.
+  AliIsolationConeIndex * fIsolationConeIndex;     //!<! Eta-phi index of the lists of the event, built on demand.
     
   // cut control histograms
   
@@ -998,7 +1008,7 @@ public:
   AliCaloTrackReader & operator = (const AliCaloTrackReader & r) ; 
   
   /// \cond CLASSIMP
-  ClassDef(AliCaloTrackReader,79) ;
+  ClassDef(AliCaloTrackReader,80) ;
   /// \endcond
 
 } ;
@@ -0,0 +1,406 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// --- ROOT system ---
+#include <TObjArray.h>
+#include <TMath.h>
+
+// --- std ---
+#include <algorithm>
+
+// --- AliRoot system ---
+#include "AliVTrack.h"
+#include "AliVCluster.h"
+#include "AliVEvent.h"
+#include "AliMixedEvent.h"
+#include "AliEMCALGeoParams.h"
+
+// --- CaloTrackCorrelations ---
+#include "AliCaloTrackReader.h"
+#include "AliCaloTrackParticle.h"
+#include "AliCalorimeterUtils.h"
+#include "AliIsolationConeIndex.h"
+
+/// \cond CLASSIMP
+ClassImp(AliIsolationConeIndex) ;
+/// \endcond
+
+namespace
+{
+  // Eta-phi grid of the index. Entries out of the eta range go to an
+  // overflow bin, which is always selected.
+  const Int_t   kNEtaRows    = 40 ;
+  const Float_t kEtaMin      = -1. ;
+  const Float_t kEtaMax      =  1. ;
+  const Int_t   kNPhiColumns = 128 ;
+  const Int_t   kNBins       = kNEtaRows*kNPhiColumns ;
+
+  // EMCal (column,row) range of the cached channel status, same as
+  // the cells scanned in AliIsolationCut::GetCellDensity().
+  const Int_t   kNStatusCols = 2*AliEMCALGeoParams::fgkEMCALCols+1 ;
+  const Int_t   kNStatusRows = AliEMCALGeoParams::fgkEMCALRows*16/3+1 ;
+}
+
+//____________________________________
+/// Default constructor.
+//____________________________________
+AliIsolationConeIndex::AliIsolationConeIndex() :
+TObject(),
+fSlots(),
+fEMCALStatus(),
+fEMCALStatusRun(-1),
+fEMCALStatusCU(0x0),
+fMomentum(),
+fTrackVector()
+{
+}
+
+//____________________________________
+/// Forget the lists of the previous event.
+/// The channel status is kept until the run changes.
+//____________________________________
+void AliIsolationConeIndex::Reset()
+{
+  fSlots.clear();
+}
+
+//____________________________________
+/// \return row of the grid for eta, -1 if out of the grid.
+//____________________________________
+Int_t AliIsolationConeIndex::GetEtaRow(Float_t eta) const
+{
+  if ( !(eta >= kEtaMin && eta < kEtaMax) ) return -1 ;
+
+  Int_t row = Int_t((eta-kEtaMin)/(kEtaMax-kEtaMin)*kNEtaRows) ;
+  return TMath::Min(row, kNEtaRows-1) ;
+}
+
+//____________________________________
+/// \return column of the grid for phi in [0,2pi], -1 if not a number.
+//____________________________________
+Int_t AliIsolationConeIndex::GetPhiColumn(Float_t phi) const
+{
+  if ( !(phi >= 0. || phi < 0.) ) return -1 ;
+
+  Int_t col = Int_t(phi/TMath::TwoPi()*kNPhiColumns) ;
+  return TMath::Max(0, TMath::Min(col, kNPhiColumns-1)) ;
+}
+
+//____________________________________________________________________________
+/// Index the list if not done yet in this event.
+/// \param list: array of AliVTrack, AliVCluster or AliCaloTrackParticle.
+/// \param reader: reader of the event, needed for the cluster vertex and the track ID.
+/// \return slot of the list, to be used in the other methods.
+//____________________________________________________________________________
+Int_t AliIsolationConeIndex::GetListSlot(TObjArray * list, AliCaloTrackReader * reader)
+{
+  if ( !list || !reader ) return -1 ;
+
+  for(UInt_t islot = 0; islot < fSlots.size(); islot++)
+  {
+    if ( fSlots[islot].fList != list ) continue ;
+
+    if ( fSlots[islot].fNEntries != list->GetEntries() ) BuildList(fSlots[islot], list, reader) ;
+
+    return islot ;
+  }
+
+  fSlots.push_back(ListIndex());
+  BuildList(fSlots.back(), list, reader) ;
+
+  return fSlots.size()-1 ;
+}
+
+//____________________________________________________________________________
+/// Calculate the kinematics of the entries of the list, as done in
+/// AliIsolationCut::MakeIsolationCut(), and bin them.
+//____________________________________________________________________________
+void AliIsolationConeIndex::BuildList(ListIndex & index, TObjArray * list, AliCaloTrackReader * reader)
+{
+  Int_t nEntries = list->GetEntries() ;
+
+  index.fList     = list ;
+  index.fNEntries = nEntries ;
+  index.fPt  .assign(nEntries, 0.) ;
+  index.fEta .assign(nEntries, 0.) ;
+  index.fPhi .assign(nEntries, 0.) ;
+  index.fType.assign(nEntries, kNotUsed) ;
+  index.fBin .assign(nEntries, kNBins) ;
+  index.fIDs .clear() ;
+
+  for(Int_t ipr = 0; ipr < nEntries; ipr++)
+  {
+    TObject * obj = list->At(ipr) ;
+
+    Float_t pt  = 0 ;
+    Float_t eta = 0 ;
+    Float_t phi = 0 ;
+
+    AliVTrack   * track = dynamic_cast<AliVTrack*>  (obj) ;
+    AliVCluster * calo  = track ? 0x0 : dynamic_cast<AliVCluster*>(obj) ;
+
+    if ( track )
+    {
+      fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
+      pt  = fTrackVector.Pt();
+      eta = fTrackVector.Eta();
+      phi = fTrackVector.Phi() ;
+
+      index.fType[ipr] = kObject ;
+      index.fIDs.push_back(std::make_pair(reader->GetTrackID(track), ipr));
+    }
+    else if ( calo )
+    {
+      Int_t evtIndex = 0 ;
+      if (reader->GetMixedEvent())
+        evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
+
+      calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
+
+      pt  = fMomentum.Pt()  ;
+      eta = fMomentum.Eta() ;
+      phi = fMomentum.Phi() ;
+
+      index.fType[ipr] = kObject ;
+      index.fIDs.push_back(std::make_pair(calo->GetID(), ipr));
+    }
+    else
+    {
+      AliCaloTrackParticle * mix = dynamic_cast<AliCaloTrackParticle*>(obj) ;
+      if ( !mix ) continue ; // kept in the overflow bin
+
+      pt  = mix->Pt();
+      eta = mix->Eta();
+      phi = mix->Phi() ;
+
+      index.fType[ipr] = kMixed ;
+    }
+
+    if ( phi < 0 ) phi+=TMath::TwoPi();
+
+    index.fPt [ipr] = pt ;
+    index.fEta[ipr] = eta ;
+    index.fPhi[ipr] = phi ;
+
+    Int_t row = GetEtaRow(eta) ;
+    Int_t col = GetPhiColumn(phi) ;
+    if ( row >= 0 && col >= 0 ) index.fBin[ipr] = row*kNPhiColumns+col ;
+  }
+
+  std::sort(index.fIDs.begin(), index.fIDs.end());
+
+  // Counting sort of the entries by bin, the overflow bin is the last one
+  index.fBinStart.assign(kNBins+2, 0) ;
+  for(Int_t ipr = 0; ipr < nEntries; ipr++) index.fBinStart[index.fBin[ipr]+1]++ ;
+  for(Int_t ibin = 0; ibin < kNBins+1; ibin++) index.fBinStart[ibin+1] += index.fBinStart[ibin] ;
+
+  index.fOrder.assign(nEntries, 0) ;
+  std::vector<Int_t> next(index.fBinStart.begin(), index.fBinStart.end()-1) ;
+  for(Int_t ipr = 0; ipr < nEntries; ipr++) index.fOrder[next[index.fBin[ipr]]++] = ipr ;
+
+  // Prefix sums of pT of the rows and columns
+  index.fRowSum.assign(kNEtaRows+1, 0.) ;
+  index.fColSum.assign(kNPhiColumns+1, 0.) ;
+  for(Int_t ipr = 0; ipr < nEntries; ipr++)
+  {
+    Int_t bin = index.fBin[ipr] ;
+    if ( bin == kNBins ) continue ;
+
+    index.fRowSum[bin/kNPhiColumns+1] += index.fPt[ipr] ;
+    index.fColSum[bin%kNPhiColumns+1] += index.fPt[ipr] ;
+  }
+  for(Int_t row = 0; row < kNEtaRows;    row++) index.fRowSum[row+1] += index.fRowSum[row] ;
+  for(Int_t col = 0; col < kNPhiColumns; col++) index.fColSum[col+1] += index.fColSum[col] ;
+}
+
+//____________________________________________________________________________
+/// Get the list positions of the entries in the bins overlapping the box,
+/// the phi window is taken modulo 2pi. One bin of margin is added on each
+/// side, and the overflow bin is always added.
+/// \param entries: output, list positions in increasing order.
+//____________________________________________________________________________
+void AliIsolationConeIndex::SelectEntriesInBox(Int_t slot, Float_t etaMin, Float_t etaMax,
+                                               Float_t phiMin, Float_t phiMax, std::vector<Int_t> & entries) const
+{
+  entries.clear();
+
+  const ListIndex & index = fSlots[slot] ;
+
+  // Rows, clamped to the grid
+  Int_t rowMin = 0 ;
+  Int_t rowMax = kNEtaRows-1 ;
+  if      ( etaMin >= kEtaMax ) rowMax = -1 ;
+  else if ( etaMin >  kEtaMin ) rowMin = TMath::Max(0, GetEtaRow(etaMin)-1) ;
+  if      ( etaMax <  kEtaMin ) rowMax = -1 ;
+  else if ( etaMax <  kEtaMax ) rowMax = TMath::Min(rowMax, GetEtaRow(etaMax)+1) ;
+
+  // Columns, as ranges modulo the number of columns
+  Int_t colMin = 0 ;
+  Int_t nCols  = kNPhiColumns ;
+  if ( phiMax-phiMin < TMath::TwoPi() )
+  {
+    Float_t phiLow = phiMin ;
+    while ( phiLow <  0                ) phiLow += TMath::TwoPi() ;
+    while ( phiLow >= TMath::TwoPi()   ) phiLow -= TMath::TwoPi() ;
+
+    colMin = GetPhiColumn(phiLow)-1 ;
+    nCols  = Int_t((phiMax-phiMin)/TMath::TwoPi()*kNPhiColumns)+4 ;
+    nCols  = TMath::Min(nCols, kNPhiColumns) ;
+    if ( colMin < 0 ) colMin += kNPhiColumns ;
+  }
+
+  for(Int_t row = rowMin; row <= rowMax; row++)
+  {
+    for(Int_t icol = 0; icol < nCols; icol++)
+    {
+      Int_t bin = row*kNPhiColumns + (colMin+icol)%kNPhiColumns ;
+      for(Int_t i = index.fBinStart[bin]; i < index.fBinStart[bin+1]; i++)
+        entries.push_back(index.fOrder[i]);
+    }
+  }
+
+  for(Int_t i = index.fBinStart[kNBins]; i < index.fBinStart[kNBins+1]; i++)
+    entries.push_back(index.fOrder[i]);
+
+  std::sort(entries.begin(), entries.end());
+}
+
+//____________________________________________________________________________
+/// Get the list positions of the tracks or clusters with the given ID.
+/// Track IDs are the ones of AliCaloTrackReader::GetTrackID().
+//____________________________________________________________________________
+void AliIsolationConeIndex::GetEntriesWithID(Int_t slot, Int_t id, std::vector<Int_t> & entries) const
+{
+  entries.clear();
+
+  const std::vector< std::pair<Int_t,Int_t> > & ids = fSlots[slot].fIDs ;
+
+  std::vector< std::pair<Int_t,Int_t> >::const_iterator it =
+  std::lower_bound(ids.begin(), ids.end(), std::make_pair(id, -1)) ;
+
+  for( ; it != ids.end() && it->first == id; ++it) entries.push_back(it->second);
+}
+
+//____________________________________________________________________________
+/// \return sum of pT of the entries with etaMin < eta < etaMax, any phi.
+/// Full rows are taken from the prefix sums, the two edge rows and the
+/// overflow bin entry by entry.
+//____________________________________________________________________________
+Double_t AliIsolationConeIndex::GetSumPtInEtaStrip(Int_t slot, Float_t etaMin, Float_t etaMax) const
+{
+  const ListIndex & index = fSlots[slot] ;
+
+  Double_t sum = 0 ;
+
+  // Rows strictly between the rows of the edges are fully inside
+  Int_t rowMin = etaMin < kEtaMin ? -1        : GetEtaRow(etaMin) ;
+  Int_t rowMax = etaMax < kEtaMax ? GetEtaRow(etaMax) : kNEtaRows ;
+  if ( etaMin >= kEtaMax ) rowMin = kNEtaRows ;
+  if ( etaMax <  kEtaMin ) rowMax = -1 ;
+
+  if ( rowMax-rowMin > 1 ) sum += index.fRowSum[rowMax] - index.fRowSum[rowMin+1] ;
+
+  // Edge rows
+  for(Int_t iedge = 0; iedge < 2; iedge++)
+  {
+    Int_t row = iedge == 0 ? rowMin : rowMax ;
+    if ( row < 0 || row >= kNEtaRows || (iedge == 1 && row == rowMin) ) continue ;
+
+    for(Int_t i = index.fBinStart[row*kNPhiColumns]; i < index.fBinStart[(row+1)*kNPhiColumns]; i++)
+    {
+      Int_t ipr = index.fOrder[i] ;
+      if ( index.fEta[ipr] > etaMin && index.fEta[ipr] < etaMax ) sum += index.fPt[ipr] ;
+    }
+  }
+
+  // Overflow
+  for(Int_t i = index.fBinStart[kNBins]; i < index.fBinStart[kNBins+1]; i++)
+  {
+    Int_t ipr = index.fOrder[i] ;
+    if ( index.fType[ipr] == kNotUsed ) continue ;
+    if ( index.fEta[ipr] > etaMin && index.fEta[ipr] < etaMax ) sum += index.fPt[ipr] ;
+  }
+
+  return sum ;
+}
+
+//____________________________________________________________________________
+/// \return sum of pT of the entries with phiMin < phi < phiMax, any eta.
+/// phi of the entries is in [0,2pi[, the window is not taken modulo 2pi.
+//____________________________________________________________________________
+Double_t AliIsolationConeIndex::GetSumPtInPhiStrip(Int_t slot, Float_t phiMin, Float_t phiMax) const
+{
+  const ListIndex & index = fSlots[slot] ;
+
+  Double_t sum = 0 ;
+
+  Int_t colMin = phiMin < 0 ? -1 : GetPhiColumn(phiMin) ;
+  Int_t colMax = phiMax < TMath::TwoPi() ? GetPhiColumn(phiMax) : kNPhiColumns ;
+  if ( phiMin >= TMath::TwoPi() ) colMin = kNPhiColumns ;
+  if ( phiMax <  0              ) colMax = -1 ;
+
+  if ( colMax-colMin > 1 ) sum += index.fColSum[colMax] - index.fColSum[colMin+1] ;
+
+  // Edge columns, in all rows
+  for(Int_t iedge = 0; iedge < 2; iedge++)
+  {
+    Int_t col = iedge == 0 ? colMin : colMax ;
+    if ( col < 0 || col >= kNPhiColumns || (iedge == 1 && col == colMin) ) continue ;
+
+    for(Int_t row = 0; row < kNEtaRows; row++)
+    {
+      Int_t bin = row*kNPhiColumns+col ;
+      for(Int_t i = index.fBinStart[bin]; i < index.fBinStart[bin+1]; i++)
+      {
+        Int_t ipr = index.fOrder[i] ;
+        if ( index.fPhi[ipr] > phiMin && index.fPhi[ipr] < phiMax ) sum += index.fPt[ipr] ;
+      }
+    }
+  }
+
+  // Overflow
+  for(Int_t i = index.fBinStart[kNBins]; i < index.fBinStart[kNBins+1]; i++)
+  {
+    Int_t ipr = index.fOrder[i] ;
+    if ( index.fType[ipr] == kNotUsed ) continue ;
+    if ( index.fPhi[ipr] > phiMin && index.fPhi[ipr] < phiMax ) sum += index.fPt[ipr] ;
+  }
+
+  return sum ;
+}
+
+//____________________________________________________________________________
+/// Status of the EMCal cell at the absolute (column,row) used in the isolation
+/// bad cell normalization, cached per run. Cells out of the cached range
+/// are passed to AliCalorimeterUtils directly.
+//____________________________________________________________________________
+Int_t AliIsolationConeIndex::GetEMCALChannelStatus(AliCalorimeterUtils * cu, Int_t runNumber,
+                                                   Int_t icol, Int_t irow, Int_t cellSM, Int_t cellEta, Int_t cellPhi)
+{
+  if ( icol < 0 || icol >= kNStatusCols || irow < 0 || irow >= kNStatusRows )
+    return cu->GetEMCALChannelStatus(cellSM,cellEta,cellPhi) ;
+
+  if ( runNumber != fEMCALStatusRun || cu != fEMCALStatusCU || fEMCALStatus.empty() )
+  {
+    fEMCALStatus.assign(kNStatusCols*kNStatusRows, -1) ;
+    fEMCALStatusRun = runNumber ;
+    fEMCALStatusCU  = cu ;
+  }
+
+  Char_t & status = fEMCALStatus[icol*kNStatusRows+irow] ;
+  if ( status < 0 ) status = cu->GetEMCALChannelStatus(cellSM,cellEta,cellPhi) == 1 ? 1 : 0 ;
+
+  return status ;
+}
@@ -0,0 +1,119 @@
+#ifndef ALIISOLATIONCONEINDEX_H
+#define ALIISOLATIONCONEINDEX_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice     */
+
+//_________________________________________________________________________
+/// \class AliIsolationConeIndex
+/// \ingroup CaloTrackCorrelationsBase
+/// \brief Per event eta-phi index of the track and cluster lists, for isolation.
+///
+/// Owned by the reader and reset for each event, so that it is shared
+/// by all the analyses using the same reader. For each list of tracks or
+/// clusters requested, the (pT, eta, phi) of the entries are calculated
+/// once, as in AliIsolationCut::MakeIsolationCut, and binned in eta-phi
+/// with the sums of pT per eta row and per phi column. With it:
+///  * the entries that may be in a cone are found from the bins around it,
+///  * the pT sums in the eta and phi strips used for the UE bands are
+///    obtained from the row/column prefix sums plus the entries of the two
+///    edge rows/columns,
+///  * the entries with a given track/cluster ID are found directly.
+///
+/// It also keeps the EMCal channel status per (column, row) of the
+/// isolation bad cell normalization, filled on first use for each run.
+//_________________________________________________________________________
+
+// --- ROOT system ---
+#include <TObject.h>
+#include <TLorentzVector.h>
+#include <TVector3.h>
+class TObjArray ;
+
+// --- std ---
+#include <vector>
+#include <utility>
+
+// --- ANALYSIS system ---
+class AliCaloTrackReader ;
+class AliCalorimeterUtils ;
+
+class AliIsolationConeIndex : public TObject {
+
+ public:
+
+  AliIsolationConeIndex() ;  // default ctor
+
+  /// Virtual destructor.
+  virtual ~AliIsolationConeIndex() { ; }
+
+  void       Reset() ;
+
+  Int_t      GetListSlot(TObjArray * list, AliCaloTrackReader * reader) ;
+
+  /// \return pT of the entry at position ipr of the list of the slot.
+  Float_t    GetPt (Int_t slot, Int_t ipr) const { return fSlots[slot].fPt [ipr] ; }
+  /// \return eta of the entry at position ipr of the list of the slot.
+  Float_t    GetEta(Int_t slot, Int_t ipr) const { return fSlots[slot].fEta[ipr] ; }
+  /// \return phi, in [0,2pi[, of the entry at position ipr of the list of the slot.
+  Float_t    GetPhi(Int_t slot, Int_t ipr) const { return fSlots[slot].fPhi[ipr] ; }
+
+  void       SelectEntriesInBox(Int_t slot, Float_t etaMin, Float_t etaMax,
+                                Float_t phiMin, Float_t phiMax, std::vector<Int_t> & entries) const ;
+
+  void       GetEntriesWithID(Int_t slot, Int_t id, std::vector<Int_t> & entries) const ;
+
+  Double_t   GetSumPtInEtaStrip(Int_t slot, Float_t etaMin, Float_t etaMax) const ;
+
+  Double_t   GetSumPtInPhiStrip(Int_t slot, Float_t phiMin, Float_t phiMax) const ;
+
+  Int_t      GetEMCALChannelStatus(AliCalorimeterUtils * cu, Int_t runNumber,
+                                   Int_t icol, Int_t irow, Int_t cellSM, Int_t cellEta, Int_t cellPhi) ;
+
+ private:
+
+  /// Entry type of the lists.
+  enum entryType { kNotUsed = 0, kObject = 1, kMixed = 2 } ;
+
+  /// Index of one list of tracks or clusters.
+  struct ListIndex {
+    TObjArray *           fList ;      ///< Indexed list, not owned.
+    Int_t                 fNEntries ;  ///< Number of entries of the list when indexed.
+    std::vector<Float_t>  fPt ;        ///< pT per list position.
+    std::vector<Float_t>  fEta ;       ///< eta per list position.
+    std::vector<Float_t>  fPhi ;       ///< phi per list position, in [0,2pi[.
+    std::vector<UChar_t>  fType ;      ///< entryType per list position.
+    std::vector<Int_t>    fBin ;       ///< eta-phi bin per list position, overflow bin for entries out of the grid.
+    std::vector<Int_t>    fOrder ;     ///< List positions ordered by bin.
+    std::vector<Int_t>    fBinStart ;  ///< First entry of each bin in fOrder, size number of bins + 2.
+    std::vector<Double_t> fRowSum ;    ///< Prefix sums of pT in eta rows.
+    std::vector<Double_t> fColSum ;    ///< Prefix sums of pT in phi columns.
+    std::vector< std::pair<Int_t,Int_t> > fIDs ; ///< (ID, list position) of the tracks/clusters, sorted.
+  } ;
+
+  void       BuildList(ListIndex & index, TObjArray * list, AliCaloTrackReader * reader) ;
+
+  Int_t      GetEtaRow(Float_t eta) const ;
+  Int_t      GetPhiColumn(Float_t phi) const ;
+
+  std::vector<ListIndex> fSlots ;          //!<! Indexed lists of the event.
+
+  std::vector<Char_t>    fEMCALStatus ;    //!<! Cached EMCal channel status per (column,row), -1 if not yet known.
+  Int_t                  fEMCALStatusRun ; //!<! Run of the cached channel status.
+  AliCalorimeterUtils *  fEMCALStatusCU ;  //!<! Calorimeter utils of the cached channel status.
+
+  TLorentzVector         fMomentum;        //!<! Momentum of cluster, temporal object.
+  TVector3               fTrackVector;     //!<! Track moment, temporal object.
+
+  /// Copy constructor not implemented.
+  AliIsolationConeIndex(              const AliIsolationConeIndex & g) ;
+
+  /// Assignment operator not implemented.
+  AliIsolationConeIndex & operator = (const AliIsolationConeIndex & g) ;
+
+  /// \cond CLASSIMP
+  ClassDef(AliIsolationConeIndex,1) ;
+  /// \endcond
+
+} ;
+
+#endif //ALIISOLATIONCONEINDEX_H
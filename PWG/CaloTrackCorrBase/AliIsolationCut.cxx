@@ -31,6 +31,7 @@
 #include "AliCaloPID.h"
 #include "AliFiducialCut.h"
 #include "AliIsolationCut.h"
+#include "AliIsolationConeIndex.h"
 
 /// \cond CLASSIMP
 ClassImp(AliIsolationCut) ;
@@ -54,7 +55,9 @@ fFracIsThresh(1),
 fIsTMClusterInConeRejected(1),
 fDistMinToTrigger(-1.),
 fMomentum(),
-fTrackVector()
+fTrackVector(),
+fConeIndexEntries(),
+fConeIndexIDEntries()
 {
   InitParameters();
 }
@@ -184,6 +187,10 @@ Float_t AliIsolationCut::GetCellDensity(AliCaloTrackParticleCorrelation * pCandi
   {
     AliEMCALGeometry* eGeom = AliEMCALGeometry::GetInstance();
     AliCalorimeterUtils *cu = reader->GetCaloUtils();
+    
+    // Channel status cached per run, shared by the analyses of the reader
+    AliIsolationConeIndex * coneIndex = reader->GetIsolationConeIndex();
+    Int_t runNumber = reader->GetInputEvent() ? reader->GetInputEvent()->GetRunNumber() : -1;
 
     Int_t absId = -999;
     if (eGeom->GetAbsCellIdFromEtaPhi(etaC,phiC,absId))
@@ -229,7 +236,9 @@ Float_t AliIsolationCut::GetCellDensity(AliCaloTrackParticleCorrelation * pCandi
               coneCellsBad += 1.;
             }
             //Count as bad "cells" marked as bad in the DataBase
-            else if (cu->GetEMCALChannelStatus(cellSM,cellEta,cellPhi)==1)
+            else if ( coneIndex ?
+                      coneIndex->GetEMCALChannelStatus(cu,runNumber,icol,irow,cellSM,cellEta,cellPhi)==1 :
+                      cu->GetEMCALChannelStatus(cellSM,cellEta,cellPhi)==1 )
             {
               coneCellsBad += 1. ;
             }
@@ -271,6 +280,10 @@ void AliIsolationCut::GetCoeffNormBadCell(AliCaloTrackParticleCorrelation * pCan
     AliEMCALGeometry* eGeom = AliEMCALGeometry::GetInstance();
     AliCalorimeterUtils *cu = reader->GetCaloUtils();
 
+    // Channel status cached per run, shared by the analyses of the reader
+    AliIsolationConeIndex * coneIndex = reader->GetIsolationConeIndex();
+    Int_t runNumber = reader->GetInputEvent() ? reader->GetInputEvent()->GetRunNumber() : -1;
+
     Int_t absId = -999;
     if (eGeom->GetAbsCellIdFromEtaPhi(etaC,phiC,absId))
     {
@@ -292,6 +305,7 @@ void AliIsolationCut::GetCoeffNormBadCell(AliCaloTrackParticleCorrelation * pCan
           if     ( Radius(colC, rowC, icol, irow) < sqrSize ) { coneCells    += 1.; }
           else if( icol>colC-sqrSize  &&  icol<colC+sqrSize ) { phiBandCells += 1 ; }
           else if( irow>rowC-sqrSize  &&  irow<rowC+sqrSize ) { etaBandCells += 1 ; }
+          else continue ; // bad cells out of the cone and bands are not counted
 
           Int_t cellSM  = -999;
           Int_t cellEta = -999;
@@ -311,7 +325,9 @@ void AliIsolationCut::GetCoeffNormBadCell(AliCaloTrackParticleCorrelation * pCan
 
           if( (icol < 0 || icol > AliEMCALGeoParams::fgkEMCALCols*2-1 ||
                irow < 0 || irow > AliEMCALGeoParams::fgkEMCALRows*5 - 1) //5*nRows+1/3*nRows //Count as bad "cells" out of EMCAL acceptance
-             || (cu->GetEMCALChannelStatus(cellSM,cellEta,cellPhi)==1))  //Count as bad "cells" marked as bad in the DataBase
+             || (coneIndex ?
+                 coneIndex->GetEMCALChannelStatus(cu,runNumber,icol,irow,cellSM,cellEta,cellPhi)==1 :
+                 cu->GetEMCALChannelStatus(cellSM,cellEta,cellPhi)==1))  //Count as bad "cells" marked as bad in the DataBase
           {
             if     ( Radius(colC, rowC, icol, irow) < sqrSize ) coneBadCellsCoeff    += 1.;
             else if( icol>colC-sqrSize  &&  icol<colC+sqrSize ) phiBandBadCellsCoeff += 1 ;
@@ -345,6 +361,73 @@ void AliIsolationCut::GetCoeffNormBadCell(AliCaloTrackParticleCorrelation * pCan
   }
 }
 
+//________________________________________________________________________________
+/// Use the eta-phi index of the lists kept by the reader, if available,
+/// to select the entries of the list that can be in the cone and to get
+/// the pT sums of the UE bands, as done in the loop of MakeIsolationCut().
+///
+/// \param list: list of tracks or clusters.
+/// \param reader: pointer to AliCaloTrackReader, owner of the index.
+/// \param etaC: pseudorapidity of candidate particle.
+/// \param phiC: azimuthal angle of candidate particle, in [0,2pi[.
+/// \param nIDs: number of track/cluster IDs of the candidate.
+/// \param ids: track/cluster IDs of the candidate, not counted.
+/// \param phiBandPtSum: output, pT sum in the phi band without the entries in the cone (to be removed in the loop).
+/// \param etaBandPtSum: output, pT sum in the eta band without the entries in the cone (to be removed in the loop).
+/// \return slot of the list in the index, -1 if the index cannot be used. The selected
+/// entries, in increasing list position, are in fConeIndexEntries.
+//________________________________________________________________________________
+Int_t AliIsolationCut::SelectEntriesWithConeIndex(TObjArray * list, AliCaloTrackReader * reader,
+                                                  Float_t etaC, Float_t phiC, Int_t nIDs, const Int_t * ids,
+                                                  Float_t & phiBandPtSum, Float_t & etaBandPtSum)
+{
+  fConeIndexEntries.clear();
+  
+  // Entries rejected by distance to the candidate but out of the cone would count in the bands
+  if ( fDistMinToTrigger > fConeSize ) return -1 ;
+  
+  AliIsolationConeIndex * coneIndex = reader->GetIsolationConeIndex();
+  if ( !coneIndex ) return -1 ;
+  
+  Int_t slot = coneIndex->GetListSlot(list, reader);
+  if ( slot < 0 ) return -1 ;
+  
+  // All the entries of the strips
+  phiBandPtSum = coneIndex->GetSumPtInEtaStrip(slot, etaC-fConeSize, etaC+fConeSize);
+  etaBandPtSum = coneIndex->GetSumPtInPhiStrip(slot, phiC-fConeSize, phiC+fConeSize);
+  
+  // Remove the candidate and its daughters, skipped in the loop
+  for(Int_t i = 0; i < nIDs; i++)
+  {
+    Bool_t done = kFALSE;
+    for(Int_t j = 0; j < i; j++)
+    {
+      if ( ids[j] == ids[i] ) done = kTRUE;
+    }
+    
+    if ( done ) continue ;
+    
+    coneIndex->GetEntriesWithID(slot, ids[i], fConeIndexIDEntries);
+    
+    for(UInt_t ie = 0; ie < fConeIndexIDEntries.size(); ie++)
+    {
+      Int_t   ipr = fConeIndexIDEntries[ie];
+      Float_t pt  = coneIndex->GetPt (slot, ipr);
+      Float_t eta = coneIndex->GetEta(slot, ipr);
+      Float_t phi = coneIndex->GetPhi(slot, ipr);
+      
+      if(eta > (etaC-fConeSize) && eta < (etaC+fConeSize)) phiBandPtSum -= pt;
+      if(phi > (phiC-fConeSize) && phi < (phiC+fConeSize)) etaBandPtSum -= pt;
+    }
+  }
+  
+  // Entries that can be in the cone, the ones in the cone are removed from the bands in the loop
+  coneIndex->SelectEntriesInBox(slot, etaC-fConeSize, etaC+fConeSize,
+                                phiC-fConeSize, phiC+fConeSize, fConeIndexEntries);
+  
+  return slot;
+}
+
 //____________________________________________
 // Put data member values in string to keep
 // in output container.
@@ -462,8 +545,22 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   if(plCTS &&
      (fPartInCone==kOnlyCharged || fPartInCone==kNeutralAndCharged))
   {
-    for(Int_t ipr = 0;ipr < plCTS->GetEntries() ; ipr ++ )
+    // With the reader cone index, only the tracks around the cone are checked,
+    // and the UE bands are obtained from the eta/phi strip sums.
+    // Track labels of the candidate only count for candidates made of tracks.
+    Int_t nIDs = pCandidate->GetDetectorTag() == AliFiducialCut::kCTS ? 4 : 0 ;
+    Int_t trackIDs[] = { pCandidate->GetTrackLabel(0), pCandidate->GetTrackLabel(1),
+                         pCandidate->GetTrackLabel(2), pCandidate->GetTrackLabel(3) } ;
+    
+    Int_t trackSlot = SelectEntriesWithConeIndex(plCTS, reader, etaC, phiC, nIDs, trackIDs,
+                                                 phiBandPtSumTrack, etaBandPtSumTrack) ;
+    
+    Int_t nTracks = trackSlot >= 0 ? (Int_t) fConeIndexEntries.size() : plCTS->GetEntries() ;
+    
+    for(Int_t itr = 0; itr < nTracks ; itr ++ )
     {
+      Int_t ipr = trackSlot >= 0 ? fConeIndexEntries[itr] : itr ;
+      
       AliVTrack* track = dynamic_cast<AliVTrack*>(plCTS->At(ipr)) ;
       
       if(track)
@@ -509,13 +606,21 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
       
       rad = Radius(etaC, phiC, eta, phi);
       
+      // ** Remove the cone from the strip sums of the index **
+      
+      if(trackSlot >= 0 && rad <= fConeSize)
+      {
+        if(eta > (etaC-fConeSize) && eta < (etaC+fConeSize)) phiBandPtSumTrack -= pt;
+        if(phi > (phiC-fConeSize) && phi < (phiC+fConeSize)) etaBandPtSumTrack -= pt;
+      }
+      
       // ** Exclude tracks too close to the candidate, inactive by default **
       
       if(rad < fDistMinToTrigger) continue ;
       
       // ** For the background out of cone **
       
-      if(rad > fConeSize)
+      if(trackSlot < 0 && rad > fConeSize)
       {
         if(eta > (etaC-fConeSize) && eta < (etaC+fConeSize)) phiBandPtSumTrack += pt;
         if(phi > (phiC-fConeSize) && phi < (phiC+fConeSize)) etaBandPtSumTrack += pt;
@@ -607,9 +712,22 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   if(plNe &&
      (fPartInCone==kOnlyNeutral || fPartInCone==kNeutralAndCharged))
   {
+    // With the reader cone index, only the clusters around the cone are checked.
+    // Not possible if the track matched clusters are rejected, the bands need the
+    // matching of all the clusters.
+    Int_t caloIDs[] = { pCandidate->GetCaloLabel(0), pCandidate->GetCaloLabel(1) } ;
+    
+    Int_t caloSlot = -1 ;
+    if ( !fIsTMClusterInConeRejected || fPartInCone != kNeutralAndCharged )
+      caloSlot = SelectEntriesWithConeIndex(plNe, reader, etaC, phiC, 2, caloIDs,
+                                            phiBandPtSumCluster, etaBandPtSumCluster) ;
+    
+    Int_t nCalo = caloSlot >= 0 ? (Int_t) fConeIndexEntries.size() : plNe->GetEntries() ;
     
-    for(Int_t ipr = 0;ipr < plNe->GetEntries() ; ipr ++ )
+    for(Int_t icl = 0; icl < nCalo ; icl ++ )
     {
+      Int_t ipr = caloSlot >= 0 ? fConeIndexEntries[icl] : icl ;
+      
       AliVCluster * calo = dynamic_cast<AliVCluster *>(plNe->At(ipr)) ;
       
       if(calo)
@@ -658,13 +776,21 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
       
       rad = Radius(etaC, phiC, eta, phi);
       
+      // ** Remove the cone from the strip sums of the index **
+      
+      if(caloSlot >= 0 && rad <= fConeSize)
+      {
+        if(eta > (etaC-fConeSize) && eta < (etaC+fConeSize)) phiBandPtSumCluster -= pt;
+        if(phi > (phiC-fConeSize) && phi < (phiC+fConeSize)) etaBandPtSumCluster -= pt;
+      }
+      
       // ** Exclude clusters too close to the candidate, inactive by default **
       
       if(rad < fDistMinToTrigger) continue ;
       
       // ** For the background out of cone **
       
-      if(rad > fConeSize)
+      if(caloSlot < 0 && rad > fConeSize)
       {
         if(eta > (etaC-fConeSize) && eta < (etaC+fConeSize)) phiBandPtSumCluster += pt;
         if(phi > (phiC-fConeSize) && phi < (phiC+fConeSize)) etaBandPtSumCluster += pt;
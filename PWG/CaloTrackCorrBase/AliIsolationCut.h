@@ -23,6 +23,9 @@
 class TObjArray ;
 #include <TLorentzVector.h>
 
+// --- std ---
+#include <vector>
+
 // --- ANALYSIS system ---
 class AliCaloTrackParticleCorrelation ;
 class AliCaloTrackReader ;
@@ -140,6 +143,14 @@ class AliIsolationCut : public TObject {
 
   TVector3   fTrackVector;       //!<! Track moment, temporal object.
 
+  Int_t      SelectEntriesWithConeIndex(TObjArray * list, AliCaloTrackReader * reader,
+                                        Float_t etaC, Float_t phiC, Int_t nIDs, const Int_t * ids,
+                                        Float_t & phiBandPtSum, Float_t & etaBandPtSum) ;
+
+  std::vector<Int_t> fConeIndexEntries;   //!<! List positions around the cone, from the reader cone index, temporal.
+
+  std::vector<Int_t> fConeIndexIDEntries; //!<! List positions of the candidate daughters, temporal.
+
   /// Copy constructor not implemented.
   AliIsolationCut(              const AliIsolationCut & g) ;
 
@@ -147,7 +158,7 @@ class AliIsolationCut : public TObject {
   AliIsolationCut & operator = (const AliIsolationCut & g) ; 
 
   /// \cond CLASSIMP
-  ClassDef(AliIsolationCut,11) ;
+  ClassDef(AliIsolationCut,12) ;
   /// \endcond
 
 } ;
@@ -111,6 +111,22 @@ AliVCluster* AliClusterContainer::GetLeadingCluster(const char* opt)
     momentum = &AliTLorentzVector::Et;
   }
 
+  const AcceptanceCache *cache = GetAcceptanceCache();
+  if (cache) {
+    // Cluster momenta are massless, therefore Et corresponds to the cached pt
+    if (!cache->fIndices.size()) return 0;
+    Int_t posMax = cache->fPtOrder[0];
+    if (option.Contains("e")) {
+      posMax = 0;
+      for (UInt_t ipos = 1; ipos < cache->fIndices.size(); ipos++) {
+        if (cache->fE[ipos] > cache->fE[posMax]) posMax = ipos;
+      }
+      if (!(cache->fE[posMax] > 0)) return 0;
+    }
+    else if (!(cache->fPt[posMax] > 0)) return 0;
+    return GetCluster(cache->fIndices[posMax]);
+  }
+
   AliClusterIterableMomentumContainer::momentum_object_pair clusterMax;
 
   for (auto cluster : accepted_momentum()) {
@@ -145,6 +161,12 @@ AliVCluster* AliClusterContainer::GetAcceptCluster(Int_t i) const
   AliVCluster *vc = GetCluster(i);
   if (!vc) return 0;
 
+  if (GetAcceptanceCache(kFALSE)) {
+    if (IsAccepted(i)) return vc;
+    AliDebug(2,"Cluster not accepted.");
+    return 0;
+  }
+
   UInt_t rejectionReason = 0;
   if (AcceptCluster(vc, rejectionReason))
     return vc;
@@ -182,6 +204,8 @@ AliVCluster* AliClusterContainer::GetAcceptClusterWithLabel(Int_t lab) const
  */
 AliVCluster* AliClusterContainer::GetNextAcceptCluster() 
 {
+  // Make sure the acceptance cache matches the current cut configuration at the start of the iteration
+  if (fCurrentID < 0) GetAcceptanceCache();
   const Int_t n = GetNEntries();
   AliVCluster *c = 0;
   do {
@@ -421,6 +445,8 @@ Bool_t AliClusterContainer::ApplyClusterCuts(const AliVCluster* clus, UInt_t &re
  */
 Int_t AliClusterContainer::GetNAcceptedClusters() const
 {
+  const AcceptanceCache *cache = GetAcceptanceCache();
+  if (cache) return cache->fIndices.size();
   UInt_t rejectionReason = 0;
   Int_t nClus = 0;
   for(int iclust = 0; iclust < this->fClArray->GetEntries(); ++iclust){
@@ -458,6 +484,26 @@ void AliClusterContainer::SetClusUserDefEnergyCut(Int_t t, Double_t cut)
   else {
     fMinE = cut;
   }
+  CutsChanged();
+}
+
+/**
+ * Add the cluster selection settings to the cut values of the base class.
+ * @param[out] values Cut values
+ * @return Class whose selection settings are all contained in the values
+ */
+TClass *AliClusterContainer::GetCutValues(std::vector<Double_t> &values) const
+{
+  AliEmcalContainer::GetCutValues(values);
+  Double_t cuts[] = {
+    fClusTimeCutLow, fClusTimeCutUp, static_cast<Double_t>(fExoticCut),
+    static_cast<Double_t>(fDefaultClusterEnergy), static_cast<Double_t>(fIncludePHOS),
+    static_cast<Double_t>(fIncludePHOSonly), static_cast<Double_t>(fPhosMinNcells), fPhosMinM02,
+    fEmcalMinM02, fEmcalMaxM02, fEmcalMaxM02CutEnergy
+  };
+  values.insert(values.end(), cuts, cuts + sizeof(cuts)/sizeof(cuts[0]));
+  values.insert(values.end(), fUserDefEnergyCut, fUserDefEnergyCut + AliVCluster::kLastUserDefEnergy + 1);
+  return AliClusterContainer::Class();
 }
 
 /**
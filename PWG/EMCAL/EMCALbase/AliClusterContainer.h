@@ -66,24 +66,24 @@ class AliClusterContainer : public AliEmcalContainer {
   AliVCluster                *GetNextCluster();
   Int_t                       GetNClusters()                         const { return GetNEntries();   }
   Int_t                       GetNAcceptedClusters()                 const;
-  void                        SetClusTimeCut(Double_t min, Double_t max)   { fClusTimeCutLow  = min ; fClusTimeCutUp = max ; }
-  void                        SetMinMCLabel(Int_t s)                       { fMinMCLabel      = s   ; }
-  void                        SetMaxMCLabel(Int_t s)                       { fMaxMCLabel      = s   ; }
+  void                        SetClusTimeCut(Double_t min, Double_t max)   { fClusTimeCutLow  = min ; fClusTimeCutUp = max ; CutsChanged(); }
+  void                        SetMinMCLabel(Int_t s)                       { fMinMCLabel      = s   ; CutsChanged(); }
+  void                        SetMaxMCLabel(Int_t s)                       { fMaxMCLabel      = s   ; CutsChanged(); }
   void                        SetMCLabelRange(Int_t min, Int_t max)        { SetMinMCLabel(min)     ; SetMaxMCLabel(max)    ; }
-  void                        SetExoticCut(Bool_t e)                       { fExoticCut       = e   ; }
-  void                        SetIncludePHOS(Bool_t b)                     { fIncludePHOS = b       ; }
-  void                        SetIncludePHOSonly(Bool_t b)                 { fIncludePHOSonly = b   ; }
-  void                        SetPhosMinNcells(Int_t n)                    { fPhosMinNcells = n; }
-  void                        SetPhosMinM02(Double_t m)                    { fPhosMinM02 = m; }
-  void 						            SetEmcalM02Range(Double_t min, Double_t max) { fEmcalMinM02 = min; fEmcalMaxM02 = max; }
-  void                        SetEmcalMaxM02Energy(Double_t max)           { fEmcalMaxM02CutEnergy = max; }
+  void                        SetExoticCut(Bool_t e)                       { fExoticCut       = e   ; CutsChanged(); }
+  void                        SetIncludePHOS(Bool_t b)                     { fIncludePHOS = b       ; CutsChanged(); }
+  void                        SetIncludePHOSonly(Bool_t b)                 { fIncludePHOSonly = b   ; CutsChanged(); }
+  void                        SetPhosMinNcells(Int_t n)                    { fPhosMinNcells = n; CutsChanged(); }
+  void                        SetPhosMinM02(Double_t m)                    { fPhosMinM02 = m; CutsChanged(); }
+  void 						            SetEmcalM02Range(Double_t min, Double_t max) { fEmcalMinM02 = min; fEmcalMaxM02 = max; CutsChanged(); }
+  void                        SetEmcalMaxM02Energy(Double_t max)           { fEmcalMaxM02CutEnergy = max; CutsChanged(); }
   void                        SetArray(const AliVEvent * event);
   void                        SetClusUserDefEnergyCut(Int_t t, Double_t cut);
   Double_t                    GetClusUserDefEnergyCut(Int_t t) const;
 
   void                        SetClusNonLinCorrEnergyCut(Double_t cut)                     { SetClusUserDefEnergyCut(AliVCluster::kNonLinCorr, cut); }
   void                        SetClusHadCorrEnergyCut(Double_t cut)                        { SetClusUserDefEnergyCut(AliVCluster::kHadCorr, cut)   ; }
-  void                        SetDefaultClusterEnergy(Int_t d)                             { fDefaultClusterEnergy = d                             ; }
+  void                        SetDefaultClusterEnergy(Int_t d)                             { fDefaultClusterEnergy = d                             ; CutsChanged(); }
 
   Int_t                       GetDefaultClusterEnergy() const                              { return fDefaultClusterEnergy                          ; }
 
@@ -110,6 +110,7 @@ class AliClusterContainer : public AliEmcalContainer {
    * @return Appropriate default array name
    */
   virtual TString             GetDefaultArrayName(const AliVEvent * const ev) const;
+  virtual TClass             *GetCutValues(std::vector<Double_t> &values) const;
 
   
 #if !(defined(__CINT__) || defined(__MAKECINT__))
@@ -13,6 +13,9 @@
  * provided "as is" without express or implied warranty.                  *
  **************************************************************************/
 
+// C++ includes
+#include <algorithm>
+
 // ROOT includes
 #include <TH2F.h>
 #include <TArrayI.h>
@@ -75,7 +78,16 @@ AliEMCALRecoUtils::AliEMCALRecoUtils():
   fCutRequireTPCRefit(kFALSE),            fCutRequireITSRefit(kFALSE),            fCutAcceptKinkDaughters(kFALSE),
   fCutMaxDCAToVertexXY(0),                fCutMaxDCAToVertexZ(0),                 fCutDCAToVertex2D(kFALSE),
   fCutRequireITSStandAlone(kFALSE),       fCutRequireITSpureSA(kFALSE),             
-  fNMCGenerToAccept(0),                   fMCGenerToAcceptForTrack(1)
+  fNMCGenerToAccept(0),                   fMCGenerToAcceptForTrack(1),
+  fCalibSnapshotValid(kFALSE),            fCalibSnapshotNCells(0),
+  fCalibCellSM(),                         fCalibBadChannel(),                     fCalibEnergyFactor(),
+  fCalibTimeShift(),                      fCalibL1PhaseShift(),                   fCalibL1ShiftOffset(),
+  fCalibCrossCells(),
+  fCellBufferAbsId(),                     fCellBufferAmp(),                       fCellBufferTime(),
+  fCellBufferLowGain(),                   fCellBufferMCLabel(),                   fCellBufferEFrac(),
+  fClusterIndexArr(0x0),                  fClusterIndexStart(),                   fClusterIndexEntries(),
+  fClusterIndexBucket(),                  fClusterCandidates(),
+  fNSurfacePropagations(0),               fNClusterPropagations(0)
 {
   // Init parameters
   InitParameters();
@@ -132,7 +144,16 @@ AliEMCALRecoUtils::AliEMCALRecoUtils(const AliEMCALRecoUtils & reco)
   fCutAcceptKinkDaughters(reco.fCutAcceptKinkDaughters),     fCutMaxDCAToVertexXY(reco.fCutMaxDCAToVertexXY),    
   fCutMaxDCAToVertexZ(reco.fCutMaxDCAToVertexZ),             fCutDCAToVertex2D(reco.fCutDCAToVertex2D),
   fCutRequireITSStandAlone(reco.fCutRequireITSStandAlone),   fCutRequireITSpureSA(reco.fCutRequireITSpureSA),
-  fNMCGenerToAccept(reco.fNMCGenerToAccept),                 fMCGenerToAcceptForTrack(reco.fMCGenerToAcceptForTrack)
+  fNMCGenerToAccept(reco.fNMCGenerToAccept),                 fMCGenerToAcceptForTrack(reco.fMCGenerToAcceptForTrack),
+  fCalibSnapshotValid(kFALSE),                               fCalibSnapshotNCells(0),
+  fCalibCellSM(),            fCalibBadChannel(),             fCalibEnergyFactor(),
+  fCalibTimeShift(),         fCalibL1PhaseShift(),           fCalibL1ShiftOffset(),
+  fCalibCrossCells(),
+  fCellBufferAbsId(),        fCellBufferAmp(),               fCellBufferTime(),
+  fCellBufferLowGain(),      fCellBufferMCLabel(),           fCellBufferEFrac(),
+  fClusterIndexArr(0x0),     fClusterIndexStart(),           fClusterIndexEntries(),
+  fClusterIndexBucket(),     fClusterCandidates(),
+  fNSurfacePropagations(0),  fNClusterPropagations(0)
 {  
   for (Int_t i = 0; i < 15 ; i++) { fMisalRotShift[i]      = reco.fMisalRotShift[i]      ; 
                                     fMisalTransShift[i]    = reco.fMisalTransShift[i]    ; }
@@ -334,6 +355,8 @@ AliEMCALRecoUtils & AliEMCALRecoUtils::operator = (const AliEMCALRecoUtils & rec
     for(int ism = 0; ism < reco.fEMCALL1PhaseInTimeRecalibration->GetEntries(); ism++) fEMCALL1PhaseInTimeRecalibration->AddAt(reco.fEMCALL1PhaseInTimeRecalibration->At(ism), ism);
   }
 
+  fCalibSnapshotValid = kFALSE;
+
   return *this;
 }
 
@@ -389,46 +412,51 @@ Bool_t AliEMCALRecoUtils::AcceptCalibrateCell(Int_t absID, Int_t bc,
                                               Float_t  & amp,    Double_t & time, 
                                               AliVCaloCells* cells) 
 {  
-  AliEMCALGeometry* geom = AliEMCALGeometry::GetInstance();
-  
-  if(!geom)
-  {
-    AliError("No instance of the geometry is available");
+  if (!UpdateCalibrationSnapshot()) 
     return kFALSE;
-  }
 
-  if ( absID < 0 || absID >= 24*48*geom->GetNumberOfSuperModules() ) 
+  if ( absID < 0 || absID >= fCalibSnapshotNCells ) 
     return kFALSE;
   
-  Int_t imod = -1, iphi =-1, ieta=-1,iTower = -1, iIphi = -1, iIeta = -1; 
+  Int_t imod = fCalibCellSM[absID];
   
-  if (!geom->GetCellIndex(absID,imod,iTower,iIphi,iIeta)) 
+  if (imod < 0) 
   {
     // cell absID does not exist
     amp=0; time = 1.e9;
     return kFALSE; 
   }
   
-  geom->GetCellPhiEtaIndexInSModule(imod,iTower,iIphi, iIeta,iphi,ieta);  
-
   // Do not include bad channels found in analysis,
-  if (IsBadChannelsRemovalSwitchedOn() && GetEMCALChannelStatus(imod, ieta, iphi)) 
+  if (IsBadChannelsRemovalSwitchedOn() && fCalibBadChannel[absID]) 
     return kFALSE;
   
   //Recalibrate energy
   amp  = cells->GetCellAmplitude(absID);
   if (!fCellsRecalibrated && IsRecalibrationOn())
-    amp *= GetEMCALChannelRecalibrationFactor(imod,ieta,iphi);
+    amp *= fCalibEnergyFactor[absID];
   
   // Recalibrate time
   time = cells->GetCellTime(absID);
   time-=fConstantTimeShift*1e-9; // only in case of old Run1 simulation
-  Bool_t isLowGain = !(cells->GetCellHighGain(absID));//HG = false -> LG = true
 
-  RecalibrateCellTime(absID,bc,time,isLowGain);
+  if (!fCellsRecalibrated && bc >= 0) 
+  {
+    Int_t bc4 = bc%4;
+
+    if (IsTimeRecalibrationOn()) 
+    {
+      Bool_t isLowGain = fLowGain && !(cells->GetCellHighGain(absID));//HG = false -> LG = true
+      time -= fCalibTimeShift[(bc4+4*isLowGain)*fCalibSnapshotNCells+absID]*1.e-9;
+    }
   
-  //Recalibrate time with L1 phase 
-  RecalibrateCellTimeL1Phase(imod, bc, time);
+    //Recalibrate time with L1 phase 
+    if (IsL1PhaseInTimeRecalibrationOn()) 
+    {
+      time -= fCalibL1PhaseShift[4*imod+bc4]*1.e-9;
+      time -= fCalibL1ShiftOffset[imod]*1.e-9;
+    }
+  }
 
   return kTRUE;
 }
@@ -563,64 +591,154 @@ Bool_t AliEMCALRecoUtils::ClusterContainsBadChannel(const AliEMCALGeometry* geom
 }
 
 ///
-/// Calculate the energy in the cross around the energy of a given cell.
-/// Used in exotic clusters/cells rejection.
+/// Copy the calibration maps into flat arrays indexed by the cell absolute ID:
+/// super module, bad channel status, energy recalibration factor, time shift
+/// per bunch crossing and gain, L1 phase shifts per super module, and the cells
+/// in cross used in GetECross(). Done once per calibration set instead of
+/// converting absID into (SM, col, row) and looking into the histograms for
+/// each cell in each event.
 ///
-/// \param absID: controlled cell absolute ID number
-/// \param tcell: time of cell under control
-/// \param cells: full list of cells
-/// \param bc: bunch crossing number
+/// Maps or super modules missing in the arrays get the defaults of the
+/// GetEMCAL...() accessors: status 0, energy factor 1, no time shift.
 ///
-/// \return float E_cross
+/// \return bool, false if no geometry is available
 ///
-//___________________________________________________________________________
-Float_t AliEMCALRecoUtils::GetECross(Int_t absID, Double_t tcell,
-                                     AliVCaloCells* cells, Int_t bc)
-{  
-  AliEMCALGeometry * geom = AliEMCALGeometry::GetInstance();
+//_______________________________________________________________________________
+Bool_t AliEMCALRecoUtils::UpdateCalibrationSnapshot()
+{
+  AliEMCALGeometry* geom = AliEMCALGeometry::GetInstance();
   
   if(!geom)
   {
     AliError("No instance of the geometry is available");
-    return -1;
+    return kFALSE;
   }
 
-  Int_t imod = -1, iphi =-1, ieta=-1,iTower = -1, iIphi = -1, iIeta = -1; 
-  geom->GetCellIndex(absID,imod,iTower,iIphi,iIeta); 
-  geom->GetCellPhiEtaIndexInSModule(imod,iTower,iIphi, iIeta,iphi,ieta);  
+  Int_t nSM    = geom->GetNumberOfSuperModules();
+  Int_t nCells = 24*48*nSM;
   
-  // Get close cells index, energy and time, not in corners
+  if ( fCalibSnapshotValid && fCalibSnapshotNCells == nCells ) 
+    return kTRUE;
   
-  Int_t absID1 = -1;
-  Int_t absID2 = -1;
+  fCalibCellSM      .assign(nCells, -1);
+  fCalibBadChannel  .assign(nCells, 0);
+  fCalibEnergyFactor.assign(nCells, 1.);
+  fCalibTimeShift   .assign(8*nCells, 0.);
+  fCalibCrossCells  .assign(4*nCells, -1);
+  fCalibL1PhaseShift .assign(4*nSM, 0.);
+  fCalibL1ShiftOffset.assign(nSM, 0.);
+
+  Int_t nBadMaps   = fEMCALBadChannelMap            ? fEMCALBadChannelMap           ->GetSize() : 0;
+  Int_t nRecalMaps = fEMCALRecalibrationFactors     ? fEMCALRecalibrationFactors    ->GetSize() : 0;
+  Int_t nTimeMaps  = fEMCALTimeRecalibrationFactors ? fEMCALTimeRecalibrationFactors->GetSize() : 0;
   
-  if ( iphi < AliEMCALGeoParams::fgkEMCALRows-1) absID1 = geom->GetAbsCellIdFromCellIndexes(imod, iphi+1, ieta);
-  if ( iphi > 0 )                                absID2 = geom->GetAbsCellIdFromCellIndexes(imod, iphi-1, ieta);
+  Int_t imod = -1, iphi =-1, ieta=-1,iTower = -1, iIphi = -1, iIeta = -1; 
   
-  // In case of cell in eta = 0 border, depending on SM shift the cross cell index
+  for (Int_t absID = 0; absID < nCells; absID++) 
+  {
+    if (!geom->GetCellIndex(absID,imod,iTower,iIphi,iIeta)) continue;
+    
+    geom->GetCellPhiEtaIndexInSModule(imod,iTower,iIphi, iIeta,iphi,ieta);  
+    
+    fCalibCellSM[absID] = imod;
+    
+    TH2I* hBad = imod < nBadMaps ? (TH2I*) fEMCALBadChannelMap->UncheckedAt(imod) : 0;
+    if (hBad) fCalibBadChannel[absID] = ((Int_t) hBad->GetBinContent(ieta,iphi)) != 0;
+    
+    TH2F* hRecal = imod < nRecalMaps ? (TH2F*) fEMCALRecalibrationFactors->UncheckedAt(imod) : 0;
+    if (hRecal) fCalibEnergyFactor[absID] = (Float_t) hRecal->GetBinContent(ieta,iphi);
+    
+    for (Int_t itime = 0; itime < 8 && itime < nTimeMaps; itime++) 
+    {
+      TH1F* hTime = (TH1F*) fEMCALTimeRecalibrationFactors->UncheckedAt(itime);
+      if (hTime) fCalibTimeShift[itime*nCells+absID] = (Float_t) hTime->GetBinContent(absID);
+    }
+    
+    // Close cells, not in corners, see GetECross()
+    Int_t* cross = &fCalibCrossCells[4*absID];
+    
+    if ( iphi < AliEMCALGeoParams::fgkEMCALRows-1) cross[0] = geom->GetAbsCellIdFromCellIndexes(imod, iphi+1, ieta);
+    if ( iphi > 0 )                                cross[1] = geom->GetAbsCellIdFromCellIndexes(imod, iphi-1, ieta);
+    
+    // In case of cell in eta = 0 border, depending on SM shift the cross cell index
+    if ( ieta == AliEMCALGeoParams::fgkEMCALCols-1 && !(imod%2) ) 
+    {
+      cross[2] = geom-> GetAbsCellIdFromCellIndexes(imod+1, iphi, 0);
+      cross[3] = geom-> GetAbsCellIdFromCellIndexes(imod,   iphi, ieta-1); 
+    } 
+    else if ( ieta == 0 && imod%2 ) 
+    {
+      cross[2] = geom-> GetAbsCellIdFromCellIndexes(imod,   iphi, ieta+1);
+      cross[3] = geom-> GetAbsCellIdFromCellIndexes(imod-1, iphi, AliEMCALGeoParams::fgkEMCALCols-1); 
+    } 
+    else 
+    {
+      if ( ieta < AliEMCALGeoParams::fgkEMCALCols-1 ) 
+        cross[2] = geom-> GetAbsCellIdFromCellIndexes(imod, iphi, ieta+1);
+      if ( ieta > 0 )                                 
+        cross[3] = geom-> GetAbsCellIdFromCellIndexes(imod, iphi, ieta-1); 
+    }
+  }
   
-  Int_t absID3 = -1;
-  Int_t absID4 = -1;
+  // L1 phase, see RecalibrateCellTimeL1Phase()
+  TH1C* hL1 = 0;
+  if (fEMCALL1PhaseInTimeRecalibration && fEMCALL1PhaseInTimeRecalibration->GetSize() > 0) 
+    hL1 = (TH1C*) fEMCALL1PhaseInTimeRecalibration->UncheckedAt(0);
   
-  if ( ieta == AliEMCALGeoParams::fgkEMCALCols-1 && !(imod%2) ) 
-  {
-    absID3 = geom-> GetAbsCellIdFromCellIndexes(imod+1, iphi, 0);
-    absID4 = geom-> GetAbsCellIdFromCellIndexes(imod,   iphi, ieta-1); 
-  } 
-  else if ( ieta == 0 && imod%2 ) 
+  for (Int_t iSM = 0; iSM < nSM; iSM++) 
   {
-    absID3 = geom-> GetAbsCellIdFromCellIndexes(imod,   iphi, ieta+1);
-    absID4 = geom-> GetAbsCellIdFromCellIndexes(imod-1, iphi, AliEMCALGeoParams::fgkEMCALCols-1); 
-  } 
-  else 
-  {
-    if ( ieta < AliEMCALGeoParams::fgkEMCALCols-1 ) 
-      absID3 = geom-> GetAbsCellIdFromCellIndexes(imod, iphi, ieta+1);
-    if ( ieta > 0 )                                 
-      absID4 = geom-> GetAbsCellIdFromCellIndexes(imod, iphi, ieta-1); 
+    Int_t l1PhaseShift = hL1 ? (Int_t) hL1->GetBinContent(iSM) : 0;
+    Int_t l1Phase      = l1PhaseShift & 3; //bit operation
+    
+    for (Int_t bc = 0; bc < 4; bc++) 
+    {
+      if(bc >= l1Phase)
+        fCalibL1PhaseShift[4*iSM+bc] = (bc - l1Phase)*25;
+      else
+        fCalibL1PhaseShift[4*iSM+bc] = (bc - l1Phase + 4)*25;
+    }
+    
+    fCalibL1ShiftOffset[iSM] = (l1PhaseShift>>2)*25; //bit operation
   }
   
-  //printf("IMOD %d, AbsId %d, a %d, b %d, c %d e %d \n",imod,absID,absID1,absID2,absID3,absID4);
+  fCalibSnapshotNCells = nCells;
+  fCalibSnapshotValid  = kTRUE;
+  
+  AliDebug(1,Form("Calibration snapshot built for %d cells in %d super modules",nCells,nSM));
+  
+  return kTRUE;
+}
+
+///
+/// Calculate the energy in the cross around the energy of a given cell.
+/// Used in exotic clusters/cells rejection.
+///
+/// \param absID: controlled cell absolute ID number
+/// \param tcell: time of cell under control
+/// \param cells: full list of cells
+/// \param bc: bunch crossing number
+///
+/// \return float E_cross
+///
+//___________________________________________________________________________
+Float_t AliEMCALRecoUtils::GetECross(Int_t absID, Double_t tcell,
+                                     AliVCaloCells* cells, Int_t bc)
+{  
+  if (!UpdateCalibrationSnapshot()) 
+    return -1;
+  
+  if ( absID < 0 || absID >= fCalibSnapshotNCells ) 
+    return 0;
+
+  // Close cells index, not in corners, from the calibration snapshot
+  const Int_t* cross = &fCalibCrossCells[4*absID];
+  
+  Int_t absID1 = cross[0];
+  Int_t absID2 = cross[1];
+  Int_t absID3 = cross[2];
+  Int_t absID4 = cross[3];
+  
+  // Energy and time
   
   Float_t  ecell1  = 0, ecell2  = 0, ecell3  = 0, ecell4  = 0;
   Double_t tcell1  = 0, tcell2  = 0, tcell3  = 0, tcell4  = 0;
@@ -1419,6 +1537,8 @@ void AliEMCALRecoUtils::InitEMCALRecalibrationFactors()
   fEMCALRecalibrationFactors->SetOwner(kTRUE);
   fEMCALRecalibrationFactors->Compress();
   
+  fCalibSnapshotValid = kFALSE;
+  
   // In order to avoid rewriting the same histograms
   TH1::AddDirectory(oldStatus);    
 }
@@ -1464,6 +1584,8 @@ void AliEMCALRecoUtils::InitEMCALTimeRecalibrationFactors()
   fEMCALTimeRecalibrationFactors->SetOwner(kTRUE);
   fEMCALTimeRecalibrationFactors->Compress();
   
+  fCalibSnapshotValid = kFALSE;
+  
   // In order to avoid rewriting the same histograms
   TH1::AddDirectory(oldStatus);    
 }
@@ -1489,6 +1611,8 @@ void AliEMCALRecoUtils::InitEMCALBadChannelStatusMap()
   fEMCALBadChannelMap->SetOwner(kTRUE);
   fEMCALBadChannelMap->Compress();
   
+  fCalibSnapshotValid = kFALSE;
+  
   // In order to avoid rewriting the same histograms
   TH1::AddDirectory(oldStatus);    
 }
@@ -1515,6 +1639,8 @@ void AliEMCALRecoUtils::InitEMCALL1PhaseInTimeRecalibration()
   fEMCALL1PhaseInTimeRecalibration->SetOwner(kTRUE);
   fEMCALL1PhaseInTimeRecalibration->Compress();
   
+  fCalibSnapshotValid = kFALSE;
+  
   // In order to avoid rewriting the same histograms
   TH1::AddDirectory(oldStatus);    
 }
@@ -1625,30 +1751,73 @@ void AliEMCALRecoUtils::RecalibrateCells(AliVCaloCells * cells, Int_t bc)
     return;
   }  
   
-  Short_t  absId  =-1;
-  Bool_t   accept = kFALSE;
-  Float_t  ecell  = 0;
-  Double_t tcell  = 0;
+  Bool_t snapshot = UpdateCalibrationSnapshot();
+  
+  // Same as AcceptCalibrateCell() for all cells, but reading the cells once
+  // in list order and using the calibration snapshot in a tight loop
+  Int_t nEMcell  = cells->GetNumberOfCells() ;  
+  
+  fCellBufferAbsId  .resize(nEMcell);
+  fCellBufferAmp    .resize(nEMcell);
+  fCellBufferTime   .resize(nEMcell);
+  fCellBufferLowGain.resize(nEMcell);
+  fCellBufferMCLabel.resize(nEMcell);
+  fCellBufferEFrac  .resize(nEMcell);
+  
+  Bool_t recalE    = !fCellsRecalibrated && IsRecalibrationOn();
+  Bool_t recalTime = !fCellsRecalibrated && bc >= 0 && IsTimeRecalibrationOn();
+  Bool_t recalL1   = !fCellsRecalibrated && bc >= 0 && IsL1PhaseInTimeRecalibrationOn();
+  Bool_t removeBad = IsBadChannelsRemovalSwitchedOn();
+  Bool_t useLG     = recalTime && fLowGain;
+  Int_t  bc4       = bc >= 0 ? bc%4 : 0;
+  
   Double_t ecellin = 0;
   Double_t tcellin = 0;
-  Int_t  mclabel = -1;
-  Double_t efrac = 0;
   
-  Int_t nEMcell  = cells->GetNumberOfCells() ;  
   for (Int_t iCell = 0; iCell < nEMcell; iCell++) 
   { 
-    cells->GetCell( iCell, absId, ecellin, tcellin, mclabel, efrac );
+    cells->GetCell( iCell, fCellBufferAbsId[iCell], ecellin, tcellin, fCellBufferMCLabel[iCell], fCellBufferEFrac[iCell] );
+    fCellBufferAmp    [iCell] = ecellin;
+    fCellBufferTime   [iCell] = tcellin;
+    fCellBufferLowGain[iCell] = useLG && !cells->GetHighGain(iCell);
+  }
+  
+  Int_t nCells = fCalibSnapshotNCells;
+  
+  for (Int_t iCell = 0; iCell < nEMcell; iCell++) 
+  { 
+    Int_t absId = fCellBufferAbsId[iCell];
     
-    accept = AcceptCalibrateCell(absId, bc, ecell ,tcell ,cells); 
-    if (!accept)
+    // Not accepted: out of range, cell does not exist, bad channel
+    if ( !snapshot || absId < 0 || absId >= nCells || fCalibCellSM[absId] < 0 || 
+         (removeBad && fCalibBadChannel[absId]) ) 
     {
-      ecell = 0;
-      tcell = -1;
+      fCellBufferAmp [iCell] = 0;
+      fCellBufferTime[iCell] = -1;
+      continue;
     }
     
-    // Set new values
-    cells->SetCell(iCell,absId,ecell, tcell, mclabel, efrac);
+    if (recalE) fCellBufferAmp[iCell] *= fCalibEnergyFactor[absId];
+    
+    Double_t tcell = fCellBufferTime[iCell] - fConstantTimeShift*1e-9; // only in case of old Run1 simulation
+    
+    if (recalTime) 
+      tcell -= fCalibTimeShift[(bc4+4*fCellBufferLowGain[iCell])*nCells+absId]*1.e-9;
+    
+    if (recalL1) 
+    {
+      Int_t imod = fCalibCellSM[absId];
+      tcell -= fCalibL1PhaseShift[4*imod+bc4]*1.e-9;
+      tcell -= fCalibL1ShiftOffset[imod]*1.e-9;
+    }
+    
+    fCellBufferTime[iCell] = tcell;
   }
+  
+  // Set new values
+  for (Int_t iCell = 0; iCell < nEMcell; iCell++) 
+    cells->SetCell(iCell, fCellBufferAbsId[iCell], fCellBufferAmp[iCell], fCellBufferTime[iCell], 
+                   fCellBufferMCLabel[iCell], fCellBufferEFrac[iCell]);
 
   fCellsRecalibrated = kTRUE;
 }
@@ -2531,6 +2700,8 @@ void AliEMCALRecoUtils::FindMatches(AliVEvent *event,
                                     const AliEMCALGeometry *geom,
                                     AliMCEvent * mc)
 {  
+  ResetPropagationCounters();
+  
   fMatchedTrackIndex  ->Reset();
   fMatchedClusterIndex->Reset();
   fResidualPhi->Reset();
@@ -2580,6 +2751,9 @@ void AliEMCALRecoUtils::FindMatches(AliVEvent *event,
     }
   }
   
+  // Clusters around each track are found through the index
+  BuildClusterIndex(clusterArr ? clusterArr : clusterArray);
+  
   Int_t    matched=0;
   Double_t cv[21];
   TString  genName;
@@ -2666,6 +2840,7 @@ void AliEMCALRecoUtils::FindMatches(AliVEvent *event,
     else
     {
       AliWarning("Wrong input data type! Should be \"AOD\" or \"ESD\" ");
+      ClearClusterIndex();
       if (clusterArray) 
       {
         clusterArray->Clear();
@@ -2696,6 +2871,7 @@ void AliEMCALRecoUtils::FindMatches(AliVEvent *event,
     // Extrapolate the track to EMCal surface, see AliEMCALRecoUtilsBase
     AliExternalTrackParam emcalParam(*trackParam);
     Float_t eta, phi, pt;
+    fNSurfacePropagations++;
     if (!ExtrapolateTrackToEMCalSurface(&emcalParam, fEMCalSurfaceDistance, fMass, fStepSurface, eta, phi, pt)) 
     {
       if (aodevent    && trackParam) delete trackParam;
@@ -2739,6 +2915,8 @@ void AliEMCALRecoUtils::FindMatches(AliVEvent *event,
     if (fITSTrackSA && trackParam) delete trackParam;
   }//track loop
   
+  ClearClusterIndex();
+  
   if (clusterArray) 
   {
     clusterArray->Clear();
@@ -2746,6 +2924,8 @@ void AliEMCALRecoUtils::FindMatches(AliVEvent *event,
   }
   
   AliDebug(2,Form("Number of matched pairs = %d !\n",matched));
+  AliDebug(1,Form("Track propagations: %d to the EMCal surface, %d to clusters\n",
+                  fNSurfacePropagations,fNClusterPropagations));
   
   fMatchedTrackIndex   ->Set(matched);
   fMatchedClusterIndex ->Set(matched);
@@ -2791,6 +2971,7 @@ Int_t AliEMCALRecoUtils::FindMatchedClusterInEvent(const AliESDtrack *track,
   AliExternalTrackParam emcalParam(*trackParam);
   
   Float_t eta, phi, pt;  
+  fNSurfacePropagations++;
   if (!AliEMCALRecoUtilsBase::ExtrapolateTrackToEMCalSurface(&emcalParam, fEMCalSurfaceDistance, fMass, fStepSurface, eta, phi, pt))	
   {
     if (fITSTrackSA) delete trackParam;
@@ -2852,9 +3033,16 @@ Int_t  AliEMCALRecoUtils::FindMatchedClusterInClusterArr(const AliExternalTrackP
   Double_t exPos[3] = {0.,0.,0.};
   if (!emcalParam->GetXYZ(exPos)) return index;
 
+  // Only the clusters around the track if the index was built for this array,
+  // in the same ascending order as the full loop so that the result is identical
+  Bool_t useIndex    = (fClusterIndexArr && fClusterIndexArr == clusterArr);
+  Int_t  nCandidates = useIndex ? SelectClusterCandidates(exPos) : clusterArr->GetEntriesFast();
+  
   Float_t clsPos[3] = {0.,0.,0.};
-  for (Int_t icl=0; icl<clusterArr->GetEntriesFast(); icl++)
+  for (Int_t ic=0; ic<nCandidates; ic++)
   {
+    Int_t icl = useIndex ? fClusterCandidates[ic] : ic;
+    
     AliVCluster *cluster = dynamic_cast<AliVCluster*> (clusterArr->At(icl)) ;
     
     if (!cluster || !cluster->IsEMCAL()) continue;
@@ -2866,6 +3054,7 @@ Int_t  AliEMCALRecoUtils::FindMatchedClusterInClusterArr(const AliExternalTrackP
     
     AliExternalTrackParam trkPamTmp (*trkParam);//Retrieve the starting point every time before the extrapolation
     
+    fNClusterPropagations++;
     if (!AliEMCALRecoUtilsBase::ExtrapolateTrackToCluster(&trkPamTmp, cluster, fMass, fStepCluster, tmpEta, tmpPhi)) continue;
     
     if (fCutEtaPhiSum) 
@@ -2903,6 +3092,147 @@ Int_t  AliEMCALRecoUtils::FindMatchedClusterInClusterArr(const AliExternalTrackP
   return index;
 }
 
+// Cluster index buckets: eta in [-1,1], outside clusters go to the edge buckets, phi in [0,2pi)
+static const Int_t    kNClusterIndexEtaBins = 40;
+static const Int_t    kNClusterIndexPhiBins = 128;
+static const Double_t kClusterIndexEtaMin   = -1.;
+static const Double_t kClusterIndexEtaWidth = 2./kNClusterIndexEtaBins;
+static const Double_t kClusterIndexPhiWidth = TMath::TwoPi()/kNClusterIndexPhiBins;
+
+static Int_t ClusterIndexEtaBin(Double_t eta)
+{
+  Int_t bin = (Int_t) TMath::Floor((eta-kClusterIndexEtaMin)/kClusterIndexEtaWidth);
+  return TMath::Max(0, TMath::Min(kNClusterIndexEtaBins-1, bin));
+}
+
+///
+/// Sort the EMCal clusters of the array in eta-phi buckets of their position.
+/// Clusters with a non finite position, never rejected by the window cut, go
+/// to an extra bucket always selected.
+/// Used by FindMatchedClusterInClusterArr() for this array until ClearClusterIndex()
+/// is called, FindMatches() builds it for the event clusters and clears it at the end.
+///
+/// \param clusterArr: input array of clusters
+///
+//_______________________________________________________________________________________________
+void AliEMCALRecoUtils::BuildClusterIndex(const TObjArray * clusterArr)
+{
+  fClusterIndexArr = clusterArr;
+  
+  Int_t nClusters = clusterArr ? clusterArr->GetEntriesFast() : 0;
+  Int_t nBuckets  = kNClusterIndexEtaBins*kNClusterIndexPhiBins+1;
+  
+  fClusterIndexStart  .assign(nBuckets+1, 0);
+  fClusterIndexBucket .assign(nClusters, -1);
+  fClusterIndexEntries.resize(nClusters);
+  
+  Float_t clsPos[3] = {0.,0.,0.};
+  for (Int_t icl=0; icl<nClusters; icl++)
+  {
+    AliVCluster *cluster = dynamic_cast<AliVCluster*> (clusterArr->At(icl)) ;
+    
+    if (!cluster || !cluster->IsEMCAL()) continue;
+    
+    cluster->GetPosition(clsPos);
+    
+    Double_t rxy = TMath::Sqrt(clsPos[0]*clsPos[0]+clsPos[1]*clsPos[1]);
+    Double_t eta = rxy > 0 ? TMath::ASinH(clsPos[2]/rxy) : (clsPos[2] >= 0 ? 1e9 : -1e9);
+    Double_t phi = TMath::ATan2(clsPos[1],clsPos[0]);
+    if (phi < 0) phi += TMath::TwoPi();
+    
+    Int_t bucket = nBuckets-1;
+    if (TMath::Finite(eta) && TMath::Finite(phi)) 
+    {
+      Int_t phiBin = TMath::Min(kNClusterIndexPhiBins-1, (Int_t) (phi/kClusterIndexPhiWidth));
+      bucket = ClusterIndexEtaBin(eta)*kNClusterIndexPhiBins + phiBin;
+    }
+    
+    fClusterIndexBucket[icl] = bucket;
+    fClusterIndexStart[bucket+1]++;
+  }
+  
+  for (Int_t ib=0; ib<nBuckets; ib++) 
+    fClusterIndexStart[ib+1] += fClusterIndexStart[ib];
+  
+  // Fill in ascending cluster order, using the bucket start as cursor
+  for (Int_t icl=0; icl<nClusters; icl++)
+  {
+    if (fClusterIndexBucket[icl] < 0) continue;
+    fClusterIndexEntries[fClusterIndexStart[fClusterIndexBucket[icl]]++] = icl;
+  }
+  
+  for (Int_t ib=nBuckets; ib>0; ib--) 
+    fClusterIndexStart[ib] = fClusterIndexStart[ib-1];
+  fClusterIndexStart[0] = 0;
+}
+
+///
+/// Select from the cluster index the clusters which can be within fClusterWindow
+/// of the track position on the EMCal surface. The window is a sphere, seen from
+/// the origin within asin(window/r) in polar angle and asin(window/r_xy) in phi,
+/// a small margin covers the rounding.
+///
+/// \param exPos: track position at the EMCal surface
+///
+/// \return number of candidates, stored in ascending cluster index in fClusterCandidates
+///
+//_______________________________________________________________________________________________
+Int_t AliEMCALRecoUtils::SelectClusterCandidates(const Double_t exPos[3])
+{
+  fClusterCandidates.clear();
+  
+  if (!fClusterIndexArr) return 0;
+  
+  Double_t window = fClusterWindow + 1.; // cm
+  Double_t rxy    = TMath::Sqrt(exPos[0]*exPos[0]+exPos[1]*exPos[1]);
+  Double_t r      = TMath::Sqrt(rxy*rxy+exPos[2]*exPos[2]);
+  
+  // Window containing the beam axis, all clusters
+  if (window >= rxy) 
+  {
+    for (Int_t icl=0; icl<(Int_t)fClusterIndexBucket.size(); icl++)
+      if (fClusterIndexBucket[icl] >= 0) fClusterCandidates.push_back(icl);
+    return fClusterCandidates.size();
+  }
+  
+  Double_t theta    = TMath::ATan2(rxy,exPos[2]);
+  Double_t dTheta   = TMath::ASin(window/r);
+  Double_t thetaMin = theta - dTheta;
+  Double_t thetaMax = theta + dTheta;
+  Double_t etaMax   = thetaMin > 0           ? -TMath::Log(TMath::Tan(thetaMin/2.)) :  1e9;
+  Double_t etaMin   = thetaMax < TMath::Pi() ? -TMath::Log(TMath::Tan(thetaMax/2.)) : -1e9;
+  
+  Int_t etaBinMin = ClusterIndexEtaBin(etaMin);
+  Int_t etaBinMax = ClusterIndexEtaBin(etaMax);
+  
+  Double_t phi  = TMath::ATan2(exPos[1],exPos[0]);
+  if (phi < 0) phi += TMath::TwoPi();
+  Double_t dPhi = TMath::ASin(window/rxy);
+  
+  Int_t phiBinMin = (Int_t) TMath::Floor((phi-dPhi)/kClusterIndexPhiWidth);
+  Int_t phiBinMax = (Int_t) TMath::Floor((phi+dPhi)/kClusterIndexPhiWidth);
+  Int_t nPhiBins  = TMath::Min(phiBinMax-phiBinMin+1, kNClusterIndexPhiBins);
+  
+  for (Int_t ieta=etaBinMin; ieta<=etaBinMax; ieta++)
+  {
+    for (Int_t iphi=0; iphi<nPhiBins; iphi++)
+    {
+      Int_t phiBin = ((phiBinMin+iphi)%kNClusterIndexPhiBins+kNClusterIndexPhiBins)%kNClusterIndexPhiBins;
+      Int_t bucket = ieta*kNClusterIndexPhiBins + phiBin;
+      for (Int_t ie=fClusterIndexStart[bucket]; ie<fClusterIndexStart[bucket+1]; ie++)
+        fClusterCandidates.push_back(fClusterIndexEntries[ie]);
+    }
+  }
+  
+  Int_t lastBucket = kNClusterIndexEtaBins*kNClusterIndexPhiBins;
+  for (Int_t ie=fClusterIndexStart[lastBucket]; ie<fClusterIndexStart[lastBucket+1]; ie++)
+    fClusterCandidates.push_back(fClusterIndexEntries[ie]);
+  
+  std::sort(fClusterCandidates.begin(), fClusterCandidates.end());
+  
+  return fClusterCandidates.size();
+}
+
 ///
 /// Return the residual by extrapolating a track param to a cluster.
 /// Mass and step hypothesis are set via data members fStepCluster and fMass 
@@ -3488,6 +3818,7 @@ void AliEMCALRecoUtils::SetTracksMatchedToCluster(const AliVEvent *event)
 }
 
 void AliEMCALRecoUtils::SetEMCALChannelRecalibrationFactors(const TObjArray *map) { 
+  fCalibSnapshotValid = kFALSE;
   if(fEMCALRecalibrationFactors) fEMCALRecalibrationFactors->Clear();
   else {
     fEMCALRecalibrationFactors = new TObjArray(map->GetEntries());
@@ -3514,9 +3845,11 @@ void AliEMCALRecoUtils::SetEMCALChannelRecalibrationFactors(Int_t iSM , const TH
   TH2F *clone = new TH2F(*h);
   clone->SetDirectory(NULL);
   fEMCALRecalibrationFactors->AddAt(clone,iSM); 
+  fCalibSnapshotValid = kFALSE;
 }
 
 void AliEMCALRecoUtils::SetEMCALChannelStatusMap(const TObjArray *map) { 
+  fCalibSnapshotValid = kFALSE;
   if(fEMCALBadChannelMap) fEMCALBadChannelMap->Clear();
   else {
     fEMCALBadChannelMap = new TObjArray(map->GetEntries());
@@ -3543,9 +3876,11 @@ void AliEMCALRecoUtils::SetEMCALChannelStatusMap(Int_t iSM , const TH2I* h) {
   TH2I *clone = new TH2I(*h);
   clone->SetDirectory(NULL);
   fEMCALBadChannelMap->AddAt(clone,iSM); 
+  fCalibSnapshotValid = kFALSE;
 }
 
 void  AliEMCALRecoUtils::SetEMCALChannelTimeRecalibrationFactors(const TObjArray *map) { 
+  fCalibSnapshotValid = kFALSE;
   if(fEMCALTimeRecalibrationFactors) fEMCALTimeRecalibrationFactors->Clear();
   else {
     fEMCALTimeRecalibrationFactors = new TObjArray(map->GetEntries());
@@ -3572,9 +3907,11 @@ void  AliEMCALRecoUtils::SetEMCALChannelTimeRecalibrationFactors(Int_t bc, const
   TH1F *clone = new TH1F(*h);
   clone->SetDirectory(NULL);
   fEMCALTimeRecalibrationFactors->AddAt(clone,bc); 
+  fCalibSnapshotValid = kFALSE;
 }
 
 void AliEMCALRecoUtils::SetEMCALL1PhaseInTimeRecalibrationForAllSM(const TObjArray *map) { 
+  fCalibSnapshotValid = kFALSE;
   if(fEMCALL1PhaseInTimeRecalibration) fEMCALL1PhaseInTimeRecalibration->Clear();
   else {
     fEMCALL1PhaseInTimeRecalibration = new TObjArray(map->GetEntries());
@@ -3600,6 +3937,7 @@ void AliEMCALRecoUtils::SetEMCALL1PhaseInTimeRecalibrationForAllSM(const TH1C* h
   TH1C *clone = new TH1C(*h);
   clone->SetDirectory(NULL);
   fEMCALL1PhaseInTimeRecalibration->AddAt(clone,0); 
+  fCalibSnapshotValid = kFALSE;
 }
 
 ///
@@ -31,6 +31,8 @@
 ///
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <vector>
+
 // Root includes
 #include <TNamed.h>
 #include <TMath.h>
@@ -176,7 +178,8 @@ public:
     else return 1 ; } 
   void     SetEMCALChannelRecalibrationFactor(Int_t iSM , Int_t iCol, Int_t iRow, Double_t c = 1) { 
     if(!fEMCALRecalibrationFactors) InitEMCALRecalibrationFactors() ;
-    ((TH2F*)fEMCALRecalibrationFactors->At(iSM))->SetBinContent(iCol,iRow,c) ; }
+    ((TH2F*)fEMCALRecalibrationFactors->At(iSM))->SetBinContent(iCol,iRow,c) ; 
+    fCalibSnapshotValid = kFALSE ; }
   
   // Recalibrate channels energy with run dependent corrections
   Bool_t   IsRunDepRecalibrationOn()               const { return fUseRunCorrectionFactors ; }
@@ -201,7 +204,8 @@ public:
     else return 0 ; } 
   void     SetEMCALChannelTimeRecalibrationFactor(Int_t bc, Int_t absID, Double_t c = 0, Bool_t isLGon=kFALSE) { 
     if(!fEMCALTimeRecalibrationFactors) InitEMCALTimeRecalibrationFactors() ;
-    ((TH1F*)fEMCALTimeRecalibrationFactors->At(bc+4*isLGon))->SetBinContent(absID,c) ; }  
+    ((TH1F*)fEMCALTimeRecalibrationFactors->At(bc+4*isLGon))->SetBinContent(absID,c) ; 
+    fCalibSnapshotValid = kFALSE ; }  
   
   TH1F *   GetEMCALChannelTimeRecalibrationFactors(Int_t bc)const       { return (TH1F*)fEMCALTimeRecalibrationFactors->At(bc) ; }	
   void     SetEMCALChannelTimeRecalibrationFactors(const TObjArray *map);
@@ -227,7 +231,8 @@ public:
     else return 0 ; } 
   void     SetEMCALL1PhaseInTimeRecalibrationForSM(Int_t iSM, Int_t c = 0) { 
     if(!fEMCALL1PhaseInTimeRecalibration) InitEMCALL1PhaseInTimeRecalibration();
-    ((TH1C*)fEMCALL1PhaseInTimeRecalibration->At(0))->SetBinContent(iSM,c) ; }  
+    ((TH1C*)fEMCALL1PhaseInTimeRecalibration->At(0))->SetBinContent(iSM,c) ; 
+    fCalibSnapshotValid = kFALSE ; }  
   
   TH1C *   GetEMCALL1PhaseInTimeRecalibrationForAllSM()const       { return (TH1C*)fEMCALL1PhaseInTimeRecalibration->At(0) ; }	
   void     SetEMCALL1PhaseInTimeRecalibrationForAllSM(const TObjArray *map);
@@ -264,12 +269,23 @@ public:
     else return 0;}//Channel is ok by default
   void     SetEMCALChannelStatus(Int_t iSM , Int_t iCol, Int_t iRow, Double_t c = 1) { 
     if(!fEMCALBadChannelMap)InitEMCALBadChannelStatusMap()               ;
-    ((TH2I*)fEMCALBadChannelMap->At(iSM))->SetBinContent(iCol,iRow,c)    ; }
+    ((TH2I*)fEMCALBadChannelMap->At(iSM))->SetBinContent(iCol,iRow,c)    ; 
+    fCalibSnapshotValid = kFALSE                                          ; }
   TH2I *   GetEMCALChannelStatusMap(Int_t iSM)     const { return (TH2I*)fEMCALBadChannelMap->At(iSM) ; }
   void     SetEMCALChannelStatusMap(const TObjArray *map);
   void     SetEMCALChannelStatusMap(Int_t iSM , const TH2I* h);
   Bool_t   ClusterContainsBadChannel(const AliEMCALGeometry* geom, const UShort_t* cellList, Int_t nCells);
  
+  //-----------------------------------------------------
+  // Calibration snapshot: energy factor, bad status, time shifts and L1 phase
+  // of the maps above copied into flat arrays indexed by absId, used per cell.
+  // Rebuilt when the maps are set or the number of super modules changes.
+  // Call InvalidateCalibrationSnapshot() after modifying the histograms of the
+  // maps directly through the Get...() pointers.
+  //-----------------------------------------------------
+  Bool_t   UpdateCalibrationSnapshot() ;
+  void     InvalidateCalibrationSnapshot()               { fCalibSnapshotValid = kFALSE ; }
+  
   //-----------------------------------------------------
   // Recalculate other cluster parameters
   //-----------------------------------------------------
@@ -301,6 +317,19 @@ public:
                                           AliExternalTrackParam *trkParam, 
                                           const TObjArray * clusterArr, 
                                           Float_t &dEta, Float_t &dPhi);
+  
+  // Eta-phi bucket index of the cluster positions, built by FindMatches for its
+  // cluster array so that each track only tests the clusters around it
+  void     BuildClusterIndex(const TObjArray * clusterArr);
+  void     ClearClusterIndex()                        { fClusterIndexArr = 0x0        ; }
+  Int_t    SelectClusterCandidates(const Double_t exPos[3]);
+  Int_t    GetClusterCandidate(Int_t i)         const { return fClusterCandidates[i]  ; }
+  
+  // Number of track propagations done since the last FindMatches call (or reset)
+  Int_t    GetNumberOfSurfacePropagations()     const { return fNSurfacePropagations  ; }
+  Int_t    GetNumberOfClusterPropagations()     const { return fNClusterPropagations  ; }
+  void     ResetPropagationCounters()                 { fNSurfacePropagations = 0     ; 
+                                                        fNClusterPropagations = 0     ; }
  
   // Needed by analysis task in AliPhysics, could be removed once base class committed and analysis task is fixed.
   static Bool_t ExtrapolateTrackToCluster (AliExternalTrackParam *trkParam, const AliVCluster *cluster,
@@ -537,8 +566,36 @@ private:
   TString    fMCGenerToAccept[5];        ///<  List with name of generators that should not be included
   Bool_t     fMCGenerToAcceptForTrack;   ///<  Activate the removal of tracks entering the track matching that come from a particular generator
   
+  // Calibration snapshot, indexed by absId
+  Bool_t               fCalibSnapshotValid;    //!<! Snapshot is up to date with the calibration maps
+  Int_t                fCalibSnapshotNCells;   //!<! Number of cells in the snapshot, 0 if not built
+  std::vector<Short_t> fCalibCellSM;           //!<! Super module of the cell, -1 if the cell does not exist
+  std::vector<UChar_t> fCalibBadChannel;       //!<! 1 if the channel status is not 0
+  std::vector<Float_t> fCalibEnergyFactor;     //!<! Energy recalibration factor
+  std::vector<Float_t> fCalibTimeShift;        //!<! Time shift (ns), index (bc+4*lowGain)*nCells+absId
+  std::vector<Float_t> fCalibL1PhaseShift;     //!<! L1 phase time shift (ns), index 4*SM+bc
+  std::vector<Float_t> fCalibL1ShiftOffset;    //!<! L1 shift offset (ns) per SM
+  std::vector<Int_t>   fCalibCrossCells;       //!<! absId of the 4 cells in cross used by GetECross, -1 if none
+  
+  // Cell buffers for RecalibrateCells
+  std::vector<Short_t>  fCellBufferAbsId;     //!<! absId
+  std::vector<Float_t>  fCellBufferAmp;       //!<! amplitude
+  std::vector<Double_t> fCellBufferTime;      //!<! time
+  std::vector<UChar_t>  fCellBufferLowGain;   //!<! low gain flag
+  std::vector<Int_t>    fCellBufferMCLabel;   //!<! MC label
+  std::vector<Double_t> fCellBufferEFrac;     //!<! embedded energy fraction
+  
+  // Cluster bucket index for track matching
+  const TObjArray *    fClusterIndexArr;       //!<! Cluster array the index was built for, 0 if none
+  std::vector<Int_t>   fClusterIndexStart;     //!<! First entry of each eta-phi bucket, nBuckets+1 entries
+  std::vector<Int_t>   fClusterIndexEntries;   //!<! Cluster indexes sorted by bucket, ascending in each bucket
+  std::vector<Int_t>   fClusterIndexBucket;    //!<! Bucket of each cluster, -1 if not indexed
+  std::vector<Int_t>   fClusterCandidates;     //!<! Clusters around the track, ascending index
+  Int_t                fNSurfacePropagations;  //!<! Number of track propagations to the EMCal surface
+  Int_t                fNClusterPropagations;  //!<! Number of track propagations to a cluster
+  
   /// \cond CLASSIMP
-  ClassDef(AliEMCALRecoUtils, 26) ;
+  ClassDef(AliEMCALRecoUtils, 28) ;
   /// \endcond
 
 };
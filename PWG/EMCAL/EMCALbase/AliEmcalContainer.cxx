@@ -12,7 +12,14 @@
  * about the suitability of this software for any purpose. It is          *
  * provided "as is" without express or implied warranty.                  *
  **************************************************************************/
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <string>
+#include <utility>
 #include <TClonesArray.h>
+#include "AliAnalysisManager.h"
 #include "AliVEvent.h"
 #include "AliLog.h"
 #include "AliNamedArrayI.h"
@@ -27,6 +34,35 @@
 ClassImp(AliEmcalContainer);
 /// \endcond
 
+namespace {
+  /// Registry of acceptance caches shared between containers, keyed by array and cut signature
+  typedef std::map<std::pair<const TClonesArray *, ULong_t>, std::shared_ptr<AliEmcalContainer::AcceptanceCache> > AcceptanceCacheRegistry_t;
+
+  AcceptanceCacheRegistry_t &GetAcceptanceCacheRegistry() {
+    static AcceptanceCacheRegistry_t registry;
+    return registry;
+  }
+}
+
+/**
+ * Default constructor of the acceptance cache, creating an empty (invalid) cache.
+ */
+AliEmcalContainer::AcceptanceCache::AcceptanceCache():
+  fArray(nullptr),
+  fEventStamp(-1),
+  fCutSignature(0),
+  fNEntries(0),
+  fValid(kFALSE),
+  fAccepted(),
+  fIndices(),
+  fPtOrder(),
+  fPt(),
+  fEta(),
+  fPhi(),
+  fE()
+{
+}
+
 /**
  * Default constructor. This constructor is only for ROOT I/O and
  * not to be used by users. The container will not connect to an
@@ -51,10 +87,18 @@ AliEmcalContainer::AliEmcalContainer():
   fMaxMCLabel(-1),
   fMassHypothesis(-1),
   fIsEmbedding(kFALSE),
+  fUseAcceptanceCache(kTRUE),
   fClArray(0),
   fCurrentID(0),
   fLabelMap(0),
   fLoadedClass(0),
+  fEventCounter(0),
+  fLastEventStamp(-1),
+  fShareAcceptanceCache(kFALSE),
+  fAcceptanceCache(),
+  fCutSignature(0),
+  fCutSignatureComplete(kFALSE),
+  fCutSignatureDirty(kTRUE),
   fClassName()
 {
   fVertex[0] = 0;
@@ -88,10 +132,18 @@ AliEmcalContainer::AliEmcalContainer(const char *name):
   fMaxMCLabel(-1),
   fMassHypothesis(-1),
   fIsEmbedding(kFALSE),
+  fUseAcceptanceCache(kTRUE),
   fClArray(0),
   fCurrentID(0),
   fLabelMap(0),
   fLoadedClass(0),
+  fEventCounter(0),
+  fLastEventStamp(-1),
+  fShareAcceptanceCache(kFALSE),
+  fAcceptanceCache(),
+  fCutSignature(0),
+  fCutSignatureComplete(kFALSE),
+  fCutSignatureDirty(kTRUE),
   fClassName()
 {
   fVertex[0] = 0;
@@ -119,6 +171,7 @@ void AliEmcalContainer::SetClassName(const char *clname)
   TClass cls(clname);
   if (cls.InheritsFrom(fBaseClassName)) {
     fClassName = clname;
+    CutsChanged();
   }
   else {
     AliError(Form("Unable to set class name %s for this container, it must inherits from %s!",clname,fBaseClassName.Data()));
@@ -176,6 +229,9 @@ void AliEmcalContainer::SetArray(const AliVEvent *event)
   }
 
   fLabelMap = dynamic_cast<AliNamedArrayI*>(event->FindListObject(fClArrayName + "_Map"));
+
+  // The array was (re-)read, the own acceptance cache is rebuilt on the next request
+  fAcceptanceCache.reset();
 }
 
 /**
@@ -187,16 +243,243 @@ void AliEmcalContainer::NextEvent(const AliVEvent * event)
   // Get the right event (either the current event of the embedded event)
   event = AliEmcalContainerUtils::GetEvent(event, fIsEmbedding);
 
+  // Reset the acceptance cache of the previous event. Shared caches are keyed by
+  // the global event stamp, caches of previous events are dropped on the next
+  // request. Caches are shared with other containers only if the stamp is available.
+  fAcceptanceCache.reset();
+  fEventCounter++;
+  Long64_t stamp = GetGlobalEventStamp();
+  fShareAcceptanceCache = stamp >= 0;
+  fLastEventStamp = stamp;
+
   if (!event) return;
 
   GetVertexFromEvent(event);
 }
 
+/**
+ * Get the global event stamp used to identify the event for acceptance
+ * caches shared between containers of different tasks. The current entry
+ * of the analysis manager is used.
+ * @return Current entry of the analysis manager (-1 if not available)
+ */
+Long64_t AliEmcalContainer::GetGlobalEventStamp()
+{
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  return mgr ? mgr->GetCurrentEntry() : -1;
+}
+
+/**
+ * Add the values of all selection settings of the container to the list
+ * used for the cut signature. Derived classes with additional selection
+ * settings add their values after the ones of the base class and return
+ * their own class.
+ * @param[out] values Cut values
+ * @return Class whose selection settings are all contained in the values
+ */
+TClass *AliEmcalContainer::GetCutValues(std::vector<Double_t> &values) const
+{
+  Double_t cuts[] = {
+    static_cast<Double_t>(fIsParticleLevel), static_cast<Double_t>(fBitMap),
+    fMinPt, fMaxPt, fMinE, fMaxE, fMinEta, fMaxEta, fMinPhi, fMaxPhi,
+    static_cast<Double_t>(fMinMCLabel), static_cast<Double_t>(fMaxMCLabel),
+    fMassHypothesis, static_cast<Double_t>(fIsEmbedding)
+  };
+  values.insert(values.end(), cuts, cuts + sizeof(cuts)/sizeof(cuts[0]));
+  return AliEmcalContainer::Class();
+}
+
+/**
+ * Get the signature of the cut configuration of the container. The
+ * signature is a hash of the class name and the cut values (GetCutValues),
+ * calculated again only if a selection setting was changed since.
+ * @return Signature of the cut configuration
+ */
+ULong_t AliEmcalContainer::GetCutSignature() const
+{
+  if (fCutSignatureDirty) {
+    std::vector<Double_t> values;
+    TClass *cl = GetCutValues(values);
+    fCutSignatureComplete = cl == IsA();
+    std::string key(IsA()->GetName());
+    key.append(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(Double_t));
+    key.append(fClassName.Data());
+    fCutSignature = std::hash<std::string>()(key);
+    fCutSignatureDirty = kFALSE;
+  }
+  return fCutSignature;
+}
+
+/**
+ * Check whether the cut signature covers all selection settings of the
+ * container class. This is not the case for classes deriving from the
+ * containers without adding their selection settings in GetCutValues.
+ * @return True if the signature is complete
+ */
+Bool_t AliEmcalContainer::HasCompleteCutSignature() const
+{
+  GetCutSignature();
+  return fCutSignatureComplete;
+}
+
+/**
+ * Run the selection on all entries in the array and fill the acceptance
+ * cache with the accept decision, the accepted indices, their kinematics
+ * and the permutation of accepted indices sorted by decreasing \f$ p_{t} \f$.
+ * @param[out] cache Cache to be filled
+ */
+void AliEmcalContainer::BuildAcceptanceCache(AcceptanceCache &cache) const
+{
+  const Int_t nentries = GetNEntries();
+  cache.fArray = fClArray;
+  cache.fNEntries = nentries;
+  cache.fAccepted.assign(nentries, false);
+  cache.fIndices.clear();
+  cache.fPt.clear();
+  cache.fEta.clear();
+  cache.fPhi.clear();
+  cache.fE.clear();
+  AliTLorentzVector mom;
+  for (Int_t index = 0; index < nentries; index++) {
+    UInt_t rejectionReason = 0;
+    if (!AcceptObject(index, rejectionReason)) continue;
+    GetMomentum(mom, index);
+    cache.fAccepted[index] = true;
+    cache.fIndices.push_back(index);
+    cache.fPt.push_back(mom.Pt());
+    cache.fEta.push_back(mom.Eta());
+    cache.fPhi.push_back(mom.Phi_0_2pi());
+    cache.fE.push_back(mom.E());
+  }
+  // Stable sort keeps the lower index first for objects with equal pt
+  cache.fPtOrder.resize(cache.fIndices.size());
+  std::iota(cache.fPtOrder.begin(), cache.fPtOrder.end(), 0);
+  const std::vector<Double_t> &pt = cache.fPt;
+  std::stable_sort(cache.fPtOrder.begin(), cache.fPtOrder.end(), [&pt](Int_t a, Int_t b) { return pt[a] > pt[b]; });
+  cache.fValid = kTRUE;
+}
+
+/**
+ * Get the acceptance cache for the current event. The cache is built
+ * on the first request within an event. In case another container connected
+ * to the same array with the same cut configuration already built the cache
+ * in this event, the cache is shared.
+ *
+ * The cache is only available in case the container is prepared for the event
+ * via NextEvent, if the cache is not disabled, and if the cut signature covers
+ * all selection settings of the container class.
+ * @param[in] checkConfig If true the cut configuration is checked against the configuration
+ * used to build the cache (rebuilding the cache if it changed). If false an existing cache is used without check.
+ * @return Acceptance cache for the current event (NULL if not available)
+ */
+const AliEmcalContainer::AcceptanceCache *AliEmcalContainer::GetAcceptanceCache(Bool_t checkConfig) const
+{
+  if (!fUseAcceptanceCache || !fEventCounter || !fClArray) return nullptr;
+  // NextEvent was not called for the current event
+  if (fLastEventStamp >= 0 && GetGlobalEventStamp() != fLastEventStamp) return nullptr;
+  if (!HasCompleteCutSignature()) return nullptr;
+  const Int_t nentries = GetNEntries();
+  if (fAcceptanceCache && fAcceptanceCache->fValid && fAcceptanceCache->fArray == fClArray && fAcceptanceCache->fNEntries == nentries) {
+    if (!checkConfig) return fAcceptanceCache.get();
+    if (fAcceptanceCache->fCutSignature == GetCutSignature()) return fAcceptanceCache.get();
+  }
+
+  ULong_t signature = GetCutSignature();
+  if (fShareAcceptanceCache) {
+    AcceptanceCacheRegistry_t &registry = GetAcceptanceCacheRegistry();
+    auto key = std::make_pair(static_cast<const TClonesArray *>(fClArray), signature);
+    auto found = registry.find(key);
+    if (found != registry.end() && found->second->fValid && found->second->fEventStamp == fLastEventStamp && found->second->fNEntries == nentries) {
+      fAcceptanceCache = found->second;
+      return fAcceptanceCache.get();
+    }
+    // Remove caches from previous events
+    for (auto it = registry.begin(); it != registry.end();) {
+      if (it->second->fEventStamp != fLastEventStamp) it = registry.erase(it);
+      else ++it;
+    }
+    fAcceptanceCache = std::make_shared<AcceptanceCache>();
+    fAcceptanceCache->fEventStamp = fLastEventStamp;
+    fAcceptanceCache->fCutSignature = signature;
+    BuildAcceptanceCache(*fAcceptanceCache);
+    registry[key] = fAcceptanceCache;
+  }
+  else {
+    fAcceptanceCache = std::make_shared<AcceptanceCache>();
+    fAcceptanceCache->fEventStamp = fLastEventStamp;
+    fAcceptanceCache->fCutSignature = signature;
+    BuildAcceptanceCache(*fAcceptanceCache);
+  }
+  return fAcceptanceCache.get();
+}
+
+/**
+ * Invalidate all shared acceptance caches built for a given array. Needs to be
+ * called by tasks modifying the objects in the array in-place (i.e. cluster
+ * corrections or the EMCAL tender) after the modification, since containers of
+ * tasks executed afterwards in the same event would otherwise reuse the selection
+ * done on the unmodified objects.
+ * @param[in] array Array for which the caches are invalidated
+ */
+void AliEmcalContainer::InvalidateSharedAcceptanceCache(const TClonesArray *array)
+{
+  AcceptanceCacheRegistry_t &registry = GetAcceptanceCacheRegistry();
+  for (auto it = registry.begin(); it != registry.end();) {
+    if (it->first.first == array) {
+      it->second->fValid = kFALSE;
+      it = registry.erase(it);
+    }
+    else ++it;
+  }
+}
+
+/**
+ * Check whether the \f$ i^{th} \f$ entry in the container is accepted. The
+ * acceptance cache is used if available, otherwise the selection is applied.
+ * The cut configuration is not checked against the cache, the cache is
+ * assumed to be up-to-date.
+ * @param[in] i Index of the object in the container
+ * @return True if the object is accepted, false otherwise
+ */
+Bool_t AliEmcalContainer::IsAccepted(Int_t i) const
+{
+  const AcceptanceCache *cache = GetAcceptanceCache(kFALSE);
+  if (cache) return i >= 0 && i < cache->fNEntries && cache->fAccepted[i];
+  UInt_t rejectionReason = 0;
+  return AcceptObject(i, rejectionReason);
+}
+
+/**
+ * Get the index of the accepted object with the highest \f$ p_{t} \f$ in the
+ * container. Uses the acceptance cache if available.
+ * @return Index of the leading accepted object (-1 if no object is accepted)
+ */
+Int_t AliEmcalContainer::GetLeadingAcceptIndex() const
+{
+  const AcceptanceCache *cache = GetAcceptanceCache();
+  if (cache) return cache->fPtOrder.size() ? cache->fIndices[cache->fPtOrder[0]] : -1;
+  Int_t leading = -1;
+  Double_t ptmax = 0;
+  AliTLorentzVector mom;
+  for (Int_t index = 0; index < GetNEntries(); index++) {
+    UInt_t rejectionReason = 0;
+    if (!AcceptObject(index, rejectionReason)) continue;
+    GetMomentum(mom, index);
+    if (leading < 0 || mom.Pt() > ptmax) {
+      leading = index;
+      ptmax = mom.Pt();
+    }
+  }
+  return leading;
+}
+
 /**
  * Count accepted entries in the container
  * @return Number of accepted events in the container
  */
 Int_t AliEmcalContainer::GetNAcceptEntries() const{
+  const AcceptanceCache *cache = GetAcceptanceCache();
+  if (cache) return cache->fIndices.size();
   Int_t result = 0;
   for(int index = 0; index < GetNEntries(); index++){
     UInt_t rejectionReason = 0;
@@ -11,6 +11,8 @@ class AliVEvent;
 class AliNamedArrayI;
 class AliVParticle;
 
+#include <memory>
+#include <vector>
 #include <TNamed.h>
 #include <TClonesArray.h>
 
@@ -70,6 +72,24 @@ typedef EMCALIterableContainer::AliEmcalIterableContainerT<TObject, EMCALIterabl
  * }
  * ~~~
  *
+ * # Acceptance cache
+ *
+ * The selection of objects (AcceptObject) is evaluated at most once per event and per
+ * cut configuration: the first request of the accepted objects (accepted iterators,
+ * number of accepted entries, leading object, old-style accept iterators) builds an
+ * acceptance cache containing the accept decision of each entry, the list of accepted
+ * indices, their kinematics (\f$ p_{t} \f$, \f$ \eta \f$, \f$ \phi \f$, E) and a
+ * permutation of the accepted indices sorted by decreasing \f$ p_{t} \f$. Containers of
+ * different tasks connected to the same array and with identical cut configuration
+ * share the same cache within an event: shared caches are keyed by the array and the
+ * global event stamp (current entry of the analysis manager), caches of previous events
+ * are dropped on the next request. The cut configuration is identified by a
+ * signature of the cut values (GetCutValues), recalculated only after a cut setter was
+ * called. Containers of derived classes which do not provide their cut values in
+ * GetCutValues do not use the cache. Tasks modifying objects inside the array in-place
+ * within the same event must call InvalidateSharedAcceptanceCache for the array afterwards.
+ * The cache can be switched off with SetUseAcceptanceCache(kFALSE).
+ *
  * The usage of EMCAL containers is described under \subpage EMCALcontainers
  */
 class AliEmcalContainer : public TObject {
@@ -118,6 +138,31 @@ class AliEmcalContainer : public TObject {
     kOverlapTpcHole = 1<<29             ///<Cut  on the regions of acceptance with bad sectors 
   };
 
+  /**
+   * @struct AcceptanceCache
+   * @brief Selection result and kinematics of accepted objects for one event and cut configuration
+   *
+   * Kinematic arrays are stored in the order of the accepted indices. The
+   * \f$ p_{t} \f$-ordered permutation contains positions inside the accepted
+   * index array.
+   */
+  struct AcceptanceCache {
+    AcceptanceCache();
+
+    const TClonesArray         *fArray;                 ///< Array the cache was built for
+    Long64_t                    fEventStamp;            ///< Event stamp at creation time
+    ULong_t                     fCutSignature;          ///< Signature of the cut configuration
+    Int_t                       fNEntries;              ///< Number of entries in the array at creation time
+    Bool_t                      fValid;                 ///< False if the cache was invalidated
+    std::vector<bool>           fAccepted;              ///< Accept bitmap, one bit per entry in the array
+    std::vector<Int_t>          fIndices;               ///< Accepted indices in ascending order
+    std::vector<Int_t>          fPtOrder;               ///< Positions in fIndices sorted by decreasing \f$ p_{t} \f$
+    std::vector<Double_t>       fPt;                    ///< \f$ p_{t} \f$ of the accepted objects
+    std::vector<Double_t>       fEta;                   ///< \f$ \eta \f$ of the accepted objects
+    std::vector<Double_t>       fPhi;                   ///< \f$ \phi \f$ (0 - 2\f$ \pi \f$) of the accepted objects
+    std::vector<Double_t>       fE;                     ///< Energy of the accepted objects
+  };
+
   AliEmcalContainer();
   AliEmcalContainer(const char *name); 
   virtual ~AliEmcalContainer(){;}
@@ -151,30 +196,37 @@ class AliEmcalContainer : public TObject {
   virtual Bool_t              AcceptObject(Int_t i, UInt_t &rejectionReason) const = 0;
   virtual Bool_t              AcceptObject(const TObject* obj, UInt_t &rejectionReason) const = 0;
   Int_t                       GetNAcceptEntries() const;
+  const AcceptanceCache      *GetAcceptanceCache(Bool_t checkConfig = kTRUE) const;
+  Bool_t                      IsAccepted(Int_t i) const;
+  Int_t                       GetLeadingAcceptIndex() const;
+  void                        InvalidateAcceptanceCache()           { fAcceptanceCache.reset()          ; }
+  void                        SetUseAcceptanceCache(Bool_t b)       { fUseAcceptanceCache = b; fAcceptanceCache.reset(); }
+  Bool_t                      GetUseAcceptanceCache()         const { return fUseAcceptanceCache        ; }
+  static void                 InvalidateSharedAcceptanceCache(const TClonesArray *array);
   void                        ResetCurrentID(Int_t i=-1)            { fCurrentID = i                    ; }
   virtual void                SetArray(const AliVEvent *event);
   void                        SetArrayName(const char *n)           { fClArrayName = n                  ; }
   void                        SetVertex(Double_t *vtx)              { memcpy(fVertex, vtx, sizeof(Double_t) * 3); }
-  void                        SetBitMap(UInt_t m)                   { fBitMap = m                       ; }
-  void                        SetIsParticleLevel(Bool_t b)          { fIsParticleLevel = b              ; }
+  void                        SetBitMap(UInt_t m)                   { fBitMap = m                       ; CutsChanged(); }
+  void                        SetIsParticleLevel(Bool_t b)          { fIsParticleLevel = b              ; CutsChanged(); }
   void                        SortArray()                           { fClArray->Sort()                  ; }
 
   TClass*                     GetLoadedClass()                      { return fLoadedClass               ; }
   virtual void                NextEvent(const AliVEvent *event);
-  void                        SetMinMCLabel(Int_t s)                            { fMinMCLabel      = s   ; }
-  void                        SetMaxMCLabel(Int_t s)                            { fMaxMCLabel      = s   ; }
+  void                        SetMinMCLabel(Int_t s)                            { fMinMCLabel      = s   ; CutsChanged(); }
+  void                        SetMaxMCLabel(Int_t s)                            { fMaxMCLabel      = s   ; CutsChanged(); }
   void                        SetMCLabelRange(Int_t min, Int_t max)             { SetMinMCLabel(min)     ; SetMaxMCLabel(max)    ; }
-  void                        SetELimits(Double_t min, Double_t max)    { fMinE   = min ; fMaxE   = max ; }
-  void                        SetMinE(Double_t min)                     { fMinE   = min ; }
-  void                        SetMaxE(Double_t max)                     { fMaxE   = max ; }
-  void                        SetPtLimits(Double_t min, Double_t max)   { fMinPt  = min ; fMaxPt  = max ; }
-  void                        SetMinPt(Double_t min)                    { fMinPt  = min ; }
-  void                        SetMaxPt(Double_t max)                    { fMaxPt  = max ; }
-  void                        SetEtaLimits(Double_t min, Double_t max)  { fMaxEta = max ; fMinEta = min ; }
-  void                        SetPhiLimits(Double_t min, Double_t max)  { fMaxPhi = max ; fMinPhi = min ; }
-  void                        SetMassHypothesis(Double_t m)             { fMassHypothesis         = m   ; }
+  void                        SetELimits(Double_t min, Double_t max)    { fMinE   = min ; fMaxE   = max ; CutsChanged(); }
+  void                        SetMinE(Double_t min)                     { fMinE   = min ; CutsChanged(); }
+  void                        SetMaxE(Double_t max)                     { fMaxE   = max ; CutsChanged(); }
+  void                        SetPtLimits(Double_t min, Double_t max)   { fMinPt  = min ; fMaxPt  = max ; CutsChanged(); }
+  void                        SetMinPt(Double_t min)                    { fMinPt  = min ; CutsChanged(); }
+  void                        SetMaxPt(Double_t max)                    { fMaxPt  = max ; CutsChanged(); }
+  void                        SetEtaLimits(Double_t min, Double_t max)  { fMaxEta = max ; fMinEta = min ; CutsChanged(); }
+  void                        SetPhiLimits(Double_t min, Double_t max)  { fMaxPhi = max ; fMinPhi = min ; CutsChanged(); }
+  void                        SetMassHypothesis(Double_t m)             { fMassHypothesis         = m   ; CutsChanged(); }
   void                        SetClassName(const char *clname);
-  void                        SetIsEmbedding(Bool_t b)                  { fIsEmbedding = b ; }
+  void                        SetIsEmbedding(Bool_t b)                  { fIsEmbedding = b ; CutsChanged(); }
   Bool_t                      GetIsEmbedding() const                    { return fIsEmbedding; }
 
   const char*                 GetName()                       const { return fName.Data()               ; }
@@ -203,6 +255,13 @@ class AliEmcalContainer : public TObject {
    */
   virtual TString             GetDefaultArrayName(const AliVEvent * const ev) const { return ""; }
   void                        GetVertexFromEvent(const AliVEvent * event);
+  virtual TClass             *GetCutValues(std::vector<Double_t> &values) const;
+  ULong_t                     GetCutSignature() const;
+  Bool_t                      HasCompleteCutSignature() const;
+  /// To be called by all setters of selection settings
+  void                        CutsChanged()                         { fCutSignatureDirty = kTRUE; fAcceptanceCache.reset(); }
+  void                        BuildAcceptanceCache(AcceptanceCache &cache) const;
+  static Long64_t             GetGlobalEventStamp();
 
   TString                     fName;                    ///< object name
   TString                     fClArrayName;             ///< name of branch
@@ -221,11 +280,19 @@ class AliEmcalContainer : public TObject {
   Int_t                       fMaxMCLabel;              ///< maximum MC label
   Double_t                    fMassHypothesis;          ///< if < 0 it will use a PID mass when available
   Bool_t                      fIsEmbedding;             ///< if true, this container will connect to an external event
+  Bool_t                      fUseAcceptanceCache;      ///< if true, selection results are cached per event
   TClonesArray               *fClArray;                 //!<! Pointer to array in input event
   Int_t                       fCurrentID;               //!<! current ID for automatic loops
   AliNamedArrayI             *fLabelMap;                //!<! Label-Index map
   Double_t                    fVertex[3];               //!<! event vertex array
   TClass                     *fLoadedClass;             //!<! Class of the objects contained in the TClonesArray
+  Long64_t                    fEventCounter;            //!<! Number of events seen by NextEvent
+  Long64_t                    fLastEventStamp;          //!<! Global event stamp at the last call of NextEvent
+  Bool_t                      fShareAcceptanceCache;    //!<! Acceptance cache can be shared with other containers in this event
+  mutable std::shared_ptr<AcceptanceCache> fAcceptanceCache; //!<! Acceptance cache for the current event
+  mutable ULong_t             fCutSignature;            //!<! Signature of the cut values
+  mutable Bool_t              fCutSignatureComplete;    //!<! GetCutValues provides all cut values of the class
+  mutable Bool_t              fCutSignatureDirty;       //!<! Cut values changed since the signature was calculated
 
  private:
   TString                     fClassName;               ///< name of the class in the TClonesArray
@@ -234,7 +301,7 @@ class AliEmcalContainer : public TObject {
   AliEmcalContainer& operator=(const AliEmcalContainer& other); // assignment
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalContainer,9);
+  ClassDef(AliEmcalContainer,10);
   /// \endcond
 };
 #endif
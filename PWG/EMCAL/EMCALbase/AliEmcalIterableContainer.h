@@ -327,11 +327,18 @@ T *AliEmcalIterableContainerT<T, STAR>::operator[](int index) const {
 
 /**
  * Build list of accepted indices inside the container.
- * For this all objects inside the container are checked
- * for being accepted or not.
+ * The indices are taken from the acceptance cache of the
+ * container if available, otherwise all objects inside the
+ * container are checked for being accepted or not.
  */
 template <typename T, typename STAR>
 void AliEmcalIterableContainerT<T, STAR>::BuildAcceptIndices(){
+  const AliEmcalContainer::AcceptanceCache *cache = fkContainer->GetAcceptanceCache();
+  if (cache) {
+    // Selection already evaluated for this event and cut configuration
+    fAcceptIndices.Set(cache->fIndices.size(), cache->fIndices.data());
+    return;
+  }
   fAcceptIndices.Set(fkContainer->GetNAcceptEntries());
   int acceptCounter = 0;
   for(int index = 0; index < fkContainer->GetNEntries(); index++){
@@ -243,6 +243,18 @@ const AliMCParticleIterableMomentumContainer AliMCParticleContainer::accepted_mo
   return AliMCParticleIterableMomentumContainer(this, true);
 }
 
+/**
+ * Add the MC flag selection to the cut values of the particle container.
+ * @param[out] values Cut values
+ * @return Class whose selection settings are all contained in the values
+ */
+TClass *AliMCParticleContainer::GetCutValues(std::vector<Double_t> &values) const
+{
+  AliParticleContainer::GetCutValues(values);
+  values.push_back(fMCFlag);
+  return AliMCParticleContainer::Class();
+}
+
 /**
  * Build title of the container consisting of the container name
  * and a string encoding the minimum \f$ p_{t} \f$ cut applied
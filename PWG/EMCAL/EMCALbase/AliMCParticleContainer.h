@@ -47,8 +47,8 @@ class AliMCParticleContainer : public AliParticleContainer {
   virtual AliVParticle       *GetNextAcceptParticle()                         { return GetNextAcceptMCParticle()  ; }
   virtual AliVParticle       *GetNextParticle()                               { return GetNextMCParticle()        ; }
 
-  void                        SetMCFlag(UInt_t m)                             { fMCFlag          = m ; }
-  void                        SelectPhysicalPrimaries(Bool_t s)               { if (s) fMCFlag |=  AliAODMCParticle::kPhysicalPrim ;   }
+  void                        SetMCFlag(UInt_t m)                             { fMCFlag          = m ; CutsChanged(); }
+  void                        SelectPhysicalPrimaries(Bool_t s)               { if (s) fMCFlag |=  AliAODMCParticle::kPhysicalPrim ; CutsChanged(); }
 
   const char*                 GetTitle() const;
 
@@ -62,6 +62,7 @@ class AliMCParticleContainer : public AliParticleContainer {
 
  protected:
   virtual TString             GetDefaultArrayName(const AliVEvent * const ev) const { return "mcparticles"; }
+  virtual TClass             *GetCutValues(std::vector<Double_t> &values) const;
 
   UInt_t                      fMCFlag;                        ///< select MC particles with flags
 
@@ -16,6 +16,7 @@
 #include <iostream>
 #include <vector>
 #include <TClonesArray.h>
+#include <TMath.h>
 
 #include "AliVEvent.h"
 #include "AliLog.h"
@@ -57,6 +58,20 @@ AliParticleContainer::AliParticleContainer(const char *name) :
   SetClassName("AliVParticle");
 }
 
+/**
+ * Add the particle selection settings to the cut values of the base class.
+ * @param[out] values Cut values
+ * @return Class whose selection settings are all contained in the values
+ */
+TClass *AliParticleContainer::GetCutValues(std::vector<Double_t> &values) const
+{
+  AliEmcalContainer::GetCutValues(values);
+  values.push_back(fMinDistanceTPCSectorEdge);
+  values.push_back(fChargeCut);
+  values.push_back(fGeneratorIndex);
+  return AliParticleContainer::Class();
+}
+
 /**
  * Get the leading particle in the container. If "p" is contained in the parameter opt,
  * then the absolute momentum is use instead of the transverse momentum.
@@ -68,6 +83,23 @@ AliVParticle* AliParticleContainer::GetLeadingParticle(const char* opt)
   TString option(opt);
   option.ToLower();
 
+  const AcceptanceCache *cache = GetAcceptanceCache();
+  if (cache) {
+    if (!cache->fIndices.size()) return 0;
+    if (!option.Contains("p")) return GetParticle(cache->fIndices[cache->fPtOrder[0]]);
+    // p = pt * cosh(eta), only the accepted particles are checked
+    UInt_t posMax = 0;
+    Double_t pMax = cache->fPt[0] * TMath::CosH(cache->fEta[0]);
+    for (UInt_t ipos = 1; ipos < cache->fIndices.size(); ipos++) {
+      Double_t p = cache->fPt[ipos] * TMath::CosH(cache->fEta[ipos]);
+      if (p > pMax) {
+        pMax = p;
+        posMax = ipos;
+      }
+    }
+    return GetParticle(cache->fIndices[posMax]);
+  }
+
   Int_t tempID = fCurrentID;
   ResetCurrentID();
 
@@ -112,9 +144,8 @@ AliVParticle* AliParticleContainer::GetParticle(Int_t i) const
  */
 AliVParticle* AliParticleContainer::GetAcceptParticle(Int_t i) const
 {
-  UInt_t rejectionReason = 0;
   if (i == -1) i = fCurrentID;
-  if (AcceptParticle(i, rejectionReason)) {
+  if (IsAccepted(i)) {
       return GetParticle(i);
   }
   else {
@@ -131,6 +162,8 @@ AliVParticle* AliParticleContainer::GetAcceptParticle(Int_t i) const
  */
 AliVParticle* AliParticleContainer::GetNextAcceptParticle()
 {
+  // Make sure the acceptance cache matches the current cut configuration at the start of the iteration
+  if (fCurrentID < 0) GetAcceptanceCache();
   const Int_t n = GetNEntries();
   AliVParticle *p = 0;
   do {
@@ -418,6 +451,8 @@ Bool_t AliParticleContainer::ApplyKinematicCuts(const AliTLorentzVector& mom, UI
  */
 Int_t AliParticleContainer::GetNAcceptedParticles() const
 {
+  const AcceptanceCache *cache = GetAcceptanceCache();
+  if (cache) return cache->fIndices.size();
   Int_t nPart = 0;
   for(int ipart = 0; ipart < this->GetNParticles(); ipart++){
     UInt_t rejectionReason = 0;
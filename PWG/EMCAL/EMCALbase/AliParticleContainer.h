@@ -71,10 +71,10 @@ class AliParticleContainer : public AliEmcalContainer {
   virtual Bool_t              GetNextAcceptMomentum(TLorentzVector &mom);
   Int_t                       GetNParticles()                           const   {return GetNEntries();}
   Int_t                       GetNAcceptedParticles()                   const;
-  void                        SetMinDistanceTPCSectorEdge(Double_t min)         { fMinDistanceTPCSectorEdge = min; }
-  void                        SetCharge(EChargeCut_t c)                         { fChargeCut = c       ; }
-  void                        SelectHIJING(Bool_t s)                            { if (s) fGeneratorIndex = 0; else fGeneratorIndex = -1; }
-  void                        SetGeneratorIndex(Short_t i)                      { fGeneratorIndex = i  ; }
+  void                        SetMinDistanceTPCSectorEdge(Double_t min)         { fMinDistanceTPCSectorEdge = min; CutsChanged(); }
+  void                        SetCharge(EChargeCut_t c)                         { fChargeCut = c       ; CutsChanged(); }
+  void                        SelectHIJING(Bool_t s)                            { if (s) fGeneratorIndex = 0; else fGeneratorIndex = -1; CutsChanged(); }
+  void                        SetGeneratorIndex(Short_t i)                      { fGeneratorIndex = i  ; CutsChanged(); }
   void                        SetArray(const AliVEvent * event);
 
   const char*                 GetTitle() const;
@@ -91,6 +91,7 @@ class AliParticleContainer : public AliEmcalContainer {
 #endif
 
  protected:
+  virtual TClass             *GetCutValues(std::vector<Double_t> &values) const;
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
   static AliEmcalContainerIndexMap <TClonesArray, AliVParticle> fgEmcalContainerIndexMap; //!<! Mapping from containers to indices
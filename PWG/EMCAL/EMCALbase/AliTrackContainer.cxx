@@ -25,7 +25,11 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
  ************************************************************************************/
 #include <bitset>
+#include <functional>
 #include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
 #include <TClonesArray.h>
 
 #include "AliAODEvent.h"
@@ -49,6 +53,24 @@ ClassImp(AliTrackContainer);
 
 TString AliTrackContainer::fgDefTrackCutsPeriod = "";
 
+namespace {
+  /// Result of the track selection shared between containers with the same track selection on the same array
+  struct SharedTrackSelection {
+    Long64_t                fEventStamp;    ///< Global event stamp at which the selection was run
+    Int_t                   fNEntries;      ///< Number of entries of the array at the time of the selection
+    std::vector<AliVTrack*> fTracks;        ///< Tracks (NULL for tracks without selection result)
+    std::vector<Char_t>     fTypes;         ///< Track types
+  };
+
+  /// Registry of shared track selections, keyed by array and track selection signature
+  typedef std::map<std::pair<const TClonesArray *, ULong_t>, SharedTrackSelection> TrackSelectionRegistry_t;
+
+  TrackSelectionRegistry_t &GetTrackSelectionRegistry() {
+    static TrackSelectionRegistry_t registry;
+    return registry;
+  }
+}
+
 // string to enum map for use with the %YAML config
 const std::map <std::string, AliEmcalTrackSelection::ETrackFilterType_t> AliTrackContainer::fgkTrackFilterTypeMap = {
   {"kNoTrackFilter", AliEmcalTrackSelection::kNoTrackFilter },
@@ -74,6 +96,8 @@ AliTrackContainer::AliTrackContainer():
   fAODFilterBits(0),
   fTrackCutsPeriod(),
   fEmcalTrackSelection(0),
+  fTrackSelectionSignature(0),
+  fTrackSelectionEvent(-1),
   fFilteredTracks(),
   fTrackTypes(5000)
 {
@@ -96,6 +120,8 @@ AliTrackContainer::AliTrackContainer(const char *name, const char *period):
   fAODFilterBits(0),
   fTrackCutsPeriod(period),
   fEmcalTrackSelection(0),
+  fTrackSelectionSignature(0),
+  fTrackSelectionEvent(-1),
   fFilteredTracks(),
   fTrackTypes(5000)
 {
@@ -174,75 +200,168 @@ void AliTrackContainer::SetArray(const AliVEvent *event)
       }
     }
   }
+
+  // Signature of the settings the track selection was created with, identifying
+  // track selections which can be shared with other containers
+  std::string key(Form("%d %s %u %d %s", fTrackFilterType, fTrackCutsPeriod.Data(), fAODFilterBits,
+                       fSelectionModeAny, fLoadedClass ? fLoadedClass->GetName() : ""));
+  if (fTrackFilterType == AliEmcalTrackSelection::kCustomTrackFilter && fListOfCuts) {
+    for (Int_t icut = 0; icut < fListOfCuts->GetEntriesFast(); icut++) key.append(Form(" %p", static_cast<void *>(fListOfCuts->At(icut))));
+  }
+  fTrackSelectionSignature = std::hash<std::string>()(key);
+  CutsChanged();
+
+  fTrackSelectionEvent = -1;
 }
 
 /**
- * Preparation for the next event: Run the track
- * selection of all bit and store the pointers to
- * selected tracks in a separate array.
+ * Preparation for the next event. The track selection is run
+ * on first access to the tracks in this event (see RunTrackSelection),
+ * unless the acceptance cache is disabled, in which case it is run here.
+ * Shared track selections are keyed by the global event stamp, selections
+ * of previous events are dropped when the selection is run next.
  */
 void AliTrackContainer::NextEvent(const AliVEvent * event)
 {
   AliParticleContainer::NextEvent(event);
 
-  fTrackTypes.Reset(kUndefined);
+  fTrackSelectionEvent = -1;
   if (fEmcalTrackSelection) {
-    auto acceptedTracks = fEmcalTrackSelection->GetAcceptedTracks(fClArray);
-
-    TObjArray *trackarray(fFilteredTracks.GetData());
-    if(!trackarray){
-      trackarray = new TObjArray;
-      trackarray->SetOwner(false);
-      fFilteredTracks.SetObject(trackarray);
-      fFilteredTracks.SetOwner(true);
-    } else {
-      trackarray->Clear();
-    }
+    if (!fUseAcceptanceCache) RunTrackSelection();
+  }
+  else {
+    fTrackTypes.Reset(kUndefined);
+    fFilteredTracks.SetOwner(false);
+    fFilteredTracks.SetObject(fClArray);
+    fTrackSelectionEvent = fEventCounter;
+  }
+}
 
-    int naccepted(0), nrejected(0), nhybridTracks1(0), nhybridTracks2(0), nhybridTracks3(0);
-    Int_t i = 0;
-    for(auto accresult : *acceptedTracks) {
-      if (i >= fTrackTypes.GetSize()) fTrackTypes.Set((i+1)*2);
-      PWG::EMCAL::AliEmcalTrackSelResultPtr *selectionResult = static_cast<PWG::EMCAL::AliEmcalTrackSelResultPtr *>(accresult);
-      AliVTrack *vTrack = selectionResult->GetTrack();
-      trackarray->AddLast(vTrack);
-      if (!(*selectionResult) || !vTrack) {
-        nrejected++;
-        fTrackTypes[i] = kRejected;
+/**
+ * Run the track selection of all bits for the current event, if not yet
+ * done, and store the pointers to selected tracks in a separate array.
+ * In case another container with the same track selection settings on the
+ * same array already ran the selection in this event, its result is reused.
+ */
+void AliTrackContainer::RunTrackSelection() const
+{
+  if (fTrackSelectionEvent == fEventCounter || !fEmcalTrackSelection || !fClArray) return;
+  fTrackSelectionEvent = fEventCounter;
+
+  TObjArray *trackarray(fFilteredTracks.GetData());
+  if(!trackarray || !fFilteredTracks.IsOwner()){
+    trackarray = new TObjArray;
+    trackarray->SetOwner(false);
+    fFilteredTracks.SetObject(trackarray);
+    fFilteredTracks.SetOwner(true);
+  } else {
+    trackarray->Clear();
+  }
+  fTrackTypes.Reset(kUndefined);
+
+  const Bool_t share = fUseAcceptanceCache && fShareAcceptanceCache && GetGlobalEventStamp() == fLastEventStamp;
+  TrackSelectionRegistry_t &registry = GetTrackSelectionRegistry();
+  auto key = std::make_pair(static_cast<const TClonesArray *>(fClArray), fTrackSelectionSignature * 2 + (fITSHybridTrackDistinction ? 1 : 0));
+  if (share) {
+    auto found = registry.find(key);
+    if (found != registry.end() && found->second.fEventStamp == fLastEventStamp && found->second.fNEntries == fClArray->GetEntriesFast()) {
+      const SharedTrackSelection &shared = found->second;
+      if (static_cast<Int_t>(shared.fTypes.size()) > fTrackTypes.GetSize()) fTrackTypes.Set(shared.fTypes.size() * 2);
+      for (std::size_t i = 0; i < shared.fTracks.size(); i++) {
+        trackarray->AddLast(shared.fTracks[i]);
+        fTrackTypes[i] = shared.fTypes[i];
       }
-      else{ 
-        // track is accepted;
-        naccepted++;
-        if (IsHybridTrackSelection()) {
-          switch(GetHybridDefinition(*selectionResult)) {
-            case PWG::EMCAL::AliEmcalTrackSelResultHybrid::kHybridGlobal:
-              fTrackTypes[i] = kHybridGlobal;
-              nhybridTracks1++;
-              break;
-            case PWG::EMCAL::AliEmcalTrackSelResultHybrid::kHybridConstrained:
-              fTrackTypes[i] = kHybridConstrained;
-              nhybridTracks2++;
-              break;
-            case PWG::EMCAL::AliEmcalTrackSelResultHybrid::kHybridConstrainedNoITSrefit:
-              fTrackTypes[i] = kHybridConstrainedNoITSrefit;
-              nhybridTracks3++;
-              break;
-            case PWG::EMCAL::AliEmcalTrackSelResultHybrid::kUndefined:
-              fTrackTypes[i] = kRejected; // should in principle never happen
-              break;
-          };
-        }
+      return;
+    }
+  }
+
+  auto acceptedTracks = fEmcalTrackSelection->GetAcceptedTracks(fClArray);
+
+  int naccepted(0), nrejected(0), nhybridTracks1(0), nhybridTracks2(0), nhybridTracks3(0);
+  Int_t i = 0;
+  for(auto accresult : *acceptedTracks) {
+    if (i >= fTrackTypes.GetSize()) fTrackTypes.Set((i+1)*2);
+    PWG::EMCAL::AliEmcalTrackSelResultPtr *selectionResult = static_cast<PWG::EMCAL::AliEmcalTrackSelResultPtr *>(accresult);
+    AliVTrack *vTrack = selectionResult->GetTrack();
+    trackarray->AddLast(vTrack);
+    if (!(*selectionResult) || !vTrack) {
+      nrejected++;
+      fTrackTypes[i] = kRejected;
+    }
+    else{ 
+      // track is accepted;
+      naccepted++;
+      if (IsHybridTrackSelection()) {
+        switch(GetHybridDefinition(*selectionResult)) {
+          case PWG::EMCAL::AliEmcalTrackSelResultHybrid::kHybridGlobal:
+            fTrackTypes[i] = kHybridGlobal;
+            nhybridTracks1++;
+            break;
+          case PWG::EMCAL::AliEmcalTrackSelResultHybrid::kHybridConstrained:
+            fTrackTypes[i] = kHybridConstrained;
+            nhybridTracks2++;
+            break;
+          case PWG::EMCAL::AliEmcalTrackSelResultHybrid::kHybridConstrainedNoITSrefit:
+            fTrackTypes[i] = kHybridConstrainedNoITSrefit;
+            nhybridTracks3++;
+            break;
+          case PWG::EMCAL::AliEmcalTrackSelResultHybrid::kUndefined:
+            fTrackTypes[i] = kRejected; // should in principle never happen
+            break;
+        };
       }
-     i++;
     }
-    AliDebugStream(1) << "Accepted: " << naccepted << ", Rejected: " << nrejected << ", hybrid: (" << nhybridTracks1 << " | " << nhybridTracks2 << " | " << nhybridTracks3 << ")" << std::endl;
+   i++;
   }
-  else {
-    fFilteredTracks.SetOwner(false);
-    fFilteredTracks.SetObject(fClArray);
+  AliDebugStream(1) << "Accepted: " << naccepted << ", Rejected: " << nrejected << ", hybrid: (" << nhybridTracks1 << " | " << nhybridTracks2 << " | " << nhybridTracks3 << ")" << std::endl;
+
+  if (share) {
+    // Remove selections from previous events
+    for (auto it = registry.begin(); it != registry.end();) {
+      if (it->second.fEventStamp != fLastEventStamp) it = registry.erase(it);
+      else ++it;
+    }
+    SharedTrackSelection &shared = registry[key];
+    shared.fEventStamp = fLastEventStamp;
+    shared.fNEntries = fClArray->GetEntriesFast();
+    shared.fTracks.resize(trackarray->GetEntriesFast());
+    shared.fTypes.resize(trackarray->GetEntriesFast());
+    for (Int_t i = 0; i < trackarray->GetEntriesFast(); i++) {
+      shared.fTracks[i] = static_cast<AliVTrack *>(trackarray->At(i));
+      shared.fTypes[i] = fTrackTypes[i];
+    }
   }
 }
 
+/**
+ * Invalidate all shared track selections run on a given array. Needs to be
+ * called by tasks modifying the tracks in the array in-place after the modification.
+ * @param[in] array Array for which the track selections are invalidated
+ */
+void AliTrackContainer::InvalidateSharedTrackSelection(const TClonesArray *array)
+{
+  TrackSelectionRegistry_t &registry = GetTrackSelectionRegistry();
+  for (auto it = registry.begin(); it != registry.end();) {
+    if (it->first.first == array) it = registry.erase(it);
+    else ++it;
+  }
+}
+
+/**
+ * Add the values of the track selection settings to the list used for the
+ * cut signature of the acceptance cache.
+ * @param[out] values Cut values
+ * @return AliTrackContainer class
+ */
+TClass *AliTrackContainer::GetCutValues(std::vector<Double_t> &values) const
+{
+  AliParticleContainer::GetCutValues(values);
+  values.push_back(static_cast<Double_t>(static_cast<ULong64_t>(fTrackSelectionSignature) >> 32));
+  values.push_back(static_cast<Double_t>(fTrackSelectionSignature & 0xffffffff));
+  values.push_back(static_cast<Double_t>(fITSHybridTrackDistinction));
+  return AliTrackContainer::Class();
+}
+
 /**
  * Get track at index in the container
  * @param[in] i Index of the particle in the container
@@ -252,6 +371,7 @@ AliVTrack* AliTrackContainer::GetTrack(Int_t i) const
 {
   //Get i^th jet in array
 
+  RunTrackSelection();
   if (i < 0 || i >= fFilteredTracks.GetData()->GetEntriesFast()) return 0;
   AliVTrack *vp = static_cast<AliVTrack*>(fFilteredTracks.GetData()->At(i));
   return vp;
@@ -319,6 +439,7 @@ AliVTrack* AliTrackContainer::GetNextTrack()
  */
 Char_t AliTrackContainer::GetTrackType(const AliVTrack* track) const
 {
+  RunTrackSelection();
   Int_t id = fFilteredTracks.GetData()->IndexOf(track);
   if (id >= 0) {
     return fTrackTypes[id];
@@ -554,6 +675,7 @@ Bool_t AliTrackContainer::AcceptTrack(const AliVTrack *vp, UInt_t &rejectionReas
  */
 Bool_t AliTrackContainer::AcceptTrack(Int_t i, UInt_t &rejectionReason) const
 {
+  RunTrackSelection();
   if(fTrackTypes[i] == kRejected) return false; // track was rejected by the track selection
   Bool_t r = ApplyTrackCuts(GetTrack(i), rejectionReason);
   if (!r) return kFALSE;
@@ -589,6 +711,7 @@ void AliTrackContainer::AddTrackCuts(AliVCuts *cuts)
     fListOfCuts->SetOwner(true);
   }
   fListOfCuts->Add(cuts);
+  CutsChanged();
 }
 
 /**
@@ -644,6 +767,7 @@ PWG::EMCAL::AliEmcalTrackSelResultHybrid::HybridType_t AliTrackContainer::GetHyb
 
 Bool_t AliTrackContainer::CheckArrayConsistency() const {
   bool teststatus = true;
+  RunTrackSelection();
   auto selected = fFilteredTracks.GetData();
   if(selected->GetEntries() != fClArray->GetEntries()) {
     std::cout << "Mismatch array size: selected " << selected->GetEntries() << ", input " << fClArray->GetEntries() << std::endl; 
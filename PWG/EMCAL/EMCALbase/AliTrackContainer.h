@@ -139,27 +139,28 @@ class AliTrackContainer : public AliParticleContainer {
   Int_t                       GetNTracks()                              const   { return GetNParticles()         ; }
   Int_t                       GetNAcceptedTracks()                              { return GetNAcceptedParticles() ; }
   ETrackFilterType_t          GetTrackFilterType()                      const   { return fTrackFilterType; }
-  Char_t                      GetTrackType(Int_t i)                     const   { return i >= 0 && i < fTrackTypes.GetSize() ? fTrackTypes[i] : (Char_t)kUndefined ; }
+  Char_t                      GetTrackType(Int_t i)                     const   { RunTrackSelection(); return i >= 0 && i < fTrackTypes.GetSize() ? fTrackTypes[i] : (Char_t)kUndefined ; }
 
   void                        SetArray(const AliVEvent *event);
 
-  void                        SetTrackFilterType(ETrackFilterType_t f)          { fTrackFilterType = f; }
-  void                        SetFilterHybridTracks(Bool_t f)                   { if (f) fTrackFilterType = AliEmcalTrackSelection::kHybridTracks; else fTrackFilterType = AliEmcalTrackSelection::kNoTrackFilter; }   // legacy method
-  void                        SetITSHybridTrackDistinction(Bool_t doUse)        { fITSHybridTrackDistinction = doUse; }
+  void                        SetTrackFilterType(ETrackFilterType_t f)          { fTrackFilterType = f; CutsChanged(); }
+  void                        SetFilterHybridTracks(Bool_t f)                   { if (f) fTrackFilterType = AliEmcalTrackSelection::kHybridTracks; else fTrackFilterType = AliEmcalTrackSelection::kNoTrackFilter; CutsChanged(); }   // legacy method
+  void                        SetITSHybridTrackDistinction(Bool_t doUse)        { fITSHybridTrackDistinction = doUse; CutsChanged(); }
 
-  void                        SetTrackCutsPeriod(const char* period)            { fTrackCutsPeriod = period; }
+  void                        SetTrackCutsPeriod(const char* period)            { fTrackCutsPeriod = period; CutsChanged(); }
   void                        AddTrackCuts(AliVCuts *cuts);
   Int_t                       GetNumberOfCutObjects() const;
   AliVCuts                   *GetTrackCuts(Int_t icut);
-  void                        SetAODFilterBits(UInt_t bits)                     { fAODFilterBits   = bits  ; }
-  void                        AddAODFilterBit(UInt_t bit)                       { fAODFilterBits  |= bit   ; }
+  void                        SetAODFilterBits(UInt_t bits)                     { fAODFilterBits   = bits  ; CutsChanged(); }
+  void                        AddAODFilterBit(UInt_t bit)                       { fAODFilterBits  |= bit   ; CutsChanged(); }
   UInt_t                      GetAODFilterBits()                          const { return fAODFilterBits    ; }
   Bool_t                      IsHybridTrackSelection() const;
 
-  void SetSelectionModeAny() { fSelectionModeAny = kTRUE ; }
-  void SetSelectionModeAll() { fSelectionModeAny = kFALSE; }
+  void SetSelectionModeAny() { fSelectionModeAny = kTRUE ; CutsChanged(); }
+  void SetSelectionModeAll() { fSelectionModeAny = kFALSE; CutsChanged(); }
 
   void                        NextEvent(const AliVEvent* event);
+  static void                 InvalidateSharedTrackSelection(const TClonesArray *array);
 
   static void                 SetDefTrackCutsPeriod(const char* period)       { fgDefTrackCutsPeriod = period; }
   static TString              GetDefTrackCutsPeriod()                         { return fgDefTrackCutsPeriod  ; }
@@ -191,6 +192,8 @@ class AliTrackContainer : public AliParticleContainer {
    * @return Appropriate default array name
    */
   virtual TString             GetDefaultArrayName(const AliVEvent * const ev) const;
+  virtual TClass             *GetCutValues(std::vector<Double_t> &values) const;
+  void                        RunTrackSelection() const;
 
   PWG::EMCAL::AliEmcalTrackSelResultHybrid::HybridType_t  GetHybridDefinition(const PWG::EMCAL::AliEmcalTrackSelResultPtr &selectionResult) const;
 
@@ -203,15 +206,17 @@ class AliTrackContainer : public AliParticleContainer {
   UInt_t                      fAODFilterBits;                 ///< track filter bits
   TString                     fTrackCutsPeriod;               ///< period string used to generate track cuts
   AliEmcalTrackSelection     *fEmcalTrackSelection;  //!<! track selection object
-  TrackOwnerHandler           fFilteredTracks;                //!<! tracks filtered using fEmcalTrackSelection
-  TArrayC                     fTrackTypes;                    //!<! track types
+  ULong_t                     fTrackSelectionSignature;       //!<! signature of the settings fEmcalTrackSelection was created with
+  mutable Long64_t            fTrackSelectionEvent;           //!<! event counter at the last track selection
+  mutable TrackOwnerHandler   fFilteredTracks;                //!<! tracks filtered using fEmcalTrackSelection
+  mutable TArrayC             fTrackTypes;                    //!<! track types
 
  private:
   AliTrackContainer(const AliTrackContainer& obj); // copy constructor
   AliTrackContainer& operator=(const AliTrackContainer& other); // assignment
 
   /// \cond CLASSIMP
-  ClassDef(AliTrackContainer,1);
+  ClassDef(AliTrackContainer,2);
   /// \endcond
 };
 
@@ -1013,6 +1013,9 @@ AliEmcalContainer * AliEmcalCorrectionTask::AddContainer(const AliEmcalContainer
     AdoptParticleContainer(dynamic_cast<AliParticleContainer *>(cont));
   }
   cont->SetName(containerName.c_str());
+  // Correction components modify the objects in-place, therefore
+  // the selection must be evaluated on the current state of the objects
+  cont->SetUseAcceptanceCache(kFALSE);
 
   return cont;
 }
@@ -1325,6 +1328,17 @@ Bool_t AliEmcalCorrectionTask::Run()
     component->Run();
   }
 
+  // Objects were modified in-place, acceptance caches and track selections of
+  // other tasks built on these arrays in this event are no longer valid
+  AliEmcalContainer * cont = 0;
+  TIter nextPartColl(&fParticleCollArray);
+  while ((cont = static_cast<AliEmcalContainer*>(nextPartColl()))) {
+    AliEmcalContainer::InvalidateSharedAcceptanceCache(cont->GetArray());
+    if (cont->InheritsFrom(AliTrackContainer::Class())) AliTrackContainer::InvalidateSharedTrackSelection(cont->GetArray());
+  }
+  TIter nextClusColl(&fClusterCollArray);
+  while ((cont = static_cast<AliEmcalContainer*>(nextClusColl()))) AliEmcalContainer::InvalidateSharedAcceptanceCache(cont->GetArray());
+
   PostData(1, fOutput);
 
   return kTRUE;
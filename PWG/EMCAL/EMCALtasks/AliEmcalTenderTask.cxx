@@ -5,11 +5,14 @@
 // Author: S.Aiola, C.Loizides
 
 #include <TChain.h>
+#include <TClonesArray.h>
 #include <TFile.h>
 
 #include "AliAnalysisManager.h"
 #include "AliEMCALTenderSupply.h"
 #include "AliAODEvent.h"
+#include "AliEmcalContainerUtils.h"
+#include "AliTrackContainer.h"
 
 #include "AliEmcalTenderTask.h"
 
@@ -79,4 +82,16 @@ void AliEmcalTenderTask::UserExec(Option_t*)
   // Process the event.
 
   fEMCALTender->ProcessEvent();
+
+  // Clusters and tracks (track matching) were modified in-place, acceptance caches and
+  // track selections of containers of other tasks built on them in this event are no longer valid
+  AliVEvent *event = InputEvent();
+  if (!event) return;
+  TClonesArray *clusters = dynamic_cast<TClonesArray*>(event->FindListObject(AliEmcalContainerUtils::DetermineUseDefaultName(AliEmcalContainerUtils::kCluster).c_str()));
+  if (clusters) AliEmcalContainer::InvalidateSharedAcceptanceCache(clusters);
+  TClonesArray *tracks = dynamic_cast<TClonesArray*>(event->FindListObject(AliEmcalContainerUtils::DetermineUseDefaultName(AliEmcalContainerUtils::kTrack).c_str()));
+  if (tracks) {
+    AliEmcalContainer::InvalidateSharedAcceptanceCache(tracks);
+    AliTrackContainer::InvalidateSharedTrackSelection(tracks);
+  }
 }
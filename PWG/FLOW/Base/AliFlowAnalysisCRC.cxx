@@ -148,8 +148,6 @@ fUseQvectorTerms(kFALSE),
 fReQ(NULL),
 fImQ(NULL),
 fSpk(NULL),
-fReQGF(NULL),
-fImQGF(NULL),
 fIntFlowCorrelationsEBE(NULL),
 fIntFlowEventWeightsForCorrelationsEBE(NULL),
 fIntFlowCorrelationsAllEBE(NULL),
@@ -398,11 +396,6 @@ fStoreExtraHistoForSubSampling(kFALSE)
 
   // printf("Arrays initialized \n");
 
-  for(Int_t i=0; i<fkGFPtB; i++) {
-    fReQGFPt[i] = NULL;
-    fImQGFPt[i] = NULL;
-  }
-
 } // end of constructor
 
 //================================================================================================================
@@ -991,18 +984,11 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
           if(dPhi>2.136283 && dPhi<2.324779) continue;
         }
 
-        // Generic Framework: Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
+        // Generic Framework: Calculate Q_{m,k} for this event (m = 0,1,...,20, k = 0,1,...,8):
         Double_t MaxPtCut = 3.;
         if(fMinMulZN==99) MaxPtCut = 1.;
         if(dPt<MaxPtCut) {
-          for(Int_t m=0;m<21;m++) // to be improved - hardwired 6
-          {
-            for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-            {
-              (*fReQGF)(m,k) += pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos(m*dPhi);
-              (*fImQGF)(m,k) += pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin(m*dPhi);
-            }
-          }
+          fQvectorGF.Fill(dPhi,wPhiEta*wPhi*wPt*wEta*wTrack);
         }
 
         for(Int_t ptb=0; ptb<fkGFPtB; ptb++) {
@@ -1014,14 +1000,7 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
           if(ptb==5 && dPt<2.5) continue;
           if(ptb==6 && (dPt<1. || dPt>3.)) continue;
           if(ptb==7 && dPt<3.) continue;
-          for(Int_t m=0;m<21;m++) // to be improved - hardwired 6
-          {
-            for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-            {
-              (*fReQGFPt[ptb])(m,k) += pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos(m*dPhi);
-              (*fImQGFPt[ptb])(m,k) += pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin(m*dPhi);
-            }
-          }
+          fQvectorGFPt[ptb].Fill(dPhi,wPhiEta*wPhi*wPt*wEta*wTrack);
         }
 
         ptEta[0] = dPt;
@@ -2495,12 +2474,6 @@ void AliFlowAnalysisCRC::BookEverythingForIntegratedFlow()
   fReQ = new TMatrixD(12,9);
   fImQ = new TMatrixD(12,9);
   fSpk = new TMatrixD(8,9);
-  fReQGF = new TMatrixD(21,9);
-  fImQGF = new TMatrixD(21,9);
-  for(Int_t i=0; i<fkGFPtB; i++) {
-    fReQGFPt[i] = new TMatrixD(21,9);
-    fImQGFPt[i] = new TMatrixD(21,9);
-  }
   // average correlations <2>, <4>, <6> and <8> for single event (bining is the same as in fIntFlowCorrelationsPro and fIntFlowCorrelationsHist):
   TString intFlowCorrelationsEBEName = "fIntFlowCorrelationsEBE";
   intFlowCorrelationsEBEName += fAnalysisLabel->Data();
@@ -10072,7 +10045,7 @@ void AliFlowAnalysisCRC::CalculateFlowGF()
 
   Int_t SubSamplingBin = fRandom->Integer(fkFlowGFNSubSampling);
 
-  Double_t dMult = (*fReQGF)(0,0);
+  Double_t dMult = fQvectorGF.Q(0,0).real();
 
   for(Int_t hr=0; hr<fkFlowGFNHarm; hr++) {
 
@@ -10140,7 +10113,7 @@ void AliFlowAnalysisCRC::CalculateFlowGF()
 
   // in wide pt bins
   for(Int_t i=0; i<fkGFPtB; i++) {
-    Double_t dMult = (*fReQGFPt[i])(0,0);
+    Double_t dMult = fQvectorGFPt[i].Q(0,0).real();
 
     for(Int_t hr=0; hr<fkFlowGFNHarm; hr++) {
 
@@ -10188,48 +10161,10 @@ void AliFlowAnalysisCRC::CalculateFlowGF()
 
 std::complex<double> AliFlowAnalysisCRC::ucN(const Int_t n, const TArrayI& h, Int_t ptb=-1)
 {
-  TArrayI cnt(n);
-  for (Int_t i = 0; i < n; i++) {
-    cnt[i] = 1;
-  }
-  TArrayI hh(h);
-
-  return ucN2(n, hh, cnt, ptb);
-}
-
-std::complex<double> AliFlowAnalysisCRC::ucN2(const Int_t n, TArrayI& h, TArrayI& cnt, Int_t ptb=-1)
-{
-  Int_t j = n-1;
-  std::complex<double> c;
-  if(ptb<0) {
-    if(h[j] >= 0) {
-      c = std::complex<double>((*fReQGF)(h[j],cnt[j]),(*fImQGF)(h[j],cnt[j]));
-    } else {
-      c = std::complex<double>((*fReQGF)(-h[j],cnt[j]),-(*fImQGF)(-h[j],cnt[j]));
-    }
-  } else {
-    if(h[j] >= 0) {
-      c = std::complex<double>((*fReQGFPt[ptb])(h[j],cnt[j]),(*fImQGFPt[ptb])(h[j],cnt[j]));
-    } else {
-      c = std::complex<double>((*fReQGFPt[ptb])(-h[j],cnt[j]),-(*fImQGFPt[ptb])(-h[j],cnt[j]));
-    }
-  }
-
-  if (n == 1) return c;
-
-  c *= ucN2(j, h, cnt, ptb);
-
-  if (cnt[j] > 1) return c;
-
-  for (Int_t i = 0; i < (n-1); i++) {
-    h[i] += h[j];
-    cnt[i] = cnt[i] + 1;
-    Double_t factor = 1.*(cnt[i]-1);
-    c -= factor * ucN2(j, h, cnt, ptb);
-    cnt[i]--;
-    h[i] -= h[j];
-  }
-  return c;
+  // generic n-particle correlator, calculated with the recursion of AliFlowGenericCorrelator
+  // (intermediate results are reused between the correlators of the same event)
+  if(ptb<0) return fQvectorGF.Correlator(n,h.GetArray());
+  return fQvectorGFPt[ptb].Correlator(n,h.GetArray());
 }
 
 //=====================================================================================================
@@ -19731,11 +19666,9 @@ void AliFlowAnalysisCRC::ResetEventByEventQuantities()
   fReQ->Zero();
   fImQ->Zero();
   fSpk->Zero();
-  fReQGF->Zero();
-  fImQGF->Zero();
+  fQvectorGF.Reset();
   for(Int_t i=0; i<fkGFPtB; i++) {
-    fReQGFPt[i]->Zero();
-    fImQGFPt[i]->Zero();
+    fQvectorGFPt[i].Reset();
   }
   fIntFlowCorrelationsEBE->Reset();
   fIntFlowEventWeightsForCorrelationsEBE->Reset();
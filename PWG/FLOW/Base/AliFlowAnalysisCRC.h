@@ -28,6 +28,9 @@
 #include "TH3D.h"
 #include "TRandom3.h"
 #include "AliFlowCommonConstants.h"
+#if !defined(__CINT__)
+#include "AliFlowGenericCorrelator.h"
+#endif
 #include "TNamed.h"
 #include <complex>
 #include <cmath>
@@ -188,7 +191,6 @@ public:
   virtual void CalculateIntFlowSumOfProductOfEventWeightsNUA();
   virtual void CalculateMixedHarmonics();
   virtual std::complex<double> ucN(const Int_t n, const TArrayI& h, Int_t ptb);
-  virtual std::complex<double> ucN2(const Int_t n, TArrayI& h, TArrayI& cnt, Int_t ptb);
   // 2c.) Cross-checking reference flow correlations with nested loops:
   virtual void EvaluateIntFlowNestedLoops(AliFlowEventSimple* const anEvent);
   virtual void EvaluateIntFlowCorrelationsWithNestedLoops(AliFlowEventSimple* const anEvent);
@@ -1284,11 +1286,11 @@ private:
   TMatrixD *fReQ; //! fReQ[m][k] = sum_{i=1}^{M} w_{i}^{k} cos(m*phi_{i})
   TMatrixD *fImQ; //! fImQ[m][k] = sum_{i=1}^{M} w_{i}^{k} sin(m*phi_{i})
   TMatrixD *fSpk; //! fSM[p][k] = (sum_{i=1}^{M} w_{i}^{k})^{p+1}
-  TMatrixD *fReQGF; //! fReQ[m][k] = sum_{i=1}^{M} w_{i}^{k} cos(m*phi_{i})
-  TMatrixD *fImQGF; //! fImQ[m][k] = sum_{i=1}^{M} w_{i}^{k} sin(m*phi_{i})
   const static Int_t fkGFPtB = 8;
-  TMatrixD *fReQGFPt[fkGFPtB]; //! fReQ[m][k] = sum_{i=1}^{M} w_{i}^{k} cos(m*phi_{i})
-  TMatrixD *fImQGFPt[fkGFPtB]; //! fImQ[m][k] = sum_{i=1}^{M} w_{i}^{k} sin(m*phi_{i})
+#if !defined(__CINT__)
+  AliFlowGenericCorrelator<20,8> fQvectorGF; //! Q[m][k] = sum_{i=1}^{M} w_{i}^{k} exp(i*m*phi_{i}), m = 0,...,20, k = 0,...,8
+  AliFlowGenericCorrelator<20,8> fQvectorGFPt[fkGFPtB]; //! same in wide pt bins
+#endif
   TH1D *fIntFlowCorrelationsEBE; //! 1st bin: <2>, 2nd bin: <4>, 3rd bin: <6>, 4th bin: <8>
   TH1D *fIntFlowEventWeightsForCorrelationsEBE; //! 1st bin: eW_<2>, 2nd bin: eW_<4>, 3rd bin: eW_<6>, 4th bin: eW_<8>
   TH1D *fIntFlowCorrelationsAllEBE; //! to be improved (add comment)
@@ -2107,7 +2109,7 @@ private:
   Bool_t fbFlagIsBadRunForC34;
   Bool_t fStoreExtraHistoForSubSampling;
 
-  ClassDef(AliFlowAnalysisCRC,74);
+  ClassDef(AliFlowAnalysisCRC,75);
 
 };
 
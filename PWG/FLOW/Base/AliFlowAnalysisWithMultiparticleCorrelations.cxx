@@ -2035,15 +2035,8 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
    dEta = pTrack->Eta();
    if(fUseWeights[0][2]){wEta = Weight(dEta,"RP","eta");} // corresponding eta weight
 
-   // Calculate Q-vector components:
-   for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
-   {
-    for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight power
-    {
-     if(fUseWeights[0][0]||fUseWeights[0][1]||fUseWeights[0][2]){wToPowerP = pow(wPhi*wPt*wEta,wp);} 
-     fQvector[h][wp] += TComplex(wToPowerP*TMath::Cos(h*dPhi),wToPowerP*TMath::Sin(h*dPhi));
-    } // for(Int_t wp=0;wp<fMaxCorrelator+1;wp++)
-   } // for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+   // Calculate Q-vector components (all harmonics from one sin/cos, powers of weight as running product):
+   fGenericCorrelator.Fill(dPhi,wPhi*wPt*wEta); // all weights are 1 if not used
   } // if(pTrack->InRPSelection()) // fill Q-vector components only with reference particles
 
   // Differential Q-vectors (a.k.a. p-vector and q-vector):
@@ -2104,6 +2097,16 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
 
  } // for(Int_t t=0;t<nTracks;t++) // loop over all tracks
 
+ // Copy Q-vector components:
+ for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+ {
+  for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight power
+  {
+   std::complex<Double_t> q = fGenericCorrelator.Q(h,wp);
+   fQvector[h][wp] = TComplex(q.real(),q.imag());
+  } // for(Int_t wp=0;wp<fMaxCorrelator+1;wp++)
+ } // for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+
 } // void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimple *anEvent)
 
 //=======================================================================================================================
@@ -3862,6 +3865,8 @@ void AliFlowAnalysisWithMultiparticleCorrelations::ResetQvector()
 {
  // Reset all Q-vector components to zero before starting a new event. 
 
+ fGenericCorrelator.Reset();
+
  for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++) 
  {
   for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight powe
@@ -4129,7 +4134,8 @@ TComplex AliFlowAnalysisWithMultiparticleCorrelations::Seven(Int_t n1, Int_t n2,
 
  Int_t harmonic[7] = {n1,n2,n3,n4,n5,n6,n7};
 
- TComplex seven = Recursion(7,harmonic); 
+ std::complex<Double_t> sevenGeneric = fGenericCorrelator.Correlator(7,harmonic); // memoized recursion 
+ TComplex seven(sevenGeneric.real(),sevenGeneric.imag()); 
 
  return seven;
 
@@ -4143,7 +4149,8 @@ TComplex AliFlowAnalysisWithMultiparticleCorrelations::Eight(Int_t n1, Int_t n2,
 
  Int_t harmonic[8] = {n1,n2,n3,n4,n5,n6,n7,n8};
 
- TComplex eight = Recursion(8,harmonic); 
+ std::complex<Double_t> eightGeneric = fGenericCorrelator.Correlator(8,harmonic); // memoized recursion 
+ TComplex eight(eightGeneric.real(),eightGeneric.imag()); 
 
  return eight;
 
@@ -5634,11 +5641,20 @@ Double_t AliFlowAnalysisWithMultiparticleCorrelations::CorrelationPsi2nPsi1n(Int
    Fatal(sMethodName.Data(),"switch(k)"); // TBI
  } // switch(k)
 
- // Calculate weight and correlators:
- Double_t dWeight = Recursion(order,harmonics0.GetArray()).Re(); // weight is 'number of combinations' by default
- TComplex cNum1 = Recursion(order,harmonics1.GetArray())/dWeight;
- TComplex cNum2 = Recursion(order,harmonics2.GetArray())/dWeight;
- ratio = cNum1.Re()/cNum2.Re();
+ // Calculate weight and correlators (memoized recursion of the generic correlator for up to 8 particles):
+ if(order<=fGenericCorrelator.kMaxParticles)
+ {
+  Double_t dWeight = fGenericCorrelator.Correlator(order,harmonics0.GetArray()).real(); // weight is 'number of combinations' by default
+  Double_t dNum1 = fGenericCorrelator.Correlator(order,harmonics1.GetArray()).real()/dWeight;
+  Double_t dNum2 = fGenericCorrelator.Correlator(order,harmonics2.GetArray()).real()/dWeight;
+  ratio = dNum1/dNum2;
+ } else
+   {
+    Double_t dWeight = Recursion(order,harmonics0.GetArray()).Re(); // weight is 'number of combinations' by default
+    TComplex cNum1 = Recursion(order,harmonics1.GetArray())/dWeight;
+    TComplex cNum2 = Recursion(order,harmonics2.GetArray())/dWeight;
+    ratio = cNum1.Re()/cNum2.Re();
+   } // if(order<=fGenericCorrelator.kMaxParticles)
 
  return ratio;
 
@@ -30,6 +30,9 @@
 #include "TStopwatch.h"
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
+#if !defined(__CINT__)
+#include "AliFlowGenericCorrelator.h"
+#endif
 
 class AliFlowAnalysisWithMultiparticleCorrelations{
  public:
@@ -382,6 +385,9 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   TProfile *fQvectorFlagsPro;    // profile to hold all flags for Q-vector
   Bool_t fCalculateQvector;      // to calculate or not to calculate Q-vector components, that's a Boolean...
   TComplex fQvector[49][9];      // Q-vector components [fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1]  
+#if !defined(__CINT__)
+  AliFlowGenericCorrelator<48,8> fGenericCorrelator; //! same Q-vector components as std::complex, used for the correlators evaluated with recursion  
+#endif
   Bool_t fCalculateDiffQvectors; // to calculate or not to calculate p- and q-vector components, that's a Boolean...  
   TComplex fpvector[100][49][9]; // p-vector components [bin][fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1] TBI hardwired 100
   TComplex fqvector[100][49][9]; // q-vector components [bin][fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1] TBI hardwired 100
@@ -476,7 +482,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Int_t fHighestHarmonicEtaGaps;      // 2-p correlations with eta gaps will be calculated for harmonics [fLowestHarmonicEtaGaps,fHighestHarmonicEtaGaps]
   TProfile *fEtaGapsPro[6];           // [harmonic] different eta gaps are different bins
 
-  ClassDef(AliFlowAnalysisWithMultiparticleCorrelations,6);
+  ClassDef(AliFlowAnalysisWithMultiparticleCorrelations,7);
 
 };
 
@@ -69,6 +69,25 @@ using std::cout;
 using std::flush;
 ClassImp(AliFlowAnalysisWithQCumulants)
 
+namespace
+{
+ // number of sums stored per bin in AliFlowAnalysisWithQCumulants::fDiffFlowQvectorsEBE:
+ // Re, Im, Re^2, Im^2 for 4 multiples of harmonic and 9 powers of weight, s and s^2 for 9 powers of weight
+ const Int_t kDiffFlowQvectorsBlockSize = 4*4*9+2*9;
+ 
+ void AddToProfileBin(TProfile *profile, Int_t bin, Int_t nEntries, Double_t dSum, Double_t dSumOfSquares)
+ {
+  // Add nEntries entries with weight 1, sum dSum and sum of squares dSumOfSquares to bin of profile 
+  // (same effect on bin content, bin entries and errors as calling TProfile::Fill() for each entry).
+  
+  profile->GetArray()[bin] += dSum;
+  profile->GetSumw2()->GetArray()[bin] += dSumOfSquares;
+  profile->SetBinEntries(bin,profile->GetBinEntries(bin)+nEntries);
+  if(profile->GetBinSumw2()->GetSize()){profile->GetBinSumw2()->GetArray()[bin] += nEntries;}
+  profile->SetEntries(profile->GetEntries()+nEntries);
+ }
+}
+
 AliFlowAnalysisWithQCumulants::AliFlowAnalysisWithQCumulants(): 
  // 0.) base:
  fHistList(NULL),
@@ -369,6 +388,12 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  fReferenceMultiplicityEBE = anEvent->GetReferenceMultiplicity(); // reference multiplicity for current event
  //Printf("Reference multiplicity (QC): %.1f",fReferenceMultiplicityEBE);
  Double_t ptEta[2] = {0.,0.}; // 0 = dPt, 1 = dEta
+ Double_t cosMnPhi[12] = {0.}; // cos(m*n*phi), m = 1,2,...,12
+ Double_t sinMnPhi[12] = {0.}; // sin(m*n*phi), m = 1,2,...,12
+ Double_t weightPowers[9] = {0.}; // w^k, k = 0,1,...,8
+ Double_t *reQ = fReQ->GetMatrixArray(); // Re[Q_{m*n,k}] stored row-wise, i.e. at [m*9+k]
+ Double_t *imQ = fImQ->GetMatrixArray(); // Im[Q_{m*n,k}] stored row-wise, i.e. at [m*9+k]
+ Double_t *spk = fSpk->GetMatrixArray(); // S_{p,k} stored row-wise, i.e. at [p*9+k]
   
  // c) Fill the common control histograms and call the method to fill fAvMultiplicity:
  this->FillCommonControlHistograms(anEvent);                                                               
@@ -378,7 +403,6 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  // d) Loop over data and calculate e-b-e quantities Q_{n,k}, S_{p,k} and s_{p,k}:
  Int_t nPrim = anEvent->NumberOfTracks();  // nPrim = total number of primary tracks
  AliFlowTrackSimple *aftsTrack = NULL;
- Int_t n = fHarmonic; // shortcut for the harmonic 
  for(Int_t i=0;i<nPrim;i++) 
  { 
   if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
@@ -409,13 +433,15 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     {
      wTrack = aftsTrack->Weight(); 
     }
+    // cos(m*n*phi), sin(m*n*phi) for m = 1,2,...,12 and w^k for k = 0,1,...,8 (from one sin/cos and recurrences):
+    this->CalculateQvectorTerms(dPhi,wPhi*wPt*wEta*wTrack,cosMnPhi,sinMnPhi,weightPowers);
     // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
     for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
     {
      for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
      {
-      (*fReQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1)*n*dPhi); 
-      (*fImQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1)*n*dPhi); 
+      reQ[m*9+k]+=weightPowers[k]*cosMnPhi[m]; 
+      imQ[m*9+k]+=weightPowers[k]*sinMnPhi[m]; 
      } 
     }
     // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
@@ -423,7 +449,7 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     {
      for(Int_t k=0;k<9;k++)
      {     
-      (*fSpk)(p,k)+=pow(wPhi*wPt*wEta*wTrack,k);
+      spk[p*9+k]+=weightPowers[k];
      }
     } 
     // Differential flow:
@@ -432,64 +458,42 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
      ptEta[0] = dPt; 
      ptEta[1] = dEta; 
      // Calculate r_{m*n,k} and s_{p,k} (r_{m,k} is 'p-vector' for RPs): 
-     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+     if(fCalculateDiffFlow){this->AccumulateDiffFlowQvectorsEBE(0,ptEta,cosMnPhi,sinMnPhi,weightPowers);}
+     if(fCalculate2DDiffFlow)
      {
-      for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+      for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
       {
-       if(fCalculateDiffFlow)
-       {
-        for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-        {
-         fReRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-         fImRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
-         if(m==0) // s_{p,k} does not depend on index m
-         {
-          fs1dEBE[0][pe][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k),1.);
-         } // end of if(m==0) // s_{p,k} does not depend on index m
-        } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-       } // end of if(fCalculateDiffFlow) 
-       if(fCalculate2DDiffFlow)
+       for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
        {
-        fReRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-        fImRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
+        fReRPQ2dEBE[0][m][k]->Fill(dPt,dEta,weightPowers[k]*cosMnPhi[m],1.);
+        fImRPQ2dEBE[0][m][k]->Fill(dPt,dEta,weightPowers[k]*sinMnPhi[m],1.);      
         if(m==0) // s_{p,k} does not depend on index m
         {
-         fs2dEBE[0][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k),1.);
+         fs2dEBE[0][k]->Fill(dPt,dEta,weightPowers[k],1.);
         } // end of if(m==0) // s_{p,k} does not depend on index m
-       } // end of if(fCalculate2DDiffFlow)
-      } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-     } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+       } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+      } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+     } // end of if(fCalculate2DDiffFlow)
      // Checking if RP particle is also POI particle:      
      if(aftsTrack->InPOISelection())
      {
       // Calculate q_{m*n,k} and s_{p,k} ('q-vector' and 's' for RPs && POIs): 
-      for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+      if(fCalculateDiffFlow){this->AccumulateDiffFlowQvectorsEBE(2,ptEta,cosMnPhi,sinMnPhi,weightPowers);}
+      if(fCalculate2DDiffFlow)
       {
-       for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+       for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
        {
-        if(fCalculateDiffFlow)
-        {
-         for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-         {
-          fReRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-          fImRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
-          if(m==0) // s_{p,k} does not depend on index m
-          {
-           fs1dEBE[2][pe][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k),1.);
-          } // end of if(m==0) // s_{p,k} does not depend on index m
-         } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-        } // end of if(fCalculateDiffFlow) 
-        if(fCalculate2DDiffFlow)
+        for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
         {
-         fReRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-         fImRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
+         fReRPQ2dEBE[2][m][k]->Fill(dPt,dEta,weightPowers[k]*cosMnPhi[m],1.);
+         fImRPQ2dEBE[2][m][k]->Fill(dPt,dEta,weightPowers[k]*sinMnPhi[m],1.);      
          if(m==0) // s_{p,k} does not depend on index m
          {
-          fs2dEBE[2][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k),1.);
+          fs2dEBE[2][k]->Fill(dPt,dEta,weightPowers[k],1.);
          } // end of if(m==0) // s_{p,k} does not depend on index m
-        } // end of if(fCalculate2DDiffFlow)
-       } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-      } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
+        } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+       } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
+      } // end of if(fCalculate2DDiffFlow)
      } // end of if(aftsTrack->InPOISelection())  
     } // end of if(fCalculateDiffFlow || fCalculate2DDiffFlow)         
    } // end of if(pTrack->InRPSelection())
@@ -522,31 +526,31 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     ptEta[0] = dPt;
     ptEta[1] = dEta;
     // Calculate p_{m*n,k} ('p-vector' for POIs): 
-    for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+    if(fCalculateDiffFlow || fCalculate2DDiffFlow)
     {
-     for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+     this->CalculateQvectorTerms(dPhi,wPhi*wPt*wEta*wTrack,cosMnPhi,sinMnPhi,weightPowers);
+    }
+    if(fCalculateDiffFlow){this->AccumulateDiffFlowQvectorsEBE(1,ptEta,cosMnPhi,sinMnPhi,weightPowers);}
+    if(fCalculate2DDiffFlow)
+    {
+     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
      {
-      if(fCalculateDiffFlow)
-      {
-       for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-       {
-        fReRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-        fImRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
-       } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-      } // end of if(fCalculateDiffFlow) 
-      if(fCalculate2DDiffFlow)
+      for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
       {
-       fReRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-       fImRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
-      } // end of if(fCalculate2DDiffFlow)
-     } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-    } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
+       fReRPQ2dEBE[1][m][k]->Fill(dPt,dEta,weightPowers[k]*cosMnPhi[m],1.);
+       fImRPQ2dEBE[1][m][k]->Fill(dPt,dEta,weightPowers[k]*sinMnPhi[m],1.);      
+      } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+     } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
+    } // end of if(fCalculate2DDiffFlow)
    } // end of if(pTrack->InPOISelection())    
   } else // to if(aftsTrack)
     {
      printf("\n WARNING (QC): No particle (i.e. aftsTrack is a NULL pointer in AFAWQC::Make())!!!!\n\n");
     }
  } // end of for(Int_t i=0;i<nPrim;i++) 
+ 
+ // Copy the per-bin sums for differential flow into the e-b-e profiles:
+ if(fCalculateDiffFlow){this->FlushDiffFlowQvectorsEBE();}
 
  // e) Calculate the final expressions for S_{p,k} and s_{p,k} (important !!!!):
  for(Int_t p=0;p<8;p++)
@@ -700,6 +704,124 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
 
 //=======================================================================================================================
 
+void AliFlowAnalysisWithQCumulants::CalculateQvectorTerms(Double_t dPhi, Double_t dWeight, Double_t *cosMnPhi, Double_t *sinMnPhi, Double_t *weightPowers) const
+{
+ // Calculate for one particle cos(m*n*phi) and sin(m*n*phi) for m = 1,2,...,12 and w^k for k = 0,1,...,8.
+ 
+ // Remarks: 
+ //  1.) Only cos(n*phi) and sin(n*phi) are evaluated directly, the higher multiples follow from 
+ //      cos((m+1)x) = cos(mx)cos(x) - sin(mx)sin(x) and sin((m+1)x) = sin(mx)cos(x) + cos(mx)sin(x);
+ //  2.) Powers of the weight are obtained as running products; 
+ //  3.) The results agree with TMath::Cos((m+1)*n*dPhi), TMath::Sin((m+1)*n*dPhi) and pow(dWeight,k) 
+ //      up to rounding (relative difference of the order of 1e-15).
+ 
+ Double_t cosNPhi = TMath::Cos(fHarmonic*dPhi);
+ Double_t sinNPhi = TMath::Sin(fHarmonic*dPhi);
+ cosMnPhi[0] = cosNPhi;
+ sinMnPhi[0] = sinNPhi;
+ for(Int_t m=1;m<12;m++)
+ {
+  cosMnPhi[m] = cosMnPhi[m-1]*cosNPhi-sinMnPhi[m-1]*sinNPhi;
+  sinMnPhi[m] = sinMnPhi[m-1]*cosNPhi+cosMnPhi[m-1]*sinNPhi;
+ }
+ 
+ weightPowers[0] = 1.;
+ for(Int_t k=1;k<9;k++)
+ {
+  weightPowers[k] = weightPowers[k-1]*dWeight;
+ }
+
+} // end of void AliFlowAnalysisWithQCumulants::CalculateQvectorTerms(Double_t dPhi, Double_t dWeight, Double_t *cosMnPhi, Double_t *sinMnPhi, Double_t *weightPowers) const
+
+//=======================================================================================================================
+
+void AliFlowAnalysisWithQCumulants::AccumulateDiffFlowQvectorsEBE(Int_t t, const Double_t *ptEta, const Double_t *cosMnPhi, const Double_t *sinMnPhi, const Double_t *weightPowers)
+{
+ // Add one particle to the per-bin sums of r_{m*n,k}, p_{m*n,k} or q_{m*n,k} (and s_{p,k}) for differential flow.
+ 
+ // Remarks: 
+ //  1.) t is the type flag (0 = RP, 1 = POI, 2 = RP && POI), s_{p,k} is not needed for t = 1;
+ //  2.) The sums are copied into fReRPQ1dEBE, fImRPQ1dEBE and fs1dEBE in FlushDiffFlowQvectorsEBE() once per event; 
+ //  3.) Layout per bin (kDiffFlowQvectorsBlockSize entries): Re, Im, Re^2, Im^2 at [(r*4+m)*9+k] with r = 0,1,2,3 for m = 0,...,3, k = 0,...,8, 
+ //      followed by s_{p,k} and s_{p,k}^2 at [144+k] and [153+k].
+ 
+ for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
+ {
+  Int_t bin = fReRPQ1dEBE[t][pe][0][0]->GetXaxis()->FindBin(ptEta[pe]);
+  Double_t *sums = fDiffFlowQvectorsEBE[t][pe].GetArray()+bin*kDiffFlowQvectorsBlockSize;
+  fDiffFlowQvectorsEntriesEBE[t][pe].GetArray()[bin]++;
+  for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+  {
+   for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+   {
+    Double_t dRe = weightPowers[k]*cosMnPhi[m];
+    Double_t dIm = weightPowers[k]*sinMnPhi[m];
+    sums[m*9+k] += dRe; 
+    sums[36+m*9+k] += dIm; 
+    sums[72+m*9+k] += dRe*dRe; 
+    sums[108+m*9+k] += dIm*dIm; 
+   } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+  } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+  if(t==1){continue;} // s_{p,k} is not needed for POIs
+  for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+  {
+   sums[144+k] += weightPowers[k]; 
+   sums[153+k] += weightPowers[k]*weightPowers[k]; 
+  } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+ } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
+
+} // end of void AliFlowAnalysisWithQCumulants::AccumulateDiffFlowQvectorsEBE(Int_t t, const Double_t *ptEta, const Double_t *cosMnPhi, const Double_t *sinMnPhi, const Double_t *weightPowers)
+
+//=======================================================================================================================
+
+void AliFlowAnalysisWithQCumulants::FlushDiffFlowQvectorsEBE()
+{
+ // Copy the per-bin sums accumulated in AccumulateDiffFlowQvectorsEBE() into fReRPQ1dEBE, fImRPQ1dEBE and fs1dEBE and reset the sums.
+ 
+ // Remarks: 
+ //  1.) The profiles end up with the same bin contents, bin entries and sums of squares as when filled particle by particle 
+ //      with weight 1 (the statistics used for mean and RMS along x are not filled, they are not used);
+ //  2.) Only bins with entries are touched.
+ 
+ for(Int_t t=0;t<3;t++) // type flag (0 = RP, 1 = POI, 2 = RP && POI)
+ { 
+  for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
+  {
+   Int_t *entries = fDiffFlowQvectorsEntriesEBE[t][pe].GetArray();
+   Int_t nBins = fDiffFlowQvectorsEntriesEBE[t][pe].GetSize(); // including underflow and overflow
+   Int_t nEntriesTotal = 0;
+   for(Int_t b=0;b<nBins;b++)
+   {
+    if(0 == entries[b]){continue;}
+    const Double_t *sums = fDiffFlowQvectorsEBE[t][pe].GetArray()+b*kDiffFlowQvectorsBlockSize;
+    for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+    {
+     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+     {
+      AddToProfileBin(fReRPQ1dEBE[t][pe][m][k],b,entries[b],sums[m*9+k],sums[72+m*9+k]);
+      AddToProfileBin(fImRPQ1dEBE[t][pe][m][k],b,entries[b],sums[36+m*9+k],sums[108+m*9+k]);
+     } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+    } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+    if(t!=1) // s_{p,k} is not needed for POIs
+    {
+     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+     {
+      AddToProfileBin(fs1dEBE[t][pe][k],b,entries[b],sums[144+k],sums[153+k]);
+     } 
+    } // end of if(t!=1)
+    nEntriesTotal += entries[b];
+   } // end of for(Int_t b=0;b<nBins;b++)
+   if(0 == nEntriesTotal){continue;}
+   // Reset the sums for the next event:
+   fDiffFlowQvectorsEBE[t][pe].Reset();
+   fDiffFlowQvectorsEntriesEBE[t][pe].Reset();
+  } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
+ } // end of for(Int_t t=0;t<3;t++)
+
+} // end of void AliFlowAnalysisWithQCumulants::FlushDiffFlowQvectorsEBE()
+
+//=======================================================================================================================
+
 void AliFlowAnalysisWithQCumulants::Finish()
 {
  // Calculate the final results.
@@ -19514,6 +19636,17 @@ void AliFlowAnalysisWithQCumulants::BookEverythingForDifferentialFlow()
    }
   }
  }
+ // per-bin sums (including underflow and overflow) from which the three profiles above are filled once per event:
+ for(Int_t t=0;t<3;t++) // typeFlag (0 = RP, 1 = POI, 2 = RP&&POI )
+ { 
+  for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
+  {
+   fDiffFlowQvectorsEBE[t][pe].Set((nBinsPtEta[pe]+2)*kDiffFlowQvectorsBlockSize);
+   fDiffFlowQvectorsEBE[t][pe].Reset();
+   fDiffFlowQvectorsEntriesEBE[t][pe].Set(nBinsPtEta[pe]+2);
+   fDiffFlowQvectorsEntriesEBE[t][pe].Reset();
+  }
+ }
  // correction terms for nua:
  for(Int_t t=0;t<2;t++) // typeFlag (0 = RP, 1 = POI)
  { 
@@ -15,6 +15,8 @@
 #define ALIFLOWANALYSISWITHQCUMULANTS_H
 
 #include "TMatrixD.h"
+#include "TArrayD.h"
+#include "TArrayI.h"
 #include "TH2D.h"
 #include "TRandom3.h"
 #include "AliFlowCommonConstants.h"
@@ -82,6 +84,9 @@ class AliFlowAnalysisWithQCumulants{
     virtual void FillCommonControlHistograms(AliFlowEventSimple *anEvent);
     virtual void FillControlHistograms(AliFlowEventSimple *anEvent);
     virtual void ResetEventByEventQuantities();
+    virtual void CalculateQvectorTerms(Double_t dPhi, Double_t dWeight, Double_t *cosMnPhi, Double_t *sinMnPhi, Double_t *weightPowers) const;
+    virtual void AccumulateDiffFlowQvectorsEBE(Int_t t, const Double_t *ptEta, const Double_t *cosMnPhi, const Double_t *sinMnPhi, const Double_t *weightPowers);
+    virtual void FlushDiffFlowQvectorsEBE();
     // 2b.) Reference flow:
     virtual void CalculateIntFlowCorrelations(); 
     virtual void CalculateIntFlowCorrelationsUsingParticleWeights();
@@ -713,6 +718,8 @@ class AliFlowAnalysisWithQCumulants{
   TProfile *fReRPQ1dEBE[3][2][4][9]; //! real part [0=r,1=p,2=q][0=pt,1=eta][m][k]
   TProfile *fImRPQ1dEBE[3][2][4][9]; //! imaginary part [0=r,1=p,2=q][0=pt,1=eta][m][k]
   TProfile *fs1dEBE[3][2][9]; //! [0=r,1=p,2=q][0=pt,1=eta][k] // to be improved
+  TArrayD fDiffFlowQvectorsEBE[3][2]; //! [0=r,1=p,2=q][0=pt,1=eta] sums per bin accumulated in Make() and flushed into the three profiles above once per event
+  TArrayI fDiffFlowQvectorsEntriesEBE[3][2]; //! [0=r,1=p,2=q][0=pt,1=eta] number of particles per bin accumulated in fDiffFlowQvectorsEBE
   TH1D *fDiffFlowCorrelationsEBE[2][2][4]; //! [0=RP,1=POI][0=pt,1=eta][reduced correlation index]
   TH1D *fDiffFlowEventWeightsForCorrelationsEBE[2][2][4]; //! [0=RP,1=POI][0=pt,1=eta][event weights for reduced correlation index]
   TH1D *fDiffFlowCorrectionTermsForNUAEBE[2][2][2][10]; //! [0=RP,1=POI][0=pt,1=eta][0=sin terms,1=cos terms][correction term index]
@@ -847,7 +854,7 @@ class AliFlowAnalysisWithQCumulants{
   TH2D *fBootstrapCumulants; // x-axis => QC{2}, QC{4}, QC{6}, QC{8}; y-axis => subsample # 
   TH2D *fBootstrapCumulantsVsM[4]; // index => QC{2}, QC{4}, QC{6}, QC{8}; x-axis => multiplicity; y-axis => subsample # 
 
-  ClassDef(AliFlowAnalysisWithQCumulants, 4);
+  ClassDef(AliFlowAnalysisWithQCumulants, 5);
 
 };
 
@@ -0,0 +1,271 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/*********************************************************
+ * generic framework multi-particle correlators          *
+ *                                                       *
+ * header only, no dictionary needed                     *
+ *********************************************************/
+
+// AliFlowGenericCorrelator<kMaxHarmonic,kMaxPower> holds the Q-vector components
+//   Q_{n,p} = sum_{i=1}^{M} w_i^p exp(i*n*phi_i), n = 0,...,kMaxHarmonic, p = 0,...,kMaxPower
+// as std::complex<double> in one flat array with layout [harmonic][power] and evaluates
+// the generic n-particle correlators <exp[i(n1*phi1+...+nn*phin)]> (numerators, i.e. not divided
+// by the number of combinations, which is obtained for all harmonics = 0) from them.
+//
+// The correlators are calculated with the recursion of K. Gulbrandsen (see also
+// AliFlowAnalysisWithMultiparticleCorrelations::Recursion()); all intermediate results are
+// memoized until the Q-vector changes. Therefore asking for the same (or a related) correlator
+// several times in one event, e.g. the numerator and the denominator <exp[i(0*phi1+...)]>, is cheap.
+//
+// Usage:
+//   AliFlowGenericCorrelator<12,4> corr;
+//   corr.Reset();
+//   for each particle: corr.Fill(phi,weight);
+//   std::complex<double> four = corr.Correlator<2,2,-2,-2>(); // harmonics known at compile time
+//   Int_t h[4] = {3,3,-3,-3};
+//   std::complex<double> four3 = corr.Correlator(4,h); // harmonics known at run time
+//
+// AliFlowGenericCorrelatorGap<kMaxHarmonic,kMaxPower> splits the particles in two subevents
+// (eta < -gap/2 and eta > gap/2) and evaluates correlators with particles from both subevents,
+// e.g. TwoGap(2,-2) = Q_A(2,1)*Q_B(-2,1), or Correlator<2,2>(A) times Correlator<-2,-2>(B) for
+// a four-particle correlator with an eta gap.
+//
+// Harmonics and powers have to be within the bounds given by the template arguments: for an
+// m-particle correlator with harmonics n_i, sum_i |n_i| <= kMaxHarmonic and m <= kMaxPower.
+
+#ifndef ALIFLOWGENERICCORRELATOR_H
+#define ALIFLOWGENERICCORRELATOR_H
+
+#include <complex>
+#include <cmath>
+#include <map>
+
+#include "Rtypes.h"
+
+//================================================================================================================
+
+template <Int_t kMaxHarmonic, Int_t kMaxPower>
+class AliFlowGenericCorrelator{
+ public:
+  typedef std::complex<Double_t> Complex_t;
+  enum { kMaxParticles = 8 }; // highest number of particles in a correlator
+
+  AliFlowGenericCorrelator() : fQvector(), fMultiplicity(0), fMemo() { Reset(); }
+
+  void Reset()
+  {
+   // Reset all Q-vector components to zero before starting a new event.
+   for(Int_t i=0;i<kSize;i++){fQvector[i] = Complex_t(0.,0.);}
+   fMultiplicity = 0;
+   fMemo.clear();
+  }
+
+  void Fill(Double_t phi, Double_t weight = 1.)
+  {
+   // Add one particle. cos(n*phi), sin(n*phi) are obtained from one sin/cos by multiplication
+   // with exp(i*phi), powers of the weight as running product.
+   const Complex_t step(std::cos(phi),std::sin(phi));
+   Complex_t harmonic(1.,0.);
+   for(Int_t h=0;h<=kMaxHarmonic;h++)
+   {
+    Complex_t *q = fQvector+h*(kMaxPower+1);
+    Double_t weightToPowerP = 1.;
+    for(Int_t p=0;p<=kMaxPower;p++)
+    {
+     q[p] += weightToPowerP*harmonic;
+     weightToPowerP *= weight;
+    }
+    harmonic *= step;
+   }
+   fMultiplicity++;
+   fMemo.clear();
+  }
+
+  void Fill(Int_t n, const Double_t *phi, const Double_t *weight = 0)
+  {
+   // Add n particles at once (weight = 0 means unit weights).
+   for(Int_t i=0;i<n;i++){Fill(phi[i],weight ? weight[i] : 1.);}
+  }
+
+  void SetQ(Int_t n, Int_t p, const Complex_t &q)
+  {
+   // Set one component directly (for Q-vectors built elsewhere); n >= 0.
+   fQvector[n*(kMaxPower+1)+p] = q;
+   fMemo.clear();
+  }
+
+  Complex_t Q(Int_t n, Int_t p) const
+  {
+   // Using the fact that Q{-n,p} = Q{n,p}^*.
+   if(n>=0){return fQvector[n*(kMaxPower+1)+p];}
+   return std::conj(fQvector[-n*(kMaxPower+1)+p]);
+  }
+
+  Int_t GetMultiplicity() const { return fMultiplicity; }
+
+  Complex_t Correlator(Int_t n, const Int_t *harmonic) const
+  {
+   // Generic n-particle correlation <exp[i(n1*phi1+...+nn*phin)]>, 1 <= n <= kMaxParticles.
+   if(n<1||n>kMaxParticles){return Complex_t(0.,0.);}
+   Int_t h[kMaxParticles];
+   Int_t mult[kMaxParticles];
+   for(Int_t i=0;i<n;i++){h[i] = harmonic[i]; mult[i] = 1;}
+   return Recursion(n,h,mult);
+  }
+
+#if __cplusplus >= 201103L
+  template <Int_t... kHarmonics>
+  Complex_t Correlator() const
+  {
+   // Generic correlator with the harmonics given at compile time, e.g. Correlator<2,-2>().
+   static_assert(sizeof...(kHarmonics) >= 1 && sizeof...(kHarmonics) <= kMaxParticles, "1 to 8 particles supported");
+   const Int_t harmonic[] = {kHarmonics...};
+   return Correlator(sizeof...(kHarmonics),harmonic);
+  }
+#endif
+
+  Complex_t Two(Int_t n1, Int_t n2) const
+  {
+   // Generic two-particle correlation <exp[i(n1*phi1+n2*phi2)]>, explicit expression.
+   return Q(n1,1)*Q(n2,1)-Q(n1+n2,2);
+  }
+
+  Complex_t Three(Int_t n1, Int_t n2, Int_t n3) const { Int_t h[3] = {n1,n2,n3}; return Correlator(3,h); }
+  Complex_t Four(Int_t n1, Int_t n2, Int_t n3, Int_t n4) const { Int_t h[4] = {n1,n2,n3,n4}; return Correlator(4,h); }
+  Complex_t Six(Int_t n1, Int_t n2, Int_t n3, Int_t n4, Int_t n5, Int_t n6) const
+  { Int_t h[6] = {n1,n2,n3,n4,n5,n6}; return Correlator(6,h); }
+  Complex_t Eight(Int_t n1, Int_t n2, Int_t n3, Int_t n4, Int_t n5, Int_t n6, Int_t n7, Int_t n8) const
+  { Int_t h[8] = {n1,n2,n3,n4,n5,n6,n7,n8}; return Correlator(8,h); }
+
+ private:
+  enum { kSize = (kMaxHarmonic+1)*(kMaxPower+1) };
+
+  // memoization key: number of particles and (harmonic, power) of each of them, packed in 16 bits each
+  struct Key_t {
+   ULong64_t fWord[2];
+   Int_t fN;
+   bool operator<(const Key_t &other) const
+   {
+    if(fN != other.fN){return fN < other.fN;}
+    if(fWord[0] != other.fWord[0]){return fWord[0] < other.fWord[0];}
+    return fWord[1] < other.fWord[1];
+   }
+  };
+
+  static Key_t MakeKey(Int_t n, const Int_t *harmonic, const Int_t *mult)
+  {
+   Key_t key;
+   key.fN = n;
+   key.fWord[0] = 0;
+   key.fWord[1] = 0;
+   for(Int_t i=0;i<n;i++)
+   {
+    // harmonic in 12 bits (offset to be positive), power in 4 bits
+    ULong64_t packed = (ULong64_t)((harmonic[i]+2048) & 0xfff) | ((ULong64_t)(mult[i] & 0xf) << 12);
+    key.fWord[i/4] |= packed << (16*(i%4));
+   }
+   return key;
+  }
+
+  Complex_t Recursion(Int_t n, Int_t *harmonic, Int_t *mult) const
+  {
+   // Calculate multi-particle correlators by using recursion originally developed by
+   // Kristjan Gulbrandsen (gulbrand@nbi.dk), with memoization of all intermediate results.
+   if(n==1){return Q(harmonic[0],mult[0]);}
+
+   const Key_t key = MakeKey(n,harmonic,mult);
+   typename std::map<Key_t,Complex_t>::const_iterator it = fMemo.find(key);
+   if(it != fMemo.end()){return it->second;}
+
+   Complex_t c = Q(harmonic[n-1],mult[n-1]);
+   c *= Recursion(n-1,harmonic,mult);
+   if(mult[n-1]==1)
+   {
+    for(Int_t i=0;i<(n-1);i++)
+    {
+     harmonic[i] += harmonic[n-1];
+     mult[i]++;
+     c -= (mult[i]-1.)*Recursion(n-1,harmonic,mult);
+     mult[i]--;
+     harmonic[i] -= harmonic[n-1];
+    }
+   }
+
+   fMemo[key] = c;
+   return c;
+  }
+
+  Complex_t fQvector[kSize];                 // Q-vector components [harmonic][power]
+  Int_t fMultiplicity;                       // number of particles filled since the last Reset()
+  mutable std::map<Key_t,Complex_t> fMemo;   // memoized intermediate results of the recursion for the current Q-vector
+};
+
+//================================================================================================================
+
+template <Int_t kMaxHarmonic, Int_t kMaxPower>
+class AliFlowGenericCorrelatorGap{
+ public:
+  typedef AliFlowGenericCorrelator<kMaxHarmonic,kMaxPower> Correlator_t;
+  typedef typename Correlator_t::Complex_t Complex_t;
+  enum ESubevent { kA = 0, kB = 1 }; // A: eta < -gap/2, B: eta > gap/2
+
+  explicit AliFlowGenericCorrelatorGap(Double_t etaGap = 0.) : fEtaGap(etaGap), fSubevent() {}
+
+  void SetEtaGap(Double_t etaGap) { fEtaGap = etaGap; }
+  Double_t GetEtaGap() const { return fEtaGap; }
+
+  void Reset() { fSubevent[kA].Reset(); fSubevent[kB].Reset(); }
+
+  void Fill(Double_t phi, Double_t eta, Double_t weight = 1.)
+  {
+   // Add one particle to the subevent it belongs to (particles within the gap are not used).
+   if(eta < -0.5*fEtaGap){fSubevent[kA].Fill(phi,weight);}
+   else if(eta > 0.5*fEtaGap){fSubevent[kB].Fill(phi,weight);}
+  }
+
+  const Correlator_t &GetSubevent(ESubevent s) const { return fSubevent[s]; }
+
+  Complex_t TwoGap(Int_t n1, Int_t n2) const
+  {
+   // <exp[i(n1*phi1+n2*phi2)]>, phi1 from A, phi2 from B.
+   return fSubevent[kA].Q(n1,1)*fSubevent[kB].Q(n2,1);
+  }
+
+  Complex_t Correlator(Int_t nA, const Int_t *harmonicA, Int_t nB, const Int_t *harmonicB) const
+  {
+   // Correlator with nA particles from A and nB particles from B, e.g. the four-particle
+   // correlator with eta gap <exp[i(n*phi1+n*phi2-n*phi3-n*phi4)]> is Correlator(2,{n,n},2,{-n,-n}).
+   return fSubevent[kA].Correlator(nA,harmonicA)*fSubevent[kB].Correlator(nB,harmonicB);
+  }
+
+  Complex_t FourGap(Int_t n1, Int_t n2, Int_t n3, Int_t n4) const
+  {
+   // <exp[i(n1*phi1+n2*phi2+n3*phi3+n4*phi4)]>, phi1, phi2 from A and phi3, phi4 from B.
+   return fSubevent[kA].Two(n1,n2)*fSubevent[kB].Two(n3,n4);
+  }
+
+  Complex_t SixGap(Int_t n1, Int_t n2, Int_t n3, Int_t n4, Int_t n5, Int_t n6) const
+  {
+   // <exp[i(n1*phi1+...+n6*phi6)]>, phi1, phi2, phi3 from A and phi4, phi5, phi6 from B.
+   return fSubevent[kA].Three(n1,n2,n3)*fSubevent[kB].Three(n4,n5,n6);
+  }
+
+ private:
+  Double_t fEtaGap;                // full size of the gap in eta between the subevents
+  Correlator_t fSubevent[2];       // Q-vectors of subevents A and B
+};
+
+#endif
@@ -32,6 +32,8 @@
 #include <TFile.h>
 #include <TTree.h>
 #include <TF1.h>
+#include <TRandom3.h>
+#include <TThread.h>
 
 #include "AliGlauberNucleon.h"
 #include "AliGlauberNucleus.h"
@@ -40,6 +42,8 @@
 using std::flush;
 ClassImp(AliGlauberMC)
 
+static const char *kNtupleVars = "Npart:Ncoll:B:MeanX:MeanY:MeanX2:MeanY2:MeanXY:VarX:VarY:VarXY:MeanXSystem:MeanYSystem:MeanXA:MeanYA:MeanXB:MeanYB:VarE:Stoa:VarEColl:VarECom:VarEPart:VarEPartColl:VarEPartCom:dNdEta:dNdEtaGBW:dNdEtaTwoNBD:xsect:tAA:Epsl2:Epsl3:Epsl4:Epsl5:E2Coll:E3Coll:E4Coll:E5Coll:E2Com:E3Com:E4Com:E5Com:Psi2:Psi3:Psi4:Psi5:BNN:signn:Ncollw";
+
 //______________________________________________________________________________
 AliGlauberMC::AliGlauberMC(Option_t* NA, Option_t* NB, Double_t xsect) :
   TNamed(),
@@ -172,7 +176,17 @@ AliGlauberMC::AliGlauberMC(Option_t* NA, Option_t* NB, Double_t xsect) :
   fOmega(0),
   fSig0(0),
   fLambda(0),
-  fSigFluc(0)
+  fSigFluc(0),
+  fNWorkers(1),
+  fSeed(0),
+  fRandom(0),
+  fSigSampler(),
+  fSigA(),
+  fSigB(),
+  fNCollA(),
+  fNCollB(),
+  fCellStart(),
+  fCellIndex()
 {
   //ctor
   for (UInt_t i=0; i<(sizeof(fdNdEtaParam)/sizeof(fdNdEtaParam[0])); i++)
@@ -322,7 +336,17 @@ AliGlauberMC::AliGlauberMC(const AliGlauberMC& in):
   fOmega(in.fOmega),
   fSig0(in.fSig0),
   fLambda(in.fLambda),
-  fSigFluc(in.fSigFluc)
+  fSigFluc(in.fSigFluc),
+  fNWorkers(in.fNWorkers),
+  fSeed(in.fSeed),
+  fRandom(in.fRandom),
+  fSigSampler(in.fSigSampler),
+  fSigA(),
+  fSigB(),
+  fNCollA(),
+  fNCollB(),
+  fCellStart(),
+  fCellIndex()
 {
   //copy ctor
   memcpy(fdNdEtaParam,in.fdNdEtaParam,sizeof(fdNdEtaParam));
@@ -453,91 +477,181 @@ AliGlauberMC& AliGlauberMC::operator=(const AliGlauberMC& in)
   fSxyCom=in.fSxyCom;
   fX=in.fX;
   fNpp=in.fNpp;
+  fNWorkers=in.fNWorkers;
+  fSeed=in.fSeed;
+  fRandom=in.fRandom;
+  fSigSampler=in.fSigSampler;
   return *this;
 }
 
+//______________________________________________________________________________
+TRandom *AliGlauberMC::GetRandom() const
+{
+  //random generator of this engine
+  return fRandom ? fRandom : gRandom;
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::InitSigFluc()
+{
+  //prepare sampling of the fluctuating sigNN
+  if (!fSigFluc) {
+    fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
+    fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
+    cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
+  }
+  if (!fSigSampler.IsValid()) {
+    fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
+    fSigSampler.Init(fSigFluc);
+  }
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberMC::ThrowSigNN()
+{
+  //fluctuating sigNN; drawn with TF1::GetRandom for the default generator
+  //(gRandom) as before, from the sampling table for an own generator
+  if (!fRandom)
+    return fSigFluc->GetRandom();
+  return fSigSampler.GetRandom(fRandom);
+}
+
 //______________________________________________________________________________
 Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
 {
   // prepare event
 
-  if (fDoFluc) {
-    if (!fSigFluc) {
-      fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
-      fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
-      cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
-    }
-  }
+  if (fDoFluc)
+    InitSigFluc();
 
   fANucleus.ThrowNucleons(-bgen/2.);
   fNucleonsA = fANucleus.GetNucleons();
   fAN = fANucleus.GetN();
   fQAN = fAN * 3;
   //fAN = 3 * fANucleus.GetN(); // for Pb, Number of quark = 3*208;
+  fSigA.resize(fAN);
   for (Int_t i = 0; i<fAN; i++)
   {
     AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(i));
     nucleonA->SetInNucleusA();
-    nucleonA->SetSigNN(fXSect);
-    if (fDoFluc)
-      nucleonA->SetSigNN(fSigFluc->GetRandom());
+    fSigA[i] = fDoFluc ? ThrowSigNN() : fXSect;
+    nucleonA->SetSigNN(fSigA[i]);
   }
   fBNucleus.ThrowNucleons(bgen/2.);
   fNucleonsB = fBNucleus.GetNucleons();
   //fBN = 3 * fBNucleus.GetN(); // Number of quark = number of nucleus*3;
   fBN = fBNucleus.GetN();
   fQBN = fBN * 3;
+  fSigB.resize(fBN);
   for (Int_t i = 0; i<fBN; i++)
   {
     AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
     nucleonB->SetInNucleusB();
-    nucleonB->SetSigNN(fXSect);
-    if (fDoFluc)
-      nucleonB->SetSigNN(fSigFluc->GetRandom());
+    fSigB[i] = fDoFluc ? ThrowSigNN() : fXSect;
+    nucleonB->SetSigNN(fSigB[i]);
   }
 
-  if (fDoFluc) {
-    if (!fSigFluc) {
-      fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
-      fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
-      cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
-    }
-    fXSect = fSigFluc->GetRandom();
-  }
+  if (fDoFluc)
+    fXSect = ThrowSigNN();
   // "ball" diameter = distance at which two balls interact
   Double_t d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
+  Double_t d2Max = d2;
+  if (fDoFluc) {
+    // the pair cross section is the larger of the two nucleons
+    Double_t sigMax = 0;
+    for (Int_t i = 0; i<fAN; i++) sigMax = TMath::Max(sigMax, fSigA[i]);
+    for (Int_t i = 0; i<fBN; i++) sigMax = TMath::Max(sigMax, fSigB[i]);
+    d2Max = sigMax/(TMath::Pi()*10);
+  }
+
+  const std::vector<Double_t>& xA = fANucleus.GetX();
+  const std::vector<Double_t>& yA = fANucleus.GetY();
+  const std::vector<Double_t>& xB = fBNucleus.GetX();
+  const std::vector<Double_t>& yB = fBNucleus.GetY();
+  fNCollA.assign(fAN, 0);
+  fNCollB.assign(fBN, 0);
 
   Double_t bNN   = 0;
   Double_t Nco   = 0;
   Double_t Ncohc = 0; // hard core
 
-  // for each of the A nucleons in nucleus B
-  for (Int_t i = 0; i<fBN; i++)
+  if (fAN>0 && fBN>0 && d2Max>0)
   {
-    AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
-    for (Int_t j = 0 ; j < fAN ; j++)
+    // transverse cell list of the nucleons in A, with cells at least as
+    // large as the interaction distance, so that only the 3x3 cells
+    // around a nucleon of B can hold collision partners
+    Double_t xMin = xA[0], xMax = xA[0];
+    Double_t yMin = yA[0], yMax = yA[0];
+    for (Int_t j = 1; j<fAN; j++)
     {
-      AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
-      Double_t dx = nucleonB->GetX()-nucleonA->GetX();
-      Double_t dy = nucleonB->GetY()-nucleonA->GetY();
-      Double_t dij = dx*dx+dy*dy;
-      if (fDoFluc) {
-	//fXSect = nucleonA->GetSigNN();
-	//fXSect = (nucleonA->GetSigNN()+nucleonB->GetSigNN())/2.;
-	fXSect = TMath::Max(nucleonA->GetSigNN(),nucleonB->GetSigNN());
-	d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
-      }
-      if (dij < d2)
+      xMin = TMath::Min(xMin, xA[j]); xMax = TMath::Max(xMax, xA[j]);
+      yMin = TMath::Min(yMin, yA[j]); yMax = TMath::Max(yMax, yA[j]);
+    }
+    const Int_t kMaxCells = 64; // per dimension
+    Double_t cell = TMath::Sqrt(d2Max);
+    cell = TMath::Max(cell, (xMax-xMin)/kMaxCells);
+    cell = TMath::Max(cell, (yMax-yMin)/kMaxCells);
+    Int_t nx = Int_t((xMax-xMin)/cell)+1;
+    Int_t ny = Int_t((yMax-yMin)/cell)+1;
+
+    fCellStart.assign(nx*ny+1, 0);
+    fCellIndex.resize(fAN);
+    for (Int_t j = 0; j<fAN; j++)
+    {
+      Int_t ix = TMath::Min(Int_t((xA[j]-xMin)/cell), nx-1);
+      Int_t iy = TMath::Min(Int_t((yA[j]-yMin)/cell), ny-1);
+      fCellStart[ix*ny+iy+1]++;
+    }
+    for (Int_t c = 0; c<nx*ny; c++)
+      fCellStart[c+1] += fCellStart[c];
+    std::vector<Int_t> next(fCellStart.begin(), fCellStart.end()-1);
+    for (Int_t j = 0; j<fAN; j++)
+    {
+      Int_t ix = TMath::Min(Int_t((xA[j]-xMin)/cell), nx-1);
+      Int_t iy = TMath::Min(Int_t((yA[j]-yMin)/cell), ny-1);
+      fCellIndex[next[ix*ny+iy]++] = j;
+    }
+
+    // for each of the B nucleons, the A nucleons in the cells around it
+    for (Int_t i = 0; i<fBN; i++)
+    {
+      Double_t fx = (xB[i]-xMin)/cell;
+      Double_t fy = (yB[i]-yMin)/cell;
+      if (fx<-1 || fx>=nx+1 || fy<-1 || fy>=ny+1) continue;
+      Int_t ixLo = fx<1  ? 0    : Int_t(fx-1);
+      Int_t ixHi = fx+1>=nx ? nx-1 : Int_t(fx+1);
+      Int_t iyLo = fy<1  ? 0    : Int_t(fy-1);
+      Int_t iyHi = fy+1>=ny ? ny-1 : Int_t(fy+1);
+      for (Int_t ix = ixLo; ix<=ixHi; ix++)
       {
-	bNN += dij;
-	++Nco;
-        nucleonB->Collide();
-        nucleonA->Collide();
-	if (dij<d2/4)
-	  ++Ncohc;
+        for (Int_t k = fCellStart[ix*ny+iyLo]; k<fCellStart[ix*ny+iyHi+1]; k++)
+        {
+          Int_t j = fCellIndex[k];
+          Double_t dx = xB[i]-xA[j];
+          Double_t dy = yB[i]-yA[j];
+          Double_t dij = dx*dx+dy*dy;
+          if (fDoFluc)
+            d2 = TMath::Max(fSigA[j],fSigB[i])/(TMath::Pi()*10); // in fm^2
+          if (dij < d2)
+          {
+            bNN += dij;
+            ++Nco;
+            ++fNCollB[i];
+            ++fNCollA[j];
+            if (dij<d2/4)
+              ++Ncohc;
+          }
+        }
       }
     }
   }
+  if (fDoFluc && fAN>0 && fBN>0) // as left by the full pair loop
+    fXSect = TMath::Max(fSigA[fAN-1],fSigB[fBN-1]);
+
+  for (Int_t j = 0; j<fAN; j++)
+    if (fNCollA[j]) ((AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j)))->SetNColl(fNCollA[j]);
+  for (Int_t i = 0; i<fBN; i++)
+    if (fNCollB[i]) ((AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i)))->SetNColl(fNCollB[i]);
 
   if (Nco>0) {
     fNcollw = Ncohc;
@@ -547,10 +661,6 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
     fBNN    = 0.;
   }
 
-  if (Nco>0)
-    fBNN = bNN/Nco;
-  else
-    fBNN = 0.;
   return CalcResults(bgen);
 }
 
@@ -1267,7 +1377,7 @@ Int_t AliGlauberMC::NegativeBinomialRandom(Int_t k, Double_t nmean) const
   {
     array[i] = NegativeBinomialDistribution(i,k,nmean) + array[i-1];
   }
-  Double_t r = gRandom->Uniform(0,1);
+  Double_t r = GetRandom()->Uniform(0,1);
   return TMath::BinarySearch(fMaxPlot,array,r)+2;
 
 }
@@ -1278,7 +1388,7 @@ Int_t AliGlauberMC::NegativeBinomialRandomSV(Double_t k, Double_t nbar) const
   // negative binomial distribution generator, S. Voloshin, 09-May-2007
   Double_t sum=0.;
   Int_t i=0;
-  Double_t ran=gRandom->Rndm();
+  Double_t ran=GetRandom()->Rndm();
   Double_t trm=1./pow(1.+nbar/k,k);
   if (trm==0.)
   {
@@ -1308,7 +1418,7 @@ Int_t AliGlauberMC::DoubleNegativeBinomialRandom( Int_t k,
   {
     array[i] = alpha*NegativeBinomialDistribution(i,k,nmean)+(1-alpha)*NegativeBinomialDistribution(i,k2,nmean2) + array[i-1];
   }
-  Double_t r = gRandom->Uniform(0,1);
+  Double_t r = GetRandom()->Uniform(0,1);
   return TMath::BinarySearch(fMaxPlot,array,r)+2;
 }
 
@@ -1506,7 +1616,7 @@ Bool_t AliGlauberMC::NextEvent(Double_t bgen)
   {
     if(bgen<0||!succes) //get impactparameter
     {
-      bgen = TMath::Sqrt((fBMax*fBMax-fBMin*fBMin)*gRandom->Rndm()+fBMin*fBMin);
+      bgen = TMath::Sqrt((fBMax*fBMax-fBMin*fBMin)*GetRandom()->Rndm()+fBMin*fBMin);
     }
     if ( (succes=CalcEvent(bgen)) ) break; //ends if we have particparts
   }
@@ -1690,22 +1800,36 @@ void AliGlauberMC::Run(Int_t nevents)
   TString title(Form("%s + %s (x-sect = %d mb)",fANucleus.GetName(),fBNucleus.GetName(),(Int_t) fXSect));
   if (fnt == 0)
   {
-    fnt = new TNtuple(name,title,
-                      "Npart:Ncoll:B:MeanX:MeanY:MeanX2:MeanY2:MeanXY:VarX:VarY:VarXY:MeanXSystem:MeanYSystem:MeanXA:MeanYA:MeanXB:MeanYB:VarE:Stoa:VarEColl:VarECom:VarEPart:VarEPartColl:VarEPartCom:dNdEta:dNdEtaGBW:dNdEtaTwoNBD:xsect:tAA:Epsl2:Epsl3:Epsl4:Epsl5:E2Coll:E3Coll:E4Coll:E5Coll:E2Com:E3Com:E4Com:E5Com:Psi2:Psi3:Psi4:Psi5:BNN:signn:Ncollw");
+    fnt = new TNtuple(name,title,kNtupleVars);
     fnt->SetDirectory(0);
   }
+  if (fNWorkers>1 && nevents>1)
+  {
+    RunWorkers(nevents);
+    return;
+  }
   Int_t q = 0;
   Int_t u = 0;
+  GenerateEvents(nevents,q,u,kTRUE);
+  std::cout << "Generating Event # " << nevents << "... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::GenerateEvents(Int_t nevents, Int_t& nok, Int_t& nfailed, Bool_t verbose)
+{
+  //generate events into fnt
+  nok = 0;
+  nfailed = 0;
   for (Int_t i = 0; i<nevents; i++)
   {
 
     if(!NextEvent())
     {
-      u++;
+      nfailed++;
       continue;
     }
 
-    q++;
+    nok++;
     Float_t v[48];
     v[0]  = GetNpart();
     v[1]  = GetNcoll();
@@ -1772,9 +1896,88 @@ void AliGlauberMC::Run(Int_t nevents)
     //always at the end
     fnt->Fill(v);
 
-    if ((i%100)==0) std::cout << "Generating Event # " << i << "... \r" << flush;
+    if (verbose && (i%100)==0) std::cout << "Generating Event # " << i << "... \r" << flush;
   }
-  std::cout << "Generating Event # " << nevents << "... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::RunWorkers(Int_t nevents)
+{
+  // Share the events between fNWorkers threads. Each worker runs a copy
+  // of this engine with its own TRandom3, seeded with fSeed+i (fSeed=0:
+  // base seed drawn from the generator of this engine), and fills its
+  // own ntuple. The ntuples are appended to fnt in worker order, so the
+  // output depends only on the seed and the number of workers.
+
+  Int_t nworkers = TMath::Min(fNWorkers,nevents);
+  cout << "Using " << nworkers << " worker threads" << endl;
+
+  // everything that is not thread safe is done before the copies
+  fANucleus.InitSampler();
+  fBNucleus.InitSampler();
+  if (fDoFluc)
+    InitSigFluc();
+  UInt_t seed = fSeed ? fSeed : 1+GetRandom()->Integer(kMaxUInt-nworkers);
+  TThread::Initialize();
+
+  std::vector<Worker>   workers(nworkers);
+  std::vector<TRandom*> randoms(nworkers);
+  std::vector<TThread*> threads(nworkers);
+  for (Int_t i = 0; i<nworkers; i++)
+  {
+    AliGlauberMC *mc = new AliGlauberMC(*this);
+    mc->fNucleonsA = 0;
+    mc->fNucleonsB = 0;
+    mc->fnt = new TNtuple(Form("%s_%d",fnt->GetName(),i),fnt->GetTitle(),kNtupleVars);
+    mc->fnt->SetDirectory(0);
+    mc->fEvents = 0;
+    mc->fTotalEvents = 0;
+    mc->fMaxNpartFound = 0;
+    randoms[i] = new TRandom3(seed+i);
+    mc->SetRandom(randoms[i]);
+    workers[i].fMC     = mc;
+    workers[i].fN      = nevents/nworkers + (i<nevents%nworkers ? 1 : 0);
+    workers[i].fOk     = 0;
+    workers[i].fFailed = 0;
+  }
+  for (Int_t i = 0; i<nworkers; i++)
+  {
+    threads[i] = new TThread(Form("GlauberWorker%d",i),RunWorker,&workers[i]);
+    threads[i]->Run();
+  }
+
+  Int_t q = 0;
+  Int_t u = 0;
+  for (Int_t i = 0; i<nworkers; i++)
+  {
+    threads[i]->Join();
+    delete threads[i];
+
+    AliGlauberMC *mc = workers[i].fMC;
+    TNtuple *nt = mc->fnt;
+    for (Long64_t e = 0; e<nt->GetEntries(); e++)
+    {
+      nt->GetEntry(e);
+      fnt->Fill(nt->GetArgs());
+    }
+    fEvents += mc->fEvents;
+    fTotalEvents += mc->fTotalEvents;
+    if (mc->fMaxNpartFound > fMaxNpartFound) fMaxNpartFound = mc->fMaxNpartFound;
+    q += workers[i].fOk;
+    u += workers[i].fFailed;
+    delete mc;
+    delete randoms[i];
+  }
+  std::cout << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
+}
+
+//______________________________________________________________________________
+void *AliGlauberMC::RunWorker(void* arg)
+{
+  //thread function of RunWorkers
+  Worker *w = static_cast<Worker*>(arg);
+  w->fMC->GenerateEvents(w->fN,w->fOk,w->fFailed,kFALSE);
+  return 0;
 }
 
 //---------------------------------------------------------------------------------
@@ -14,11 +14,14 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "AliGlauberNucleus.h"
+#include "AliGlauberSampler.h"
 #include <Riostream.h>
 #include <TNamed.h>
+#include <vector>
 
 class TObjArray;
 class TNtuple;
+class TRandom;
 
 using std::cout;
 using std::endl;
@@ -99,7 +102,10 @@ public:
    void   Setr(Double_t r)  {fANucleus.SetR(r); fBNucleus.SetR(r);}
    void   Seta(Double_t a)  {fANucleus.SetA(a); fBNucleus.SetA(a);}
    void   SetDoFluc(Double_t omega, Double_t sig0, Double_t lam, Bool_t on=kTRUE) 
-            {fDoFluc=on;fOmega=omega;fSig0=sig0;fLambda=lam;}
+            {fDoFluc=on;fOmega=omega;fSig0=sig0;fLambda=lam;fSigSampler.Clear();}
+   void   SetNWorkers(Int_t n)        {fNWorkers = n;}
+   void   SetSeed(UInt_t seed)        {fSeed = seed;}
+   void   SetRandom(TRandom* rnd)     {fRandom = rnd; fANucleus.SetRandom(rnd); fBNucleus.SetRandom(rnd);}
    static void       PrintVersion()         {cout << "AliGlauberMC " << Version() << endl;}
    static const char *Version()             {return "v1.2";}
    static void       RunAndSaveNtuple( Int_t n,
@@ -251,9 +257,33 @@ private:
    Double_t     fSig0;           //regularization parameter 
    Double_t     fLambda;         //lambda parameter
    TF1         *fSigFluc;        //!parameterization for fluctuating sigNN
+   Int_t        fNWorkers;       //number of worker threads used by Run
+   UInt_t       fSeed;           //seed of the first worker random stream, 0: from gRandom
+   TRandom     *fRandom;         //!random generator, gRandom if not set
+   AliGlauberSampler fSigSampler; //!sampling table of fSigFluc
+   std::vector<Double_t> fSigA;  //!sigNN of the nucleons in A
+   std::vector<Double_t> fSigB;  //!sigNN of the nucleons in B
+   std::vector<Int_t> fNCollA;   //!collisions of the nucleons in A
+   std::vector<Int_t> fNCollB;   //!collisions of the nucleons in B
+   std::vector<Int_t> fCellStart; //!first entry of each transverse cell in fCellIndex
+   std::vector<Int_t> fCellIndex; //!nucleons of A ordered by transverse cell
+
+   struct Worker {
+      AliGlauberMC *fMC;         //engine of the worker
+      Int_t         fN;          //events to generate
+      Int_t         fOk;         //successful events
+      Int_t         fFailed;     //discarded events
+   };
+
    Bool_t       CalcResults(Double_t bgen);
+   void         InitSigFluc();
+   Double_t     ThrowSigNN();
+   TRandom     *GetRandom() const;
+   void         GenerateEvents(Int_t nevents, Int_t& nok, Int_t& nfailed, Bool_t verbose);
+   void         RunWorkers(Int_t nevents);
+   static void *RunWorker(void* arg);
 
-   ClassDef(AliGlauberMC,4)
+   ClassDef(AliGlauberMC,5)
 };
 
 #endif
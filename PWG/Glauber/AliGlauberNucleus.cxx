@@ -49,7 +49,12 @@ AliGlauberNucleus::AliGlauberNucleus(Option_t* iname, Int_t iN, Double_t iR, Dou
   fF(0),
   fTrials(0),
   fFunction(ifunc),
-  fNucleons(NULL)
+  fNucleons(NULL),
+  fX(),
+  fY(),
+  fZ(),
+  fRandom(0),
+  fRadius()
 {
    if (fN==0) {
       cout << "Setting up nucleus " << iname << endl;
@@ -76,10 +81,15 @@ AliGlauberNucleus::AliGlauberNucleus(const AliGlauberNucleus& in):
   fMinDist(in.fMinDist),
   fF(in.fF),
   fTrials(in.fTrials),
-  fFunction(in.fFunction),
-  fNucleons(NULL)
+  fFunction(in.fFunction ? static_cast<TF1*>(in.fFunction->Clone()) : 0),
+  fNucleons(NULL),
+  fX(in.fX),
+  fY(in.fY),
+  fZ(in.fZ),
+  fRandom(in.fRandom),
+  fRadius(in.fRadius)
 {
-  //copy ctor
+  //copy ctor, the density is cloned since it is owned
   if (in.fNucleons)
     fNucleons=static_cast<TObjArray*>((in.fNucleons)->Clone());
 }
@@ -96,10 +106,16 @@ AliGlauberNucleus& AliGlauberNucleus::operator=(const AliGlauberNucleus& in)
   fMinDist=in.fMinDist;
   fF=in.fF;
   fTrials=in.fTrials;
-  fFunction=in.fFunction;
+  delete fFunction;
+  fFunction=in.fFunction ? static_cast<TF1*>(in.fFunction->Clone()) : 0;
   delete fNucleons;
-  fNucleons=static_cast<TObjArray*>((in.fNucleons)->Clone());
-  fNucleons->SetOwner();
+  fNucleons=in.fNucleons ? static_cast<TObjArray*>((in.fNucleons)->Clone()) : 0;
+  if (fNucleons) fNucleons->SetOwner();
+  fX=in.fX;
+  fY=in.fY;
+  fZ=in.fZ;
+  fRandom=in.fRandom;
+  fRadius=in.fRadius;
   return *this;
 }
 
@@ -177,6 +193,7 @@ void AliGlauberNucleus::Lookup(Option_t* name)
 void AliGlauberNucleus::SetR(Double_t ir)
 {
    fR = ir;
+   fRadius.Clear();
    switch (fF)
    {
       case 0: // Proton
@@ -195,6 +212,7 @@ void AliGlauberNucleus::SetR(Double_t ir)
 void AliGlauberNucleus::SetA(Double_t ia)
 {
    fA = ia;
+   fRadius.Clear();
    switch (fF)
    {
       case 0: // Proton
@@ -212,6 +230,7 @@ void AliGlauberNucleus::SetA(Double_t ia)
 void AliGlauberNucleus::SetW(Double_t iw)
 {
    fW = iw;
+   fRadius.Clear();
    switch (fF)
    {
       case 0: // Proton
@@ -225,6 +244,34 @@ void AliGlauberNucleus::SetW(Double_t iw)
    }
 }
 
+//______________________________________________________________________________
+TRandom *AliGlauberNucleus::GetRandom() const
+{
+   // random generator used to throw the nucleons
+   return fRandom ? fRandom : gRandom;
+}
+
+//______________________________________________________________________________
+void AliGlauberNucleus::InitSampler()
+{
+   // Tabulate the density for sampling the radii. Done on first use,
+   // but must be called before the nucleus is copied to a worker thread.
+   if (!fRadius.IsValid())
+      fRadius.Init(fFunction);
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberNucleus::ThrowRadius()
+{
+   // Radius of a nucleon. With the default generator (gRandom) it is drawn
+   // with TF1::GetRandom as before, so that results for a given seed of
+   // gRandom do not change. With an own generator (worker threads) the
+   // sampling table is used, since TF1::GetRandom draws from gRandom.
+   if (!fRandom)
+      return fFunction->GetRandom();
+   return fRadius.GetRandom(fRandom);
+}
+
 //______________________________________________________________________________
 void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
 {
@@ -236,6 +283,11 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
 	 fNucleons->Add(nucleon); 
       }
    } 
+   fX.resize(fN);
+   fY.resize(fN);
+   fZ.resize(fN);
+   InitSampler();
+   TRandom *rnd = GetRandom();
    
    fTrials = 0;
 
@@ -246,50 +298,47 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
    Bool_t hulthen = (TString(GetName())=="dh");
    if (fN==2 && hulthen) { //special treatmeant for Hulten
 
-      Double_t r = fFunction->GetRandom()/2;
-      Double_t phi = gRandom->Rndm() * 2 * TMath::Pi() ;
-      Double_t ctheta = 2*gRandom->Rndm() - 1 ;
+      Double_t r = ThrowRadius()/2;
+      Double_t phi = rnd->Rndm() * 2 * TMath::Pi() ;
+      Double_t ctheta = 2*rnd->Rndm() - 1 ;
       Double_t stheta = sqrt(1-ctheta*ctheta);
      
-      AliGlauberNucleon *nucleon1=(AliGlauberNucleon*)(fNucleons->UncheckedAt(0));
-      AliGlauberNucleon *nucleon2=(AliGlauberNucleon*)(fNucleons->UncheckedAt(1));
-      nucleon1->Reset();
-      nucleon1->SetXYZ(r * stheta * cos(phi) + xshift,
-		       r * stheta * sin(phi),
-		       r * ctheta);
-      nucleon2->Reset();
-      nucleon2->SetXYZ(-nucleon1->GetX() + 2*xshift,
-		       -nucleon1->GetY(),
-		       -nucleon1->GetZ());
+      fX[0] = r * stheta * cos(phi) + xshift;
+      fY[0] = r * stheta * sin(phi);
+      fZ[0] = r * ctheta;
+      fX[1] = -fX[0] + 2*xshift;
+      fY[1] = -fY[0];
+      fZ[1] = -fZ[0];
+      for (Int_t i = 0; i<fN; i++) {
+         AliGlauberNucleon *nucleon=(AliGlauberNucleon*)(fNucleons->UncheckedAt(i));
+         nucleon->Reset();
+         nucleon->SetXYZ(fX[i],fY[i],fZ[i]);
+      }
       fTrials = 1;
       return;
    }
 
+   Double_t minDist2 = fMinDist*fMinDist;
    for (Int_t i = 0; i<fN; i++) {
-      AliGlauberNucleon *nucleon=(AliGlauberNucleon*)(fNucleons->UncheckedAt(i));
-      nucleon->Reset();
       while(1) {
          fTrials++;
-         Double_t r = fFunction->GetRandom();
-         Double_t phi = gRandom->Rndm() * 2 * TMath::Pi() ;
-         Double_t ctheta = 2*gRandom->Rndm() - 1 ;
+         Double_t r = ThrowRadius();
+         Double_t phi = rnd->Rndm() * 2 * TMath::Pi() ;
+         Double_t ctheta = 2*rnd->Rndm() - 1 ;
          Double_t stheta = TMath::Sqrt(1-ctheta*ctheta);
          Double_t x = r * stheta * cos(phi) + xshift;
          Double_t y = r * stheta * sin(phi);      
          Double_t z = r * ctheta;      
-         nucleon->SetXYZ(x,y,z);
+         fX[i] = x;
+         fY[i] = y;
+         fZ[i] = z;
          if(fMinDist<0) break;
          Bool_t test=1;
          for (Int_t j = 0; j<i; j++) {
-            AliGlauberNucleon *other=(AliGlauberNucleon*)fNucleons->UncheckedAt(j);
-            Double_t xo=other->GetX();
-            Double_t yo=other->GetY();
-            Double_t zo=other->GetZ();
-            Double_t dist = TMath::Sqrt((x-xo)*(x-xo)+
-                                       (y-yo)*(y-yo)+
-                                       (z-zo)*(z-zo));
-	       
-            if(dist<fMinDist) {
+            Double_t dx = x-fX[j];
+            Double_t dy = y-fY[j];
+            Double_t dz = z-fZ[j];
+            if(dx*dx+dy*dy+dz*dz<minDist2) {
                test=0;
                break;
             }
@@ -297,9 +346,9 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
          if (test) break; //found nucleuon outside of mindist
       }
            
-      sumx += nucleon->GetX();
-      sumy += nucleon->GetY();
-      sumz += nucleon->GetZ();
+      sumx += fX[i];
+      sumy += fY[i];
+      sumz += fZ[i];
    }
       
    if(1) { // set the centre-of-mass to be at zero (+xshift)
@@ -307,11 +356,12 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
       sumy = sumy/fN;  
       sumz = sumz/fN;  
       for (Int_t i = 0; i<fN; i++) {
+         fX[i] -= sumx+xshift;
+         fY[i] -= sumy;
+         fZ[i] -= sumz;
          AliGlauberNucleon *nucleon=(AliGlauberNucleon*)(fNucleons->UncheckedAt(i));
-         nucleon->SetXYZ(nucleon->GetX()-sumx-xshift,
-                         nucleon->GetY()-sumy,
-                         nucleon->GetZ()-sumz);
+         nucleon->Reset();
+         nucleon->SetXYZ(fX[i],fY[i],fZ[i]);
       }
    }
 }
-
@@ -16,8 +16,11 @@
 
 //class TNamed;
 #include <TNamed.h>
+#include <vector>
+#include "AliGlauberSampler.h"
 class TObjArray;
 class TF1;
+class TRandom;
 
 class AliGlauberNucleus : public TNamed {
 private:
@@ -30,6 +33,11 @@ private:
    Int_t      fTrials;     //Store trials needed to complete nucleus
    TF1*       fFunction;   //Probability density function rho(r)
    TObjArray* fNucleons;   //Array of nucleons
+   std::vector<Double_t> fX; //!x of the nucleons, same order as fNucleons
+   std::vector<Double_t> fY; //!y of the nucleons
+   std::vector<Double_t> fZ; //!z of the nucleons
+   TRandom*   fRandom;     //!Random generator, gRandom if not set
+   AliGlauberSampler fRadius; //!Sampling table of fFunction
 
    void       Lookup(Option_t* name);
 
@@ -47,14 +55,21 @@ public:
    Double_t   GetW()             const {return fW;}
    TObjArray *GetNucleons()      const {return fNucleons;}
    Int_t      GetTrials()        const {return fTrials;}
+   const std::vector<Double_t>& GetX() const {return fX;}
+   const std::vector<Double_t>& GetY() const {return fY;}
+   const std::vector<Double_t>& GetZ() const {return fZ;}
+   TRandom   *GetRandom()        const;
    void       SetN(Int_t in)           {fN=in;}
    void       SetR(Double_t ir);
    void       SetA(Double_t ia);
    void       SetW(Double_t iw);
    void       SetMinDist(Double_t min) {fMinDist=min;}
+   void       SetRandom(TRandom* rnd)  {fRandom=rnd;}
+   void       InitSampler();
+   Double_t   ThrowRadius();
    void       ThrowNucleons(Double_t xshift=0.);
 
-   ClassDef(AliGlauberNucleus,1)
+   ClassDef(AliGlauberNucleus,2)
 };
 
 #endif
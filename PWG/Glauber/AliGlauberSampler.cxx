@@ -0,0 +1,89 @@
+/**************************************************************************
+* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+//
+//  AliGlauberSampler implementation
+//  support class for Glauber MC
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Riostream.h>
+#include <TMath.h>
+#include <TF1.h>
+#include <TRandom.h>
+#include "AliGlauberSampler.h"
+
+using std::cerr;
+using std::endl;
+ClassImp(AliGlauberSampler)
+
+//______________________________________________________________________________
+AliGlauberSampler::AliGlauberSampler() :
+  fXMin(0),
+  fDX(0),
+  fCdf()
+{
+  //ctor
+}
+
+//______________________________________________________________________________
+void AliGlauberSampler::Init(TF1* f, Int_t nbins)
+{
+   // Tabulate the cumulative distribution of f over its range.  The
+   // content of each bin is integrated with Simpson's rule, negative
+   // values of f are treated as zero.  Not thread safe: f is evaluated
+   // here, so call it before handing the sampler to a worker.
+
+   fCdf.clear();
+   if (!f || nbins<1) return;
+
+   fXMin = f->GetXmin();
+   fDX   = (f->GetXmax()-fXMin)/nbins;
+
+   std::vector<Double_t> cdf(nbins+1, 0.);
+   Double_t fa = TMath::Max(f->Eval(fXMin), 0.);
+   for (Int_t i = 0; i<nbins; i++) {
+      Double_t xa = fXMin + i*fDX;
+      Double_t fm = TMath::Max(f->Eval(xa+fDX/2), 0.);
+      Double_t fb = TMath::Max(f->Eval(xa+fDX), 0.);
+      cdf[i+1] = cdf[i] + (fa+4*fm+fb)*fDX/6;
+      fa = fb;
+   }
+   if (cdf[nbins]<=0) {
+      cerr << "AliGlauberSampler: " << f->GetName() << " has no positive integral" << endl;
+      return;
+   }
+   for (Int_t i = 1; i<=nbins; i++)
+      cdf[i] /= cdf[nbins];
+   fCdf.swap(cdf);
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberSampler::GetRandom(TRandom* rnd) const
+{
+   // Draw a value, linear in the cumulative distribution within a bin.
+
+   if (fCdf.empty()) return fXMin;
+
+   Int_t    nbins = fCdf.size()-1;
+   Double_t u     = rnd->Rndm();
+   Int_t    i     = TMath::BinarySearch(nbins+1, &fCdf[0], u);
+   if (i<0) i = 0;
+   if (i>=nbins) i = nbins-1;
+   Double_t w = fCdf[i+1]-fCdf[i];
+   Double_t t = w>0 ? (u-fCdf[i])/w : 0.5;
+   return fXMin + (i+t)*fDX;
+}
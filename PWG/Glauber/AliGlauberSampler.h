@@ -0,0 +1,41 @@
+#ifndef ALIGLAUBERSAMPLER_H
+#define ALIGLAUBERSAMPLER_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+////////////////////////////////////////////////////////////////////////////////
+//
+//  AliGlauberSampler
+//  support class for Glauber MC
+//
+//  Tabulated cumulative distribution of a TF1, sampled with a given
+//  random generator instead of gRandom, so that each Glauber MC
+//  worker can use its own random stream.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Rtypes.h>
+#include <vector>
+class TF1;
+class TRandom;
+
+class AliGlauberSampler {
+private:
+   Double_t              fXMin;  //Lower edge of the table
+   Double_t              fDX;    //Bin width of the table
+   std::vector<Double_t> fCdf;   //Normalized cumulative distribution at the bin edges
+
+public:
+   AliGlauberSampler();
+   virtual ~AliGlauberSampler() {}
+
+   void       Init(TF1* f, Int_t nbins=1000);
+   void       Clear()                  {fCdf.clear();}
+   Bool_t     IsValid()          const {return !fCdf.empty();}
+   Double_t   GetRandom(TRandom* rnd) const;
+
+   ClassDef(AliGlauberSampler,1)
+};
+
+#endif
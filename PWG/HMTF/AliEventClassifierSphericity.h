@@ -2,6 +2,7 @@
 #define AliEventClassifierSphericity_cxx
 
 #include "AliEventClassifierBase.h"
+#include "AliEventShapeCalculator.h"
 
 class AliEventClassifierSphericity : public AliEventClassifierBase {
  public:
@@ -13,8 +14,10 @@ class AliEventClassifierSphericity : public AliEventClassifierBase {
 
  private:
   void CalculateClassifierValue(AliMCEvent *event, AliStack *stack);
+
+  AliEventShapeCalculator fEventShape; //! selected tracks of the current event
   
-  ClassDef(AliEventClassifierSphericity, 1);
+  ClassDef(AliEventClassifierSphericity, 2);
 };
 
 #endif
@@ -42,50 +42,14 @@ Bool_t AliEventClassifierSpherocity::TrackPassesSelection(AliMCParticle* track,
 }
 
 void AliEventClassifierSpherocity::CalculateClassifierValue(AliMCEvent *event, AliStack *stack) {
-  // This implementation is adapted from PWGLF/SPECTRA/Spherocity/AliTransverseEventShape.cxx
-  fClassifierValue = 0.0;
-
-  Float_t sumRatioSquare = 0;
-  Float_t minimalSumRatioSquare = 2;
-  
-  // Step size in phi unit vector used to find m spherocity
-  Float_t phiStepSize = 0.1;
-
-  // Computing total pt
-  Float_t sumapt = 0;
+  // Spherocity of the selected tracks, see PWG/Tools/AliEventShapeCalculator;
+  // -1 for events without selected tracks
+  fEventShape.Clear();
   Int_t ntracks = event->GetNumberOfTracks();
   for (Int_t iTrack = 0; iTrack < ntracks; iTrack++) {
     AliMCParticle *track = static_cast<AliMCParticle*>(event->GetTrack(iTrack));
     if (!TrackPassesSelection(track, stack, iTrack)) continue;
-    sumapt += track->Pt();
+    fEventShape.AddTrack(track->Pt(), track->Phi());
   }
-  
-  // Getting thrust
-  for(Int_t i = 0; i < 360/(phiStepSize); ++i){
-    Float_t numerator = 0;
-    Float_t phiparam  = 0;
-    Float_t nx = 0;
-    Float_t ny = 0;
-    phiparam=((TMath::Pi()) * i * phiStepSize) / 180; // parametrization of the angle
-    nx = TMath::Cos(phiparam);            // x component of an unitary vector n
-    ny = TMath::Sin(phiparam);            // y component of an unitary vector n
-    for(Int_t iTrack = 0; iTrack < ntracks; ++iTrack){
-      AliMCParticle *track = static_cast<AliMCParticle*>(event->GetTrack(iTrack));
-      if (!TrackPassesSelection(track, stack, iTrack)) continue;
-      
-      Float_t pxA = track->Pt() * TMath::Cos(track->Phi());
-      Float_t pyA = track->Pt() * TMath::Sin(track->Phi());
-      //product between p projection in XY plane and the unitary vector
-      numerator += TMath::Abs( ny * pxA - nx * pyA );
-    }
-    
-    sumRatioSquare = TMath::Power((numerator / sumapt), 2);
-    if(sumRatioSquare < minimalSumRatioSquare)  //minimization of pFull
-      {
-	minimalSumRatioSquare = sumRatioSquare;
-      }
-  }
-
-  // Compute the final spherocity:
-  fClassifierValue = (minimalSumRatioSquare * TMath::Pi() * TMath::Pi()) / 4.0;
+  fClassifierValue = fEventShape.GetSpherocity();
 }
@@ -0,0 +1,278 @@
+/**************************************************************************
+ * Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//
+// Transverse spherocity, sphericity and thrust of a list of tracks.
+//
+// Definitions, with the sums over the tracks and n a unit vector in
+// the transverse plane:
+//   spherocity = pi^2/4 * min_n ( sum |pT x n| / sum pT )^2
+//   thrust     =          max_n   sum |pT . n| / sum pT
+//   sphericity = 2 lambda_min / (lambda_1 + lambda_2), with lambda the
+//                eigenvalues of S_ab = sum pT_a pT_b / pT / sum pT
+//
+
+#include <TMath.h>
+#include "AliEventShapeCalculator.h"
+
+ClassImp(AliEventShapeCalculator)
+
+//________________________________________________________________________
+AliEventShapeCalculator::AliEventShapeCalculator() :
+  TObject(),
+  fPt(),
+  fPhi(),
+  fPsi(),
+  fIndex(),
+  fQx(),
+  fQy(),
+  fSumPt(0.),
+  fStatus(0),
+  fSpherocity(-1.),
+  fSpherocityAxis(-1.),
+  fSphericity(-1.),
+  fThrust(-1.),
+  fThrustAxis(-1.)
+{
+}
+
+//________________________________________________________________________
+void AliEventShapeCalculator::Clear(Option_t* /*opt*/)
+{
+  // Remove the tracks, to start a new event
+
+  fPt.clear();
+  fPhi.clear();
+  fSumPt = 0.;
+  fStatus = 0;
+}
+
+//________________________________________________________________________
+void AliEventShapeCalculator::AddTrack(Double_t pt, Double_t phi)
+{
+  // Add one track to the event
+
+  fPt.push_back(pt);
+  fPhi.push_back(phi);
+  fSumPt += pt;
+  fStatus = 0;
+}
+
+//________________________________________________________________________
+void AliEventShapeCalculator::SetTracks(Int_t n, const Double_t* pt, const Double_t* phi)
+{
+  // Set all tracks of the event
+
+  Clear();
+  fPt.assign(pt, pt+n);
+  fPhi.assign(phi, phi+n);
+  for (Int_t i = 0; i < n; i++) fSumPt += pt[i];
+}
+
+//________________________________________________________________________
+void AliEventShapeCalculator::SetTracks(Int_t n, const Float_t* pt, const Float_t* phi)
+{
+  // Set all tracks of the event
+
+  Clear();
+  fPt.assign(pt, pt+n);
+  fPhi.assign(phi, phi+n);
+  for (Int_t i = 0; i < n; i++) fSumPt += pt[i];
+}
+
+//________________________________________________________________________
+Double_t AliEventShapeCalculator::GetSpherocity()
+{
+  // Spherocity, -1 if not defined
+
+  if (!(fStatus & kSpherocity)) CalculateSpherocity();
+  return fSpherocity;
+}
+
+//________________________________________________________________________
+Double_t AliEventShapeCalculator::GetSpherocityAxis()
+{
+  // Azimuth in [0,pi) of the axis minimizing the spherocity sum, -1 if not defined
+
+  if (!(fStatus & kSpherocity)) CalculateSpherocity();
+  return fSpherocityAxis;
+}
+
+//________________________________________________________________________
+Double_t AliEventShapeCalculator::GetSphericity()
+{
+  // Sphericity, -1 if not defined
+
+  if (!(fStatus & kSphericity)) CalculateSphericity();
+  return fSphericity;
+}
+
+//________________________________________________________________________
+Double_t AliEventShapeCalculator::GetThrust()
+{
+  // Thrust, -1 if not defined
+
+  if (!(fStatus & kThrust)) CalculateThrust();
+  return fThrust;
+}
+
+//________________________________________________________________________
+Double_t AliEventShapeCalculator::GetThrustAxis()
+{
+  // Azimuth in [0,pi) of the thrust axis, -1 if not defined
+
+  if (!(fStatus & kThrust)) CalculateThrust();
+  return fThrustAxis;
+}
+
+//________________________________________________________________________
+void AliEventShapeCalculator::Sort()
+{
+  // Fold the track directions into [0,pi) and order them. The shapes do
+  // not depend on the sign of the track vectors.
+
+  if (fStatus & kSorted) return;
+
+  Int_t n = fPt.size();
+  fPsi.resize(n);
+  fIndex.resize(n);
+  fQx.resize(n);
+  fQy.resize(n);
+  for (Int_t i = 0; i < n; i++) {
+    Double_t psi = fPhi[i] - TMath::Pi() * TMath::Floor(fPhi[i] / TMath::Pi());
+    if (psi >= TMath::Pi() || psi < 0) psi = 0;
+    fPsi[i] = psi;
+  }
+  if (n > 0) TMath::Sort(n, &fPsi[0], &fIndex[0], kFALSE);
+  for (Int_t k = 0; k < n; k++) {
+    Int_t i = fIndex[k];
+    fQx[k] = fPt[i] * TMath::Cos(fPsi[i]);
+    fQy[k] = fPt[i] * TMath::Sin(fPsi[i]);
+  }
+  fStatus |= kSorted;
+}
+
+//________________________________________________________________________
+void AliEventShapeCalculator::CalculateSpherocity()
+{
+  // Between two consecutive track directions, sum |pT x n| is a positive
+  // sinusoid in the axis angle, so its minimum is at a track direction.
+  // For the axis along track k, the tracks before k in folded phi have
+  // pT x n of one sign, those after of the other, so
+  //   sum |pT x n| = n x (Q - 2 P_k)
+  // with Q the sum of all folded vectors and P_k the sum of those before k.
+
+  fStatus |= kSpherocity;
+  fSpherocity = -1.;
+  fSpherocityAxis = -1.;
+  Int_t n = fPt.size();
+  if (n == 0 || !(fSumPt > 0)) return;
+
+  Sort();
+  Double_t qx = 0., qy = 0.;
+  for (Int_t k = 0; k < n; k++) { qx += fQx[k]; qy += fQy[k]; }
+
+  Double_t minSum = -1.;
+  Double_t px = 0., py = 0.;
+  for (Int_t k = 0; k < n; k++) {
+    Int_t i = fIndex[k];
+    if (fPt[i] > 0) {
+      Double_t nx = fQx[k] / fPt[i];
+      Double_t ny = fQy[k] / fPt[i];
+      Double_t sum = nx * (qy - 2*py) - ny * (qx - 2*px);
+      if (minSum < 0 || sum < minSum) {
+        minSum = sum;
+        fSpherocityAxis = fPsi[i];
+      }
+    }
+    px += fQx[k];
+    py += fQy[k];
+  }
+  if (minSum < 0) minSum = 0.;
+
+  Double_t ratio = minSum / fSumPt;
+  fSpherocity = ratio * ratio * TMath::Pi() * TMath::Pi() / 4.;
+}
+
+//________________________________________________________________________
+void AliEventShapeCalculator::CalculateSphericity()
+{
+  // Eigenvalues of the linearized transverse momentum tensor
+
+  fStatus |= kSphericity;
+  fSphericity = -1.;
+  Int_t n = fPt.size();
+  if (n == 0 || !(fSumPt > 0)) return;
+
+  Sort();
+  Double_t s00 = 0., s01 = 0., s11 = 0.;
+  for (Int_t k = 0; k < n; k++) {
+    Double_t pt = fPt[fIndex[k]];
+    if (pt == 0) continue;
+    s00 += fQx[k] * fQx[k] / pt;
+    s01 += fQx[k] * fQy[k] / pt;
+    s11 += fQy[k] * fQy[k] / pt;
+  }
+  s00 /= fSumPt;
+  s01 /= fSumPt;
+  s11 /= fSumPt;
+
+  Double_t trace = s00 + s11;
+  Double_t disc  = TMath::Sqrt(TMath::Max(trace*trace - 4*(s00*s11 - s01*s01), 0.));
+  Double_t lambda1 = (trace + disc) / 2;
+  Double_t lambda2 = (trace - disc) / 2;
+  if (lambda1 + lambda2 != 0) fSphericity = 2 * TMath::Min(lambda1, lambda2) / (lambda1 + lambda2);
+  else fSphericity = 0.;
+}
+
+//________________________________________________________________________
+void AliEventShapeCalculator::CalculateThrust()
+{
+  // For any axis, the tracks with pT . n > 0 are on one side of a line
+  // through the origin, that is a range of the folded directions. The
+  // thrust sum is the largest |Q - 2 P_k| over these splits, along the
+  // direction of Q - 2 P_k.
+
+  fStatus |= kThrust;
+  fThrust = -1.;
+  fThrustAxis = -1.;
+  Int_t n = fPt.size();
+  if (n == 0 || !(fSumPt > 0)) return;
+
+  Sort();
+  Double_t qx = 0., qy = 0.;
+  for (Int_t k = 0; k < n; k++) { qx += fQx[k]; qy += fQy[k]; }
+
+  Double_t max2 = -1., dxMax = 0., dyMax = 0.;
+  Double_t px = 0., py = 0.;
+  for (Int_t k = 0; k <= n; k++) {
+    Double_t dx = qx - 2*px;
+    Double_t dy = qy - 2*py;
+    if (dx*dx + dy*dy > max2) {
+      max2 = dx*dx + dy*dy;
+      dxMax = dx;
+      dyMax = dy;
+    }
+    if (k < n) {
+      px += fQx[k];
+      py += fQy[k];
+    }
+  }
+  fThrust = TMath::Sqrt(max2) / fSumPt;
+  Double_t axis = TMath::ATan2(dyMax, dxMax);
+  if (axis < 0) axis += TMath::Pi();
+  if (axis >= TMath::Pi()) axis -= TMath::Pi();
+  fThrustAxis = axis;
+}
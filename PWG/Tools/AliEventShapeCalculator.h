@@ -0,0 +1,86 @@
+/**
+ * \file AliEventShapeCalculator.h
+ * \brief Declaration of class AliEventShapeCalculator
+ *
+ * Transverse event shapes (spherocity, sphericity, thrust) of a list of
+ * tracks given as pt and phi arrays.
+ */
+#ifndef ALIEVENTSHAPECALCULATOR_H
+#define ALIEVENTSHAPECALCULATOR_H
+
+/* Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <TObject.h>
+#include <vector>
+
+/**
+ * \class AliEventShapeCalculator
+ * \brief Transverse spherocity, sphericity and thrust of an event
+ *
+ * The tracks of an event are set with SetTracks() or AddTrack(). The
+ * shapes are calculated on first request and kept until the tracks
+ * change, so that all users of the same calculator share them.
+ *
+ * Spherocity and thrust are exact: the track directions are folded
+ * into [0,pi) and sorted once, and the sums over all tracks for each
+ * candidate axis are obtained from running sums along the sorted list.
+ * The minimum of the spherocity sum is always on one of the track
+ * directions, so no scan over a grid of axes is needed. The cost is
+ * one sort, O(N log N), instead of O(N) sines and cosines per axis.
+ *
+ * Shapes of events without tracks or with zero total pt are -1.
+ */
+class AliEventShapeCalculator : public TObject {
+public:
+  AliEventShapeCalculator();
+  virtual ~AliEventShapeCalculator() {}
+
+  virtual void Clear(Option_t* opt="");
+  void         AddTrack(Double_t pt, Double_t phi);
+  void         SetTracks(Int_t n, const Double_t* pt, const Double_t* phi);
+  void         SetTracks(Int_t n, const Float_t* pt, const Float_t* phi);
+
+  /// \return number of tracks of the event
+  Int_t        GetNTracks() const { return fPt.size(); }
+  /// \return scalar sum of the track pt
+  Double_t     GetSumPt()   const { return fSumPt; }
+
+  Double_t     GetSpherocity();
+  Double_t     GetSpherocityAxis();
+  Double_t     GetSphericity();
+  Double_t     GetThrust();
+  Double_t     GetThrustAxis();
+
+private:
+  /// Quantities already calculated for the current tracks
+  enum EStatus {
+    kSorted     = 1<<0,
+    kSpherocity = 1<<1,
+    kSphericity = 1<<2,
+    kThrust     = 1<<3
+  };
+
+  void         Sort();
+  void         CalculateSpherocity();
+  void         CalculateSphericity();
+  void         CalculateThrust();
+
+  std::vector<Double_t> fPt;           //!<! pt of the tracks
+  std::vector<Double_t> fPhi;          //!<! phi of the tracks
+  std::vector<Double_t> fPsi;          //!<! phi folded into [0,pi)
+  std::vector<Int_t>    fIndex;        //!<! tracks ordered in folded phi
+  std::vector<Double_t> fQx;           //!<! px of the folded tracks, in fIndex order
+  std::vector<Double_t> fQy;           //!<! py of the folded tracks, in fIndex order
+  Double_t              fSumPt;        //!<! scalar sum of pt
+  UInt_t                fStatus;       //!<! EStatus bits
+  Double_t              fSpherocity;   //!<! spherocity
+  Double_t              fSpherocityAxis; //!<! phi of the spherocity axis, in [0,pi)
+  Double_t              fSphericity;   //!<! sphericity
+  Double_t              fThrust;       //!<! thrust
+  Double_t              fThrustAxis;   //!<! phi of the thrust axis, in [0,pi)
+
+  ClassDef(AliEventShapeCalculator, 1) // Transverse event shapes
+};
+
+#endif /* ALIEVENTSHAPECALCULATOR_H */
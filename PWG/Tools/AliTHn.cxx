@@ -53,7 +53,12 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT() :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fAxisUniform(0),
+  fAxisMin(0),
+  fAxisMax(0),
+  fAxisEdges(0),
+  fBatchBins()
 {
   // Constructor
 }
@@ -69,7 +74,12 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const Char_t* name, const Char_t*
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fAxisUniform(0),
+  fAxisMin(0),
+  fAxisMax(0),
+  fAxisEdges(0),
+  fBatchBins()
 {
   // Constructor
 
@@ -106,7 +116,12 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const AliTHnT &c) :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fAxisUniform(0),
+  fAxisMin(0),
+  fAxisMax(0),
+  fAxisEdges(0),
+  fBatchBins()
 {
   //
   // AliTHnT copy constructor
@@ -131,10 +146,7 @@ AliTHnT<TemplateArray, TemplateType>::~AliTHnT()
   
   delete[] fValues;
   delete[] fSumw2;
-  delete[] axisCache;
-  delete[] fNbinsCache;
-  delete[] fLastVars;
-  delete[] fLastBins;
+  ResetAxisCache();
 }
 
 template <class TemplateArray, typename TemplateType>
@@ -191,9 +203,8 @@ AliTHnT<TemplateArray, TemplateType> &AliTHnT<TemplateArray, TemplateType>::oper
       fValues = 0;
       fSumw2 = 0;
     }
-    delete [] axisCache;
-    axisCache = new TAxis*[fNVars];
-    memcpy(axisCache, c.axisCache, fNVars*sizeof(TAxis*));
+    // the caches point to the axes of this object and are rebuilt at the next Fill
+    ResetAxisCache();
   }
   return *this;
 }
@@ -282,31 +293,117 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
 }
 
 template <class TemplateArray, typename TemplateType>
-void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep, Double_t weight)
+void AliTHnT<TemplateArray, TemplateType>::InitAxisCache()
 {
-  // fills an entry
-
-  // fill axis cache
-  if (!axisCache)
+  // caches the axis pointers and the information needed to find bins without calling TAxis::FindBin
+  
+  axisCache = new TAxis*[fNVars];
+  fNbinsCache = new Int_t[fNVars];
+  fLastVars = new Double_t[fNVars];
+  fLastBins = new Int_t[fNVars];
+  fAxisUniform = new Bool_t[fNVars];
+  fAxisMin = new Double_t[fNVars];
+  fAxisMax = new Double_t[fNVars];
+  fAxisEdges = new const Double_t*[fNVars];
+  
+  for (Int_t i=0; i<fNVars; i++)
   {
-    axisCache = new TAxis*[fNVars];
-    fNbinsCache = new Int_t[fNVars];
-    for (Int_t i=0; i<fNVars; i++)
-    {
-      axisCache[i] = GetAxis(i, 0);
-      fNbinsCache[i] = axisCache[i]->GetNbins();
-    }
+    axisCache[i] = GetAxis(i, 0);
+    fNbinsCache[i] = axisCache[i]->GetNbins();
+    fAxisMin[i] = axisCache[i]->GetXmin();
+    fAxisMax[i] = axisCache[i]->GetXmax();
+    fAxisUniform[i] = (axisCache[i]->GetXbins()->GetSize() == 0);
+    fAxisEdges[i] = (fAxisUniform[i]) ? 0 : axisCache[i]->GetXbins()->GetArray();
     
-    fLastVars = new Double_t[fNVars];
-    fLastBins = new Int_t[fNVars];
-    
-    // initial values to prevent checking for 0 below
-    for (Int_t i=0; i<fNVars; i++)
+    // initial values to prevent checking for 0 in Fill
+    fLastVars[i] = fAxisMin[i];
+    fLastBins[i] = FindAxisBin(i, fAxisMin[i]);
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::ResetAxisCache()
+{
+  // deletes the axis caches, they are recreated at the next call to Fill
+  
+  delete[] axisCache;
+  delete[] fNbinsCache;
+  delete[] fLastVars;
+  delete[] fLastBins;
+  delete[] fAxisUniform;
+  delete[] fAxisMin;
+  delete[] fAxisMax;
+  delete[] fAxisEdges;
+  
+  axisCache = 0;
+  fNbinsCache = 0;
+  fLastVars = 0;
+  fLastBins = 0;
+  fAxisUniform = 0;
+  fAxisMin = 0;
+  fAxisMax = 0;
+  fAxisEdges = 0;
+}
+
+template <class TemplateArray, typename TemplateType>
+Int_t AliTHnT<TemplateArray, TemplateType>::FindAxisBin(Int_t i, Double_t x) const
+{
+  // returns the bin of <x> on axis <i> counting from 0, or -1 for under/overflow
+  // gives the same result as TAxis::FindBin (apart from the shift by 1)
+  
+  if (!(x >= fAxisMin[i] && x < fAxisMax[i]))
+    return -1;
+  
+  if (fAxisUniform[i])
+  {
+    Int_t bin = (Int_t) (fNbinsCache[i] * (x - fAxisMin[i]) / (fAxisMax[i] - fAxisMin[i]));
+    return (bin < fNbinsCache[i]) ? bin : -1;
+  }
+  
+  // binary search without branches: largest edge <= x
+  const Double_t* edges = fAxisEdges[i];
+  const Double_t* base = edges;
+  Int_t len = fNbinsCache[i] + 1;
+  while (len > 1)
+  {
+    const Int_t half = len / 2;
+    base = (base[half] <= x) ? base + half : base;
+    len -= half;
+  }
+  
+  return base - edges;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::CreateStep(Int_t istep, Bool_t sumw2)
+{
+  // creates the containers of step <istep>; the sumw2 container is only created when requested (weight != 1)
+  
+  if (!fValues[istep])
+  {
+    fValues[istep] = new TemplateArray(fNBins);
+    AliInfo(Form("Created values container for step %d", istep));
+  }
+
+  if (sumw2)
+  {
+    // initialize with already filled entries (which have been filled with weight == 1), in this case fSumw2 := fValues
+    if (!fSumw2[istep])
     {
-      fLastBins[i] = axisCache[i]->FindBin(var[i]);
-      fLastVars[i] = var[i];
+      fSumw2[istep] = new TemplateArray(*fValues[istep]);
+      AliInfo(Form("Created sumw2 container for step %d", istep));
     }
   }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep, Double_t weight)
+{
+  // fills an entry
+
+  // fill axis cache
+  if (!axisCache)
+    InitAxisCache();
   
   // calculate global bin index
   Long64_t bin = 0;
@@ -319,36 +416,22 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
       tmpBin = fLastBins[i];
     else
     {
-      tmpBin = axisCache[i]->FindBin(var[i]);
+      tmpBin = FindAxisBin(i, var[i]);
       fLastBins[i] = tmpBin;
       fLastVars[i] = var[i];
     }
     //Printf("%d", tmpBin);
 
     // under/overflow not supported
-    if (tmpBin < 1 || tmpBin > fNbinsCache[i])
+    if (tmpBin < 0)
       return;
     
     // bins start from 0 here
-    bin += tmpBin - 1;
+    bin += tmpBin;
 //     Printf("%lld", bin);
   }
 
-  if (!fValues[istep])
-  {
-    fValues[istep] = new TemplateArray(fNBins);
-    AliInfo(Form("Created values container for step %d", istep));
-  }
-
-  if (weight != 1)
-  {
-    // initialize with already filled entries (which have been filled with weight == 1), in this case fSumw2 := fValues
-    if (!fSumw2[istep])
-    {
-      fSumw2[istep] = new TemplateArray(*fValues[istep]);
-      AliInfo(Form("Created sumw2 container for step %d", istep));
-    }
-  }
+  CreateStep(istep, (weight != 1));
 
   fValues[istep]->GetArray()[bin] += weight;
   if (fSumw2[istep])
@@ -360,6 +443,110 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 //   AliCFContainer::Fill(var, istep, weight);
 }
 
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillN(Int_t n, const Double_t* const* vars, Int_t istep, const Double_t* weights)
+{
+  // fills <n> entries at once
+  // vars[i] points to the <n> values of variable i
+  // weights points to the <n> weights; if 0 all entries are filled with weight 1
+  //
+  // the global bin indices are calculated axis by axis for blocks of entries. These loops do not
+  // contain data dependent branches and can be vectorized by the compiler. The result is identical to
+  // calling Fill for each entry.
+  
+  if (n <= 0)
+    return;
+  
+  if (!axisCache)
+    InitAxisCache();
+  
+  const Int_t kBlockSize = 256;
+  if (fBatchBins.size() < (UInt_t) kBlockSize)
+    fBatchBins.resize(kBlockSize);
+  Long64_t* bins = &fBatchBins[0];
+  
+  for (Int_t offset=0; offset<n; offset+=kBlockSize)
+  {
+    const Int_t nBlock = TMath::Min(kBlockSize, n - offset);
+    
+    for (Int_t k=0; k<nBlock; k++)
+      bins[k] = 0;
+    
+    // calculate global bin index, -1 flags under/overflow in any of the axes
+    for (Int_t i=0; i<fNVars; i++)
+    {
+      const Double_t* x = vars[i] + offset;
+      const Long64_t nBins = fNbinsCache[i];
+      const Double_t xMin = fAxisMin[i];
+      const Double_t xMax = fAxisMax[i];
+      
+      if (fAxisUniform[i])
+      {
+        const Double_t width = xMax - xMin;
+        for (Int_t k=0; k<nBlock; k++)
+        {
+          const Bool_t inRange = (x[k] >= xMin && x[k] < xMax);
+          // same arithmetic as TAxis::FindBin; out of range values are replaced to avoid an undefined conversion
+          const Double_t value = (inRange) ? x[k] : xMin;
+          const Long64_t bin = (Long64_t) (nBins * (value - xMin) / width);
+          bins[k] = (inRange && bin < nBins && bins[k] >= 0) ? bins[k] * nBins + bin : -1;
+        }
+      }
+      else
+      {
+        const Double_t* edges = fAxisEdges[i];
+        for (Int_t k=0; k<nBlock; k++)
+        {
+          const Bool_t inRange = (x[k] >= xMin && x[k] < xMax);
+          const Double_t value = (inRange) ? x[k] : xMin;
+          const Double_t* base = edges;
+          Int_t len = nBins + 1;
+          while (len > 1)
+          {
+            const Int_t half = len / 2;
+            base = (base[half] <= value) ? base + half : base;
+            len -= half;
+          }
+          const Long64_t bin = base - edges;
+          bins[k] = (inRange && bins[k] >= 0) ? bins[k] * nBins + bin : -1;
+        }
+      }
+    }
+    
+    // containers are only created when an entry is filled (as in Fill)
+    Bool_t anyInRange = kFALSE;
+    Bool_t anyWeighted = kFALSE;
+    for (Int_t k=0; k<nBlock; k++)
+    {
+      if (bins[k] < 0)
+        continue;
+      anyInRange = kTRUE;
+      if (weights && weights[offset+k] != 1)
+        anyWeighted = kTRUE;
+    }
+    
+    if (!anyInRange)
+      continue;
+    
+    // as all entries before the first one with weight != 1 have weight 1, the sumw2 container can be created for the full block
+    CreateStep(istep, anyWeighted);
+    
+    TemplateType* values = fValues[istep]->GetArray();
+    TemplateType* sumw2 = (fSumw2[istep]) ? fSumw2[istep]->GetArray() : 0;
+    
+    for (Int_t k=0; k<nBlock; k++)
+    {
+      if (bins[k] < 0)
+        continue;
+      
+      const Double_t weight = (weights) ? weights[offset+k] : 1;
+      values[bins[k]] += weight;
+      if (sumw2)
+        sumw2[bins[k]] += weight * weight;
+    }
+  }
+}
+
 template <class TemplateArray, typename TemplateType>
 Long64_t AliTHnT<TemplateArray, TemplateType>::GetGlobalBinIndex(const Int_t* binIdx)
 {
@@ -398,45 +585,31 @@ void AliTHnT<TemplateArray, TemplateType>::FillContainer(AliCFContainer* cont)
     Int_t* binIdx = new Int_t[fNVars];
     Int_t* nBins  = new Int_t[fNVars];
     for (Int_t j=0; j<fNVars; j++)
-    {
-      binIdx[j] = 1;
       nBins[j] = target->GetAxis(j)->GetNbins();
-    }
     
     Long64_t count = 0;
     
-    while (1)
+    // scan the dense array and only calculate the axis bin indices for filled bins
+    for (Long64_t globalBin = 0; globalBin < fNBins; globalBin++)
     {
-//       for (Int_t j=0; j<fNVars; j++)
-// 	printf("%d ", binIdx[j]);
-      
-      Long64_t globalBin = GetGlobalBinIndex(binIdx);
-//       Printf(" --> %lld", globalBin);
+      if (source[globalBin] == 0)
+        continue;
       
-      if (source[globalBin] != 0)
+      // inverse of GetGlobalBinIndex
+      Long64_t remainder = globalBin;
+      for (Int_t j=fNVars-1; j>=0; j--)
       {
-	target->SetBinContent(binIdx, source[globalBin]);
-	target->SetBinError(binIdx, TMath::Sqrt(sourceSumw2[globalBin]));
-	
-	count++;
+        binIdx[j] = remainder % nBins[j] + 1;
+        remainder /= nBins[j];
       }
       
-      binIdx[fNVars-1]++;
-      
-      for (Int_t j=fNVars-1; j>0; j--)
-      {
-	if (binIdx[j] > nBins[j])
-	{
-	  binIdx[j] = 1;
-	  binIdx[j-1]++;
-	}
-      }
+      target->SetBinContent(binIdx, source[globalBin]);
+      target->SetBinError(binIdx, TMath::Sqrt(sourceSumw2[globalBin]));
       
-      if (binIdx[0] > nBins[0])
-	break;
+      count++;
     }
     
-    AliInfo(Form("Step %d: copied %lld entries out of %lld bins", i, count, GetGlobalBinIndex(binIdx)));
+    AliInfo(Form("Step %d: copied %lld entries out of %lld bins", i, count, fNBins));
 
     delete[] binIdx;
     delete[] nBins;
@@ -14,6 +14,8 @@
 #include "TString.h"
 #include "AliCFContainer.h"
 
+#include <vector>
+
 class TArray;
 class TArrayF;
 class TArrayD;
@@ -26,6 +28,7 @@ public:
   AliTHnBase(const Char_t* name, const Char_t* title,const Int_t nSelStep, const Int_t nVarIn, const Int_t* nBinIn) : AliCFContainer(name, title, nSelStep, nVarIn, nBinIn) { }
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) = 0;
+  virtual void FillN(Int_t n, const Double_t* const* vars, Int_t istep, const Double_t* weights=0) = 0;
   virtual void FillParent() = 0;
   virtual void FillContainer(AliCFContainer* cont) = 0;
 
@@ -48,6 +51,7 @@ class AliTHnT : public AliTHnBase
   virtual ~AliTHnT();
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  virtual void FillN(Int_t n, const Double_t* const* vars, Int_t istep, const Double_t* weights=0);
   virtual void FillParent();
   virtual void FillContainer(AliCFContainer* cont);
   
@@ -65,6 +69,10 @@ class AliTHnT : public AliTHnBase
   
 protected:
   void Init();
+  void InitAxisCache();
+  void ResetAxisCache();
+  void CreateStep(Int_t istep, Bool_t sumw2);
+  Int_t FindAxisBin(Int_t i, Double_t x) const;
   Long64_t GetGlobalBinIndex(const Int_t* binIdx);
   
   Long64_t fNBins;   // number of total bins
@@ -77,8 +85,13 @@ protected:
   Int_t* fNbinsCache; //! cache Nbins per axis
   Double_t* fLastVars; //! caching of last used bins (in many loops some vars are the same for a while)
   Int_t* fLastBins; //! caching of last used bins (in many loops some vars are the same for a while)
+  Bool_t* fAxisUniform; //! axis has equidistant bins (bin from arithmetic, otherwise binary search in fAxisEdges)
+  Double_t* fAxisMin; //! cache lower edge per axis
+  Double_t* fAxisMax; //! cache upper edge per axis
+  const Double_t** fAxisEdges; //! cache bin edges per axis (only for variable bins)
+  std::vector<Long64_t> fBatchBins; //! global bin indices of the block processed in FillN
   
-  ClassDef(AliTHnT, 5) // THn like container
+  ClassDef(AliTHnT, 6) // THn like container
 };
 
 typedef AliTHnT<TArrayF, Float_t> AliTHn;
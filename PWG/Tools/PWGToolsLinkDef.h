@@ -30,6 +30,7 @@
 #pragma link C++ class AliJSONString+;
 #pragma link C++ class AliAnalysisTaskDummy+;
 #pragma link C++ class AliTLorentzVector+;
+#pragma link C++ class AliEventShapeCalculator+;
 #if ROOT_VERSION_CODE > ROOT_VERSION(6,4,0)
 #pragma link C++ namespace YAML+;
 #pragma link C++ class YAML::Node+;
@@ -46,4 +47,5 @@
 #pragma link C++ function TestTHistManager::TestRunBuildGrouped();
 #pragma link C++ function TestTHistManager::TestRunFillSimple();
 #pragma link C++ function TestTHistManager::TestRunFillGrouped();
+#pragma link C++ function TestTHistManager::TestRunFillHandle();
 #endif
@@ -77,13 +77,13 @@ THashList* THistManager::CreateHistoGroup(const char *groupname) {
 	return childgroup;
 }
 
-TH1* THistManager::CreateTH1(const char *name, const char *title, int nbins, double xmin, double xmax, Option_t *opt){
+THistManager::TH1Handle THistManager::CreateTH1(const char *name, const char *title, int nbins, double xmin, double xmax, Option_t *opt){
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTH1", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return TH1Handle();
 	}
 	TH1* h = new TH1D(hname, title, nbins, xmin, xmax);
   TString optionstring(opt);
@@ -91,16 +91,16 @@ TH1* THistManager::CreateTH1(const char *name, const char *title, int nbins, dou
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return TH1Handle(h);
 }
 
-TH1* THistManager::CreateTH1(const char *name, const char *title, int nbins, const double *xbins, Option_t *opt){
+THistManager::TH1Handle THistManager::CreateTH1(const char *name, const char *title, int nbins, const double *xbins, Option_t *opt){
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTH1", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return TH1Handle();
 	}
 	TH1* h = new TH1D(hname, title, nbins, xbins);
   TString optionstring(opt);
@@ -108,16 +108,16 @@ TH1* THistManager::CreateTH1(const char *name, const char *title, int nbins, con
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return TH1Handle(h);
 }
 
-TH1* THistManager::CreateTH1(const char *name, const char *title, const TArrayD &xbins, Option_t *opt){
+THistManager::TH1Handle THistManager::CreateTH1(const char *name, const char *title, const TArrayD &xbins, Option_t *opt){
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTH1", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return TH1Handle();
 	}
 	TH1* h = new TH1D(hname, title, xbins.GetSize()-1, xbins.GetArray());
   TString optionstring(opt);
@@ -125,10 +125,10 @@ TH1* THistManager::CreateTH1(const char *name, const char *title, const TArrayD
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return TH1Handle(h);
 }
 
-TH1* THistManager::CreateTH1(const char *name, const char *title, const TBinning &xbin, Option_t *opt){
+THistManager::TH1Handle THistManager::CreateTH1(const char *name, const char *title, const TBinning &xbin, Option_t *opt){
   TArrayD myxbins;
   try{
     xbin.CreateBinEdges(myxbins);
@@ -138,13 +138,13 @@ TH1* THistManager::CreateTH1(const char *name, const char *title, const TBinning
   return CreateTH1(name, title, myxbins, opt);
 }
 
-TH2* THistManager::CreateTH2(const char *name, const char *title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, Option_t *opt){
+THistManager::TH2Handle THistManager::CreateTH2(const char *name, const char *title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, Option_t *opt){
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTH2", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return TH2Handle();
 	}
 	TH2* h = new TH2D(hname, title, nbinsx, xmin, xmax, nbinsy, ymin, ymax);
   TString optionstring(opt);
@@ -152,16 +152,16 @@ TH2* THistManager::CreateTH2(const char *name, const char *title, int nbinsx, do
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return TH2Handle(h);
 }
 
-TH2* THistManager::CreateTH2(const char *name, const char *title, int nbinsx, const double *xbins, int nbinsy, const double *ybins, Option_t *opt){
+THistManager::TH2Handle THistManager::CreateTH2(const char *name, const char *title, int nbinsx, const double *xbins, int nbinsy, const double *ybins, Option_t *opt){
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTH2", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return TH2Handle();
 	}
 	TH2* h = new TH2D(hname, title, nbinsx, xbins, nbinsy, ybins);
   TString optionstring(opt);
@@ -169,16 +169,16 @@ TH2* THistManager::CreateTH2(const char *name, const char *title, int nbinsx, co
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return TH2Handle(h);
 }
 
-TH2* THistManager::CreateTH2(const char *name, const char *title, const TArrayD &xbins, const TArrayD &ybins, Option_t *opt){
+THistManager::TH2Handle THistManager::CreateTH2(const char *name, const char *title, const TArrayD &xbins, const TArrayD &ybins, Option_t *opt){
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTH2", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return TH2Handle();
 	}
 	TH2* h = new TH2D(hname, title, xbins.GetSize() - 1, xbins.GetArray(), ybins.GetSize() - 1, ybins.GetArray());
   TString optionstring(opt);
@@ -186,10 +186,10 @@ TH2* THistManager::CreateTH2(const char *name, const char *title, const TArrayD
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return TH2Handle(h);
 }
 
-TH2* THistManager::CreateTH2(const char *name, const char *title, const TBinning &xbins, const TBinning &ybins, Option_t *opt){
+THistManager::TH2Handle THistManager::CreateTH2(const char *name, const char *title, const TBinning &xbins, const TBinning &ybins, Option_t *opt){
   TArrayD myxbins, myybins;
   try{
     xbins.CreateBinEdges(myxbins);
@@ -205,13 +205,13 @@ TH2* THistManager::CreateTH2(const char *name, const char *title, const TBinning
   return CreateTH2(name, title, myxbins, myybins, opt);
 }
 
-TH3* THistManager::CreateTH3(const char* name, const char* title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, int nbinsz, double zmin, double zmax, Option_t *opt) {
+THistManager::TH3Handle THistManager::CreateTH3(const char* name, const char* title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, int nbinsz, double zmin, double zmax, Option_t *opt) {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTH3", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return TH3Handle();
 	}
 	TH3* h = new TH3D(hname, title, nbinsx, xmin, xmax, nbinsy, ymin, ymax, nbinsz, zmin, zmax);
   TString optionstring(opt);
@@ -219,16 +219,16 @@ TH3* THistManager::CreateTH3(const char* name, const char* title, int nbinsx, do
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return TH3Handle(h);
 }
 
-TH3* THistManager::CreateTH3(const char* name, const char* title, int nbinsx, const double* xbins, int nbinsy, const double* ybins, int nbinsz, const double* zbins, Option_t *opt) {
+THistManager::TH3Handle THistManager::CreateTH3(const char* name, const char* title, int nbinsx, const double* xbins, int nbinsy, const double* ybins, int nbinsz, const double* zbins, Option_t *opt) {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTH3", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return TH3Handle();
   }
 	TH3* h = new TH3D(hname, title, nbinsx, xbins, nbinsy, ybins, nbinsz, zbins);
   TString optionstring(opt);
@@ -236,16 +236,16 @@ TH3* THistManager::CreateTH3(const char* name, const char* title, int nbinsx, co
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return TH3Handle(h);
 }
 
-TH3* THistManager::CreateTH3(const char* name, const char* title, const TArrayD& xbins, const TArrayD& ybins, const TArrayD& zbins, Option_t *opt) {
+THistManager::TH3Handle THistManager::CreateTH3(const char* name, const char* title, const TArrayD& xbins, const TArrayD& ybins, const TArrayD& zbins, Option_t *opt) {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTH3", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return TH3Handle();
 	}
 	TH3* h = new TH3D(hname, title, xbins.GetSize()-1, xbins.GetArray(), ybins.GetSize()-1, ybins.GetArray(), zbins.GetSize()-1, zbins.GetArray());
   TString optionstring(opt);
@@ -253,10 +253,10 @@ TH3* THistManager::CreateTH3(const char* name, const char* title, const TArrayD&
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return TH3Handle(h);
 }
 
-TH3* THistManager::CreateTH3(const char *name, const char *title, const TBinning &xbins, const TBinning &ybins, const TBinning &zbins, Option_t *opt){
+THistManager::TH3Handle THistManager::CreateTH3(const char *name, const char *title, const TBinning &xbins, const TBinning &ybins, const TBinning &zbins, Option_t *opt){
   TArrayD myxbins, myybins, myzbins;
   try{
     xbins.CreateBinEdges(myxbins);
@@ -277,13 +277,13 @@ TH3* THistManager::CreateTH3(const char *name, const char *title, const TBinning
   return CreateTH3(name, title, myxbins, myybins, myzbins);
 }
 
-THnSparse* THistManager::CreateTHnSparse(const char *name, const char *title, int ndim, const int *nbins, const double *min, const double *max, Option_t *opt) {
+THistManager::THnSparseHandle THistManager::CreateTHnSparse(const char *name, const char *title, int ndim, const int *nbins, const double *min, const double *max, Option_t *opt) {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTHnSparse", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return THnSparseHandle();
 	}
 	THnSparse* h = new THnSparseD(hname, title, ndim, nbins, min, max);
   TString optionstring(opt);
@@ -291,16 +291,16 @@ THnSparse* THistManager::CreateTHnSparse(const char *name, const char *title, in
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return THnSparseHandle(h);
 }
 
-THnSparse* THistManager::CreateTHnSparse(const char *name, const char *title, int ndim, const TAxis **axes, Option_t *opt) {
+THistManager::THnSparseHandle THistManager::CreateTHnSparse(const char *name, const char *title, int ndim, const TAxis **axes, Option_t *opt) {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTHnSparse", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return THnSparseHandle();
 	}
 	TArrayD xmin(ndim), xmax(ndim);
 	TArrayI nbins(ndim);
@@ -318,16 +318,16 @@ THnSparse* THistManager::CreateTHnSparse(const char *name, const char *title, in
   if(optionstring.Contains("s"))
     hsparse->Sumw2();
 	parent->Add(hsparse);
-	return hsparse;
+	return THnSparseHandle(hsparse);
 }
 
-THnSparse* THistManager::CreateTHnSparse(const char *name, const char *title, int ndim, const TBinning **axes, Option_t *opt){
+THistManager::THnSparseHandle THistManager::CreateTHnSparse(const char *name, const char *title, int ndim, const TBinning **axes, Option_t *opt){
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
   if(parent->FindObject(hname)){
     Fatal("THistManager::CreateTHnSparse", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-    return 0;
+    return THnSparseHandle();
   }
   TArrayD xmin(ndim), xmax(ndim);
   TArrayI nbins(ndim);
@@ -351,10 +351,10 @@ THnSparse* THistManager::CreateTHnSparse(const char *name, const char *title, in
   if(optionstring.Contains("s"))
     hsparse->Sumw2();
   parent->Add(hsparse);
-  return hsparse;
+  return THnSparseHandle(hsparse);
 }
 
-void THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, double xmin, double xmax, Option_t *opt) {
+THistManager::TProfileHandle THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, double xmin, double xmax, Option_t *opt) {
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
@@ -362,9 +362,10 @@ void THistManager::CreateTProfile(const char* name, const char* title, int nbins
 		Fatal("THistManager::CreateTProfile", "Object %s already exists in group %s", hname.Data(), dirname.Data());
   TProfile *hist = new TProfile(hname, title, nbinsX, xmin, xmax, opt);
   parent->Add(hist);
+  return TProfileHandle(hist);
 }
 
-void THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, const double* xbins, Option_t *opt) {
+THistManager::TProfileHandle THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, const double* xbins, Option_t *opt) {
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
@@ -372,9 +373,10 @@ void THistManager::CreateTProfile(const char* name, const char* title, int nbins
 		Fatal("THistManager::CreateTHnSparse", "Object %s already exists in group %s", hname.Data(), dirname.Data());
   TProfile *hist = new TProfile(hname, title, nbinsX, xbins, opt);
   parent->Add(hist);
+  return TProfileHandle(hist);
 }
 
-void THistManager::CreateTProfile(const char* name, const char* title, const TArrayD& xbins, Option_t *opt){
+THistManager::TProfileHandle THistManager::CreateTProfile(const char* name, const char* title, const TArrayD& xbins, Option_t *opt){
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
@@ -382,16 +384,17 @@ void THistManager::CreateTProfile(const char* name, const char* title, const TAr
 		Fatal("THistManager::CreateTHnSparse", "Object %s already exists in group %s", hname.Data(), dirname.Data());
   TProfile *hist = new TProfile(hname.Data(), title, xbins.GetSize()-1, xbins.GetArray(), opt);
   parent->Add(hist);
+  return TProfileHandle(hist);
 }
 
-void THistManager::CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt){
+THistManager::TProfileHandle THistManager::CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt){
   TArrayD myxbins;
   try{
     xbins.CreateBinEdges(myxbins);
   } catch (std::exception &e){
     Fatal("THistManager::CreateProfile", "Exception raised: %s", e.what());
   }
-  CreateTProfile(name, title, myxbins, opt);
+  return CreateTProfile(name, title, myxbins, opt);
 }
 
 void THistManager::SetObject(TObject * const o, const char *group) {
@@ -409,17 +412,8 @@ void THistManager::SetObject(TObject * const o, const char *group) {
 }
 
 void THistManager::FillTH1(const char *name, double x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
+	TH1 *hist = FindHistogramForFill<TH1>(name, "THistManager::FillTH1");
+	if(!hist) return;
 	TString optionstring(opt);
 	if(optionstring.Contains("w")){
 	  // use bin width as weight
@@ -428,21 +422,12 @@ void THistManager::FillTH1(const char *name, double x, double weight, Option_t *
 	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
 	    weight = 1./hist->GetXaxis()->GetBinWidth(bin);
 	}
-	hist->Fill(x, weight);
+	Fill(TH1Handle(hist), x, weight);
 }
 
 void THistManager::FillTH1(const char *name, const char *label, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
-  if(!hist){
-    Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-    return;
-  }
+  TH1 *hist = FindHistogramForFill<TH1>(name, "THistManager::FillTH1");
+  if(!hist) return;
 	TString optionstring(opt);
 	if(optionstring.Contains("w")){
 	  // use bin width as weight
@@ -456,17 +441,8 @@ void THistManager::FillTH1(const char *name, const char *label, double weight, O
 }
 
 void THistManager::FillTH2(const char *name, double x, double y, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
+	TH2 *hist = FindHistogramForFill<TH2>(name, "THistManager::FillTH2");
+	if(!hist) return;
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
@@ -477,21 +453,12 @@ void THistManager::FillTH2(const char *name, double x, double y, double weight,
 	  Int_t biny = hist->GetYaxis()->FindBin(y);
 	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
 	}
-	hist->Fill(x, y, myweight);
+	Fill(TH2Handle(hist), x, y, myweight);
 }
 
 void THistManager::FillTH2(const char *name, double *point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
+	TH2 *hist = FindHistogramForFill<TH2>(name, "THistManager::FillTH2");
+	if(!hist) return;
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
@@ -502,21 +469,12 @@ void THistManager::FillTH2(const char *name, double *point, double weight, Optio
 	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
 	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
 	}
-	hist->Fill(point[0], point[1], weight);
+	Fill(TH2Handle(hist), point[0], point[1], weight);
 }
 
 void THistManager::FillTH2(const char *name, const char *labelX, const char *labelY, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-  if(!hist){
-    Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-    return;
-  }
+  TH2 *hist = FindHistogramForFill<TH2>(name, "THistManager::FillTH2");
+  if(!hist) return;
   TString optstring(opt);
   Double_t myweight = optstring.Contains("w") ? 1. : weight;
   if(optstring.Contains("wx")){
@@ -531,17 +489,8 @@ void THistManager::FillTH2(const char *name, const char *labelX, const char *lab
 }
 
 void THistManager::FillTH3(const char* name, double x, double y, double z, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
+	TH3 *hist = FindHistogramForFill<TH3>(name, "THistManager::FillTH3");
+	if(!hist) return;
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
@@ -556,21 +505,12 @@ void THistManager::FillTH3(const char* name, double x, double y, double z, doubl
 	  Int_t binz = hist->GetZaxis()->FindBin(z);
 	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
 	}
-	hist->Fill(x, y, z, weight);
+	Fill(TH3Handle(hist), x, y, z, weight);
 }
 
 void THistManager::FillTH3(const char* name, const double* point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
+	TH3 *hist = FindHistogramForFill<TH3>(name, "THistManager::FillTH3");
+	if(!hist) return;
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
@@ -585,21 +525,12 @@ void THistManager::FillTH3(const char* name, const double* point, double weight,
 	  Int_t binz = hist->GetZaxis()->FindBin(point[2]);
 	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
 	}
-	hist->Fill(point[0], point[1], point[2], weight);
+	Fill(TH3Handle(hist), point[0], point[1], point[2], weight);
 }
 
 void THistManager::FillTHnSparse(const char *name, const double *x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTHnSparse", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	THnSparseD *hist = dynamic_cast<THnSparseD *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTHnSparse", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
+	THnSparseD *hist = FindHistogramForFill<THnSparseD>(name, "THistManager::FillTHnSparse");
+	if(!hist) return;
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	for(Int_t iaxis = 0; iaxis < hist->GetNdimensions(); iaxis++){
@@ -611,18 +542,13 @@ void THistManager::FillTHnSparse(const char *name, const double *x, double weigh
 	  }
 	}
 
-	hist->Fill(x, weight);
+	Fill(THnSparseHandle(hist), x, weight);
 }
 
 void THistManager::FillProfile(const char* name, double x, double y, double weight){
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent)
-		Fatal("THistManager::FillTProfile", "Parent group %s does not exist", dirname.Data());
-  TProfile *hist = dynamic_cast<TProfile *>(parent->FindObject(hname));
-  if(!hist)
-		Fatal("THistManager::FillTProfile", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-  hist->Fill(x, y, weight);
+  TProfile *hist = FindHistogramForFill<TProfile>(name, "THistManager::FillTProfile");
+  if(!hist) return;
+  Fill(TProfileHandle(hist), x, y, weight);
 }
 
 TObject *THistManager::FindObject(const char *name) const {
@@ -647,6 +573,22 @@ THashList *THistManager::FindGroup(const char *dirname) const {
 	return nullptr;
 }
 
+template<typename HistType>
+HistType *THistManager::FindHistogramForFill(const char *name, const char *caller) const {
+	TString dirname(basename(name)), hname(histname(name));
+	THashList *parent(FindGroup(dirname));
+	if(!parent){
+		Fatal(caller, "Parent group %s does not exist", dirname.Data());
+		return nullptr;
+	}
+	HistType *hist = dynamic_cast<HistType *>(parent->FindObject(hname));
+	if(!hist){
+		Fatal(caller, "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		return nullptr;
+	}
+	return hist;
+}
+
 TString THistManager::basename(const TString &path) const {
 	int index = path.Last('/');
 	if(index < 0) return "";  // no directory structure
@@ -1030,6 +972,77 @@ namespace TestTHistManager {
     return success ? 0 : 1;
   }
 
+  int THistManagerTestSuite::TestFillHandleHistograms(){
+    THistManager testmgr("testmgr");
+
+    THistManager::TH1Handle h1 = testmgr.CreateTH1("Handles/Test1", "Test fill 1D histogram via handle", 1, 0., 1.);
+    THistManager::TH2Handle h2 = testmgr.CreateTH2("Handles/Test2", "Test fill 2D histogram via handle", 1, 0., 1., 1, 0., 1.);
+    THistManager::TH3Handle h3 = testmgr.CreateTH3("Handles/Test3", "Test fill 3D histogram via handle", 1, 0., 1., 1, 0., 1., 1, 0., 1.);
+    int nbins[4] = {1,1,1,1}; double min[4] = {0.,0.,0.,0.}, max[4] = {1.,1.,1.,1.};
+    THistManager::THnSparseHandle hn = testmgr.CreateTHnSparse("Handles/TestN", "Test fill THnSparse via handle", 4, nbins, min, max);
+    THistManager::TProfileHandle hp = testmgr.CreateTProfile("Handles/TestProfile", "Test fill profile via handle", 1, 0., 1.);
+
+    // Handles obtained via lookup must point to the same histograms
+    THistManager::TH1Handle l1 = testmgr.GetHandle<TH1>("Handles/Test1");
+    THistManager::TH2Handle l2 = testmgr.GetHandle<TH2>("Handles/Test2");
+    THistManager::TH3Handle l3 = testmgr.GetHandle<TH3>("Handles/Test3");
+    THistManager::THnSparseHandle ln = testmgr.GetHandle<THnSparse>("Handles/TestN");
+    THistManager::TProfileHandle lp = testmgr.GetHandle<TProfile>("Handles/TestProfile");
+
+    bool success(true);
+    if(!(h1.IsValid() && h2.IsValid() && h3.IsValid() && hn.IsValid() && hp.IsValid())){
+      std::cout << "Invalid handle returned by Create method" << std::endl;
+      return 1;
+    }
+    if(!(l1.IsValid() && l2.IsValid() && l3.IsValid() && ln.IsValid() && lp.IsValid())){
+      std::cout << "Invalid handle returned by GetHandle" << std::endl;
+      return 1;
+    }
+    if(testmgr.GetHandle<TH2>("Handles/Test1").IsValid()){
+      std::cout << "GetHandle returned valid handle for histogram of different type" << std::endl;
+      success = false;
+    }
+
+    double point[4] = {0.5, 0.5, 0.5, 0.5};
+    for(int i = 0; i < 50; i++){
+      testmgr.Fill(h1, 0.5);
+      testmgr.Fill(h2, 0.5, 0.5);
+      testmgr.Fill(h3, 0.5, 0.5, 0.5);
+      testmgr.Fill(hn, point);
+      testmgr.Fill(hp, 0.5, 1.);
+      testmgr.Fill(l1, 0.5);
+      testmgr.Fill(l2, 0.5, 0.5);
+      testmgr.Fill(l3, 0.5, 0.5, 0.5);
+      testmgr.Fill(ln, point);
+      testmgr.Fill(lp, 0.5, 1.);
+    }
+
+    // Evaluate test
+    // tell user why test has failed
+    if(TMath::Abs(h1->GetBinContent(1) - 100) > DBL_EPSILON){
+      std::cout << "Test1: Mismatch in values, expected 100, found " <<  h1->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(h2->GetBinContent(1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Test2: Mismatch in values, expected 100, found " <<  h2->GetBinContent(1, 1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(h3->GetBinContent(1, 1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Test3: Mismatch in values, expected 100, found " <<  h3->GetBinContent(1, 1, 1) << std::endl;
+      success = false;
+    }
+    int binfound[4] = {1, 1, 1, 1};
+    if(TMath::Abs(hn->GetBinContent(binfound) - 100) > DBL_EPSILON){
+      std::cout << "TestN: Mismatch in values, expected 100, found " <<  hn->GetBinContent(binfound) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(hp->GetBinContent(1) - 1) > DBL_EPSILON){
+      std::cout << "TestProfile: Mismatch in values, expected 1, found " <<  hp->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    return success ? 0 : 1;
+  }
+
   int TestRunAll(){
     int testresult(0);
     THistManagerTestSuite testsuite;
@@ -1050,6 +1063,10 @@ namespace TestTHistManager {
     testresult += testsuite.TestFillGroupedHistograms();
     std::cout << "Result after test: " << testresult << std::endl;
 
+    std::cout << "Running test: Fill Handle" << std::endl;
+    testresult += testsuite.TestFillHandleHistograms();
+    std::cout << "Result after test: " << testresult << std::endl;
+
     return testresult;
   }
 
@@ -1072,4 +1089,9 @@ namespace TestTHistManager {
     THistManagerTestSuite testsuite;
     return testsuite.TestFillGroupedHistograms();
   }
+
+  int TestRunFillHandle(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillHandleHistograms();
+  }
 }
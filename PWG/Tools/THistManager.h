@@ -4,19 +4,19 @@
  * See cxx source for full Copyright notice                               */
 
 #include <THashList.h>
+#include <TH1.h>
+#include <TH2.h>
+#include <TH3.h>
+#include <THnSparse.h>
 #include <TIterator.h>
 #include <TNamed.h>
+#include <TProfile.h>
 #include <iterator>
 
 class TArrayD;
 class TAxis;
 class TBinning;
 class TList;
-class TH1;
-class TH2;
-class TH3;
-class THnSparse;
-class TProfile;
 
 /**
  * @defgroup Histmanager
@@ -95,6 +95,31 @@ class TProfile;
  * an argument for options. Automatic correction for the bin width is done when
  * specifying the argument *W*, followed by the direction. Adding multiple directions
  * the weight is calculated for all directions at the same time.
+ *
+ * # Filling histograms via handles
+ *
+ * Filling histograms by name requires to resolve the path of the histogram
+ * inside the group structure, to find the histogram in the hash list and to
+ * interpret the option string for each entry. For histograms filled inside
+ * loops over tracks, clusters or jets this becomes the dominating cost. All
+ * Create methods therefore return a handle to the histogram, which can be
+ * stored by the user (i.e. as data member of the task, marked transient) and
+ * used in the Fill methods taking a handle instead of the histogram name. Filling
+ * via the handle does not need any lookup and costs a single pointer indirection.
+ * Handles to histograms added via SetObject, or in case the handle was not
+ * stored at creation time, can be obtained via GetHandle.
+ *
+ * ~~~{.cxx}
+ * THistManager::TH1Handle hPt = mgr.CreateTH1("hPt", "pt-distribution", TLinearBinning(100, 0., 100.));
+ * for(auto en : ROOT::TSeqI(0, 10000) {
+ *   double pt = gRandom->Exp(-1);
+ *   mgr.Fill(hPt, pt);
+ * }
+ * ~~~
+ *
+ * Handles convert implicitly to the pointer of the underlying histogram, therefore
+ * code using the return value of the Create methods as histogram pointer continues
+ * to work.
  */
 class THistManager : public TNamed {
 public:
@@ -229,6 +254,70 @@ public:
     iterator();
   };
 
+  /**
+   * @class THistHandle
+   * @brief Lightweight handle to a histogram inside the histogram manager
+   * @ingroup Histmanager
+   *
+   * Handles are returned by the Create methods of the histogram manager
+   * and can be used in the handle-based Fill methods in order to avoid
+   * the lookup of the histogram by name. The handle does not own the
+   * histogram, it stays valid as long as the histogram manager owning the
+   * histogram is alive.
+   */
+  template<typename HistType>
+  class THistHandle {
+  public:
+    /**
+     * @brief Default constructor, creating an invalid handle
+     */
+    THistHandle(): fHistogram(nullptr) {}
+
+    /**
+     * @brief Constructor, creating a handle for a given histogram
+     * @param[in] hist Histogram connected to the handle
+     */
+    explicit THistHandle(HistType *hist): fHistogram(hist) {}
+
+    /**
+     * @brief Destructor
+     */
+    ~THistHandle() {}
+
+    /**
+     * @brief Implicit conversion to the histogram pointer
+     * @return Histogram connected to the handle
+     */
+    operator HistType *() const { return fHistogram; }
+
+    /**
+     * @brief Access to the histogram connected to the handle
+     * @return Histogram connected to the handle
+     */
+    HistType *operator->() const { return fHistogram; }
+
+    /**
+     * @brief Get the histogram connected to the handle
+     * @return Histogram connected to the handle
+     */
+    HistType *GetHistogram() const { return fHistogram; }
+
+    /**
+     * @brief Check whether the handle is connected to a histogram
+     * @return True if the handle points to a histogram, false otherwise
+     */
+    bool IsValid() const { return fHistogram != nullptr; }
+
+  private:
+    HistType                    *fHistogram;          ///< Histogram connected to the handle (not owned)
+  };
+
+  typedef THistHandle<TH1> TH1Handle;                 ///< Handle to 1D histograms
+  typedef THistHandle<TH2> TH2Handle;                 ///< Handle to 2D histograms
+  typedef THistHandle<TH3> TH3Handle;                 ///< Handle to 3D histograms
+  typedef THistHandle<THnSparse> THnSparseHandle;     ///< Handle to sparse histograms
+  typedef THistHandle<TProfile> TProfileHandle;       ///< Handle to profile histograms
+
   /**
    * @brief Default constructor.
    *
@@ -277,7 +366,7 @@ public:
 	 * @param xmax max. value of the range
 	 * @param opt Additonal options (s for sumw2)
 	 */
-	TH1* CreateTH1(const char *name, const char *title, int nbins, double xmin, double xmax, Option_t *opt = "");
+	TH1Handle CreateTH1(const char *name, const char *title, int nbins, double xmin, double xmax, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH1 within the container.
@@ -290,7 +379,7 @@ public:
 	 * @param[in] xbins array of bin limits
 	 * @param[in] opt Additonal options (s for sumw2)
 	 */
-	TH1* CreateTH1(const char *name, const char *title, int nbins, const double *xbins, Option_t *opt = "");
+	TH1Handle CreateTH1(const char *name, const char *title, int nbins, const double *xbins, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH1 within the container.
@@ -302,7 +391,7 @@ public:
 	 * @param[in] xbins array of bin limits (contains also number of bins)
 	 * @param[in] opt Additonal options (s for sumw2)
 	 */
-	TH1* CreateTH1(const char *name, const char *title, const TArrayD &xbins, Option_t *opt = "");
+	TH1Handle CreateTH1(const char *name, const char *title, const TArrayD &xbins, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH1 within the container.
@@ -314,7 +403,7 @@ public:
 	 * @param[in] xbins User Binning
 	 * @param[in] opt Additonal options (s for sumw2)
 	 */
-	TH1* CreateTH1(const char *name, const char *title, const TBinning &binning, Option_t *opt = "");
+	TH1Handle CreateTH1(const char *name, const char *title, const TBinning &binning, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH2 within the container.
@@ -330,7 +419,7 @@ public:
 	 * @param[in] ymin min. value of the range in y-direction
 	 * @param[in] ymax max. value of the range in y-direction
 	 */
-	TH2* CreateTH2(const char *name, const char *title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, Option_t *opt = "");
+	TH2Handle CreateTH2(const char *name, const char *title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH2 within the container.
@@ -346,7 +435,7 @@ public:
 	 * @param[in] ymin min. value of the range in y-direction
 	 * @param[in] ymax max. value of the range in y-direction
 	 */
-	TH2* CreateTH2(const char *name, const char *title, int nbinsx, const double *xbins, int nbinsy, const double *ybins, Option_t *opt = "");
+	TH2Handle CreateTH2(const char *name, const char *title, int nbinsx, const double *xbins, int nbinsy, const double *ybins, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH2 within the container.
@@ -358,7 +447,7 @@ public:
 	 * @param[in] xbins array of bin limits in x-direction (contains also the number of bins)
 	 * @param[in] ybins array of bin limits in y-direction (contains also the number of bins)
 	 */
-	TH2* CreateTH2(const char *name, const char *title, const TArrayD &xbins, const TArrayD &ybins, Option_t *opt = "");
+	TH2Handle CreateTH2(const char *name, const char *title, const TArrayD &xbins, const TArrayD &ybins, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH2 within the container.
@@ -370,7 +459,7 @@ public:
 	 * @param[in] User binning in x-direction
 	 * @param[in] User binning in y-direction
 	 */
-	TH2* CreateTH2(const char *name, const char *title, const TBinning &xbins, const TBinning &ybins, Option_t *opt = "");
+	TH2Handle CreateTH2(const char *name, const char *title, const TBinning &xbins, const TBinning &ybins, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH2 within the container.
@@ -386,7 +475,7 @@ public:
 	 * @param[in] ymin min. value of the range in y-direction
 	 * @param[in] ymax max. value of the range in y-direction
 	 */
-	TH3* CreateTH3(const char *name, const char *title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, int nbinsz, double zmin, double zmax, Option_t *opt = "");
+	TH3Handle CreateTH3(const char *name, const char *title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, int nbinsz, double zmin, double zmax, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH3 within the container.
@@ -402,7 +491,7 @@ public:
 	 * @param[in] nbinsz number of bins in z-direction
 	 * @param[in] zbins array of bin limits in z-direction
 	 */
-	TH3* CreateTH3(const char *name, const char *title, int nbinsx, const double *xbins, int nbinsy, const double *ybins, int nbinsz, const double *zbins, Option_t *opt = "");
+	TH3Handle CreateTH3(const char *name, const char *title, int nbinsx, const double *xbins, int nbinsy, const double *ybins, int nbinsz, const double *zbins, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH3 within the container.
@@ -415,7 +504,7 @@ public:
 	 * @param[in] ybins array of bin limits in y-direction (contains also the number of bins)
 	 * @param[in] zbins array of bin limits in z-direction (contains also the number of bins)
 	 */
-	TH3* CreateTH3(const char *name, const char *title, const TArrayD &xbins, const TArrayD &ybins, const TArrayD &zbins, Option_t *opt = "");
+	TH3Handle CreateTH3(const char *name, const char *title, const TArrayD &xbins, const TArrayD &ybins, const TArrayD &zbins, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH3 within the container.
@@ -428,7 +517,7 @@ public:
 	 * @param[in] User binning in y-direction
 	 * @param[in] User binning in z-direction
 	 */
-	TH3* CreateTH3(const char *name, const char *title, const TBinning &xbins, const TBinning &ybins, const TBinning &zbins, Option_t *opt = "");
+	TH3Handle CreateTH3(const char *name, const char *title, const TBinning &xbins, const TBinning &ybins, const TBinning &zbins, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new THnSparse within the container.
@@ -442,7 +531,7 @@ public:
 	 * @param[in] min min. value of the range for each dimension
 	 * @param[in] max max. value of the range for each dimension
 	 */
-	THnSparse* CreateTHnSparse(const char *name, const char *title, int ndim, const int *nbins, const double *min, const double *max, Option_t *opt = "");
+	THnSparseHandle CreateTHnSparse(const char *name, const char *title, int ndim, const int *nbins, const double *min, const double *max, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new THnSparse within the container.
@@ -454,7 +543,7 @@ public:
 	 * @param[in] ndim Number of dimensions
 	 * @param[in] axes Array of pointers to TAxis for containing the axis definition for each dimension
 	 */
-	THnSparse* CreateTHnSparse(const char *name, const char *title, int ndim, const TAxis **axes, Option_t *opt = "");
+	THnSparseHandle CreateTHnSparse(const char *name, const char *title, int ndim, const TAxis **axes, Option_t *opt = "");
 
   /**
    * @brief Create a new THnSparse within the container.
@@ -466,7 +555,7 @@ public:
    * @param[in] ndim Number of dimensions
    * @param[in] axes Array of pointers to TAxis for containing the axis definition for each dimension
    */
-  THnSparse* CreateTHnSparse(const char *name, const char *title, int ndim, const TBinning **axes, Option_t *opt = "");
+  THnSparseHandle CreateTHnSparse(const char *name, const char *title, int ndim, const TBinning **axes, Option_t *opt = "");
 
 
 	/**
@@ -481,7 +570,7 @@ public:
 	 * @param[in] xmax max. value in x-direction
 	 * @param[in] opt Further options
 	 */
-  void CreateTProfile(const char *name, const char *title, int nbinsX, double xmin, double xmax, Option_t *opt = "");
+  TProfileHandle CreateTProfile(const char *name, const char *title, int nbinsX, double xmin, double xmax, Option_t *opt = "");
 
   /**
    * @brief Create a new TProfile within the container.
@@ -494,7 +583,7 @@ public:
    * @param[in] xbins binning in x-direction
    * @param[in] opt Further options
    */
-  void CreateTProfile(const char *name, const char *title, int nbinsX, const double *xbins, Option_t *opt = "");
+  TProfileHandle CreateTProfile(const char *name, const char *title, int nbinsX, const double *xbins, Option_t *opt = "");
 
   /**
    * @brief Create a new TProfile within the container.
@@ -506,7 +595,7 @@ public:
    * @param[in] xbins binning in x-direction
    * @param[in] opt Further options
    */
-  void CreateTProfile(const char *name, const char *title, const TArrayD &xbins, Option_t *opt = "");
+  TProfileHandle CreateTProfile(const char *name, const char *title, const TArrayD &xbins, Option_t *opt = "");
 
   /**
    * @brief Create a new TProfile within the container.
@@ -518,7 +607,7 @@ public:
    * @param[in] xbins User binning
    * @param[in] opt Further options
    */
-  void CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt = "");
+  TProfileHandle CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt = "");
 
   /**
    * @brief Set a new group into the container into the parent group
@@ -634,6 +723,72 @@ public:
 	 */
   void FillProfile(const char *name, double x, double y, double weight = 1.);
 
+  /**
+   * @brief Fill a 1D histogram via its handle.
+   *
+   * No lookup of the histogram is performed.
+   * @param[in] hist Handle of the histogram
+   * @param[in] x x-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void Fill(const TH1Handle &hist, double x, double weight = 1.) { hist->Fill(x, weight); }
+
+  /**
+   * @brief Fill a 2D histogram via its handle.
+   *
+   * No lookup of the histogram is performed.
+   * @param[in] hist Handle of the histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void Fill(const TH2Handle &hist, double x, double y, double weight = 1.) { hist->Fill(x, y, weight); }
+
+  /**
+   * @brief Fill a 3D histogram via its handle.
+   *
+   * No lookup of the histogram is performed.
+   * @param[in] hist Handle of the histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] z z-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void Fill(const TH3Handle &hist, double x, double y, double z, double weight = 1.) { hist->Fill(x, y, z, weight); }
+
+  /**
+   * @brief Fill a nD sparse histogram via its handle.
+   *
+   * No lookup of the histogram is performed.
+   * @param[in] hist Handle of the histogram
+   * @param[in] x coordinates of the data
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void Fill(const THnSparseHandle &hist, const double *x, double weight = 1.) { hist->Fill(x, weight); }
+
+  /**
+   * @brief Fill a profile histogram via its handle.
+   *
+   * No lookup of the histogram is performed.
+   * @param[in] hist Handle of the histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void Fill(const TProfileHandle &hist, double x, double y, double weight = 1.) { hist->Fill(x, y, weight); }
+
+  /**
+   * @brief Get handle to a histogram inside the container.
+   *
+   * The name follows the common group notation. The lookup is
+   * done once, the handle can be used in the handle-based
+   * Fill methods afterwards.
+   * @param[in] name Name of the histogram (including parent groups)
+   * @return Handle to the histogram (invalid if the histogram is not found or of different type)
+   */
+  template<typename HistType>
+  THistHandle<HistType> GetHandle(const char *name) const { return THistHandle<HistType>(dynamic_cast<HistType *>(FindObject(name))); }
+
   /**
    * @brief Create forward iterator starting at the beginning of the
    * container
@@ -695,6 +850,17 @@ private:
 	THistManager(const THistManager &);
 	THistManager &operator=(const THistManager &);
 
+	/**
+	 * @brief Find histogram of a given type for filling.
+	 *
+	 * Fatal is raised in case either the parent group or the
+	 * histogram are not found.
+	 * @param[in] name Name of the histogram (including parent groups)
+	 * @param[in] caller Name of the calling function (for error messages)
+	 * @return Histogram found (NULL if not found)
+	 */
+	template<typename HistType>
+	HistType *FindHistogramForFill(const char *name, const char *caller) const;
 
 	/**
 	 * @brief Find histogram group.
@@ -845,6 +1011,21 @@ public:
    * @return 0 if test is passed, 1 if it failed
    */
   int TestFillGroupedHistograms();
+
+  /**
+   * Purpose of the test: Check whether the handles returned by the Create methods and by GetHandle
+   * fill the same histogram as the name-based Fill methods
+   * Relies on: TestFillSimpleHistograms
+   *
+   * Creating histograms of all types in a group, and filling them 50 times via the handle returned
+   * by the Create method and 50 times via the handle obtained with GetHandle.
+   *
+   * Test passed:
+   * - All handles are valid
+   * - All histograms have in its 1 bin the bin content 100 (mean 1 for the profile)
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillHandleHistograms();
 };
 
 /**
@@ -882,5 +1063,12 @@ int TestRunFillSimple();
  */
 int TestRunFillGrouped();
 
+/**
+ * Run the test for filling histograms via handles. See @ref THistManagerTestSuite
+ * for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunFillHandle();
+
 }
 #endif
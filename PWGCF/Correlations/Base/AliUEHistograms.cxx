@@ -25,6 +25,7 @@
 #include "AliUEHistograms.h"
 
 #include "AliCFContainer.h"
+#include "AliTHn.h"
 #include "AliBasicParticle.h"
 #include "AliVParticle.h"
 #include "AliAODTrack.h"
@@ -37,8 +38,61 @@
 #include "TMath.h"
 #include "TLorentzVector.h"
 
+#include <vector>
+
 ClassImp(AliUEHistograms)
 
+namespace {
+  // structure-of-arrays copy of the properties of a list of particles used in the pair loops of FillCorrelations
+  // this avoids virtual function calls (and casts) for each pair
+  struct AliUEParticleArrays
+  {
+    AliUEParticleArrays() : fN(0), fPt(), fEta(), fPhi(), fCharge(), fFlag(), fObject(), fBasic() { }
+    
+    void Fill(TObjArray* list, Bool_t basicParticles)
+    {
+      fN = list->GetEntriesFast();
+      fPt.resize(fN);
+      fEta.resize(fN);
+      fPhi.resize(fN);
+      fCharge.resize(fN);
+      fFlag.assign(fN, 0);
+      fObject.resize(fN);
+      fBasic.assign(basicParticles ? fN : 0, 0);
+      for (Int_t i=0; i<fN; i++)
+      {
+        AliVParticle* particle = (AliVParticle*) list->UncheckedAt(i);
+        fPt[i] = particle->Pt();
+        fEta[i] = particle->Eta();
+        fPhi[i] = particle->Phi();
+        fCharge[i] = particle->Charge();
+        fObject[i] = particle;
+        if (basicParticles)
+          fBasic[i] = dynamic_cast<AliBasicParticle*>(particle);
+      }
+    }
+    
+    Bool_t HasBasicParticles() const
+    {
+      if ((Int_t) fBasic.size() != fN)
+        return kFALSE;
+      for (Int_t i=0; i<fN; i++)
+        if (!fBasic[i])
+          return kFALSE;
+      return kTRUE;
+    }
+    
+    Int_t fN;                               // number of particles
+    std::vector<Double_t> fPt;              // pt
+    std::vector<Float_t> fEta;              // eta
+    std::vector<Double_t> fPhi;             // phi
+    std::vector<Float_t> fCharge;           // charge
+    std::vector<Char_t> fFlag;              // flag for resonance daughters
+    std::vector<TObject*> fObject;          // original particle
+    std::vector<AliBasicParticle*> fBasic;  // original particle as AliBasicParticle (only if event number check is requested)
+  };
+}
+
 const Int_t AliUEHistograms::fgkUEHists = 3;
 
 AliUEHistograms::AliUEHistograms(const char* name, const char* histograms, const char* binning) : 
@@ -560,6 +614,11 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
   //
   // if mixed is non-0, mixed events are filled, the trigger particle is from particles, the associated from mixed
   // if weight < 0, then the pt of the associated particle is filled as weight
+  //
+  // the particle properties are copied once into contiguous arrays (see AliUEParticleArrays), such that the pair loop does not
+  // call virtual functions. For each trigger particle, the simple pair selections and delta eta, delta phi are evaluated for all
+  // associated particles in one pass, the more expensive pair cuts (conversions, resonances, two-track) only for the remaining pairs.
+  // The per-particle efficiency corrections are looked up once per particle and not once per pair.
   
   Bool_t fillpT = kFALSE;
   if (weight < 0)
@@ -577,18 +636,23 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
     TH1::AddDirectory(oldStatus);
   }
 
-  // Eta() is extremely time consuming, therefore cache it for the inner loop here:
-  TObjArray* input = (mixed) ? mixed : particles;
-  TArrayF eta(input->GetEntriesFast());
-  for (Int_t i=0; i<input->GetEntriesFast(); i++)
-    eta[i] = ((AliVParticle*) input->UncheckedAt(i))->Eta();
-  
   // if particles is not set, just fill event statistics
   if (particles)
   {
-    Int_t jMax = particles->GetEntriesFast();
+    // Eta() is extremely time consuming, therefore cache it (and the other properties) for the loops here
+    AliUEParticleArrays triggers;
+    triggers.Fill(particles, fCheckEventNumberInCorrelation);
+    AliUEParticleArrays mixedArrays;
     if (mixed)
-      jMax = mixed->GetEntriesFast();
+      mixedArrays.Fill(mixed, fCheckEventNumberInCorrelation);
+    AliUEParticleArrays& assoc = (mixed) ? mixedArrays : triggers;
+    
+    if (fCheckEventNumberInCorrelation)
+      if (!triggers.HasBasicParticles() || !assoc.HasBasicParticles())
+        AliFatal("If fCheckEventNumberInCorrelation is set, particle must be derived from AliBasicParticle");
+    
+    const Int_t iMax = triggers.fN;
+    const Int_t jMax = assoc.fN;
     
     TH1* triggerWeighting = 0;
     if (fWeightPerEvent)
@@ -596,12 +660,10 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       TAxis* axis = fNumberDensityPhi->GetTrackHist(AliUEHist::kToward)->GetGrid(0)->GetGrid()->GetAxis(2);
       triggerWeighting = new TH1F("triggerWeighting", "", axis->GetNbins(), axis->GetXbins()->GetArray());
     
-      for (Int_t i=0; i<particles->GetEntriesFast(); i++)
+      for (Int_t i=0; i<iMax; i++)
       {
-	AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
-	
 	// some optimization
-	Float_t triggerEta = triggerParticle->Eta();
+	Float_t triggerEta = triggers.fEta[i];
 
 	if (fTriggerRestrictEta > 0 && TMath::Abs(triggerEta) > fTriggerRestrictEta)
 	  continue;
@@ -613,15 +675,15 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	if (fTriggerSelectCharge != 0)
-	  if (triggerParticle->Charge() * fTriggerSelectCharge < 0)
+	  if (triggers.fCharge[i] * fTriggerSelectCharge < 0)
 	    continue;
 	
-	triggerWeighting->Fill(triggerParticle->Pt());
+	triggerWeighting->Fill(triggers.fPt[i]);
       }
     }
     
     // identify K, Lambda candidates and flag those particles
-    // a TObject bit is used for this
+    // a TObject bit is used for this (in addition to the flag in the particle arrays which is used below)
     const UInt_t kResonanceDaughterFlag = 1 << 14;
     if (fRejectResonanceDaughters > 0)
     {
@@ -638,57 +700,43 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	default: AliFatal(Form("Invalid setting %d", fRejectResonanceDaughters));
       }
 
-      for (Int_t i=0; i<particles->GetEntriesFast(); i++)
+      for (Int_t i=0; i<iMax; i++)
 	particles->UncheckedAt(i)->ResetBit(kResonanceDaughterFlag);
       if (mixed)
 	for (Int_t i=0; i<jMax; i++)
 	  mixed->UncheckedAt(i)->ResetBit(kResonanceDaughterFlag);
       
-      for (Int_t i=0; i<particles->GetEntriesFast(); i++)
+      for (Int_t i=0; i<iMax; i++)
       {
-	AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
-	
 	for (Int_t j=0; j<jMax; j++)
 	{
 	  if (!mixed && i == j)
 	    continue;
 	
-	  AliVParticle* particle = 0;
-	  if (!mixed)
-	    particle = (AliVParticle*) particles->UncheckedAt(j);
-	  else
-	    particle = (AliVParticle*) mixed->UncheckedAt(j);
-	  
 	  // check if both particles point to the same element (does not occur for mixed events, but if subsets are mixed within the same event)
 	  if (fCheckEventNumberInCorrelation)
 	  {
-	    AliBasicParticle* triggerParticleBasic = dynamic_cast<AliBasicParticle*>(triggerParticle);
-	    AliBasicParticle* particleBasic        = dynamic_cast<AliBasicParticle*>(particle);
-	    if(!triggerParticleBasic || !particleBasic)
-	    {
-	      AliFatal("If fCheckEventNumberInCorrelation is set, particle must be derived from AliBasicParticle");
-	      continue;
-	    }
-	
-	    if(triggerParticleBasic->IsInSameEvent(particleBasic))
+	    if (triggers.fBasic[i]->IsInSameEvent(assoc.fBasic[j]))
 	      continue;
 	  }
-	  else if (mixed && triggerParticle->IsEqual(particle))
+	  else if (mixed && triggers.fObject[i]->IsEqual(assoc.fObject[j]))
 	    continue;
 	  
-	  if (triggerParticle->Charge() * particle->Charge() > 0)
+	  if (triggers.fCharge[i] * assoc.fCharge[j] > 0)
 	    continue;
       
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerParticle->Eta(), triggerParticle->Phi(), particle->Pt(), particle->Eta(), particle->Phi(), massDaughter1, massDaughter2);
+	  Float_t mass = GetInvMassSquaredCheap(triggers.fPt[i], triggers.fEta[i], triggers.fPhi[i], assoc.fPt[j], assoc.fEta[j], assoc.fPhi[j], massDaughter1, massDaughter2);
 	      
 	  if (TMath::Abs(mass - resonanceMass*resonanceMass) < interval*5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerParticle->Eta(), triggerParticle->Phi(), particle->Pt(), particle->Eta(), particle->Phi(), massDaughter1, massDaughter2);
+	    mass = GetInvMassSquared(triggers.fPt[i], triggers.fEta[i], triggers.fPhi[i], assoc.fPt[j], assoc.fEta[j], assoc.fPhi[j], massDaughter1, massDaughter2);
 
 	    if (mass > (resonanceMass-interval)*(resonanceMass-interval) && mass < (resonanceMass+interval)*(resonanceMass+interval))
 	    {
-	      triggerParticle->SetBit(kResonanceDaughterFlag);
-	      particle->SetBit(kResonanceDaughterFlag);
+	      triggers.fObject[i]->SetBit(kResonanceDaughterFlag);
+	      assoc.fObject[j]->SetBit(kResonanceDaughterFlag);
+	      triggers.fFlag[i] = 1;
+	      assoc.fFlag[j] = 1;
 	      
 // 	      Printf("Flagged %d %d %f", i, j, TMath::Sqrt(mass));
 	    }
@@ -697,12 +745,50 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       }
     }
     
-    for (Int_t i=0; i<particles->GetEntriesFast(); i++)
+    // efficiency correction of the associated particles (does not depend on the trigger particle)
+    std::vector<Double_t> assocWeight(jMax, weight);
+    for (Int_t j=0; j<jMax; j++)
     {
-      AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
+      if (fillpT)
+        assocWeight[j] = (Float_t) assoc.fPt[j];
       
+      if (applyEfficiency && fEfficiencyCorrectionAssociated)
+      {
+        Int_t effVars[4];
+        effVars[0] = fEfficiencyCorrectionAssociated->GetAxis(0)->FindBin(assoc.fEta[j]);
+        effVars[1] = fEfficiencyCorrectionAssociated->GetAxis(1)->FindBin(assoc.fPt[j]); //pt
+        effVars[2] = fEfficiencyCorrectionAssociated->GetAxis(2)->FindBin(centrality); //centrality
+        effVars[3] = fEfficiencyCorrectionAssociated->GetAxis(3)->FindBin((Double_t) zVtx); //zVtx
+        assocWeight[j] *= fEfficiencyCorrectionAssociated->GetBinContent(effVars);
+      }
+    }
+    
+    // per trigger particle buffers for the pair loop
+    std::vector<Float_t>  pairDEta(jMax);
+    std::vector<Double_t> pairDPhi(jMax);
+    std::vector<Char_t>   pairAccepted(jMax);
+    // variables of the accepted pairs, one array per axis of the track histogram (as needed by AliTHnBase::FillN)
+    const Int_t kNFillVars = 6;
+    std::vector<Double_t> fillVars[kNFillVars];
+    const Double_t* fillVarsPtr[kNFillVars];
+    std::vector<Double_t> fillWeights;
+    for (Int_t k=0; k<kNFillVars; k++)
+      fillVars[k].reserve(jMax);
+    fillWeights.reserve(jMax);
+    
+    // fill all in toward region and do not use the other regions
+    AliCFContainer* trackHist = fNumberDensityPhi->GetTrackHist(AliUEHist::kToward);
+    AliTHnBase* trackHistTHn = dynamic_cast<AliTHnBase*> (trackHist);
+    
+    const Bool_t pairMassCuts = (fCutConversionsV > 0 || fCutResonancesV > 0);
+    
+    for (Int_t i=0; i<iMax; i++)
+    {
       // some optimization
-      Float_t triggerEta = triggerParticle->Eta();
+      const Float_t triggerEta = triggers.fEta[i];
+      const Double_t triggerPt = triggers.fPt[i];
+      const Double_t triggerPhi = triggers.fPhi[i];
+      const Float_t triggerCharge = triggers.fCharge[i];
       
       if (fTriggerRestrictEta > 0 && TMath::Abs(triggerEta) > fTriggerRestrictEta)
 	continue;
@@ -714,155 +800,97 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       }
       
       if (fTriggerSelectCharge != 0)
-	if (triggerParticle->Charge() * fTriggerSelectCharge < 0)
+	if (triggerCharge * fTriggerSelectCharge < 0)
 	  continue;
 	
       if (fRejectResonanceDaughters > 0)
-	if (triggerParticle->TestBit(kResonanceDaughterFlag))
+	if (triggers.fFlag[i])
 	{
 // 	  Printf("Skipped i=%d", i);
 	  continue;
 	}
 	
+      // weight factors which only depend on the trigger particle
+      Double_t triggerEfficiency = 1;
+      if (applyEfficiency && fEfficiencyCorrectionTriggers)
+      {
+        Int_t effVars[4];
+
+        effVars[0] = fEfficiencyCorrectionTriggers->GetAxis(0)->FindBin(triggerEta);
+        effVars[1] = fEfficiencyCorrectionTriggers->GetAxis(1)->FindBin(triggerPt); //pt
+        effVars[2] = fEfficiencyCorrectionTriggers->GetAxis(2)->FindBin(centrality); //centrality
+        effVars[3] = fEfficiencyCorrectionTriggers->GetAxis(3)->FindBin((Double_t) zVtx); //zVtx
+        triggerEfficiency = fEfficiencyCorrectionTriggers->GetBinContent(effVars);
+      }
+      Double_t triggerEventWeight = 1;
+      if (fWeightPerEvent)
+      {
+        Int_t weightBin = triggerWeighting->GetXaxis()->FindBin(triggerPt);
+        triggerEventWeight = triggerWeighting->GetBinContent(weightBin);
+      }
+      
+      // first pass over all associated particles: delta eta, delta phi and the selections which do not need the pair mass
+      // (no branches, such that this loop can be vectorized)
       for (Int_t j=0; j<jMax; j++)
       {
-        if (!mixed && i == j)
-          continue;
+        const Float_t chargeProduct = triggerCharge * assoc.fCharge[j];
+        const Float_t eta = assoc.fEta[j];
+        
+        Bool_t accept = (mixed || i != j);
+        accept &= !(fPtOrder && assoc.fPt[j] >= triggerPt);
+        accept &= !(fAssociatedSelectCharge != 0 && assoc.fCharge[j] * fAssociatedSelectCharge < 0);
+        accept &= !(fSelectCharge == 1 && chargeProduct > 0); // skip like sign
+        accept &= !(fSelectCharge == 2 && chargeProduct < 0); // skip unlike sign
+        accept &= !(fOnlyOneAssocEtaSide != 0 && fOnlyOneAssocEtaSide * eta < 0);
+        accept &= !(fEtaOrdering && ((triggerEta < 0 && eta < triggerEta) || (triggerEta > 0 && eta > triggerEta)));
+        accept &= !(fRejectResonanceDaughters > 0 && assoc.fFlag[j]);
+        pairAccepted[j] = accept;
+        
+        pairDEta[j] = triggerEta - eta;
+        
+        Double_t dphi = triggerPhi - assoc.fPhi[j];
+        if (dphi > 1.5 * TMath::Pi()) 
+          dphi -= TMath::TwoPi();
+        if (dphi < -0.5 * TMath::Pi())
+          dphi += TMath::TwoPi();
+        pairDPhi[j] = dphi;
+      }
       
-        AliVParticle* particle = 0;
-        if (!mixed)
-          particle = (AliVParticle*) particles->UncheckedAt(j);
-        else
-          particle = (AliVParticle*) mixed->UncheckedAt(j);
+      // second pass over the remaining pairs
+      for (Int_t k=0; k<kNFillVars; k++)
+        fillVars[k].clear();
+      fillWeights.clear();
+      for (Int_t j=0; j<jMax; j++)
+      {
+        if (!pairAccepted[j])
+          continue;
         
         // check if both particles point to the same element (does not occur for mixed events, but if subsets are mixed within the same event)
         if (fCheckEventNumberInCorrelation)
         {
-          AliBasicParticle* triggerParticleBasic = dynamic_cast<AliBasicParticle*>(triggerParticle);
-          AliBasicParticle* particleBasic        = dynamic_cast<AliBasicParticle*>(particle);
-          if(!triggerParticleBasic || !particleBasic)
-            AliFatal("If fCheckEventNumberInCorrelation is set, particle must be derived from AliBasicParticle");
-      
-          if(triggerParticleBasic->IsInSameEvent(particleBasic))
+          if (triggers.fBasic[i]->IsInSameEvent(assoc.fBasic[j]))
             continue;
         }
-        else if (mixed && triggerParticle->IsEqual(particle))
+        else if (mixed && triggers.fObject[i]->IsEqual(assoc.fObject[j]))
           continue;
         
-        if (fPtOrder)
-	  if (particle->Pt() >= triggerParticle->Pt())
-	    continue;
-	
-	if (fAssociatedSelectCharge != 0)
-	  if (particle->Charge() * fAssociatedSelectCharge < 0)
-	    continue;
-
-        if (fSelectCharge > 0)
-        {
-          // skip like sign
-          if (fSelectCharge == 1 && particle->Charge() * triggerParticle->Charge() > 0)
-            continue;
-            
-          // skip unlike sign
-          if (fSelectCharge == 2 && particle->Charge() * triggerParticle->Charge() < 0)
-            continue;
-        }
-        
-        if (fOnlyOneAssocEtaSide != 0)
-          if (fOnlyOneAssocEtaSide * eta[j] < 0)
-            continue;
-
-	if (fEtaOrdering)
-	{
-	  if (triggerEta < 0 && eta[j] < triggerEta)
-	    continue;
-	  if (triggerEta > 0 && eta[j] > triggerEta)
-	    continue;
-	}
-
-	if (fRejectResonanceDaughters > 0)
-	  if (particle->TestBit(kResonanceDaughterFlag))
-	  {
-// 	    Printf("Skipped j=%d", j);
-	    continue;
-	  }
-
-	// conversions
-	if (fCutConversionsV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
-	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
-	  
-	  if (mass < fCutConversionsV * 5)
-	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
-	    
-	    fControlConvResoncances->Fill(0.0, mass);
-
-	    if (mass < fCutConversionsV*fCutConversionsV) 
-	      continue;
-	  }
-	}
-	
-	// K0s
-	if (fCutResonancesV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
-	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
-	  
-	  const Float_t kK0smass = 0.4976;
-	  
-	  if (TMath::Abs(mass - kK0smass*kK0smass) < fCutResonancesV * 5)
-	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
-	    
-	    fControlConvResoncances->Fill(1, mass - kK0smass*kK0smass);
-
-	    if (mass > (kK0smass-fCutResonancesV)*(kK0smass-fCutResonancesV) && mass < (kK0smass+fCutResonancesV)*(kK0smass+fCutResonancesV))
-	      continue;
-	  }
-	}
-	
-	// Lambda
-	if (fCutResonancesV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
-	{
-	  Float_t mass1 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
-	  Float_t mass2 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
-	  
-	  const Float_t kLambdaMass = 1.115;
-
-	  if (TMath::Abs(mass1 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
-	  {
-	    mass1 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
-
-	    fControlConvResoncances->Fill(2, mass1 - kLambdaMass*kLambdaMass);
-	    
-	    if (mass1 > (kLambdaMass-fCutResonancesV)*(kLambdaMass-fCutResonancesV) && mass1 < (kLambdaMass+fCutResonancesV)*(kLambdaMass+fCutResonancesV))
-	      continue;
-	  }
-	  if (TMath::Abs(mass2 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
-	  {
-	    mass2 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
-
-	    fControlConvResoncances->Fill(2, mass2 - kLambdaMass*kLambdaMass);
-
-	    if (mass2 > (kLambdaMass-fCutResonancesV)*(kLambdaMass-fCutResonancesV) && mass2 < (kLambdaMass+fCutResonancesV)*(kLambdaMass+fCutResonancesV))
-	      continue;
-	  }
-	}
+        if (pairMassCuts && triggerCharge * assoc.fCharge[j] < 0 && IsPairRemovedByMassCuts(triggerPt, triggerEta, triggerPhi, assoc.fPt[j], assoc.fEta[j], assoc.fPhi[j]))
+          continue;
 
 	if (twoTrackEfficiencyCut)
 	{
 	  // the variables & cuthave been developed by the HBT group 
 	  // see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
 
-	  Float_t phi1 = triggerParticle->Phi();
-	  Float_t pt1 = triggerParticle->Pt();
-	  Float_t charge1 = triggerParticle->Charge();
+	  Float_t phi1 = triggerPhi;
+	  Float_t pt1 = triggerPt;
+	  Float_t charge1 = triggerCharge;
 	    
-	  Float_t phi2 = particle->Phi();
-	  Float_t pt2 = particle->Pt();
-	  Float_t charge2 = particle->Charge();
+	  Float_t phi2 = assoc.fPhi[j];
+	  Float_t pt2 = assoc.fPt[j];
+	  Float_t charge2 = assoc.fCharge[j];
 	      
-	  Float_t deta = triggerEta - eta[j];
+	  Float_t deta = pairDEta[j];
 	      
 	  // optimization
 	  if (TMath::Abs(deta) < twoTrackEfficiencyCutValue * 2.5 * 3)
@@ -903,102 +931,69 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  }
 	}
         
-        Double_t vars[6];
-        vars[0] = triggerEta - eta[j];
-        vars[1] = particle->Pt();
-        vars[2] = triggerParticle->Pt();
-        vars[3] = centrality;
-        vars[4] = triggerParticle->Phi() - particle->Phi();
-        if (vars[4] > 1.5 * TMath::Pi()) 
-          vars[4] -= TMath::TwoPi();
-        if (vars[4] < -0.5 * TMath::Pi())
-          vars[4] += TMath::TwoPi();
-	vars[5] = zVtx;
+        fillVars[0].push_back(pairDEta[j]);
+        fillVars[1].push_back(assoc.fPt[j]);
+        fillVars[2].push_back(triggerPt);
+        fillVars[3].push_back(centrality);
+        fillVars[4].push_back(pairDPhi[j]);
+        fillVars[5].push_back(zVtx);
 	
-	if (fillpT)
-	  weight = particle->Pt();
-	
-	Double_t useWeight = weight;
-	if (applyEfficiency)
-	{
-	  if (fEfficiencyCorrectionAssociated)
-	  {
-	    Int_t effVars[4];
-	    // associated particle
-	    effVars[0] = fEfficiencyCorrectionAssociated->GetAxis(0)->FindBin(eta[j]);
-	    effVars[1] = fEfficiencyCorrectionAssociated->GetAxis(1)->FindBin(vars[1]); //pt
-	    effVars[2] = fEfficiencyCorrectionAssociated->GetAxis(2)->FindBin(vars[3]); //centrality
-	    effVars[3] = fEfficiencyCorrectionAssociated->GetAxis(3)->FindBin(vars[5]); //zVtx
-	    
-	    // 	  Printf("%d %d %d %d %f", effVars[0], effVars[1], effVars[2], effVars[3], fEfficiencyCorrectionAssociated->GetBinContent(effVars));
-	  
-	    useWeight *= fEfficiencyCorrectionAssociated->GetBinContent(effVars);
-	  }
-	  if (fEfficiencyCorrectionTriggers)
-	  {
-	    Int_t effVars[4];
-
-	    effVars[0] = fEfficiencyCorrectionTriggers->GetAxis(0)->FindBin(triggerEta);
-	    effVars[1] = fEfficiencyCorrectionTriggers->GetAxis(1)->FindBin(vars[2]); //pt
-	    effVars[2] = fEfficiencyCorrectionTriggers->GetAxis(2)->FindBin(vars[3]); //centrality
-	    effVars[3] = fEfficiencyCorrectionTriggers->GetAxis(3)->FindBin(vars[5]); //zVtx
-	    useWeight *= fEfficiencyCorrectionTriggers->GetBinContent(effVars);
-	  }
-	}
-
+	Double_t useWeight = assocWeight[j];
+	useWeight *= triggerEfficiency;
 	if (fWeightPerEvent)
-	{
-	  Int_t weightBin = triggerWeighting->GetXaxis()->FindBin(vars[2]);
-// 	  Printf("Using weight %f", triggerWeighting->GetBinContent(weightBin));
-	  useWeight /= triggerWeighting->GetBinContent(weightBin);
-	}
-    
-        // fill all in toward region and do not use the other regions
-	fNumberDensityPhi->GetTrackHist(AliUEHist::kToward)->Fill(vars, step, useWeight);
-
-// 	Printf("%.2f %.2f --> %.2f", triggerEta, eta[j], vars[0]);
+	  useWeight /= triggerEventWeight;
+	fillWeights.push_back(useWeight);
+      }
+      
+      const Int_t nFill = fillWeights.size();
+      if (nFill > 0)
+      {
+        for (Int_t k=0; k<kNFillVars; k++)
+          fillVarsPtr[k] = &fillVars[k][0];
+        
+        if (trackHistTHn)
+          trackHistTHn->FillN(nFill, fillVarsPtr, step, &fillWeights[0]);
+        else
+        {
+          Double_t vars[kNFillVars];
+          for (Int_t l=0; l<nFill; l++)
+          {
+            for (Int_t k=0; k<kNFillVars; k++)
+              vars[k] = fillVarsPtr[k][l];
+            trackHist->Fill(vars, step, fillWeights[l]);
+          }
+        }
       }
  
       if (firstTime)
       {
         // once per trigger particle
         Double_t vars[3];
-        vars[0] = triggerParticle->Pt();
+        vars[0] = triggerPt;
         vars[1] = centrality;
 	vars[2] = zVtx;
 
 	Double_t useWeight = 1;
 	if (fEfficiencyCorrectionTriggers && applyEfficiency)
-	{
-	  Int_t effVars[4];
-	  
-	  // trigger particle
-	  effVars[0] = fEfficiencyCorrectionTriggers->GetAxis(0)->FindBin(triggerEta);
-	  effVars[1] = fEfficiencyCorrectionTriggers->GetAxis(1)->FindBin(vars[0]); //pt
-	  effVars[2] = fEfficiencyCorrectionTriggers->GetAxis(2)->FindBin(vars[1]); //centrality
-	  effVars[3] = fEfficiencyCorrectionTriggers->GetAxis(3)->FindBin(vars[2]); //zVtx
-	  useWeight *= fEfficiencyCorrectionTriggers->GetBinContent(effVars);
-	}
+	  useWeight *= triggerEfficiency;
 
-	if (TMath::Abs(triggerEta) < 0.8 && triggerParticle->Pt() > 0)
-	  fInvYield2->Fill(centrality, triggerParticle->Pt(), useWeight / triggerParticle->Pt());
+	if (TMath::Abs(triggerEta) < 0.8 && triggerPt > 0)
+	  fInvYield2->Fill(centrality, triggerPt, useWeight / triggerPt);
 
 	if (fWeightPerEvent)
 	{
 	  // leads effectively to a filling of one entry per filled trigger particle pT bin
-	  Int_t weightBin = triggerWeighting->GetXaxis()->FindBin(vars[0]);
-// 	  Printf("Using weight %f", triggerWeighting->GetBinContent(weightBin));
-	  useWeight /= triggerWeighting->GetBinContent(weightBin);
+	  useWeight /= triggerEventWeight;
 	}
 	
         fNumberDensityPhi->GetEventHist()->Fill(vars, step, useWeight);
 
 	// QA
-        fCorrelationpT->Fill(centrality, triggerParticle->Pt());
+        fCorrelationpT->Fill(centrality, triggerPt);
         fCorrelationEta->Fill(centrality, triggerEta);
-        fCorrelationPhi->Fill(centrality, triggerParticle->Phi());
-	fYields->Fill(centrality, triggerParticle->Pt(), triggerEta);
-	fYieldsEtaPhiPT->Fill(triggerParticle->Pt(), triggerEta, triggerParticle->Phi());
+        fCorrelationPhi->Fill(centrality, triggerPhi);
+	fYields->Fill(centrality, triggerPt, triggerEta);
+	fYieldsEtaPhiPT->Fill(triggerPt, triggerEta, triggerPhi);
 	
 /*        if (dynamic_cast<AliAODTrack*>(triggerParticle))
           fITSClusterMap->Fill(((AliAODTrack*) triggerParticle)->GetITSClusterMap(), centrality, triggerParticle->Pt());*/
@@ -1016,6 +1011,77 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
   fCentralityCorrelation->Fill(centrality, particles->GetEntriesFast());
   FillEvent(centrality, step);
 }
+
+//____________________________________________________________________
+Bool_t AliUEHistograms::IsPairRemovedByMassCuts(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2)
+{
+  // checks the cuts on conversions and resonances (K0s, Lambda) for an unlike-sign pair
+  // returns kTRUE if the pair has to be removed
+  
+  // conversions
+  if (fCutConversionsV > 0)
+  {
+    Float_t mass = GetInvMassSquaredCheap(pt1, eta1, phi1, pt2, eta2, phi2, 0.510e-3, 0.510e-3);
+    
+    if (mass < fCutConversionsV * 5)
+    {
+      mass = GetInvMassSquared(pt1, eta1, phi1, pt2, eta2, phi2, 0.510e-3, 0.510e-3);
+      
+      fControlConvResoncances->Fill(0.0, mass);
+
+      if (mass < fCutConversionsV*fCutConversionsV) 
+        return kTRUE;
+    }
+  }
+  
+  // K0s
+  if (fCutResonancesV > 0)
+  {
+    Float_t mass = GetInvMassSquaredCheap(pt1, eta1, phi1, pt2, eta2, phi2, 0.1396, 0.1396);
+    
+    const Float_t kK0smass = 0.4976;
+    
+    if (TMath::Abs(mass - kK0smass*kK0smass) < fCutResonancesV * 5)
+    {
+      mass = GetInvMassSquared(pt1, eta1, phi1, pt2, eta2, phi2, 0.1396, 0.1396);
+      
+      fControlConvResoncances->Fill(1, mass - kK0smass*kK0smass);
+
+      if (mass > (kK0smass-fCutResonancesV)*(kK0smass-fCutResonancesV) && mass < (kK0smass+fCutResonancesV)*(kK0smass+fCutResonancesV))
+        return kTRUE;
+    }
+  }
+  
+  // Lambda
+  if (fCutResonancesV > 0)
+  {
+    Float_t mass1 = GetInvMassSquaredCheap(pt1, eta1, phi1, pt2, eta2, phi2, 0.1396, 0.9383);
+    Float_t mass2 = GetInvMassSquaredCheap(pt1, eta1, phi1, pt2, eta2, phi2, 0.9383, 0.1396);
+    
+    const Float_t kLambdaMass = 1.115;
+
+    if (TMath::Abs(mass1 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
+    {
+      mass1 = GetInvMassSquared(pt1, eta1, phi1, pt2, eta2, phi2, 0.1396, 0.9383);
+
+      fControlConvResoncances->Fill(2, mass1 - kLambdaMass*kLambdaMass);
+      
+      if (mass1 > (kLambdaMass-fCutResonancesV)*(kLambdaMass-fCutResonancesV) && mass1 < (kLambdaMass+fCutResonancesV)*(kLambdaMass+fCutResonancesV))
+        return kTRUE;
+    }
+    if (TMath::Abs(mass2 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
+    {
+      mass2 = GetInvMassSquared(pt1, eta1, phi1, pt2, eta2, phi2, 0.9383, 0.1396);
+
+      fControlConvResoncances->Fill(2, mass2 - kLambdaMass*kLambdaMass);
+
+      if (mass2 > (kLambdaMass-fCutResonancesV)*(kLambdaMass-fCutResonancesV) && mass2 < (kLambdaMass+fCutResonancesV)*(kLambdaMass+fCutResonancesV))
+        return kTRUE;
+    }
+  }
+  
+  return kFALSE;
+}
   
 //____________________________________________________________________
 void AliUEHistograms::FillTrackingEfficiency(TObjArray* mc, TObjArray* recoPrim, TObjArray* recoAll, TObjArray* recoPrimPID, TObjArray* recoAllPID, TObjArray* fake, Int_t particleType, Double_t centrality, Double_t zVtx)
@@ -446,7 +446,8 @@ void AliAnalysisTaskEventMixingBF::UserExecMix(Option_t *)
       
       if(fUseOfflineTrigger){
        	isSelectedMain = ((AliInputEventHandler*)(AliAnalysisManager::GetAnalysisManager()->GetInputEventHandler()))->IsEventSelected();
-	isSelectedMix = ((AliInputEventHandler*)((AliMultiInputEventHandler *)(AliAnalysisManager::GetAnalysisManager()->GetInputEventHandler()))->GetFirstMultiInputHandler())->IsEventSelected();
+	// the input handler is not filled for events from the mixing cache (selected when added to the pool)
+	if(!mixIEH->IsUsingMixEventCache()) isSelectedMix = ((AliInputEventHandler*)((AliMultiInputEventHandler *)(AliAnalysisManager::GetAnalysisManager()->GetInputEventHandler()))->GetFirstMultiInputHandler())->IsEventSelected();
       }
       
       if(isSelectedMain && isSelectedMix) {
@@ -683,9 +684,7 @@ AliMixInputEventHandler *AliAnalysisTaskEventMixingBF::SetupEventsForMixing() {
       AliInputEventHandler      *ihMainCurrent     = inEvHMain->GetFirstInputEventHandler();
       fMainEvent = ihMainCurrent->GetEvent();
 
-      AliMultiInputEventHandler *inEvHMixedCurrent = mixEH->GetFirstMultiInputHandler(); // for buffer = 1
-      AliInputEventHandler      *ihMixedCurrent    = inEvHMixedCurrent->GetFirstInputEventHandler();
-      fMixEvent                                    = ihMixedCurrent->GetEvent();
+      fMixEvent = mixEH->GetMixedEvent(0); // for buffer = 1 (also events from the mixing cache)
       
       return mixEH;
   }
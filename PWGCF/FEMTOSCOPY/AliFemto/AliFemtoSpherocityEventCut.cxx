@@ -25,7 +25,8 @@ AliFemtoSpherocityEventCut::AliFemtoSpherocityEventCut():
   fAcceptOnlyPhysics(0),
   fSoCutMin(0.0),
   fSoCutMax(1.0),
-  fSelectTrigger(0)
+  fSelectTrigger(0),
+  fEventShape()
 {
   // Default constructor
   fEventMult[0] = 0;
@@ -51,8 +52,8 @@ bool AliFemtoSpherocityEventCut::Pass(const AliFemtoEvent* event)
   int mult = (int) event->UncorrectedNumberOfPrimaries();
   double vertexZPos = event->PrimVertPos().z();
   double spherocity = -10;
-  int MULT = 0;
 
+  fEventShape.Clear();
   AliFemtoTrackCollection *tracks = event->TrackCollection();
   for (AliFemtoTrackIterator iter = tracks->begin(); iter != tracks->end(); iter++) {
 
@@ -62,73 +63,16 @@ bool AliFemtoSpherocityEventCut::Pass(const AliFemtoEvent* event)
       continue;
     }
 
-    MULT++;
+    fEventShape.AddTrack(NewPt, (*iter)->P().Phi());
 
   }
   //if(SumPt==0){return kFALSE;}
-  if (MULT < 3) {
+  if (fEventShape.GetNTracks() < 3) {
     return kFALSE;
   }
 
-  Double_t *pxA = new Double_t[MULT]();
-  Double_t *pyA = new Double_t[MULT]();
-
-  Double_t sumapt = 0;
-  Int_t counter = 0;
-
-  AliFemtoTrackCollection *tracks2 = event->TrackCollection();
-  for (AliFemtoTrackIterator iter2 = tracks2->begin(); iter2 != tracks2->end(); iter2++) {
-
-    Double_t NewPt2 = (*iter2)->Pt();
-    Double_t NewPhi2 = (*iter2)->P().Phi();
-    Double_t NewEta2 = (*iter2)->P().PseudoRapidity();
-    if (TMath::Abs(NewEta2) > 0.8 || NewPt2 < 0.5) {
-      continue;
-    }
-
-    Double_t Px;
-    Double_t Py;
-
-    Px= NewPt2 * TMath::Cos(NewPhi2);
-    Py= NewPt2 * TMath::Sin(NewPhi2);
-
-    pxA[counter] = Px;
-    pyA[counter] = Py;
-    sumapt += NewPt2;
-    counter++;
-  }
-
-  Double_t pFull = 0;
-  Double_t Spherocity = 2;
-  //Getting thrust
-  for (Int_t i = 0; i < 360; ++i) {
-    Double_t numerador = 0;
-    Double_t phiparam  = 0;
-    Double_t nx = 0;
-    Double_t ny = 0;
-    phiparam = ((TMath::Pi()) * i) / 180; // parametrization of the angle
-    nx = TMath::Cos(phiparam);            // x component of an unitary vector n
-    ny = TMath::Sin(phiparam);            // y component of an unitary vector n
-    for (Int_t i1 = 0; i1 < MULT; ++i1) {
-      numerador += TMath::Abs(ny * pxA[i1] - nx * pyA[i1]);//product between momentum proyection in XY plane and the unitari vector.
-    }
-    pFull = TMath::Power(numerador / sumapt, 2);
-    if (pFull < Spherocity) {//maximization of pFull
-      Spherocity = pFull;
-    }
-  }
-
-
-  spherocity=((Spherocity)*TMath::Pi()*TMath::Pi())/4.0;
-
-  if (pxA) {// clean up array memory used for TMath::Sort
-    delete[] pxA;
-    pxA = 0;
-  }
-  if (pyA) {// clean up array memory used for TMath::Sort
-    delete[] pyA;
-    pyA = 0;
-  }
+  // exact minimum over the axes, see AliEventShapeCalculator
+  spherocity = fEventShape.GetSpherocity();
 
   if(spherocity>fSoCutMax || spherocity<fSoCutMin) {
     //cout<<" Event kicked out !"<<"SoCutMax= "<<fSoCutMax<<"  SoCutMin= "<<fSoCutMin<<endl;
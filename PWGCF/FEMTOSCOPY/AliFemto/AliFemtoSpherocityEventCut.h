@@ -8,6 +8,7 @@
 #define AliFemtoSpherocityEventCUT_H
 
 #include "AliFemtoEventCut.h"
+#include "AliEventShapeCalculator.h"
 
 class AliFemtoSpherocityEventCut : public AliFemtoEventCut {
 
@@ -48,10 +49,11 @@ private:   // here are the quantities I want to cut on...
   double fSoCutMin;        ///< transverse sphericity minimum
   double fSoCutMax;        ///< transverse sphericity maximum
   int  fSelectTrigger;     ///< If set, only given trigger will be selected
+  AliEventShapeCalculator fEventShape; //!<! tracks of the current event for the spherocity
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
-  ClassDef(AliFemtoSpherocityEventCut, 1);
+  ClassDef(AliFemtoSpherocityEventCut, 2);
   /// \endcond
 #endif
 
@@ -74,7 +76,8 @@ inline AliFemtoSpherocityEventCut::AliFemtoSpherocityEventCut(const AliFemtoSphe
   fAcceptOnlyPhysics(c.fAcceptOnlyPhysics),
   fSoCutMin(c.fSoCutMin),
   fSoCutMax(c.fSoCutMax),
-  fSelectTrigger(c.fSelectTrigger)
+  fSelectTrigger(c.fSelectTrigger),
+  fEventShape()
 {
   fEventMult[0] = c.fEventMult[0];
   fEventMult[1] = c.fEventMult[1];
@@ -71,6 +71,9 @@ The names are available via the function PairClassName(Int_t i)
 #include "AliDielectronV0Cuts.h"
 #include "AliDielectronPID.h"
 #include "AliDielectronHistos.h"
+#include "AliDielectronVarCuts.h"
+#include "AliDielectronEventCuts.h"
+#include "AliDielectronCutGroup.h"
 
 #include "AliDielectron.h"
 
@@ -340,14 +343,76 @@ void AliDielectron::Init()
   }
 
   if(fHistos) {
-    (*fUsedVars)|= (*fHistos->GetUsedVars());
-
     // Initialisation of AliDielectronEvtVsTrkHist
     if(fHistos->GetHistogramList()->FindObject("EvtVsTrk")){
       fEvtVsTrkHist = new AliDielectronEvtVsTrkHist("EvtVsTrkHistos", "EvtVsTrkHistos");
       fEvtVsTrkHist->SetHistogramList(fHistos);
     }
   }
+
+  CollectUsedVars();
+}
+
+//________________________________________________________________
+void AliDielectron::CollectUsedVars()
+{
+  //
+  // Build the fill map of this instance from all registered cuts, histograms,
+  // CF container and mixing handler, plus the variables they depend on.
+  // The map is used for the event data and for all variables filled by this class
+  //
+  if (fHistos)        (*fUsedVars)|= (*fHistos->GetUsedVars());
+  if (fHistoArray)    (*fUsedVars)|= (*fHistoArray->GetUsedVars());
+  if (fCfManagerPair) (*fUsedVars)|= (*fCfManagerPair->GetUsedVars());
+  if (fMixing) {
+    for (Int_t i=0; i<fMixing->GetNumberOfVariables(); ++i) fUsedVars->SetBitNumber(fMixing->GetVariable(i),kTRUE);
+  }
+
+  AddUsedVars(fEventFilter.GetCuts());
+  AddUsedVars(fTrackFilter.GetCuts());
+  AddUsedVars(fPairPreFilter1.GetCuts());
+  AddUsedVars(fPairPreFilter2.GetCuts());
+  AddUsedVars(fPairPreFilterLegs1.GetCuts());
+  AddUsedVars(fPairPreFilterLegs2.GetCuts());
+  AddUsedVars(fPairFilter.GetCuts());
+  AddUsedVars(fEventPlanePreFilter.GetCuts());
+  AddUsedVars(fEventPlanePOIPreFilter.GetCuts());
+
+  AliDielectronVarManager::AddDependencies(fUsedVars,fLegEffMap,fPairEffMap);
+  AliDebug(1,Form("%s: %u variables in the fill map",GetName(),fUsedVars->CountBits()));
+}
+
+//________________________________________________________________
+void AliDielectron::AddUsedVars(const TList *cuts)
+{
+  //
+  // Add the variables used by a list of cuts to the fill map
+  //
+  if (!cuts) return;
+  TIter nextCut(cuts);
+  while (AliAnalysisCuts *cut=static_cast<AliAnalysisCuts*>(nextCut())) AddUsedVars(cut);
+}
+
+//________________________________________________________________
+void AliDielectron::AddUsedVars(AliAnalysisCuts *cut)
+{
+  //
+  // Add the variables used by a cut to the fill map, descending into
+  // pair leg cuts and cut groups
+  //
+  if (!cut) return;
+  TBits *used=0x0;
+  if      (AliDielectronVarCuts   *varCuts  =dynamic_cast<AliDielectronVarCuts*>(cut))   used=varCuts->GetUsedVars();
+  else if (AliDielectronPID       *pidCuts  =dynamic_cast<AliDielectronPID*>(cut))       used=pidCuts->GetUsedVars();
+  else if (AliDielectronEventCuts *eventCuts=dynamic_cast<AliDielectronEventCuts*>(cut)) used=eventCuts->GetUsedVars();
+  else if (AliDielectronPairLegCuts *legCuts=dynamic_cast<AliDielectronPairLegCuts*>(cut)) {
+    AddUsedVars(legCuts->GetLeg1Filter().GetCuts());
+    AddUsedVars(legCuts->GetLeg2Filter().GetCuts());
+  }
+  else if (AliDielectronCutGroup *group=dynamic_cast<AliDielectronCutGroup*>(cut)) {
+    for (Int_t iCut=0; iCut<group->GetNCuts(); ++iCut) AddUsedVars(const_cast<AliAnalysisCuts*>(group->GetCut(iCut)));
+  }
+  if (used) (*fUsedVars)|= (*used);
 }
 
 //________________________________________________________________
@@ -420,9 +485,11 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
   if(fPostPIDCntrdCorrTOF)  AliDielectronPID::SetCentroidCorrFunctionTOF(fPostPIDCntrdCorrTOF);
   if(fPostPIDWdthCorrTOF)   AliDielectronPID::SetWidthCorrFunctionTOF(fPostPIDWdthCorrTOF);
 
-  // set event
+  // set event, with the fill map of this instance
+  TBits *previousMap=AliDielectronVarManager::GetFillMap();
   AliDielectronVarManager::SetFillMap(fUsedVars);
   AliDielectronVarManager::SetEvent(ev1);
+  AliDielectronVarManager::SetFillMap(previousMap);
 
   if (fMixing){
     //set mixing bin to event data
@@ -700,7 +767,6 @@ void AliDielectron::FillHistogramsTracks(TObjArray **tracks)
 
   TString  className,className2;
   Double_t values[AliDielectronVarManager::kNMaxValues];
-  AliDielectronVarManager::SetFillMap(fUsedVars);
 
   //Fill track information, separately for the track array candidates
   for (Int_t i=0; i<2; ++i){
@@ -708,7 +774,7 @@ void AliDielectron::FillHistogramsTracks(TObjArray **tracks)
     if (!fHistos->GetHistogramList()->FindObject(className.Data())) continue;
     Int_t ntracks=tracks[i]->GetEntriesFast();
     for (Int_t itrack=0; itrack<ntracks; ++itrack){
-      AliDielectronVarManager::Fill(tracks[i]->UncheckedAt(itrack), values);
+      AliDielectronVarManager::Fill(tracks[i]->UncheckedAt(itrack), values, fUsedVars);
       fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
     }
   }
@@ -723,11 +789,10 @@ void AliDielectron::FillHistogramsMC(const AliMCEvent *ev, AliVEvent *ev1)
   //
 
   Double_t values[AliDielectronVarManager::kNMaxValues]={0.};
-  AliDielectronVarManager::SetFillMap(fUsedVars);
 
   // Fill event information
-  AliDielectronVarManager::Fill(ev1, values);    // ESD/AOD information
-  AliDielectronVarManager::Fill(ev, values);     // MC truth info
+  AliDielectronVarManager::Fill(ev1, values, fUsedVars);    // ESD/AOD information
+  AliDielectronVarManager::Fill(ev, values, fUsedVars);     // MC truth info
   if (fHistos->GetHistogramList()->FindObject("MCEvent"))
     fHistos->FillClass("MCEvent", AliDielectronVarManager::kNMaxValues, values);
 }
@@ -742,7 +807,6 @@ void AliDielectron::FillHistograms(const AliVEvent *ev, Bool_t pairInfoOnly)
 
   TString  className,className2;
   Double_t values[AliDielectronVarManager::kNMaxValues]={0.};
-  AliDielectronVarManager::SetFillMap(fUsedVars);
 
   //Fill event information
   if (ev){
@@ -761,7 +825,7 @@ void AliDielectron::FillHistograms(const AliVEvent *ev, Bool_t pairInfoOnly)
       if (!trkClass && !mergedtrkClass) continue;
       Int_t ntracks=fTracks[i].GetEntriesFast();
       for (Int_t itrack=0; itrack<ntracks; ++itrack){
-        AliDielectronVarManager::Fill(fTracks[i].UncheckedAt(itrack), values);
+        AliDielectronVarManager::Fill(fTracks[i].UncheckedAt(itrack), values, fUsedVars);
         if(trkClass)
           fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
         if(mergedtrkClass && i<2)
@@ -784,7 +848,7 @@ void AliDielectron::FillHistograms(const AliVEvent *ev, Bool_t pairInfoOnly)
 
       //fill pair information
       if (pairClass){
-        AliDielectronVarManager::Fill(pair, values);
+        AliDielectronVarManager::Fill(pair, values, fUsedVars);
         fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
       }
 
@@ -793,12 +857,12 @@ void AliDielectron::FillHistograms(const AliVEvent *ev, Bool_t pairInfoOnly)
         AliVParticle *d1=pair->GetFirstDaughterP();
         AliVParticle *d2=pair->GetSecondDaughterP();
         if (!arrLegs.FindObject(d1)){
-          AliDielectronVarManager::Fill(d1, values);
+          AliDielectronVarManager::Fill(d1, values, fUsedVars);
           fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
           arrLegs.Add(d1);
         }
         if (!arrLegs.FindObject(d2)){
-          AliDielectronVarManager::Fill(d2, values);
+          AliDielectronVarManager::Fill(d2, values, fUsedVars);
           fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
           arrLegs.Add(d2);
         }
@@ -820,7 +884,6 @@ void AliDielectron::FillHistogramsPair(AliDielectronPair *pair,Bool_t fromPreFil
   //
   TString  className,className2;
   Double_t values[AliDielectronVarManager::kNMaxValues];
-  AliDielectronVarManager::SetFillMap(fUsedVars);
 
   //Fill Pair information, separately for all pair candidate arrays and the legs
   TObjArray arrLegs(100);
@@ -838,17 +901,17 @@ void AliDielectron::FillHistogramsPair(AliDielectronPair *pair,Bool_t fromPreFil
 
   //fill pair information
   if (pairClass){
-    AliDielectronVarManager::Fill(pair, values);
+    AliDielectronVarManager::Fill(pair, values, fUsedVars);
     fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
   }
 
   if (legClass){
     AliVParticle *d1=pair->GetFirstDaughterP();
-    AliDielectronVarManager::Fill(d1, values);
+    AliDielectronVarManager::Fill(d1, values, fUsedVars);
     fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
 
     AliVParticle *d2=pair->GetSecondDaughterP();
-    AliDielectronVarManager::Fill(d2, values);
+    AliDielectronVarManager::Fill(d2, values, fUsedVars);
     fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
   }
 }
@@ -1514,6 +1577,7 @@ void AliDielectron::FillDebugTree()
   //
 
   //Fill Debug tree
+  TBits *previousMap=AliDielectronVarManager::GetFillMap();
   AliDielectronVarManager::SetFillMap(fDebugTree->GetUsedVars());
   for (Int_t i=0; i<10; ++i){
     Int_t ntracks=PairArray(i)->GetEntriesFast();
@@ -1521,6 +1585,7 @@ void AliDielectron::FillDebugTree()
       fDebugTree->Fill(static_cast<AliDielectronPair*>(PairArray(i)->UncheckedAt(ipair)));
     }
   }
+  AliDielectronVarManager::SetFillMap(previousMap);
 }
 
 //________________________________________________________________
@@ -1583,24 +1648,26 @@ void AliDielectron::FillMCHistograms(Int_t label1, Int_t label2, Int_t nSignal)
 
   // fill event values
   Double_t values[AliDielectronVarManager::kNMaxValues];
-  AliDielectronVarManager::SetFillMap(fUsedVars);
-  AliDielectronVarManager::Fill(dieMC->GetMCEvent(), values); // get event informations
+  AliDielectronVarManager::Fill(dieMC->GetMCEvent(), values, fUsedVars); // get event informations
   // @TODO: check if this Fill() is even needed. It might modify the fill map (fUsedVars).
 
   // fill the leg variables
   //  printf("leg:%d trk:%d part1:%p part2:%p \n",legClass,trkClass,part1,part2);
   if (legClass || trkClass) {
-    if(part1) AliDielectronVarManager::Fill(part1,values);
+    if(part1) AliDielectronVarManager::Fill(part1, values, fUsedVars);
     if(part1 && trkClass)          fHistos->FillClass(className3, AliDielectronVarManager::kNMaxValues, values);
     if(part1 && part2 && legClass) fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
-    if(part2) AliDielectronVarManager::Fill(part2,values);
+    if(part2) AliDielectronVarManager::Fill(part2, values, fUsedVars);
     if(part2 && trkClass)          fHistos->FillClass(className3, AliDielectronVarManager::kNMaxValues, values);
     if(part1 && part2 && legClass) fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
   }
 
   //fill pair information
   if (pairClass && part1 && part2) {
+    TBits *previousMap=AliDielectronVarManager::GetFillMap();
+    AliDielectronVarManager::SetFillMap(fUsedVars);
     AliDielectronVarManager::FillVarMCParticle2(part1,part2,values);
+    AliDielectronVarManager::SetFillMap(previousMap);
     fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
   }
 
@@ -1614,7 +1681,6 @@ void AliDielectron::FillMCHistograms(const AliVEvent *ev) {
   if (!fSignalsMC) return;
   TString className,className2,className3;
   Double_t values[AliDielectronVarManager::kNMaxValues]={0.};
-  AliDielectronVarManager::SetFillMap(fUsedVars);
   // AliDielectronVarManager::Fill(ev, values);
   // not needed to get event information here, because done in FillVarVParticle() [and FillVarDielectronPair()].
 
@@ -1640,14 +1706,14 @@ void AliDielectron::FillMCHistograms(const AliVEvent *ev) {
           if(isMCtruth) {
             //fill pair information
             if (pairClass){
-              AliDielectronVarManager::Fill(pair, values);
+              AliDielectronVarManager::Fill(pair, values, fUsedVars);
               fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
             }
             //fill leg information, both + and - in the same histo
             if (legClass){
-              AliDielectronVarManager::Fill(pair->GetFirstDaughterP(),values);
+              AliDielectronVarManager::Fill(pair->GetFirstDaughterP(), values, fUsedVars);
               fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
-              AliDielectronVarManager::Fill(pair->GetSecondDaughterP(),values);
+              AliDielectronVarManager::Fill(pair->GetSecondDaughterP(), values, fUsedVars);
               fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
             }
           } //is signal
@@ -1661,14 +1727,14 @@ void AliDielectron::FillMCHistograms(const AliVEvent *ev) {
           if(isMCtruth){
             //fill pair information
             if (pairClass){
-              AliDielectronVarManager::Fill(pair, values);
+              AliDielectronVarManager::Fill(pair, values, fUsedVars);
               fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
             }
             //fill leg information, both + and - in the same histo
             if (legClass){
-              AliDielectronVarManager::Fill(pair->GetFirstDaughterP(),values);
+              AliDielectronVarManager::Fill(pair->GetFirstDaughterP(), values, fUsedVars);
               fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
-              AliDielectronVarManager::Fill(pair->GetSecondDaughterP(),values);
+              AliDielectronVarManager::Fill(pair->GetSecondDaughterP(), values, fUsedVars);
               fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
             }
           } //is signal
@@ -1682,14 +1748,14 @@ void AliDielectron::FillMCHistograms(const AliVEvent *ev) {
           if(isMCtruth){
             //fill pair information
             if (pairClass){
-              AliDielectronVarManager::Fill(pair, values);
+              AliDielectronVarManager::Fill(pair, values, fUsedVars);
               fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
             }
             //fill leg information, both + and - in the same histo
             if (legClass){
-              AliDielectronVarManager::Fill(pair->GetFirstDaughterP(),values);
+              AliDielectronVarManager::Fill(pair->GetFirstDaughterP(), values, fUsedVars);
               fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
-              AliDielectronVarManager::Fill(pair->GetSecondDaughterP(),values);
+              AliDielectronVarManager::Fill(pair->GetSecondDaughterP(), values, fUsedVars);
               fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
             }
           } //is signal
@@ -1708,7 +1774,7 @@ void AliDielectron::FillMCHistograms(const AliVEvent *ev) {
         Bool_t isMCtruth2 = AliDielectronMC::Instance()->IsMCTruth(label, (AliDielectronSignalMC*)fSignalsMC->At(isig), 2);
         // skip if track does not correspond to the signal
         if(!isMCtruth1 && !isMCtruth2) continue;
-        AliDielectronVarManager::Fill(fTracks[i].UncheckedAt(itrack), values);
+        AliDielectronVarManager::Fill(fTracks[i].UncheckedAt(itrack), values, fUsedVars);
         fHistos->FillClass(className3, AliDielectronVarManager::kNMaxValues, values);
       } //loop: tracks
     } //loop: arrays
@@ -2140,7 +2206,6 @@ void AliDielectron::FillHistogramsFromPairArray(Bool_t pairInfoOnly/*=kFALSE*/)
 
   TString  className,className2;
   Double_t values[AliDielectronVarManager::kNMaxValues]={0.};
-  AliDielectronVarManager::SetFillMap(fUsedVars);
   AliDielectronVarManager::SetLegEffMap(fLegEffMap);
   AliDielectronVarManager::SetPairEffMap(fPairEffMap);
 
@@ -2186,12 +2251,9 @@ void AliDielectron::FillHistogramsFromPairArray(Bool_t pairInfoOnly/*=kFALSE*/)
       //histogram array for the pair
       if (fHistoArray) fHistoArray->Fill(i,pair);
 
-      // fill map
-      AliDielectronVarManager::SetFillMap(fUsedVars);
-
       //fill pair information
       if (pairClass){
-        AliDielectronVarManager::Fill(pair, values);
+        AliDielectronVarManager::Fill(pair, values, fUsedVars);
         fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
       }
 
@@ -2200,12 +2262,12 @@ void AliDielectron::FillHistogramsFromPairArray(Bool_t pairInfoOnly/*=kFALSE*/)
         AliVParticle *d1=pair->GetFirstDaughterP();
         AliVParticle *d2=pair->GetSecondDaughterP();
         if (!arrLegs.FindObject(d1)){
-          AliDielectronVarManager::Fill(d1, values);
+          AliDielectronVarManager::Fill(d1, values, fUsedVars);
           fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
           arrLegs.Add(d1);
         }
         if (!arrLegs.FindObject(d2)){
-          AliDielectronVarManager::Fill(d2, values);
+          AliDielectronVarManager::Fill(d2, values, fUsedVars);
           fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
           arrLegs.Add(d2);
         }
@@ -283,6 +283,9 @@ private:
   Int_t GetPairIndex(Int_t arr1, Int_t arr2) const {return arr1>=arr2?arr1*(arr1+1)/2+arr2:arr2*(arr2+1)/2+arr1;}
 
   void InitPairCandidateArrays();
+  void CollectUsedVars();
+  void AddUsedVars(const TList *cuts);
+  void AddUsedVars(AliAnalysisCuts *cut);
   void ClearArrays();
 
   TObjArray* PairArray(Int_t i);
@@ -98,6 +98,7 @@ public:
 
   Int_t GetNumberOfBins() const;
   const TObjArray * GetHistArray() const { return &fArrPairType; }
+  TBits *GetUsedVars() const { return fUsedVars; }
   Bool_t GetStepForMCGenerated()   const { return fStepGenerated; }
   Bool_t IsEventArray()           const { return fEventArray; }
   
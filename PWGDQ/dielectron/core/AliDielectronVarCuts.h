@@ -57,6 +57,7 @@ public:
   // getters
   Bool_t  GetCutOnMCtruth() const { return fCutOnMCtruth; }
   CutType GetCutType()      const { return fCutType;      }
+  TBits*  GetUsedVars()     const { return fUsedVars;     }
 
   Int_t GetNCuts() { return fNActiveCuts; }
 
@@ -766,3 +766,77 @@ UInt_t AliDielectronVarManager::GetValueType(const char* valname) {
   }
   return -1;
 }
+
+//________________________________________________________________
+void AliDielectronVarManager::AddDependencies(TBits *map, const TObject *legEffMap, const TObject *pairEffMap)
+{
+  //
+  // Complete the fill map 'map' with all variables needed to compute the ones already set,
+  // including the axes of the efficiency maps. Dependencies are resolved transitively.
+  //
+  if (!map) return;
+
+  // pairs of (variable, variable it is computed from or needs for the same fill)
+  static const UShort_t kDependencies[][2] = {
+    {kNFclsTPCfCross,   kNFclsTPC},
+    {kNFclsTPCfCross,   kNFclsTPCr},
+    {kOneOverLegEff,    kLegEff},
+    {kPairEff,          kLegEff},
+    {kOneOverPairEff,   kPairEff},
+    {kOneOverPairEffSq, kPairEff},
+    {kTRDpidEffPair,    kTRDpidEffLeg},
+    {kPairType,         kTPCnSigmaEle},  // the pair type classes are filled together with the leg PID
+    {kPairType,         kITSnSigmaEle},
+    {kPairType,         kTOFnSigmaEle},
+    {kQnTPCrpH2FlowV2,  kQnDeltaPhiTPCrpH2},
+    {kQnV0ArpH2FlowV2,  kQnDeltaPhiV0ArpH2},
+    {kQnV0CrpH2FlowV2,  kQnDeltaPhiV0CrpH2},
+    {kQnV0rpH2FlowV2,   kQnDeltaPhiV0rpH2},
+    {kQnSPDrpH2FlowV2,  kQnDeltaPhiSPDrpH2},
+    {kQnDeltaPhiTrackTPCrpH2, kQnTPCrpH2},
+    {kQnDeltaPhiTrackV0CrpH2, kQnV0CrpH2}
+  };
+  const Int_t nDependencies=sizeof(kDependencies)/sizeof(kDependencies[0]);
+
+  // the efficiencies are looked up with the variables on the map axes
+  if (map->TestBitNumber(kLegEff) || map->TestBitNumber(kOneOverLegEff) || map->TestBitNumber(kPairEff) ||
+      map->TestBitNumber(kOneOverPairEff) || map->TestBitNumber(kOneOverPairEffSq)) {
+    AddEffMapVariables(map, legEffMap);
+  }
+  if (map->TestBitNumber(kPairEff) || map->TestBitNumber(kOneOverPairEff) || map->TestBitNumber(kOneOverPairEffSq)) {
+    AddEffMapVariables(map, pairEffMap);
+  }
+
+  Bool_t changed=kTRUE;
+  while (changed) {
+    changed=kFALSE;
+    for (Int_t i=0; i<nDependencies; ++i) {
+      if (map->TestBitNumber(kDependencies[i][0]) && !map->TestBitNumber(kDependencies[i][1])) {
+        map->SetBitNumber(kDependencies[i][1], kTRUE);
+        changed=kTRUE;
+      }
+    }
+  }
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::AddEffMapVariables(TBits *map, const TObject *effMap)
+{
+  //
+  // Add the variables on the axes of an efficiency map (see GetSingleLegEff and GetPairEff)
+  //
+  if (!effMap) return;
+  if (effMap->InheritsFrom(THnBase::Class())) {
+    const THnBase *eff = static_cast<const THnBase*>(effMap);
+    for (Int_t idim=0; idim<eff->GetNdimensions(); ++idim) {
+      UInt_t var = GetValueType(eff->GetAxis(idim)->GetName());
+      if (var<kNMaxValues) map->SetBitNumber(var, kTRUE);
+    }
+  }
+  else if (effMap->IsA()==TSpline3::Class()) {
+    TH1 *hist = const_cast<TSpline3*>(static_cast<const TSpline3*>(effMap))->GetHistogram();
+    if (!hist) return;
+    UInt_t var = GetValueType(hist->GetXaxis()->GetName());
+    if (var<kNMaxValues) map->SetBitNumber(var, kTRUE);
+  }
+}
@@ -703,6 +703,7 @@ public:
   AliDielectronVarManager(const char* name, const char* title);
   virtual ~AliDielectronVarManager();
   static void Fill(const TObject* particle, Double_t * const values);
+  static void Fill(const TObject* particle, Double_t * const values, TBits *map);
   static void FillVarMCParticle2(const AliVParticle *p1, const AliVParticle *p2, Double_t * const values);
   static void FillVarVParticle(const AliVParticle *particle,         Double_t * const values);
 
@@ -714,6 +715,8 @@ public:
   static void SetLegEffMap( TObject *map) { fgLegEffMap=map; }
   static void SetPairEffMap(TObject *map) { fgPairEffMap=map; }
   static void SetFillMap(   TBits   *map) { fgFillMap=map; }
+  static TBits* GetFillMap() { return fgFillMap; }
+  static void AddDependencies(TBits *map, const TObject *legEffMap=0x0, const TObject *pairEffMap=0x0);
   static void SetVZEROCalibrationFile(const Char_t* filename) {fgVZEROCalibrationFile = filename;}
 
   static void SetVZERORecenteringFile(const Char_t* filename) {fgVZERORecenteringFile = filename;}
@@ -752,6 +755,7 @@ private:
   static const char* fgkParticleNames[kNMaxValues][3];  //variable names
 
   static Bool_t Req(ValueTypes var) { return (fgFillMap ? fgFillMap->TestBitNumber(var) : kTRUE); }
+  static void AddEffMapVariables(TBits *map, const TObject *effMap);
   static void FillVarESDtrack(const AliESDtrack *particle,           Double_t * const values);
   static void FillVarAODTrack(const AliAODTrack *particle,           Double_t * const values);
   static void FillVarVTrdTrack(const AliVParticle *particle,         Double_t * const values);
@@ -830,6 +834,18 @@ inline void AliDielectronVarManager::Fill(const TObject* object, Double_t * cons
 //   else printf(Form("AliDielectronVarManager::Fill: Type %s is not supported by AliDielectronVarManager!", object->ClassName())); //TODO: implement without object needed
 }
 
+inline void AliDielectronVarManager::Fill(const TObject* object, Double_t * const values, TBits *map)
+{
+  //
+  // Fill with the fill map 'map' (e.g. the one of an AliDielectron instance),
+  // the previous fill map is restored afterwards
+  //
+  TBits *previousMap=fgFillMap;
+  fgFillMap=map;
+  Fill(object, values);
+  fgFillMap=previousMap;
+}
+
 inline void AliDielectronVarManager::FillVarVParticle(const AliVParticle *particle, Double_t * const values)
 {
   ///
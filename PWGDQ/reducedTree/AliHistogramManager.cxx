@@ -48,7 +48,10 @@ AliHistogramManager::AliHistogramManager() :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(0)
+  fNVars(0),
+  fHistClassLists(),
+  fFillPlans(),
+  fFillPlanNHists()
 {
   //
   // Constructor
@@ -70,7 +73,10 @@ AliHistogramManager::AliHistogramManager(const Char_t* name, Int_t nvars) :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(nvars)
+  fNVars(nvars),
+  fHistClassLists(),
+  fFillPlans(),
+  fFillPlanNHists()
 {
   //
   // Constructor
@@ -130,6 +136,32 @@ void AliHistogramManager::AddHistClass(const Char_t* histClass) {
   hList->SetOwner(kTRUE);
   hList->SetName(histClass);
   fMainList.Add(hList);
+  RegisterHistClass(hList);
+}
+
+//__________________________________________________________________
+Int_t AliHistogramManager::RegisterHistClass(THashList* hList) {
+  //
+  // Assign a handle to a histogram class; the handle is stored in the unique ID of the list
+  //
+  UInt_t idx = hList->GetUniqueID();
+  if(idx<fHistClassLists.size() && fHistClassLists[idx]==hList) return idx;
+  idx = fHistClassLists.size();
+  hList->SetUniqueID(idx);
+  fHistClassLists.push_back(hList);
+  fFillPlans.push_back(std::vector<FillRecord>());
+  fFillPlanNHists.push_back(-1);
+  return idx;
+}
+
+//__________________________________________________________________
+Int_t AliHistogramManager::GetHistClassIndex(const Char_t* className) {
+  //
+  // Get the handle of a histogram class, to be used with FillHistClass(Int_t, Float_t*)
+  //
+  THashList* hList = (THashList*)fMainList.FindObject(className);
+  if(!hList) return -1;
+  return RegisterHistClass(hList);
 }
 
 //_________________________________________________________________
@@ -153,6 +185,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  InvalidateFillPlans();     // the fill plans are rebuilt at the next FillHistClass() call
   TString hname = name;
   
   Int_t dimension = 1;
@@ -292,6 +325,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  InvalidateFillPlans();
   TString hname = name;
   
   Int_t dimension = 1;
@@ -433,6 +467,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  InvalidateFillPlans();
   TString hname = name;
   
   TString titleStr(title);
@@ -482,6 +517,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  InvalidateFillPlans();
   TString hname = name;
   
   TString titleStr(title);
@@ -615,131 +651,126 @@ void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values
     cout << "         Histogram list not filled" << endl; */
     return;
   }
-  if(!hList) {
-    return;
+  FillHistClass(RegisterHistClass(hList), values);
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillHistClass(Int_t classIndex, Float_t* values) {
+  //
+  //  fill a class of histograms using its handle (see GetHistClassIndex())
+  //
+  if(classIndex<0 || classIndex>=(Int_t)fHistClassLists.size()) return;
+  if(fFillPlanNHists[classIndex]!=fHistClassLists[classIndex]->GetEntries()) BuildFillPlan(classIndex);
+  
+  const std::vector<FillRecord>& plan = fFillPlans[classIndex];
+  Double_t fillValues[20]={0.0};
+  for(std::vector<FillRecord>::const_iterator it=plan.begin(); it!=plan.end(); ++it) {
+    const Int_t* vars = it->fVars;
+    const Bool_t hasWeight = (it->fVarW>AliReducedVarManager::kNothing);
+    switch(it->fKind) {
+      case kFillTH1:
+        if(hasWeight) ((TH1*)it->fHist)->Fill(values[vars[0]],values[it->fVarW]);
+        else ((TH1*)it->fHist)->Fill(values[vars[0]]);
+      break;
+      case kFillProfile:
+        if(hasWeight) ((TProfile*)it->fHist)->Fill(values[vars[0]],values[vars[1]],values[it->fVarW]);
+        else ((TProfile*)it->fHist)->Fill(values[vars[0]],values[vars[1]]);
+      break;
+      case kFillTH2:
+        if(hasWeight) ((TH2*)it->fHist)->Fill(values[vars[0]],values[vars[1]],values[it->fVarW]);
+        else ((TH2*)it->fHist)->Fill(values[vars[0]],values[vars[1]]);
+      break;
+      case kFillProfile2D:
+        if(hasWeight) ((TProfile2D*)it->fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[it->fVarW]);
+        else ((TProfile2D*)it->fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]]);
+      break;
+      case kFillTH3:
+        if(hasWeight) ((TH3*)it->fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[it->fVarW]);
+        else ((TH3*)it->fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]]);
+      break;
+      case kFillProfile3D:
+        if(hasWeight) ((TProfile3D*)it->fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[vars[3]],values[it->fVarW]);
+        else ((TProfile3D*)it->fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[vars[3]]);
+      break;
+      case kFillTHn:
+        for(Int_t idim=0;idim<it->fNDims;++idim) fillValues[idim] = values[vars[idim]];
+        if(hasWeight) ((THnBase*)it->fHist)->Fill(fillValues,values[it->fVarW]);
+        else ((THnBase*)it->fHist)->Fill(fillValues);
+      break;
+      default:
+      break;
+    }
   }
-    
+}
+
+//__________________________________________________________________
+void AliHistogramManager::BuildFillPlan(Int_t classIndex) {
+  //
+  //  Decode the unique IDs of all histograms in a class into a list of fill records.
+  //  Histograms using variables which are not flagged as used are left out.
+  //
+  THashList* hList = fHistClassLists[classIndex];
+  std::vector<FillRecord>& plan = fFillPlans[classIndex];
+  plan.clear();
+  plan.reserve(hList->GetEntries());
+  
   TIter next(hList);
   TObject* h=0x0;
-  Bool_t isProfile;
-  Bool_t isTHn;
-  Int_t thnDim=0;
-  Double_t fillValues[20]={0.0};
-  Int_t uid = 0;
-  Int_t varX=-1, varY=-1, varZ=-1, varT=-1, varW=-1;
-  Int_t dimension=0;
   while((h=next())) {
-    Bool_t allVarsGood = kTRUE;
-    uid = h->GetUniqueID();
-    isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
-    isTHn = ((uid%100)>10 ? kTRUE : kFALSE);      
-    if(isTHn) thnDim = (uid%100)-10;        // the excess over 10 from the last 2 digits give the dimension of the THn
-    dimension = 0;
-    if(!isTHn) dimension = ((TH1*)h)->GetDimension();
-        
+    FillRecord rec;
+    rec.fHist = h;
+    rec.fNDims = 0;
+    rec.fVarW = AliReducedVarManager::kNothing;
+    
+    Int_t uid = h->GetUniqueID();
+    Bool_t isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
+    Bool_t isTHn = ((uid%100)>10 ? kTRUE : kFALSE);
+    Int_t thnDim = (isTHn ? (uid%100)-10 : 0);        // the excess over 10 from the last 2 digits give the dimension of the THn
+    
     uid = (uid-(uid%100))/100;
-    varX = -1;
-    varY = -1;
-    varZ = -1;
-    varT = -1;
-    varW = -1;
+    Int_t varT = -1;
     if(uid>0) {
-      varW = uid%(fNVars+1)-1;
-      if(varW==0) varW=AliReducedVarManager::kNothing;
+      rec.fVarW = uid%(fNVars+1)-1;
+      if(rec.fVarW==0) rec.fVarW=AliReducedVarManager::kNothing;
       uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
       if(uid>0) varT = uid - 1;
-      //cout << "Filling " << h->GetName() << " with varT " << varT << endl;
     }
-        
-    if(!isTHn) {
-      varX = ((TH1*)h)->GetXaxis()->GetUniqueID();
-      if(fUsedVars[varX]) {
-        switch(dimension) {
-          case 1:
-            if(isProfile) {
-              varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-              if(!fUsedVars[varY]) break;
-              if(varW>AliReducedVarManager::kNothing) { 
-                if(!fUsedVars[varW]) break;
-                ((TProfile*)h)->Fill(values[varX],values[varY],values[varW]);
-              }
-              else 
-                ((TProfile*)h)->Fill(values[varX],values[varY]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH1F*)h)->Fill(values[varX],values[varW]);
-              }
-              else
-                ((TH1F*)h)->Fill(values[varX]);
-            }
-          break;
-          case 2:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            if(isProfile) {
-              varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-              if(!fUsedVars[varZ]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ]);        
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH2F*)h)->Fill(values[varX],values[varY], values[varW]);
-              }
-              else
-                ((TH2F*)h)->Fill(values[varX],values[varY]);
-            }
-          break;
-          case 3:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-            if(!fUsedVars[varZ]) break;
-            if(isProfile) {
-              if(!fUsedVars[varT]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT],values[varW]);
-              }
-              else
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ]);
-            }
-          break;
-          default:
-          break;
-        }  // end switch
-      }
-    }  // end if(!isTHn)
-    else {
+    if(rec.fVarW>AliReducedVarManager::kNothing && !fUsedVars[rec.fVarW]) continue;
+    
+    if(isTHn) {
+      if(thnDim>20) continue;
+      Bool_t allVarsGood = kTRUE;
       for(Int_t idim=0;idim<thnDim;++idim) {
-        allVarsGood &= fUsedVars[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-        fillValues[idim] = values[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-      }
-      if(allVarsGood) {
-        if(varW>AliReducedVarManager::kNothing) {
-          if(fUsedVars[varW])
-            ((THnF*)h)->Fill(fillValues,values[varW]);
-        }
-        else
-          ((THnF*)h)->Fill(fillValues);
+        rec.fVars[idim] = ((THnBase*)h)->GetAxis(idim)->GetUniqueID();
+        allVarsGood &= fUsedVars[rec.fVars[idim]];
       }
+      if(!allVarsGood) continue;
+      rec.fKind = kFillTHn;
+      rec.fNDims = thnDim;
+      plan.push_back(rec);
+      continue;
+    }
+    
+    TH1* h1 = (TH1*)h;
+    Int_t dimension = h1->GetDimension();
+    if(dimension<1 || dimension>3) continue;
+    rec.fVars[0] = h1->GetXaxis()->GetUniqueID();
+    rec.fVars[1] = h1->GetYaxis()->GetUniqueID();
+    rec.fVars[2] = h1->GetZaxis()->GetUniqueID();
+    rec.fVars[3] = varT;
+    rec.fNDims = dimension + (isProfile ? 1 : 0);
+    if(isProfile && dimension==3 && varT<0) continue;
+    Bool_t allVarsGood = kTRUE;
+    for(Int_t idim=0;idim<rec.fNDims;++idim) allVarsGood &= fUsedVars[rec.fVars[idim]];
+    if(!allVarsGood) continue;
+    switch(dimension) {
+      case 1: rec.fKind = (isProfile ? kFillProfile : kFillTH1); break;
+      case 2: rec.fKind = (isProfile ? kFillProfile2D : kFillTH2); break;
+      case 3: rec.fKind = (isProfile ? kFillProfile3D : kFillTH3); break;
     }
+    plan.push_back(rec);
   }
+  fFillPlanNHists[classIndex] = hList->GetEntries();
 }
 
 //__________________________________________________________________
@@ -14,6 +14,8 @@
 #include <TList.h>
 #include <THashList.h>
 
+#include <vector>
+
 #include "AliReducedVarManager.h"
 
 class TAxis;
@@ -65,6 +67,8 @@ class AliHistogramManager : public TObject {
                         TAxis* axis);
   
   void FillHistClass(const Char_t* className, Float_t* values);
+  void FillHistClass(Int_t classIndex, Float_t* values);
+  Int_t GetHistClassIndex(const Char_t* className);    // handle of a histogram class to be used in FillHistClass(Int_t, Float_t*); -1 if not existing
   
   void SetUseDefaultVariableNames(Bool_t flag) {fUseDefaultVariableNames = flag;};
   void SetDefaultVarNames(TString* vars, TString* units);
@@ -86,6 +90,25 @@ class AliHistogramManager : public TObject {
    AliHistogramManager(const AliHistogramManager& histMan);             
    AliHistogramManager& operator=(const AliHistogramManager& histMan);      
    
+  enum EFillKind {
+    kFillTH1=0,
+    kFillProfile,
+    kFillTH2,
+    kFillProfile2D,
+    kFillTH3,
+    kFillProfile3D,
+    kFillTHn
+  };
+  
+  // Fill plan record, decoded once from the unique IDs of the histogram and its axes
+  struct FillRecord {
+    TObject* fHist;            // histogram
+    Int_t fKind;               // EFillKind
+    Int_t fNDims;              // number of filled variables
+    Int_t fVars[20];           // variables filled on each axis (X,Y,Z,T for TH1/TProfile, THn dimensions)
+    Int_t fVarW;               // weight variable (kNothing for no weight)
+  };
+  
   THashList fMainList;          // master histogram list
   TString fName;                 // master histogram list name
   THashList* fMainDirectory;   //! main directory with analysis output (this is used for loading output files and retrieving histograms offline)
@@ -101,9 +124,16 @@ class AliHistogramManager : public TObject {
   TString fVariableUnits[AliReducedVarManager::kNVars];               //! variable units
   Int_t fNVars;                          // maximum number of variables
   
+  std::vector<THashList*> fHistClassLists;              //! histogram classes, indexed by the class handle
+  std::vector<std::vector<FillRecord> > fFillPlans;     //! fill plan of each histogram class
+  std::vector<Int_t> fFillPlanNHists;                   //! number of histograms in the class when its plan was built (-1 if outdated)
+  
   void MakeAxisLabels(TAxis* ax, const Char_t* labels);
+  Int_t RegisterHistClass(THashList* hList);
+  void BuildFillPlan(Int_t classIndex);
+  void InvalidateFillPlans() {fFillPlanNHists.assign(fFillPlanNHists.size(), -1);}
   
-  ClassDef(AliHistogramManager, 3)
+  ClassDef(AliHistogramManager, 4)
 };
 
 #endif
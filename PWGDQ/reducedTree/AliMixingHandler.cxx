@@ -32,8 +32,7 @@ AliMixingHandler::AliMixingHandler(Int_t mixingSetup /* = kMixResonanceLegs*/) :
   fMixingThreshold(1.0),
   fDownscaleEvents(1.0),
   fDownscaleTracks(1.0),
-  fPoolsLeg1("TClonesArray"),
-  fPoolsLeg2("TClonesArray"),
+  fPools(),
   fNParallelCuts(0),
   fHistClassNames(""),
   fPoolSize(),
@@ -45,7 +44,9 @@ AliMixingHandler::AliMixingHandler(Int_t mixingSetup /* = kMixResonanceLegs*/) :
   fHistos(0x0),
   fCrossPairsCuts(),
   fLikePairsLeg1Cuts(),
-  fLikePairsLeg2Cuts()
+  fLikePairsLeg2Cuts(),
+  fTrackBuffer(),
+  fPairBuffer()
 {
   // 
   // default constructor
@@ -71,8 +72,7 @@ AliMixingHandler::AliMixingHandler(const Char_t* name, const Char_t* title, Int_
   fMixingThreshold(1.0),
   fDownscaleEvents(1.0),
   fDownscaleTracks(1.0),
-  fPoolsLeg1("TClonesArray"),
-  fPoolsLeg2("TClonesArray"),
+  fPools(),
   fNParallelCuts(0),
   fHistClassNames(""),
   fPoolSize(),
@@ -84,7 +84,9 @@ AliMixingHandler::AliMixingHandler(const Char_t* name, const Char_t* title, Int_
   fHistos(0x0),
   fCrossPairsCuts(),
   fLikePairsLeg1Cuts(),
-  fLikePairsLeg2Cuts()
+  fLikePairsLeg2Cuts(),
+  fTrackBuffer(),
+  fPairBuffer()
 {
   //
   // Named constructor
@@ -163,13 +165,14 @@ void AliMixingHandler::Init() {
   if(histClassArr->GetEntries()!=nClassesPerCut*fNParallelCuts) {  
     cout << "AliMixingHandler::Init(): ERROR The number of cuts and the number of hist class names provided do not match!" << endl;
     cout << "                   hist classes: " << histClassArr->GetEntries() << ";    n-parallel cuts: " << fNParallelCuts << endl;
+    delete histClassArr;
     return;
   }
+  delete histClassArr;
 
   Int_t size = 1;
   for(Int_t iVar = 0; iVar<fNMixingVariables; ++iVar) size *= (fVariableLimits[iVar].GetSize()-1);
-  fPoolsLeg1.Expand(size); fPoolsLeg1.SetOwner(kTRUE);
-  fPoolsLeg2.Expand(size); fPoolsLeg2.SetOwner(kTRUE);
+  fPools.assign(size, MixingPool());
   
   fPoolSize.Set(fNParallelCuts*size);
   for(Int_t i=0;i<fNParallelCuts*size;++i) fPoolSize[i] = 0;
@@ -208,36 +211,85 @@ void AliMixingHandler::FillEvent(TList* leg1List, TList* leg2List, Float_t* valu
   // find the event category
   Int_t category = FindEventCategory(values);
   if(category<0) return;   // event characteristics outside the defined ranges
+  if(category>=Int_t(fPools.size())) return;   // pools not initialized
   
-  TClonesArray *leg1PoolP = static_cast<TClonesArray*>(fPoolsLeg1.At(category));
-  if(!leg1PoolP) leg1PoolP = new(fPoolsLeg1[category]) TClonesArray("TList",1);
-  leg1PoolP->SetOwner(kTRUE);
-  TClonesArray *leg2PoolP=static_cast<TClonesArray*>(fPoolsLeg2.At(category));
-  if(!leg2PoolP) leg2PoolP = new(fPoolsLeg2[category]) TClonesArray("TList",1);
-  leg2PoolP->SetOwner(kTRUE);
-  
-  TClonesArray &leg1Pool=*leg1PoolP;
-  TClonesArray &leg2Pool=*leg2PoolP;
-  // add the leg lists to the appropriate pools
-  TList *list1 = new(leg1Pool[leg1Pool.GetEntries()]) TList();
-  TList *list2 = new(leg2Pool[leg2Pool.GetEntries()]) TList();
-  list1->SetOwner(kTRUE); list2->SetOwner(kTRUE);
-  for(Int_t it=0; it<leg1List->GetEntries(); ++it)
-     list1->Add(leg1List->At(it)->Clone());
-  for(Int_t it=0; it<leg2List->GetEntries(); ++it)
-     list2->Add(leg2List->At(it)->Clone());
-    
   // increment the size of the pools in this category
   ULong_t mixingMask = IncrementPoolSizes(leg1List,leg2List,category);
   
+  // add the legs to the pool of this category; only the cut bits used for mixing are kept
+  // and tracks without any of them are not stored
+  ULong_t cutsMask = (fNParallelCuts<Int_t(8*sizeof(ULong_t)) ? (ULong_t(1)<<fNParallelCuts)-1 : ~ULong_t(0));
+  MixingPool& pool = fPools[category];
+  AddToPool(pool, leg1List, cutsMask);
+  pool.fLeg2Offsets.push_back(pool.fTracks.size());
+  AddToPool(pool, leg2List, cutsMask);
+  if(Int_t(pool.fTracks.size())==pool.fEventOffsets.back()) pool.fLeg2Offsets.pop_back();     // nothing to mix in this event
+  else {
+    pool.fEventOffsets.push_back(pool.fTracks.size());
+    pool.fNEventsAdded += 1;
+    if(pool.fTracks.size()>pool.fPeakTracks) pool.fPeakTracks = pool.fTracks.size();
+  }
+  
   // if full pool(s) were found then run the event mixing
   if(mixingMask) {
-    RunEventMixing(leg1PoolP,leg2PoolP,mixingMask,type,values);
+    RunEventMixing(pool,mixingMask,type,values);
     ResetPoolSizes(mixingMask,category);
   }
 }
 
 
+//_________________________________________________________________________
+void AliMixingHandler::AddToPool(MixingPool& pool, TList* list, ULong_t cutsMask) {
+  //
+  // Append the tracks of a list to the pool
+  //
+  TIter nextTrack(list);
+  AliReducedBaseTrack* track=0x0;
+  while((track=(AliReducedBaseTrack*)nextTrack())) {
+    MixingTrack t;
+    t.fFlags = track->GetFlags() & cutsMask;
+    if(!t.fFlags) continue;
+    t.fIsCartesian = track->IsCartesian();
+    if(t.fIsCartesian) {
+      t.fP[0] = track->Px(); t.fP[1] = track->Py(); t.fP[2] = track->Pz();
+    }
+    else {
+      t.fP[0] = track->Pt(); t.fP[1] = track->Phi(); t.fP[2] = track->Eta();
+    }
+    t.fCharge = track->Charge();
+    t.fIsPair = (track->IsA()==AliReducedPairInfo::Class());
+    t.fMass = 0.0; t.fPairType = 0; t.fCandidateId = 0;
+    if(t.fIsPair) {
+      AliReducedPairInfo* pair = (AliReducedPairInfo*)track;
+      t.fMass = pair->Mass();
+      t.fPairType = pair->PairType();
+      t.fCandidateId = pair->CandidateId();
+    }
+    pool.fTracks.push_back(t);
+    pool.fNTracksAdded += 1;
+  }
+}
+
+
+//_________________________________________________________________________
+AliReducedBaseTrack* AliMixingHandler::LoadTrack(const MixingTrack& t, Int_t slot) {
+  //
+  // Load a pool entry into one of the two reusable track (pair) objects
+  //
+  AliReducedBaseTrack* track = (t.fIsPair ? (AliReducedBaseTrack*)&fPairBuffer[slot] : &fTrackBuffer[slot]);
+  if(t.fIsCartesian) track->PxPyPz(t.fP[0], t.fP[1], t.fP[2]);
+  else track->PtPhiEta(t.fP[0], t.fP[1], t.fP[2]);
+  track->Charge(t.fCharge);
+  track->SetFlags(t.fFlags);
+  if(t.fIsPair) {
+    fPairBuffer[slot].SetMass(t.fMass);
+    fPairBuffer[slot].PairType(t.fPairType);
+    fPairBuffer[slot].CandidateId(t.fCandidateId);
+  }
+  return track;
+}
+
+
 //_________________________________________________________________________
 Int_t AliMixingHandler::FindEventCategory(Float_t* values) {
    //
@@ -374,73 +426,73 @@ void AliMixingHandler::RunLeftoverMixing(Int_t type) {
   cout << "========================================================================" << endl;
   cout << "      Leftover mixing for Mixing Handler " << GetName() << endl;
   cout << "========================================================================" << endl;
+  PrintPoolStatistics();
   
   // create a mixing mask which enables all cuts
   ULong_t mixingMask = 0;
   for(Int_t i=0; i<fNParallelCuts; ++i) mixingMask |= (ULong_t(1)<<i);
   Float_t values[AliReducedVarManager::kNVars];
   
-  for(Int_t icateg=0; icateg<fPoolsLeg1.GetEntries(); ++icateg) {
-    TClonesArray *leg1Pool = static_cast<TClonesArray*>(fPoolsLeg1.At(icateg));
-    TClonesArray *leg2Pool = static_cast<TClonesArray*>(fPoolsLeg2.At(icateg));
-    if(!leg1Pool) continue;
-    if(!leg2Pool) continue;
+  for(Int_t icateg=0; icateg<Int_t(fPools.size()); ++icateg) {
+    if(fPools[icateg].NEvents()==0) continue;
     
     for(Int_t iVar=0; iVar<fNMixingVariables; ++iVar) {
        Int_t bin = GetBinFromCategory(iVar, icateg);
        values[fVariables[iVar]] = 0.5*(fVariableLimits[iVar][bin] + fVariableLimits[iVar][bin+1]);
     }
     
-    RunEventMixing(leg1Pool,leg2Pool,mixingMask,type,values);
+    RunEventMixing(fPools[icateg],mixingMask,type,values);
     ResetPoolSizes(mixingMask,icateg);
   }  // end loop over categories
 }
 
 
 //_________________________________________________________________________
-void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2Pool, ULong_t mixingMask,
-				      Int_t type, Float_t* values) {
+void AliMixingHandler::RunEventMixing(MixingPool& pool, ULong_t mixingMask, Int_t type, Float_t* values) {
   //
   // Run event mixing
   // NOTE: The mixingMask is a bit map with bits toggled for the pools which need mixing
   //       The type is the pair candidate type. It is used in AliReducedPairInfo::CandidateType, mainly to know which mass assumption to be made for the legs
   //
-  Int_t entries = leg1Pool->GetEntries();
+  Int_t entries = pool.NEvents();
   if(entries<2) return;
   
+  // handles of the histogram classes
   TObjArray* histClassArr = fHistClassNames.Tokenize(";");
+  std::vector<Int_t> histClasses(histClassArr->GetEntries());
+  for(Int_t i=0; i<histClassArr->GetEntries(); ++i)
+    histClasses[i] = fHistos->GetHistClassIndex(histClassArr->At(i)->GetName());
+  delete histClassArr;
+  const Int_t nHistClasses = histClasses.size();
   
-  TIter iterEv1Leg1Pool(leg1Pool);
-  TIter iterEv1Leg2Pool(leg2Pool);
+  const MixingTrack* tracks = &pool.fTracks[0];
   ULong_t testFlags1 = 0;
   ULong_t testFlags2 = 0;
   for(Int_t iev1=0; iev1<entries; ++iev1) {                            // first event loop
-    // get the lists of leg1 and leg2 tracks for the first event
-    TList* ev1Leg1List = (TList*)iterEv1Leg1Pool();
-    TList* ev1Leg2List = (TList*)iterEv1Leg2Pool();
+    // ranges of the leg1 and leg2 tracks for the first event
+    const Int_t ev1Leg1Begin = pool.fEventOffsets[iev1];
+    const Int_t ev1Leg2Begin = pool.fLeg2Offsets[iev1];
+    const Int_t ev1End = pool.fEventOffsets[iev1+1];
     
-    TIter iterEv2Leg1Pool(leg1Pool);
-    TIter iterEv2Leg2Pool(leg2Pool);
     for(Int_t iev2=0; iev2<entries; ++iev2) {                         // second event loop 
-      TList* ev2Leg1List = (TList*)iterEv2Leg1Pool();
-      TList* ev2Leg2List = (TList*)iterEv2Leg2Pool();
       if(iev1==iev2) continue;
+      const Int_t ev2Leg1Begin = pool.fEventOffsets[iev2];
+      const Int_t ev2Leg2Begin = pool.fLeg2Offsets[iev2];
+      const Int_t ev2End = pool.fEventOffsets[iev2+1];
       
       //loop over the ev1-leg1 list
-      TIter iterLeg1(ev1Leg1List);
-      AliReducedBaseTrack* ev1Leg1=0x0;
-      while((ev1Leg1=(AliReducedBaseTrack*)iterLeg1())) {
+      for(Int_t i1=ev1Leg1Begin; i1<ev1Leg2Begin; ++i1) {
         // check that this track has at least one common bit with the mixing mask
-        testFlags1 = mixingMask & ev1Leg1->GetFlags();
+        testFlags1 = mixingMask & tracks[i1].fFlags;
         if(!testFlags1) continue;
+        AliReducedBaseTrack* ev1Leg1 = LoadTrack(tracks[i1], 0);
 	
         //loop over the ev2-leg2 list
-        TIter iterLeg2(ev2Leg2List);
-        AliReducedBaseTrack* ev2Leg2=0x0;
-        while((ev2Leg2=(AliReducedBaseTrack*)iterLeg2())) {
+        for(Int_t i2=ev2Leg2Begin; i2<ev2End; ++i2) {
           // check that this track has at least one common bit with the mixing mask and with ev1-leg1
-          testFlags2 = testFlags1 & ev2Leg2->GetFlags();
+          testFlags2 = testFlags1 & tracks[i2].fFlags;
           if(!testFlags2) continue;
+          AliReducedBaseTrack* ev2Leg2 = LoadTrack(tracks[i2], 1);
 	  
           // fill cross-pairs (leg1 - leg2) for the enabled bits
           if(fMixingSetup==kMixResonanceLegs) AliReducedVarManager::FillPairInfoME(ev1Leg1, ev2Leg2, type, values);
@@ -448,11 +500,9 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
           if(!IsPairSelected(values, 1)) continue;   // fill histograms only if pair cuts are fulfilled
           for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
             if((testFlags2)&(ULong_t(1)<<ibit)) { 
-              if(fMixingSetup==kMixResonanceLegs) fHistos->FillHistClass(histClassArr->At(ibit*3+1)->GetName(), values);
-              if(fMixingSetup==kMixCorrelation) {
-                Int_t pairType = (reinterpret_cast<AliReducedPairInfo*>(ev1Leg1))->PairType();
-                fHistos->FillHistClass(histClassArr->At(ibit*3+pairType)->GetName(), values);
-              }
+              Int_t histClass = ibit*3+1;
+              if(fMixingSetup==kMixCorrelation) histClass = ibit*3+tracks[i1].fPairType;
+              if(histClass<nHistClasses) fHistos->FillHistClass(histClasses[histClass], values);
             }
           }  
 	}  // end loop over the ev2-leg2 list
@@ -460,19 +510,17 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
 	if(fMixingSetup==kMixCorrelation) continue;
 	if(!fMixLikeSign) continue;
 	// loop over the ev2-leg1 list
-	TIter iterLeg1LS(ev2Leg1List);
-	AliReducedBaseTrack* ev2Leg1=0x0;
-	while((ev2Leg1=(AliReducedBaseTrack*)iterLeg1LS())) {
+	for(Int_t i2=ev2Leg1Begin; i2<ev2Leg2Begin; ++i2) {
 	  // check that this track has at least one common bit with the mixing mask and with ev1-leg1
-	  testFlags2 = testFlags1 & ev2Leg1->GetFlags();
+	  testFlags2 = testFlags1 & tracks[i2].fFlags;
           if(!testFlags2) continue;
 	  
 	  // fill like-pairs (leg1 - leg1) for the enabled bits
-	  AliReducedVarManager::FillPairInfoME(ev1Leg1, ev2Leg1, type, values);
+	  AliReducedVarManager::FillPairInfoME(ev1Leg1, LoadTrack(tracks[i2], 1), type, values);
           if(!IsPairSelected(values, 0)) continue;   // fill histograms only if pair cuts are fulfilled
 	  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
-            if((testFlags2)&(ULong_t(1)<<ibit)) 
-              fHistos->FillHistClass(histClassArr->At(ibit*3+0)->GetName(), values);
+            if((testFlags2)&(ULong_t(1)<<ibit) && ibit*3<nHistClasses) 
+              fHistos->FillHistClass(histClasses[ibit*3+0], values);
           }  
 	}  // end loop over the ev2-leg1 list
       }  // end loop over the ev1-leg1 list
@@ -480,96 +528,56 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
       if(fMixingSetup==kMixCorrelation) continue;
       if(!fMixLikeSign) continue;
       //loop over the ev1-leg2 list
-      TIter iterLeg2(ev1Leg2List);
-      AliReducedBaseTrack* ev1Leg2=0x0;
-      while((ev1Leg2=(AliReducedBaseTrack*)iterLeg2())) {
+      for(Int_t i1=ev1Leg2Begin; i1<ev1End; ++i1) {
 	// check that this track has at least one common bit with the mixing mask
-	testFlags1 = mixingMask & ev1Leg2->GetFlags();
+	testFlags1 = mixingMask & tracks[i1].fFlags;
         if(!testFlags1) continue;
+        AliReducedBaseTrack* ev1Leg2 = LoadTrack(tracks[i1], 0);
 	
 	//loop over the ev2-leg2 list 
-	TIter iterLeg2LS(ev2Leg2List);
-	AliReducedBaseTrack* ev2Leg2=0x0;
-	while((ev2Leg2=(AliReducedBaseTrack*)iterLeg2LS())) {
+	for(Int_t i2=ev2Leg2Begin; i2<ev2End; ++i2) {
 	  // check that this track has at least one common bit with the mixing mask and with ev1-leg1
-	  testFlags2 = testFlags1 & ev2Leg2->GetFlags();
+	  testFlags2 = testFlags1 & tracks[i2].fFlags;
           if(!testFlags2) continue;
 	  
 	  // fill like-pairs (leg2 - leg2) for the enabled bits
-	  AliReducedVarManager::FillPairInfoME(ev1Leg2, ev2Leg2, type, values);
+	  AliReducedVarManager::FillPairInfoME(ev1Leg2, LoadTrack(tracks[i2], 1), type, values);
           if(!IsPairSelected(values, 2)) continue;   // fill histograms only if pair cuts are fulfilled
 	  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
-            if((testFlags2)&(ULong_t(1)<<ibit)) 
-              fHistos->FillHistClass(histClassArr->At(ibit*3+2)->GetName(), values);
+            if((testFlags2)&(ULong_t(1)<<ibit) && ibit*3+2<nHistClasses) 
+              fHistos->FillHistClass(histClasses[ibit*3+2], values);
           }  
 	}  // end loop over the ev2-leg2 list
       }  // end loop over the ev1-leg2 list
     }  // end second event loop
   }  // end first event loop
   
-  // unset the mixing flags --------------------------------------
-  iterEv1Leg1Pool.Reset(); 
-  iterEv1Leg2Pool.Reset();
-  for(Int_t ie1=0; ie1<entries; ++ie1) {
-    TList* leg1List = (TList*)iterEv1Leg1Pool();        
-    TIter iterLeg1(leg1List);
-    AliReducedBaseTrack* track=0x0;
-    while((track=(AliReducedBaseTrack*)iterLeg1())) {
-      testFlags1 = mixingMask & track->GetFlags();
-      if(!testFlags1) continue;
-      
-      for(UShort_t ibit=0; ibit<fNParallelCuts; ++ibit) {
-	if((testFlags1)&(ULong_t(1)<<ibit)) 
-	  track->UnsetFlag(ibit);
-      }
-    }  // end loop over the first leg list
-    
-    TList* leg2List = (TList*)iterEv1Leg2Pool();
-    TIter iterLeg2(leg2List);
-    while((track=(AliReducedBaseTrack*)iterLeg2())) {
-      testFlags1 = mixingMask & track->GetFlags();
-      if(!testFlags1) continue;
-
-      for(UShort_t ibit=0; ibit<fNParallelCuts; ++ibit) {
-	if((testFlags1)&(ULong_t(1)<<ibit)) 
-	  track->UnsetFlag(ibit);
-      }
-    }  // end loop over the second leg list
-  }  // end loop over events
-  
-  // clean the tracks which don't have enabled mixing flags anymore
-  AliReducedBaseTrack* track=0x0;
-  // leg1 lists
-  iterEv1Leg1Pool.Reset(); TList* leg1List=0x0;
-  while((leg1List=(TList*)iterEv1Leg1Pool())) {
-    TIter iterLeg1(leg1List);
-    while((track=(AliReducedBaseTrack*)iterLeg1())) {
-      if(!track->GetFlags()) {
-         leg1List->Remove(track); delete track;
-      }
-    }
-  }  // end while
-  // leg2 lists
-  iterEv1Leg2Pool.Reset(); TList* leg2List=0x0;
-  while((leg2List=(TList*)iterEv1Leg2Pool())) {  
-    TIter iterLeg2(leg2List);
-    while((track=(AliReducedBaseTrack*)iterLeg2())) {
-      if(!track->GetFlags()) {
-         leg2List->Remove(track); delete track;
-      }
-    }
-  }  // end while
-  
-  // clean the events without any tracks left
-  for(Int_t i=leg1Pool->GetEntries()-1;i>=0;--i) {
-    leg1List=(TList*)leg1Pool->At(i);
-    leg2List=(TList*)leg2Pool->At(i);
-    if(leg1List->GetEntries()==0 && 
-       leg2List->GetEntries()==0) {
-       leg1Pool->RemoveAt(i); leg1Pool->Compress(); //delete leg1List;
-       leg2Pool->RemoveAt(i); leg2Pool->Compress(); //delete leg2List;
+  // unset the mixing flags and compact the pool in place, dropping the tracks without enabled
+  // mixing flags and the events without any tracks left
+  Int_t nTracksKept = 0;
+  Int_t nEventsKept = 0;
+  for(Int_t iev=0; iev<entries; ++iev) {
+    const Int_t leg1Begin = pool.fEventOffsets[iev];
+    const Int_t leg2Begin = pool.fLeg2Offsets[iev];
+    const Int_t end = pool.fEventOffsets[iev+1];
+    const Int_t eventBegin = nTracksKept;
+    for(Int_t i=leg1Begin; i<end; ++i) {
+      if(i==leg2Begin) pool.fLeg2Offsets[nEventsKept] = nTracksKept;
+      ULong_t flags = pool.fTracks[i].fFlags & (~mixingMask);
+      if(!flags) continue;
+      pool.fTracks[nTracksKept] = pool.fTracks[i];
+      pool.fTracks[nTracksKept].fFlags = flags;
+      ++nTracksKept;
     }
+    if(leg2Begin==end) pool.fLeg2Offsets[nEventsKept] = nTracksKept;
+    if(nTracksKept==eventBegin) continue;
+    pool.fEventOffsets[nEventsKept] = eventBegin;
+    ++nEventsKept;
   }
+  pool.fTracks.resize(nTracksKept);
+  pool.fEventOffsets.resize(nEventsKept+1);
+  pool.fEventOffsets[nEventsKept] = nTracksKept;
+  pool.fLeg2Offsets.resize(nEventsKept);
 }
 
 
@@ -628,6 +636,7 @@ void AliMixingHandler::PrintMixingLists(Int_t debugLevel) {
    cout << "Histogram class names :: " << fHistClassNames.Data() << endl;
   
    if(debugLevel<1) return;
+   PrintPoolStatistics();
   
    Int_t nCategories = 1;
    for(Int_t iVar=0; iVar<fNMixingVariables; ++iVar) nCategories *= (fVariableLimits[iVar].GetSize() - 1);
@@ -649,36 +658,21 @@ void AliMixingHandler::PrintMixingLists(Int_t debugLevel) {
       cout << endl;
       if(debugLevel<2) continue;
       
-      TClonesArray *leg1PoolP = static_cast<TClonesArray*>(fPoolsLeg1.At(iCateg));
-      if(!leg1PoolP) continue;
-      TClonesArray &leg1Pool=*leg1PoolP;
-      TClonesArray *leg2PoolP = static_cast<TClonesArray*>(fPoolsLeg2.At(iCateg));
-      
-      TIter iterLeg1Pool(leg1PoolP);
-      TIter iterLeg2Pool(leg2PoolP);
-      for(Int_t iev=0; iev<leg1Pool.GetEntries(); ++iev) {
-         TList* leg1List = (TList*)iterLeg1Pool();
-         TList* leg2List = (TList*)iterLeg2Pool();
+      if(iCateg>=Int_t(fPools.size())) continue;
+      const MixingPool& pool = fPools[iCateg];
+      for(Int_t iev=0; iev<pool.NEvents(); ++iev) {
+         const Int_t leg1Begin = pool.fEventOffsets[iev];
+         const Int_t leg2Begin = pool.fLeg2Offsets[iev];
+         const Int_t end = pool.fEventOffsets[iev+1];
          cout << "	Event #" << iev << ";  No. of tracks (leg1/leg2) :: " 
-         << leg1List->GetEntries() << " / " << leg2List->GetEntries() << endl;
+         << leg2Begin-leg1Begin << " / " << end-leg2Begin << endl;
          if(debugLevel<3) continue;
          
-         TIter iterLeg1List(leg1List);
-         cout << "		Leg1 list" << endl;
-         for(Int_t itrack=0; itrack<leg1List->GetEntries(); ++itrack) {
-            track = (AliReducedBaseTrack*)iterLeg1List();
-            cout << "		track #" << itrack << " (p/px/py/pz/charge/flags) :: "
-            << track->P() << " / " << track->Px() << " / " 
-            << track->Py() << " / " << track->Pz() << "/" << track->Charge() << " / " << flush;
-            AliReducedVarManager::PrintBits(track->GetFlags(), fNParallelCuts);	 
-            cout << endl;
-         }  // end loop over tracks
-         
-         TIter iterLeg2List(leg2List);
-         cout << "		Leg2 list" << endl;
-         for(Int_t itrack=0; itrack<leg2List->GetEntries(); ++itrack) {
-            track = (AliReducedBaseTrack*)iterLeg2List();
-            cout << "		track #" << itrack << " (p/px/py/pz/charge/flags) :: "
+         for(Int_t i=leg1Begin; i<end; ++i) {
+            if(i==leg1Begin) cout << "		Leg1 list" << endl;
+            if(i==leg2Begin) cout << "		Leg2 list" << endl;
+            track = LoadTrack(pool.fTracks[i], 0);
+            cout << "		track #" << (i<leg2Begin ? i-leg1Begin : i-leg2Begin) << " (p/px/py/pz/charge/flags) :: "
             << track->P() << " / " << track->Px() << " / " 
             << track->Py() << " / " << track->Pz() << "/" << track->Charge() << " / " << flush;
             AliReducedVarManager::PrintBits(track->GetFlags(), fNParallelCuts);	 
@@ -687,3 +681,27 @@ void AliMixingHandler::PrintMixingLists(Int_t debugLevel) {
       }  // end loop over events
    }  // end loop over categories  
 }
+
+
+//_________________________________________________________________________
+void AliMixingHandler::PrintPoolStatistics() const {
+   //
+   // Print the occupancy and memory use of the mixing pools
+   //
+   ULong64_t totalBytes = 0, totalTracks = 0;
+   Int_t totalEvents = 0;
+   cout << "Mixing pools of " << GetName() << " (" << sizeof(MixingTrack) << " bytes per stored track)" << endl;
+   cout << "  category :: events / tracks / peak tracks / allocated bytes / events added / tracks added" << endl;
+   for(Int_t iCateg=0; iCateg<Int_t(fPools.size()); ++iCateg) {
+      const MixingPool& pool = fPools[iCateg];
+      if(pool.fNEventsAdded==0) continue;
+      ULong64_t bytes = pool.fTracks.capacity()*sizeof(MixingTrack) + 
+                        (pool.fEventOffsets.capacity()+pool.fLeg2Offsets.capacity())*sizeof(Int_t);
+      cout << "  " << iCateg << " :: " << pool.NEvents() << " / " << pool.fTracks.size() << " / " << pool.fPeakTracks 
+           << " / " << bytes << " / " << pool.fNEventsAdded << " / " << pool.fNTracksAdded << endl;
+      totalBytes += bytes;
+      totalTracks += pool.fTracks.size();
+      totalEvents += pool.NEvents();
+   }
+   cout << "  total :: " << totalEvents << " events / " << totalTracks << " tracks / " << totalBytes << " bytes" << endl;
+}
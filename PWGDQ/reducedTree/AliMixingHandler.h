@@ -14,9 +14,13 @@
 #include <TList.h>
 #include <TString.h>
 
+#include <vector>
+
 #include "AliHistogramManager.h"
 #include "AliReducedVarManager.h"
 #include "AliReducedInfoCut.h"
+#include "AliReducedBaseTrack.h"
+#include "AliReducedPairInfo.h"
 
 class AliMixingHandler : public TNamed {
    
@@ -75,12 +79,38 @@ public:
   Bool_t AcceptTrack();    // randomly accept/reject a track for mixing
   void RunLeftoverMixing(Int_t type=-1);
   void PrintMixingLists(Int_t debug);  
+  void PrintPoolStatistics() const;
   Bool_t IsPairSelected(Float_t* values, Int_t pairType);
   
 private:
    AliMixingHandler(const AliMixingHandler& handler);             
    AliMixingHandler& operator=(const AliMixingHandler& handler);      
    
+  // Compact copy of a leg kept in the mixing pools, holding only what is needed by the pair filling
+  struct MixingTrack {
+    Float_t fP[3];             // (px,py,pz) or (pt,phi,eta), as stored in the original track
+    Float_t fMass;             // mass (pair candidates only; only the first mass hypothesis is kept)
+    ULong_t fFlags;            // cut bits which still have to be mixed
+    Char_t  fCharge;           // charge
+    Char_t  fPairType;         // pair type (pair candidates only)
+    Char_t  fCandidateId;      // candidate type (pair candidates only)
+    Bool_t  fIsCartesian;      // momentum representation
+    Bool_t  fIsPair;           // the original object was an AliReducedPairInfo
+  };
+  
+  // Pool of one event category: the legs of all events are stored contiguously,
+  // leg1 tracks followed by leg2 tracks for each event
+  struct MixingPool {
+    MixingPool() : fTracks(), fEventOffsets(1,0), fLeg2Offsets(), fNEventsAdded(0), fNTracksAdded(0), fPeakTracks(0) {}
+    Int_t NEvents() const {return fLeg2Offsets.size();}
+    std::vector<MixingTrack> fTracks;      // legs of all events in the pool
+    std::vector<Int_t> fEventOffsets;      // index of the first leg1 track of each event; last element is the number of tracks
+    std::vector<Int_t> fLeg2Offsets;       // index of the first leg2 track of each event
+    Long64_t fNEventsAdded;                // number of events added to the pool
+    Long64_t fNTracksAdded;                // number of tracks added to the pool
+    UInt_t fPeakTracks;                    // largest number of tracks held at the same time
+  };
+  
   // User options
   Int_t    fMixingSetup;          //  see Constants for various options 
   Int_t fPoolDepth;              // depth of the event mixing pool
@@ -90,8 +120,7 @@ private:
   Float_t fDownscaleEvents;      // random downscale adding events to the pools
   Float_t fDownscaleTracks;      // random downscale adding tracks fo the pools
   
-  TClonesArray fPoolsLeg1;         // array of pools
-  TClonesArray fPoolsLeg2;         // array of pools
+  std::vector<MixingPool> fPools;  //! pools, one for each event category
   Int_t fNParallelCuts;            // number of parallel cuts which are run
   TString fHistClassNames;         // name of the histogram classes for each cut, separated by a semicolon ";"
   TArrayI fPoolSize;               // counters for the pool sizes
@@ -108,11 +137,16 @@ private:
   TList fLikePairsLeg1Cuts;    // cut object for LEG1 like pairs
   TList fLikePairsLeg2Cuts;    // cut object for LEG2 like pairs
   
-  void RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2Pool, ULong_t mixingMask, Int_t type, Float_t* values);
+  AliReducedBaseTrack fTrackBuffer[2];   //! track objects loaded from the pools during mixing
+  AliReducedPairInfo fPairBuffer[2];     //! pair objects loaded from the pools during mixing
+  
+  void AddToPool(MixingPool& pool, TList* list, ULong_t cutsMask);
+  AliReducedBaseTrack* LoadTrack(const MixingTrack& track, Int_t slot);
+  void RunEventMixing(MixingPool& pool, ULong_t mixingMask, Int_t type, Float_t* values);
   ULong_t IncrementPoolSizes(TList* list1, TList* list2, Int_t eventCategory);
   void ResetPoolSizes(ULong_t mixingMask, Int_t category);  
   
-  ClassDef(AliMixingHandler,3);
+  ClassDef(AliMixingHandler,4);
 };
 
 #endif
@@ -372,9 +372,11 @@ void AliReducedAnalysisJpsi2ee::FillTrackHistograms(AliReducedBaseTrack* track,
          AliReducedTrackInfo* trackInfo = dynamic_cast<AliReducedTrackInfo*>(track);
          if(!trackInfo) continue;
          
+         // the same class is filled for each flag / layer, so look up its handle only once
+         Int_t histClassIdx = fHistosManager->GetHistClassIndex(Form("%sStatusFlags_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()));
          for(UInt_t iflag=0; iflag<AliReducedVarManager::kNTrackingFlags; ++iflag) {
             AliReducedVarManager::FillTrackingFlag(trackInfo, iflag, fValues);
-            fHistosManager->FillHistClass(Form("%sStatusFlags_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
+            fHistosManager->FillHistClass(histClassIdx, fValues);
             if(mcDecisionMap) {
                for(Int_t iMC=0; iMC<=fLegCandidatesMCcuts.GetEntries(); ++iMC) {
                   if(mcDecisionMap & (UInt_t(1)<<iMC))
@@ -383,9 +385,10 @@ void AliReducedAnalysisJpsi2ee::FillTrackHistograms(AliReducedBaseTrack* track,
                }
             }
          }
+         histClassIdx = fHistosManager->GetHistClassIndex(Form("%sITSclusterMap_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()));
          for(Int_t iLayer=0; iLayer<6; ++iLayer) {
             AliReducedVarManager::FillITSlayerFlag(trackInfo, iLayer, fValues);
-            fHistosManager->FillHistClass(Form("%sITSclusterMap_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
+            fHistosManager->FillHistClass(histClassIdx, fValues);
             if(mcDecisionMap) {
                for(Int_t iMC=0; iMC<=fLegCandidatesMCcuts.GetEntries(); ++iMC) {
                   if(mcDecisionMap & (UInt_t(1)<<iMC))
@@ -394,9 +397,10 @@ void AliReducedAnalysisJpsi2ee::FillTrackHistograms(AliReducedBaseTrack* track,
                }
             }
          }
+         histClassIdx = fHistosManager->GetHistClassIndex(Form("%sTPCclusterMap_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()));
          for(Int_t iLayer=0; iLayer<8; ++iLayer) {
             AliReducedVarManager::FillTPCclusterBitFlag(trackInfo, iLayer, fValues);
-            fHistosManager->FillHistClass(Form("%sTPCclusterMap_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
+            fHistosManager->FillHistClass(histClassIdx, fValues);
             if(mcDecisionMap) {
                for(Int_t iMC=0; iMC<=fLegCandidatesMCcuts.GetEntries(); ++iMC) {
                   if(mcDecisionMap & (UInt_t(1)<<iMC))
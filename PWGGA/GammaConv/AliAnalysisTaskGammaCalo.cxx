@@ -80,6 +80,7 @@ AliAnalysisTaskGammaCalo::AliAnalysisTaskGammaCalo(): AliAnalysisTaskSE(),
   fClusterTreeList(NULL),
   fOutputContainer(NULL),
   fClusterCandidates(NULL),
+  fMotherCache(NULL),
   fEventCutArray(NULL),
   fEventCuts(NULL),
   fClusterCutArray(NULL),
@@ -351,6 +352,7 @@ AliAnalysisTaskGammaCalo::AliAnalysisTaskGammaCalo(const char *name):
   fClusterTreeList(NULL),
   fOutputContainer(0),
   fClusterCandidates(NULL),
+  fMotherCache(NULL),
   fEventCutArray(NULL),
   fEventCuts(NULL),
   fClusterCutArray(NULL),
@@ -610,6 +612,10 @@ AliAnalysisTaskGammaCalo::~AliAnalysisTaskGammaCalo()
     delete fClusterCandidates;
     fClusterCandidates = 0x0;
   }
+  if(fMotherCache){
+    delete fMotherCache;
+    fMotherCache = 0x0;
+  }
   if(fBGHandler){
     delete[] fBGHandler;
     fBGHandler = 0x0;
@@ -894,6 +900,7 @@ void AliAnalysisTaskGammaCalo::UserCreateOutputObjects(){
   // Array of current cut's gammas
   fClusterCandidates  = new TList();
   fClusterCandidates->SetOwner(kTRUE);
+  fMotherCache        = new AliConversionMotherCache();
 
   fCutFolder          = new TList*[fnCuts];
   fESDList            = new TList*[fnCuts];
@@ -2430,6 +2437,7 @@ void AliAnalysisTaskGammaCalo::UserExec(Option_t *)
   if(fIsHeavyIon ==1)fEventPlaneAngle = EventPlane->GetEventplane("V0",fInputEvent,2);
   else fEventPlaneAngle=0.0;
 
+  fMotherCache->Reset();
   for(Int_t iCut = 0; iCut<fnCuts; iCut++){
 
     fiCut = iCut;
@@ -3678,7 +3686,8 @@ void AliAnalysisTaskGammaCalo::CalculatePi0Candidates(){
           if ( tof > fMinTimingCluster && tof < fMaxTimingCluster ) continue;
         }
 
-        AliAODConversionMother *pi0cand = new AliAODConversionMother(gamma0,gamma1);
+        // pairs of the same two clusters are built once for all cuts
+        AliAODConversionMother *pi0cand = fMotherCache->GetMother(gamma0->GetCaloClusterRef(),gamma1->GetCaloClusterRef(),gamma0,gamma1);
         pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
 
         if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(pi0cand,kTRUE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(),gamma0->GetLeadingCellID(),gamma1->GetLeadingCellID()))){
@@ -3753,8 +3762,6 @@ void AliAnalysisTaskGammaCalo::CalculatePi0Candidates(){
             }
           }
         }
-        delete pi0cand;
-        pi0cand=0x0;
       }
     }
   }
@@ -11,6 +11,7 @@
 #include "AliConvEventCuts.h"
 #include "AliConversionPhotonCuts.h"
 #include "AliConversionMesonCuts.h"
+#include "AliConversionMotherCache.h"
 #include "AliAnalysisManager.h"
 #include "TProfile2D.h"
 #include "TH3.h"
@@ -133,6 +134,7 @@ class AliAnalysisTaskGammaCalo : public AliAnalysisTaskSE {
     TList**               fClusterTreeList;                                     // Array of lists with tree for EoverP
     TList*                fOutputContainer;                                     // Output container
     TList*                fClusterCandidates;                                   //! current list of cluster candidates
+    AliConversionMotherCache* fMotherCache;                                     //! meson candidates shared by the cut strings
     TList*                fEventCutArray;                                       // List with Event Cuts
     AliConvEventCuts*     fEventCuts;                                           // EventCutObject
     TList*                fClusterCutArray;                                     // List with Cluster Cuts
@@ -406,7 +408,7 @@ class AliAnalysisTaskGammaCalo : public AliAnalysisTaskSE {
     AliAnalysisTaskGammaCalo(const AliAnalysisTaskGammaCalo&);                  // Prevent copy-construction
     AliAnalysisTaskGammaCalo &operator=(const AliAnalysisTaskGammaCalo&);       // Prevent assignment
 
-    ClassDef(AliAnalysisTaskGammaCalo, 44);
+    ClassDef(AliAnalysisTaskGammaCalo, 45);
 };
 
 #endif
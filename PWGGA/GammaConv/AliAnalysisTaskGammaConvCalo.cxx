@@ -46,6 +46,7 @@
 #include "AliKFVertex.h"
 #include "AliGenCocktailEventHeader.h"
 #include "AliConversionAODBGHandlerRP.h"
+#include "AliConversionPhotonFeatureTable.h"
 #include "AliAODMCParticle.h"
 #include "AliAODMCHeader.h"
 #include "AliEventplane.h"
@@ -86,6 +87,8 @@ AliAnalysisTaskGammaConvCalo::AliAnalysisTaskGammaConvCalo(): AliAnalysisTaskSE(
   fReaderGammas(NULL),
   fGammaCandidates(NULL),
   fClusterCandidates(NULL),
+  fPhotonCutMask(NULL),
+  fMotherCache(NULL),
   fEventCutArray(NULL),
   fEventCuts(NULL),
   fCutArray(NULL),
@@ -385,6 +388,8 @@ AliAnalysisTaskGammaConvCalo::AliAnalysisTaskGammaConvCalo(const char *name):
   fReaderGammas(NULL),
   fGammaCandidates(NULL),
   fClusterCandidates(NULL),
+  fPhotonCutMask(NULL),
+  fMotherCache(NULL),
   fEventCutArray(NULL),
   fEventCuts(NULL),
   fCutArray(NULL),
@@ -669,6 +674,14 @@ AliAnalysisTaskGammaConvCalo::~AliAnalysisTaskGammaConvCalo()
     delete fClusterCandidates;
     fClusterCandidates = 0x0;
   }
+  if(fPhotonCutMask){
+    delete fPhotonCutMask;
+    fPhotonCutMask = 0x0;
+  }
+  if(fMotherCache){
+    delete fMotherCache;
+    fMotherCache = 0x0;
+  }
   if(fBGHandler){
     delete[] fBGHandler;
     fBGHandler = 0x0;
@@ -801,6 +814,8 @@ void AliAnalysisTaskGammaConvCalo::UserCreateOutputObjects(){
   fGammaCandidates    = new TList();
   fClusterCandidates  = new TList();
   fClusterCandidates->SetOwner(kTRUE);
+  fPhotonCutMask      = new AliConversionPhotonCutMask(fCutArray);
+  fMotherCache        = new AliConversionMotherCache();
 
   fCutFolder          = new TList*[fnCuts];
   fESDList            = new TList*[fnCuts];
@@ -2545,6 +2560,7 @@ void AliAnalysisTaskGammaConvCalo::UserExec(Option_t *)
     fV0Reader->RelabelAODs(kTRUE);
   }
 
+  fMotherCache->Reset();
   for(Int_t iCut = 0; iCut<fnCuts; iCut++){
 
     fiCut = iCut;
@@ -3155,7 +3171,7 @@ void AliAnalysisTaskGammaConvCalo::ProcessPhotonCandidates()
       if( (isNegFromMBHeader+isPosFromMBHeader) != 4) fIsFromDesiredHeader = kFALSE;
     }
 
-    if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->PhotonIsSelected(PhotonCandidate,fInputEvent)) continue;
+    if(!fPhotonCutMask->PhotonIsSelected(fiCut,i,PhotonCandidate,fInputEvent)) continue;
     if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->InPlaneOutOfPlaneCut(PhotonCandidate->GetPhotonPhi(),fEventPlaneAngle)) continue;
     if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->UseElecSharingCut() &&
     !((AliConversionPhotonCuts*)fCutArray->At(fiCut))->UseToCloseV0sCut()){
@@ -4119,10 +4135,12 @@ void AliAnalysisTaskGammaConvCalo::CalculatePi0Candidates(){
   if(fCorrTaskSetting.CompareTo(""))
     arrClustersMesonCand = dynamic_cast<TClonesArray*>(fInputEvent->FindListObject(Form("%sClustersBranch",fCorrTaskSetting.Data())));
   // Conversion Gammas
+  AliConversionPhotonFeatureTable *features = fV0Reader->GetPhotonFeatureTable();
   if(fGammaCandidates->GetEntries()>0){
     for(Int_t firstGammaIndex=0;firstGammaIndex<fGammaCandidates->GetEntries();firstGammaIndex++){
       AliAODConversionPhoton *gamma0=dynamic_cast<AliAODConversionPhoton*>(fGammaCandidates->At(firstGammaIndex));
       if (gamma0==NULL) continue;
+      Int_t key0 = features ? features->FindCandidate(gamma0) : -1;
 
       for(Int_t secondGammaIndex=0;secondGammaIndex<fClusterCandidates->GetEntries();secondGammaIndex++){
         Bool_t matched = kFALSE;
@@ -4162,7 +4180,8 @@ void AliAnalysisTaskGammaConvCalo::CalculatePi0Candidates(){
           if(arrClustersMesonCand) delete cluster;
         }
 
-        AliAODConversionMother *pi0cand = new AliAODConversionMother(gamma0,gamma1);
+        // pairs of the same reader photon and cluster are built once for all cuts
+        AliAODConversionMother *pi0cand = fMotherCache->GetMother(key0,gamma1->GetIsCaloPhoton() ? gamma1->GetCaloClusterRef() : -1,gamma0,gamma1);
         pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
 
         if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(pi0cand,kTRUE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift()))){
@@ -4342,8 +4361,6 @@ void AliAnalysisTaskGammaConvCalo::CalculatePi0Candidates(){
             }
           }
         }
-        delete pi0cand;
-        pi0cand=0x0;
       }
     }
   }
@@ -11,6 +11,8 @@
 #include "AliConvEventCuts.h"
 #include "AliConversionPhotonCuts.h"
 #include "AliConversionMesonCuts.h"
+#include "AliConversionPhotonCutMask.h"
+#include "AliConversionMotherCache.h"
 #include "AliAnalysisManager.h"
 #include "TProfile2D.h"
 #include "TH3.h"
@@ -164,6 +166,8 @@ class AliAnalysisTaskGammaConvCalo : public AliAnalysisTaskSE {
     TClonesArray*                       fReaderGammas;          // Array with conversion photons selected by V0Reader Cut
     TList*                              fGammaCandidates;       // current list of photon candidates
     TList*                              fClusterCandidates;     //! current list of cluster candidates
+    AliConversionPhotonCutMask*         fPhotonCutMask;         //! photon cuts evaluated once per event for all cut strings
+    AliConversionMotherCache*           fMotherCache;           //! meson candidates shared by the cut strings
     TList*                              fEventCutArray;         // List with Event Cuts
     AliConvEventCuts*                   fEventCuts;             // EventCutObject
     TList*                              fCutArray;              // List with Conversion Cuts
@@ -477,7 +481,7 @@ class AliAnalysisTaskGammaConvCalo : public AliAnalysisTaskSE {
     AliAnalysisTaskGammaConvCalo(const AliAnalysisTaskGammaConvCalo&); // Prevent copy-construction
     AliAnalysisTaskGammaConvCalo &operator=(const AliAnalysisTaskGammaConvCalo&); // Prevent assignment
 
-    ClassDef(AliAnalysisTaskGammaConvCalo, 45);
+    ClassDef(AliAnalysisTaskGammaConvCalo, 46);
 };
 
 #endif
@@ -50,6 +50,7 @@
 #include "AliKFVertex.h"
 #include "AliGenCocktailEventHeader.h"
 #include "AliConversionAODBGHandlerRP.h"
+#include "AliConversionPhotonFeatureTable.h"
 #include "AliAODMCParticle.h"
 #include "AliAODMCHeader.h"
 #include "AliEventplane.h"
@@ -81,6 +82,8 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(): AliAnalysisTaskSE(),
   fOutputContainer(0),
   fReaderGammas(NULL),
   fGammaCandidates(NULL),
+  fPhotonCutMask(NULL),
+  fMotherCache(NULL),
   fEventCutArray(NULL),
   fCutArray(NULL),
   fMesonCutArray(NULL),
@@ -291,6 +294,8 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(const char *name):
   fOutputContainer(0),
   fReaderGammas(NULL),
   fGammaCandidates(NULL),
+  fPhotonCutMask(NULL),
+  fMotherCache(NULL),
   fEventCutArray(NULL),
   fCutArray(NULL),
   fMesonCutArray(NULL),
@@ -486,6 +491,14 @@ AliAnalysisTaskGammaConvV1::~AliAnalysisTaskGammaConvV1()
     delete fGammaCandidates;
     fGammaCandidates = 0x0;
   }
+  if(fPhotonCutMask){
+    delete fPhotonCutMask;
+    fPhotonCutMask = 0x0;
+  }
+  if(fMotherCache){
+    delete fMotherCache;
+    fMotherCache = 0x0;
+  }
   if(fBGHandler){
     delete[] fBGHandler;
     fBGHandler = 0x0;
@@ -803,6 +816,8 @@ void AliAnalysisTaskGammaConvV1::UserCreateOutputObjects(){
 
   // Array of current cut's gammas
   fGammaCandidates          = new TList();
+  fPhotonCutMask            = new AliConversionPhotonCutMask(fCutArray);
+  fMotherCache              = new AliConversionMotherCache();
 
   fCutFolder                = new TList*[fnCuts];
   fESDList                  = new TList*[fnCuts];
@@ -1835,6 +1850,7 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
     RelabelAODPhotonCandidates(kTRUE);    // In case of AODMC relabeling MC
     fV0Reader->RelabelAODs(kTRUE);
   }
+  fMotherCache->Reset(fInputEvent->GetPrimaryVertex());
   for(Int_t iCut = 0; iCut<fnCuts; iCut++){
     fiCut = iCut;
 
@@ -2056,7 +2072,7 @@ void AliAnalysisTaskGammaConvV1::ProcessPhotonCandidates()
     }
 
 
-    if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->PhotonIsSelected(PhotonCandidate,fInputEvent)) continue;
+    if(!fPhotonCutMask->PhotonIsSelected(fiCut,i,PhotonCandidate,fInputEvent)) continue;
     if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->InPlaneOutOfPlaneCut(PhotonCandidate->GetPhotonPhi(),fEventPlaneAngle)) continue;
     if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->UseElecSharingCut() &&
       !((AliConversionPhotonCuts*)fCutArray->At(fiCut))->UseToCloseV0sCut()){
@@ -3088,10 +3104,12 @@ void AliAnalysisTaskGammaConvV1::ProcessMCParticles()
 void AliAnalysisTaskGammaConvV1::CalculatePi0Candidates(){
 
   // Conversion Gammas
+  AliConversionPhotonFeatureTable *features = fV0Reader->GetPhotonFeatureTable();
   if(fGammaCandidates->GetEntries()>1){
     for(Int_t firstGammaIndex=0;firstGammaIndex<fGammaCandidates->GetEntries()-1;firstGammaIndex++){
       AliAODConversionPhoton *gamma0=dynamic_cast<AliAODConversionPhoton*>(fGammaCandidates->At(firstGammaIndex));
       if (gamma0==NULL) continue;
+      Int_t key0 = features ? features->FindCandidate(gamma0) : -1;
       for(Int_t secondGammaIndex=firstGammaIndex+1;secondGammaIndex<fGammaCandidates->GetEntries();secondGammaIndex++){
         AliAODConversionPhoton *gamma1=dynamic_cast<AliAODConversionPhoton*>(fGammaCandidates->At(secondGammaIndex));
         //Check for same Electron ID
@@ -3101,9 +3119,9 @@ void AliAnalysisTaskGammaConvV1::CalculatePi0Candidates(){
         gamma0->GetTrackLabelNegative() == gamma1->GetTrackLabelPositive() ||
         gamma0->GetTrackLabelPositive() == gamma1->GetTrackLabelNegative() ) continue;
 
-        AliAODConversionMother *pi0cand = new AliAODConversionMother(gamma0,gamma1);
+        // pairs of the same two reader photons are built once for all cuts, including the DCA to the primary vertex
+        AliAODConversionMother *pi0cand = fMotherCache->GetMother(key0,features ? features->FindCandidate(gamma1) : -1,gamma0,gamma1);
         pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
-        pi0cand->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
 
         if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(pi0cand,kTRUE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift()))){
           if(fDoCentralityFlat > 0){
@@ -3201,8 +3219,6 @@ void AliAnalysisTaskGammaConvV1::CalculatePi0Candidates(){
             }
           }
         }
-        delete pi0cand;
-        pi0cand=0x0;
       }
     }
   }
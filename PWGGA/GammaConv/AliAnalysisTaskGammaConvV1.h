@@ -10,6 +10,8 @@
 #include "AliGammaConversionAODBGHandler.h"
 #include "AliConversionAODBGHandlerRP.h"
 #include "AliConversionMesonCuts.h"
+#include "AliConversionPhotonCutMask.h"
+#include "AliConversionMotherCache.h"
 #include "AliAnalysisManager.h"
 #include "TProfile2D.h"
 #include "TH3.h"
@@ -104,6 +106,8 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     TList*                            fOutputContainer;                           //
     TClonesArray*                     fReaderGammas;                              //
     TList*                            fGammaCandidates;                           //
+    AliConversionPhotonCutMask*       fPhotonCutMask;                             //! photon cuts evaluated once per event for all cut strings
+    AliConversionMotherCache*         fMotherCache;                               //! meson candidates shared by the cut strings
     TList*                            fEventCutArray;                             //
     TList*                            fCutArray;                                  //
     TList*                            fMesonCutArray;                             //
@@ -307,7 +311,7 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
 
     AliAnalysisTaskGammaConvV1(const AliAnalysisTaskGammaConvV1&); // Prevent copy-construction
     AliAnalysisTaskGammaConvV1 &operator=(const AliAnalysisTaskGammaConvV1&); // Prevent assignment
-    ClassDef(AliAnalysisTaskGammaConvV1, 42);
+    ClassDef(AliAnalysisTaskGammaConvV1, 43);
 };
 
 #endif
@@ -58,6 +58,7 @@ AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType) :
   fRunNumber(-1),
   fGeomEMCAL(NULL),
   fGeomPHOS(NULL),
+  fEMCALRecoUtils(NULL),
   fMapTrackToCluster(),
   fMapClusterToTrack(),
   fNEntries(1),
@@ -93,6 +94,7 @@ AliCaloTrackMatcher::~AliCaloTrackMatcher(){
 
     if(fHistControlMatches) delete fHistControlMatches;
     if(fSecHistControlMatches) delete fSecHistControlMatches;
+    if(fEMCALRecoUtils) delete fEMCALRecoUtils;
     if(fAnalysisTrainMode.EqualTo("Grid")){
         if(fListHistos != NULL){
             delete fListHistos;
@@ -266,6 +268,21 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
     }
   }
 
+  // clusters are used in place (no copy); for EMCal/DCal the clusters within the matching
+  // window around a track are preselected with the eta-phi cluster index of AliEMCALRecoUtils
+  const TObjArray *clusterArr = arrClusters;
+  TObjArray eventClusters(nClus);
+  if(!clusterArr){
+    for(Int_t iclus=0;iclus < nClus;iclus++) eventClusters.AddAt(event->GetCaloCluster(iclus),iclus);
+    clusterArr = &eventClusters;
+  }
+  Bool_t useClusterIndex = (fClusterType == 1 || fClusterType == 3);
+  if(useClusterIndex){
+    if(!fEMCALRecoUtils) fEMCALRecoUtils = new AliEMCALRecoUtils();
+    fEMCALRecoUtils->SetClusterWindow(fMatchingWindow);
+    fEMCALRecoUtils->BuildClusterIndex(clusterArr);
+  }
+
   for (Int_t itr=0;itr<event->GetNumberOfTracks();itr++){
     AliExternalTrackParam *trackParam = 0;
     AliVTrack *inTrack = 0x0;
@@ -382,51 +399,28 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
     // cout << "eta/phi: " << eta << ", " << phi << endl;
     // cout << "nClus: " << nClus << endl;
     Int_t nClusterMatchesToTrack = 0;
-    for(Int_t iclus=0;iclus < nClus;iclus++){
-      AliVCluster* cluster = NULL;
-      if(arrClusters){
-        if(esdev){
-          if(arrClusters)
-            cluster = new AliESDCaloCluster(*(AliESDCaloCluster*)arrClusters->At(iclus));
-        } else if(aodev){
-          if(arrClusters)
-            cluster = new AliAODCaloCluster(*(AliAODCaloCluster*)arrClusters->At(iclus));
-        }
-      }
-      else
-        cluster = event->GetCaloCluster(iclus);
-      if (!cluster){
-        if(arrClusters) delete cluster;
-        continue;
-      }
+    Int_t nCandidates = useClusterIndex ? fEMCALRecoUtils->SelectClusterCandidates(exPos) : nClus;
+    for(Int_t icand=0;icand < nCandidates;icand++){
+      Int_t iclus = useClusterIndex ? fEMCALRecoUtils->GetClusterCandidate(icand) : icand;
+      AliVCluster* cluster = dynamic_cast<AliVCluster*>(clusterArr->At(iclus));
+      if (!cluster) continue;
       // cout << "-------------------------LOOPING: " << iclus << ", " << cluster->GetID() << endl;
       cluster->GetPosition(clsPos);
       Double_t dR = TMath::Sqrt(TMath::Power(exPos[0]-clsPos[0],2)+TMath::Power(exPos[1]-clsPos[1],2)+TMath::Power(exPos[2]-clsPos[2],2));
       //cout << "dR: " << dR << endl;
-      if (dR > fMatchingWindow){
-        if(arrClusters) delete cluster;
-        continue;
-      }
+      if (dR > fMatchingWindow) continue;
       Double_t clusterR = TMath::Sqrt( clsPos[0]*clsPos[0] + clsPos[1]*clsPos[1] );
       AliExternalTrackParam trackParamTmp(emcParam);//Retrieve the starting point every time before the extrapolation
       if(fClusterType == 1 || fClusterType == 3){
-        if (!cluster->IsEMCAL()){
-          if(arrClusters) delete cluster;
-          continue;
-        }
+        if (!cluster->IsEMCAL()) continue;
         if(!AliEMCALRecoUtils::ExtrapolateTrackToCluster(&trackParamTmp, cluster, 0.139, 5., dEta, dPhi)){
           fHistControlMatches->Fill(4.,inTrack->Pt());
-          if(arrClusters) delete cluster;
           continue;
         }
       }else if(fClusterType == 2){
-        if (!cluster->IsPHOS()){
-          if(arrClusters) delete cluster;
-          continue;
-        }
+        if (!cluster->IsPHOS()) continue;
         if(!AliTrackerBase::PropagateTrackToBxByBz(&trackParamTmp, clusterR, 0.139, 5., kTRUE, 0.8, -1)){
           fHistControlMatches->Fill(4.,inTrack->Pt());
-          if(arrClusters) delete cluster;
           continue;
         }
         Double_t trkPos[3] = {0,0,0};
@@ -440,10 +434,7 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
       Float_t dR2 = dPhi*dPhi + dEta*dEta;
 
       //cout << dEta << " - " << dPhi << " - " << dR2 << endl;
-      if(dR2 > fMatchingResidual){
-        if(arrClusters) delete cluster;
-        continue;
-      }
+      if(dR2 > fMatchingResidual) continue;
       nClusterMatchesToTrack++;
       if(aodev){
         fMapTrackToCluster.insert(make_pair(itr,cluster->GetID()));
@@ -455,13 +446,12 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
       fVectorDeltaEtaDeltaPhi.push_back(make_pair(dEta,dPhi));
       fMap_TrID_ClID_ToIndex[make_pair(inTrack->GetID(),cluster->GetID())] = fNEntries++;
       if( (Int_t)fVectorDeltaEtaDeltaPhi.size() != (fNEntries-1)) AliFatal("Fatal error in AliCaloTrackMatcher, vector and map are not in sync!");
-      if(arrClusters) delete cluster;
-
     }
     if(nClusterMatchesToTrack == 0) fHistControlMatches->Fill(5.,inTrack->Pt());
     else fHistControlMatches->Fill(6.,inTrack->Pt());
     delete trackParam;
   }
+  if(useClusterIndex) fEMCALRecoUtils->ClearClusterIndex();
 
   return;
 }
@@ -9,6 +9,7 @@
 #include <utility>
 
 class TF1;
+class AliEMCALRecoUtils;
 
 using namespace std;
 
@@ -104,6 +105,7 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
 
     AliEMCALGeometry*     fGeomEMCAL;              // pointer to EMCAL geometry
     AliPHOSGeometry*      fGeomPHOS;               // pointer to PHOS geometry
+    AliEMCALRecoUtils*    fEMCALRecoUtils;         //! eta-phi cluster index to preselect the clusters around a track (EMCal/DCal)
 
     multimap<Int_t,Int_t> fMapTrackToCluster;      // connects a given track ID with all associated cluster IDs
     multimap<Int_t,Int_t> fMapClusterToTrack;      // connects a given cluster ID with all associated track IDs
@@ -126,7 +128,7 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     TH2F*                 fHistControlMatches;     // bookkeeping for processed tracks/clusters and succesful matches
     TH2F*                 fSecHistControlMatches;  // bookkeeping for processed V0-tracks/clusters and succesful matches
 
-    ClassDef(AliCaloTrackMatcher,4)
+    ClassDef(AliCaloTrackMatcher,5)
 };
 
 #endif
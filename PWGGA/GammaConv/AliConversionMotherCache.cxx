@@ -0,0 +1,149 @@
+/****************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved.   *
+ *                                                                          *
+ * Permission to use, copy, modify and distribute this software and its     *
+ * documentation strictly for non-commercial purposes is hereby granted     *
+ * without fee, provided that the above copyright notice appears in all     *
+ * copies and that both the copyright notice and this permission notice     *
+ * appear in the supporting documentation. The authors make no claims       *
+ * about the suitability of this software for any purpose. It is            *
+ * provided "as is" without express or implied warranty.                    *
+ ***************************************************************************/
+
+////////////////////////////////////////////////
+//---------------------------------------------
+// Meson candidates of an event shared by the
+// cut loops of a task
+//---------------------------------------------
+////////////////////////////////////////////////
+
+#include <limits>
+#include "AliConversionMotherCache.h"
+#include "AliAODConversionMother.h"
+#include "AliAODConversionPhoton.h"
+#include "AliVVertex.h"
+
+/// \cond CLASSIMP
+ClassImp(AliConversionMotherCache)
+/// \endcond
+
+//________________________________________________________________________
+AliConversionMotherCache::AliConversionMotherCache() :
+  TObject(),
+  fPrimVertex(NULL),
+  fMothers(),
+  fDaughters(),
+  fKeys(),
+  fNEntries(0),
+  fIndex(),
+  fNKeys0(0),
+  fNKeys1(0),
+  fMother(NULL),
+  fNRequested(0),
+  fNBuilt(0)
+{
+
+}
+
+//________________________________________________________________________
+AliConversionMotherCache::~AliConversionMotherCache(){
+  for(UInt_t i=0;i<fMothers.size();i++) delete fMothers[i];
+  delete fMother;
+}
+
+//________________________________________________________________________
+void AliConversionMotherCache::Reset(const AliVVertex *primVertex){
+  // Starts a new event, to be called before the cut loop
+
+  for(Int_t i=0;i<fNEntries;i++) fIndex[fKeys[2*i]*fNKeys1+fKeys[2*i+1]] = -1;
+  fNEntries   = 0;
+  fPrimVertex = primVertex;
+}
+
+//________________________________________________________________________
+void AliConversionMotherCache::GetDaughterValues(const AliAODConversionPhoton *gamma0, const AliAODConversionPhoton *gamma1, Double_t *values){
+  const AliAODConversionPhoton *gamma[2] = {gamma0,gamma1};
+  for(Int_t i=0;i<2;i++){
+    Double_t *v = values+8*i;
+    v[0] = gamma[i]->Px();
+    v[1] = gamma[i]->Py();
+    v[2] = gamma[i]->Pz();
+    v[3] = gamma[i]->E();
+    v[4] = gamma[i]->GetConversionX();
+    v[5] = gamma[i]->GetConversionY();
+    v[6] = gamma[i]->GetConversionZ();
+    v[7] = gamma[i]->GetPhotonQuality();
+  }
+}
+
+//________________________________________________________________________
+void AliConversionMotherCache::Copy(AliAODConversionMother *target, const AliAODConversionMother *source){
+  // AliAODConversionParticle::operator= does not copy the four-momentum
+  *target = *source;
+  target->TLorentzVector::operator=(*source);
+}
+
+//________________________________________________________________________
+void AliConversionMotherCache::Build(AliAODConversionMother *mother, const AliAODConversionPhoton *gamma0, const AliAODConversionPhoton *gamma1){
+  AliAODConversionMother built(gamma0,gamma1);
+  Copy(mother,&built);
+  if(fPrimVertex) mother->CalculateDistanceOfClossetApproachToPrimVtx(fPrimVertex);
+  fNBuilt++;
+}
+
+//________________________________________________________________________
+Int_t AliConversionMotherCache::FindEntry(Int_t key0, Int_t key1){
+  // Entry of the pair (key0,key1), a new one if the pair is not stored yet
+
+  if(key0 >= fNKeys0 || key1 >= fNKeys1){
+    Int_t nKeys0 = fNKeys0, nKeys1 = fNKeys1;
+    while(key0 >= nKeys0) nKeys0 = nKeys0 > 0 ? 2*nKeys0 : 64;
+    while(key1 >= nKeys1) nKeys1 = nKeys1 > 0 ? 2*nKeys1 : 64;
+    fIndex.assign(nKeys0*nKeys1,-1);
+    fNKeys0 = nKeys0;
+    fNKeys1 = nKeys1;
+    for(Int_t i=0;i<fNEntries;i++) fIndex[fKeys[2*i]*fNKeys1+fKeys[2*i+1]] = i;
+  }
+  Int_t &entry = fIndex[key0*fNKeys1+key1];
+  if(entry >= 0) return entry;
+
+  entry = fNEntries++;
+  if(fNEntries > (Int_t)fMothers.size()){
+    fMothers.push_back(new AliAODConversionMother());
+    fDaughters.resize(fNEntries*kNDaughterValues);
+    fKeys.resize(2*fNEntries);
+  }
+  fKeys[2*entry]   = key0;
+  fKeys[2*entry+1] = key1;
+  // force the build of the new pair
+  fDaughters[entry*kNDaughterValues] = std::numeric_limits<Double_t>::quiet_NaN();
+  return entry;
+}
+
+//________________________________________________________________________
+AliAODConversionMother* AliConversionMotherCache::GetMother(Int_t key0, Int_t key1, const AliAODConversionPhoton *gamma0, const AliAODConversionPhoton *gamma1){
+  // Pair of gamma0 and gamma1, the same as new AliAODConversionMother(gamma0,gamma1)
+  // followed by the DCA calculation if a vertex was given. Pairs with a negative key
+  // are not stored.
+
+  fNRequested++;
+  if(!fMother) fMother = new AliAODConversionMother();
+  if(key0 < 0 || key1 < 0){
+    Build(fMother,gamma0,gamma1);
+    return fMother;
+  }
+
+  Int_t entry = FindEntry(key0,key1);
+  Double_t values[kNDaughterValues];
+  GetDaughterValues(gamma0,gamma1,values);
+  Double_t *stored = &fDaughters[entry*kNDaughterValues];
+  Bool_t unchanged = kTRUE;
+  for(Int_t i=0;i<kNDaughterValues && unchanged;i++) unchanged = (values[i] == stored[i]);
+  if(!unchanged){
+    Build(fMothers[entry],gamma0,gamma1);
+    for(Int_t i=0;i<kNDaughterValues;i++) stored[i] = values[i];
+  }
+  // the tasks set labels and MC information on the candidate, the stored pair stays as built
+  Copy(fMother,fMothers[entry]);
+  return fMother;
+}
@@ -0,0 +1,68 @@
+#ifndef ALICONVERSIONMOTHERCACHE_H
+#define ALICONVERSIONMOTHERCACHE_H
+
+#include <vector>
+#include "TObject.h"
+
+class AliVVertex;
+class AliAODConversionPhoton;
+class AliAODConversionMother;
+
+/**
+ * @class AliConversionMotherCache
+ * @brief Meson candidates of an event shared by the cut loops of a task
+ * @ingroup GammaConv
+ *
+ * The tasks pair the photons selected by each cut separately. A pair of the
+ * same two photon candidates selected by several cuts is built only once per
+ * event: GetMother is called with a key for each photon (the position of a
+ * conversion photon in the V0 reader, the cluster index of a calorimeter
+ * photon) and keeps the pair for the following cuts. The stored pair is used
+ * if the momenta, conversion points and qualities of both photons, the only
+ * input of AliAODConversionMother(y1,y2), are unchanged, otherwise it is
+ * rebuilt. If a primary vertex is given to Reset, the DCA of the pair to the
+ * vertex is calculated as well.
+ *
+ * The returned object is a copy of the stored pair, valid until the next call
+ * of GetMother; it is owned by the cache and must not be deleted.
+ */
+class AliConversionMotherCache : public TObject {
+  public:
+    AliConversionMotherCache();
+    virtual ~AliConversionMotherCache();
+
+    void                    Reset(const AliVVertex *primVertex = NULL);
+    AliAODConversionMother* GetMother(Int_t key0, Int_t key1, const AliAODConversionPhoton *gamma0, const AliAODConversionPhoton *gamma1);
+
+    Long64_t                GetNRequested() const                   {return fNRequested;}
+    Long64_t                GetNBuilt() const                       {return fNBuilt;}
+
+  private:
+    AliConversionMotherCache(const AliConversionMotherCache &ref);
+    AliConversionMotherCache &operator=(const AliConversionMotherCache &ref);
+
+    enum {kNDaughterValues = 16};
+
+    static void             Copy(AliAODConversionMother *target, const AliAODConversionMother *source);
+    void                    Build(AliAODConversionMother *mother, const AliAODConversionPhoton *gamma0, const AliAODConversionPhoton *gamma1);
+    Int_t                   FindEntry(Int_t key0, Int_t key1);
+    static void             GetDaughterValues(const AliAODConversionPhoton *gamma0, const AliAODConversionPhoton *gamma1, Double_t *values);
+
+    const AliVVertex*                     fPrimVertex;      //!<! vertex for the DCA of the pairs, not owned
+    std::vector<AliAODConversionMother*>  fMothers;         //!<! stored pairs, owned and reused in the following events
+    std::vector<Double_t>                 fDaughters;       //!<! kNDaughterValues input values of each stored pair
+    std::vector<Int_t>                    fKeys;            //!<! keys of each stored pair
+    Int_t                                 fNEntries;        //!<! number of pairs stored in the event
+    std::vector<Int_t>                    fIndex;           //!<! entry of the pair (key0,key1) at key0*fNKeys1+key1, -1 if not stored
+    Int_t                                 fNKeys0;          //!<! range of the first key in fIndex
+    Int_t                                 fNKeys1;          //!<! range of the second key in fIndex
+    AliAODConversionMother*               fMother;          //!<! copy returned by GetMother
+    Long64_t                              fNRequested;      //!<! number of requested pairs
+    Long64_t                              fNBuilt;          //!<! number of built pairs
+
+    /// \cond CLASSIMP
+    ClassDef(AliConversionMotherCache,1)
+    /// \endcond
+};
+
+#endif
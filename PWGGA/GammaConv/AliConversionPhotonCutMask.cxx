@@ -0,0 +1,118 @@
+/****************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved.   *
+ *                                                                          *
+ * Permission to use, copy, modify and distribute this software and its     *
+ * documentation strictly for non-commercial purposes is hereby granted     *
+ * without fee, provided that the above copyright notice appears in all     *
+ * copies and that both the copyright notice and this permission notice     *
+ * appear in the supporting documentation. The authors make no claims       *
+ * about the suitability of this software for any purpose. It is            *
+ * provided "as is" without express or implied warranty.                    *
+ ***************************************************************************/
+
+////////////////////////////////////////////////
+//---------------------------------------------
+// Photon selection of all cut strings of a
+// task, evaluated once per event for the
+// candidates of the V0 reader
+//---------------------------------------------
+////////////////////////////////////////////////
+
+#include "TList.h"
+#include "AliConversionPhotonCutMask.h"
+#include "AliConversionPhotonCuts.h"
+#include "AliConversionPhotonFeatureTable.h"
+#include "AliAODConversionPhoton.h"
+#include "AliVEvent.h"
+
+/// \cond CLASSIMP
+ClassImp(AliConversionPhotonCutMask)
+/// \endcond
+
+//________________________________________________________________________
+AliConversionPhotonCutMask::AliConversionPhotonCutMask() :
+  TObject(),
+  fCutArray(NULL),
+  fTable(NULL),
+  fEventSerial(-1),
+  fNCuts(0),
+  fSelection(),
+  fMask()
+{
+
+}
+
+//________________________________________________________________________
+AliConversionPhotonCutMask::AliConversionPhotonCutMask(TList *cutArray) :
+  TObject(),
+  fCutArray(cutArray),
+  fTable(NULL),
+  fEventSerial(-1),
+  fNCuts(0),
+  fSelection(),
+  fMask()
+{
+
+}
+
+//________________________________________________________________________
+Bool_t AliConversionPhotonCutMask::Evaluate(AliVEvent *event){
+  // Evaluates the compiled cuts for all candidates of the event, once per event
+
+  if(fTable && fTable->GetEvent() == event && fTable->GetEventSerial() == fEventSerial) return kTRUE;
+  fTable = NULL;
+  if(!fCutArray || !event) return kFALSE;
+
+  fNCuts = fCutArray->GetEntries();
+  std::vector<AliConversionPhotonCuts*> compiled(fNCuts,(AliConversionPhotonCuts*)NULL);
+  AliConversionPhotonFeatureTable *table = NULL;
+  for(Int_t iCut=0;iCut<fNCuts;iCut++){
+    AliConversionPhotonCuts *cuts = dynamic_cast<AliConversionPhotonCuts*>(fCutArray->At(iCut));
+    if(!cuts) continue;
+    AliConversionPhotonFeatureTable *cutTable = cuts->GetPhotonFeatureTable(event);
+    if(!cutTable || !cuts->CompilePhotonSelection()) continue;
+    if(!table){
+      table = cutTable;
+      if(!table->IsFilled()) table->Fill(cuts);
+    }
+    // cuts configured with another V0 reader are left to PhotonIsSelected
+    if(cutTable == table) compiled[iCut] = cuts;
+  }
+  if(!table) return kFALSE;
+
+  Int_t nRows = table->GetNCandidates();
+  fSelection.assign(nRows*fNCuts,0);
+  fMask.assign(nRows,0);
+  for(Int_t row=0;row<nRows;row++){
+    if(!table->GetCandidate(row)) continue;
+    UInt_t *selection = &fSelection[row*fNCuts];
+    for(Int_t iCut=0;iCut<fNCuts;iCut++){
+      if(!compiled[iCut]) continue;
+      selection[iCut] = compiled[iCut]->SelectPhotonCandidate(table,row);
+      if(iCut < 64 && compiled[iCut]->IsPhotonSelection(selection[iCut])) fMask[row] |= (1ULL << iCut);
+    }
+  }
+  fTable       = table;
+  fEventSerial = table->GetEventSerial();
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Bool_t AliConversionPhotonCutMask::PhotonIsSelected(Int_t iCut, Int_t row, AliAODConversionPhoton *photon, AliVEvent *event){
+  // Selection of the candidate at position row of the V0 reader by cut iCut, with the same
+  // bookkeeping as AliConversionPhotonCuts::PhotonIsSelected
+
+  AliConversionPhotonCuts *cuts = (AliConversionPhotonCuts*)fCutArray->At(iCut);
+  if(Evaluate(event) && iCut < fNCuts && row >= 0 && row < fTable->GetNCandidates()){
+    UInt_t selection = fSelection[row*fNCuts+iCut];
+    if(selection && fTable->IsCandidateUnchanged(row,photon)) return cuts->PhotonIsSelected(fTable,row,selection);
+  }
+  return cuts->PhotonIsSelected(photon,event);
+}
+
+//________________________________________________________________________
+ULong64_t AliConversionPhotonCutMask::GetMask(Int_t row) const{
+  // Cuts (< 64) selecting the candidate at position row, for the last evaluated event
+  if(!fTable || row < 0 || row >= (Int_t)fMask.size()) return 0;
+  return fMask[row];
+}
@@ -0,0 +1,58 @@
+#ifndef ALICONVERSIONPHOTONCUTMASK_H
+#define ALICONVERSIONPHOTONCUTMASK_H
+
+#include <vector>
+#include "TObject.h"
+
+class TList;
+class AliVEvent;
+class AliAODConversionPhoton;
+class AliConversionPhotonFeatureTable;
+
+/**
+ * @class AliConversionPhotonCutMask
+ * @brief Selection of all photon cut strings of a task for the candidates of the V0 reader, one bit per cut
+ * @ingroup GammaConv
+ *
+ * On the first request of an event, all cuts of the task's cut list which can
+ * be compiled (AliConversionPhotonCuts::CompilePhotonSelection) are evaluated
+ * with AliConversionPhotonCuts::SelectPhotonCandidate on the candidate table of
+ * the V0 reader, looping over the candidates and, for each, over the cuts.
+ * The result is kept per candidate and cut, and as a bit mask per candidate
+ * for the first 64 cuts.
+ *
+ * PhotonIsSelected replaces AliConversionPhotonCuts::PhotonIsSelected in the
+ * per-cut loops of the tasks: it fills the bookkeeping histograms of the cut
+ * from the stored result. Cuts which are not compiled, candidates not from
+ * the reader and candidates whose momentum was changed after the table was
+ * filled are passed to AliConversionPhotonCuts::PhotonIsSelected.
+ */
+class AliConversionPhotonCutMask : public TObject {
+  public:
+    AliConversionPhotonCutMask();
+    AliConversionPhotonCutMask(TList *cutArray);
+    virtual ~AliConversionPhotonCutMask() {}
+
+    void              SetCutArray(TList *cutArray)                   {fCutArray = cutArray; fTable = NULL;}
+    Bool_t            PhotonIsSelected(Int_t iCut, Int_t row, AliAODConversionPhoton *photon, AliVEvent *event);
+    ULong64_t         GetMask(Int_t row) const;
+
+  private:
+    AliConversionPhotonCutMask(const AliConversionPhotonCutMask &ref);
+    AliConversionPhotonCutMask &operator=(const AliConversionPhotonCutMask &ref);
+
+    Bool_t            Evaluate(AliVEvent *event);
+
+    TList*                            fCutArray;        //!<! photon cuts of the task, not owned
+    AliConversionPhotonFeatureTable*  fTable;           //!<! candidate table of the evaluated event, owned by the V0 reader
+    Long64_t                          fEventSerial;     //!<! serial of the evaluated event in the table
+    Int_t                             fNCuts;           //!<! number of cuts
+    std::vector<UInt_t>               fSelection;       //!<! result of SelectPhotonCandidate at [row*fNCuts+cut], 0 if the cut is not compiled
+    std::vector<ULong64_t>            fMask;            //!<! bit i set if the candidate is selected by cut i < 64
+
+    /// \cond CLASSIMP
+    ClassDef(AliConversionPhotonCutMask,1)
+    /// \endcond
+};
+
+#endif
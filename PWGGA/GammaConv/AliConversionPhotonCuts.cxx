@@ -51,6 +51,7 @@
 #include "AliGenHijingEventHeader.h"
 #include "AliTriggerAnalysis.h"
 #include "AliV0ReaderV1.h"
+#include "AliConversionPhotonFeatureTable.h"
 #include "AliAODMCParticle.h"
 #include "AliAODMCHeader.h"
 #include "AliTRDTriggerAnalysis.h"
@@ -220,7 +221,9 @@ AliConversionPhotonCuts::AliConversionPhotonCuts(const char *name,const char *ti
   fPreSelCut(kFALSE),
   fProcessAODCheck(kFALSE),
   fMaterialBudgetWeightsInitialized(kFALSE),
-  fProfileContainingMaterialBudgetWeights(NULL)
+  fProfileContainingMaterialBudgetWeights(NULL),
+  fV0Reader(NULL),
+  fSelectionCompiled(-1)
 
 {
   InitPIDResponse();
@@ -357,7 +360,9 @@ AliConversionPhotonCuts::AliConversionPhotonCuts(const AliConversionPhotonCuts &
   fPreSelCut(ref.fPreSelCut),
   fProcessAODCheck(ref.fProcessAODCheck),
   fMaterialBudgetWeightsInitialized(ref.fMaterialBudgetWeightsInitialized),
-  fProfileContainingMaterialBudgetWeights(ref.fProfileContainingMaterialBudgetWeights)
+  fProfileContainingMaterialBudgetWeights(ref.fProfileContainingMaterialBudgetWeights),
+  fV0Reader(NULL),
+  fSelectionCompiled(-1)
 
 {
   // Copy Constructor
@@ -400,6 +405,7 @@ void AliConversionPhotonCuts::InitCutHistograms(TString name, Bool_t preCut){
   // Initialize Cut Histograms for QA (only initialized and filled if function is called)
   TH1::AddDirectory(kFALSE);
 
+  fSelectionCompiled = -1;
   if(fHistograms != NULL){
     delete fHistograms;
     fHistograms=NULL;
@@ -972,6 +978,16 @@ Bool_t AliConversionPhotonCuts::CorrectedTPCClusterCut(AliConversionPhotonBase *
 Bool_t AliConversionPhotonCuts::PhotonIsSelected(AliConversionPhotonBase *photon, AliVEvent * event){
   //Selection of Reconstructed Photons
 
+  // candidates of the V0 reader are selected from the columns filled once per event for all cuts,
+  // as long as their momentum was not changed since (smearing, rotation)
+  AliConversionPhotonFeatureTable *features = GetPhotonFeatureTable(event);
+  if(features && CompilePhotonSelection()){
+    if(!features->IsFilled()) features->Fill(this);
+    Int_t row = features->FindCandidate(photon);
+    if(row >= 0 && features->IsCandidateUnchanged(row, features->GetCandidate(row)))
+      return PhotonIsSelected(features, row, SelectPhotonCandidate(features, row));
+  }
+
   FillPhotonCutIndex(kPhotonIn);
 
   if(event->IsA()==AliESDEvent::Class()) {
@@ -997,13 +1013,17 @@ Bool_t AliConversionPhotonCuts::PhotonIsSelected(AliConversionPhotonBase *photon
     Bool_t bFound = kFALSE;
     Int_t v0PosID = posTrack->GetID();
     Int_t v0NegID = negTrack->GetID();
-    AliAODv0* v0 = NULL;
-    for(Int_t iV=0; iV<aodEvent->GetNumberOfV0s(); iV++){
-      v0 = aodEvent->GetV0(iV);
-      if(!v0) continue;
-      if( (v0PosID == v0->GetPosID() && v0NegID == v0->GetNegID()) || (v0PosID == v0->GetNegID() && v0NegID == v0->GetPosID()) ){
-        bFound = kTRUE;
-        break;
+    if(features){
+      bFound = features->HasAODV0(v0PosID,v0NegID);
+    } else {
+      AliAODv0* v0 = NULL;
+      for(Int_t iV=0; iV<aodEvent->GetNumberOfV0s(); iV++){
+        v0 = aodEvent->GetV0(iV);
+        if(!v0) continue;
+        if( (v0PosID == v0->GetPosID() && v0NegID == v0->GetNegID()) || (v0PosID == v0->GetNegID() && v0NegID == v0->GetPosID()) ){
+          bFound = kTRUE;
+          break;
+        }
       }
     }
     if(!bFound){
@@ -1038,6 +1058,283 @@ Bool_t AliConversionPhotonCuts::PhotonIsSelected(AliConversionPhotonBase *photon
   return kTRUE;
 }
 
+///________________________________________________________________________
+Bool_t AliConversionPhotonCuts::CompilePhotonSelection(){
+  // Checks whether SelectPhotonCandidate, the selection of this cut string compiled to the
+  // columns of AliConversionPhotonFeatureTable, can replace PhotonIsSelected. This is the
+  // case when no histogram of the candidate values is filled during the selection, i.e.
+  // with light output or for cuts without histograms, and the PID response is available
+
+  if(fSelectionCompiled < 0){
+    fSelectionCompiled = 1;
+    if( fHistoInvMassbefore || fHistoArmenterosbefore || fHistoInvMassafter || fHistoArmenterosafter ||
+        fHistoEtaDistV0s || fHistoEtaDistV0sAfterdEdxCuts || fHistoTPCdEdxbefore || fHistoTPCdEdxafter ||
+        fHistoTPCdEdxSigbefore || fHistoTPCdEdxSigafter || fHistoKappaafter || fHistoTOFbefore ||
+        fHistoTOFSigbefore || fHistoTOFSigafter || fHistoITSSigbefore || fHistoITSSigafter ||
+        fHistoPsiPairDeltaPhiafter || fHistoAsymmetryafter ) fSelectionCompiled = 0;
+    if(fDoPhotonAsymmetryCut && fDoPhotonPDependentAsymCut && !fFAsymmetryCut) fSelectionCompiled = 0;
+  }
+  if(!fSelectionCompiled) return kFALSE;
+  if(!fPIDResponse) InitPIDResponse();
+  return fPIDResponse != NULL;
+}
+
+///________________________________________________________________________
+UInt_t AliConversionPhotonCuts::SelectPhotonCandidate(const AliConversionPhotonFeatureTable *features, Int_t row) const {
+  // Selection of PhotonIsSelected evaluated on the columns of the candidate table, without
+  // filling histograms. Returns the cut which rejected the candidate (or kPhotonOut) and the
+  // index of the failed sub-cut, from which PhotonIsSelected(features,row,selection) fills
+  // the bookkeeping histograms
+
+  const Int_t kNeg = AliConversionPhotonFeatureTable::kNegative;
+  const Int_t kPos = AliConversionPhotonFeatureTable::kPositive;
+
+  if(features->IsESD()){
+    if(features->HasFlag(row, AliConversionPhotonFeatureTable::kOnFlyV0) != fUseOnFlyV0Finder) return EncodeSelection(kOnFly);
+  }
+  if(!features->HasFlag(row, AliConversionPhotonFeatureTable::kHasTracks)) return EncodeSelection(kNoTracks);
+  if(features->IsAOD() && fPreSelCut && ( fIsHeavyIon != 1 || (fIsHeavyIon == 1 && fProcessAODCheck) )){
+    if(!features->HasFlag(row, AliConversionPhotonFeatureTable::kInAODV0s)) return EncodeSelection(kNoV0);
+  }
+
+  // Track cuts, indices of fHistoTrackCuts
+  Double_t negCharge = features->GetTrackValue(row, kNeg, AliConversionPhotonFeatureTable::kTrackCharge);
+  Double_t posCharge = features->GetTrackValue(row, kPos, AliConversionPhotonFeatureTable::kTrackCharge);
+  if(fUseOnFlyV0FinderSameSign==0){
+    if(negCharge == posCharge) return EncodeSelection(kTrackCuts, 1);
+  }else if(fUseOnFlyV0FinderSameSign==1){
+    if(negCharge != posCharge) return EncodeSelection(kTrackCuts, 1);
+  }
+  if( features->GetTrackValue(row, kNeg, AliConversionPhotonFeatureTable::kTrackNcls) < fMinClsTPC ||
+      features->GetTrackValue(row, kPos, AliConversionPhotonFeatureTable::kTrackNcls) < fMinClsTPC ) return EncodeSelection(kTrackCuts, 2);
+  Double_t negEta = features->GetTrackValue(row, kNeg, AliConversionPhotonFeatureTable::kTrackEta);
+  Double_t posEta = features->GetTrackValue(row, kPos, AliConversionPhotonFeatureTable::kTrackEta);
+  if( posEta > (fEtaCut) || posEta < (-fEtaCut) || negEta > (fEtaCut) || negEta < (-fEtaCut) ) return EncodeSelection(kTrackCuts, 3);
+  if(fEtaCutMin>-0.1){
+    if( (posEta < (fEtaCutMin) && posEta > (-fEtaCutMin)) || (negEta < (fEtaCutMin) && negEta > (-fEtaCutMin)) ) return EncodeSelection(kTrackCuts, 3);
+  }
+  Double_t negPt = features->GetTrackValue(row, kNeg, AliConversionPhotonFeatureTable::kTrackPt);
+  Double_t posPt = features->GetTrackValue(row, kPos, AliConversionPhotonFeatureTable::kTrackPt);
+  if(fDoAsymPtCut){
+    if((posPt<fSinglePtCut || negPt<fSinglePtCut2) && (posPt<fSinglePtCut2 || negPt<fSinglePtCut) ) return EncodeSelection(kTrackCuts, 4);
+  } else {
+    if(posPt<fSinglePtCut || negPt<fSinglePtCut) return EncodeSelection(kTrackCuts, 4);
+  }
+  if( !features->HasTrackFlag(row, kNeg, AliConversionPhotonFeatureTable::kTPCrefit) ||
+      !features->HasTrackFlag(row, kPos, AliConversionPhotonFeatureTable::kTPCrefit) ) return EncodeSelection(kTrackCuts, 5);
+  if( features->HasTrackFlag(row, kNeg, AliConversionPhotonFeatureTable::kKink) ||
+      features->HasTrackFlag(row, kPos, AliConversionPhotonFeatureTable::kKink) ) return EncodeSelection(kTrackCuts, 6);
+
+  // Kappa and dEdx cuts, the third index is the leg (0 for the kappa cut)
+  if(fSwitchToKappa){
+    Double_t kappa = features->GetValue(row, AliConversionPhotonFeatureTable::kKappa);
+    if(kappa < fKappaMinCut || kappa > fKappaMaxCut) return EncodeSelection(kdEdxCuts, 0, 0);
+  }
+  for(Int_t leg=kNeg; leg<=kPos; leg++){
+    Int_t dEdxIndex = SelectPhotonCandidateTrackPID(features, row, leg);
+    if(dEdxIndex > 0) return EncodeSelection(kdEdxCuts, dEdxIndex, leg+1);
+  }
+
+  // Photon cuts, indices of fHistoPhotonCuts, the third index is the one of the acceptance cuts
+  if(fDoQtGammaSelection == kTRUE){
+    Double_t qt    = features->GetValue(row, AliConversionPhotonFeatureTable::kQt);
+    Double_t alpha = features->GetValue(row, AliConversionPhotonFeatureTable::kAlpha);
+    if(fDo2DQt){
+      if ( !(TMath::Power(alpha/0.95,2)+TMath::Power(qt/fQtMax,2) < 1) ) return EncodeSelection(kPhotonCuts, 1);
+    } else {
+      if(qt>fQtMax) return EncodeSelection(kPhotonCuts, 1);
+    }
+  }
+  Double_t chi2 = features->GetValue(row, AliConversionPhotonFeatureTable::kChi2);
+  if(chi2 > fChi2CutConversion || chi2 <=0) return EncodeSelection(kPhotonCuts, 2);
+  Int_t acceptanceIndex = SelectPhotonCandidateAcceptance(features, row);
+  if(acceptanceIndex > 0) return EncodeSelection(kPhotonCuts, 3, acceptanceIndex);
+
+  if(fDoPhotonAsymmetryCut == kTRUE){
+    Double_t photonP = features->GetValue(row, AliConversionPhotonFeatureTable::kP);
+    for(Int_t leg=kPos; leg>=kNeg; leg--){
+      Double_t trackP = features->GetTrackValue(row, leg, AliConversionPhotonFeatureTable::kTrackP);
+      Double_t trackAsy = 0;
+      if(fDoPhotonPDependentAsymCut){
+        if (photonP!=0.) trackAsy = trackP/photonP;
+        if( trackAsy > fFAsymmetryCut->Eval(photonP) || trackAsy < 1.-fFAsymmetryCut->Eval(photonP) ) return EncodeSelection(kPhotonCuts, 4);
+      } else if( trackP > fMinPPhotonAsymmetryCut ){
+        if (photonP!=0.) trackAsy = trackP/photonP;
+        if( trackAsy<fMinPhotonAsymmetry ||trackAsy>(1.- fMinPhotonAsymmetry)) return EncodeSelection(kPhotonCuts, 4);
+      }
+    }
+  }
+  if(features->IsESD()){
+    if( !(features->GetTrackValue(row, kNeg, AliConversionPhotonFeatureTable::kTrackTPCProbElectron)>=fPIDProbabilityCutNegativeParticle &&
+          features->GetTrackValue(row, kPos, AliConversionPhotonFeatureTable::kTrackTPCProbElectron)>=fPIDProbabilityCutPositiveParticle) ) return EncodeSelection(kPhotonCuts, 5);
+  }
+  AliConversionPhotonFeatureTable::ETrackColumn clsToF = fUseCorrectedTPCClsInfo ? AliConversionPhotonFeatureTable::kTrackCorrClsToF : AliConversionPhotonFeatureTable::kTrackClsToF;
+  if( features->GetTrackValue(row, kNeg, clsToF) < fMinClsTPCToF || features->GetTrackValue(row, kPos, clsToF) < fMinClsTPCToF ) return EncodeSelection(kPhotonCuts, 6);
+
+  Double_t psiPair = features->GetValue(row, AliConversionPhotonFeatureTable::kPsiPair);
+  Bool_t psiPairSelected = kTRUE;
+  if (fDo2DPsiPairChi2){
+    psiPairSelected = TMath::Abs(psiPair) < -fPsiPairCut/fChi2CutConversion*chi2 + fPsiPairCut || (fIncludeRejectedPsiPair && psiPair == 4);
+  } else if(fIncludeRejectedPsiPair){
+    psiPairSelected = !(TMath::Abs(psiPair) > fPsiPairCut || psiPair != 4);
+  } else {
+    psiPairSelected = !(TMath::Abs(psiPair) > fPsiPairCut);
+  }
+  if(!psiPairSelected) return EncodeSelection(kPhotonCuts, 7);
+  if(features->GetValue(row, AliConversionPhotonFeatureTable::kCosPA) < fCosPAngleCut) return EncodeSelection(kPhotonCuts, 8);
+  if(features->GetValue(row, AliConversionPhotonFeatureTable::kDCAr) > fDCARPrimVtxCut) return EncodeSelection(kPhotonCuts, 9);
+  if(TMath::Abs(features->GetValue(row, AliConversionPhotonFeatureTable::kDCAz)) > fDCAZPrimVtxCut) return EncodeSelection(kPhotonCuts, 10);
+  if(fDoPhotonQualitySelectionCut && features->GetValue(row, AliConversionPhotonFeatureTable::kQuality) != fPhotonQualityCut) return EncodeSelection(kPhotonCuts, 11);
+
+  return EncodeSelection(kPhotonOut);
+}
+
+///________________________________________________________________________
+Int_t AliConversionPhotonCuts::SelectPhotonCandidateTrackPID(const AliConversionPhotonFeatureTable *features, Int_t row, Int_t leg) const {
+  // dEdxCuts on the columns of one track, returns the index of the failed cut in fHistodEdxCuts or 0
+
+  Double_t p        = features->GetTrackValue(row, leg, AliConversionPhotonFeatureTable::kTrackP);
+  Double_t nSigmaE  = features->GetTrackValue(row, leg, AliConversionPhotonFeatureTable::kTrackNSigmaTPCElectron);
+  Double_t nSigmaPi = features->GetTrackValue(row, leg, AliConversionPhotonFeatureTable::kTrackNSigmaTPCPion);
+
+  if(fDodEdxSigmaCut == kTRUE && !fSwitchToKappa){
+    if( nSigmaE<fPIDnSigmaBelowElectronLine || nSigmaE>fPIDnSigmaAboveElectronLine) return 1;
+    if( p>fPIDMinPnSigmaAbovePionLine && p<fPIDMaxPnSigmaAbovePionLine ){
+      if(nSigmaE>fPIDnSigmaBelowElectronLine && nSigmaE<fPIDnSigmaAboveElectronLine && nSigmaPi<fPIDnSigmaAbovePionLine) return 2;
+    }
+    if( p>fPIDMaxPnSigmaAbovePionLine ){
+      if(nSigmaE>fPIDnSigmaBelowElectronLine && nSigmaE<fPIDnSigmaAboveElectronLine && nSigmaPi<fPIDnSigmaAbovePionLineHighPt) return 3;
+    }
+  }
+  if(fDoKaonRejectionLowP == kTRUE && !fSwitchToKappa){
+    if( p<fPIDMinPKaonRejectionLowP &&
+        TMath::Abs(features->GetTrackValue(row, leg, AliConversionPhotonFeatureTable::kTrackNSigmaTPCKaon))<fPIDnSigmaAtLowPAroundKaonLine) return 4;
+  }
+  if(fDoProtonRejectionLowP == kTRUE && !fSwitchToKappa){
+    if( p<fPIDMinPProtonRejectionLowP &&
+        TMath::Abs(features->GetTrackValue(row, leg, AliConversionPhotonFeatureTable::kTrackNSigmaTPCProton))<fPIDnSigmaAtLowPAroundProtonLine) return 5;
+  }
+  if(fDoPionRejectionLowP == kTRUE && !fSwitchToKappa){
+    if( p<fPIDMinPPionRejectionLowP && TMath::Abs(nSigmaPi)<fPIDnSigmaAtLowPAroundPionLine) return 6;
+  }
+  if(fUseTOFpid && features->HasTrackFlag(row, leg, AliConversionPhotonFeatureTable::kTOFpid)){
+    Double_t nSigmaTOF = features->GetTrackValue(row, leg, AliConversionPhotonFeatureTable::kTrackNSigmaTOFElectron);
+    if(nSigmaTOF>fTofPIDnSigmaAboveElectronLine || nSigmaTOF<fTofPIDnSigmaBelowElectronLine) return 7;
+  }
+  if(fUseITSpid && features->HasTrackFlag(row, leg, AliConversionPhotonFeatureTable::kITSpid) &&
+     features->GetTrackValue(row, leg, AliConversionPhotonFeatureTable::kTrackPt)<=fMaxPtPIDITS){
+    Double_t nSigmaITS = features->GetTrackValue(row, leg, AliConversionPhotonFeatureTable::kTrackNSigmaITSElectron);
+    if(nSigmaITS>fITSPIDnSigmaAboveElectronLine || nSigmaITS<fITSPIDnSigmaBelowElectronLine) return 8;
+  }
+  if(fDoTRDPID){
+    if(!fPIDResponse->IdentifiedAsElectronTRD(features->GetCandidateTrack(row, leg),fPIDTRDEfficiency)) return 9;
+  }
+  return 0;
+}
+
+///________________________________________________________________________
+Int_t AliConversionPhotonCuts::SelectPhotonCandidateAcceptance(const AliConversionPhotonFeatureTable *features, Int_t row) const {
+  // AcceptanceCuts on the columns of the photon, returns the index of the failed cut in fHistoAcceptanceCuts or 0
+
+  Double_t radius = features->GetValue(row, AliConversionPhotonFeatureTable::kR);
+  Double_t z      = features->GetValue(row, AliConversionPhotonFeatureTable::kZ);
+  Double_t eta    = features->GetValue(row, AliConversionPhotonFeatureTable::kEta);
+  Double_t phi    = features->GetValue(row, AliConversionPhotonFeatureTable::kPhi);
+
+  if(radius>fMaxR) return 1;
+  if(radius<fMinR) return 2;
+  if(radius <= ((TMath::Abs(z)*fLineCutZRSlope)-fLineCutZValue)) return 3;
+  if(fUseEtaMinCut && radius >= ((TMath::Abs(z)*fLineCutZRSlopeMin)-fLineCutZValueMin )) return 3;
+  if(TMath::Abs(z) > fMaxZ ) return 4;
+  if( eta > (fEtaCut) || eta < (-fEtaCut) ) return 5;
+  if(fEtaCutMin>-0.1){
+    if( eta < (fEtaCutMin) && eta > (-fEtaCutMin) ) return 5;
+  }
+  if (fDoShrinkTPCAcceptance){
+    if(eta > fEtaForPhiCutMin && eta < fEtaForPhiCutMax ){
+      if (fMinPhiCut < fMaxPhiCut){
+        if( phi > fMinPhiCut && phi < fMaxPhiCut ) return 6;
+      } else {
+        Double_t photonPhi = phi;
+        if (phi < TMath::Pi()) photonPhi = phi + 2*TMath::Pi();
+        if( photonPhi > fMinPhiCut && photonPhi < fMaxPhiCut+2*TMath::Pi() ) return 6;
+      }
+    }
+  }
+  if(features->GetValue(row, AliConversionPhotonFeatureTable::kPt)<fPtCut) return 7;
+  return 0;
+}
+
+///________________________________________________________________________
+Bool_t AliConversionPhotonCuts::PhotonIsSelected(const AliConversionPhotonFeatureTable *features, Int_t row, UInt_t selection){
+  // Fills the bookkeeping histograms of PhotonIsSelected for the result of SelectPhotonCandidate,
+  // returns whether the candidate is selected
+
+  Int_t cut      = selection & 0xf;
+  Int_t index    = (selection >> 4) & 0xf;
+  Int_t subIndex = (selection >> 8) & 0xf;
+
+  FillPhotonCutIndex(kPhotonIn);
+  if(cut == kOnFly || cut == kNoTracks || cut == kNoV0){
+    FillPhotonCutIndex(cut);
+    return kFALSE;
+  }
+
+  // TracksAreSelected, the AOD/ESD specific cuts (5, 6) are filled twice
+  if(fHistoTrackCuts){
+    fHistoTrackCuts->Fill(0.);
+    if(cut == kTrackCuts){
+      fHistoTrackCuts->Fill(index);
+      if(index >= 5) fHistoTrackCuts->Fill(index);
+    } else {
+      fHistoTrackCuts->Fill(7);
+    }
+  }
+  if(cut == kTrackCuts){
+    FillPhotonCutIndex(kTrackCuts);
+    return kFALSE;
+  }
+
+  // dEdxCuts of the negative, then the positive track, not called if the kappa cut failed
+  if(cut != kdEdxCuts || subIndex > 0){
+    for(Int_t leg=AliConversionPhotonFeatureTable::kNegative; leg<=AliConversionPhotonFeatureTable::kPositive; leg++){
+      Double_t pt = features->GetTrackValue(row, leg, AliConversionPhotonFeatureTable::kTrackPt);
+      if(fHistodEdxCuts) fHistodEdxCuts->Fill(0.,pt);
+      if(cut == kdEdxCuts && subIndex == leg+1){
+        if(fHistodEdxCuts) fHistodEdxCuts->Fill(index,pt);
+        break;
+      }
+      if(fHistodEdxCuts) fHistodEdxCuts->Fill(10.,pt);
+    }
+  }
+  if(cut == kdEdxCuts){
+    FillPhotonCutIndex(kdEdxCuts);
+    return kFALSE;
+  }
+
+  // PhotonCuts with the AcceptanceCuts as index 3
+  Double_t photonPt = features->GetValue(row, AliConversionPhotonFeatureTable::kPt);
+  if(fHistoPhotonCuts) fHistoPhotonCuts->Fill(0.,photonPt);
+  if(cut == kPhotonCuts && index < 3){
+    if(fHistoPhotonCuts) fHistoPhotonCuts->Fill(index,photonPt);
+    FillPhotonCutIndex(kPhotonCuts);
+    return kFALSE;
+  }
+  if(fHistoAcceptanceCuts){
+    fHistoAcceptanceCuts->Fill(0.,photonPt);
+    fHistoAcceptanceCuts->Fill(cut == kPhotonCuts && index == 3 ? subIndex : 8,photonPt);
+  }
+  if(cut == kPhotonCuts){
+    if(fHistoPhotonCuts) fHistoPhotonCuts->Fill(index,photonPt);
+    FillPhotonCutIndex(kPhotonCuts);
+    return kFALSE;
+  }
+  if(fHistoPhotonCuts) fHistoPhotonCuts->Fill(12.,photonPt);
+
+  FillPhotonCutIndex(kPhotonOut);
+  return kTRUE;
+}
+
 ///________________________________________________________________________
 Bool_t AliConversionPhotonCuts::ArmenterosQtCut(AliConversionPhotonBase *photon){   // Armenteros Qt Cut
   if(fDo2DQt){
@@ -1476,8 +1773,11 @@ AliVTrack *AliConversionPhotonCuts::GetTrack(AliVEvent * event, Int_t label){
 
   } else {
     if(label == -999999) return NULL; // if AOD relabelling goes wrong, immediately return NULL
+    // the V0 reader keeps the track IDs of the event sorted, avoids the linear search below
+    AliConversionPhotonFeatureTable *features = GetPhotonFeatureTable(event);
+    if(features) return features->GetTrack(label, fV0Reader->AreAODsRelabeled());
     AliVTrack * track = 0x0;
-    if(((AliV0ReaderV1*)AliAnalysisManager::GetAnalysisManager()->GetTask(fV0ReaderName.Data()))->AreAODsRelabeled()){
+    if(fV0Reader && fV0Reader->AreAODsRelabeled()){
       if(event->GetTrack(label)) track = dynamic_cast<AliVTrack*>(event->GetTrack(label));
       return track;
     }
@@ -1496,6 +1796,18 @@ AliVTrack *AliConversionPhotonCuts::GetTrack(AliVEvent * event, Int_t label){
   return NULL;
 }
 
+///________________________________________________________________________
+AliConversionPhotonFeatureTable *AliConversionPhotonCuts::GetPhotonFeatureTable(AliVEvent * event){
+  //Returns the candidate table of the V0 reader for this event, NULL if the reader
+  //is not running or has not finished processing the event
+
+  if(!fV0Reader) fV0Reader = (AliV0ReaderV1*)AliAnalysisManager::GetAnalysisManager()->GetTask(fV0ReaderName.Data());
+  if(!fV0Reader) return NULL;
+  AliConversionPhotonFeatureTable *features = fV0Reader->GetPhotonFeatureTable();
+  if(!features || !event || features->GetEvent() != event) return NULL;
+  return features;
+}
+
 ///________________________________________________________________________
 AliESDtrack *AliConversionPhotonCuts::GetESDTrack(AliESDEvent * event, Int_t label){
   //Returns pointer to the track with given ESD label
@@ -1672,6 +1984,7 @@ Bool_t AliConversionPhotonCuts::InitializeCutsFromCutString(const TString analys
 Bool_t AliConversionPhotonCuts::SetCut(cutIds cutID, const Int_t value) {
   ///Set individual cut ID
 
+  fSelectionCompiled = -1;
   switch (cutID) {
 
     case kv0FinderType:
@@ -31,6 +31,8 @@ class iostream;
 class TList;
 class AliAnalysisManager;
 class AliAODMCParticle;
+class AliV0ReaderV1;
+class AliConversionPhotonFeatureTable;
 
 /**
  * @class AliConversionPhotonCuts
@@ -155,6 +157,10 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
     
     // Cut Selection
     Bool_t PhotonIsSelected(AliConversionPhotonBase * photon, AliVEvent  * event);
+    Bool_t CompilePhotonSelection();
+    UInt_t SelectPhotonCandidate(const AliConversionPhotonFeatureTable *features, Int_t row) const;
+    Bool_t PhotonIsSelected(const AliConversionPhotonFeatureTable *features, Int_t row, UInt_t selection);
+    Bool_t IsPhotonSelection(UInt_t selection) const {return (Int_t)(selection & 0xf) == kPhotonOut;}
     Bool_t PhotonIsSelectedMC(TParticle *particle,AliMCEvent *mcEvent,Bool_t checkForConvertedGamma=kTRUE);
     Bool_t PhotonIsSelectedAODMC(AliAODMCParticle *particle,TClonesArray *aodmcArray,Bool_t checkForConvertedGamma=kTRUE);
     //Bool_t ElectronIsSelectedMC(TParticle *particle,AliMCEvent *mcEvent);
@@ -177,6 +183,7 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
     void SetProcessAODCheck(Bool_t flag){fProcessAODCheck = flag; return;}
 
     AliVTrack * GetTrack(AliVEvent * event, Int_t label);
+    AliConversionPhotonFeatureTable * GetPhotonFeatureTable(AliVEvent * event);
     AliESDtrack *GetESDTrack(AliESDEvent * event, Int_t label);
     
     ///Cut functions
@@ -382,10 +389,17 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
     Bool_t            fProcessAODCheck;                     ///< Flag for processing check for AOD to be contained in AliAODs.root and AliAODGammaConversion.root
     Bool_t            fMaterialBudgetWeightsInitialized;    ///< weights for conversions photons due due deviating material budget in MC compared to data
     TProfile*         fProfileContainingMaterialBudgetWeights;      
+    AliV0ReaderV1*    fV0Reader;                            //!<! V0 reader with name fV0ReaderName
+    Int_t             fSelectionCompiled;                   //!<! SelectPhotonCandidate can replace PhotonIsSelected (1), not (0), not checked yet (-1)
+
+    Int_t             SelectPhotonCandidateTrackPID(const AliConversionPhotonFeatureTable *features, Int_t row, Int_t leg) const;
+    Int_t             SelectPhotonCandidateAcceptance(const AliConversionPhotonFeatureTable *features, Int_t row) const;
+    /// result of SelectPhotonCandidate: rejecting cut (photonCuts), index of the failed cut in its bookkeeping histogram, leg or acceptance index
+    static UInt_t     EncodeSelection(Int_t cut, Int_t index = 0, Int_t subIndex = 0) {return cut | (index << 4) | (subIndex << 8);}
 
   private:
     /// \cond CLASSIMP
-    ClassDef(AliConversionPhotonCuts,15)
+    ClassDef(AliConversionPhotonCuts,17)
     /// \endcond
 };
 
@@ -0,0 +1,310 @@
+/****************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved.   *
+ *                                                                          *
+ * Permission to use, copy, modify and distribute this software and its     *
+ * documentation strictly for non-commercial purposes is hereby granted     *
+ * without fee, provided that the above copyright notice appears in all     *
+ * copies and that both the copyright notice and this permission notice     *
+ * appear in the supporting documentation. The authors make no claims       *
+ * about the suitability of this software for any purpose. It is            *
+ * provided "as is" without express or implied warranty.                    *
+ ***************************************************************************/
+
+////////////////////////////////////////////////
+//---------------------------------------------
+// Per-event table of the photon candidates of
+// a V0 reader and of the quantities used by
+// the photon selection, shared by all the
+// photon cuts of the reader
+//---------------------------------------------
+////////////////////////////////////////////////
+
+#include <algorithm>
+#include "TMath.h"
+#include "TClonesArray.h"
+#include "AliConversionPhotonFeatureTable.h"
+#include "AliConversionPhotonCuts.h"
+#include "AliAODConversionPhoton.h"
+#include "AliVEvent.h"
+#include "AliVTrack.h"
+#include "AliVVertex.h"
+#include "AliESDEvent.h"
+#include "AliESDtrack.h"
+#include "AliESDv0.h"
+#include "AliAODEvent.h"
+#include "AliAODTrack.h"
+#include "AliAODVertex.h"
+#include "AliAODv0.h"
+#include "AliPID.h"
+#include "AliPIDResponse.h"
+
+/// \cond CLASSIMP
+ClassImp(AliConversionPhotonFeatureTable)
+/// \endcond
+
+namespace {
+  Bool_t TrackIDLess(const std::pair<Int_t,Int_t> &a, const std::pair<Int_t,Int_t> &b){return a.first < b.first;}
+}
+
+//________________________________________________________________________
+AliConversionPhotonFeatureTable::AliConversionPhotonFeatureTable() :
+  TObject(),
+  fEvent(NULL),
+  fCandidates(NULL),
+  fEventSerial(0),
+  fFilled(kFALSE),
+  fIsESD(kFALSE),
+  fIsAOD(kFALSE),
+  fNRows(0),
+  fPhotonFlags(),
+  fRowIndex(),
+  fTrackIDIndex(),
+  fTrackIDIndexBuilt(kFALSE),
+  fV0Index(),
+  fV0IndexBuilt(kFALSE)
+{
+
+}
+
+//________________________________________________________________________
+void AliConversionPhotonFeatureTable::Reset(){
+  // Invalidates the table, the columns keep their capacity
+
+  fEvent              = NULL;
+  fCandidates         = NULL;
+  fFilled             = kFALSE;
+  fIsESD              = kFALSE;
+  fIsAOD              = kFALSE;
+  fNRows              = 0;
+  fTrackIDIndexBuilt  = kFALSE;
+  fV0IndexBuilt       = kFALSE;
+  fRowIndex.clear();
+  fTrackIDIndex.clear();
+  fV0Index.clear();
+}
+
+//________________________________________________________________________
+void AliConversionPhotonFeatureTable::SetCandidates(AliVEvent *event, TClonesArray *candidates){
+  // Photons reconstructed by the V0 reader for this event, the columns are filled on first use
+
+  Reset();
+  fEvent      = event;
+  fCandidates = candidates;
+  fEventSerial++;
+  if(!fEvent) return;
+  fIsESD      = fEvent->IsA()==AliESDEvent::Class();
+  fIsAOD      = fEvent->IsA()==AliAODEvent::Class();
+}
+
+//________________________________________________________________________
+void AliConversionPhotonFeatureTable::Fill(AliConversionPhotonCuts *cuts){
+  // Fills the columns for all candidates of the event. None of the quantities depends
+  // on the cut values, the tracks, PID and pointing angle are taken from the helpers of
+  // the cuts so that they are identical to the ones of AliConversionPhotonCuts::PhotonIsSelected
+
+  if(fFilled || !fEvent || !fCandidates || !cuts) return;
+  fFilled = kTRUE;
+
+  fNRows = fCandidates->GetEntriesFast();
+  for(Int_t i=0;i<kNPhotonColumns;i++) fPhotonColumns[i].assign(fNRows,0.);
+  fPhotonFlags.assign(fNRows,0);
+  for(Int_t leg=0;leg<kNLegs;leg++){
+    for(Int_t i=0;i<kNTrackColumns;i++) fTrackColumns[leg][i].assign(fNRows,0.);
+    fTrackFlags[leg].assign(fNRows,0);
+    fTracks[leg].assign(fNRows,(AliVTrack*)NULL);
+  }
+  fRowIndex.clear();
+  fRowIndex.reserve(fNRows);
+
+  AliPIDResponse *pidResponse = cuts->GetPIDResponse();
+  for(Int_t row=0;row<fNRows;row++){
+    AliAODConversionPhoton *photon = dynamic_cast<AliAODConversionPhoton*>(fCandidates->At(row));
+    if(!photon) continue;
+    fRowIndex.push_back(std::make_pair((const AliConversionPhotonBase*)photon,row));
+
+    fPhotonColumns[kPx][row]      = photon->Px();
+    fPhotonColumns[kPy][row]      = photon->Py();
+    fPhotonColumns[kPz][row]      = photon->Pz();
+    fPhotonColumns[kE][row]       = photon->E();
+    fPhotonColumns[kPt][row]      = photon->GetPhotonPt();
+    fPhotonColumns[kP][row]       = photon->GetPhotonP();
+    fPhotonColumns[kEta][row]     = photon->GetPhotonEta();
+    fPhotonColumns[kPhi][row]     = photon->GetPhotonPhi();
+    fPhotonColumns[kR][row]       = photon->GetConversionRadius();
+    fPhotonColumns[kZ][row]       = photon->GetConversionZ();
+    fPhotonColumns[kChi2][row]    = photon->GetChi2perNDF();
+    fPhotonColumns[kPsiPair][row] = photon->GetPsiPair();
+    fPhotonColumns[kQt][row]      = photon->GetArmenterosQt();
+    fPhotonColumns[kAlpha][row]   = photon->GetArmenterosAlpha();
+
+    if(fIsESD){
+      AliESDv0 *v0 = ((AliESDEvent*)fEvent)->GetV0(photon->GetV0Index());
+      if(v0 && v0->GetOnFlyStatus()) fPhotonFlags[row] |= kOnFlyV0;
+    }
+
+    AliVTrack *negTrack = cuts->GetTrack(fEvent, photon->GetTrackLabelNegative());
+    AliVTrack *posTrack = cuts->GetTrack(fEvent, photon->GetTrackLabelPositive());
+    if(!negTrack || !posTrack) continue;
+    fPhotonFlags[row] |= kHasTracks;
+    if(fIsAOD && HasAODV0(posTrack->GetID(),negTrack->GetID())) fPhotonFlags[row] |= kInAODV0s;
+
+    FillTrack(cuts, row, kNegative, negTrack, photon->GetConversionRadius());
+    FillTrack(cuts, row, kPositive, posTrack, photon->GetConversionRadius());
+
+    // the photon quality and the DCA are stored in the photon, as done inside the selection
+    photon->DeterminePhotonQuality(negTrack,posTrack);
+    photon->CalculateDistanceOfClossetApproachToPrimVtx(fEvent->GetPrimaryVertex());
+    fPhotonColumns[kCosPA][row]   = cuts->GetCosineOfPointingAngle(photon, fEvent);
+    fPhotonColumns[kDCAr][row]    = photon->GetDCArToPrimVtx();
+    fPhotonColumns[kDCAz][row]    = photon->GetDCAzToPrimVtx();
+    if(dynamic_cast<AliAODEvent*>(fEvent)) fPhotonColumns[kQuality][row] = cuts->DeterminePhotonQualityAOD(photon, fEvent);
+    else fPhotonColumns[kQuality][row] = photon->GetPhotonQuality();
+
+    if(pidResponse){
+      Float_t kappaMinus = fTrackColumns[kNegative][kTrackNSigmaTPCElectron][row];
+      Float_t kappaPlus  = fTrackColumns[kPositive][kTrackNSigmaTPCElectron][row];
+      Float_t kappa      = ( TMath::Abs(kappaMinus) + TMath::Abs(kappaPlus) ) / 2.0 + 2.0*(kappaMinus+kappaPlus);
+      fPhotonColumns[kKappa][row] = kappa;
+    }
+  }
+  std::sort(fRowIndex.begin(), fRowIndex.end());
+}
+
+//________________________________________________________________________
+void AliConversionPhotonFeatureTable::FillTrack(AliConversionPhotonCuts *cuts, Int_t row, Int_t leg, AliVTrack *track, Double_t radius){
+  // Track columns of one leg of the photon
+
+  fTracks[leg][row] = track;
+  std::vector<Double_t> *columns = fTrackColumns[leg];
+  columns[kTrackPt][row]      = track->Pt();
+  columns[kTrackP][row]       = track->P();
+  columns[kTrackEta][row]     = track->Eta();
+  columns[kTrackCharge][row]  = track->Charge();
+  columns[kTrackNcls][row]    = track->GetNcls(1);
+  if(track->GetTPCNclsF()!=0) columns[kTrackClsToF][row] = (Double_t)track->GetNcls(1)/(Double_t)track->GetTPCNclsF();
+  columns[kTrackCorrClsToF][row] = track->GetTPCClusterInfo(2,0,cuts->GetFirstTPCRow(radius));
+
+  UChar_t flags = 0;
+  if(track->IsA()==AliAODTrack::Class()){
+    AliAODTrack *aodTrack = static_cast<AliAODTrack*>(track);
+    if(aodTrack->IsOn(AliESDtrack::kTPCrefit)) flags |= kTPCrefit;
+    AliAODVertex *prodVertex = aodTrack->GetProdVertex();
+    if(prodVertex && prodVertex->GetType()==AliAODVertex::kKink) flags |= kKink;
+  } else {
+    AliESDtrack *esdTrack = static_cast<AliESDtrack*>(track);
+    if(esdTrack->IsOn(AliESDtrack::kTPCrefit)) flags |= kTPCrefit;
+    if(esdTrack->GetKinkIndex(0) > 0) flags |= kKink;
+  }
+  if((track->GetStatus() & AliESDtrack::kTOFpid) && !(track->GetStatus() & AliESDtrack::kTOFmismatch)) flags |= kTOFpid;
+  if(track->GetStatus() & AliESDtrack::kITSpid) flags |= kITSpid;
+  fTrackFlags[leg][row] = flags;
+
+  AliPIDResponse *pidResponse = cuts->GetPIDResponse();
+  if(pidResponse){
+    columns[kTrackNSigmaTPCElectron][row] = pidResponse->NumberOfSigmasTPC(track, AliPID::kElectron);
+    columns[kTrackNSigmaTPCPion][row]     = pidResponse->NumberOfSigmasTPC(track, AliPID::kPion);
+    columns[kTrackNSigmaTPCKaon][row]     = pidResponse->NumberOfSigmasTPC(track, AliPID::kKaon);
+    columns[kTrackNSigmaTPCProton][row]   = pidResponse->NumberOfSigmasTPC(track, AliPID::kProton);
+    if(flags & kTOFpid) columns[kTrackNSigmaTOFElectron][row] = pidResponse->NumberOfSigmasTOF(track, AliPID::kElectron);
+    if(flags & kITSpid) columns[kTrackNSigmaITSElectron][row] = pidResponse->NumberOfSigmasITS(track, AliPID::kElectron);
+  }
+
+  if(dynamic_cast<AliESDEvent*>(fEvent)){
+    Double_t prob[AliPID::kSPECIES];
+    static_cast<AliESDtrack*>(track)->GetTPCpid(prob);
+    columns[kTrackTPCProbElectron][row] = prob[AliPID::kElectron];
+  }
+}
+
+//________________________________________________________________________
+AliAODConversionPhoton *AliConversionPhotonFeatureTable::GetCandidate(Int_t row) const{
+  // Photon of the row
+  if(!fCandidates || row<0 || row>=fNRows) return NULL;
+  return (AliAODConversionPhoton*)fCandidates->At(row);
+}
+
+//________________________________________________________________________
+Int_t AliConversionPhotonFeatureTable::FindCandidate(const AliConversionPhotonBase *photon) const{
+  // Row of the photon, -1 if it is not a candidate of the V0 reader
+
+  std::vector<std::pair<const AliConversionPhotonBase*,Int_t> >::const_iterator it =
+    std::lower_bound(fRowIndex.begin(), fRowIndex.end(), std::make_pair(photon,-1));
+  if(it == fRowIndex.end() || it->first != photon) return -1;
+  return it->second;
+}
+
+//________________________________________________________________________
+Bool_t AliConversionPhotonFeatureTable::IsCandidateUnchanged(Int_t row, const AliAODConversionPhoton *photon) const{
+  // Checks that the photon is the one of the row and that its momentum was not modified
+  // since the table was filled (smearing, rotation for the background)
+
+  if(!fFilled || !photon || GetCandidate(row) != photon) return kFALSE;
+  return photon->Px() == fPhotonColumns[kPx][row] && photon->Py() == fPhotonColumns[kPy][row] &&
+         photon->Pz() == fPhotonColumns[kPz][row] && photon->E()  == fPhotonColumns[kE][row];
+}
+
+//________________________________________________________________________
+void AliConversionPhotonFeatureTable::BuildTrackIDIndex(){
+  // Sorts the track IDs of the AOD, replaces the linear search done for each label
+
+  fTrackIDIndexBuilt = kTRUE;
+  if(!fEvent) return;
+  Int_t nTracks = fEvent->GetNumberOfTracks();
+  fTrackIDIndex.reserve(nTracks);
+  for(Int_t ii=0; ii<nTracks; ii++){
+    AliVTrack *track = dynamic_cast<AliVTrack*>(fEvent->GetTrack(ii));
+    if(track) fTrackIDIndex.push_back(std::make_pair(track->GetID(),ii));
+  }
+  // stable sort: for duplicated IDs the first track is found, as in the linear search
+  std::stable_sort(fTrackIDIndex.begin(), fTrackIDIndex.end(), TrackIDLess);
+}
+
+//________________________________________________________________________
+AliVTrack *AliConversionPhotonFeatureTable::GetTrack(Int_t label, Bool_t relabeledAOD){
+  // Returns the track with the given label, same conventions as AliConversionPhotonCuts::GetTrack.
+  // The relabeling state of the reader can change within the event, it is passed for each call
+
+  if(!fEvent) return NULL;
+  if(fEvent->IsA()==AliESDEvent::Class()){
+    if(label > fEvent->GetNumberOfTracks() ) return NULL;
+    return ((AliESDEvent*)fEvent)->GetTrack(label);
+  }
+
+  if(label == -999999) return NULL; // if AOD relabelling goes wrong, immediately return NULL
+  if(relabeledAOD){
+    if(fEvent->GetTrack(label)) return dynamic_cast<AliVTrack*>(fEvent->GetTrack(label));
+    return NULL;
+  }
+
+  if(!fTrackIDIndexBuilt) BuildTrackIDIndex();
+  std::vector<std::pair<Int_t,Int_t> >::const_iterator it =
+    std::lower_bound(fTrackIDIndex.begin(), fTrackIDIndex.end(), std::make_pair(label,0), TrackIDLess);
+  if(it == fTrackIDIndex.end() || it->first != label) return NULL;
+  return dynamic_cast<AliVTrack*>(fEvent->GetTrack(it->second));
+}
+
+//________________________________________________________________________
+void AliConversionPhotonFeatureTable::BuildV0Index(){
+  // Sorted track ID pairs of the V0s of the AOD, the order of the daughters is not relevant
+
+  fV0IndexBuilt = kTRUE;
+  AliAODEvent *aodEvent = dynamic_cast<AliAODEvent*>(fEvent);
+  if(!aodEvent) return;
+  fV0Index.reserve(aodEvent->GetNumberOfV0s());
+  for(Int_t iV=0; iV<aodEvent->GetNumberOfV0s(); iV++){
+    AliAODv0 *v0 = aodEvent->GetV0(iV);
+    if(!v0) continue;
+    Int_t posID = v0->GetPosID();
+    Int_t negID = v0->GetNegID();
+    fV0Index.push_back(std::make_pair(TMath::Min(posID,negID),TMath::Max(posID,negID)));
+  }
+  std::sort(fV0Index.begin(), fV0Index.end());
+}
+
+//________________________________________________________________________
+Bool_t AliConversionPhotonFeatureTable::HasAODV0(Int_t posID, Int_t negID){
+  // Checks whether a V0 with the two tracks is contained in the AOD
+
+  if(!fV0IndexBuilt) BuildV0Index();
+  return std::binary_search(fV0Index.begin(), fV0Index.end(), std::make_pair(TMath::Min(posID,negID),TMath::Max(posID,negID)));
+}
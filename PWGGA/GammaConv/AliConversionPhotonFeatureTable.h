@@ -0,0 +1,157 @@
+#ifndef ALICONVERSIONPHOTONFEATURETABLE_H
+#define ALICONVERSIONPHOTONFEATURETABLE_H
+
+#include <utility>
+#include <vector>
+#include "TObject.h"
+
+class AliVEvent;
+class AliVTrack;
+class TClonesArray;
+class AliConversionPhotonBase;
+class AliAODConversionPhoton;
+class AliConversionPhotonCuts;
+
+/**
+ * @class AliConversionPhotonFeatureTable
+ * @brief Per-event table of the photon candidates of a V0 reader and of the quantities the photon cuts select on
+ * @ingroup GammaConv
+ *
+ * The table is owned by the V0 reader. At the end of AliV0ReaderV1::ProcessEvent
+ * it is given the event and the reconstructed photons, one row per photon in the
+ * order of the reader array. On first use in the event it is filled column-wise
+ * with everything AliConversionPhotonCuts::SelectPhotonCandidate needs, which
+ * does not depend on the cut values:
+ *  - photon: momentum, R, Z, chi2/ndf, psi pair, cos(pointing angle), Armenteros
+ *    qt and alpha, DCA to the primary vertex, photon quality,
+ *  - per track: pt, p, eta, charge, TPC clusters, TPC n sigma (e, pi, K, p),
+ *    TOF and ITS electron n sigma, TPC electron probability and status flags,
+ *  - whether the tracks exist and whether an AOD V0 with the same tracks exists.
+ * Tracks, PID response and pointing angle are therefore evaluated once per event
+ * for all cut strings. The table also keeps the sorted track ID and V0 indices
+ * used for the label look-up on AODs which are not relabeled.
+ */
+class AliConversionPhotonFeatureTable : public TObject {
+  public:
+    /// Photon columns
+    enum EPhotonColumn {
+      kPx = 0,                ///< momentum when the table was filled, used to detect modified candidates
+      kPy,
+      kPz,
+      kE,
+      kPt,
+      kP,
+      kEta,
+      kPhi,
+      kR,
+      kZ,
+      kChi2,
+      kPsiPair,
+      kCosPA,
+      kQt,
+      kAlpha,
+      kDCAr,
+      kDCAz,
+      kQuality,
+      kKappa,
+      kNPhotonColumns
+    };
+
+    /// Columns of the two tracks of the photon
+    enum ETrackColumn {
+      kTrackPt = 0,
+      kTrackP,
+      kTrackEta,
+      kTrackCharge,
+      kTrackNcls,
+      kTrackClsToF,           ///< TPC clusters over findable clusters
+      kTrackCorrClsToF,       ///< TPC cluster info from the first TPC row after the conversion point
+      kTrackNSigmaTPCElectron,
+      kTrackNSigmaTPCPion,
+      kTrackNSigmaTPCKaon,
+      kTrackNSigmaTPCProton,
+      kTrackNSigmaTOFElectron,
+      kTrackNSigmaITSElectron,
+      kTrackTPCProbElectron,  ///< ESD only
+      kNTrackColumns
+    };
+
+    enum ELeg {
+      kNegative = 0,
+      kPositive,
+      kNLegs
+    };
+
+    /// Photon flags
+    enum EPhotonFlag {
+      kHasTracks  = 1<<0,     ///< both tracks were found
+      kOnFlyV0    = 1<<1,     ///< ESD V0 from the on-the-fly finder
+      kInAODV0s   = 1<<2      ///< the AOD contains a V0 with the same tracks
+    };
+
+    /// Track flags
+    enum ETrackFlag {
+      kTPCrefit   = 1<<0,
+      kKink       = 1<<1,     ///< kink daughter
+      kTOFpid     = 1<<2,     ///< TOF PID without mismatch
+      kITSpid     = 1<<3
+    };
+
+    AliConversionPhotonFeatureTable();
+    virtual ~AliConversionPhotonFeatureTable() {}
+
+    void              Reset();
+    void              SetCandidates(AliVEvent *event, TClonesArray *candidates);
+    void              Fill(AliConversionPhotonCuts *cuts);
+
+    AliVEvent*        GetEvent() const                                 {return fEvent;}
+    Long64_t          GetEventSerial() const                           {return fEventSerial;}
+    Bool_t            IsFilled() const                                 {return fFilled;}
+    Bool_t            IsESD() const                                    {return fIsESD;}
+    Bool_t            IsAOD() const                                    {return fIsAOD;}
+    Int_t             GetNCandidates() const                           {return fNRows;}
+    AliAODConversionPhoton* GetCandidate(Int_t row) const;
+    Int_t             FindCandidate(const AliConversionPhotonBase *photon) const;
+    Bool_t            IsCandidateUnchanged(Int_t row, const AliAODConversionPhoton *photon) const;
+
+    Double_t          GetValue(Int_t row, EPhotonColumn column) const  {return fPhotonColumns[column][row];}
+    Double_t          GetTrackValue(Int_t row, Int_t leg, ETrackColumn column) const {return fTrackColumns[leg][column][row];}
+    Bool_t            HasFlag(Int_t row, UInt_t flag) const            {return (fPhotonFlags[row] & flag) != 0;}
+    Bool_t            HasTrackFlag(Int_t row, Int_t leg, UInt_t flag) const {return (fTrackFlags[leg][row] & flag) != 0;}
+    AliVTrack*        GetCandidateTrack(Int_t row, Int_t leg) const    {return fTracks[leg][row];}
+
+    AliVTrack*        GetTrack(Int_t label, Bool_t relabeledAOD);
+    Bool_t            HasAODV0(Int_t posID, Int_t negID);
+
+  private:
+    AliConversionPhotonFeatureTable(const AliConversionPhotonFeatureTable &ref);
+    AliConversionPhotonFeatureTable &operator=(const AliConversionPhotonFeatureTable &ref);
+
+    void              FillTrack(AliConversionPhotonCuts *cuts, Int_t row, Int_t leg, AliVTrack *track, Double_t radius);
+    void              BuildTrackIDIndex();
+    void              BuildV0Index();
+
+    AliVEvent*                            fEvent;                   //!<! event the table is filled for
+    TClonesArray*                         fCandidates;              //!<! photons of the V0 reader, one per row
+    Long64_t                              fEventSerial;             //!<! incremented for each new event
+    Bool_t                                fFilled;                  //!<! columns are filled for this event
+    Bool_t                                fIsESD;                   //!<! event is an AliESDEvent
+    Bool_t                                fIsAOD;                   //!<! event is an AliAODEvent
+    Int_t                                 fNRows;                   //!<! number of candidates
+    std::vector<Double_t>                 fPhotonColumns[kNPhotonColumns];        //!<! photon columns
+    std::vector<Double_t>                 fTrackColumns[kNLegs][kNTrackColumns];  //!<! track columns
+    std::vector<UChar_t>                  fPhotonFlags;             //!<! EPhotonFlag bits of each row
+    std::vector<UChar_t>                  fTrackFlags[kNLegs];      //!<! ETrackFlag bits of each row
+    std::vector<AliVTrack*>               fTracks[kNLegs];          //!<! tracks of each row
+    std::vector<std::pair<const AliConversionPhotonBase*,Int_t> > fRowIndex; //!<! (photon, row) sorted in the photon pointer
+    std::vector<std::pair<Int_t,Int_t> >  fTrackIDIndex;            //!<! (track ID, position) sorted in ID, AODs only
+    Bool_t                                fTrackIDIndexBuilt;       //!<! fTrackIDIndex is filled for this event
+    std::vector<std::pair<Int_t,Int_t> >  fV0Index;                 //!<! sorted (min ID, max ID) of the tracks of the AOD V0s
+    Bool_t                                fV0IndexBuilt;            //!<! fV0Index is filled for this event
+
+    /// \cond CLASSIMP
+    ClassDef(AliConversionPhotonFeatureTable,2)
+    /// \endcond
+};
+
+#endif
@@ -58,6 +58,7 @@
 #include "AliKFConversionPhoton.h"
 #include "AliAODConversionPhoton.h"
 #include "AliConversionPhotonBase.h"
+#include "AliConversionPhotonFeatureTable.h"
 #include "TVector.h"
 #include "AliKFVertex.h"
 #include "AliAODTrack.h"
@@ -148,7 +149,8 @@ AliV0ReaderV1::AliV0ReaderV1(const char *name) : AliAnalysisTaskSE(name),
   fImpactParamTree(NULL),
   fVectorFoundGammas(0),
   fCurrentFileName(""),
-  fMCFileChecked(kFALSE)
+  fMCFileChecked(kFALSE),
+  fPhotonFeatureTable(NULL)
 {
   // Default constructor
 
@@ -166,6 +168,10 @@ AliV0ReaderV1::~AliV0ReaderV1()
     delete fConversionGammas;
     fConversionGammas=0x0;
   }
+  if(fPhotonFeatureTable){
+    delete fPhotonFeatureTable;
+    fPhotonFeatureTable=0x0;
+  }
 }
 
 /**
@@ -610,6 +616,11 @@ Bool_t AliV0ReaderV1::ProcessEvent(AliVEvent *inputEvent,AliMCEvent *mcEvent)
   //Clear TBits object with accepted v0s from previous event
   if (kAddv0sInESDFilter){fPCMv0BitField->Clear();}
 
+  //Invalidate the candidate table shared by the photon cuts of all tasks using this reader,
+  //it is given the new candidates once they are all reconstructed
+  if(!fPhotonFeatureTable) fPhotonFeatureTable = new AliConversionPhotonFeatureTable();
+  fPhotonFeatureTable->Reset();
+
   fInputEvent = inputEvent;
   fMCEvent    = mcEvent;
 
@@ -655,6 +666,8 @@ Bool_t AliV0ReaderV1::ProcessEvent(AliVEvent *inputEvent,AliMCEvent *mcEvent)
     GetAODConversionGammas();
   }
 
+  fPhotonFeatureTable->SetCandidates(fInputEvent,fConversionGammas);
+
   return kTRUE;
 }
 ///________________________________________________________________________
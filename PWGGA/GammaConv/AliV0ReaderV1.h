@@ -28,6 +28,7 @@ class TClonesArray;
 class TH1F;
 class TH2F;
 class AliAODConversionPhoton;
+class AliConversionPhotonFeatureTable;
 
 #if (__GNUC__ >= 3) && !defined(__INTEL_COMPILER)
 // gcc warns in level Weffc++ about non-virtual destructor
@@ -87,6 +88,7 @@ class AliV0ReaderV1 : public AliAnalysisTaskSE {
     AliConversionPhotonBase *operator[](int index) const;
 
     AliConversionPhotonCuts*  GetConversionCuts()                   {return fConversionCuts;}
+    AliConversionPhotonFeatureTable* GetPhotonFeatureTable() const  {return fPhotonFeatureTable;}
     AliConvEventCuts*         GetEventCuts()                        {return fEventCuts;}
     TList*                    GetCutHistograms()                    {if(fConversionCuts) {return fConversionCuts->GetCutHistograms();}
                                                                      return NULL;}
@@ -251,12 +253,13 @@ class AliV0ReaderV1 : public AliAnalysisTaskSE {
     vector<Int_t>  fVectorFoundGammas;            // vector with found MC labels of gammas
     TString       fCurrentFileName;               // current file name
     Bool_t        fMCFileChecked;                 // vector with MC file names which are broken
+    AliConversionPhotonFeatureTable *fPhotonFeatureTable; //! per-event photon candidate table shared by the photon cuts using this reader
 
   private:
     AliV0ReaderV1(AliV0ReaderV1 &original);
     AliV0ReaderV1 &operator=(const AliV0ReaderV1 &ref);
 
-    ClassDef(AliV0ReaderV1, 16)
+    ClassDef(AliV0ReaderV1, 17)
 
 };
 
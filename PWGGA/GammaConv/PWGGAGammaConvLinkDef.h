@@ -14,6 +14,9 @@
 #pragma link C++ class AliCaloPhotonCuts+;
 #pragma link C++ class AliConvEventCuts+;
 #pragma link C++ class AliConversionPhotonCuts+;
+#pragma link C++ class AliConversionPhotonFeatureTable+;
+#pragma link C++ class AliConversionPhotonCutMask+;
+#pragma link C++ class AliConversionMotherCache+;
 #pragma link C++ class AliConversionCuts+;
 #pragma link C++ class AliConversionSelection+;
 #pragma link C++ class AliV0ReaderV1+;
@@ -152,6 +152,14 @@ fOKInvMassLctoV0(kFALSE),
 fnTrksTotal(0),
 fnSeleTrksTotal(0),
 fMakeReducedRHF(kFALSE),
+fBenchmarkMode(kFALSE),
+fMaxTracksPairDCATable(1500),
+fPairDCATable(0x0),
+fPairDCATableSize(0),
+fPairDCANTrks(0),
+fnPairsTested(0),
+fnPairsDCAComputed(0),
+fnVerticesFitted(0),
 fMassDzero(0.),
 fMassDplus(0.),
 fMassDs(0.),
@@ -247,6 +255,14 @@ fOKInvMassLctoV0(source.fOKInvMassLctoV0),
 fnTrksTotal(0),
 fnSeleTrksTotal(0),
 fMakeReducedRHF(kFALSE),
+fBenchmarkMode(source.fBenchmarkMode),
+fMaxTracksPairDCATable(source.fMaxTracksPairDCATable),
+fPairDCATable(0x0),
+fPairDCATableSize(0),
+fPairDCANTrks(0),
+fnPairsTested(0),
+fnPairsDCAComputed(0),
+fnVerticesFitted(0),
 fMassDzero(source.fMassDzero),
 fMassDplus(source.fMassDplus),
 fMassDs(source.fMassDs),
@@ -338,6 +354,8 @@ AliAnalysisVertexingHF &AliAnalysisVertexingHF::operator=(const AliAnalysisVerte
   fOKInvMassDstar = source.fOKInvMassDstar;
   fOKInvMassD0to4p = source.fOKInvMassD0to4p;
   fOKInvMassLctoV0 = source.fOKInvMassLctoV0;
+  fBenchmarkMode = source.fBenchmarkMode;
+  fMaxTracksPairDCATable = source.fMaxTracksPairDCATable;
   fMassDzero = source.fMassDzero;
   fMassDplus = source.fMassDplus;
   fMassDs = source.fMassDs;
@@ -371,6 +389,7 @@ AliAnalysisVertexingHF::~AliAnalysisVertexingHF() {
   if(fMassCalc2) { delete fMassCalc2; fMassCalc2=0; }
   if(fMassCalc3) { delete fMassCalc3; fMassCalc3=0; }
   if(fMassCalc4) { delete fMassCalc4; fMassCalc4=0; }
+  if(fPairDCATable) { delete [] fPairDCATable; fPairDCATable=0; }
 }
 //----------------------------------------------------------------------------
 TList *AliAnalysisVertexingHF::FillListOfCuts() {
@@ -618,6 +637,20 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   AliDebug(1,Form(" Selected tracks: %d",nSeleTrks));
   fnSeleTrksTotal += nSeleTrks;
 
+  // The track-to-track DCAs needed by the 2-, 3- and 4-prong loops only depend
+  // on the two tracks (always taken at the primary vertex): index the displaced
+  // tracks and memoize the DCAs, so that each pair is computed only once
+  // instead of once per triplet/quadruplet
+  Int_t *pairDCAIndex = new Int_t[trkEntries];
+  Int_t  nDisplTrks = 0;
+  for(Int_t iTrk=0; iTrk<nSeleTrks; iTrk++) {
+    pairDCAIndex[iTrk] = (TESTBIT(seleFlags[iTrk],kBitDispl) ? nDisplTrks++ : -1);
+  }
+  ResetPairDCATable(nDisplTrks);
+  Long64_t nPairsTestedStart = fnPairsTested;
+  Long64_t nPairsDCAComputedStart = fnPairsDCAComputed;
+  Long64_t nVerticesFittedStart = fnVerticesFitted;
+
 
   TObjArray *twoTrackArray1    = new TObjArray(2);
   TObjArray *twoTrackArray2    = new TObjArray(2);
@@ -867,7 +900,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
       negtrack1->GetPxPyPz(momneg1);
 
       // DCA between the two tracks
-      dcap1n1 = postrack1->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
+      dcap1n1 = GetPairDCA(postrack1,pairDCAIndex[iTrkP1],negtrack1,pairDCAIndex[iTrkN1]);
       if(dcap1n1>dcaMax) { negtrack1=0; continue; }
 
       // Vertexing
@@ -1131,9 +1164,9 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
 	//printf("********** %d %d %d\n",postrack1->GetID(),postrack2->GetID(),negtrack1->GetID());
 
-	dcap2n1 = postrack2->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
+	dcap2n1 = GetPairDCA(postrack2,pairDCAIndex[iTrkP2],negtrack1,pairDCAIndex[iTrkN1]);
 	if(dcap2n1>dcaMax) { postrack2=0; continue; }
-	dcap1p2 = postrack2->GetDCA(postrack1,fBzkG,xdummy,ydummy);
+	dcap1p2 = GetPairDCA(postrack2,pairDCAIndex[iTrkP2],postrack1,pairDCAIndex[iTrkP1]);
 	if(dcap1p2>dcaMax) { postrack2=0; continue; }
 
 	// check invariant mass cuts for D+,Ds,Lc
@@ -1275,9 +1308,9 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    SetParametersAtVertex(postrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP2));
 	    SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 
-	    dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	    dcap1n2 = GetPairDCA(postrack1,pairDCAIndex[iTrkP1],negtrack2,pairDCAIndex[iTrkN2]);
 	    if(dcap1n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
-            dcap2n2 = postrack2->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+            dcap2n2 = GetPairDCA(postrack2,pairDCAIndex[iTrkP2],negtrack2,pairDCAIndex[iTrkN2]);
             if(dcap2n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
 
 
@@ -1409,9 +1442,9 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 	//printf("********** %d %d %d\n",postrack1->GetID(),negtrack1->GetID(),negtrack2->GetID());
 
-	dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	dcap1n2 = GetPairDCA(postrack1,pairDCAIndex[iTrkP1],negtrack2,pairDCAIndex[iTrkN2]);
 	if(dcap1n2>dcaMax) { negtrack2=0; continue; }
-	dcan1n2 = negtrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	dcan1n2 = GetPairDCA(negtrack1,pairDCAIndex[iTrkN1],negtrack2,pairDCAIndex[iTrkN2]);
 	if(dcan1n2>dcaMax) { negtrack2=0; continue; }
 
 	threeTrackArray->AddAt(negtrack1,0);
@@ -1546,8 +1579,15 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   fourTrackArray->Delete();  delete fourTrackArray;
   delete [] seleFlags; seleFlags=NULL;
   if(evtNumber) {delete [] evtNumber; evtNumber=NULL;}
+  delete [] pairDCAIndex; pairDCAIndex=NULL;
   tracksAtVertex.Delete();
 
+  if(fBenchmarkMode) {
+    printf("AliAnalysisVertexingHF: %d selected tracks, %lld pairs tested (DCA computed for %lld), %lld vertex fits\n",
+	   nSeleTrks,fnPairsTested-nPairsTestedStart,fnPairsDCAComputed-nPairsDCAComputedStart,
+	   fnVerticesFitted-nVerticesFittedStart);
+  }
+
   if(fInputAOD) {
     seleTrksArray.Delete();
     if(fAODMap) { delete [] fAODMap; fAODMap=NULL; }
@@ -2937,6 +2977,11 @@ void AliAnalysisVertexingHF::PrintStatus() const {
     printf("  Ds -> K0s K cuts:\n");
     if(fCutsDstoK0sK) fCutsDstoK0sK->PrintAll();
   }
+  printf("Track-to-track DCAs memoized for up to %d displaced tracks\n",fMaxTracksPairDCATable);
+  if(fBenchmarkMode) {
+    printf("Benchmark: %d tracks, %d selected, %lld pairs tested (DCA computed for %lld), %lld vertex fits\n",
+	   fnTrksTotal,fnSeleTrksTotal,fnPairsTested,fnPairsDCAComputed,fnVerticesFitted);
+  }
 
   return;
 }
@@ -2949,6 +2994,7 @@ AliAODVertex* AliAnalysisVertexingHF::ReconstructSecondaryVertex(TObjArray *trkA
 
   AliESDVertex *vertexESD = 0;
   AliAODVertex *vertexAOD = 0;
+  fnVerticesFitted++;
 
   if(!fSecVtxWithKF) { // AliVertexerTracks
 
@@ -3699,6 +3745,42 @@ void AliAnalysisVertexingHF::SetParametersAtVertex(AliESDtrack* esdt, const AliE
   return;
 }
 //-----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::ResetPairDCATable(Int_t nTrks){
+  /// Prepare the table of track-to-track DCAs for nTrks displaced tracks.
+  /// The table is not used (DCAs always recomputed) above fMaxTracksPairDCATable
+  /// tracks, to limit the memory (nTrks*nTrks doubles)
+
+  fPairDCANTrks=0;
+  if(nTrks<2 || nTrks>fMaxTracksPairDCATable) return;
+  Int_t size=nTrks*nTrks;
+  if(size>fPairDCATableSize) {
+    delete [] fPairDCATable;
+    fPairDCATable = new Double_t[size];
+    fPairDCATableSize=size;
+  }
+  for(Int_t i=0; i<size; i++) fPairDCATable[i]=-1.;
+  fPairDCANTrks=nTrks;
+  return;
+}
+//-----------------------------------------------------------------------------
+Double_t AliAnalysisVertexingHF::GetPairDCA(AliESDtrack *trk1,Int_t index1,AliESDtrack *trk2,Int_t index2){
+  /// DCA between trk1 and trk2 (both with parameters at primary vertex),
+  /// taken from the table of the current event if already computed.
+  /// index1 and index2 are the positions of the tracks in the table (-1 if not there)
+
+  fnPairsTested++;
+  Double_t *stored=0x0;
+  if(fPairDCANTrks>0 && index1>=0 && index2>=0) {
+    stored=&fPairDCATable[index1*fPairDCANTrks+index2];
+    if(*stored>=0.) return *stored;
+  }
+  fnPairsDCAComputed++;
+  Double_t xdummy,ydummy;
+  Double_t dca=trk1->GetDCA(trk2,fBzkG,xdummy,ydummy);
+  if(stored) *stored=dca;
+  return dca;
+}
+//-----------------------------------------------------------------------------
 void AliAnalysisVertexingHF::SetMasses(){
   /// Set the hadron mass values from TDatabasePDG
 
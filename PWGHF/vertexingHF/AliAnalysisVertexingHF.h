@@ -94,6 +94,8 @@ class AliAnalysisVertexingHF : public TNamed {
   void SetMixEventOff() { fMixEvent=kFALSE; }
   void SetInputAOD() { fInputAOD=kTRUE; }
   void SetMakeReducedRHF(Bool_t makeredAOD=kFALSE) { fMakeReducedRHF=makeredAOD; }
+  void SetBenchmarkMode(Bool_t bench=kTRUE) { fBenchmarkMode=bench; }
+  void SetMaxTracksForPairDCATable(Int_t ntrk) { fMaxTracksPairDCATable=ntrk; }
   Bool_t GetD0toKpi() const { return fD0toKpi; }
   Bool_t GetJPSItoEle() const { return fJPSItoEle; }
   Bool_t Get3Prong() const { return f3Prong; }
@@ -107,6 +109,11 @@ class AliAnalysisVertexingHF : public TNamed {
   Bool_t GetRecoPrimVtxSkippingTrks() const {return fRecoPrimVtxSkippingTrks;}
   Bool_t GetRmTrksFromPrimVtx() const {return fRmTrksFromPrimVtx;}
   Bool_t GetMakeReducedRHF() const {return fMakeReducedRHF;}
+  Bool_t GetBenchmarkMode() const {return fBenchmarkMode;}
+  Int_t  GetMaxTracksForPairDCATable() const {return fMaxTracksPairDCATable;}
+  Long64_t GetNPairsTested() const {return fnPairsTested;}
+  Long64_t GetNPairsDCAComputed() const {return fnPairsDCAComputed;}
+  Long64_t GetNVerticesFitted() const {return fnVerticesFitted;}
   void SetFindVertexForDstar(Bool_t vtx=kTRUE) { fFindVertexForDstar=vtx; }
   void SetFindVertexForCascades(Bool_t vtx=kTRUE) { fFindVertexForCascades=vtx; }
 
@@ -340,6 +347,14 @@ class AliAnalysisVertexingHF : public TNamed {
   Int_t  fnTrksTotal;
   Int_t  fnSeleTrksTotal;
   Bool_t fMakeReducedRHF;// switch the reduction of dAOD size on/off
+  Bool_t fBenchmarkMode; /// print the number of tested pairs and vertex fits for each event
+  Int_t  fMaxTracksPairDCATable; /// max number of displaced tracks for which the track-to-track DCAs are memoized
+  Double_t *fPairDCATable; //! [fPairDCATableSize] track-to-track DCAs of the current event (-1: not computed yet)
+  Int_t  fPairDCATableSize; //! allocated size of fPairDCATable
+  Int_t  fPairDCANTrks; //! number of displaced tracks in fPairDCATable (0: table not used)
+  Long64_t fnPairsTested; //! track pairs tested with the DCA cut
+  Long64_t fnPairsDCAComputed; //! track pairs for which the DCA was computed
+  mutable Long64_t fnVerticesFitted; //! calls to the secondary vertex fit
 
   Double_t fMassDzero;
   Double_t fMassDplus;
@@ -411,6 +426,8 @@ class AliAnalysisVertexingHF : public TNamed {
 				   Int_t &nSeleTrks,
 				   UChar_t *seleFlags,Int_t *evtNumber);
   void SetParametersAtVertex(AliESDtrack* esdt, const AliExternalTrackParam* extpar) const;
+  void ResetPairDCATable(Int_t nTrks);
+  Double_t GetPairDCA(AliESDtrack *trk1,Int_t index1,AliESDtrack *trk2,Int_t index2);
 
   Bool_t SingleTrkCuts(AliESDtrack *trk,Float_t centralityperc, Bool_t &okDisplaced,Bool_t &okSoftPi, Bool_t &ok3prong, Bool_t &okBachelor) const;
 
@@ -420,7 +437,7 @@ class AliAnalysisVertexingHF : public TNamed {
 				  TObjArray *twoTrackArrayV0);
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisVertexingHF,27);  // Reconstruction of HF decay candidates
+  ClassDef(AliAnalysisVertexingHF,28);  // Reconstruction of HF decay candidates
   /// \endcond
 };
 
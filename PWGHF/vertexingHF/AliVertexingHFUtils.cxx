@@ -28,6 +28,7 @@
 #include "AliAODMCParticle.h"
 #include "AliAODRecoDecayHF.h"
 #include "AliVertexingHFUtils.h"
+#include "AliEventShapeCalculator.h"
 
 /* $Id$ */
 
@@ -2111,12 +2112,7 @@ Double_t AliVertexingHFUtils::GetSphericity(AliAODEvent* aod,
   /// compute sphericity
 
   Int_t nTracks=aod->GetNumberOfTracks();
-  Int_t nSelTracks=0;
-
-  Double_t sumpt=0.;
-  Double_t s00=0.;
-  Double_t s01=0.;
-  Double_t s11=0.;
+  AliEventShapeCalculator shape;
   if(ptMin<0.) ptMin=0.;
 
   for(Int_t it=0; it<nTracks; it++) {
@@ -2133,29 +2129,12 @@ Double_t AliVertexingHFUtils::GetSphericity(AliAODEvent* aod,
     if(filtbit1==1 && !tpcRefit) fb1=kFALSE;
     if(filtbit2==1 && !tpcRefit) fb2=kFALSE;
     if( !(fb1 || fb2) ) continue;
-    Double_t px=pt*TMath::Cos(phi);
-    Double_t py=pt*TMath::Sin(phi);
-    s00 += (px * px)/pt;
-    s01 += (py * px)/pt;
-    s11 += (py * py)/pt;
-    nSelTracks++;
-    sumpt+=pt;
+    shape.AddTrack(pt,phi);
   }
 
-  if(nSelTracks<minMult) return -0.5;
-
-  if(sumpt>0.){
-    s00/=sumpt;
-    s01/=sumpt;
-    s11/=sumpt;
-  }else return -0.5;
-
-  Double_t sphericity = -10;
-  Double_t lambda1=((s00+s11)+TMath::Sqrt((s00+s11)*(s00+s11)-4*(s00*s11-s01*s01)))/2.;
-  Double_t lambda2=((s00+s11)-TMath::Sqrt((s00+s11)*(s00+s11)-4*(s00*s11-s01*s01)))/2.;
-  if(TMath::Abs(lambda2)<0.00001 && TMath::Abs(lambda1)<0.00001) sphericity=0;
-  if(TMath::Abs(lambda1+lambda2)>0.000001) sphericity=2*TMath::Min(lambda1,lambda2)/(lambda1+lambda2);
-  return sphericity;
+  if(shape.GetNTracks()<minMult) return -0.5;
+  if(!(shape.GetSumPt()>0.)) return -0.5;
+  return shape.GetSphericity();
 
 }
 
@@ -2165,17 +2144,15 @@ void AliVertexingHFUtils::GetSpherocity(AliAODEvent* aod,
                                         Double_t etaMin, Double_t etaMax,
                                         Double_t ptMin, Double_t ptMax,
                                         Int_t filtbit1, Int_t filtbit2,
-                                        Int_t minMult, Double_t phiStepSizeDeg,
+                                        Int_t minMult, Double_t /*phiStepSizeDeg*/,
                                         Int_t nTrksToSkip, Int_t* idToSkip
                                         ){
   /// compute spherocity
+  /// the minimizing axis phiRef, in [0,pi), is found exactly by
+  /// AliEventShapeCalculator: phiStepSizeDeg is not used
 
   Int_t nTracks=aod->GetNumberOfTracks();
-  Int_t nSelTracks=0;
-
-  Double_t* ptArr=new Double_t[nTracks];
-  Double_t* phiArr=new Double_t[nTracks];
-  Double_t sumpt=0.;
+  AliEventShapeCalculator shape;
 
   for(Int_t it=0; it<nTracks; it++) {
     AliAODTrack *tr=dynamic_cast<AliAODTrack*>(aod->GetTrack(it));
@@ -2199,37 +2176,13 @@ void AliVertexingHFUtils::GetSpherocity(AliAODEvent* aod,
     if(filtbit1==1 && !tpcRefit) fb1=kFALSE;
     if(filtbit2==1 && !tpcRefit) fb2=kFALSE;
     if( !(fb1 || fb2) ) continue;
-    ptArr[nSelTracks]=pt;
-    phiArr[nSelTracks]=phi;
-    nSelTracks++;
-    sumpt+=pt;
-  }
-
-  if(nSelTracks<minMult){spherocity = -0.5; return;}
-
-  //Getting thrust
-  spherocity=2.;
-  for(Int_t i=0; i<360/phiStepSizeDeg; ++i){
-    Double_t phistep=TMath::Pi()*(Double_t)i*phiStepSizeDeg/180.;
-    Double_t nx=TMath::Cos(phistep);
-    Double_t ny=TMath::Sin(phistep);
-    Double_t numer=0.;
-    for(Int_t j=0; j<nSelTracks; ++j){
-      Double_t pxA=ptArr[j]*TMath::Cos(phiArr[j]);  // x component of an unitary vector n
-      Double_t pyA=ptArr[j]*TMath::Sin(phiArr[j]);  // y component of an unitary vector n
-      numer+=TMath::Abs(ny*pxA - nx*pyA);
-    }
-    Double_t pFull=numer*numer/(sumpt*sumpt);
-    if(pFull<spherocity){
-        spherocity=pFull; // minimization;
-        phiRef=phistep;
-    }
+    shape.AddTrack(pt,phi);
   }
 
-  delete [] ptArr;
-  delete [] phiArr;
+  if(shape.GetNTracks()<minMult || !(shape.GetSumPt()>0.)){spherocity = -0.5; return;}
 
-  spherocity*=(TMath::Pi()*TMath::Pi()/4.);
+  spherocity=shape.GetSpherocity();
+  phiRef=shape.GetSpherocityAxis();
   return;
 
 }
@@ -2238,16 +2191,14 @@ void AliVertexingHFUtils::GetGeneratedSpherocity(TClonesArray *arrayMC,
                                                  Double_t &spherocity, Double_t &phiRef,
                                                  Double_t etaMin, Double_t etaMax,
                                                  Double_t ptMin, Double_t ptMax,
-                                                 Int_t minMult, Double_t phiStepSizeDeg){
+                                                 Int_t minMult, Double_t /*phiStepSizeDeg*/){
 
   /// compute generated spherocity
+  /// the minimizing axis phiRef, in [0,pi), is found exactly by
+  /// AliEventShapeCalculator: phiStepSizeDeg is not used
 
   Int_t nParticles=arrayMC->GetEntriesFast();
-  Int_t nSelParticles=0;
-
-  Double_t* ptArr=new Double_t[nParticles];
-  Double_t* phiArr=new Double_t[nParticles];
-  Double_t sumpt=0.;
+  AliEventShapeCalculator shape;
 
   for(Int_t ip=0; ip<nParticles; ip++) {
     AliAODMCParticle *part=(AliAODMCParticle*)arrayMC->UncheckedAt(ip);
@@ -2261,38 +2212,13 @@ void AliVertexingHFUtils::GetGeneratedSpherocity(TClonesArray *arrayMC,
     if(charge==0) continue;
     if(eta<etaMin || eta>etaMax) continue;
     if(pt<ptMin || pt>ptMax) continue;
-
-    ptArr[nSelParticles]=pt;
-    phiArr[nSelParticles]=phi;
-    nSelParticles++;
-    sumpt+=pt;
-  }
-
-  if(nSelParticles<minMult){spherocity = -0.5; return;}
-
-  //Getting thrust
-  spherocity=2.;
-  for(Int_t i=0; i<360/phiStepSizeDeg; ++i){
-    Double_t phistep=TMath::Pi()*(Double_t)i*phiStepSizeDeg/180.;
-    Double_t nx=TMath::Cos(phistep);
-    Double_t ny=TMath::Sin(phistep);
-    Double_t numer=0.;
-    for(Int_t j=0; j<nSelParticles; ++j){
-      Double_t pxA=ptArr[j]*TMath::Cos(phiArr[j]);  // x component of an unitary vector n
-      Double_t pyA=ptArr[j]*TMath::Sin(phiArr[j]);  // y component of an unitary vector n
-      numer+=TMath::Abs(ny*pxA - nx*pyA);
-    }
-    Double_t pFull=numer*numer/(sumpt*sumpt);
-    if(pFull<spherocity){
-        spherocity=pFull; // minimization;
-        phiRef=phistep;
-    }
+    shape.AddTrack(pt,phi);
   }
 
-  delete [] ptArr;
-  delete [] phiArr;
+  if(shape.GetNTracks()<minMult || !(shape.GetSumPt()>0.)){spherocity = -0.5; return;}
 
-  spherocity*=(TMath::Pi()*TMath::Pi()/4.);
+  spherocity=shape.GetSpherocity();
+  phiRef=shape.GetSpherocityAxis();
   return;
 
 }
@@ -13,6 +13,7 @@
  * provided "as is" without express or implied warranty.                  *
  **************************************************************************/
 
+#include <algorithm>
 #include <vector>
 
 #include <TClonesArray.h>
@@ -50,6 +51,22 @@ ClassImp(AliEmcalJetTask);
 
 const Int_t AliEmcalJetTask::fgkConstIndexShift = 100000;
 
+namespace {
+  /// Registry of jet tasks offering their clustering results to other jet tasks
+  typedef std::vector<const AliEmcalJetTask *> SharedClusteringRegistry_t;
+
+  SharedClusteringRegistry_t &GetSharedClusteringRegistry() {
+    static SharedClusteringRegistry_t registry;
+    return registry;
+  }
+
+  /// Get the current entry of the analysis manager, used to identify the event (-1 if not available)
+  Long64_t GetClusteringEventStamp() {
+    AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+    return mgr ? mgr->GetCurrentEntry() : -1;
+  }
+}
+
 /**
  * Default constructor. This constructor is only for ROOT I/O and
  * not to be used by users.
@@ -79,8 +96,15 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fIsEmcPart(0),
   fLegacyMode(kFALSE),
   fFillGhost(kFALSE),
+  fShareClustering(kTRUE),
   fJets(0),
   fFastJetWrapper("AliEmcalJetTask","AliEmcalJetTask"),
+  fClusteringResult(0),
+  fClusteringEventStamp(-1),
+  fSortedJetIndexes(),
+  fConstituentBuffer(),
+  fNJetSlots(0),
+  fNAllocations(0),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap()
 {
@@ -115,8 +139,15 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fIsEmcPart(0),
   fLegacyMode(kFALSE),
   fFillGhost(kFALSE),
+  fShareClustering(kTRUE),
   fJets(0),
   fFastJetWrapper(name,name),
+  fClusteringResult(0),
+  fClusteringEventStamp(-1),
+  fSortedJetIndexes(),
+  fConstituentBuffer(),
+  fNJetSlots(0),
+  fNAllocations(0),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap()
 {
@@ -127,6 +158,8 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
  */
 AliEmcalJetTask::~AliEmcalJetTask()
 {
+  SharedClusteringRegistry_t &registry = GetSharedClusteringRegistry();
+  registry.erase(std::remove(registry.begin(), registry.end(), this), registry.end());
 }
 
 /**
@@ -234,6 +267,8 @@ Int_t AliEmcalJetTask::FindJets()
   }
 
   fFastJetWrapper.Clear();
+  fClusteringResult = 0;
+  fClusteringEventStamp = GetClusteringEventStamp();
 
   AliDebug(2,Form("Jet type = %d", fJetType));
 
@@ -278,43 +313,128 @@ Int_t AliEmcalJetTask::FindJets()
 
   if (fFastJetWrapper.GetInputVectors().size() == 0) return 0;
 
-  // run jet finder
-  fFastJetWrapper.Run();
+  // run jet finder, unless the same clustering was already done by another jet task in this event
+  fClusteringResult = FindSharedClustering();
+  if (fClusteringResult) {
+    AliDebug(2,"Using clustering result shared by another jet task");
+  }
+  else {
+    // a failed clustering is not offered to other jet tasks
+    if (fFastJetWrapper.Run() != 0) fClusteringEventStamp = -1;
+    fClusteringResult = &fFastJetWrapper;
+  }
+
+  return fClusteringResult->GetInclusiveJets().size();
+}
 
-  return fFastJetWrapper.GetInclusiveJets().size();
+/**
+ * Check whether the clustering of this task can be shared with other jet tasks.
+ * Tasks with jet utilities are excluded, as the utilities work on the FastJet
+ * wrapper of the task. Sharing also requires a valid event stamp.
+ * @return kTRUE if the clustering can be shared
+ */
+Bool_t AliEmcalJetTask::CanShareClustering() const
+{
+  if (!fShareClustering) return kFALSE;
+  if (fUtilities && fUtilities->GetEntries()) return kFALSE;
+  return fClusteringEventStamp >= 0;
+}
+
+/**
+ * Check whether another jet task performs the same clustering as this task,
+ * meaning same jet definition and identical input vectors (momenta and user indices).
+ * @param other Jet task to compare to
+ * @return kTRUE if the clustering is the same
+ */
+Bool_t AliEmcalJetTask::HasSameClustering(const AliEmcalJetTask &other) const
+{
+  if (other.fJetAlgo != fJetAlgo || other.fRecombScheme != fRecombScheme || other.fLegacyMode != fLegacyMode) return kFALSE;
+  if (TMath::Abs(other.fRadius - fRadius) > 1e-6 || TMath::Abs(other.fGhostArea - fGhostArea) > 1e-9) return kFALSE;
+
+  const std::vector<fastjet::PseudoJet> &inputs = fFastJetWrapper.GetInputVectors();
+  const std::vector<fastjet::PseudoJet> &otherInputs = other.fFastJetWrapper.GetInputVectors();
+  if (inputs.size() != otherInputs.size()) return kFALSE;
+  for (UInt_t i = 0; i < inputs.size(); i++) {
+    if (inputs[i].user_index() != otherInputs[i].user_index()) return kFALSE;
+    if (inputs[i].px() != otherInputs[i].px() || inputs[i].py() != otherInputs[i].py() ||
+        inputs[i].pz() != otherInputs[i].pz() || inputs[i].E() != otherInputs[i].E()) return kFALSE;
+  }
+  return kTRUE;
+}
+
+/**
+ * Look for a jet task which already clustered the current event with the same
+ * jet definition and the same input vectors. Only tasks which ran the clustering
+ * themselves in the current event are considered.
+ * @return FastJet wrapper holding the clustering result (NULL if not found)
+ */
+const AliFJWrapper *AliEmcalJetTask::FindSharedClustering() const
+{
+  if (!CanShareClustering()) return 0;
+
+  for (auto task : GetSharedClusteringRegistry()) {
+    if (task == this) continue;
+    if (task->fClusteringEventStamp != fClusteringEventStamp) continue;
+    if (task->fClusteringResult != &task->fFastJetWrapper) continue;
+    if (!task->CanShareClustering()) continue;
+    if (!HasSameClustering(*task)) continue;
+    return &task->fFastJetWrapper;
+  }
+
+  return 0;
 }
 
 /**
  * This method fills the jet output branch (TClonesArray) with the jet found by the FastJet
  * wrapper. Before filling the jet branch, the utilities are prepared. Then the utilities are
  * called for each jet and finally after jet finding the terminate method of all utilities is called.
+ *
+ * The inclusive jets are accessed by reference, sorted via an index permutation and
+ * the constituents are retrieved into a buffer reused for all jets. Together with the
+ * output array keeping the memory of its jet objects, no buffer owned by the task is
+ * reallocated once the largest event has been seen. Reallocations are counted in
+ * fNAllocations (see GetNAllocations()).
  */
 void AliEmcalJetTask::FillJetBranch()
 {
   PrepareUtilities();
 
   // loop over fastjet jets
-  std::vector<fastjet::PseudoJet> jets_incl = fFastJetWrapper.GetInclusiveJets();
+  const std::vector<fastjet::PseudoJet> &jets_incl = fClusteringResult->GetInclusiveJets();
   // sort jets according to jet pt
-  static Int_t indexes[9999] = {-1};
-  GetSortedArray(indexes, jets_incl);
+  std::size_t capacity = fSortedJetIndexes.capacity();
+  GetSortedArray(fSortedJetIndexes, jets_incl);
+  if (fSortedJetIndexes.capacity() != capacity) fNAllocations++;
+
+  // pre-size the output array to the maximum number of jets
+  if ((Int_t)jets_incl.size() > fJets->GetSize()) {
+    fJets->Expand(jets_incl.size());
+    fNAllocations++;
+  }
 
   AliDebug(1,Form("%d jets found", (Int_t)jets_incl.size()));
   for (UInt_t ijet = 0, jetCount = 0; ijet < jets_incl.size(); ++ijet) {
-    Int_t ij = indexes[ijet];
-    AliDebug(3,Form("Jet pt = %f, area = %f", jets_incl[ij].perp(), fFastJetWrapper.GetJetArea(ij)));
-
-    if (jets_incl[ij].perp() < fMinJetPt) continue;
-    if (fFastJetWrapper.GetJetArea(ij) < fMinJetArea) continue;
-    if ((jets_incl[ij].eta() < fJetEtaMin) || (jets_incl[ij].eta() > fJetEtaMax) ||
-        (jets_incl[ij].phi() < fJetPhiMin) || (jets_incl[ij].phi() > fJetPhiMax))
+    Int_t ij = fSortedJetIndexes[ijet];
+    const fastjet::PseudoJet &fjjet = jets_incl[ij];
+    Double_t jetArea = fClusteringResult->GetJetArea(ij);
+    AliDebug(3,Form("Jet pt = %f, area = %f", fjjet.perp(), jetArea));
+
+    if (fjjet.perp() < fMinJetPt) continue;
+    if (jetArea < fMinJetArea) continue;
+    if ((fjjet.eta() < fJetEtaMin) || (fjjet.eta() > fJetEtaMax) ||
+        (fjjet.phi() < fJetPhiMin) || (fjjet.phi() > fJetPhiMax))
       continue;
 
+    // the output array keeps the memory of the jet objects deleted in the previous events
+    if ((Int_t)jetCount >= fNJetSlots) {
+      fNJetSlots = jetCount + 1;
+      fNAllocations++;
+    }
     AliEmcalJet *jet = new ((*fJets)[jetCount])
-    		          AliEmcalJet(jets_incl[ij].perp(), jets_incl[ij].eta(), jets_incl[ij].phi(), jets_incl[ij].m());
+    		          AliEmcalJet(fjjet.perp(), fjjet.eta(), fjjet.phi(), fjjet.m());
     jet->SetLabel(ij);
 
-    fastjet::PseudoJet area(fFastJetWrapper.GetJetAreaVector(ij));
+    fastjet::PseudoJet area(fClusteringResult->GetJetAreaVector(ij));
     jet->SetArea(area.perp());
     jet->SetAreaEta(area.eta());
     jet->SetAreaPhi(area.phi());
@@ -322,8 +442,10 @@ void AliEmcalJetTask::FillJetBranch()
     jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), fRadius));
 
     // Fill constituent info
-    std::vector<fastjet::PseudoJet> constituents(fFastJetWrapper.GetJetConstituents(ij));
-    FillJetConstituents(jet, constituents, constituents);
+    capacity = fConstituentBuffer.capacity();
+    fClusteringResult->GetJetConstituents(ij, fConstituentBuffer);
+    if (fConstituentBuffer.capacity() != capacity) fNAllocations++;
+    FillJetConstituents(jet, fConstituentBuffer, fConstituentBuffer);
 
     if (fGeom) {
       if ((jet->Phi() > fGeom->GetArm1PhiMin() * TMath::DegToRad()) &&
@@ -339,28 +461,33 @@ void AliEmcalJetTask::FillJetBranch()
     jetCount++;
   }
 
+  AliDebug(2,Form("Buffer allocations so far: %llu", fNAllocations));
+
   TerminateUtilities();
 }
 
 /**
- * Sorts jets by pT (decreasing)
- * @param[out] indexes This array is used to return the indexes of the jets ordered by pT
+ * Sorts jets by pT (decreasing). Jets with the same pT are kept in the original order.
+ * The sorting is done on an index permutation, the jets are not copied.
+ * @param[out] indexes This vector is used to return the indexes of the jets ordered by pT (its capacity is reused)
  * @param[in] array Vector containing the list of jets obtained by the FastJet wrapper
  * @return kTRUE if at least one jet was found in array; kFALSE otherwise
  */
-Bool_t AliEmcalJetTask::GetSortedArray(Int_t indexes[], std::vector<fastjet::PseudoJet> array) const
+Bool_t AliEmcalJetTask::GetSortedArray(std::vector<Int_t> &indexes, const std::vector<fastjet::PseudoJet> &array) const
 {
-  static Float_t pt[9999] = {0};
-
   const Int_t n = (Int_t)array.size();
+  indexes.resize(n);
 
   if (n < 1)
     return kFALSE;
 
   for (Int_t i = 0; i < n; i++)
-    pt[i] = array[i].perp();
+    indexes[i] = i;
 
-  TMath::Sort(n, pt, indexes);
+  std::sort(indexes.begin(), indexes.end(), [&array](Int_t i, Int_t j) {
+    Double_t pt2i = array[i].pt2(), pt2j = array[j].pt2();
+    return pt2i > pt2j || (pt2i == pt2j && i < j);
+  });
 
   return kTRUE;
 }
@@ -419,6 +546,11 @@ void AliEmcalJetTask::ExecOnce()
 
   InitUtilities();
 
+  if (fShareClustering) {
+    SharedClusteringRegistry_t &registry = GetSharedClusteringRegistry();
+    if (std::find(registry.begin(), registry.end(), this) == registry.end()) registry.push_back(this);
+  }
+
   AliAnalysisTaskEmcal::ExecOnce();
 
   // Setup container utils. Must be called after AliAnalysisTaskEmcal::ExecOnce() so that the
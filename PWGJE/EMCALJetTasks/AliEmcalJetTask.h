@@ -44,6 +44,17 @@ namespace fastjet {
  * and its derived classes. Utilities can be added via the AddUtility(AliEmcalJetUtility*) method.
  * All the utilities added in the list will be executed. Users can implement new utilities
  * deriving a new class from AliEmcalJetUtility to interface functionalities of the FastJet contribs.
+ *
+ * Several jet finder instances in the same train often run the same clustering
+ * (e.g. kT jets for the different rho tasks) on identical input. If the sharing of
+ * the clustering is enabled (default, see SetShareClustering), a jet task looks for
+ * another jet task which already clustered the current event with the same jet
+ * definition (algorithm, radius, recombination scheme, ghost area, legacy mode) and
+ * exactly the same input vectors. If found, the cluster sequence, the inclusive jets
+ * and the jet areas of that task are used instead of running the clustering again.
+ * Output cuts (min. jet pt, min. area, eta-phi range) are applied by each task
+ * separately. Tasks with jet utilities never share their clustering, as utilities
+ * operate on the FastJet wrapper of the task.
  */
 class AliEmcalJetTask : public AliAnalysisTaskEmcal {
  public:
@@ -79,6 +90,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   void                   SetLegacyMode(Bool_t mode)                 { if (IsLocked()) return; fLegacyMode       = mode  ; }
   void                   SetFillGhost(Bool_t b=kTRUE)               { if (IsLocked()) return; fFillGhost        = b     ; }
   void                   SetRadius(Double_t r)                      { if (IsLocked()) return; fRadius           = r     ; }
+  void                   SetShareClustering(Bool_t b)               { if (IsLocked()) return; fShareClustering  = b     ; }
 
   void                   SetEtaRange(Double_t emi, Double_t ema);
   void                   SetMinJetClusPt(Double_t min);
@@ -105,6 +117,8 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Int_t                  GetRecombScheme()                { return fRecombScheme      ; }
   Double_t               GetTrackEfficiency()             { return fTrackEfficiency   ; }
   Bool_t                 GetTrackEfficiencyOnlyForEmbedding() { return fTrackEfficiencyOnlyForEmbedding; }
+  Bool_t                 GetShareClustering() const       { return fShareClustering   ; }
+  ULong64_t              GetNAllocations() const          { return fNAllocations      ; }
 
   TClonesArray*          GetJets()                        { return fJets              ; }
   TObjArray*             GetUtilities()                   { return fUtilities         ; }
@@ -159,7 +173,10 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   void                   PrepareUtilities();
   void                   ExecuteUtilities(AliEmcalJet* jet, Int_t ij);
   void                   TerminateUtilities();
-  Bool_t                 GetSortedArray(Int_t indexes[], std::vector<fastjet::PseudoJet> array) const;
+  Bool_t                 GetSortedArray(std::vector<Int_t> &indexes, const std::vector<fastjet::PseudoJet> &array) const;
+  Bool_t                 CanShareClustering() const;
+  Bool_t                 HasSameClustering(const AliEmcalJetTask &other) const;
+  const AliFJWrapper    *FindSharedClustering() const;
   Bool_t                 IsJetInEmcal(Double_t eta, Double_t phi, Double_t r);
   Bool_t                 IsJetInDcal(Double_t eta, Double_t phi, Double_t r);
   Bool_t                 IsJetInDcalOnly(Double_t eta, Double_t phi, Double_t r);
@@ -190,9 +207,16 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Bool_t                 fIsEmcPart;              //!<!=true if emcal particles are given as input (for clusters)
   Bool_t                 fLegacyMode;             //!<!=true to enable FJ 2.x behavior
   Bool_t                 fFillGhost;              ///< =true ghost particles will be filled in AliEmcalJet obj
+  Bool_t                 fShareClustering;        ///< =true clustering results are shared with jet tasks with identical jet definition and input
 
   TClonesArray          *fJets;                   //!<!jet collection
   AliFJWrapper           fFastJetWrapper;         //!<!fastjet wrapper
+  const AliFJWrapper    *fClusteringResult;       //!<!wrapper holding the clustering of the current event (own or shared from another jet task)
+  Long64_t               fClusteringEventStamp;   //!<!event stamp of the clustering result
+  std::vector<Int_t>     fSortedJetIndexes;       //!<!jet indexes sorted by decreasing pt (reused buffer)
+  std::vector<fastjet::PseudoJet> fConstituentBuffer; //!<!constituents of the current jet (reused buffer)
+  Int_t                  fNJetSlots;              //!<!number of jet objects allocated in the output array
+  ULong64_t              fNAllocations;           //!<!number of (re)allocations of the buffers used to fill the jet branch
 
   static const Int_t     fgkConstIndexShift;      //!<!contituent index shift
 
@@ -207,7 +231,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   AliEmcalJetTask &operator=(const AliEmcalJetTask&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalJetTask, 26);
+  ClassDef(AliEmcalJetTask, 27);
   /// \endcond
 };
 #endif
@@ -35,6 +35,7 @@ class AliFJWrapper
   const std::vector<fastjet::PseudoJet>&  GetEventSubJets()   const { return fEventSubJets;              }
   const std::vector<fastjet::PseudoJet>&  GetFilteredJets()    const { return fFilteredJets;               }
   std::vector<fastjet::PseudoJet>         GetJetConstituents(UInt_t idx) const;
+  void                                    GetJetConstituents(UInt_t idx, std::vector<fastjet::PseudoJet>& constituents) const;
   std::vector<fastjet::PseudoJet>         GetEventSubJetConstituents(UInt_t idx) const;
   std::vector<fastjet::PseudoJet>         GetFilteredJetConstituents(UInt_t idx) const;
   Double_t                                GetMedianUsedForBgSubtraction() const { return fMedUsedForBgSub; }
@@ -628,6 +629,21 @@ AliFJWrapper::GetJetConstituents(UInt_t idx) const
   return retval;
 }
 
+//_________________________________________________________________________________________________
+void AliFJWrapper::GetJetConstituents(UInt_t idx, std::vector<fastjet::PseudoJet>& constituents) const
+{
+  // Get jets constituents into an existing vector.
+  // The vector is cleared first, its capacity is reused.
+
+  constituents.clear();
+
+  if ( idx < fInclusiveJets.size() ) {
+    fClustSeq->add_constituents(fInclusiveJets[idx], constituents);
+  } else {
+    AliError(Form("[e] ::GetJetConstituents wrong index: %d",idx));
+  }
+}
+
 //_________________________________________________________________________________________________
 std::vector<fastjet::PseudoJet>
 AliFJWrapper::GetEventSubJetConstituents(UInt_t idx) const
@@ -322,6 +322,30 @@ AliFMDCorrELossFit::ELossFit::Evaluate(Double_t x,
 			   TMath::Min(maxN, UShort_t(fN)), fA);
 }
 
+//____________________________________________________________________
+void
+AliFMDCorrELossFit::ELossFit::Evaluate(const TAxis& axis, 
+				       Double_t*    f, 
+				       UShort_t     maxN) const
+{
+  // 
+  // Evaluate 
+  // @f[ 
+  //  f_N(x;\Delta,\xi,\sigma') = 
+  //     \sum_{i=1}^{n} a_i f(x;\Delta_i,\xi_i,\sigma_i')
+  // @f] 
+  //
+  // at all bin centres of the axis
+  // 
+  // Parameters:
+  //    axis        Axis 
+  //    f           On return, the values at the bin centres 
+  //    maxN 	  @f$ \max{N}@f$    
+  //
+  AliLandauGaus::Fn(axis, f, fDelta, fXi, fSigma, fSigmaN, 
+		    TMath::Min(maxN, UShort_t(fN)), fA);
+}
+
 //____________________________________________________________________
 Double_t 
 AliFMDCorrELossFit::ELossFit::EvaluateWeighted(Double_t x, 
@@ -268,6 +268,18 @@ public:
      */
     Double_t Evaluate(Double_t x, 
 		      UShort_t maxN=999) const;
+    /** 
+     * Evaluate @f$ f_N@f$ (see above) at all bin centres of an axis
+     * in one go (see AliLandauGaus::Fn).
+     *
+     * @param axis        Axis 
+     * @param f           On return, @f$ f_N@f$ at the bin centres.
+     *                    Must have room for the number of bins.
+     * @param maxN 	  @f$ \max{N}@f$    
+     */
+    void Evaluate(const TAxis& axis, 
+		  Double_t*    f, 
+		  UShort_t     maxN=999) const;
     /** 
      * Evaluate 
      * @f[ 
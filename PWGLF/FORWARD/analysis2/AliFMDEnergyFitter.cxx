@@ -202,6 +202,8 @@ AliFMDEnergyFitter::CreateOutputObjects(TList* dir)
   d->Add(AliForwardUtil::MakeParameter("regCut",        fRegularizationCut));
   d->Add(AliForwardUtil::MakeParameter("deltaShift", 
 				       AliLandauGaus::EnableSigmaShift()));
+  d->Add(AliForwardUtil::MakeParameter("lgTable", 
+				       AliLandauGaus::EnableTable()));
 
   if (fRingHistos.GetEntries() <= 0) { 
     AliFatal("No ring histograms where defined - giving up!");
@@ -298,6 +300,12 @@ AliFMDEnergyFitter::SetEnableDeltaShift(Bool_t use)
 {
   AliLandauGaus::EnableSigmaShift(use ? 1 : 0);
 }
+//____________________________________________________________________
+void
+AliFMDEnergyFitter::SetUseLandauGausTable(Bool_t use) 
+{
+  AliLandauGaus::EnableTable(use ? 1 : 0);
+}
 
 //____________________________________________________________________
 Bool_t
@@ -583,6 +591,7 @@ AliFMDEnergyFitter::Print(Option_t*) const
   PFV("max(chi^2/nu)",	        fMaxChi2PerNDF);
   PFV("min(a_i)",	        fMinWeight);
   PFV("Regularization cut",     fRegularizationCut);
+  PFB("Tabulated Landau-Gauss", AliLandauGaus::EnableTable());
   TString r = "";
   switch (fResidualMethod) { 
   case kNoResiduals:              r = "None";       break;
@@ -1453,6 +1462,10 @@ AliFMDEnergyFitter::RingHistos::CalculateResiduals(EResidualMethod mode,
 
     // Reset histogram
   Int_t nX = resi->GetNbinsX();
+
+  // Evaluate the fit at all bin centres in one go 
+  TArrayD fv(nX);
+  fit->Evaluate(*dist->GetXaxis(), fv.fArray);
   for (Int_t i  = 1; i <= nX; i++) { 
     Double_t x  = dist->GetBinCenter(i);
     if (x < lowCut)  continue;
@@ -1463,7 +1476,7 @@ AliFMDEnergyFitter::RingHistos::CalculateResiduals(EResidualMethod mode,
     Double_t r  = 0;
     Double_t er = 0;
     if (h > 0 && e > 0) { 
-      Double_t f = fit->GetC() * fit->Evaluate(x);
+      Double_t f = fit->GetC() * fv[i-1];
       if (f > 0) { 
 	r  = h-f;
 	switch (mode) { 
@@ -299,6 +299,17 @@ public:
    * @param use If true, enable extra shift @f$\delta\Delta_p(\sigma/\xi)@f$  
    */
   void SetEnableDeltaShift(Bool_t use=true);
+  /**
+   * Whether to evaluate the Landau-Gauss convolutions by interpolation
+   * in a table of precomputed values (see AliLandauGausTable) rather
+   * than by numerical integration.  This makes the fits much faster,
+   * at the price of differences of less than @f$10^{-4}@f$ of the
+   * peak value.  Note, this is a global setting which applies
+   * to all evaluations of AliLandauGaus::F in the process.
+   *
+   * @param use If true, use the tabulated evaluation 
+   */
+  void SetUseLandauGausTable(Bool_t use=true);
 
   /* @} */
   // -----------------------------------------------------------------
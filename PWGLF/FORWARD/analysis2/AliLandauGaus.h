@@ -13,6 +13,8 @@
 #include <TObject.h>
 #include <TF1.h>
 #include <TMath.h>
+#include <TAxis.h>
+#include <vector>
 
 /** 
  * This class contains static member functions to calculate the energy
@@ -94,6 +96,10 @@
  * Landau with a Gaussian (see LandauGaus), and @f$ a@f$ is a vector of
  * weights for each @f$ f_i@f$. Note that @f$ a_1 = 1@f$.
  *
+ * The convolution is evaluated numerically (see FConv).  If enabled
+ * with EnableTable, the evaluation is done by interpolation in a table
+ * of precomputed values instead (see AliLandauGausTable).
+ *
  * Everything is defined in this header file to make it easy to move
  * this code around. Nothing here's meant to be persistent, so we
  * can easily do that. 
@@ -197,8 +203,10 @@ public:
    *    \exp{-\frac{(x-x')^2}{2\sigma'^2}}
    * @f]
    * 
-   * Note that this function uses the constants NSteps() and
-   * NSigma()
+   * If the table is enabled (see EnableTable), and the point is
+   * inside the tabulated domain, the value is interpolated in
+   * AliLandauGausTable.  Otherwise the numerical convolution FConv is
+   * evaluated.
    * 
    * @param x         where to evaluate @f$ f@f$
    * @param delta     @f$ \Delta_p@f$ of @f$ f(x;\Delta_p,\xi,\sigma')@f$
@@ -211,6 +219,23 @@ public:
   static Double_t F(Double_t x, Double_t delta, Double_t xi, 
 		    Double_t sigma, Double_t sigma_n);
   //------------------------------------------------------------------
+  /** 
+   * Numerically evaluate the Landau convolved with a Gaussian (see F)
+   * 
+   * Note that this function uses the constants NSteps() and
+   * NSigma()
+   * 
+   * @param x         where to evaluate @f$ f@f$
+   * @param delta     @f$ \Delta_p@f$ of @f$ f(x;\Delta_p,\xi,\sigma')@f$
+   * @param xi        @f$ \xi@f$ of @f$ f(x;\Delta_p,\xi,\sigma')@f$
+   * @param sigma     @f$ \sigma@f$ of @f$\sigma'^2=\sigma^2-\sigma_n^2 @f$
+   * @param sigma_n   @f$ \sigma_n@f$ of @f$\sigma'^2=\sigma^2-\sigma_n^2 @f$
+   * 
+   * @return @f$ f@f$ evaluated at @f$ x@f$.  
+   */
+  static Double_t FConv(Double_t x, Double_t delta, Double_t xi, 
+			Double_t sigma, Double_t sigma_n);
+  //------------------------------------------------------------------
   /** 
    * Evaluate 
    * @f[ 
@@ -283,6 +308,27 @@ public:
   static Double_t Fn(Double_t x, Double_t delta, Double_t xi, 
 		     Double_t sigma, Double_t sigma_n, Int_t n, 
 		     const Double_t* a);
+  //------------------------------------------------------------------
+  /** 
+   * Evaluate @f$ f_N@f$ (see above) at all bin centres of an axis.
+   * If the table is enabled (see EnableTable), the evaluation is done
+   * in one go by AliLandauGausTable::Fn.
+   * 
+   * @param axis     Axis 
+   * @param f        On return, @f$ f_N@f$ at the bin centres.  Must
+   *                 have room for the number of bins of @a axis.
+   * @param delta    @f$ \Delta_1@f$ 
+   * @param xi       @f$ \xi_1@f$
+   * @param sigma    @f$ \sigma_1@f$ 
+   * @param sigma_n  @f$ \sigma_n@f$ 
+   * @param n        @f$ N@f$ 
+   * @param a        Array of size @f$ N-1@f$ of the weights @f$ a_i@f$ for 
+   *                 @f$ i > 1@f$ 
+   */
+  static void Fn(const TAxis& axis, Double_t* f, 
+		 Double_t delta, Double_t xi, 
+		 Double_t sigma, Double_t sigma_n, Int_t n, 
+		 const Double_t* a);
   /** 
    * Get parameters for the @f$ i@f$ particle response.
    *
@@ -308,6 +354,15 @@ public:
    * @return whether the sigma shift is enabled or not 
    */
   static Bool_t EnableSigmaShift(Short_t val=-1);
+  /** 
+   * Set and check if the tabulated evaluation (see AliLandauGausTable)
+   * is enabled.
+   * 
+   * @param val if <0, then only check.  Otherwise set enabled (>0) or not (=0)
+   * 
+   * @return whether the tabulated evaluation is enabled or not 
+   */
+  static Bool_t EnableTable(Short_t val=-1);
   /** 
    * Get the shift of the MPV due to convolution with a Gaussian. 
    *
@@ -475,6 +530,229 @@ public:
   static Double_t CompFunc(Double_t* xp, Double_t* pp);
   /* @} */
 };
+
+//====================================================================
+/** 
+ * Tabulated evaluation of the Landau convolved with a Gaussian (see
+ * AliLandauGaus::F).  With 
+ *
+ * @f[ 
+ *   \lambda = \frac{x-\Delta_p}{\xi}\quad s = \frac{\sigma'}{\xi}
+ * @f] 
+ *
+ * we have 
+ *
+ * @f[ 
+ *   f(x;\Delta_p,\xi,\sigma') = \frac{1}{\xi} g(\lambda,s)\quad
+ *   g(\lambda,s) = f(\lambda;0,1,s)
+ * @f] 
+ * 
+ * so a single 2-dimensional table of @f$ g@f$ covers all values of
+ * the parameters.  The table holds @f$\log g@f$ evaluated with
+ * AliLandauGaus::FConv on a regular grid in @f$(w(\lambda),\log
+ * s)@f$, and is interpolated with Catmull-Rom splines in both
+ * directions.  The map @f$ w@f$ is the identity in
+ * @f$[-\lambda_c,\lambda_c]@f$ and logarithmic outside, to cover the
+ * long tail of the Landau and the Gaussian tail for large @f$ s@f$
+ * with a finite number of nodes.
+ *
+ * In the domain @f$\lambda\in[-100,1000]@f$ and @f$ s\in[0.05,10]@f$
+ * the difference to AliLandauGaus::FConv is less than
+ * @f$10^{-4}@f$ of the peak value, and less than @f$10^{-3}@f$
+ * relative where @f$ f@f$ is larger than @f$10^{-3}@f$ of the peak
+ * value (see tests/TestLandauGausTable.C).  The largest differences
+ * are for @f$ s\approx10@f$, where the steps of FConv are as large as
+ * the width of the Landau.  Outside of that domain
+ * AliLandauGaus::FConv is used.
+ *
+ * The array member functions evaluate many points with the same
+ * parameters, e.g., all bin centres of a histogram.  The
+ * interpolation in @f$ s@f$ is then done once for the range of
+ * nodes needed, and the loop over the points only interpolates in
+ * @f$\lambda@f$.
+ *
+ * The table is filled on first use, and is not persistent. 
+ *
+ * @ingroup pwglf_forward 
+ */
+class AliLandauGausTable
+{
+public:
+  //__________________________________________________________________
+  /** 
+   * @{ 
+   * @name Constants 
+   */
+  /** 
+   * @return Least tabulated @f$\lambda@f$ 
+   */
+  static Double_t LambdaMin() { return -100; }
+  /** 
+   * @return Largest tabulated @f$\lambda@f$ 
+   */
+  static Double_t LambdaMax() { return 1000; }
+  /** 
+   * @return @f$\lambda_c@f$ above which, and @f$-\lambda_c@f$ below
+   * which, the node spacing grows
+   */
+  static Double_t LambdaC() { return 10; }
+  /** 
+   * @return Node spacing in @f$ w(\lambda)@f$ 
+   */
+  static Double_t WStep() { return 0.05; }
+  /** 
+   * @return Least tabulated @f$ s@f$ 
+   */
+  static Double_t SMin() { return 0.05; }
+  /** 
+   * @return Largest tabulated @f$ s@f$ 
+   */
+  static Double_t SMax() { return 10; }
+  /** 
+   * @return Number of nodes in @f$\log s@f$ between SMin and SMax 
+   */
+  static Int_t NS() { return 120; }
+  /* @} */
+
+  //__________________________________________________________________
+  /** 
+   * @{ 
+   * @name Evaluation 
+   */
+  /** 
+   * Get the table.  The table is filled on the first call.
+   * 
+   * @return Reference to the table
+   */
+  static const AliLandauGausTable& Instance();
+  /** 
+   * Interpolate @f$ f(x;\Delta_p,\xi,\sigma')@f$ in the table 
+   * 
+   * @param x         where to evaluate @f$ f@f$
+   * @param delta     @f$ \Delta_p@f$ 
+   * @param xi        @f$ \xi@f$ 
+   * @param sigma     @f$ \sigma@f$ 
+   * @param sigma_n   @f$ \sigma_n@f$ 
+   * @param f         On return, @f$ f@f$ evaluated at @f$ x@f$ 
+   * 
+   * @return true if @f$(x,\xi,\sigma')@f$ is in the tabulated domain,
+   * false otherwise, in which case @a f is not set.
+   */
+  Bool_t Eval(Double_t x, Double_t delta, Double_t xi, 
+	      Double_t sigma, Double_t sigma_n, Double_t& f) const;
+  /** 
+   * Evaluate @f$ f(x;\Delta_p,\xi,\sigma')@f$ at @a n points.  Points
+   * outside of the tabulated domain are evaluated with
+   * AliLandauGaus::FConv.
+   * 
+   * @param n         Number of points 
+   * @param x         Where to evaluate 
+   * @param f         On return, the values 
+   * @param delta     @f$ \Delta_p@f$ 
+   * @param xi        @f$ \xi@f$ 
+   * @param sigma     @f$ \sigma@f$ 
+   * @param sigma_n   @f$ \sigma_n@f$ 
+   */
+  void F(Int_t n, const Double_t* x, Double_t* f, 
+	 Double_t delta, Double_t xi, 
+	 Double_t sigma, Double_t sigma_n) const;
+  /** 
+   * Evaluate @f$ f_i(x;\Delta_p,\xi,\sigma')@f$ at @a n points (see
+   * AliLandauGaus::Fi).
+   * 
+   * @param n         Number of points 
+   * @param x         Where to evaluate 
+   * @param f         On return, the values 
+   * @param delta     @f$ \Delta@f$ 
+   * @param xi        @f$ \xi@f$ 
+   * @param sigma     @f$ \sigma@f$ 
+   * @param sigma_n   @f$ \sigma_n@f$ 
+   * @param i         @f$ i@f$ 
+   */
+  void Fi(Int_t n, const Double_t* x, Double_t* f, 
+	  Double_t delta, Double_t xi, 
+	  Double_t sigma, Double_t sigma_n, Int_t i) const;
+  /** 
+   * Evaluate @f$ f_N(x;\Delta_p,\xi,\sigma')@f$ at @a n points (see
+   * AliLandauGaus::Fn).
+   * 
+   * @param n         Number of points 
+   * @param x         Where to evaluate 
+   * @param f         On return, the values 
+   * @param delta     @f$ \Delta_1@f$ 
+   * @param xi        @f$ \xi_1@f$ 
+   * @param sigma     @f$ \sigma_1@f$ 
+   * @param sigma_n   @f$ \sigma_n@f$ 
+   * @param nPart     @f$ N@f$ 
+   * @param a         Array of size @f$ N-1@f$ of the weights @f$ a_i@f$ for 
+   *                  @f$ i > 1@f$ 
+   */
+  void Fn(Int_t n, const Double_t* x, Double_t* f, 
+	  Double_t delta, Double_t xi, 
+	  Double_t sigma, Double_t sigma_n, 
+	  Int_t nPart, const Double_t* a) const;
+  /* @} */
+  /** 
+   * Map @f$\lambda\rightarrow w(\lambda)@f$ of the node spacing 
+   * 
+   * @param lambda @f$\lambda@f$ 
+   * 
+   * @return @f$ w(\lambda)@f$ 
+   */
+  static Double_t W(Double_t lambda);
+  /** 
+   * Inverse of W
+   * 
+   * @param w @f$ w@f$ 
+   * 
+   * @return @f$\lambda(w)@f$ 
+   */
+  static Double_t Lambda(Double_t w);
+protected:
+  /** 
+   * Constructor.  Fills the table 
+   */
+  AliLandauGausTable();
+  /** 
+   * Copy constructor - not implemented 
+   */
+  AliLandauGausTable(const AliLandauGausTable&);
+  /** 
+   * Assignment operator - not implemented
+   */
+  AliLandauGausTable& operator=(const AliLandauGausTable&);
+  /** 
+   * Catmull-Rom weights of the 4 nodes around a point 
+   * 
+   * @param t  Position between the 2 middle nodes, in @f$[0,1]@f$ 
+   * @param w  On return, the 4 weights
+   */
+  static void Weights(Double_t t, Double_t* w);
+  /** 
+   * Find the rows and weights of the interpolation in @f$ s@f$ 
+   * 
+   * @param s    @f$ s@f$ 
+   * @param row  On return, the first of the 4 rows 
+   * @param w    On return, the weights of the 4 rows 
+   * 
+   * @return true if @a s is in the tabulated domain 
+   */
+  Bool_t FindRows(Double_t s, Int_t& row, Double_t* w) const;
+  /** 
+   * Node position of @f$\lambda@f$, that is @f$ (w(\lambda)-w_0)/\delta
+   * w@f$ where @f$ w_0@f$ is the first node.
+   * 
+   * @param lambda @f$\lambda@f$ 
+   * 
+   * @return Node position, or -1 if out of the tabulated domain 
+   */
+  Double_t NodePosition(Double_t lambda) const;
+  Int_t                 fNW;    // Number of nodes in w
+  Double_t              fW0;    // w of the first node 
+  Double_t              fLogS0; // log(s) of the first row
+  Double_t              fDLogS; // Row spacing in log(s)
+  std::vector<Double_t> fLogG;  // log(g) per row (s) and node (w)
+};
 //____________________________________________________________________
 inline Bool_t
 AliLandauGaus::EnableSigmaShift(Short_t val)
@@ -484,6 +762,14 @@ AliLandauGaus::EnableSigmaShift(Short_t val)
   return enabled;
 }
 //____________________________________________________________________
+inline Bool_t
+AliLandauGaus::EnableTable(Short_t val)
+{
+  static Bool_t enabled = false;
+  if (val >= 0) enabled = val == 1;
+  return enabled;
+}
+//____________________________________________________________________
 inline void
 AliLandauGaus::IPars(Int_t i, Double_t& delta, Double_t& xi, Double_t& sigma)
 {
@@ -529,6 +815,20 @@ AliLandauGaus::F(Double_t x, Double_t delta, Double_t xi,
 {
   if (xi <= 0) return 0;
 
+  Double_t f = 0;
+  if (EnableTable() && 
+      AliLandauGausTable::Instance().Eval(x, delta, xi, sigma, sigmaN, f))
+    return f;
+  
+  return FConv(x, delta, xi, sigma, sigmaN);
+}
+//____________________________________________________________________
+inline Double_t 
+AliLandauGaus::FConv(Double_t x, Double_t delta, Double_t xi,
+		     Double_t sigma, Double_t sigmaN)
+{
+  if (xi <= 0) return 0;
+
   const Int_t    nSteps = NSteps();
   const Double_t nSigma = NSigma();
   const Double_t deltaP = delta; // - sigma * sigmaShift; // + sigma * mpshift;
@@ -574,6 +874,27 @@ AliLandauGaus::Fn(Double_t x, Double_t delta, Double_t xi,
     result += a[i-2] * Fi(x,delta,xi,sigma,sigmaN,i);
   return result;
 }
+//____________________________________________________________________
+inline void
+AliLandauGaus::Fn(const TAxis& axis, Double_t* f, 
+		  Double_t delta, Double_t xi, 
+		  Double_t sigma, Double_t sigmaN, Int_t n, 
+		  const Double_t* a)
+{
+  const Int_t nX = axis.GetNbins();
+  if (nX <= 0) return;
+  
+  std::vector<Double_t> x(nX);
+  for (Int_t i = 0; i < nX; i++) x[i] = axis.GetBinCenter(i+1);
+
+  if (EnableTable()) {
+    AliLandauGausTable::Instance().Fn(nX, &(x[0]), f, 
+				      delta, xi, sigma, sigmaN, n, a);
+    return;
+  }
+  for (Int_t i = 0; i < nX; i++) 
+    f[i] = Fn(x[i], delta, xi, sigma, sigmaN, n, a);
+}
 
 //____________________________________________________________________
 inline Double_t 
@@ -799,6 +1120,218 @@ AliLandauGaus::MakeComposite(Double_t c1,
 		      xi2);   // 6 secondary Xi
   return comp;
 }
+
+//====================================================================
+inline const AliLandauGausTable&
+AliLandauGausTable::Instance()
+{
+  static const AliLandauGausTable table;
+  return table;
+}
+//____________________________________________________________________
+inline Double_t
+AliLandauGausTable::W(Double_t lambda)
+{
+  const Double_t lc = LambdaC();
+  if (lambda >  lc) return  lc + lc * TMath::Log(1 + (lambda - lc) / lc);
+  if (lambda < -lc) return -lc - lc * TMath::Log(1 - (lambda + lc) / lc);
+  return lambda;
+}
+//____________________________________________________________________
+inline Double_t
+AliLandauGausTable::Lambda(Double_t w)
+{
+  const Double_t lc = LambdaC();
+  if (w >  lc) return  lc + lc * (TMath::Exp((w - lc) / lc) - 1);
+  if (w < -lc) return -lc - lc * (TMath::Exp(-(w + lc) / lc) - 1);
+  return w;
+}
+//____________________________________________________________________
+inline 
+AliLandauGausTable::AliLandauGausTable()
+  : fNW(0), fW0(0), fLogS0(0), fDLogS(0), fLogG()
+{
+  // One node (row) below, and two above the domain, for the 4-point
+  // interpolation at the edges
+  const Double_t dw   = WStep();
+  const Double_t wMin = W(LambdaMin());
+  const Double_t wMax = W(LambdaMax());
+  const Int_t    nS   = NS() + 3;
+  fNW    = Int_t(TMath::Ceil((wMax - wMin) / dw)) + 4;
+  fW0    = wMin - dw;
+  fDLogS = TMath::Log(SMax() / SMin()) / (NS() - 1);
+  fLogS0 = TMath::Log(SMin()) - fDLogS;
+  fLogG.resize(nS * fNW);
+
+  // Values that underflow are set to a small value, to keep the
+  // logarithm finite 
+  const Double_t least = 1e-300;
+  for (Int_t j = 0; j < nS; j++) { 
+    Double_t s = TMath::Exp(fLogS0 + j * fDLogS);
+    for (Int_t k = 0; k < fNW; k++) {
+      Double_t g = AliLandauGaus::FConv(Lambda(fW0 + k * dw), 0, 1, s, 0);
+      fLogG[j * fNW + k] = TMath::Log(TMath::Max(g, least));
+    }
+  }
+}
+//____________________________________________________________________
+inline void
+AliLandauGausTable::Weights(Double_t t, Double_t* w)
+{
+  const Double_t t2 = t * t;
+  const Double_t t3 = t2 * t;
+  w[0] = .5 * (-t3 + 2 * t2 - t);
+  w[1] = .5 * (3 * t3 - 5 * t2 + 2);
+  w[2] = .5 * (-3 * t3 + 4 * t2 + t);
+  w[3] = .5 * (t3 - t2);
+}
+//____________________________________________________________________
+inline Bool_t
+AliLandauGausTable::FindRows(Double_t s, Int_t& row, Double_t* w) const
+{
+  // Negated test so that NaN is out of the domain 
+  if (!(s >= SMin() && s <= SMax())) return false;
+  const Double_t u = (TMath::Log(s) - fLogS0) / fDLogS;
+  const Int_t    j = TMath::Max(1, TMath::Min(Int_t(u), NS()));
+  Weights(u - j, w);
+  row = j - 1;
+  return true;
+}
+//____________________________________________________________________
+inline Double_t
+AliLandauGausTable::NodePosition(Double_t lambda) const
+{
+  if (!(lambda >= LambdaMin() && lambda <= LambdaMax())) return -1;
+  return TMath::Max(1., (W(lambda) - fW0) / WStep());
+}
+//____________________________________________________________________
+inline Bool_t
+AliLandauGausTable::Eval(Double_t x, Double_t delta, Double_t xi, 
+			 Double_t sigma, Double_t sigmaN, Double_t& f) const
+{
+  if (xi <= 0) return false;
+  
+  const Double_t sigma1 = (sigmaN == 0 ? sigma : 
+			   TMath::Sqrt(sigmaN*sigmaN + sigma*sigma));
+  Int_t    row = 0;
+  Double_t ws[4];
+  if (!FindRows(sigma1 / xi, row, ws)) return false;
+
+  const Double_t v = NodePosition((x - delta) / xi);
+  if (v < 0) return false;
+  const Int_t    k = Int_t(v);
+  Double_t       wl[4];
+  Weights(v - k, wl);
+
+  // Same order of summation as in F below 
+  const Double_t* r0 = &(fLogG[row * fNW + k - 1]);
+  const Double_t* r1 = r0 + fNW;
+  const Double_t* r2 = r1 + fNW;
+  const Double_t* r3 = r2 + fNW;
+  Double_t        r  = 0;
+  for (Int_t i = 0; i < 4; i++) 
+    r += wl[i] * (ws[0] * r0[i] + ws[1] * r1[i] + ws[2] * r2[i] + 
+		  ws[3] * r3[i]);
+  f = TMath::Exp(r) / xi;
+  return true;
+}
+//____________________________________________________________________
+inline void
+AliLandauGausTable::F(Int_t n, const Double_t* x, Double_t* f, 
+		      Double_t delta, Double_t xi, 
+		      Double_t sigma, Double_t sigmaN) const
+{
+  if (n <= 0) return;
+  if (xi <= 0) { 
+    for (Int_t i = 0; i < n; i++) f[i] = 0;
+    return;
+  }
+  const Double_t sigma1 = (sigmaN == 0 ? sigma : 
+			   TMath::Sqrt(sigmaN*sigmaN + sigma*sigma));
+  Int_t    row = 0;
+  Double_t ws[4];
+  if (!FindRows(sigma1 / xi, row, ws)) { 
+    for (Int_t i = 0; i < n; i++) 
+      f[i] = AliLandauGaus::FConv(x[i], delta, xi, sigma, sigmaN);
+    return;
+  }
+
+  // Node positions, and the range of nodes needed 
+  std::vector<Double_t> v(n);
+  Int_t kMin = fNW;
+  Int_t kMax = -1;
+  for (Int_t i = 0; i < n; i++) { 
+    v[i] = NodePosition((x[i] - delta) / xi);
+    if (v[i] < 0) continue;
+    Int_t k = Int_t(v[i]);
+    kMin    = TMath::Min(kMin, k);
+    kMax    = TMath::Max(kMax, k);
+  }
+  
+  if (kMax >= 0) {
+    // Interpolate in s once for all needed nodes 
+    const Int_t     nCol = kMax - kMin + 4;
+    const Double_t* r0   = &(fLogG[row * fNW + kMin - 1]);
+    const Double_t* r1   = r0 + fNW;
+    const Double_t* r2   = r1 + fNW;
+    const Double_t* r3   = r2 + fNW;
+    std::vector<Double_t> col(nCol);
+    for (Int_t k = 0; k < nCol; k++) 
+      col[k] = ws[0] * r0[k] + ws[1] * r1[k] + ws[2] * r2[k] + ws[3] * r3[k];
+
+    // Interpolate in lambda for each point 
+    const Double_t ixi = 1 / xi;
+    for (Int_t i = 0; i < n; i++) { 
+      if (v[i] < 0) continue;
+      const Int_t     k  = Int_t(v[i]);
+      const Double_t  t  = v[i] - k;
+      const Double_t* c  = &(col[k - kMin]);
+      Double_t        wl[4];
+      Weights(t, wl);
+      f[i] = TMath::Exp(wl[0] * c[0] + wl[1] * c[1] + 
+			wl[2] * c[2] + wl[3] * c[3]) * ixi;
+    }
+  }
+  
+  // Points out of the tabulated domain 
+  for (Int_t i = 0; i < n; i++) 
+    if (v[i] < 0) f[i] = AliLandauGaus::FConv(x[i], delta, xi, sigma, sigmaN);
+}
+//____________________________________________________________________
+inline void
+AliLandauGausTable::Fi(Int_t n, const Double_t* x, Double_t* f, 
+		       Double_t delta, Double_t xi, 
+		       Double_t sigma, Double_t sigmaN, Int_t i) const
+{
+  Double_t deltaI = delta;
+  Double_t xiI    = xi;
+  Double_t sigmaI = sigma;
+  AliLandauGaus::IPars(i, deltaI, xiI, sigmaI);
+  if (sigmaI < 1e-10) {
+    // Fall back to landau 
+    for (Int_t j = 0; j < n; j++) f[j] = AliLandauGaus::Fl(x[j], deltaI, xiI);
+    return;
+  }
+  F(n, x, f, deltaI, xiI, sigmaI, sigmaN);
+}
+//____________________________________________________________________
+inline void
+AliLandauGausTable::Fn(Int_t n, const Double_t* x, Double_t* f, 
+		       Double_t delta, Double_t xi, 
+		       Double_t sigma, Double_t sigmaN, 
+		       Int_t nPart, const Double_t* a) const
+{
+  if (n <= 0) return;
+  Fi(n, x, f, delta, xi, sigma, sigmaN, 1);
+  if (nPart < 2) return;
+
+  std::vector<Double_t> fi(n);
+  for (Int_t i = 2; i <= nPart; i++) { 
+    Fi(n, x, &(fi[0]), delta, xi, sigma, sigmaN, i);
+    const Double_t ai = a[i-2];
+    for (Int_t j = 0; j < n; j++) f[j] += ai * fi[j];
+  }
+}
 #endif
 // Local Variables:
 //  mode: C++ 
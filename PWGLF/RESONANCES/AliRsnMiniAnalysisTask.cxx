@@ -14,6 +14,7 @@
 //
 
 #include <Riostream.h>
+#include <algorithm>
 
 #include <TH1.h>
 #include <TList.h>
@@ -86,6 +87,8 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask() :
    fTrackCuts(0),
    fRsnEvent(),
    fEvBuffer(0x0),
+   fEvStore(),
+   fMixCandidates(),
    fTriggerAna(0x0),
    fESDtrackCuts(0x0),
    fMiniEvent(0x0),
@@ -146,6 +149,8 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const char *name, Bool_t useMC,Bo
    fTrackCuts(0),
    fRsnEvent(),
    fEvBuffer(0x0),
+   fEvStore(),
+   fMixCandidates(),
    fTriggerAna(0x0),
    fESDtrackCuts(0x0),
    fMiniEvent(0x0),
@@ -212,6 +217,8 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const AliRsnMiniAnalysisTask &cop
    fTrackCuts(copy.fTrackCuts),
    fRsnEvent(),
    fEvBuffer(0x0),
+   fEvStore(),
+   fMixCandidates(),
    fTriggerAna(copy.fTriggerAna),
    fESDtrackCuts(copy.fESDtrackCuts),
    fMiniEvent(0x0),
@@ -422,12 +429,16 @@ void AliRsnMiniAnalysisTask::UserCreateOutputObjects()
       cs->Init(fOutput);
    }
 
-   // create temporary tree for filtered events
+   // create buffer for filtered events: in memory, or
+   // a temporary tree if it has to be saved in the output file
    if (fMiniEvent) SafeDelete(fMiniEvent);
-   if (fRsnTreeInFile) OpenFile(2);
-   fEvBuffer = new TTree("EventBuffer", "Temporary buffer for mini events");  
    fMiniEvent = new AliRsnMiniEvent();
-   fEvBuffer->Branch("events", "AliRsnMiniEvent", &fMiniEvent);
+   fEvStore.Clear();
+   if (fRsnTreeInFile) {
+      OpenFile(2);
+      fEvBuffer = new TTree("EventBuffer", "Temporary buffer for mini events");  
+      fEvBuffer->Branch("events", "AliRsnMiniEvent", &fMiniEvent);
+   }
    
    // create one histogram per each stored definition (event histograms)
    Int_t i, ndef = fHistograms.GetEntries();
@@ -486,10 +497,12 @@ void AliRsnMiniAnalysisTask::UserExec(Option_t *)
    if (fMiniEvent->IsEmpty()) {
       AliDebugClass(2, Form("Rejecting empty event #%d", fEvNum));
    } else {
-      Int_t id = fEvBuffer->GetEntries();
+      Int_t id = fEvStore.GetEntries();
       AliDebugClass(2, Form("Adding event #%d with ID = %d", fEvNum, id));
       fMiniEvent->ID() = id;
-      fEvBuffer->Fill();
+      // the store keeps the events only when they are not in the tree
+      fEvStore.Add(fMiniEvent, !fRsnTreeInFile);
+      if (fRsnTreeInFile) fEvBuffer->Fill();
    }
 
    // post data for computed stuff
@@ -508,12 +521,13 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
 //
 
    // security code: reassign the buffer to the mini-event cursor
-   fEvBuffer->SetBranchAddress("events", &fMiniEvent);
+   if (fRsnTreeInFile) fEvBuffer->SetBranchAddress("events", &fMiniEvent);
    TStopwatch timer;
    // prepare variables
-   Int_t ievt, nEvents = (Int_t)fEvBuffer->GetEntries();
+   Int_t ievt, nEvents = fEvStore.GetEntries();
    Int_t idef, nDefs   = fHistograms.GetEntries();
-   Int_t imix, iloop, ifill;
+   Int_t imix, ifill;
+   AliRsnMiniEvent *event = 0x0;
    AliRsnMiniOutput *def = 0x0;
    AliRsnMiniOutput::EComputation compType;
 
@@ -531,7 +545,7 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    timer.Start();
    for (ievt = 0; ievt < nEvents; ievt++) {
       // get next entry
-      fEvBuffer->GetEntry(ievt);
+      event = GetBufferedEvent(ievt);
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] Std.Event %d/%d",GetName(), ievt,nEvents));
          timer.Stop(); timer.Print(); fflush(stdout); timer.Start(kFALSE);
@@ -546,23 +560,23 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
             case AliRsnMiniOutput::kEventOnly:
                //AliDebugClass(1, Form("Event %d, def '%s': event-value histogram filling", ievt, def->GetName()));
                ifill = 1;
-               def->FillEvent(fMiniEvent, &fValues);
+               def->FillEvent(event, &fValues);
                break;
             case AliRsnMiniOutput::kTruePair:
                //AliDebugClass(1, Form("Event %d, def '%s': true-pair histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
+               ifill = def->FillPair(event, event, &fValues);
                break;
             case AliRsnMiniOutput::kTrackPair:
                //AliDebugClass(1, Form("Event %d, def '%s': pair-value histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
+               ifill = def->FillPair(event, event, &fValues);
                break;
             case AliRsnMiniOutput::kTrackPairRotated1:
                //AliDebugClass(1, Form("Event %d, def '%s': rotated (1) background histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
+               ifill = def->FillPair(event, event, &fValues);
                break;
             case AliRsnMiniOutput::kTrackPairRotated2:
                //AliDebugClass(1, Form("Event %d, def '%s': rotated (2) background histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
+               ifill = def->FillPair(event, event, &fValues);
                break;
             default:
                // other kinds are processed elsewhere
@@ -581,13 +595,9 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
       return;
    }
 
-   // initialize mixing counter
-   Int_t    nmatched[nEvents];
-   TString *smatched = new TString[nEvents];
-   for (ievt = 0; ievt < nEvents; ievt++) {
-      smatched[ievt] = "|";
-      nmatched[ievt] = 0;
-   }
+   // initialize mixing counter and list of events to be mixed with each event
+   std::vector<Int_t> nmatched(nEvents, 0);
+   std::vector< std::vector<Int_t> > matched(nEvents);
 
 
    AliInfo(Form("[%s] Std.Event %d/%d",GetName(), nEvents,nEvents));
@@ -600,64 +610,56 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
          timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
       }
       if (nmatched[ievt] >= fNMix) continue;
-      fEvBuffer->GetEntry(ievt);
-      AliRsnMiniEvent evMain(*fMiniEvent);
-      for (iloop = 1; iloop < nEvents; iloop++) {
-         imix = ievt + iloop;
-         if (imix >= nEvents) imix -= nEvents;
-         if (imix == ievt) continue;
-         // text next entry
-         fEvBuffer->GetEntry(imix);
-         // skip if events are not matched
-         if (!EventsMatch(&evMain, fMiniEvent)) continue;
+      // matched events, in the order ievt+1, ..., nEvents-1, 0, ..., ievt-1
+      Int_t ic, nCandidates = FindMixingCandidates(ievt, fMixCandidates);
+      for (ic = 0; ic < nCandidates; ic++) {
+         imix = fMixCandidates[ic];
          // check that the array of good matches for mixed does not already contain main event
-         if (smatched[imix].Contains(Form("|%d|", ievt))) continue;
+         if (std::find(matched[imix].begin(), matched[imix].end(), ievt) != matched[imix].end()) continue;
          // check that the found good events has not enough matches already
          if (nmatched[imix] >= fNMix) continue;
          // add new mixing candidate
-         smatched[ievt].Append(Form("%d|", imix));
+         matched[ievt].push_back(imix);
          nmatched[ievt]++;
          nmatched[imix]++;
          if (nmatched[ievt] >= fNMix) break;
       }
-      AliDebugClass(1, Form("Matches for event %5d = %d [%s] (missing are declared above)", evMain.ID(), nmatched[ievt], smatched[ievt].Data()));
+      AliDebugClass(1, Form("Matches for event %5d = %d, %d candidates (missing are declared above)", ievt, nmatched[ievt], nCandidates));
    }
 
    AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout); timer.Start();
 
    // perform mixing
-   TObjArray *list = 0x0;
-   TObjString *os = 0x0;
+   AliRsnMiniEvent evMainCopy;
    for (ievt = 0; ievt < nEvents; ievt++) {
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] EventMixing %d/%d",GetName(),ievt,nEvents));
          timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
       }
       ifill = 0;
-      fEvBuffer->GetEntry(ievt);
-      AliRsnMiniEvent evMain(*fMiniEvent);
-      list = smatched[ievt].Tokenize("|");
-      TObjArrayIter next(list);
-      while ( (os = (TObjString *)next()) ) {
-         imix = os->GetString().Atoi();
-         fEvBuffer->GetEntry(imix);
+      AliRsnMiniEvent *evMain = GetBufferedEvent(ievt);
+      // with the tree buffer, the cursor is overwritten when reading the mixed events
+      if (fRsnTreeInFile) {
+         evMainCopy = *evMain;
+         evMain = &evMainCopy;
+      }
+      for (UInt_t im = 0; im < matched[ievt].size(); im++) {
+         imix = matched[ievt][im];
+         event = GetBufferedEvent(imix);
          for (idef = 0; idef < nDefs; idef++) {
             def = (AliRsnMiniOutput *)fHistograms[idef];
             if (!def) continue;
             if (!def->IsTrackPairMix()) continue;
-            ifill += def->FillPair(&evMain, fMiniEvent, &fValues, kTRUE);
+            ifill += def->FillPair(evMain, event, &fValues, kTRUE);
             if (!def->IsSymmetric()) {
                AliDebugClass(2, "Reflecting non symmetric pair");
-               ifill += def->FillPair(fMiniEvent, &evMain, &fValues, kFALSE);
+               ifill += def->FillPair(event, evMain, &fValues, kFALSE);
             }
          }
       }
-      delete list;
    }
 
-   delete [] smatched;
-
    AliInfo(Form("[%s] EventMixing %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout);
 
@@ -1484,13 +1486,23 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
 //
 
    if (!event1 || !event2) return kFALSE;
+   return EventsMatch(event1->Vz(), event1->Mult(), event1->Angle(), event2->Vz(), event2->Mult(), event2->Angle());
+}
+
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniAnalysisTask::EventsMatch(Float_t vz1, Float_t mult1, Float_t angle1, Float_t vz2, Float_t mult2, Float_t angle2)
+{
+//
+// Check if two events with the given vz, mult and angle are compatible, see above.
+//
+
    Int_t ivz1, ivz2, imult1, imult2, iangle1, iangle2;
    Double_t dv, dm, da;
 
    if (fContinuousMix) {
-      dv = TMath::Abs(event1->Vz()    - event2->Vz()   );
-      dm = TMath::Abs(event1->Mult()  - event2->Mult() );
-      da = TMath::Abs(event1->Angle() - event2->Angle());
+      dv = TMath::Abs(vz1    - vz2   );
+      dm = TMath::Abs(mult1  - mult2 );
+      da = TMath::Abs(angle1 - angle2);
       if (dv > fMaxDiffVz) {
          //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Vz = %f", event1->ID(), event2->ID(), dv));
          return kFALSE;
@@ -1505,12 +1517,12 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
       }
       return kTRUE;
    } else {
-      ivz1 = (Int_t)(event1->Vz() / fMaxDiffVz);
-      ivz2 = (Int_t)(event2->Vz() / fMaxDiffVz);
-      imult1 = (Int_t)(event1->Mult() / fMaxDiffMult);
-      imult2 = (Int_t)(event2->Mult() / fMaxDiffMult);
-      iangle1 = (Int_t)(event1->Angle() / fMaxDiffAngle);
-      iangle2 = (Int_t)(event2->Angle() / fMaxDiffAngle);
+      ivz1 = (Int_t)(vz1 / fMaxDiffVz);
+      ivz2 = (Int_t)(vz2 / fMaxDiffVz);
+      imult1 = (Int_t)(mult1 / fMaxDiffMult);
+      imult2 = (Int_t)(mult2 / fMaxDiffMult);
+      iangle1 = (Int_t)(angle1 / fMaxDiffAngle);
+      iangle2 = (Int_t)(angle2 / fMaxDiffAngle);
       if (ivz1 != ivz2) return kFALSE;
       if (imult1 != imult2) return kFALSE;
       if (iangle1 != iangle2) return kFALSE;
@@ -1518,6 +1530,68 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
    }
 }
 
+//__________________________________________________________________________________________________
+Int_t AliRsnMiniAnalysisTask::FindMixingCandidates(Int_t ievt, std::vector<Int_t> &candidates)
+{
+//
+// Fill the list of stored events which match with event ievt (see EventsMatch).
+// They are taken from a range in vz of the event store, wide enough to contain
+// all matching events, and returned in the order ievt+1, ..., N-1, 0, ..., ievt-1,
+// which is the order in which they were looked for in the whole buffer.
+// Can be called at any time, with the events stored so far.
+//
+
+   candidates.clear();
+   Int_t nEvents = fEvStore.GetEntries();
+   if (ievt < 0 || ievt >= nEvents) return 0;
+
+   Double_t vz = fEvStore.GetVz(ievt);
+   Double_t dvz = TMath::Abs(fMaxDiffVz);
+   Double_t vzMin = -1E30, vzMax = 1E30;
+   if (fContinuousMix) {
+      vzMin = vz - fMaxDiffVz;
+      vzMax = vz + fMaxDiffVz;
+   } else if (dvz > 0.0 && TMath::Abs(vz / dvz) < 1E9) {
+      // same bin (truncation towards 0) is within one bin width
+      Double_t ivz = (Double_t)(Int_t)(vz / dvz);
+      vzMin = (ivz - 1.0) * dvz;
+      vzMax = (ivz + 1.0) * dvz;
+   }
+   // margin for the rounding of the single precision differences
+   Double_t margin = 1E-5 * (TMath::Abs(vz) + dvz) + 1E-6;
+   fEvStore.SelectVzRange(vzMin - margin, vzMax + margin, candidates);
+
+   Float_t vz1 = fEvStore.GetVz(ievt), mult1 = fEvStore.GetMult(ievt), angle1 = fEvStore.GetAngle(ievt);
+   Int_t ic, nCandidates = 0;
+   for (ic = 0; ic < (Int_t)candidates.size(); ic++) {
+      Int_t imix = candidates[ic];
+      if (imix == ievt) continue;
+      if (!EventsMatch(vz1, mult1, angle1, fEvStore.GetVz(imix), fEvStore.GetMult(imix), fEvStore.GetAngle(imix))) continue;
+      // store the distance in the search order, converted back below
+      candidates[nCandidates++] = (imix > ievt) ? (imix - ievt) : (imix - ievt + nEvents);
+   }
+   candidates.resize(nCandidates);
+   std::sort(candidates.begin(), candidates.end());
+   for (ic = 0; ic < nCandidates; ic++) {
+      candidates[ic] += ievt;
+      if (candidates[ic] >= nEvents) candidates[ic] -= nEvents;
+   }
+   return nCandidates;
+}
+
+//__________________________________________________________________________________________________
+AliRsnMiniEvent *AliRsnMiniAnalysisTask::GetBufferedEvent(Int_t ievt)
+{
+//
+// Return the stored event ievt, from memory or read in the mini-event cursor
+// from the tree buffer: in this case the pointer is valid until the next call.
+//
+
+   if (!fRsnTreeInFile) return fEvStore.GetEvent(ievt);
+   fEvBuffer->GetEntry(ievt);
+   return fMiniEvent;
+}
+
 //---------------------------------------------------------------------
 Double_t AliRsnMiniAnalysisTask::ApplyCentralityPatchPbPb2011(){
   //This part rejects randomly events such that the centrality gets flat for LHC11h Pb-Pb data
@@ -12,6 +12,7 @@
 // Developers: F. Bellini (fbellini@cern.ch)
 //
 
+#include <vector>
 #include <TString.h>
 #include <TClonesArray.h>
 
@@ -23,6 +24,7 @@
 #include "AliRsnCutEventUtils.h"
 #include "AliRsnCutPrimaryVertex.h"
 #include "AliRsnMiniResonanceFinder.h"
+#include "AliRsnMiniEventStore.h"
 
 #include "AliESDtrackCuts.h"
 
@@ -109,6 +111,9 @@ private:
    void     FillTrueMotherAOD(AliRsnMiniEvent *event);
    void     StoreTrueMother(AliRsnMiniPair *pair, AliRsnMiniEvent *event);
    Bool_t   EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2);
+   Bool_t   EventsMatch(Float_t vz1, Float_t mult1, Float_t angle1, Float_t vz2, Float_t mult2, Float_t angle2);
+   Int_t    FindMixingCandidates(Int_t ievt, std::vector<Int_t> &candidates);
+   AliRsnMiniEvent *GetBufferedEvent(Int_t ievt);
    AliQnCorrectionsQnVector * GetQnVectorFromList(const TList *list,
                                                         const char *subdetector,
                                                         const char *expectedstep) const;
@@ -146,7 +151,9 @@ private:
    AliRsnCutSet        *fEventCuts;       //  cuts on events
    TObjArray            fTrackCuts;       //  list of single track cuts
    AliRsnEvent          fRsnEvent;        //! interface object to the event
-   TTree               *fEvBuffer;        //! mini-event buffer
+   TTree               *fEvBuffer;        //! mini-event buffer saved in file (only with fRsnTreeInFile)
+   AliRsnMiniEventStore fEvStore;         //! mini-event buffer in memory, with mixing variables and index
+   std::vector<Int_t>   fMixCandidates;   //! candidates for mixing with the current event
    AliTriggerAnalysis  *fTriggerAna;      //! trigger analysis
    AliESDtrackCuts     *fESDtrackCuts;    //! quality cut for ESD tracks
    AliRsnMiniEvent     *fMiniEvent;       //! mini-event cursor
@@ -169,7 +176,7 @@ private:
    UShort_t              fNResonanceFinders; // number of AliRsnMiniResonanceFinder objects
    AliRsnMiniResonanceFinder* fResonanceFinder[2]; // pointers to AliRsnMiniResonanceFinder objects
 
-   ClassDef(AliRsnMiniAnalysisTask, 16);   // AliRsnMiniAnalysisTask
+   ClassDef(AliRsnMiniAnalysisTask, 17);   // AliRsnMiniAnalysisTask
 };
 
 
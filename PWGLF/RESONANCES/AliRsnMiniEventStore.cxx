@@ -0,0 +1,157 @@
+//
+// Mini-Event store
+// In-memory buffer of the mini-events selected by the mini analysis task.
+// The mixing variables are kept in columns, and an index of the events
+// sorted in vz gives the mixing candidates of an event with a range query.
+// The index is updated lazily: events added since the last query are
+// sorted and merged into it at the next query, so that queries can be
+// done while events are still being added.
+//
+
+#include <algorithm>
+
+#include "AliRsnMiniEvent.h"
+#include "AliRsnMiniEventStore.h"
+
+ClassImp(AliRsnMiniEventStore)
+
+namespace {
+   // orders event indexes by vz of the event, then by index
+   struct VzLess {
+      VzLess(const std::vector<Float_t> &vz) : fVz(vz) {}
+      Bool_t operator()(Int_t i, Int_t j) const {return (fVz[i] < fVz[j] || (fVz[i] == fVz[j] && i < j));}
+      Bool_t operator()(Int_t i, Double_t v) const {return fVz[i] < v;}
+      Bool_t operator()(Double_t v, Int_t i) const {return v < fVz[i];}
+      const std::vector<Float_t> &fVz;
+   };
+}
+
+//__________________________________________________________________________________________________
+AliRsnMiniEventStore::AliRsnMiniEventStore() :
+   TObject(),
+   fEvents(),
+   fVz(),
+   fMult(),
+   fAngle(),
+   fVzIndex(),
+   fNIndexed(0)
+{
+//
+// Default constructor
+//
+
+   fEvents.SetOwner(kTRUE);
+}
+
+//__________________________________________________________________________________________________
+AliRsnMiniEventStore::AliRsnMiniEventStore(const AliRsnMiniEventStore &copy) :
+   TObject(copy),
+   fEvents(),
+   fVz(copy.fVz),
+   fMult(copy.fMult),
+   fAngle(copy.fAngle),
+   fVzIndex(copy.fVzIndex),
+   fNIndexed(copy.fNIndexed)
+{
+//
+// Copy constructor.
+// The stored events are copied.
+//
+
+   fEvents.SetOwner(kTRUE);
+   for (Int_t i = 0; i < copy.fEvents.GetEntriesFast(); i++)
+      fEvents.Add(new AliRsnMiniEvent(*copy.GetEvent(i)));
+}
+
+//__________________________________________________________________________________________________
+AliRsnMiniEventStore &AliRsnMiniEventStore::operator=(const AliRsnMiniEventStore &copy)
+{
+//
+// Assignment operator.
+// The stored events are copied.
+//
+
+   TObject::operator=(copy);
+   if (this == &copy)
+      return *this;
+   fEvents.Delete();
+   for (Int_t i = 0; i < copy.fEvents.GetEntriesFast(); i++)
+      fEvents.Add(new AliRsnMiniEvent(*copy.GetEvent(i)));
+   fVz = copy.fVz;
+   fMult = copy.fMult;
+   fAngle = copy.fAngle;
+   fVzIndex = copy.fVzIndex;
+   fNIndexed = copy.fNIndexed;
+   return (*this);
+}
+
+//__________________________________________________________________________________________________
+Int_t AliRsnMiniEventStore::Add(AliRsnMiniEvent *event, Bool_t keepEvent)
+{
+//
+// Adds the mixing variables of the event and, if required, a copy of it.
+// The same choice must be done for all events, since they are retrieved
+// with the same position as their variables.
+// Returns the position of the event in the store.
+//
+
+   Int_t id = GetEntries();
+   fVz.push_back(event->Vz());
+   fMult.push_back(event->Mult());
+   fAngle.push_back(event->Angle());
+   fVzIndex.push_back(id);
+   if (keepEvent) fEvents.Add(new AliRsnMiniEvent(*event));
+   return id;
+}
+
+//__________________________________________________________________________________________________
+void AliRsnMiniEventStore::Clear(Option_t *)
+{
+//
+// Removes all events
+//
+
+   fEvents.Delete();
+   fVz.clear();
+   fMult.clear();
+   fAngle.clear();
+   fVzIndex.clear();
+   fNIndexed = 0;
+}
+
+//__________________________________________________________________________________________________
+void AliRsnMiniEventStore::UpdateIndex()
+{
+//
+// Sorts the events added since the last update
+// and merges them in the index
+//
+
+   Int_t n = (Int_t)fVzIndex.size();
+   if (fNIndexed >= n) return;
+
+   VzLess less(fVz);
+   std::sort(fVzIndex.begin() + fNIndexed, fVzIndex.end(), less);
+   std::inplace_merge(fVzIndex.begin(), fVzIndex.begin() + fNIndexed, fVzIndex.end(), less);
+   fNIndexed = n;
+}
+
+//__________________________________________________________________________________________________
+Int_t AliRsnMiniEventStore::SelectVzRange(Double_t vzMin, Double_t vzMax, std::vector<Int_t> &list)
+{
+//
+// Fills the list with the events having vzMin <= vz <= vzMax,
+// in ascending vz. Returns the number of selected events.
+//
+
+   list.clear();
+   if (vzMin > vzMax) return 0;
+
+   UpdateIndex();
+
+   VzLess less(fVz);
+   std::vector<Int_t>::const_iterator first = std::lower_bound(fVzIndex.begin(), fVzIndex.end(), vzMin, less);
+   std::vector<Int_t>::const_iterator last  = std::upper_bound(first, fVzIndex.end(), vzMax, less);
+   list.assign(first, last);
+   return (Int_t)list.size();
+}
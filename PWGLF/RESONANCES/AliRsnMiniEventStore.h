@@ -0,0 +1,52 @@
+#ifndef ALIRSNMINIEVENTSTORE_H
+#define ALIRSNMINIEVENTSTORE_H
+
+//
+// Mini-Event store
+// In-memory buffer of the mini-events selected by the mini analysis task.
+// The mixing variables (vz, multiplicity, angle) are kept in columns
+// with an index sorted in vz, so that the candidates for mixing with
+// a given event are found with a range query instead of reading all
+// the stored events. Events can be added and queried at any time.
+//
+
+#include <vector>
+#include <TObject.h>
+#include <TObjArray.h>
+
+class AliRsnMiniEvent;
+
+class AliRsnMiniEventStore : public TObject {
+public:
+
+   AliRsnMiniEventStore();
+   AliRsnMiniEventStore(const AliRsnMiniEventStore &copy);
+   AliRsnMiniEventStore &operator=(const AliRsnMiniEventStore &copy);
+   virtual ~AliRsnMiniEventStore() {}
+
+   Int_t            Add(AliRsnMiniEvent *event, Bool_t keepEvent = kTRUE);
+   void             Clear(Option_t *opt = "");
+
+   Int_t            GetEntries()        const {return (Int_t)fVz.size();}
+   Float_t          GetVz(Int_t i)      const {return fVz[i];}
+   Float_t          GetMult(Int_t i)    const {return fMult[i];}
+   Float_t          GetAngle(Int_t i)   const {return fAngle[i];}
+   AliRsnMiniEvent *GetEvent(Int_t i)   const {return (i < fEvents.GetEntriesFast() ? (AliRsnMiniEvent *)fEvents.UncheckedAt(i) : 0x0);}
+
+   Int_t            SelectVzRange(Double_t vzMin, Double_t vzMax, std::vector<Int_t> &list);
+
+private:
+
+   void             UpdateIndex();
+
+   TObjArray            fEvents;     //  stored events (owned), empty if only the columns are kept
+   std::vector<Float_t> fVz;         //  z-position of vertex of each event
+   std::vector<Float_t> fMult;       //  multiplicity or centrality of each event
+   std::vector<Float_t> fAngle;      //  reaction plane angle of each event
+   std::vector<Int_t>   fVzIndex;    //! events sorted in vz
+   Int_t                fNIndexed;   //! number of events already sorted in fVzIndex
+
+   ClassDef(AliRsnMiniEventStore, 1)
+};
+
+#endif
@@ -43,6 +43,7 @@ class AliESDFMD;
 class AliCFContainer;
 class AliV0Result;
 class AliCascadeResult;
+class AliWeakResultSelector;
 class AliExternalTrackParam;
 
 //#include "TString.h"
@@ -283,6 +284,7 @@ private:
     TTree  *fTreeEvent;              //! Output Tree, Events
     TTree  *fTreeV0;              //! Output Tree, V0s
     TTree  *fTreeCascade;              //! Output Tree, Cascades
+    AliWeakResultSelector *fWeakResultSelector; //! Batched selection of the V0 and cascade configurations
     
     AliPIDResponse *fPIDResponse;     // PID response object
     AliESDtrackCuts *fESDtrackCuts;   // ESD track cuts used for primary track definition
@@ -826,8 +828,9 @@ private:
     AliAnalysisTaskStrangenessVsMultiplicityMCRun2(const AliAnalysisTaskStrangenessVsMultiplicityMCRun2&);            // not implemented
     AliAnalysisTaskStrangenessVsMultiplicityMCRun2& operator=(const AliAnalysisTaskStrangenessVsMultiplicityMCRun2&); // not implemented
     
-    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityMCRun2, 1);
+    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityMCRun2, 2);
     //1: first implementation
+    //2: batched selection of the configurations (AliWeakResultSelector)
 };
 
 #endif
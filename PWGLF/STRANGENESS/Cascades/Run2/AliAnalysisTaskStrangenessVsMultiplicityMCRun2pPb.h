@@ -43,6 +43,7 @@ class AliESDFMD;
 class AliCFContainer;
 class AliV0Result;
 class AliCascadeResult;
+class AliWeakResultSelector;
 class AliExternalTrackParam;
 
 //#include "TString.h"
@@ -256,6 +257,7 @@ private:
     TTree  *fTreeEvent;              //! Output Tree, Events
     TTree  *fTreeV0;              //! Output Tree, V0s
     TTree  *fTreeCascade;              //! Output Tree, Cascades
+    AliWeakResultSelector *fWeakResultSelector; //! Batched selection of the V0 and cascade configurations
     
     AliPIDResponse *fPIDResponse;     // PID response object
     AliESDtrackCuts *fESDtrackCuts;   // ESD track cuts used for primary track definition
@@ -643,8 +645,9 @@ private:
     AliAnalysisTaskStrangenessVsMultiplicityMCRun2pPb(const AliAnalysisTaskStrangenessVsMultiplicityMCRun2pPb&);            // not implemented
     AliAnalysisTaskStrangenessVsMultiplicityMCRun2pPb& operator=(const AliAnalysisTaskStrangenessVsMultiplicityMCRun2pPb&); // not implemented
     
-    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityMCRun2pPb, 2);
+    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityMCRun2pPb, 3);
     //1: first implementation
+    //3: batched selection of the configurations (AliWeakResultSelector)
 };
 
 #endif
@@ -119,6 +119,7 @@ class AliAODv0;
 #include "AliEventCuts.h"
 #include "AliV0Result.h"
 #include "AliCascadeResult.h"
+#include "AliWeakResultSelector.h"
 #include "AliAnalysisTaskStrangenessVsMultiplicityRun2.h"
 
 using std::cout;
@@ -127,7 +128,7 @@ using std::endl;
 ClassImp(AliAnalysisTaskStrangenessVsMultiplicityRun2)
 
 AliAnalysisTaskStrangenessVsMultiplicityRun2::AliAnalysisTaskStrangenessVsMultiplicityRun2()
-: AliAnalysisTaskSE(), fListHist(0), fListV0(0), fListCascade(0), fTreeEvent(0), fTreeV0(0), fTreeCascade(0), fPIDResponse(0), fESDtrackCuts(0), fESDtrackCutsITSsa2010(0), fESDtrackCutsGlobal2015(0), fUtils(0), fRand(0),
+: AliAnalysisTaskSE(), fListHist(0), fListV0(0), fListCascade(0), fTreeEvent(0), fTreeV0(0), fTreeCascade(0), fWeakResultSelector(0), fPIDResponse(0), fESDtrackCuts(0), fESDtrackCutsITSsa2010(0), fESDtrackCutsGlobal2015(0), fUtils(0), fRand(0),
 
 //---> Flags controlling Event Tree output
 fkSaveEventTree    ( kTRUE ), //no downscaling in this tree so far
@@ -391,7 +392,7 @@ fHistCentrality(0)
 }
 
 AliAnalysisTaskStrangenessVsMultiplicityRun2::AliAnalysisTaskStrangenessVsMultiplicityRun2(Bool_t lSaveEventTree, Bool_t lSaveV0Tree, Bool_t lSaveCascadeTree, const char *name, TString lExtraOptions)
-: AliAnalysisTaskSE(name), fListHist(0), fListV0(0), fListCascade(0), fTreeEvent(0), fTreeV0(0), fTreeCascade(0), fPIDResponse(0), fESDtrackCuts(0), fESDtrackCutsITSsa2010(0), fESDtrackCutsGlobal2015(0), fUtils(0), fRand(0),
+: AliAnalysisTaskSE(name), fListHist(0), fListV0(0), fListCascade(0), fTreeEvent(0), fTreeV0(0), fTreeCascade(0), fWeakResultSelector(0), fPIDResponse(0), fESDtrackCuts(0), fESDtrackCutsITSsa2010(0), fESDtrackCutsGlobal2015(0), fUtils(0), fRand(0),
 
 //---> Flags controlling Event Tree output
 fkSaveEventTree    ( kFALSE ), //no downscaling in this tree so far
@@ -743,6 +744,10 @@ AliAnalysisTaskStrangenessVsMultiplicityRun2::~AliAnalysisTaskStrangenessVsMulti
         delete fTreeCascade;
         fTreeCascade = 0x0;
     }
+    if (fWeakResultSelector) {
+        delete fWeakResultSelector;
+        fWeakResultSelector = 0x0;
+    }
     if (fUtils) {
         delete fUtils;
         fUtils = 0x0;
@@ -1081,6 +1086,14 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserCreateOutputObjects()
         fListCascade->SetOwner();
     }
     
+    //Batched selection of the configurations, compiled at the first event
+    if ( !fWeakResultSelector ){
+        fWeakResultSelector = new AliWeakResultSelector( AliWeakResultSelector::kV0MaxRadius            | AliWeakResultSelector::kV0276TeVLikedEdx |
+                                                         AliWeakResultSelector::kCascSwapBachelorCharge | AliWeakResultSelector::kCascTOF          |
+                                                         AliWeakResultSelector::kCascVarDCACascDau      | AliWeakResultSelector::kCascDCACascadeToPV |
+                                                         AliWeakResultSelector::kCascWeightedDCAToPV );
+    }
+    
     //Regular Output: Slots 1, 2, 3
     PostData(1, fListHist    );
     PostData(2, fListV0      );
@@ -1372,6 +1385,10 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
     Int_t nv0s = 0;
     nv0s = lESDevent->GetNumberOfV0s();
     
+    //Configurations, compiled once (or again if changed)
+    if( !fWeakResultSelector->IsCompiled(fListV0, fListCascade) ) fWeakResultSelector->Compile(fListV0, fListCascade);
+    fWeakResultSelector->ClearV0Candidates();
+    
     for (Int_t iV0 = 0; iV0 < nv0s; iV0++) //extra-crazy test
     {   // This is the begining of the V0 loop
         AliESDv0 *v0 = ((AliESDEvent*)lESDevent)->GetV0(iV0);
@@ -1658,138 +1675,51 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         // Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
         
-        //Step 1: Sweep members of the output object TList and fill all of them as appropriate
-        Int_t lNumberOfConfigurations = fListV0->GetEntries();
-        //AliWarning(Form("[V0 Analyses] Processing different configurations (%i detected)",lNumberOfConfigurations));
-        TH3F *histoout         = 0x0;
-        AliV0Result *lV0Result = 0x0;
-        for(Int_t lcfg=0; lcfg<lNumberOfConfigurations; lcfg++){
-            lV0Result = (AliV0Result*) fListV0->At(lcfg);
-            histoout  = lV0Result->GetHistogram();
-            
-            Float_t lMass = 0;
-            Float_t lRap  = 0;
-            Float_t lPDGMass = -1;
-            Float_t lNegdEdx = 100;
-            Float_t lPosdEdx = 100;
-            Float_t lBaryonMomentum = -0.5;
-            Float_t lBaryonPt = -0.5;
-            Float_t lBaryondEdxFromProton = 0;
-            
-            //========================================================================
-            //Setting up: Variable V0 CosPA
-            Float_t lV0CosPACut = lV0Result -> GetCutV0CosPA();
-            Float_t lVarV0CosPApar[5];
-            lVarV0CosPApar[0] = lV0Result->GetCutVarV0CosPAExp0Const();
-            lVarV0CosPApar[1] = lV0Result->GetCutVarV0CosPAExp0Slope();
-            lVarV0CosPApar[2] = lV0Result->GetCutVarV0CosPAExp1Const();
-            lVarV0CosPApar[3] = lV0Result->GetCutVarV0CosPAExp1Slope();
-            lVarV0CosPApar[4] = lV0Result->GetCutVarV0CosPAConst();
-            Float_t lVarV0CosPA = TMath::Cos(
-                                             lVarV0CosPApar[0]*TMath::Exp(lVarV0CosPApar[1]*fTreeVariablePt) +
-                                             lVarV0CosPApar[2]*TMath::Exp(lVarV0CosPApar[3]*fTreeVariablePt) +
-                                             lVarV0CosPApar[4]);
-            if( lV0Result->GetCutUseVarV0CosPA() ){
-                //Only use if tighter than the non-variable cut
-                if( lVarV0CosPA > lV0CosPACut ) lV0CosPACut = lVarV0CosPA;
-            }
-            //========================================================================
-            
-            if ( lV0Result->GetMassHypothesis() == AliV0Result::kK0Short     ){
-                lMass    = fTreeVariableInvMassK0s;
-                lRap     = fTreeVariableRapK0Short;
-                lPDGMass = 0.497;
-                lNegdEdx = fTreeVariableNSigmasNegPion;
-                lPosdEdx = fTreeVariableNSigmasPosPion;
-            }
-            if ( lV0Result->GetMassHypothesis() == AliV0Result::kLambda      ){
-                lMass = fTreeVariableInvMassLambda;
-                lRap = fTreeVariableRapLambda;
-                lPDGMass = 1.115683;
-                lNegdEdx = fTreeVariableNSigmasNegPion;
-                lPosdEdx = fTreeVariableNSigmasPosProton;
-                lBaryonMomentum = fTreeVariablePosInnerP;
-                lBaryonPt = lThisPosInnerPt;
-                lBaryondEdxFromProton = fTreeVariableNSigmasPosProton;
-            }
-            if ( lV0Result->GetMassHypothesis() == AliV0Result::kAntiLambda  ){
-                lMass = fTreeVariableInvMassAntiLambda;
-                lRap = fTreeVariableRapLambda;
-                lPDGMass = 1.115683;
-                lNegdEdx = fTreeVariableNSigmasNegProton;
-                lPosdEdx = fTreeVariableNSigmasPosPion;
-                lBaryonMomentum = fTreeVariableNegInnerP;
-                lBaryonPt = lThisNegInnerPt;
-                lBaryondEdxFromProton = fTreeVariableNSigmasNegProton;
-            }
-            
-            if (
-                //Check 1: Offline Vertexer
-                lOnFlyStatus == lV0Result->GetUseOnTheFly() &&
-                
-                //Check 2: Basic Acceptance cuts
-                lV0Result->GetCutMinEtaTracks() < fTreeVariableNegEta && fTreeVariableNegEta < lV0Result->GetCutMaxEtaTracks() &&
-                lV0Result->GetCutMinEtaTracks() < fTreeVariablePosEta && fTreeVariablePosEta < lV0Result->GetCutMaxEtaTracks() &&
-                lRap > lV0Result->GetCutMinRapidity() &&
-                lRap < lV0Result->GetCutMaxRapidity() &&
-                
-                //Check 3: Topological Variables
-                fTreeVariableV0Radius > lV0Result->GetCutV0Radius() &&
-                fTreeVariableV0Radius < lV0Result->GetCutMaxV0Radius() &&
-                fTreeVariableDcaNegToPrimVertex > lV0Result->GetCutDCANegToPV() &&
-                fTreeVariableDcaPosToPrimVertex > lV0Result->GetCutDCAPosToPV() &&
-                fTreeVariableDcaV0Daughters < lV0Result->GetCutDCAV0Daughters() &&
-                fTreeVariableV0CosineOfPointingAngle > lV0CosPACut &&
-                fTreeVariableDistOverTotMom*lPDGMass < lV0Result->GetCutProperLifetime() &&
-                fTreeVariableLeastNbrCrossedRows > lV0Result->GetCutLeastNumberOfCrossedRows() &&
-                fTreeVariableLeastRatioCrossedRowsOverFindable > lV0Result->GetCutLeastNumberOfCrossedRowsOverFindable() &&
-                
-                //Check 4: Minimum momentum of baryon daughter
-                ( lV0Result->GetMassHypothesis() == AliV0Result::kK0Short || lBaryonMomentum > lV0Result->GetCutMinBaryonMomentum() ) &&
-                
-                //Check 5: TPC dEdx selections
-                TMath::Abs(lNegdEdx)<lV0Result->GetCutTPCdEdx() &&
-                TMath::Abs(lPosdEdx)<lV0Result->GetCutTPCdEdx() &&
-                
-                //Check 6: Armenteros-Podolanski space cut (for K0Short analysis)
-                ( ( lV0Result->GetCutArmenteros() == kFALSE || lV0Result->GetMassHypothesis() != AliV0Result::kK0Short ) || ( fTreeVariablePtArmV0>lV0Result->GetCutArmenterosParameter()*TMath::Abs(fTreeVariableAlphaV0) ) ) &&
-                
-                //Check 7: kITSrefit track selection if requested
-                (
-                 ( (fTreeVariableNegTrackStatus & AliESDtrack::kITSrefit) &&
-                  (fTreeVariablePosTrackStatus & AliESDtrack::kITSrefit) )
-                 ||
-                 !lV0Result->GetCutUseITSRefitTracks()
-                 )&&
-                
-                //Check 8: Max Chi2/Clusters if not absurd
-                ( lV0Result->GetCutMaxChi2PerCluster()>1e+3 ||
-                 fTreeVariableMaxChi2PerCluster < lV0Result->GetCutMaxChi2PerCluster()
-                 ) &&
-                //Check 9: Min Track Length if positive
-                ( lV0Result->GetCutMinTrackLength()<0 || //this is a bit paranoid...
-                 fTreeVariableMinTrackLength > lV0Result->GetCutMinTrackLength()
-                 )&&
-                
-                //Check 10: Special 2.76TeV-like dedx
-                // Logic: either not requested, or K0Short, or high-pT baryon daughter, or passes cut!
-                ( !lV0Result->GetCut276TeVLikedEdx() ||
-                 ( lV0Result->GetMassHypothesis() == AliV0Result::kK0Short ||
-                  ( lBaryonPt > 1.0 || TMath::Abs(lBaryondEdxFromProton)<3.0 )
-                  )
-                 )
-                )
-            {
-                //This satisfies all my conditionals! Fill histogram
-                histoout -> Fill ( fCentrality, fTreeVariablePt, lMass );
-            }
-        }
+        //Step 1: Buffer the candidate, the configurations of fListV0 are checked
+        //for all the candidates of the event at once after the V0 loop
+        AliWeakResultSelector::V0Candidate lV0Candidate = AliWeakResultSelector::V0Candidate();
+        lV0Candidate.fOnFlyStatus                       = lOnFlyStatus;
+        lV0Candidate.fPt                                = fTreeVariablePt;
+        lV0Candidate.fNegEta                            = fTreeVariableNegEta;
+        lV0Candidate.fPosEta                            = fTreeVariablePosEta;
+        lV0Candidate.fRapK0Short                        = fTreeVariableRapK0Short;
+        lV0Candidate.fRapLambda                         = fTreeVariableRapLambda;
+        lV0Candidate.fInvMassK0s                        = fTreeVariableInvMassK0s;
+        lV0Candidate.fInvMassLambda                     = fTreeVariableInvMassLambda;
+        lV0Candidate.fInvMassAntiLambda                 = fTreeVariableInvMassAntiLambda;
+        lV0Candidate.fV0Radius                          = fTreeVariableV0Radius;
+        lV0Candidate.fDcaNegToPrimVertex                = fTreeVariableDcaNegToPrimVertex;
+        lV0Candidate.fDcaPosToPrimVertex                = fTreeVariableDcaPosToPrimVertex;
+        lV0Candidate.fDcaV0Daughters                    = fTreeVariableDcaV0Daughters;
+        lV0Candidate.fV0CosineOfPointingAngle           = fTreeVariableV0CosineOfPointingAngle;
+        lV0Candidate.fDistOverTotMom                    = fTreeVariableDistOverTotMom;
+        lV0Candidate.fLeastNbrCrossedRows               = fTreeVariableLeastNbrCrossedRows;
+        lV0Candidate.fLeastRatioCrossedRowsOverFindable = fTreeVariableLeastRatioCrossedRowsOverFindable;
+        lV0Candidate.fPosInnerP                         = fTreeVariablePosInnerP;
+        lV0Candidate.fNegInnerP                         = fTreeVariableNegInnerP;
+        lV0Candidate.fPosInnerPt                        = lThisPosInnerPt;
+        lV0Candidate.fNegInnerPt                        = lThisNegInnerPt;
+        lV0Candidate.fNSigmasPosProton                  = fTreeVariableNSigmasPosProton;
+        lV0Candidate.fNSigmasPosPion                    = fTreeVariableNSigmasPosPion;
+        lV0Candidate.fNSigmasNegProton                  = fTreeVariableNSigmasNegProton;
+        lV0Candidate.fNSigmasNegPion                    = fTreeVariableNSigmasNegPion;
+        lV0Candidate.fPtArmV0                           = fTreeVariablePtArmV0;
+        lV0Candidate.fAlphaV0                           = fTreeVariableAlphaV0;
+        lV0Candidate.fNegTrackStatus                    = fTreeVariableNegTrackStatus;
+        lV0Candidate.fPosTrackStatus                    = fTreeVariablePosTrackStatus;
+        lV0Candidate.fMaxChi2PerCluster                 = fTreeVariableMaxChi2PerCluster;
+        lV0Candidate.fMinTrackLength                    = fTreeVariableMinTrackLength;
+        fWeakResultSelector->AddV0Candidate(lV0Candidate);
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
         // End Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
         
     }// This is the end of the V0 loop
     
+    //Step 2: Check all configurations with the V0 candidates of the event and fill
+    fWeakResultSelector->SelectV0Candidates();
+    fWeakResultSelector->FillV0Histograms( fCentrality );
+    
     //------------------------------------------------
     // Rerun cascade vertexer!
     //------------------------------------------------
@@ -1823,6 +1753,8 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
     Long_t ncascades = 0;
     ncascades = lESDevent->GetNumberOfCascades();
     
+    fWeakResultSelector->ClearCascadeCandidates();
+    
     for (Int_t iXi = 0; iXi < ncascades; iXi++) {
         //------------------------------------------------
         // Initializations
@@ -2509,325 +2441,101 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         // Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
         
-        //Step 1: Sweep members of the output object TList and fill all of them as appropriate
-        Int_t lNumberOfConfigurationsCascade = fListCascade->GetEntries();
-        //AliWarning(Form("[Cascade Analyses] Processing different configurations (%i detected)",lNumberOfConfigurationsCascade));
-        TH3F *histoout         = 0x0;
-        AliCascadeResult *lCascadeResult = 0x0;
-        for(Int_t lcfg=0; lcfg<lNumberOfConfigurationsCascade; lcfg++){
-            lCascadeResult = (AliCascadeResult*) fListCascade->At(lcfg);
-            histoout  = lCascadeResult->GetHistogram();
-            
-            Float_t lMass = 0;
-            Float_t lV0Mass = 0;
-            Float_t lRap  = 0;
-            Float_t lPDGMass = -1;
-            Float_t lNegdEdx = 100;
-            Float_t lPosdEdx = 100;
-            Float_t lBachdEdx = 100;
-            Float_t lNegTOFsigma = 100;
-            Float_t lPosTOFsigma = 100;
-            Float_t lBachTOFsigma = 100;
-            Short_t  lCharge = -2;
-            Int_t lChargePos =  1;
-            Int_t lChargeNeg = -1;
-            Float_t lprpx, lprpy, lprpz, lpipx, lpipy, lpipz;
-            lpipx = fTreeCascVarBachPx;
-            lpipy = fTreeCascVarBachPy;
-            lpipz = fTreeCascVarBachPz;
-            
-            //For parametric V0 Mass selection
-            Float_t lExpV0Mass =
-            fLambdaMassMean[0]+
-            fLambdaMassMean[1]*TMath::Exp(fLambdaMassMean[2]*lV0Pt)+
-            fLambdaMassMean[3]*TMath::Exp(fLambdaMassMean[4]*lV0Pt);
-            
-            Float_t lExpV0Sigma =
-            fLambdaMassSigma[0]+fLambdaMassSigma[1]*lV0Pt+
-            fLambdaMassSigma[2]*TMath::Exp(fLambdaMassSigma[3]*lV0Pt);
-            
-            //========================================================================
-            //For 2.76TeV-like parametric V0 CosPA
-            Float_t l276TeVV0CosPA = 0.998;
-            Float_t pThr=1.5;
-            if (lV0TotMomentum<pThr) {
-                //Below the threshold "pThr", try a momentum dependent cos(PA) cut
-                const Double_t bend=0.03; // approximate Xi bending angle
-                const Double_t qt=0.211;  // max Lambda pT in Omega decay
-                const Double_t cpaThr=TMath::Cos(TMath::ATan(qt/pThr) + bend);
-                Double_t
-                cpaCut=(0.998/cpaThr)*TMath::Cos(TMath::ATan(qt/lV0TotMomentum) + bend);
-                l276TeVV0CosPA = cpaCut;
-            }
-            //========================================================================
-            
-            //========================================================================
-            //Setting up: Variable Cascade CosPA
-            Float_t lCascCosPACut = lCascadeResult -> GetCutCascCosPA();
-            Float_t lVarCascCosPApar[5];
-            lVarCascCosPApar[0] = lCascadeResult->GetCutVarCascCosPAExp0Const();
-            lVarCascCosPApar[1] = lCascadeResult->GetCutVarCascCosPAExp0Slope();
-            lVarCascCosPApar[2] = lCascadeResult->GetCutVarCascCosPAExp1Const();
-            lVarCascCosPApar[3] = lCascadeResult->GetCutVarCascCosPAExp1Slope();
-            lVarCascCosPApar[4] = lCascadeResult->GetCutVarCascCosPAConst();
-            Float_t lVarCascCosPA = TMath::Cos(
-                                               lVarCascCosPApar[0]*TMath::Exp(lVarCascCosPApar[1]*fTreeCascVarPt) +
-                                               lVarCascCosPApar[2]*TMath::Exp(lVarCascCosPApar[3]*fTreeCascVarPt) +
-                                               lVarCascCosPApar[4]);
-            if( lCascadeResult->GetCutUseVarCascCosPA() ){
-                //Only use if tighter than the non-variable cut
-                if( lVarCascCosPA > lCascCosPACut ) lCascCosPACut = lVarCascCosPA;
-            }
-            //========================================================================
-            
-            //========================================================================
-            //Setting up: Variable V0 CosPA
-            Float_t lV0CosPACut = lCascadeResult -> GetCutV0CosPA();
-            Float_t lVarV0CosPApar[5];
-            lVarV0CosPApar[0] = lCascadeResult->GetCutVarV0CosPAExp0Const();
-            lVarV0CosPApar[1] = lCascadeResult->GetCutVarV0CosPAExp0Slope();
-            lVarV0CosPApar[2] = lCascadeResult->GetCutVarV0CosPAExp1Const();
-            lVarV0CosPApar[3] = lCascadeResult->GetCutVarV0CosPAExp1Slope();
-            lVarV0CosPApar[4] = lCascadeResult->GetCutVarV0CosPAConst();
-            Float_t lVarV0CosPA = TMath::Cos(
-                                             lVarV0CosPApar[0]*TMath::Exp(lVarV0CosPApar[1]*fTreeCascVarPt) +
-                                             lVarV0CosPApar[2]*TMath::Exp(lVarV0CosPApar[3]*fTreeCascVarPt) +
-                                             lVarV0CosPApar[4]);
-            if( lCascadeResult->GetCutUseVarV0CosPA() ){
-                //Only use if tighter than the non-variable cut
-                if( lVarV0CosPA > lV0CosPACut ) lV0CosPACut = lVarV0CosPA;
-            }
-            //========================================================================
-            
-            //========================================================================
-            //Setting up: Variable BB CosPA
-            Float_t lBBCosPACut = lCascadeResult -> GetCutBachBaryonCosPA();
-            Float_t lVarBBCosPApar[5];
-            lVarBBCosPApar[0] = lCascadeResult->GetCutVarBBCosPAExp0Const();
-            lVarBBCosPApar[1] = lCascadeResult->GetCutVarBBCosPAExp0Slope();
-            lVarBBCosPApar[2] = lCascadeResult->GetCutVarBBCosPAExp1Const();
-            lVarBBCosPApar[3] = lCascadeResult->GetCutVarBBCosPAExp1Slope();
-            lVarBBCosPApar[4] = lCascadeResult->GetCutVarBBCosPAConst();
-            Float_t lVarBBCosPA = TMath::Cos(
-                                             lVarBBCosPApar[0]*TMath::Exp(lVarBBCosPApar[1]*fTreeCascVarPt) +
-                                             lVarBBCosPApar[2]*TMath::Exp(lVarBBCosPApar[3]*fTreeCascVarPt) +
-                                             lVarBBCosPApar[4]);
-            if( lCascadeResult->GetCutUseVarBBCosPA() ){
-                //Only use if looser than the non-variable cut (WARNING: BEWARE INVERSE LOGIC)
-                if( lVarBBCosPA > lBBCosPACut ) lBBCosPACut = lVarBBCosPA;
-            }
-            //========================================================================
-            
-            //========================================================================
-            //Setting up: Variable DCA Casc Dau
-            Float_t lDCACascDauCut = lCascadeResult -> GetCutDCACascDaughters();
-            Float_t lVarDCACascDaupar[5];
-            lVarDCACascDaupar[0] = lCascadeResult->GetCutVarDCACascDauExp0Const();
-            lVarDCACascDaupar[1] = lCascadeResult->GetCutVarDCACascDauExp0Slope();
-            lVarDCACascDaupar[2] = lCascadeResult->GetCutVarDCACascDauExp1Const();
-            lVarDCACascDaupar[3] = lCascadeResult->GetCutVarDCACascDauExp1Slope();
-            lVarDCACascDaupar[4] = lCascadeResult->GetCutVarDCACascDauConst();
-            Float_t lVarDCACascDau = lVarDCACascDaupar[0]*TMath::Exp(lVarDCACascDaupar[1]*fTreeCascVarPt) +
-            lVarDCACascDaupar[2]*TMath::Exp(lVarDCACascDaupar[3]*fTreeCascVarPt) +
-            lVarDCACascDaupar[4];
-            if( lCascadeResult->GetCutUseVarDCACascDau() ){
-                //Loosest: default cut, parametric can go tighter
-                if( lVarDCACascDau < lDCACascDauCut ) lDCACascDauCut = lVarDCACascDau;
-            }
-            //========================================================================
-            
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kXiMinus     ){
-                lCharge  = -1;
-                if ( lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
-                lMass    = fTreeCascVarMassAsXi;
-                lV0Mass  = fTreeCascVarV0MassLambda;
-                lRap     = fTreeCascVarRapXi;
-                lPDGMass = 1.32171;
-                lNegdEdx = fTreeCascVarNegNSigmaPion;
-                lPosdEdx = fTreeCascVarPosNSigmaProton;
-                lBachdEdx= fTreeCascVarBachNSigmaPion;
-                lNegTOFsigma = fTreeCascVarNegTOFNSigmaPion;
-                lPosTOFsigma = fTreeCascVarPosTOFNSigmaProton;
-                lBachTOFsigma = fTreeCascVarBachTOFNSigmaPion;
-                lprpx = fTreeCascVarPosPx;
-                lprpy = fTreeCascVarPosPy;
-                lprpz = fTreeCascVarPosPz;
-            }
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kXiPlus      ){
-                lCharge  = +1;
-                if ( lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
-                lMass    = fTreeCascVarMassAsXi;
-                lV0Mass  = fTreeCascVarV0MassAntiLambda;
-                lRap     = fTreeCascVarRapXi;
-                lPDGMass = 1.32171;
-                lNegdEdx = fTreeCascVarNegNSigmaProton;
-                lPosdEdx = fTreeCascVarPosNSigmaPion;
-                lBachdEdx= fTreeCascVarBachNSigmaPion;
-                lNegTOFsigma = fTreeCascVarNegTOFNSigmaProton;
-                lPosTOFsigma = fTreeCascVarPosTOFNSigmaPion;
-                lBachTOFsigma = fTreeCascVarBachTOFNSigmaPion;
-                lprpx = fTreeCascVarNegPx;
-                lprpy = fTreeCascVarNegPy;
-                lprpz = fTreeCascVarNegPz;
-            }
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kOmegaMinus     ){
-                lCharge  = -1;
-                if ( lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
-                lMass    = fTreeCascVarMassAsOmega;
-                lV0Mass  = fTreeCascVarV0MassLambda;
-                lRap     = fTreeCascVarRapOmega;
-                lPDGMass = 1.67245;
-                lNegdEdx = fTreeCascVarNegNSigmaPion;
-                lPosdEdx = fTreeCascVarPosNSigmaProton;
-                lBachdEdx= fTreeCascVarBachNSigmaKaon;
-                lNegTOFsigma = fTreeCascVarNegTOFNSigmaPion;
-                lPosTOFsigma = fTreeCascVarPosTOFNSigmaProton;
-                lBachTOFsigma = fTreeCascVarBachTOFNSigmaKaon;
-                lprpx = fTreeCascVarPosPx;
-                lprpy = fTreeCascVarPosPy;
-                lprpz = fTreeCascVarPosPz;
-            }
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kOmegaPlus      ){
-                lCharge  = +1;
-                if ( lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
-                lMass    = fTreeCascVarMassAsOmega;
-                lV0Mass  = fTreeCascVarV0MassAntiLambda;
-                lRap     = fTreeCascVarRapOmega;
-                lPDGMass = 1.67245;
-                lNegdEdx = fTreeCascVarNegNSigmaProton;
-                lPosdEdx = fTreeCascVarPosNSigmaPion;
-                lBachdEdx= fTreeCascVarBachNSigmaKaon;
-                lNegTOFsigma = fTreeCascVarNegTOFNSigmaProton;
-                lPosTOFsigma = fTreeCascVarPosTOFNSigmaPion;
-                lBachTOFsigma = fTreeCascVarBachTOFNSigmaKaon;
-                lprpx = fTreeCascVarNegPx;
-                lprpy = fTreeCascVarNegPy;
-                lprpz = fTreeCascVarNegPz;
-            }
-            
-            if (lCascadeResult->GetCutUseTOFUnchecked() == kFALSE ){
-                //Always-pass values
-                lNegTOFsigma = 0;
-                lPosTOFsigma = 0;
-                lBachTOFsigma = 0;
-            }
-            
-            if (
-                //Check 1: Charge consistent with expectations
-                fTreeCascVarCharge == lCharge &&
-                
-                //Check 2: Basic Acceptance cuts
-                lCascadeResult->GetCutMinEtaTracks() < fTreeCascVarPosEta && fTreeCascVarPosEta < lCascadeResult->GetCutMaxEtaTracks() &&
-                lCascadeResult->GetCutMinEtaTracks() < fTreeCascVarNegEta && fTreeCascVarNegEta < lCascadeResult->GetCutMaxEtaTracks() &&
-                lCascadeResult->GetCutMinEtaTracks() < fTreeCascVarBachEta && fTreeCascVarBachEta < lCascadeResult->GetCutMaxEtaTracks() &&
-                lRap > lCascadeResult->GetCutMinRapidity() &&
-                lRap < lCascadeResult->GetCutMaxRapidity() &&
-                
-                //Check 3: Topological Variables
-                // - V0 Selections
-                fTreeCascVarDCANegToPrimVtx > lCascadeResult->GetCutDCANegToPV() &&
-                fTreeCascVarDCAPosToPrimVtx > lCascadeResult->GetCutDCAPosToPV() &&
-                fTreeCascVarDCAV0Daughters < lCascadeResult->GetCutDCAV0Daughters() &&
-                fTreeCascVarV0CosPointingAngle > lV0CosPACut &&
-                fTreeCascVarV0Radius > lCascadeResult->GetCutV0Radius() &&
-                // - Cascade Selections
-                fTreeCascVarDCAV0ToPrimVtx > lCascadeResult->GetCutDCAV0ToPV() &&
-                TMath::Abs(lV0Mass-1.116) < lCascadeResult->GetCutV0Mass() &&
-                fTreeCascVarDCABachToPrimVtx > lCascadeResult->GetCutDCABachToPV() &&
-                fTreeCascVarDCACascDaughters < lDCACascDauCut &&
-                fTreeCascVarCascCosPointingAngle > lCascCosPACut &&
-                fTreeCascVarCascRadius > lCascadeResult->GetCutCascRadius() &&
-                
-                // - Implementation of a parametric V0 Mass cut if requested
-                (
-                 ( lCascadeResult->GetCutV0MassSigma() > 50 ) || //anything goes
-                 (TMath::Abs( (lV0Mass-lExpV0Mass) / lExpV0Sigma ) < lCascadeResult->GetCutV0MassSigma() )
-                 ) &&
-                
-                // - Miscellaneous
-                fTreeCascVarDistOverTotMom*lPDGMass < lCascadeResult->GetCutProperLifetime() &&
-                fTreeCascVarLeastNbrClusters > lCascadeResult->GetCutLeastNumberOfClusters() &&
-                
-                //Check 4: TPC dEdx selections
-                TMath::Abs(lNegdEdx )<lCascadeResult->GetCutTPCdEdx() &&
-                TMath::Abs(lPosdEdx )<lCascadeResult->GetCutTPCdEdx() &&
-                TMath::Abs(lBachdEdx)<lCascadeResult->GetCutTPCdEdx() &&
-                
-                //Check 4bis: TOF selections (experimental)
-                //WARNING: if lCascadeResult->GetCutUseTOFUnchecked is false, the TOFsigmas will be zero: will always pass
-                TMath::Abs(lNegTOFsigma )< 4 &&
-                TMath::Abs(lPosTOFsigma )< 4 &&
-                TMath::Abs(lBachTOFsigma)< 4 &&
-                
-                //Check 5: Xi rejection for Omega analysis
-                ( ( lCascadeResult->GetMassHypothesis() != AliCascadeResult::kOmegaMinus && lCascadeResult->GetMassHypothesis() != AliCascadeResult::kOmegaPlus  ) || ( TMath::Abs( fTreeCascVarMassAsXi - 1.32171 ) > lCascadeResult->GetCutXiRejection() ) ) &&
-                
-                //Check 6: Experimental DCA Bachelor to Baryon cut
-                ( fTreeCascVarDCABachToBaryon > lCascadeResult->GetCutDCABachToBaryon() ) &&
-                
-                //Check 7: Experimental Bach Baryon CosPA
-                ( fTreeCascVarWrongCosPA < lBBCosPACut  ) &&
-                
-                //Check 8: Min/Max V0 Lifetime cut
-                ( ( fTreeCascVarV0Lifetime > lCascadeResult->GetCutMinV0Lifetime() ) &&
-                 ( fTreeCascVarV0Lifetime < lCascadeResult->GetCutMaxV0Lifetime() ||
-                  lCascadeResult->GetCutMaxV0Lifetime() > 1e+3 ) ) &&
-                
-                //Check 9: kITSrefit track selection if requested
-                (
-                 ( (fTreeCascVarPosTrackStatus & AliESDtrack::kITSrefit) &&
-                  (fTreeCascVarNegTrackStatus & AliESDtrack::kITSrefit) &&
-                  (fTreeCascVarBachTrackStatus & AliESDtrack::kITSrefit)
-                  )
-                 ||
-                 !lCascadeResult->GetCutUseITSRefitTracks()
-                 ) &&
-                
-                //Check 10: Max Chi2/Clusters if not absurd
-                ( lCascadeResult->GetCutMaxChi2PerCluster()>1e+3 ||
-                 fTreeCascVarMaxChi2PerCluster < lCascadeResult->GetCutMaxChi2PerCluster()
-                 )&&
-                
-                //Check 11: Min Track Length if positive
-                ( lCascadeResult->GetCutMinTrackLength()<0 || //this is a bit paranoid...
-                 fTreeCascVarMinTrackLength > lCascadeResult->GetCutMinTrackLength()
-                 )&&
-                
-                //Check 12: Check if special V0 CosPA cut used
-                //either don't use the cut at all, or make sure it's above threshold
-                ( lCascadeResult->GetCutUse276TeVV0CosPA()==kFALSE ||
-                 fTreeCascVarV0CosPointingAngle>l276TeVV0CosPA
-                 )&&
-                
-                //Check 13: 3D Cascade DCA to PV
-                ( lCascadeResult->GetCutDCACascadeToPV() > 999 ||
-                 (TMath::Sqrt(fTreeCascVarCascDCAtoPVz*fTreeCascVarCascDCAtoPVz + fTreeCascVarCascDCAtoPVxy*fTreeCascVarCascDCAtoPVxy)<lCascadeResult->GetCutDCACascadeToPV() )
-                 )&&
-                
-                //Check 14a: Negative track DCA to PV, weighted
-                ( lCascadeResult->GetCutDCANegToPVWeighted() < 0 ||
-                 (fTreeCascVarDCANegToPrimVtx/TMath::Sqrt(fTreeCascVarNegDCAPVSigmaX2*fTreeCascVarNegDCAPVSigmaX2 + fTreeCascVarNegDCAPVSigmaY2*fTreeCascVarNegDCAPVSigmaY2+1e-6)>lCascadeResult->GetCutDCANegToPVWeighted() )
-                 )&&
-                //Check 14a: Negative track DCA to PV, weighted
-                ( lCascadeResult->GetCutDCAPosToPVWeighted() < 0 ||
-                 (fTreeCascVarDCAPosToPrimVtx/TMath::Sqrt(fTreeCascVarPosDCAPVSigmaX2*fTreeCascVarPosDCAPVSigmaX2 + fTreeCascVarPosDCAPVSigmaY2*fTreeCascVarPosDCAPVSigmaY2+1e-6)>lCascadeResult->GetCutDCAPosToPVWeighted() )
-                 )&&
-                //Check 14a: Negative track DCA to PV, weighted
-                ( lCascadeResult->GetCutDCABachToPVWeighted() < 0 ||
-                 (fTreeCascVarDCABachToPrimVtx/TMath::Sqrt(fTreeCascVarBachDCAPVSigmaX2*fTreeCascVarBachDCAPVSigmaX2 + fTreeCascVarBachDCAPVSigmaY2*fTreeCascVarBachDCAPVSigmaY2+1e-6)>lCascadeResult->GetCutDCABachToPVWeighted() )
-                 )
-                )
-            {
-                //This satisfies all my conditionals! Fill histogram
-                histoout -> Fill ( fCentrality, fTreeCascVarPt, lMass );
-            }
+        //Step 1: Buffer the candidate, the configurations of fListCascade are checked
+        //for all the candidates of the event at once after the cascade loop
+        AliWeakResultSelector::CascadeCandidate lCascCandidate = AliWeakResultSelector::CascadeCandidate();
+        lCascCandidate.fCharge                = fTreeCascVarCharge;
+        lCascCandidate.fPt                    = fTreeCascVarPt;
+        lCascCandidate.fMassAsXi              = fTreeCascVarMassAsXi;
+        lCascCandidate.fMassAsOmega           = fTreeCascVarMassAsOmega;
+        lCascCandidate.fRapXi                 = fTreeCascVarRapXi;
+        lCascCandidate.fRapOmega              = fTreeCascVarRapOmega;
+        lCascCandidate.fNegEta                = fTreeCascVarNegEta;
+        lCascCandidate.fPosEta                = fTreeCascVarPosEta;
+        lCascCandidate.fBachEta               = fTreeCascVarBachEta;
+        lCascCandidate.fDCANegToPrimVtx       = fTreeCascVarDCANegToPrimVtx;
+        lCascCandidate.fDCAPosToPrimVtx       = fTreeCascVarDCAPosToPrimVtx;
+        lCascCandidate.fDCAV0Daughters        = fTreeCascVarDCAV0Daughters;
+        lCascCandidate.fV0CosPointingAngle    = fTreeCascVarV0CosPointingAngle;
+        lCascCandidate.fV0Radius              = fTreeCascVarV0Radius;
+        lCascCandidate.fDCAV0ToPrimVtx        = fTreeCascVarDCAV0ToPrimVtx;
+        lCascCandidate.fV0MassLambda          = fTreeCascVarV0MassLambda;
+        lCascCandidate.fV0MassAntiLambda      = fTreeCascVarV0MassAntiLambda;
+        lCascCandidate.fDCABachToPrimVtx      = fTreeCascVarDCABachToPrimVtx;
+        lCascCandidate.fDCACascDaughters      = fTreeCascVarDCACascDaughters;
+        lCascCandidate.fCascCosPointingAngle  = fTreeCascVarCascCosPointingAngle;
+        lCascCandidate.fCascRadius            = fTreeCascVarCascRadius;
+        lCascCandidate.fCascDCAtoPVxy         = fTreeCascVarCascDCAtoPVxy;
+        lCascCandidate.fCascDCAtoPVz          = fTreeCascVarCascDCAtoPVz;
+        lCascCandidate.fDistOverTotMom        = fTreeCascVarDistOverTotMom;
+        lCascCandidate.fLeastNbrClusters      = fTreeCascVarLeastNbrClusters;
+        lCascCandidate.fNegNSigmaPion         = fTreeCascVarNegNSigmaPion;
+        lCascCandidate.fNegNSigmaProton       = fTreeCascVarNegNSigmaProton;
+        lCascCandidate.fPosNSigmaPion         = fTreeCascVarPosNSigmaPion;
+        lCascCandidate.fPosNSigmaProton       = fTreeCascVarPosNSigmaProton;
+        lCascCandidate.fBachNSigmaPion        = fTreeCascVarBachNSigmaPion;
+        lCascCandidate.fBachNSigmaKaon        = fTreeCascVarBachNSigmaKaon;
+        lCascCandidate.fNegTOFNSigmaPion      = fTreeCascVarNegTOFNSigmaPion;
+        lCascCandidate.fNegTOFNSigmaProton    = fTreeCascVarNegTOFNSigmaProton;
+        lCascCandidate.fPosTOFNSigmaPion      = fTreeCascVarPosTOFNSigmaPion;
+        lCascCandidate.fPosTOFNSigmaProton    = fTreeCascVarPosTOFNSigmaProton;
+        lCascCandidate.fBachTOFNSigmaPion     = fTreeCascVarBachTOFNSigmaPion;
+        lCascCandidate.fBachTOFNSigmaKaon     = fTreeCascVarBachTOFNSigmaKaon;
+        lCascCandidate.fDCABachToBaryon       = fTreeCascVarDCABachToBaryon;
+        lCascCandidate.fWrongCosPA            = fTreeCascVarWrongCosPA;
+        lCascCandidate.fV0Lifetime            = fTreeCascVarV0Lifetime;
+        lCascCandidate.fNegTrackStatus        = fTreeCascVarNegTrackStatus;
+        lCascCandidate.fPosTrackStatus        = fTreeCascVarPosTrackStatus;
+        lCascCandidate.fBachTrackStatus       = fTreeCascVarBachTrackStatus;
+        lCascCandidate.fMaxChi2PerCluster     = fTreeCascVarMaxChi2PerCluster;
+        lCascCandidate.fMinTrackLength        = fTreeCascVarMinTrackLength;
+        lCascCandidate.fNegDCAPVSigmaX2       = fTreeCascVarNegDCAPVSigmaX2;
+        lCascCandidate.fNegDCAPVSigmaY2       = fTreeCascVarNegDCAPVSigmaY2;
+        lCascCandidate.fPosDCAPVSigmaX2       = fTreeCascVarPosDCAPVSigmaX2;
+        lCascCandidate.fPosDCAPVSigmaY2       = fTreeCascVarPosDCAPVSigmaY2;
+        lCascCandidate.fBachDCAPVSigmaX2      = fTreeCascVarBachDCAPVSigmaX2;
+        lCascCandidate.fBachDCAPVSigmaY2      = fTreeCascVarBachDCAPVSigmaY2;
+
+        //For parametric V0 Mass selection
+        lCascCandidate.fExpV0Mass =
+        fLambdaMassMean[0]+
+        fLambdaMassMean[1]*TMath::Exp(fLambdaMassMean[2]*lV0Pt)+
+        fLambdaMassMean[3]*TMath::Exp(fLambdaMassMean[4]*lV0Pt);
+        
+        lCascCandidate.fExpV0Sigma =
+        fLambdaMassSigma[0]+fLambdaMassSigma[1]*lV0Pt+
+        fLambdaMassSigma[2]*TMath::Exp(fLambdaMassSigma[3]*lV0Pt);
+        
+        //========================================================================
+        //For 2.76TeV-like parametric V0 CosPA
+        Float_t l276TeVV0CosPA = 0.998;
+        Float_t pThr=1.5;
+        if (lV0TotMomentum<pThr) {
+            //Below the threshold "pThr", try a momentum dependent cos(PA) cut
+            const Double_t bend=0.03; // approximate Xi bending angle
+            const Double_t qt=0.211;  // max Lambda pT in Omega decay
+            const Double_t cpaThr=TMath::Cos(TMath::ATan(qt/pThr) + bend);
+            Double_t
+            cpaCut=(0.998/cpaThr)*TMath::Cos(TMath::ATan(qt/lV0TotMomentum) + bend);
+            l276TeVV0CosPA = cpaCut;
         }
+        lCascCandidate.f276TeVV0CosPA = l276TeVV0CosPA;
+        //========================================================================
+        
+        fWeakResultSelector->AddCascadeCandidate(lCascCandidate);
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
         // End Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
         
     }// end of the Cascade loop (ESD or AOD)
     
+    //Step 2: Check all configurations with the cascade candidates of the event and fill
+    fWeakResultSelector->SelectCascadeCandidates();
+    fWeakResultSelector->FillCascadeHistograms( fCentrality );
+    
+    //Entries and statistics of the histograms filled in this event
+    fWeakResultSelector->FlushHistograms();
+    
     // Post output data.
     PostData(1, fListHist    );
     PostData(2, fListV0      );
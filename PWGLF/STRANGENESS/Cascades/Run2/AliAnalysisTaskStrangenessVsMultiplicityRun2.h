@@ -43,6 +43,7 @@ class AliESDFMD;
 class AliCFContainer;
 class AliV0Result;
 class AliCascadeResult;
+class AliWeakResultSelector;
 class AliExternalTrackParam;
 
 //#include "TString.h"
@@ -237,6 +238,7 @@ private:
     TTree  *fTreeEvent;              //! Output Tree, Events
     TTree  *fTreeV0;              //! Output Tree, V0s
     TTree  *fTreeCascade;              //! Output Tree, Cascades
+    AliWeakResultSelector *fWeakResultSelector; //! Batched selection of the V0 and cascade configurations
 
     AliPIDResponse *fPIDResponse;     // PID response object
     AliESDtrackCuts *fESDtrackCuts;   // ESD track cuts used for primary track definition
@@ -560,8 +562,9 @@ private:
     AliAnalysisTaskStrangenessVsMultiplicityRun2(const AliAnalysisTaskStrangenessVsMultiplicityRun2&);            // not implemented
     AliAnalysisTaskStrangenessVsMultiplicityRun2& operator=(const AliAnalysisTaskStrangenessVsMultiplicityRun2&); // not implemented
 
-    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2, 2);
+    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2, 3);
     //1: first implementation
+    //3: batched selection of the configurations (AliWeakResultSelector)
 };
 
 #endif
@@ -43,6 +43,7 @@ class AliESDFMD;
 class AliCFContainer;
 class AliV0Result;
 class AliCascadeResult;
+class AliWeakResultSelector;
 
 //#include "TString.h"
 //#include "AliESDtrackCuts.h"
@@ -229,6 +230,7 @@ private:
     TTree  *fTreeEvent;              //! Output Tree, Events
     TTree  *fTreeV0;              //! Output Tree, V0s
     TTree  *fTreeCascade;              //! Output Tree, Cascades
+    AliWeakResultSelector *fWeakResultSelector; //! Batched selection of the V0 and cascade configurations
     
     AliPIDResponse *fPIDResponse;     // PID response object
     AliESDtrackCuts *fESDtrackCuts;   // ESD track cuts used for primary track definition
@@ -485,8 +487,9 @@ private:
     AliAnalysisTaskStrangenessVsMultiplicityRun2pPb(const AliAnalysisTaskStrangenessVsMultiplicityRun2pPb&);            // not implemented
     AliAnalysisTaskStrangenessVsMultiplicityRun2pPb& operator=(const AliAnalysisTaskStrangenessVsMultiplicityRun2pPb&); // not implemented
     
-    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2pPb, 2);
+    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2pPb, 3);
     //1: first implementation
+    //3: batched selection of the configurations (AliWeakResultSelector)
 };
 
 #endif
@@ -41,6 +41,7 @@ class AliESDv0;
 class AliAODv0;
 
 #include <Riostream.h>
+#include <vector>
 #include "TList.h"
 #include "TH1.h"
 #include "TH2.h"
@@ -54,6 +55,7 @@ class AliAODv0;
 #include "TRandom3.h"
 #include "TLorentzVector.h"
 #include "TObjectTable.h"
+#include "TThread.h"
 //#include "AliLog.h"
 
 #include "AliESDEvent.h"
@@ -97,6 +99,33 @@ using std::endl;
 
 ClassImp(AliAnalysisTaskWeakDecayVertexer)
 
+//Output of the DCA minimization of one pair (V0: negative and positive daughter
+//at the DCA; cascade: bachelor at the DCA in fFirst)
+struct AliAnalysisTaskWeakDecayVertexer::PairCandidate {
+    Long_t fPair; //index in the pair list
+    Double_t fDCA;
+    AliExternalTrackParam fFirst;
+    AliExternalTrackParam fSecond;
+};
+
+//Contiguous range [fBegin, fEnd) of the pair list processed by one worker thread
+struct AliAnalysisTaskWeakDecayVertexer::PairChunk {
+    PairChunk() : fTask(0), fEvent(0), fB(0), fPairs(0), fBegin(0), fEnd(0),
+    fFirstParams(0), fSecondParams(0), fV0s(0), fTracks(0), fStatus(), fCandidates() {}
+    AliAnalysisTaskWeakDecayVertexer *fTask;
+    AliESDEvent *fEvent;
+    Double_t fB;
+    const std::vector<std::pair<Int_t,Int_t> > *fPairs;
+    Long_t fBegin;
+    Long_t fEnd;
+    const std::vector<AliExternalTrackParam> *fFirstParams;  //V0: negative daughters
+    const std::vector<AliExternalTrackParam> *fSecondParams; //V0: positive daughters
+    const std::vector<AliESDv0> *fV0s;                       //cascade: V0s with the mass hypothesis
+    const TArrayI *fTracks;                                  //cascade: bachelor track indices
+    std::vector<UInt_t> fStatus;                             //cascade: PropagateToDCA status bits per pair
+    std::vector<PairCandidate> fCandidates;                  //pairs passing the DCA cuts, in pair order
+};
+
 AliAnalysisTaskWeakDecayVertexer::AliAnalysisTaskWeakDecayVertexer()
 : AliAnalysisTaskSE(), fListHist(0), fPIDResponse(0),
 //________________________________________________
@@ -129,6 +158,8 @@ fkDoXYPlanePreOptCascade( kFALSE ),
 fkDoPureGeometricMinimization( kFALSE ),
 fkDoCascadeRefit( kFALSE ) ,
 fMaxIterationsWhenMinimizing(27),
+fkDoPairPreselection( kTRUE ),
+fNThreads( 1 ),
 fMinPtV0(   -1 ), //pre-selection
 fMaxPtV0( 1000 ),
 fMinPtCascade(   0.3 ),
@@ -139,6 +170,7 @@ fMassWindowAroundCascade(0.060),
 fHistEventCounter(0),
 fHistCentrality(0),
 fHistNumberOfCandidates(0), //bookkeep total number of candidates analysed
+fHistNumberOfPairs(0), //bookkeep track pairs tried by the vertexers
 fHistV0ToBachelorPropagationStatus(0)
 //________________________________________________
 {
@@ -177,6 +209,8 @@ fkDoXYPlanePreOptCascade( kFALSE ),
 fkDoPureGeometricMinimization( kFALSE ),
 fkDoCascadeRefit( kFALSE ) ,
 fMaxIterationsWhenMinimizing(27),
+fkDoPairPreselection( kTRUE ),
+fNThreads( 1 ),
 fMinPtV0(   -1 ), //pre-selection
 fMaxPtV0( 1000 ),
 fMinPtCascade(   0.3 ), //pre-selection
@@ -187,6 +221,7 @@ fMassWindowAroundCascade(0.060),
 fHistEventCounter(0),
 fHistCentrality(0),
 fHistNumberOfCandidates(0), //bookkeep total number of candidates analysed
+fHistNumberOfPairs(0), //bookkeep track pairs tried by the vertexers
 fHistV0ToBachelorPropagationStatus(0)
 //________________________________________________
 {
@@ -272,6 +307,17 @@ void AliAnalysisTaskWeakDecayVertexer::UserCreateOutputObjects()
         fHistNumberOfCandidates->GetXaxis()->SetBinLabel(4, "Cascades: re-vertexed");
         fListHist->Add(fHistNumberOfCandidates);
     }
+    if(! fHistNumberOfPairs ) {
+        //Bookkeep pairs considered / left after preselection / accepted as candidates
+        fHistNumberOfPairs = new TH1D( "fHistNumberOfPairs", "Pair count;;Pair Count",6,0,6);
+        fHistNumberOfPairs->GetXaxis()->SetBinLabel(1, "V0s: pairs considered");
+        fHistNumberOfPairs->GetXaxis()->SetBinLabel(2, "V0s: pairs preselected");
+        fHistNumberOfPairs->GetXaxis()->SetBinLabel(3, "V0s: pairs accepted");
+        fHistNumberOfPairs->GetXaxis()->SetBinLabel(4, "Cascades: pairs considered");
+        fHistNumberOfPairs->GetXaxis()->SetBinLabel(5, "Cascades: pairs preselected");
+        fHistNumberOfPairs->GetXaxis()->SetBinLabel(6, "Cascades: pairs accepted");
+        fListHist->Add(fHistNumberOfPairs);
+    }
     if(! fHistV0ToBachelorPropagationStatus ) {
         //Bookkeep bach/v0 combination attempts, please
         fHistV0ToBachelorPropagationStatus = new TH1D( "fHistV0ToBachelorPropagationStatus", "V0/Bach pair counts",10,0,10);
@@ -525,7 +571,17 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
     TArrayI neg(nentr);
     TArrayI pos(nentr);
     
+    //Step 1: per-track quantities, computed once instead of once per pair
+    //(same ordering as neg/pos; circles stored as center x, y and radius)
+    std::vector<Double_t> lNegD, lPosD;
+    std::vector<AliExternalTrackParam> lNegParam, lPosParam;
+    std::vector<Double_t> lNegCircle, lPosCircle;
+    lNegD.reserve(nentr); lPosD.reserve(nentr);
+    lNegParam.reserve(nentr); lPosParam.reserve(nentr);
+    lNegCircle.reserve(3*nentr); lPosCircle.reserve(3*nentr);
+    
     Long_t nneg=0, npos=0, nvtx=0;
+    Long_t lNPairs=0, lNPreselected=0;
     
     Long_t i;
     for (i=0; i<nentr; i++) {
@@ -544,125 +600,132 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
         if (TMath::Abs(d)<fV0VertexerSels[2]) continue;
         if (TMath::Abs(d)>fV0VertexerSels[6]) continue;
         
-        if (esdTrack->GetSign() < 0.) neg[nneg++]=i;
-        else pos[npos++]=i;
+        //Starting parameters of the DCA minimization
+        AliExternalTrackParam lParam(*esdTrack);
+        //Re-propagate to closest position to the primary vertex if asked to do so
+        if (fkResetInitialPositions){
+            Double_t dztemp[2], covartemp[3];
+            //Safety margin: 250 -> exceedingly large... not sure this makes sense, but ok
+            lParam.PropagateToDCA( vtxT3D , b , 250, dztemp, covartemp );
+        }
+        Double_t lCircle[3];
+        GetHelixCircle( &lParam, b, lCircle );
+        
+        if (esdTrack->GetSign() < 0.) {
+            neg[nneg++]=i;
+            lNegD.push_back(TMath::Abs(d));
+            lNegParam.push_back(lParam);
+            lNegCircle.insert(lNegCircle.end(), lCircle, lCircle+3);
+        } else {
+            pos[npos++]=i;
+            lPosD.push_back(TMath::Abs(d));
+            lPosParam.push_back(lParam);
+            lPosCircle.insert(lPosCircle.end(), lCircle, lCircle+3);
+        }
     }
     
-    
-    for (i=0; i<nneg; i++) {
-        Long_t nidx=neg[i];
-        AliESDtrack *ntrk=event->GetTrack(nidx);
-        
-        for (Int_t k=0; k<npos; k++) {
-            Int_t pidx=pos[k];
-            AliESDtrack *ptrk=event->GetTrack(pidx);
-            
-            //Pre-select dE/dx: only proceed if at least one of these tracks looks like a proton
-            /*
-             if(fkPreselectDedxLambda){
-             Double_t lNSigPproton = TMath::Abs(fPIDResponse->NumberOfSigmasTPC( ptrk, AliPID::kProton ));
-             Double_t lNSigNproton = TMath::Abs(fPIDResponse->NumberOfSigmasTPC( ntrk, AliPID::kProton ));
-             if( lNSigPproton>5.0 && lNSigNproton>5.0 ) continue;
-             }
-             */
-            
-            if (TMath::Abs(ntrk->GetD(xPrimaryVertex,yPrimaryVertex,b))<fV0VertexerSels[1])
-                if (TMath::Abs(ptrk->GetD(xPrimaryVertex,yPrimaryVertex,b))<fV0VertexerSels[2]) continue;
-            
-            AliExternalTrackParam nt(*ntrk), pt(*ptrk), *ntp=&nt, *ptp=&pt;
-            Double_t xn, xp, dca;
-            
-            //Improved call: use own function, including XY-pre-opt stage
-            
-            //Re-propagate to closest position to the primary vertex if asked to do so
-            if (fkResetInitialPositions){
-                Double_t dztemp[2], covartemp[3];
-                //Safety margin: 250 -> exceedingly large... not sure this makes sense, but ok
-                ntp->PropagateToDCA( vtxT3D , b , 250, dztemp, covartemp );
-                ptp->PropagateToDCA( vtxT3D , b , 250, dztemp, covartemp );
+    //Step 2: pairs, in the same order as the serial loops, in blocks of whole rows
+    //Step 3 (DCA minimization) runs in fNThreads workers, Step 4 (vertexing) serially in pair order
+    const Long_t kPairBlockSize = 100000;
+    std::vector<std::pair<Int_t,Int_t> > lPairs;
+    std::vector<PairChunk> lChunks;
+    PairChunk lTemplate;
+    lTemplate.fTask = this;
+    lTemplate.fEvent = event;
+    lTemplate.fB = b;
+    lTemplate.fPairs = &lPairs;
+    lTemplate.fFirstParams = &lNegParam;
+    lTemplate.fSecondParams = &lPosParam;
+    
+    i=0;
+    while (i<nneg) {
+        lPairs.clear();
+        for (; i<nneg && (Long_t)lPairs.size()<kPairBlockSize; i++) {
+            for (Int_t k=0; k<npos; k++) {
+                lNPairs++;
+                
+                //Pre-select dE/dx: only proceed if at least one of these tracks looks like a proton
+                /*
+                 if(fkPreselectDedxLambda){
+                 Double_t lNSigPproton = TMath::Abs(fPIDResponse->NumberOfSigmasTPC( ptrk, AliPID::kProton ));
+                 Double_t lNSigNproton = TMath::Abs(fPIDResponse->NumberOfSigmasTPC( ntrk, AliPID::kProton ));
+                 if( lNSigPproton>5.0 && lNSigNproton>5.0 ) continue;
+                 }
+                 */
+                
+                if (lNegD[i]<fV0VertexerSels[1])
+                    if (lPosD[k]<fV0VertexerSels[2]) continue;
+                
+                //Skip pairs too far apart in the transverse plane for the DCA cut
+                if ( fkDoPairPreselection &&
+                    !IsV0PairPreselected( &lNegCircle[3*i], &lPosCircle[3*k],
+                                         lNegParam[i].GetSigmaY2() + lPosParam[k].GetSigmaY2(),
+                                         lNegParam[i].GetSigmaZ2() + lPosParam[k].GetSigmaZ2() ) ) continue;
+                lNPreselected++;
+                lPairs.push_back( std::make_pair( (Int_t)i, k ) );
             }
-            
-            if( fkDoImprovedDCAV0DauPropagation ){
-                //Improved: use own call
-                dca=GetDCAV0Dau(ptp, ntp, xp, xn, b);
-            }else{
-                //Old: use old call
-                dca=nt.GetDCA(&pt,b,xn,xp);
+        }
+        if ( lPairs.empty() ) continue;
+        
+        //Step 3: DCA minimization, starting from the (re-propagated) track parameters
+        RunPairChunks( lTemplate, lPairs.size(), &MinimizeV0Pairs, lChunks );
+        
+        //Step 4: serial merge in pair order
+        for (UInt_t c=0; c<lChunks.size(); c++) {
+            std::vector<PairCandidate> &lCandidates = lChunks[c].fCandidates;
+            for (UInt_t ic=0; ic<lCandidates.size(); ic++) {
+                AliExternalTrackParam &nt = lCandidates[ic].fFirst;
+                AliExternalTrackParam &pt = lCandidates[ic].fSecond;
+                Double_t dca = lCandidates[ic].fDCA;
+                Long_t nidx=neg[lPairs[lCandidates[ic].fPair].first];
+                Int_t pidx=pos[lPairs[lCandidates[ic].fPair].second];
+                
+                //select maximum eta range (after propagation)
+                if (TMath::Abs(nt.Eta())>0.8&&fkExtraCleanup) continue;
+                if (TMath::Abs(pt.Eta())>0.8&&fkExtraCleanup) continue;
+                
+                AliESDv0 vertex(nt,nidx,pt,pidx);
+                
+                //Experimental: refit V0 if asked to do so
+                if( fkDoV0Refit ) vertex.Refit();
+                
+                //No selection: it was not previously applied, don't  apply now.
+                //if (vertex.GetChi2V0() > fChi2max) continue;
+                
+                Double_t x=vertex.Xv(), y=vertex.Yv();
+                Double_t r2=x*x + y*y;
+                if (r2 < fV0VertexerSels[5]*fV0VertexerSels[5]) continue;
+                if (r2 > fV0VertexerSels[6]*fV0VertexerSels[6]) continue;
+                
+                Float_t cpa=vertex.GetV0CosineOfPointingAngle(xPrimaryVertex,yPrimaryVertex,zPrimaryVertex);
+                
+                //Simple cosine cut (no pt dependence for now)
+                if (cpa < fV0VertexerSels[4]) continue;
+                
+                vertex.SetDcaV0Daughters(dca);
+                vertex.SetV0CosineOfPointingAngle(cpa);
+                vertex.ChangeMassHypothesis(kK0Short);
+                
+                //pre-select on pT
+                Double_t lMomX       = 0. , lMomY = 0., lMomZ = 0.;
+                Double_t lTransvMom  = 0. ;
+                vertex.GetPxPyPz( lMomX, lMomY, lMomZ );
+                lTransvMom      = TMath::Sqrt( lMomX*lMomX   + lMomY*lMomY );
+                if(lTransvMom<fMinPtV0) continue;
+                if(lTransvMom>fMaxPtV0) continue;
+                
+                event->AddV0(&vertex);
+                
+                nvtx++;
+                
+                //if ( nvtx % 10000 ) gObjectTable->Print(); //debug, REMOVE ME PLEASE
             }
-            
-            if (dca > fV0VertexerSels[3]) continue;
-            if ((xn+xp) > 2*fV0VertexerSels[6]) continue;
-            if ((xn+xp) < 2*fV0VertexerSels[5]) continue;
-            
-            /* FIXME: this correction is not implemented
-             Bool_t corrected=kFALSE;
-             if ((nt.GetX() > 3.) && (xn < 3.)) {
-             //correct for the beam pipe material
-             corrected=kTRUE;
-             }
-             if ((pt.GetX() > 3.) && (xp < 3.)) {
-             //correct for the beam pipe material
-             corrected=kTRUE;
-             }
-             if (corrected) {
-             
-             if( fkDoImprovedDCAV0DauPropagation ){
-             //Improved: use own call
-             dca=GetDCAV0Dau(&pt, &nt, xp, xn, b);
-             }else{
-             //Old: use old call
-             dca=nt.GetDCA(&pt,b,xn,xp);
-             }
-             if (dca > fV0VertexerSels[3]) continue;
-             if ((xn+xp) > 2*fV0VertexerSels[6]) continue;
-             if ((xn+xp) < 2*fV0VertexerSels[5]) continue;
-             }
-             */
-            
-            nt.PropagateTo(xn,b); pt.PropagateTo(xp,b);
-            
-            //select maximum eta range (after propagation)
-            if (TMath::Abs(nt.Eta())>0.8&&fkExtraCleanup) continue;
-            if (TMath::Abs(pt.Eta())>0.8&&fkExtraCleanup) continue;
-            
-            AliESDv0 vertex(nt,nidx,pt,pidx);
-            
-            //Experimental: refit V0 if asked to do so
-            if( fkDoV0Refit ) vertex.Refit();
-            
-            //No selection: it was not previously applied, don't  apply now.
-            //if (vertex.GetChi2V0() > fChi2max) continue;
-            
-            Double_t x=vertex.Xv(), y=vertex.Yv();
-            Double_t r2=x*x + y*y;
-            if (r2 < fV0VertexerSels[5]*fV0VertexerSels[5]) continue;
-            if (r2 > fV0VertexerSels[6]*fV0VertexerSels[6]) continue;
-            
-            Float_t cpa=vertex.GetV0CosineOfPointingAngle(xPrimaryVertex,yPrimaryVertex,zPrimaryVertex);
-            
-            //Simple cosine cut (no pt dependence for now)
-            if (cpa < fV0VertexerSels[4]) continue;
-            
-            vertex.SetDcaV0Daughters(dca);
-            vertex.SetV0CosineOfPointingAngle(cpa);
-            vertex.ChangeMassHypothesis(kK0Short);
-            
-            //pre-select on pT
-            Double_t lMomX       = 0. , lMomY = 0., lMomZ = 0.;
-            Double_t lTransvMom  = 0. ;
-            vertex.GetPxPyPz( lMomX, lMomY, lMomZ );
-            lTransvMom      = TMath::Sqrt( lMomX*lMomX   + lMomY*lMomY );
-            if(lTransvMom<fMinPtV0) continue;
-            if(lTransvMom>fMaxPtV0) continue;
-            
-            event->AddV0(&vertex);
-            
-            nvtx++;
-            
-            //if ( nvtx % 10000 ) gObjectTable->Print(); //debug, REMOVE ME PLEASE
         }
     }
-    Info("Tracks2V0vertices","Number of reconstructed V0 vertices: %ld",nvtx);
+    fHistNumberOfPairs->Fill(0.5, lNPairs);
+    fHistNumberOfPairs->Fill(1.5, lNPreselected);
+    fHistNumberOfPairs->Fill(2.5, nvtx);
+    Info("Tracks2V0vertices","Number of reconstructed V0 vertices: %ld (pairs considered: %ld, preselected: %ld)",nvtx,lNPairs,lNPreselected);
     return nvtx;
 }
 
@@ -770,9 +833,13 @@ Long_t AliAnalysisTaskWeakDecayVertexer::V0sTracks2CascadeVertices(AliESDEvent *
     }
     nV0=vtcs.GetEntriesFast();
     
-    // stores relevant tracks in another array
+    // stores relevant tracks in another array, bucketed by bachelor charge
+    // (tracks of charge 0, if any, are tried with both V0 hypotheses as before)
     Long_t nentr=(Int_t)event->GetNumberOfTracks();
     TArrayI trk(nentr); Long_t ntr=0;
+    TArrayI trkNeg(nentr), trkPos(nentr); Long_t ntrNeg=0, ntrPos=0;
+    std::vector<Double_t> lTrkXYZ, lTrkPxPyPz, lTrkCircle; //per entry of trk, for the pair preselection
+    lTrkXYZ.reserve(3*nentr); lTrkPxPyPz.reserve(3*nentr); lTrkCircle.reserve(3*nentr);
     for (i=0; i<nentr; i++) {
         AliESDtrack *esdtr=event->GetTrack(i);
         ULong_t status=esdtr->GetStatus();
@@ -786,152 +853,149 @@ Long_t AliAnalysisTaskWeakDecayVertexer::V0sTracks2CascadeVertices(AliESDEvent *
         if (esdtr->GetTPCNcls() < 70 && lThisTrackLength<80 ) continue;
         
         if (TMath::Abs(esdtr->GetD(xPrimaryVertex,yPrimaryVertex,b))<fCascadeVertexerSels[3]) continue;
+        
+        Double_t lXYZ[3], lPxPyPz[3], lCircle[3];
+        esdtr->GetXYZ(lXYZ);
+        esdtr->GetPxPyPz(lPxPyPz);
+        GetHelixCircle( esdtr, b, lCircle );
+        lTrkXYZ.insert(lTrkXYZ.end(), lXYZ, lXYZ+3);
+        lTrkPxPyPz.insert(lTrkPxPyPz.end(), lPxPyPz, lPxPyPz+3);
+        lTrkCircle.insert(lTrkCircle.end(), lCircle, lCircle+3);
+        
+        if (esdtr->GetSign()<=0) trkNeg[ntrNeg++]=ntr;
+        if (esdtr->GetSign()>=0) trkPos[ntrPos++]=ntr;
         trk[ntr++]=i;
     }
     
     Double_t massLambda=1.11568;
     Long_t ncasc=0;
-    
-    // Looking for the cascades...
-    for (i=0; i<nV0; i++) { //loop on V0s
-        AliESDv0 *v=(AliESDv0*)vtcs.UncheckedAt(i);
-        AliESDv0 v0(*v);
-        v0.ChangeMassHypothesis(kLambda0); // the v0 must be Lambda
-        if (TMath::Abs(v0.GetEffMass()-massLambda)>fCascadeVertexerSels[2]) continue;
-        for (Int_t j=0; j<ntr; j++) {//loop on tracks
-            Int_t bidx=trk[j];
-            //Bo:   if (bidx==v->GetNindex()) continue; //bachelor and v0's negative tracks must be different
-            if (bidx==v0.GetIndex(0)) continue; //Bo:  consistency 0 for neg
-            
-            AliESDtrack *btrk=event->GetTrack(bidx);
-            
-            if (btrk->GetSign()>0) continue;  // bachelor's charge
-            
-            AliESDv0 *pv0=&v0;
-            AliExternalTrackParam bt(*btrk), *pbt=&bt;
-            
-            Double_t dca=PropagateToDCA(pv0,pbt,event,b);
-            if (dca > fCascadeVertexerSels[4]) continue;
-            
-            //eta cut - test
-            if (TMath::Abs(pbt->Eta())>0.8&&fkExtraCleanup) continue;
-            
-            AliESDcascade cascade(*pv0,*pbt,bidx);//constucts a cascade candidate
-            //PH        if (cascade.GetChi2Xi() > fChi2max) continue;
-            
-            //Improve estimate of cascade decay position using uncertainties if requested to do so
-            if( fkDoCascadeRefit ) cascade.RefitCascade(pbt);
-                
-            Double_t x,y,z; cascade.GetXYZcascade(x,y,z); // Bo: bug correction
-            Double_t r2=x*x + y*y;
-            if (r2 > fCascadeVertexerSels[7]*fCascadeVertexerSels[7]) continue;   // condition on fiducial zone
-            if (r2 < fCascadeVertexerSels[6]*fCascadeVertexerSels[6]) continue;
-            
-            Double_t pxV0,pyV0,pzV0;
-            pv0->GetPxPyPz(pxV0,pyV0,pzV0);
-            if (x*pxV0+y*pyV0+z*pzV0 < 0) continue; //causality
-            
-            Double_t x1,y1,z1; pv0->GetXYZ(x1,y1,z1);
-            if (r2 > (x1*x1+y1*y1)) continue;
-            
-            if (cascade.GetCascadeCosineOfPointingAngle(xPrimaryVertex,yPrimaryVertex,zPrimaryVertex) <fCascadeVertexerSels[5]) continue; //condition on the cascade pointing angle
-            
-            //pre-select on pT
-            Double_t lXiMomX       = 0. , lXiMomY = 0., lXiMomZ = 0.;
-            Double_t lXiTransvMom  = 0. ;
-            cascade.GetPxPyPz( lXiMomX, lXiMomY, lXiMomZ );
-            lXiTransvMom      = TMath::Sqrt( lXiMomX*lXiMomX   + lXiMomY*lXiMomY );
-            if(lXiTransvMom<fMinPtCascade) continue;
-            if(lXiTransvMom>fMaxPtCascade) continue;
-            
-            //Filter masses: anti-cascade hypotheses
-            Double_t lV0quality = 0.;
-            cascade.ChangeMassHypothesis(lV0quality , 3312); // pdg code -3312 = Xi+
-            Double_t lInvMassXi = cascade.GetEffMassXi();
-            cascade.ChangeMassHypothesis(lV0quality , 3334); // pdg code -3312 = Xi+
-            Double_t lInvMassOmega = cascade.GetEffMassXi();
-            
-            //Remove if outside window of interest
-            if(TMath::Abs(lInvMassXi   -1.322)>fMassWindowAroundCascade &&
-               TMath::Abs(lInvMassOmega-1.672)>fMassWindowAroundCascade ) continue;
-            
-            cascade.SetDcaXiDaughters(dca);
-            event->AddCascade(&cascade);
-            ncasc++;
-        } // end loop tracks
-    } // end loop V0s
-    
-    // Looking for the anti-cascades...
-    for (i=0; i<nV0; i++) { //loop on V0s
-        AliESDv0 *v=(AliESDv0*)vtcs.UncheckedAt(i);
-        AliESDv0 v0(*v);
-        v0.ChangeMassHypothesis(kLambda0Bar); //the v0 must be anti-Lambda
-        if (TMath::Abs(v0.GetEffMass()-massLambda)>fCascadeVertexerSels[2]) continue;
+    Long_t lNPairs=0, lNPreselected=0;
+    
+    //Pairs in the same order as the serial loops, in blocks of whole rows: the DCA
+    //minimizations run in fNThreads workers, the cascade vertexing serially in pair order
+    const Long_t kPairBlockSize = 100000;
+    std::vector<AliESDv0> lV0s;
+    std::vector<std::pair<Int_t,Int_t> > lPairs;
+    std::vector<PairChunk> lChunks;
+    PairChunk lTemplate;
+    lTemplate.fTask = this;
+    lTemplate.fEvent = event;
+    lTemplate.fB = b;
+    lTemplate.fPairs = &lPairs;
+    lTemplate.fV0s = &lV0s;
+    lTemplate.fTracks = &trk;
+    lV0s.reserve(nV0);
+    
+    // Looking for the cascades (lHypothesis 0) and anti-cascades (lHypothesis 1)...
+    for (Int_t lHypothesis=0; lHypothesis<2; lHypothesis++) {
+        TArrayI &lBach = lHypothesis ? trkPos : trkNeg;
+        Long_t lNBach = lHypothesis ? ntrPos : ntrNeg;
+        Int_t lPDGSign = lHypothesis ? -1 : 1;
+        
+        //V0s with the Lambda (anti-Lambda) mass hypothesis
+        lV0s.clear();
+        for (i=0; i<nV0; i++) { //loop on V0s
+            AliESDv0 *v=(AliESDv0*)vtcs.UncheckedAt(i);
+            AliESDv0 v0(*v);
+            v0.ChangeMassHypothesis(lHypothesis ? kLambda0Bar : kLambda0); // the v0 must be (anti-)Lambda
+            if (TMath::Abs(v0.GetEffMass()-massLambda)>fCascadeVertexerSels[2]) continue;
+            lV0s.push_back(v0);
+        }
         
-        for (Int_t j=0; j<ntr; j++) {//loop on tracks
-            Int_t bidx=trk[j];
-            if (bidx==v0.GetIndex(1)) continue; //Bo:  consistency 1 for pos
-            
-            AliESDtrack *btrk=event->GetTrack(bidx);
-            
-            if (btrk->GetSign()<0) continue;  // bachelor's charge
-            
-            AliESDv0 *pv0=&v0;
-            AliExternalTrackParam bt(*btrk), *pbt=&bt;
-            
-            Double_t dca=PropagateToDCA(pv0,pbt,event,b);
-            if (dca > fCascadeVertexerSels[4]) continue;
-            
-            //eta cut - test
-            if (TMath::Abs(pbt->Eta())>0.8) continue;
-            
-            AliESDcascade cascade(*pv0,*pbt,bidx); //constucts a cascade candidate
-            //PH         if (cascade.GetChi2Xi() > fChi2max) continue;
-            
-            //Improve estimate of cascade decay position using uncertainties if requested to do so
-            if( fkDoCascadeRefit ) cascade.RefitCascade(pbt);
-            
-            Double_t x,y,z; cascade.GetXYZcascade(x,y,z); // Bo: bug correction
-            Double_t r2=x*x + y*y;
-            if (r2 > fCascadeVertexerSels[7]*fCascadeVertexerSels[7]) continue;   // condition on fiducial zone
-            if (r2 < fCascadeVertexerSels[6]*fCascadeVertexerSels[6]) continue;
-            
-            Double_t pxV0,pyV0,pzV0;
-            pv0->GetPxPyPz(pxV0,pyV0,pzV0);
-            if (x*pxV0+y*pyV0+z*pzV0 < 0) continue; //causality
-            
-            Double_t x1,y1,z1; pv0->GetXYZ(x1,y1,z1);
-            if (r2 > (x1*x1+y1*y1)) continue;
-            
-            if (cascade.GetCascadeCosineOfPointingAngle(xPrimaryVertex,yPrimaryVertex,zPrimaryVertex) < fCascadeVertexerSels[5]) continue; //condition on the cascade pointing angle
-            
-            //pre-select on pT
-            Double_t lXiMomX       = 0. , lXiMomY = 0., lXiMomZ = 0.;
-            Double_t lXiTransvMom  = 0. ;
-            cascade.GetPxPyPz( lXiMomX, lXiMomY, lXiMomZ );
-            lXiTransvMom  	= TMath::Sqrt( lXiMomX*lXiMomX   + lXiMomY*lXiMomY );
-            if(lXiTransvMom<fMinPtCascade) continue;
-            if(lXiTransvMom>fMaxPtCascade) continue;
-            
-            //Filter masses: anti-cascade hypotheses
-            Double_t lV0quality = 0.;
-            cascade.ChangeMassHypothesis(lV0quality , -3312); // pdg code -3312 = Xi+
-            Double_t lInvMassXi = cascade.GetEffMassXi();
-            cascade.ChangeMassHypothesis(lV0quality , -3334); // pdg code -3312 = Xi+
-            Double_t lInvMassOmega = cascade.GetEffMassXi();
-            
-            //Remove if outside window of interest
-            if(TMath::Abs(lInvMassXi   -1.322)>fMassWindowAroundCascade &&
-               TMath::Abs(lInvMassOmega-1.672)>fMassWindowAroundCascade ) continue;
-            
-            cascade.SetDcaXiDaughters(dca);
-            event->AddCascade(&cascade);
-            ncasc++;
-            
-        } // end loop tracks
-    } // end loop V0s
+        Long_t iv=0;
+        while (iv<(Long_t)lV0s.size()) {
+            lPairs.clear();
+            for (; iv<(Long_t)lV0s.size() && (Long_t)lPairs.size()<kPairBlockSize; iv++) {
+                AliESDv0 &v0 = lV0s[iv];
+                Double_t lV0XYZ[3], lV0PxPyPz[3];
+                v0.GetXYZ(lV0XYZ[0],lV0XYZ[1],lV0XYZ[2]);
+                v0.GetPxPyPz(lV0PxPyPz[0],lV0PxPyPz[1],lV0PxPyPz[2]);
+                for (Int_t jj=0; jj<lNBach; jj++) {//loop on tracks with the bachelor's charge
+                    Int_t j=lBach[jj];
+                    Int_t bidx=trk[j];
+                    //Bo:   if (bidx==v->GetNindex()) continue; //bachelor and v0's negative tracks must be different
+                    if (bidx==v0.GetIndex(lHypothesis)) continue; //Bo:  consistency 0 for neg, 1 for pos
+                    lNPairs++;
+                    
+                    //Skip pairs that cannot pass the DCA cut
+                    if ( fkDoPairPreselection &&
+                        !IsCascadePairPreselected( lV0XYZ, lV0PxPyPz, &lTrkXYZ[3*j], &lTrkPxPyPz[3*j], &lTrkCircle[3*j] ) ) continue;
+                    lNPreselected++;
+                    lPairs.push_back( std::make_pair( (Int_t)iv, j ) );
+                }
+            }
+            if ( lPairs.empty() ) continue;
+            
+            RunPairChunks( lTemplate, lPairs.size(), &MinimizeCascadePairs, lChunks );
+            
+            //Serial merge in pair order (propagation status of every pair, then candidates)
+            for (UInt_t c=0; c<lChunks.size(); c++) {
+                std::vector<PairCandidate> &lCandidates = lChunks[c].fCandidates;
+                UInt_t ic=0;
+                for (Long_t lPair=lChunks[c].fBegin; lPair<lChunks[c].fEnd; lPair++) {
+                    FillPropagationStatus( lChunks[c].fStatus[lPair-lChunks[c].fBegin] );
+                    if ( ic>=lCandidates.size() || lCandidates[ic].fPair!=lPair ) continue;
+                    PairCandidate &lCandidate = lCandidates[ic++];
+                    
+                    AliESDv0 *pv0=&lV0s[lPairs[lPair].first];
+                    AliExternalTrackParam *pbt=&lCandidate.fFirst;
+                    Int_t bidx=trk[lPairs[lPair].second];
+                    Double_t dca=lCandidate.fDCA;
+                    
+                    //eta cut - test (always applied for anti-cascades)
+                    if (TMath::Abs(pbt->Eta())>0.8&&(fkExtraCleanup||lHypothesis)) continue;
+                    
+                    AliESDcascade cascade(*pv0,*pbt,bidx);//constucts a cascade candidate
+                    //PH        if (cascade.GetChi2Xi() > fChi2max) continue;
+                    
+                    //Improve estimate of cascade decay position using uncertainties if requested to do so
+                    if( fkDoCascadeRefit ) cascade.RefitCascade(pbt);
+                    
+                    Double_t x,y,z; cascade.GetXYZcascade(x,y,z); // Bo: bug correction
+                    Double_t r2=x*x + y*y;
+                    if (r2 > fCascadeVertexerSels[7]*fCascadeVertexerSels[7]) continue;   // condition on fiducial zone
+                    if (r2 < fCascadeVertexerSels[6]*fCascadeVertexerSels[6]) continue;
+                    
+                    Double_t pxV0,pyV0,pzV0;
+                    pv0->GetPxPyPz(pxV0,pyV0,pzV0);
+                    if (x*pxV0+y*pyV0+z*pzV0 < 0) continue; //causality
+                    
+                    Double_t x1,y1,z1; pv0->GetXYZ(x1,y1,z1);
+                    if (r2 > (x1*x1+y1*y1)) continue;
+                    
+                    if (cascade.GetCascadeCosineOfPointingAngle(xPrimaryVertex,yPrimaryVertex,zPrimaryVertex) <fCascadeVertexerSels[5]) continue; //condition on the cascade pointing angle
+                    
+                    //pre-select on pT
+                    Double_t lXiMomX       = 0. , lXiMomY = 0., lXiMomZ = 0.;
+                    Double_t lXiTransvMom  = 0. ;
+                    cascade.GetPxPyPz( lXiMomX, lXiMomY, lXiMomZ );
+                    lXiTransvMom      = TMath::Sqrt( lXiMomX*lXiMomX   + lXiMomY*lXiMomY );
+                    if(lXiTransvMom<fMinPtCascade) continue;
+                    if(lXiTransvMom>fMaxPtCascade) continue;
+                    
+                    //Filter masses: Xi-/Omega- (Xi+/Omega+ for anti-cascades)
+                    Double_t lV0quality = 0.;
+                    cascade.ChangeMassHypothesis(lV0quality , lPDGSign*3312); // pdg code 3312 = Xi-
+                    Double_t lInvMassXi = cascade.GetEffMassXi();
+                    cascade.ChangeMassHypothesis(lV0quality , lPDGSign*3334); // pdg code 3334 = Omega-
+                    Double_t lInvMassOmega = cascade.GetEffMassXi();
+                    
+                    //Remove if outside window of interest
+                    if(TMath::Abs(lInvMassXi   -1.322)>fMassWindowAroundCascade &&
+                       TMath::Abs(lInvMassOmega-1.672)>fMassWindowAroundCascade ) continue;
+                    
+                    cascade.SetDcaXiDaughters(dca);
+                    event->AddCascade(&cascade);
+                    ncasc++;
+                } // end loop pairs
+            } // end loop chunks
+        }
+    } // end loop hypotheses
     
-    Info("V0sTracks2CascadeVertices","Number of reconstructed cascades: %ld",ncasc);
+    fHistNumberOfPairs->Fill(3.5, lNPairs);
+    fHistNumberOfPairs->Fill(4.5, lNPreselected);
+    fHistNumberOfPairs->Fill(5.5, ncasc);
+    Info("V0sTracks2CascadeVertices","Number of reconstructed cascades: %ld (pairs considered: %ld, preselected: %ld)",ncasc,lNPairs,lNPreselected);
     
     return ncasc;
 }
@@ -1056,6 +1120,8 @@ Long_t AliAnalysisTaskWeakDecayVertexer::V0sTracks2CascadeVerticesUncheckedCharg
     // stores candidate bachelor tracks in another array
     Int_t nentr=(Int_t)event->GetNumberOfTracks();
     TArrayI trk(nentr); Int_t ntr=0;
+    std::vector<Double_t> lTrkXYZ, lTrkPxPyPz, lTrkCircle; //per entry of trk, for the pair preselection
+    lTrkXYZ.reserve(3*nentr); lTrkPxPyPz.reserve(3*nentr); lTrkCircle.reserve(3*nentr);
     for (i=0; i<nentr; i++) {
         AliESDtrack *esdtr=event->GetTrack(i);
         
@@ -1071,11 +1137,20 @@ Long_t AliAnalysisTaskWeakDecayVertexer::V0sTracks2CascadeVerticesUncheckedCharg
         
         if (TMath::Abs(esdtr->GetD(xPrimaryVertex,yPrimaryVertex,b))<fCascadeVertexerSels[3]) continue;
         
+        Double_t lXYZ[3], lPxPyPz[3], lCircle[3];
+        esdtr->GetXYZ(lXYZ);
+        esdtr->GetPxPyPz(lPxPyPz);
+        GetHelixCircle( esdtr, b, lCircle );
+        lTrkXYZ.insert(lTrkXYZ.end(), lXYZ, lXYZ+3);
+        lTrkPxPyPz.insert(lTrkPxPyPz.end(), lPxPyPz, lPxPyPz+3);
+        lTrkCircle.insert(lTrkCircle.end(), lCircle, lCircle+3);
+        
         trk[ntr++]=i;
     }
     
     Double_t massLambda=1.11568;
     Int_t ncasc=0;
+    Long_t lNPairs=0, lNPreselected=0;
     
     // Looking for both cascades and anti-cascades simultaneously
     
@@ -1096,6 +1171,9 @@ Long_t AliAnalysisTaskWeakDecayVertexer::V0sTracks2CascadeVerticesUncheckedCharg
         //Only disregard if it does not pass any of the desired hypotheses
         if (TMath::Abs(lMassAsLambda-massLambda)>fCascadeVertexerSels[2] &&
             TMath::Abs(lMassAsAntiLambda-massLambda)>fCascadeVertexerSels[2]) continue;
+        Double_t lV0XYZ[3], lV0PxPyPz[3];
+        v0.GetXYZ(lV0XYZ[0],lV0XYZ[1],lV0XYZ[2]);
+        v0.GetPxPyPz(lV0PxPyPz[0],lV0PxPyPz[1],lV0PxPyPz[2]);
         
         for (Int_t j=0; j<ntr; j++) {//loop on tracks
             Int_t bidx=trk[j];
@@ -1103,6 +1181,12 @@ Long_t AliAnalysisTaskWeakDecayVertexer::V0sTracks2CascadeVerticesUncheckedCharg
             if (bidx==v0.GetIndex(0)) continue; //Bo:  consistency 0 for neg
             if (bidx==v0.GetIndex(1)) continue; //Bo:  consistency 0 for neg
             if (v0.GetIndex(0)==v0.GetIndex(1)) continue; //Bo:  consistency 0 for neg
+            lNPairs++;
+            
+            //Skip pairs that cannot pass the DCA cut
+            if ( fkDoPairPreselection &&
+                !IsCascadePairPreselected( lV0XYZ, lV0PxPyPz, &lTrkXYZ[3*j], &lTrkPxPyPz[3*j], &lTrkCircle[3*j] ) ) continue;
+            lNPreselected++;
             
             AliESDtrack *btrk=event->GetTrack(bidx);
             
@@ -1141,7 +1225,10 @@ Long_t AliAnalysisTaskWeakDecayVertexer::V0sTracks2CascadeVerticesUncheckedCharg
         } // end loop tracks
     } // end loop V0s
     
-    Info("V0sTracks2CascadeVerticesUncheckedCharges","Number of reconstructed cascades: %d",ncasc);
+    fHistNumberOfPairs->Fill(3.5, lNPairs);
+    fHistNumberOfPairs->Fill(4.5, lNPreselected);
+    fHistNumberOfPairs->Fill(5.5, ncasc);
+    Info("V0sTracks2CascadeVerticesUncheckedCharges","Number of reconstructed cascades: %d (pairs considered: %ld, preselected: %ld)",ncasc,lNPairs,lNPreselected);
     
     return 0;
 }
@@ -1165,13 +1252,15 @@ Double_t AliAnalysisTaskWeakDecayVertexer::Det(Double_t a00,Double_t a01,Double_
 }
 
 //________________________________________________________________________
-Double_t AliAnalysisTaskWeakDecayVertexer::PropagateToDCA(AliESDv0 *v, AliExternalTrackParam *t, AliESDEvent *event, Double_t b) {
+Double_t AliAnalysisTaskWeakDecayVertexer::PropagateToDCA(AliESDv0 *v, AliExternalTrackParam *t, AliESDEvent *event, Double_t b, UInt_t *lStatus) {
     //--------------------------------------------------------------------
     // This function returns the DCA between the V0 and the track
+    // With lStatus, the propagation status is returned as bits (1<<bin)
+    // instead of being filled (used by the worker threads)
     //--------------------------------------------------------------------
     
     //Count received
-    fHistV0ToBachelorPropagationStatus->Fill(0.5);
+    CountPropagationStatus(lStatus, 0);
     
     Double_t alpha=t->GetAlpha(), cs1=TMath::Cos(alpha), sn1=TMath::Sin(alpha);
     Double_t r[3]; t->GetXYZ(r);
@@ -1206,17 +1295,17 @@ Double_t AliAnalysisTaskWeakDecayVertexer::PropagateToDCA(AliESDv0 *v, AliExtern
         x1=x1*cs1 + y1*sn1;
         if (!t->PropagateTo(x1,b)) {
             //Count linear propagation failures
-            fHistV0ToBachelorPropagationStatus->Fill(1.5);
-            Error("PropagateToDCA","Propagation failed !");
+            CountPropagationStatus(lStatus, 1);
+            if (!lStatus) Error("PropagateToDCA","Propagation failed !");
             return 1.e+33;
         }
         //Count linear propagation successes
-        fHistV0ToBachelorPropagationStatus->Fill(2.5);
+        CountPropagationStatus(lStatus, 2);
     }
     
     if( fkDoImprovedDCACascDauPropagation ){
         //Count Improved Cascade propagation received
-        fHistV0ToBachelorPropagationStatus->Fill(3.5); //bin 4
+        CountPropagationStatus(lStatus, 3); //bin 4
         
         //DCA Calculation improved -> non-linear propagation
         //Preparatory step 1: get two tracks corresponding to V0
@@ -1416,12 +1505,12 @@ Double_t AliAnalysisTaskWeakDecayVertexer::PropagateToDCA(AliESDv0 *v, AliExtern
                     if ((gt1*gt1+gt2*gt2) > 1.e-4/dy2/dy2){
                         AliDebug(1," stopped at not a stationary point !");
                         //Count not stationary point
-                        fHistV0ToBachelorPropagationStatus->Fill(4.5); //bin 5
+                        CountPropagationStatus(lStatus, 4); //bin 5
                     }
                     Double_t lmb=h11+h22; lmb=lmb-TMath::Sqrt(lmb*lmb-4*det);
                     if (lmb < 0.){
                         //Count stopped at not a minimum
-                        fHistV0ToBachelorPropagationStatus->Fill(5.5);
+                        CountPropagationStatus(lStatus, 5);
                         AliDebug(1," stopped at not a minimum !");
                     }
                     break;
@@ -1438,7 +1527,7 @@ Double_t AliAnalysisTaskWeakDecayVertexer::PropagateToDCA(AliESDv0 *v, AliExtern
                 if (div>512) {
                     AliDebug(1," overshoot !"); break;
                     //Count overshoots
-                    fHistV0ToBachelorPropagationStatus->Fill(6.5);
+                    CountPropagationStatus(lStatus, 6);
                 }
             }
             dm=dd;
@@ -1451,7 +1540,7 @@ Double_t AliAnalysisTaskWeakDecayVertexer::PropagateToDCA(AliESDv0 *v, AliExtern
         if (max<=0){
             AliDebug(1," too many iterations !");
             //Count excessive iterations
-            fHistV0ToBachelorPropagationStatus->Fill(7.5);
+            CountPropagationStatus(lStatus, 7);
         }
         
         Double_t cs=TMath::Cos(t->GetAlpha());
@@ -1462,19 +1551,34 @@ Double_t AliAnalysisTaskWeakDecayVertexer::PropagateToDCA(AliESDv0 *v, AliExtern
         if (!t->PropagateTo(xthis,b)) {
             //AliWarning(" propagation failed !";
             //Count curved propagation failures
-            fHistV0ToBachelorPropagationStatus->Fill(8.5);
+            CountPropagationStatus(lStatus, 8);
             return 1e+33;
         }
         
         //V0 distance to bachelor: the desired distance
         Double_t rBachDCAPt[3]; t->GetXYZ(rBachDCAPt);
         dca = v->GetD(rBachDCAPt[0],rBachDCAPt[1],rBachDCAPt[2]);
-        fHistV0ToBachelorPropagationStatus->Fill(9.5);
+        CountPropagationStatus(lStatus, 9);
     }
     
     return dca;
 }
 
+//________________________________________________________________________
+void AliAnalysisTaskWeakDecayVertexer::CountPropagationStatus(UInt_t *lStatus, Int_t lBin) {
+    //Fill bin lBin of fHistV0ToBachelorPropagationStatus, or record it in lStatus
+    if (lStatus) *lStatus |= (1u<<lBin);
+    else fHistV0ToBachelorPropagationStatus->Fill(lBin+0.5);
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskWeakDecayVertexer::FillPropagationStatus(UInt_t lStatus) {
+    //Fill the propagation status recorded by PropagateToDCA in a worker thread
+    for (Int_t lBin=0; lBin<10; lBin++)
+        if (lStatus & (1u<<lBin)) fHistV0ToBachelorPropagationStatus->Fill(lBin+0.5);
+    if (lStatus & (1u<<1)) Error("PropagateToDCA","Propagation failed !");
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskWeakDecayVertexer::Evaluate(const Double_t *h, Double_t t,
                                                 Double_t r[3],  //radius vector
@@ -1936,3 +2040,201 @@ void AliAnalysisTaskWeakDecayVertexer::GetHelixCenter(const AliExternalTrackPara
     center[1] =	ypos + ypoint;
     return;
 }
+
+//________________________________________________________________________
+void AliAnalysisTaskWeakDecayVertexer::GetHelixCircle(const AliExternalTrackParam *track, Double_t b, Double_t circle[3]) const {
+    //--------------------------------------------------------------------
+    // Center and radius, in the XY plane, of the helix followed in the
+    // DCA minimizations (see Evaluate). Radius -1 for a straight track
+    //--------------------------------------------------------------------
+    Double_t p[6]; track->GetHelixParameters(p,b);
+    if (TMath::Abs(p[4])<=kAlmost0) {
+        circle[0] = 0.;
+        circle[1] = 0.;
+        circle[2] = -1.;
+        return;
+    }
+    circle[0] = p[5] - TMath::Sin(p[2])/p[4];
+    circle[1] = p[0] + TMath::Cos(p[2])/p[4];
+    circle[2] = TMath::Abs(1./p[4]);
+}
+
+//________________________________________________________________________
+Bool_t AliAnalysisTaskWeakDecayVertexer::IsV0PairPreselected(const Double_t *lNegCircle, const Double_t *lPosCircle,
+                                                             Double_t lSigmaY2, Double_t lSigmaZ2) const {
+    //--------------------------------------------------------------------
+    // Returns kFALSE only for pairs that cannot pass the DCA V0 daughters
+    // cut. Both AliExternalTrackParam::GetDCA and GetDCAV0Dau return
+    // sqrt(dm*sqrt(dy2*dz2)) for two points on the helices, with
+    // dm >= dxy^2/dy2: the DCA is at least the distance between the two
+    // circles in XY, times (dz2/dy2)^(1/4)
+    //--------------------------------------------------------------------
+    if ( lNegCircle[2]<0 || lPosCircle[2]<0 ) return kTRUE; //straight tracks
+    if ( !(lSigmaY2>0) || !(lSigmaZ2>0) ) return kTRUE;
+    
+    Double_t lDist = TMath::Sqrt(
+                                 TMath::Power( lNegCircle[0] - lPosCircle[0] , 2) +
+                                 TMath::Power( lNegCircle[1] - lPosCircle[1] , 2)
+                                 );
+    Double_t lGap = 0.;
+    if ( lDist > lNegCircle[2] + lPosCircle[2] ) lGap = lDist - lNegCircle[2] - lPosCircle[2]; //apart
+    if ( lDist < TMath::Abs(lNegCircle[2] - lPosCircle[2]) ) lGap = TMath::Abs(lNegCircle[2] - lPosCircle[2]) - lDist; //one inside the other
+    
+    //1e-3 cm: margin for the rounding in the propagations
+    Double_t lBound = lGap*TMath::Power(lSigmaZ2/lSigmaY2, 0.25);
+    return !( lBound > fV0VertexerSels[3] + 1e-3 );
+}
+
+//________________________________________________________________________
+Bool_t AliAnalysisTaskWeakDecayVertexer::IsCascadePairPreselected(const Double_t *lV0Pos, const Double_t *lV0Mom,
+                                                                  const Double_t *lBachPos, const Double_t *lBachMom,
+                                                                  const Double_t *lBachCircle) const {
+    //--------------------------------------------------------------------
+    // Returns kFALSE only for pairs for which PropagateToDCA cannot return
+    // a DCA passing the cascade daughters cut:
+    //  - linear case: the returned value is the DCA between the bachelor
+    //    and V0 straight lines, calculated here in the same way
+    //  - improved case: the returned value is the distance of a point of
+    //    the bachelor helix to the V0 line, at least the distance between
+    //    the helix circle and the V0 line in the XY plane
+    //--------------------------------------------------------------------
+    Double_t lCut = fCascadeVertexerSels[4] + 1e-3; //margin for the rounding in the propagations
+    
+    if ( !fkDoImprovedDCACascDauPropagation ){
+        Double_t x1=lBachPos[0], y1=lBachPos[1], z1=lBachPos[2];
+        Double_t px1=lBachMom[0], py1=lBachMom[1], pz1=lBachMom[2];
+        Double_t x2=lV0Pos[0], y2=lV0Pos[1], z2=lV0Pos[2];
+        Double_t px2=lV0Mom[0], py2=lV0Mom[1], pz2=lV0Mom[2];
+        
+        Double_t dd= Det(x2-x1,y2-y1,z2-z1,px1,py1,pz1,px2,py2,pz2);
+        Double_t ax= Det(py1,pz1,py2,pz2);
+        Double_t ay=-Det(px1,pz1,px2,pz2);
+        Double_t az= Det(px1,py1,px2,py2);
+        
+        Double_t dca=TMath::Abs(dd)/TMath::Sqrt(ax*ax + ay*ay + az*az);
+        return !( dca > lCut );
+    }
+    
+    if ( lBachCircle[2]<0 ) return kTRUE; //straight track
+    Double_t lV0Pt = TMath::Sqrt( lV0Mom[0]*lV0Mom[0] + lV0Mom[1]*lV0Mom[1] );
+    if ( !(lV0Pt>0) ) return kTRUE;
+    
+    //Distance of the circle center to the V0 line in XY
+    Double_t lDist = TMath::Abs( (lV0Pos[0]-lBachCircle[0])*lV0Mom[1] - (lV0Pos[1]-lBachCircle[1])*lV0Mom[0] ) / lV0Pt;
+    return !( lDist - lBachCircle[2] > lCut );
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskWeakDecayVertexer::RunPairChunks(const PairChunk &lTemplate, Long_t lNPairs, void *(*lWorker)(void *), std::vector<PairChunk> &lChunks) {
+    // Splits the pair list in up to fNThreads contiguous chunks and runs lWorker
+    // on each of them. The workers only touch their own chunk and copies of the
+    // track parameters: histograms and the event are filled afterwards by the
+    // caller, in pair order, so the output does not depend on fNThreads.
+    Long_t lNChunks = TMath::Max(1L, TMath::Min((Long_t)fNThreads, lNPairs));
+    lChunks.assign(lNChunks, lTemplate);
+    for (Long_t c=0; c<lNChunks; c++) {
+        lChunks[c].fBegin = lNPairs*c/lNChunks;
+        lChunks[c].fEnd = lNPairs*(c+1)/lNChunks;
+        lChunks[c].fStatus.assign(lChunks[c].fEnd-lChunks[c].fBegin, 0);
+    }
+    if (lNChunks==1) {
+        lWorker(&lChunks[0]);
+        return;
+    }
+    TThread::Initialize();
+    std::vector<TThread*> lThreads(lNChunks);
+    for (Long_t c=0; c<lNChunks; c++) {
+        lThreads[c] = new TThread(Form("WeakDecayVertexer%ld",c),lWorker,&lChunks[c]);
+        lThreads[c]->Run();
+    }
+    for (Long_t c=0; c<lNChunks; c++) {
+        lThreads[c]->Join();
+        delete lThreads[c];
+    }
+}
+
+//________________________________________________________________________
+void *AliAnalysisTaskWeakDecayVertexer::MinimizeV0Pairs(void *lArg) {
+    //thread function of Tracks2V0vertices: daughter DCA minimization and DCA cuts
+    PairChunk *lChunk = static_cast<PairChunk*>(lArg);
+    AliAnalysisTaskWeakDecayVertexer *lTask = lChunk->fTask;
+    Double_t b = lChunk->fB;
+    for (Long_t lPair=lChunk->fBegin; lPair<lChunk->fEnd; lPair++) {
+        const std::pair<Int_t,Int_t> &lIdx = (*lChunk->fPairs)[lPair];
+        AliExternalTrackParam nt((*lChunk->fFirstParams)[lIdx.first]), pt((*lChunk->fSecondParams)[lIdx.second]), *ntp=&nt, *ptp=&pt;
+        Double_t xn, xp, dca;
+        
+        //Improved call: use own function, including XY-pre-opt stage
+        
+        if( lTask->fkDoImprovedDCAV0DauPropagation ){
+            //Improved: use own call
+            dca=lTask->GetDCAV0Dau(ptp, ntp, xp, xn, b);
+        }else{
+            //Old: use old call
+            dca=nt.GetDCA(&pt,b,xn,xp);
+        }
+        
+        if (dca > lTask->fV0VertexerSels[3]) continue;
+        if ((xn+xp) > 2*lTask->fV0VertexerSels[6]) continue;
+        if ((xn+xp) < 2*lTask->fV0VertexerSels[5]) continue;
+        
+        /* FIXME: this correction is not implemented
+         Bool_t corrected=kFALSE;
+         if ((nt.GetX() > 3.) && (xn < 3.)) {
+         //correct for the beam pipe material
+         corrected=kTRUE;
+         }
+         if ((pt.GetX() > 3.) && (xp < 3.)) {
+         //correct for the beam pipe material
+         corrected=kTRUE;
+         }
+         if (corrected) {
+         
+         if( fkDoImprovedDCAV0DauPropagation ){
+         //Improved: use own call
+         dca=GetDCAV0Dau(&pt, &nt, xp, xn, b);
+         }else{
+         //Old: use old call
+         dca=nt.GetDCA(&pt,b,xn,xp);
+         }
+         if (dca > fV0VertexerSels[3]) continue;
+         if ((xn+xp) > 2*fV0VertexerSels[6]) continue;
+         if ((xn+xp) < 2*fV0VertexerSels[5]) continue;
+         }
+         */
+        
+        nt.PropagateTo(xn,b); pt.PropagateTo(xp,b);
+        
+        lChunk->fCandidates.push_back(PairCandidate());
+        PairCandidate &lCandidate = lChunk->fCandidates.back();
+        lCandidate.fPair = lPair;
+        lCandidate.fDCA = dca;
+        lCandidate.fFirst = nt;
+        lCandidate.fSecond = pt;
+    }
+    return 0;
+}
+
+//________________________________________________________________________
+void *AliAnalysisTaskWeakDecayVertexer::MinimizeCascadePairs(void *lArg) {
+    //thread function of V0sTracks2CascadeVertices: V0-bachelor DCA minimization and DCA cut
+    PairChunk *lChunk = static_cast<PairChunk*>(lArg);
+    AliAnalysisTaskWeakDecayVertexer *lTask = lChunk->fTask;
+    for (Long_t lPair=lChunk->fBegin; lPair<lChunk->fEnd; lPair++) {
+        const std::pair<Int_t,Int_t> &lIdx = (*lChunk->fPairs)[lPair];
+        //shared V0, only read by PropagateToDCA
+        AliESDv0 *pv0 = const_cast<AliESDv0*>(&(*lChunk->fV0s)[lIdx.first]);
+        AliESDtrack *btrk = lChunk->fEvent->GetTrack((*lChunk->fTracks)[lIdx.second]);
+        AliExternalTrackParam bt(*btrk);
+        
+        Double_t dca=lTask->PropagateToDCA(pv0,&bt,lChunk->fEvent,lChunk->fB,&lChunk->fStatus[lPair-lChunk->fBegin]);
+        if (dca > lTask->fCascadeVertexerSels[4]) continue;
+        
+        lChunk->fCandidates.push_back(PairCandidate());
+        PairCandidate &lCandidate = lChunk->fCandidates.back();
+        lCandidate.fPair = lPair;
+        lCandidate.fDCA = dca;
+        lCandidate.fFirst = bt;
+    }
+    return 0;
+}
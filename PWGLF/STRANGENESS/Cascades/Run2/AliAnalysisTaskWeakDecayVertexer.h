@@ -33,6 +33,9 @@ class AliESDEvent;
 class AliPhysicsSelection;
 
 #include "AliEventCuts.h"
+#if !defined(__CINT__)
+#include <vector>
+#endif
 
 class AliAnalysisTaskWeakDecayVertexer : public AliAnalysisTaskSE {
 public:
@@ -96,6 +99,14 @@ public:
     void SetMaxIterations (Long_t lMaxIter = 100){
         fMaxIterationsWhenMinimizing = lMaxIter;
     }
+    void SetDoPairPreselection( Bool_t lOpt = kTRUE ){
+        //Skip pairs that cannot pass the daughter DCA cuts (no change in output)
+        fkDoPairPreselection = lOpt;
+    }
+    void SetNThreads( Int_t lNThreads = 1 ){
+        //Worker threads for the DCA minimizations of the V0 and cascade finders (no change in output)
+        fNThreads = lNThreads;
+    }
     
     
 //---------------------------------------------------------------------------------------
@@ -211,7 +222,8 @@ public:
     Double_t Det(Double_t a00,Double_t a01,Double_t a02,
                  Double_t a10,Double_t a11,Double_t a12,
                  Double_t a20,Double_t a21,Double_t a22) const;
-    Double_t PropagateToDCA(AliESDv0 *vtx,AliExternalTrackParam *trk, AliESDEvent *event, Double_t b);
+    Double_t PropagateToDCA(AliESDv0 *vtx,AliExternalTrackParam *trk, AliESDEvent *event, Double_t b, UInt_t *lStatus = 0x0);
+    void CountPropagationStatus(UInt_t *lStatus, Int_t lBin);
     void Evaluate(const Double_t *h, Double_t t,
                   Double_t r[3],  //radius vector
                   Double_t g[3],  //first defivatives
@@ -222,6 +234,24 @@ public:
     Double_t GetDCAV0Dau ( AliExternalTrackParam *pt, AliExternalTrackParam *nt, Double_t &xp, Double_t &xn, Double_t b);
     void GetHelixCenter(const AliExternalTrackParam *track,Double_t center[2], Double_t b);
     //---------------------------------------------------------------------------------------
+    //Pair preselection: lower bounds of the DCAs found by the minimizations
+    void GetHelixCircle(const AliExternalTrackParam *track, Double_t b, Double_t circle[3]) const;
+    Bool_t IsV0PairPreselected(const Double_t *lNegCircle, const Double_t *lPosCircle,
+                               Double_t lSigmaY2, Double_t lSigmaZ2) const;
+    Bool_t IsCascadePairPreselected(const Double_t *lV0Pos, const Double_t *lV0Mom,
+                                    const Double_t *lBachPos, const Double_t *lBachMom,
+                                    const Double_t *lBachCircle) const;
+    //---------------------------------------------------------------------------------------
+#if !defined(__CINT__)
+    //Pair DCA minimizations in worker threads, each on a contiguous range of the pair list
+    struct PairCandidate;
+    struct PairChunk;
+    static void *MinimizeV0Pairs(void *lArg);
+    static void *MinimizeCascadePairs(void *lArg);
+    void RunPairChunks(const PairChunk &lTemplate, Long_t lNPairs, void *(*lWorker)(void *), std::vector<PairChunk> &lChunks);
+    void FillPropagationStatus(UInt_t lStatus);
+    //---------------------------------------------------------------------------------------
+#endif
 
 private:
     // Note : In ROOT, "//!" means "do not stream the data from Master node to Worker node" ...
@@ -262,6 +292,8 @@ private:
     Bool_t fkDoPureGeometricMinimization;
     Bool_t fkDoCascadeRefit; //WARNING: needs DoV0Refit!
     Long_t fMaxIterationsWhenMinimizing;
+    Bool_t fkDoPairPreselection; //if true, skip pairs that cannot pass the DCA cuts before minimizing
+    Int_t fNThreads; //number of worker threads for the DCA minimizations
     
     //Min/Max pT for cascades
     Float_t fMinPtV0; //minimum pt above which we keep candidates in TTree output
@@ -282,6 +314,7 @@ private:
     TH1D *fHistEventCounter; //!
     TH1D *fHistCentrality; //!
     TH1D *fHistNumberOfCandidates; //!
+    TH1D *fHistNumberOfPairs; //! pairs considered, preselected and accepted by the vertexers
     
      
     TH1D *fHistV0ToBachelorPropagationStatus; //! 
@@ -289,8 +322,10 @@ private:
     AliAnalysisTaskWeakDecayVertexer(const AliAnalysisTaskWeakDecayVertexer&);            // not implemented
     AliAnalysisTaskWeakDecayVertexer& operator=(const AliAnalysisTaskWeakDecayVertexer&); // not implemented
 
-    ClassDef(AliAnalysisTaskWeakDecayVertexer, 1);
+    ClassDef(AliAnalysisTaskWeakDecayVertexer, 3);
     //1: first implementation
+    //2: pair preselection and pair counters
+    //3: worker threads for the pair DCA minimizations
 };
 
 #endif
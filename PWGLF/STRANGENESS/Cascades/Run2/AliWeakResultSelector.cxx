@@ -0,0 +1,1114 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// Batched selection of V0 and cascade candidates with all the
+// AliV0Result / AliCascadeResult configurations of a task
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include "TList.h"
+#include "TH3F.h"
+#include "TMath.h"
+#include "AliESDtrack.h"
+#include "AliV0Result.h"
+#include "AliCascadeResult.h"
+#include "AliWeakResultSelector.h"
+#include "AliLog.h"
+
+ClassImp(AliWeakResultSelector);
+
+namespace {
+    //Same binning of two axes (fixed or variable bins)
+    Bool_t SameAxis(const TAxis *a, const TAxis *b){
+        if( a->GetNbins() != b->GetNbins() ) return kFALSE;
+        if( a->GetXmin()  != b->GetXmin()  ) return kFALSE;
+        if( a->GetXmax()  != b->GetXmax()  ) return kFALSE;
+        const TArrayD *abins = a->GetXbins();
+        const TArrayD *bbins = b->GetXbins();
+        if( abins->GetSize() != bbins->GetSize() ) return kFALSE;
+        for(Int_t i=0; i<abins->GetSize(); i++) if( abins->At(i) != bbins->At(i) ) return kFALSE;
+        return kTRUE;
+    }
+}
+
+//________________________________________________________________
+AliWeakResultSelector::AliWeakResultSelector() :
+TObject(),
+fOptions(0),
+fListV0(0x0),
+fNV0Configs(0),
+fV0Position(),
+fV0Config(),
+fV0Hypo(),
+fV0Flags(),
+fV0VarCosPA(),
+fV0BinningGroup(),
+fV0VarPars(),
+fListCascade(0x0),
+fNCascConfigs(0),
+fCascPosition(),
+fCascConfig(),
+fCascHypo(),
+fCascCharge(),
+fCascFlags(),
+fCascVarCascCosPA(),
+fCascVarV0CosPA(),
+fCascVarBBCosPA(),
+fCascVarDCACascDau(),
+fCascBinningGroup(),
+fCascVarCosPAPars(),
+fCascVarDCAPars(),
+fV0Candidates(),
+fCascCandidates(),
+fV0Pt(),
+fCascPt(),
+fV0VarValues(),
+fCascVarCosPAValues(),
+fCascVarDCAValues(),
+fSurvivors(),
+fV0Selected(),
+fCascSelected(),
+fGroupHisto(),
+fGroupHypo(),
+fGroupCentrality(),
+fGroupXBin(),
+fV0BinYZ(),
+fCascBinYZ(),
+fStatsHisto(),
+fStats(),
+fStatsLoaded(),
+fStatsEntries(),
+fHistoSlot(),
+fNPairsRejectedEarly(0),
+fNPairsEvaluated(0)
+{
+    // Dummy Constructor: all options off
+    for(Int_t i=0; i<=kNV0Hypo;   i++) fV0HypoStart[i]   = 0;
+    for(Int_t i=0; i<=kNCascHypo; i++) fCascHypoStart[i] = 0;
+}
+
+//________________________________________________________________
+AliWeakResultSelector::AliWeakResultSelector(UInt_t lOptions) :
+TObject(),
+fOptions(lOptions),
+fListV0(0x0),
+fNV0Configs(0),
+fV0Position(),
+fV0Config(),
+fV0Hypo(),
+fV0Flags(),
+fV0VarCosPA(),
+fV0BinningGroup(),
+fV0VarPars(),
+fListCascade(0x0),
+fNCascConfigs(0),
+fCascPosition(),
+fCascConfig(),
+fCascHypo(),
+fCascCharge(),
+fCascFlags(),
+fCascVarCascCosPA(),
+fCascVarV0CosPA(),
+fCascVarBBCosPA(),
+fCascVarDCACascDau(),
+fCascBinningGroup(),
+fCascVarCosPAPars(),
+fCascVarDCAPars(),
+fV0Candidates(),
+fCascCandidates(),
+fV0Pt(),
+fCascPt(),
+fV0VarValues(),
+fCascVarCosPAValues(),
+fCascVarDCAValues(),
+fSurvivors(),
+fV0Selected(),
+fCascSelected(),
+fGroupHisto(),
+fGroupHypo(),
+fGroupCentrality(),
+fGroupXBin(),
+fV0BinYZ(),
+fCascBinYZ(),
+fStatsHisto(),
+fStats(),
+fStatsLoaded(),
+fStatsEntries(),
+fHistoSlot(),
+fNPairsRejectedEarly(0),
+fNPairsEvaluated(0)
+{
+    // Constructor with the ESelectionOption bits of the task
+    for(Int_t i=0; i<=kNV0Hypo;   i++) fV0HypoStart[i]   = 0;
+    for(Int_t i=0; i<=kNCascHypo; i++) fCascHypoStart[i] = 0;
+}
+
+//________________________________________________________________
+AliWeakResultSelector::~AliWeakResultSelector()
+{
+    // Destructor: lists and histograms are not owned
+    // Histograms filled in the current event must have been flushed
+}
+
+//________________________________________________________________
+Bool_t AliWeakResultSelector::IsCompiled(TList *lListV0, TList *lListCascade) const
+{
+    //Check if the configurations of the lists are the compiled ones
+    if( lListV0      != fListV0      ) return kFALSE;
+    if( lListCascade != fListCascade ) return kFALSE;
+    if( lListV0      && lListV0     ->GetEntries() != fNV0Configs   ) return kFALSE;
+    if( lListCascade && lListCascade->GetEntries() != fNCascConfigs ) return kFALSE;
+    return kTRUE;
+}
+
+//________________________________________________________________
+AliV0Result *AliWeakResultSelector::GetV0Result(Int_t lcfg) const
+{
+    return (AliV0Result*) fListV0->At(lcfg);
+}
+
+//________________________________________________________________
+AliCascadeResult *AliWeakResultSelector::GetCascadeResult(Int_t lcfg) const
+{
+    return (AliCascadeResult*) fListCascade->At(lcfg);
+}
+
+//________________________________________________________________
+Int_t AliWeakResultSelector::AddVarCutParameters(std::vector<Float_t> &lPars, Float_t p0, Float_t p1, Float_t p2, Float_t p3, Float_t p4)
+{
+    //Index of the parameter set, added if not yet known
+    Int_t lNSets = lPars.size()/5;
+    for(Int_t iset=0; iset<lNSets; iset++){
+        if( lPars[5*iset  ]==p0 && lPars[5*iset+1]==p1 && lPars[5*iset+2]==p2 &&
+            lPars[5*iset+3]==p3 && lPars[5*iset+4]==p4 ) return iset;
+    }
+    lPars.push_back(p0);
+    lPars.push_back(p1);
+    lPars.push_back(p2);
+    lPars.push_back(p3);
+    lPars.push_back(p4);
+    return lNSets;
+}
+
+//________________________________________________________________
+Int_t AliWeakResultSelector::FindBinningGroup(TH3F *lHisto, Int_t lHypo)
+{
+    //Histograms with the same binning and mass hypothesis share the
+    //bins of the candidates. Buffered histograms are filled with Fill (-1)
+    if( !lHisto || lHisto->GetBuffer() ) return -1;
+    for(UInt_t igr=0; igr<fGroupHisto.size(); igr++){
+        if( fGroupHypo[igr] != lHypo ) continue;
+        TH3F *lRef = fGroupHisto[igr];
+        if( SameAxis(lRef->GetXaxis(), lHisto->GetXaxis()) &&
+            SameAxis(lRef->GetYaxis(), lHisto->GetYaxis()) &&
+            SameAxis(lRef->GetZaxis(), lHisto->GetZaxis()) ) return igr;
+    }
+    fGroupHisto.push_back(lHisto);
+    fGroupHypo.push_back(lHypo);
+    fGroupCentrality.push_back(0);
+    fGroupXBin.push_back(-1);
+    return fGroupHisto.size()-1;
+}
+
+//________________________________________________________________
+void AliWeakResultSelector::Compile(TList *lListV0, TList *lListCascade)
+{
+    //Copy the cuts of all the configurations into per-cut arrays,
+    //ordered by mass hypothesis, and find the loosest cuts of each hypothesis.
+    //Cuts which are compared as Float_t in the tasks are stored truncated
+    fListV0       = lListV0;
+    fListCascade  = lListCascade;
+    fNV0Configs   = lListV0      ? lListV0     ->GetEntries() : 0;
+    fNCascConfigs = lListCascade ? lListCascade->GetEntries() : 0;
+
+    fGroupHisto.clear();
+    fGroupHypo.clear();
+    fGroupCentrality.clear();
+    fGroupXBin.clear();
+
+    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    // V0 configurations
+    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    fV0Position.assign(fNV0Configs, -1);
+    fV0Config.clear();
+    fV0Hypo.clear();
+    fV0Flags.clear();
+    for(Int_t icut=0; icut<kNV0Cuts; icut++) fV0Cut[icut].clear();
+    fV0VarCosPA.clear();
+    fV0BinningGroup.clear();
+    fV0VarPars.clear();
+
+    for(Int_t lHypo=0; lHypo<kNV0Hypo; lHypo++){
+        fV0HypoStart[lHypo] = fV0Config.size();
+        for(Int_t lcfg=0; lcfg<fNV0Configs; lcfg++){
+            AliV0Result *lV0Result = (AliV0Result*) lListV0->At(lcfg);
+            if( lV0Result->GetMassHypothesis() != lHypo ) continue;
+            fV0Position[lcfg] = fV0Config.size();
+            fV0Config.push_back(lcfg);
+            fV0Hypo.push_back(lHypo);
+
+            UInt_t lFlags = 0;
+            if( lV0Result->GetUseOnTheFly()          ) lFlags |= kFlagOnTheFly;
+            if( lV0Result->GetCutArmenteros()        ) lFlags |= kFlagArmenteros;
+            if( lV0Result->GetCutUseITSRefitTracks() ) lFlags |= kFlagITSRefitTracks;
+            if( lV0Result->GetCut276TeVLikedEdx()    ) lFlags |= kFlag276TeVLikedEdx;
+            if( lV0Result->GetCutMCUseMCProperties() ) lFlags |= kFlagMCUseMCProperties;
+            fV0Flags.push_back(lFlags);
+
+            fV0Cut[kV0CutMinEtaTracks]                       .push_back(lV0Result->GetCutMinEtaTracks());
+            fV0Cut[kV0CutMaxEtaTracks]                       .push_back(lV0Result->GetCutMaxEtaTracks());
+            fV0Cut[kV0CutMinRapidity]                        .push_back(lV0Result->GetCutMinRapidity());
+            fV0Cut[kV0CutMaxRapidity]                        .push_back(lV0Result->GetCutMaxRapidity());
+            fV0Cut[kV0CutV0Radius]                           .push_back(lV0Result->GetCutV0Radius());
+            fV0Cut[kV0CutMaxV0Radius]                        .push_back(lV0Result->GetCutMaxV0Radius());
+            fV0Cut[kV0CutDCANegToPV]                         .push_back(lV0Result->GetCutDCANegToPV());
+            fV0Cut[kV0CutDCAPosToPV]                         .push_back(lV0Result->GetCutDCAPosToPV());
+            fV0Cut[kV0CutDCAV0Daughters]                     .push_back(lV0Result->GetCutDCAV0Daughters());
+            fV0Cut[kV0CutV0CosPA]                            .push_back((Float_t) lV0Result->GetCutV0CosPA());
+            fV0Cut[kV0CutProperLifetime]                     .push_back(lV0Result->GetCutProperLifetime());
+            fV0Cut[kV0CutLeastNumberOfCrossedRows]           .push_back(lV0Result->GetCutLeastNumberOfCrossedRows());
+            fV0Cut[kV0CutLeastNumberOfCrossedRowsOverFindable].push_back(lV0Result->GetCutLeastNumberOfCrossedRowsOverFindable());
+            fV0Cut[kV0CutMinBaryonMomentum]                  .push_back(lV0Result->GetCutMinBaryonMomentum());
+            fV0Cut[kV0CutTPCdEdx]                            .push_back(lV0Result->GetCutTPCdEdx());
+            fV0Cut[kV0CutArmenterosParameter]                .push_back(lV0Result->GetCutArmenterosParameter());
+            fV0Cut[kV0CutMaxChi2PerCluster]                  .push_back(lV0Result->GetCutMaxChi2PerCluster());
+            fV0Cut[kV0CutMinTrackLength]                     .push_back(lV0Result->GetCutMinTrackLength());
+
+            Int_t lVarSet = -1;
+            if( lV0Result->GetCutUseVarV0CosPA() )
+                lVarSet = AddVarCutParameters(fV0VarPars,
+                                              lV0Result->GetCutVarV0CosPAExp0Const(), lV0Result->GetCutVarV0CosPAExp0Slope(),
+                                              lV0Result->GetCutVarV0CosPAExp1Const(), lV0Result->GetCutVarV0CosPAExp1Slope(),
+                                              lV0Result->GetCutVarV0CosPAConst());
+            fV0VarCosPA.push_back(lVarSet);
+            fV0BinningGroup.push_back(FindBinningGroup(lV0Result->GetHistogram(), lHypo));
+        }
+    }
+    fV0HypoStart[kNV0Hypo] = fV0Config.size();
+
+    //Loosest cuts: minimum of the lower cuts, maximum of the upper cuts
+    for(Int_t lHypo=0; lHypo<kNV0Hypo; lHypo++){
+        Int_t lFirst = fV0HypoStart[lHypo];
+        Int_t lLast  = fV0HypoStart[lHypo+1];
+        fV0OnFly[lHypo]      = -1;
+        fV0LoosestRap[lHypo] = kTRUE;
+        if( lFirst == lLast ) continue;
+        Double_t *lLoose = fV0Loosest[lHypo];
+        for(Int_t icut=0; icut<kNV0Cuts; icut++) lLoose[icut] = fV0Cut[icut][lFirst];
+        fV0OnFly[lHypo] = (fV0Flags[lFirst] & kFlagOnTheFly) ? 1 : 0;
+        for(Int_t lpos=lFirst; lpos<lLast; lpos++){
+            lLoose[kV0CutMinEtaTracks]   = TMath::Min(lLoose[kV0CutMinEtaTracks],   fV0Cut[kV0CutMinEtaTracks][lpos]);
+            lLoose[kV0CutMaxEtaTracks]   = TMath::Max(lLoose[kV0CutMaxEtaTracks],   fV0Cut[kV0CutMaxEtaTracks][lpos]);
+            lLoose[kV0CutMinRapidity]    = TMath::Min(lLoose[kV0CutMinRapidity],    fV0Cut[kV0CutMinRapidity][lpos]);
+            lLoose[kV0CutMaxRapidity]    = TMath::Max(lLoose[kV0CutMaxRapidity],    fV0Cut[kV0CutMaxRapidity][lpos]);
+            lLoose[kV0CutV0Radius]       = TMath::Min(lLoose[kV0CutV0Radius],       fV0Cut[kV0CutV0Radius][lpos]);
+            lLoose[kV0CutMaxV0Radius]    = TMath::Max(lLoose[kV0CutMaxV0Radius],    fV0Cut[kV0CutMaxV0Radius][lpos]);
+            lLoose[kV0CutDCANegToPV]     = TMath::Min(lLoose[kV0CutDCANegToPV],     fV0Cut[kV0CutDCANegToPV][lpos]);
+            lLoose[kV0CutDCAPosToPV]     = TMath::Min(lLoose[kV0CutDCAPosToPV],     fV0Cut[kV0CutDCAPosToPV][lpos]);
+            lLoose[kV0CutDCAV0Daughters] = TMath::Max(lLoose[kV0CutDCAV0Daughters], fV0Cut[kV0CutDCAV0Daughters][lpos]);
+            //the variable CosPA can only tighten the cut
+            lLoose[kV0CutV0CosPA]        = TMath::Min(lLoose[kV0CutV0CosPA],        fV0Cut[kV0CutV0CosPA][lpos]);
+            lLoose[kV0CutTPCdEdx]        = TMath::Max(lLoose[kV0CutTPCdEdx],        fV0Cut[kV0CutTPCdEdx][lpos]);
+            if( fV0OnFly[lHypo] != ((fV0Flags[lpos] & kFlagOnTheFly) ? 1 : 0) ) fV0OnFly[lHypo] = -1;
+            //configurations with MC rapidity: reconstructed rapidity not checked
+            if( (fOptions & kV0MCRapidity) && (fV0Flags[lpos] & kFlagMCUseMCProperties) ) fV0LoosestRap[lHypo] = kFALSE;
+        }
+    }
+    fV0Selected.assign(fNV0Configs, std::vector<Int_t>());
+
+    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    // Cascade configurations
+    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    fCascPosition.assign(fNCascConfigs, -1);
+    fCascConfig.clear();
+    fCascHypo.clear();
+    fCascCharge.clear();
+    fCascFlags.clear();
+    for(Int_t icut=0; icut<kNCascCuts; icut++) fCascCut[icut].clear();
+    fCascVarCascCosPA.clear();
+    fCascVarV0CosPA.clear();
+    fCascVarBBCosPA.clear();
+    fCascVarDCACascDau.clear();
+    fCascBinningGroup.clear();
+    fCascVarCosPAPars.clear();
+    fCascVarDCAPars.clear();
+
+    for(Int_t lHypo=0; lHypo<kNCascHypo; lHypo++){
+        fCascHypoStart[lHypo] = fCascConfig.size();
+        for(Int_t lcfg=0; lcfg<fNCascConfigs; lcfg++){
+            AliCascadeResult *lCascadeResult = (AliCascadeResult*) lListCascade->At(lcfg);
+            if( lCascadeResult->GetMassHypothesis() != lHypo ) continue;
+            fCascPosition[lcfg] = fCascConfig.size();
+            fCascConfig.push_back(lcfg);
+            fCascHypo.push_back(lHypo);
+
+            Int_t lCharge = ( lHypo == AliCascadeResult::kXiMinus || lHypo == AliCascadeResult::kOmegaMinus ) ? -1 : +1;
+            if( (fOptions & kCascSwapBachelorCharge) && lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
+            fCascCharge.push_back(lCharge);
+
+            UInt_t lFlags = 0;
+            if( lCascadeResult->GetCutUseITSRefitTracks() ) lFlags |= kFlagITSRefitTracks;
+            if( lCascadeResult->GetCutMCUseMCProperties() ) lFlags |= kFlagMCUseMCProperties;
+            if( lCascadeResult->GetCutUse276TeVV0CosPA()  ) lFlags |= kFlagUse276TeVV0CosPA;
+            if( lCascadeResult->GetCutUseTOFUnchecked()   ) lFlags |= kFlagUseTOFUnchecked;
+            fCascFlags.push_back(lFlags);
+
+            fCascCut[kCascCutMinEtaTracks]         .push_back(lCascadeResult->GetCutMinEtaTracks());
+            fCascCut[kCascCutMaxEtaTracks]         .push_back(lCascadeResult->GetCutMaxEtaTracks());
+            fCascCut[kCascCutMinRapidity]          .push_back(lCascadeResult->GetCutMinRapidity());
+            fCascCut[kCascCutMaxRapidity]          .push_back(lCascadeResult->GetCutMaxRapidity());
+            fCascCut[kCascCutDCANegToPV]           .push_back(lCascadeResult->GetCutDCANegToPV());
+            fCascCut[kCascCutDCAPosToPV]           .push_back(lCascadeResult->GetCutDCAPosToPV());
+            fCascCut[kCascCutDCAV0Daughters]       .push_back(lCascadeResult->GetCutDCAV0Daughters());
+            fCascCut[kCascCutV0CosPA]              .push_back((Float_t) lCascadeResult->GetCutV0CosPA());
+            fCascCut[kCascCutV0Radius]             .push_back(lCascadeResult->GetCutV0Radius());
+            fCascCut[kCascCutDCAV0ToPV]            .push_back(lCascadeResult->GetCutDCAV0ToPV());
+            fCascCut[kCascCutV0Mass]               .push_back(lCascadeResult->GetCutV0Mass());
+            fCascCut[kCascCutDCABachToPV]          .push_back(lCascadeResult->GetCutDCABachToPV());
+            //compared as Float_t only together with the variable cut
+            fCascCut[kCascCutDCACascDaughters]     .push_back(lCascadeResult->GetCutDCACascDaughters());
+            fCascCut[kCascCutCascCosPA]            .push_back((Float_t) lCascadeResult->GetCutCascCosPA());
+            fCascCut[kCascCutCascRadius]           .push_back(lCascadeResult->GetCutCascRadius());
+            fCascCut[kCascCutV0MassSigma]          .push_back(lCascadeResult->GetCutV0MassSigma());
+            fCascCut[kCascCutProperLifetime]       .push_back(lCascadeResult->GetCutProperLifetime());
+            fCascCut[kCascCutLeastNumberOfClusters].push_back(lCascadeResult->GetCutLeastNumberOfClusters());
+            fCascCut[kCascCutTPCdEdx]              .push_back(lCascadeResult->GetCutTPCdEdx());
+            fCascCut[kCascCutXiRejection]          .push_back(lCascadeResult->GetCutXiRejection());
+            fCascCut[kCascCutDCABachToBaryon]      .push_back(lCascadeResult->GetCutDCABachToBaryon());
+            fCascCut[kCascCutBachBaryonCosPA]      .push_back((Float_t) lCascadeResult->GetCutBachBaryonCosPA());
+            fCascCut[kCascCutMinV0Lifetime]        .push_back(lCascadeResult->GetCutMinV0Lifetime());
+            fCascCut[kCascCutMaxV0Lifetime]        .push_back(lCascadeResult->GetCutMaxV0Lifetime());
+            fCascCut[kCascCutMaxChi2PerCluster]    .push_back(lCascadeResult->GetCutMaxChi2PerCluster());
+            fCascCut[kCascCutMinTrackLength]       .push_back(lCascadeResult->GetCutMinTrackLength());
+            fCascCut[kCascCutDCACascadeToPV]       .push_back(lCascadeResult->GetCutDCACascadeToPV());
+            fCascCut[kCascCutDCANegToPVWeighted]   .push_back(lCascadeResult->GetCutDCANegToPVWeighted());
+            fCascCut[kCascCutDCAPosToPVWeighted]   .push_back(lCascadeResult->GetCutDCAPosToPVWeighted());
+            fCascCut[kCascCutDCABachToPVWeighted]  .push_back(lCascadeResult->GetCutDCABachToPVWeighted());
+
+            Int_t lVarSet = -1;
+            if( lCascadeResult->GetCutUseVarCascCosPA() )
+                lVarSet = AddVarCutParameters(fCascVarCosPAPars,
+                                              lCascadeResult->GetCutVarCascCosPAExp0Const(), lCascadeResult->GetCutVarCascCosPAExp0Slope(),
+                                              lCascadeResult->GetCutVarCascCosPAExp1Const(), lCascadeResult->GetCutVarCascCosPAExp1Slope(),
+                                              lCascadeResult->GetCutVarCascCosPAConst());
+            fCascVarCascCosPA.push_back(lVarSet);
+            lVarSet = -1;
+            if( lCascadeResult->GetCutUseVarV0CosPA() )
+                lVarSet = AddVarCutParameters(fCascVarCosPAPars,
+                                              lCascadeResult->GetCutVarV0CosPAExp0Const(), lCascadeResult->GetCutVarV0CosPAExp0Slope(),
+                                              lCascadeResult->GetCutVarV0CosPAExp1Const(), lCascadeResult->GetCutVarV0CosPAExp1Slope(),
+                                              lCascadeResult->GetCutVarV0CosPAConst());
+            fCascVarV0CosPA.push_back(lVarSet);
+            lVarSet = -1;
+            if( lCascadeResult->GetCutUseVarBBCosPA() )
+                lVarSet = AddVarCutParameters(fCascVarCosPAPars,
+                                              lCascadeResult->GetCutVarBBCosPAExp0Const(), lCascadeResult->GetCutVarBBCosPAExp0Slope(),
+                                              lCascadeResult->GetCutVarBBCosPAExp1Const(), lCascadeResult->GetCutVarBBCosPAExp1Slope(),
+                                              lCascadeResult->GetCutVarBBCosPAConst());
+            fCascVarBBCosPA.push_back(lVarSet);
+            lVarSet = -1;
+            if( (fOptions & kCascVarDCACascDau) && lCascadeResult->GetCutUseVarDCACascDau() )
+                lVarSet = AddVarCutParameters(fCascVarDCAPars,
+                                              lCascadeResult->GetCutVarDCACascDauExp0Const(), lCascadeResult->GetCutVarDCACascDauExp0Slope(),
+                                              lCascadeResult->GetCutVarDCACascDauExp1Const(), lCascadeResult->GetCutVarDCACascDauExp1Slope(),
+                                              lCascadeResult->GetCutVarDCACascDauConst());
+            fCascVarDCACascDau.push_back(lVarSet);
+            fCascBinningGroup.push_back(FindBinningGroup(lCascadeResult->GetHistogram(), 10+lHypo));
+        }
+    }
+    fCascHypoStart[kNCascHypo] = fCascConfig.size();
+
+    for(Int_t lHypo=0; lHypo<kNCascHypo; lHypo++){
+        Int_t lFirst = fCascHypoStart[lHypo];
+        Int_t lLast  = fCascHypoStart[lHypo+1];
+        fCascLoosestCharge[lHypo] = 0;
+        fCascLoosestRap[lHypo]    = kTRUE;
+        if( lFirst == lLast ) continue;
+        Double_t *lLoose = fCascLoosest[lHypo];
+        for(Int_t icut=0; icut<kNCascCuts; icut++) lLoose[icut] = fCascCut[icut][lFirst];
+        fCascLoosestCharge[lHypo] = fCascCharge[lFirst];
+        for(Int_t lpos=lFirst; lpos<lLast; lpos++){
+            lLoose[kCascCutMinEtaTracks]   = TMath::Min(lLoose[kCascCutMinEtaTracks],   fCascCut[kCascCutMinEtaTracks][lpos]);
+            lLoose[kCascCutMaxEtaTracks]   = TMath::Max(lLoose[kCascCutMaxEtaTracks],   fCascCut[kCascCutMaxEtaTracks][lpos]);
+            lLoose[kCascCutMinRapidity]    = TMath::Min(lLoose[kCascCutMinRapidity],    fCascCut[kCascCutMinRapidity][lpos]);
+            lLoose[kCascCutMaxRapidity]    = TMath::Max(lLoose[kCascCutMaxRapidity],    fCascCut[kCascCutMaxRapidity][lpos]);
+            lLoose[kCascCutDCANegToPV]     = TMath::Min(lLoose[kCascCutDCANegToPV],     fCascCut[kCascCutDCANegToPV][lpos]);
+            lLoose[kCascCutDCAPosToPV]     = TMath::Min(lLoose[kCascCutDCAPosToPV],     fCascCut[kCascCutDCAPosToPV][lpos]);
+            lLoose[kCascCutDCABachToPV]    = TMath::Min(lLoose[kCascCutDCABachToPV],    fCascCut[kCascCutDCABachToPV][lpos]);
+            lLoose[kCascCutDCAV0ToPV]      = TMath::Min(lLoose[kCascCutDCAV0ToPV],      fCascCut[kCascCutDCAV0ToPV][lpos]);
+            lLoose[kCascCutDCAV0Daughters] = TMath::Max(lLoose[kCascCutDCAV0Daughters], fCascCut[kCascCutDCAV0Daughters][lpos]);
+            lLoose[kCascCutV0Radius]       = TMath::Min(lLoose[kCascCutV0Radius],       fCascCut[kCascCutV0Radius][lpos]);
+            lLoose[kCascCutCascRadius]     = TMath::Min(lLoose[kCascCutCascRadius],     fCascCut[kCascCutCascRadius][lpos]);
+            //the variable cuts can only tighten the CosPA cuts
+            lLoose[kCascCutV0CosPA]        = TMath::Min(lLoose[kCascCutV0CosPA],        fCascCut[kCascCutV0CosPA][lpos]);
+            lLoose[kCascCutCascCosPA]      = TMath::Min(lLoose[kCascCutCascCosPA],      fCascCut[kCascCutCascCosPA][lpos]);
+            //and the DCA between daughters: Float_t- or Double_t-compared, take the looser
+            Double_t lDCACascDau = fCascCut[kCascCutDCACascDaughters][lpos];
+            lLoose[kCascCutDCACascDaughters] = TMath::Max(lLoose[kCascCutDCACascDaughters],
+                                                          TMath::Max(lDCACascDau, (Double_t)((Float_t)lDCACascDau)));
+            lLoose[kCascCutTPCdEdx]        = TMath::Max(lLoose[kCascCutTPCdEdx],        fCascCut[kCascCutTPCdEdx][lpos]);
+            if( fCascLoosestCharge[lHypo] != fCascCharge[lpos] ) fCascLoosestCharge[lHypo] = 0;
+            if( (fOptions & kCascMCRapidity) && (fCascFlags[lpos] & kFlagMCUseMCProperties) ) fCascLoosestRap[lHypo] = kFALSE;
+        }
+    }
+    fCascSelected.assign(fNCascConfigs, std::vector<Int_t>());
+
+    fStatsHisto.clear();
+    fStats.clear();
+    fStatsLoaded.clear();
+    fStatsEntries.clear();
+    fHistoSlot.assign(fNV0Configs+fNCascConfigs, -1);
+
+    AliInfo(Form("Compiled %i V0 and %i cascade configurations, %i histogram binnings, %i+%i+%i variable cut parametrizations",
+                 fNV0Configs, fNCascConfigs, (Int_t) fGroupHisto.size(),
+                 (Int_t) fV0VarPars.size()/5, (Int_t) fCascVarCosPAPars.size()/5, (Int_t) fCascVarDCAPars.size()/5));
+}
+
+//________________________________________________________________
+void AliWeakResultSelector::EvaluateVarCuts(const std::vector<Float_t> &lPars, Bool_t lCosine, const std::vector<Float_t> &lPt, std::vector<Float_t> &lValues) const
+{
+    //Variable cuts of each parameter set at the pt of each candidate,
+    //same expression and precision as in the tasks
+    Int_t lNSets = lPars.size()/5;
+    Int_t lNCand = lPt.size();
+    lValues.resize(lNSets*lNCand);
+    for(Int_t iset=0; iset<lNSets; iset++){
+        const Float_t *lPar = &lPars[5*iset];
+        Float_t *lValue = lNCand ? &lValues[iset*lNCand] : 0x0;
+        for(Int_t lcand=0; lcand<lNCand; lcand++){
+            if( lCosine )
+                lValue[lcand] = TMath::Cos(
+                                           lPar[0]*TMath::Exp(lPar[1]*lPt[lcand]) +
+                                           lPar[2]*TMath::Exp(lPar[3]*lPt[lcand]) +
+                                           lPar[4]);
+            else
+                lValue[lcand] = lPar[0]*TMath::Exp(lPar[1]*lPt[lcand]) +
+                lPar[2]*TMath::Exp(lPar[3]*lPt[lcand]) +
+                lPar[4];
+        }
+    }
+}
+
+//________________________________________________________________
+void AliWeakResultSelector::ClearV0Candidates()
+{
+    fV0Candidates.clear();
+    for(UInt_t lcfg=0; lcfg<fV0Selected.size(); lcfg++) fV0Selected[lcfg].clear();
+}
+
+//________________________________________________________________
+void AliWeakResultSelector::ClearCascadeCandidates()
+{
+    fCascCandidates.clear();
+    for(UInt_t lcfg=0; lcfg<fCascSelected.size(); lcfg++) fCascSelected[lcfg].clear();
+}
+
+//________________________________________________________________
+Int_t AliWeakResultSelector::AddV0Candidate(const V0Candidate &lCandidate)
+{
+    fV0Candidates.push_back(lCandidate);
+    return fV0Candidates.size()-1;
+}
+
+//________________________________________________________________
+Int_t AliWeakResultSelector::AddCascadeCandidate(const CascadeCandidate &lCandidate)
+{
+    fCascCandidates.push_back(lCandidate);
+    return fCascCandidates.size()-1;
+}
+
+//________________________________________________________________
+Bool_t AliWeakResultSelector::PassV0Loosest(Int_t lHypo, const V0Candidate &lCand) const
+{
+    //Cuts which every configuration of the mass hypothesis applies, at
+    //their loosest value: a candidate failing them fails all configurations
+    const Double_t *lLoose = fV0Loosest[lHypo];
+    Float_t lRap     = lCand.fRapLambda;
+    Float_t lNegdEdx = lCand.fNSigmasNegPion;
+    Float_t lPosdEdx = lCand.fNSigmasPosProton;
+    if( lHypo == AliV0Result::kK0Short ){
+        lRap     = lCand.fRapK0Short;
+        lPosdEdx = lCand.fNSigmasPosPion;
+    }
+    if( lHypo == AliV0Result::kAntiLambda ){
+        lNegdEdx = lCand.fNSigmasNegProton;
+        lPosdEdx = lCand.fNSigmasPosPion;
+    }
+    return
+    ( fV0OnFly[lHypo] < 0 || lCand.fOnFlyStatus == fV0OnFly[lHypo] ) &&
+    lLoose[kV0CutMinEtaTracks] < lCand.fNegEta && lCand.fNegEta < lLoose[kV0CutMaxEtaTracks] &&
+    lLoose[kV0CutMinEtaTracks] < lCand.fPosEta && lCand.fPosEta < lLoose[kV0CutMaxEtaTracks] &&
+    ( !fV0LoosestRap[lHypo] || ( lRap > lLoose[kV0CutMinRapidity] && lRap < lLoose[kV0CutMaxRapidity] ) ) &&
+    lCand.fV0Radius > lLoose[kV0CutV0Radius] &&
+    ( !(fOptions & kV0MaxRadius) || lCand.fV0Radius < lLoose[kV0CutMaxV0Radius] ) &&
+    lCand.fDcaNegToPrimVertex > lLoose[kV0CutDCANegToPV] &&
+    lCand.fDcaPosToPrimVertex > lLoose[kV0CutDCAPosToPV] &&
+    lCand.fDcaV0Daughters < lLoose[kV0CutDCAV0Daughters] &&
+    lCand.fV0CosineOfPointingAngle > lLoose[kV0CutV0CosPA] &&
+    TMath::Abs(lNegdEdx) < lLoose[kV0CutTPCdEdx] &&
+    TMath::Abs(lPosdEdx) < lLoose[kV0CutTPCdEdx];
+}
+
+//________________________________________________________________
+Bool_t AliWeakResultSelector::PassV0(Int_t lpos, const V0Candidate &lCand, Int_t lcand) const
+{
+    //Full selection of one configuration, as in the V0 loop of the tasks
+    Int_t  lHypo  = fV0Hypo[lpos];
+    UInt_t lFlags = fV0Flags[lpos];
+
+    Float_t lRap = 0;
+    Float_t lPDGMass = -1;
+    Float_t lNegdEdx = 100;
+    Float_t lPosdEdx = 100;
+    Float_t lBaryonMomentum = -0.5;
+    Float_t lBaryonPt = -0.5;
+    Float_t lBaryondEdxFromProton = 0;
+
+    //Variable V0 CosPA: only used if tighter than the non-variable cut
+    Float_t lV0CosPACut = fV0Cut[kV0CutV0CosPA][lpos];
+    if( fV0VarCosPA[lpos] >= 0 ){
+        Float_t lVarV0CosPA = fV0VarValues[fV0VarCosPA[lpos]*fV0Candidates.size()+lcand];
+        if( lVarV0CosPA > lV0CosPACut ) lV0CosPACut = lVarV0CosPA;
+    }
+
+    if ( lHypo == AliV0Result::kK0Short ){
+        lRap     = lCand.fRapK0Short;
+        lPDGMass = 0.497;
+        lNegdEdx = lCand.fNSigmasNegPion;
+        lPosdEdx = lCand.fNSigmasPosPion;
+    }
+    if ( lHypo == AliV0Result::kLambda ){
+        lRap = lCand.fRapLambda;
+        lPDGMass = 1.115683;
+        lNegdEdx = lCand.fNSigmasNegPion;
+        lPosdEdx = lCand.fNSigmasPosProton;
+        lBaryonMomentum = lCand.fPosInnerP;
+        lBaryonPt = lCand.fPosInnerPt;
+        lBaryondEdxFromProton = lCand.fNSigmasPosProton;
+    }
+    if ( lHypo == AliV0Result::kAntiLambda ){
+        lRap = lCand.fRapLambda;
+        lPDGMass = 1.115683;
+        lNegdEdx = lCand.fNSigmasNegProton;
+        lPosdEdx = lCand.fNSigmasPosPion;
+        lBaryonMomentum = lCand.fNegInnerP;
+        lBaryonPt = lCand.fNegInnerPt;
+        lBaryondEdxFromProton = lCand.fNSigmasNegProton;
+    }
+    if( (fOptions & kV0MCRapidity) && (lFlags & kFlagMCUseMCProperties) ) lRap = lCand.fRapMC;
+
+    return
+    //Check 1: Offline Vertexer
+    lCand.fOnFlyStatus == ( (lFlags & kFlagOnTheFly) ? 1 : 0 ) &&
+
+    //Check 2: Basic Acceptance cuts
+    fV0Cut[kV0CutMinEtaTracks][lpos] < lCand.fNegEta && lCand.fNegEta < fV0Cut[kV0CutMaxEtaTracks][lpos] &&
+    fV0Cut[kV0CutMinEtaTracks][lpos] < lCand.fPosEta && lCand.fPosEta < fV0Cut[kV0CutMaxEtaTracks][lpos] &&
+    lRap > fV0Cut[kV0CutMinRapidity][lpos] &&
+    lRap < fV0Cut[kV0CutMaxRapidity][lpos] &&
+
+    //Check 3: Topological Variables
+    lCand.fV0Radius > fV0Cut[kV0CutV0Radius][lpos] &&
+    ( !(fOptions & kV0MaxRadius) || lCand.fV0Radius < fV0Cut[kV0CutMaxV0Radius][lpos] ) &&
+    lCand.fDcaNegToPrimVertex > fV0Cut[kV0CutDCANegToPV][lpos] &&
+    lCand.fDcaPosToPrimVertex > fV0Cut[kV0CutDCAPosToPV][lpos] &&
+    lCand.fDcaV0Daughters < fV0Cut[kV0CutDCAV0Daughters][lpos] &&
+    lCand.fV0CosineOfPointingAngle > lV0CosPACut &&
+    lCand.fDistOverTotMom*lPDGMass < fV0Cut[kV0CutProperLifetime][lpos] &&
+    lCand.fLeastNbrCrossedRows > fV0Cut[kV0CutLeastNumberOfCrossedRows][lpos] &&
+    lCand.fLeastRatioCrossedRowsOverFindable > fV0Cut[kV0CutLeastNumberOfCrossedRowsOverFindable][lpos] &&
+
+    //Check 4: Minimum momentum of baryon daughter
+    ( lHypo == AliV0Result::kK0Short || lBaryonMomentum > fV0Cut[kV0CutMinBaryonMomentum][lpos] ) &&
+
+    //Check 5: TPC dEdx selections
+    TMath::Abs(lNegdEdx)<fV0Cut[kV0CutTPCdEdx][lpos] &&
+    TMath::Abs(lPosdEdx)<fV0Cut[kV0CutTPCdEdx][lpos] &&
+
+    //Check 6: Armenteros-Podolanski space cut (for K0Short analysis)
+    ( ( !(lFlags & kFlagArmenteros) || lHypo != AliV0Result::kK0Short ) || ( lCand.fPtArmV0>fV0Cut[kV0CutArmenterosParameter][lpos]*TMath::Abs(lCand.fAlphaV0) ) ) &&
+
+    //Check 7: kITSrefit track selection if requested
+    (
+     ( (lCand.fNegTrackStatus & AliESDtrack::kITSrefit) &&
+      (lCand.fPosTrackStatus & AliESDtrack::kITSrefit) )
+     ||
+     !(lFlags & kFlagITSRefitTracks)
+     )&&
+
+    //Check 8: Max Chi2/Clusters if not absurd
+    ( fV0Cut[kV0CutMaxChi2PerCluster][lpos]>1e+3 ||
+     lCand.fMaxChi2PerCluster < fV0Cut[kV0CutMaxChi2PerCluster][lpos]
+     ) &&
+    //Check 9: Min Track Length if positive
+    ( fV0Cut[kV0CutMinTrackLength][lpos]<0 ||
+     lCand.fMinTrackLength > fV0Cut[kV0CutMinTrackLength][lpos]
+     )&&
+
+    //Check 10: Special 2.76TeV-like dedx
+    ( !(fOptions & kV0276TeVLikedEdx) || !(lFlags & kFlag276TeVLikedEdx) ||
+     ( lHypo == AliV0Result::kK0Short ||
+      ( lBaryonPt > 1.0 || TMath::Abs(lBaryondEdxFromProton)<3.0 )
+      )
+     );
+}
+
+//________________________________________________________________
+void AliWeakResultSelector::SelectV0Candidates()
+{
+    //Candidates passing each configuration: loosest cuts of the mass
+    //hypothesis first, then the configurations over the survivors only
+    Int_t lNCand = fV0Candidates.size();
+    for(UInt_t lcfg=0; lcfg<fV0Selected.size(); lcfg++) fV0Selected[lcfg].clear();
+    fV0BinYZ.assign(fGroupHisto.size()*lNCand, -1);
+    if( !lNCand ) return;
+
+    fV0Pt.resize(lNCand);
+    for(Int_t lcand=0; lcand<lNCand; lcand++) fV0Pt[lcand] = fV0Candidates[lcand].fPt;
+    EvaluateVarCuts(fV0VarPars, kTRUE, fV0Pt, fV0VarValues);
+
+    for(Int_t lHypo=0; lHypo<kNV0Hypo; lHypo++){
+        Int_t lFirst = fV0HypoStart[lHypo];
+        Int_t lLast  = fV0HypoStart[lHypo+1];
+        if( lFirst == lLast ) continue;
+        fSurvivors.clear();
+        for(Int_t lcand=0; lcand<lNCand; lcand++)
+            if( PassV0Loosest(lHypo, fV0Candidates[lcand]) ) fSurvivors.push_back(lcand);
+        Int_t lNSurvivors = fSurvivors.size();
+        fNPairsRejectedEarly += (Long64_t)(lNCand-lNSurvivors)*(lLast-lFirst);
+        fNPairsEvaluated     += (Long64_t)lNSurvivors*(lLast-lFirst);
+        for(Int_t lpos=lFirst; lpos<lLast; lpos++){
+            std::vector<Int_t> &lSelected = fV0Selected[fV0Config[lpos]];
+            for(Int_t is=0; is<lNSurvivors; is++){
+                Int_t lcand = fSurvivors[is];
+                if( PassV0(lpos, fV0Candidates[lcand], lcand) ) lSelected.push_back(lcand);
+            }
+        }
+    }
+}
+
+//________________________________________________________________
+Bool_t AliWeakResultSelector::PassCascadeLoosest(Int_t lHypo, const CascadeCandidate &lCand) const
+{
+    //Cuts which every configuration of the mass hypothesis applies, at
+    //their loosest value: a candidate failing them fails all configurations
+    const Double_t *lLoose = fCascLoosest[lHypo];
+    Bool_t  lOmega    = ( lHypo == AliCascadeResult::kOmegaMinus || lHypo == AliCascadeResult::kOmegaPlus );
+    Bool_t  lMinus    = ( lHypo == AliCascadeResult::kXiMinus    || lHypo == AliCascadeResult::kOmegaMinus );
+    Float_t lRap      = lOmega ? lCand.fRapOmega       : lCand.fRapXi;
+    Float_t lNegdEdx  = lMinus ? lCand.fNegNSigmaPion   : lCand.fNegNSigmaProton;
+    Float_t lPosdEdx  = lMinus ? lCand.fPosNSigmaProton : lCand.fPosNSigmaPion;
+    Float_t lBachdEdx = lOmega ? lCand.fBachNSigmaKaon  : lCand.fBachNSigmaPion;
+    return
+    ( fCascLoosestCharge[lHypo] == 0 || lCand.fCharge == fCascLoosestCharge[lHypo] ) &&
+    lLoose[kCascCutMinEtaTracks] < lCand.fPosEta  && lCand.fPosEta  < lLoose[kCascCutMaxEtaTracks] &&
+    lLoose[kCascCutMinEtaTracks] < lCand.fNegEta  && lCand.fNegEta  < lLoose[kCascCutMaxEtaTracks] &&
+    lLoose[kCascCutMinEtaTracks] < lCand.fBachEta && lCand.fBachEta < lLoose[kCascCutMaxEtaTracks] &&
+    ( !fCascLoosestRap[lHypo] || ( lRap > lLoose[kCascCutMinRapidity] && lRap < lLoose[kCascCutMaxRapidity] ) ) &&
+    lCand.fDCANegToPrimVtx > lLoose[kCascCutDCANegToPV] &&
+    lCand.fDCAPosToPrimVtx > lLoose[kCascCutDCAPosToPV] &&
+    lCand.fDCAV0Daughters < lLoose[kCascCutDCAV0Daughters] &&
+    lCand.fV0CosPointingAngle > lLoose[kCascCutV0CosPA] &&
+    lCand.fV0Radius > lLoose[kCascCutV0Radius] &&
+    lCand.fDCAV0ToPrimVtx > lLoose[kCascCutDCAV0ToPV] &&
+    lCand.fDCABachToPrimVtx > lLoose[kCascCutDCABachToPV] &&
+    lCand.fDCACascDaughters < lLoose[kCascCutDCACascDaughters] &&
+    lCand.fCascCosPointingAngle > lLoose[kCascCutCascCosPA] &&
+    lCand.fCascRadius > lLoose[kCascCutCascRadius] &&
+    TMath::Abs(lNegdEdx ) < lLoose[kCascCutTPCdEdx] &&
+    TMath::Abs(lPosdEdx ) < lLoose[kCascCutTPCdEdx] &&
+    TMath::Abs(lBachdEdx) < lLoose[kCascCutTPCdEdx];
+}
+
+//________________________________________________________________
+Bool_t AliWeakResultSelector::PassCascade(Int_t lpos, const CascadeCandidate &lCand, Int_t lcand) const
+{
+    //Full selection of one configuration, as in the cascade loop of the tasks
+    Int_t  lHypo  = fCascHypo[lpos];
+    UInt_t lFlags = fCascFlags[lpos];
+    Int_t  lNCand = fCascCandidates.size();
+
+    Float_t lV0Mass = 0;
+    Float_t lRap  = 0;
+    Float_t lPDGMass = -1;
+    Float_t lNegdEdx = 100;
+    Float_t lPosdEdx = 100;
+    Float_t lBachdEdx = 100;
+    Float_t lNegTOFsigma = 0;
+    Float_t lPosTOFsigma = 0;
+    Float_t lBachTOFsigma = 0;
+    Short_t lCharge = fCascCharge[lpos];
+
+    //Variable cuts: CosPA only used if tighter, BB CosPA (inverse logic) if looser
+    Float_t lCascCosPACut = fCascCut[kCascCutCascCosPA][lpos];
+    if( fCascVarCascCosPA[lpos] >= 0 ){
+        Float_t lVarCascCosPA = fCascVarCosPAValues[fCascVarCascCosPA[lpos]*lNCand+lcand];
+        if( lVarCascCosPA > lCascCosPACut ) lCascCosPACut = lVarCascCosPA;
+    }
+    Float_t lV0CosPACut = fCascCut[kCascCutV0CosPA][lpos];
+    if( fCascVarV0CosPA[lpos] >= 0 ){
+        Float_t lVarV0CosPA = fCascVarCosPAValues[fCascVarV0CosPA[lpos]*lNCand+lcand];
+        if( lVarV0CosPA > lV0CosPACut ) lV0CosPACut = lVarV0CosPA;
+    }
+    Float_t lBBCosPACut = fCascCut[kCascCutBachBaryonCosPA][lpos];
+    if( fCascVarBBCosPA[lpos] >= 0 ){
+        Float_t lVarBBCosPA = fCascVarCosPAValues[fCascVarBBCosPA[lpos]*lNCand+lcand];
+        if( lVarBBCosPA > lBBCosPACut ) lBBCosPACut = lVarBBCosPA;
+    }
+    Bool_t lPassDCACascDau = kFALSE;
+    if( fOptions & kCascVarDCACascDau ){
+        //Loosest: default cut, parametric can go tighter
+        Float_t lDCACascDauCut = fCascCut[kCascCutDCACascDaughters][lpos];
+        if( fCascVarDCACascDau[lpos] >= 0 ){
+            Float_t lVarDCACascDau = fCascVarDCAValues[fCascVarDCACascDau[lpos]*lNCand+lcand];
+            if( lVarDCACascDau < lDCACascDauCut ) lDCACascDauCut = lVarDCACascDau;
+        }
+        lPassDCACascDau = lCand.fDCACascDaughters < lDCACascDauCut;
+    } else {
+        lPassDCACascDau = lCand.fDCACascDaughters < fCascCut[kCascCutDCACascDaughters][lpos];
+    }
+
+    if ( lHypo == AliCascadeResult::kXiMinus ){
+        lV0Mass  = lCand.fV0MassLambda;
+        lRap     = lCand.fRapXi;
+        lPDGMass = 1.32171;
+        lNegdEdx = lCand.fNegNSigmaPion;
+        lPosdEdx = lCand.fPosNSigmaProton;
+        lBachdEdx= lCand.fBachNSigmaPion;
+        lNegTOFsigma = lCand.fNegTOFNSigmaPion;
+        lPosTOFsigma = lCand.fPosTOFNSigmaProton;
+        lBachTOFsigma = lCand.fBachTOFNSigmaPion;
+    }
+    if ( lHypo == AliCascadeResult::kXiPlus ){
+        lV0Mass  = lCand.fV0MassAntiLambda;
+        lRap     = lCand.fRapXi;
+        lPDGMass = 1.32171;
+        lNegdEdx = lCand.fNegNSigmaProton;
+        lPosdEdx = lCand.fPosNSigmaPion;
+        lBachdEdx= lCand.fBachNSigmaPion;
+        lNegTOFsigma = lCand.fNegTOFNSigmaProton;
+        lPosTOFsigma = lCand.fPosTOFNSigmaPion;
+        lBachTOFsigma = lCand.fBachTOFNSigmaPion;
+    }
+    if ( lHypo == AliCascadeResult::kOmegaMinus ){
+        lV0Mass  = lCand.fV0MassLambda;
+        lRap     = lCand.fRapOmega;
+        lPDGMass = 1.67245;
+        lNegdEdx = lCand.fNegNSigmaPion;
+        lPosdEdx = lCand.fPosNSigmaProton;
+        lBachdEdx= lCand.fBachNSigmaKaon;
+        lNegTOFsigma = lCand.fNegTOFNSigmaPion;
+        lPosTOFsigma = lCand.fPosTOFNSigmaProton;
+        lBachTOFsigma = lCand.fBachTOFNSigmaKaon;
+    }
+    if ( lHypo == AliCascadeResult::kOmegaPlus ){
+        lV0Mass  = lCand.fV0MassAntiLambda;
+        lRap     = lCand.fRapOmega;
+        lPDGMass = 1.67245;
+        lNegdEdx = lCand.fNegNSigmaProton;
+        lPosdEdx = lCand.fPosNSigmaPion;
+        lBachdEdx= lCand.fBachNSigmaKaon;
+        lNegTOFsigma = lCand.fNegTOFNSigmaProton;
+        lPosTOFsigma = lCand.fPosTOFNSigmaPion;
+        lBachTOFsigma = lCand.fBachTOFNSigmaKaon;
+    }
+    if( !(fOptions & kCascTOF) || !(lFlags & kFlagUseTOFUnchecked) ){
+        //Always-pass values
+        lNegTOFsigma = 0;
+        lPosTOFsigma = 0;
+        lBachTOFsigma = 0;
+    }
+    if( (fOptions & kCascMCRapidity) && (lFlags & kFlagMCUseMCProperties) ) lRap = lCand.fRapMC;
+
+    return
+    //Check 1: Charge consistent with expectations
+    lCand.fCharge == lCharge &&
+
+    //Check 2: Basic Acceptance cuts
+    fCascCut[kCascCutMinEtaTracks][lpos] < lCand.fPosEta && lCand.fPosEta < fCascCut[kCascCutMaxEtaTracks][lpos] &&
+    fCascCut[kCascCutMinEtaTracks][lpos] < lCand.fNegEta && lCand.fNegEta < fCascCut[kCascCutMaxEtaTracks][lpos] &&
+    fCascCut[kCascCutMinEtaTracks][lpos] < lCand.fBachEta && lCand.fBachEta < fCascCut[kCascCutMaxEtaTracks][lpos] &&
+    lRap > fCascCut[kCascCutMinRapidity][lpos] &&
+    lRap < fCascCut[kCascCutMaxRapidity][lpos] &&
+
+    //Check 3: Topological Variables
+    // - V0 Selections
+    lCand.fDCANegToPrimVtx > fCascCut[kCascCutDCANegToPV][lpos] &&
+    lCand.fDCAPosToPrimVtx > fCascCut[kCascCutDCAPosToPV][lpos] &&
+    lCand.fDCAV0Daughters < fCascCut[kCascCutDCAV0Daughters][lpos] &&
+    lCand.fV0CosPointingAngle > lV0CosPACut &&
+    lCand.fV0Radius > fCascCut[kCascCutV0Radius][lpos] &&
+    // - Cascade Selections
+    lCand.fDCAV0ToPrimVtx > fCascCut[kCascCutDCAV0ToPV][lpos] &&
+    TMath::Abs(lV0Mass-1.116) < fCascCut[kCascCutV0Mass][lpos] &&
+    lCand.fDCABachToPrimVtx > fCascCut[kCascCutDCABachToPV][lpos] &&
+    lPassDCACascDau &&
+    lCand.fCascCosPointingAngle > lCascCosPACut &&
+    lCand.fCascRadius > fCascCut[kCascCutCascRadius][lpos] &&
+
+    // - Implementation of a parametric V0 Mass cut if requested
+    (
+     ( fCascCut[kCascCutV0MassSigma][lpos] > 50 ) || //anything goes
+     (TMath::Abs( (lV0Mass-lCand.fExpV0Mass) / lCand.fExpV0Sigma ) < fCascCut[kCascCutV0MassSigma][lpos] )
+     ) &&
+
+    // - Miscellaneous
+    lCand.fDistOverTotMom*lPDGMass < fCascCut[kCascCutProperLifetime][lpos] &&
+    lCand.fLeastNbrClusters > fCascCut[kCascCutLeastNumberOfClusters][lpos] &&
+
+    //Check 4: TPC dEdx selections
+    TMath::Abs(lNegdEdx )<fCascCut[kCascCutTPCdEdx][lpos] &&
+    TMath::Abs(lPosdEdx )<fCascCut[kCascCutTPCdEdx][lpos] &&
+    TMath::Abs(lBachdEdx)<fCascCut[kCascCutTPCdEdx][lpos] &&
+
+    //Check 4bis: TOF selections (experimental)
+    TMath::Abs(lNegTOFsigma )< 4 &&
+    TMath::Abs(lPosTOFsigma )< 4 &&
+    TMath::Abs(lBachTOFsigma)< 4 &&
+
+    //Check 5: Xi rejection for Omega analysis
+    ( ( lHypo != AliCascadeResult::kOmegaMinus && lHypo != AliCascadeResult::kOmegaPlus  ) || ( TMath::Abs( lCand.fMassAsXi - 1.32171 ) > fCascCut[kCascCutXiRejection][lpos] ) ) &&
+
+    //Check 6: Experimental DCA Bachelor to Baryon cut
+    ( lCand.fDCABachToBaryon > fCascCut[kCascCutDCABachToBaryon][lpos] ) &&
+
+    //Check 7: Experimental Bach Baryon CosPA
+    ( lCand.fWrongCosPA < lBBCosPACut  ) &&
+
+    //Check 8: Min/Max V0 Lifetime cut
+    ( ( lCand.fV0Lifetime > fCascCut[kCascCutMinV0Lifetime][lpos] ) &&
+     ( lCand.fV0Lifetime < fCascCut[kCascCutMaxV0Lifetime][lpos] ||
+      fCascCut[kCascCutMaxV0Lifetime][lpos] > 1e+3 ) ) &&
+
+    //Check 9: kITSrefit track selection if requested
+    (
+     ( (lCand.fPosTrackStatus & AliESDtrack::kITSrefit) &&
+      (lCand.fNegTrackStatus & AliESDtrack::kITSrefit) &&
+      (lCand.fBachTrackStatus & AliESDtrack::kITSrefit)
+      )
+     ||
+     !(lFlags & kFlagITSRefitTracks)
+     ) &&
+
+    //Check 10: Max Chi2/Clusters if not absurd
+    ( fCascCut[kCascCutMaxChi2PerCluster][lpos]>1e+3 ||
+     lCand.fMaxChi2PerCluster < fCascCut[kCascCutMaxChi2PerCluster][lpos]
+     )&&
+
+    //Check 11: Min Track Length if positive
+    ( fCascCut[kCascCutMinTrackLength][lpos]<0 ||
+     lCand.fMinTrackLength > fCascCut[kCascCutMinTrackLength][lpos]
+     )&&
+
+    //Check 12: Check if special V0 CosPA cut used
+    ( !(lFlags & kFlagUse276TeVV0CosPA) ||
+     lCand.fV0CosPointingAngle>lCand.f276TeVV0CosPA
+     )&&
+
+    //Check 13: 3D Cascade DCA to PV
+    ( !(fOptions & kCascDCACascadeToPV) || fCascCut[kCascCutDCACascadeToPV][lpos] > 999 ||
+     (TMath::Sqrt(lCand.fCascDCAtoPVz*lCand.fCascDCAtoPVz + lCand.fCascDCAtoPVxy*lCand.fCascDCAtoPVxy)<fCascCut[kCascCutDCACascadeToPV][lpos] )
+     )&&
+
+    //Check 14: daughter track DCAs to PV, weighted
+    ( !(fOptions & kCascWeightedDCAToPV) ||
+     (
+      ( fCascCut[kCascCutDCANegToPVWeighted][lpos] < 0 ||
+       (lCand.fDCANegToPrimVtx/TMath::Sqrt(lCand.fNegDCAPVSigmaX2*lCand.fNegDCAPVSigmaX2 + lCand.fNegDCAPVSigmaY2*lCand.fNegDCAPVSigmaY2+1e-6)>fCascCut[kCascCutDCANegToPVWeighted][lpos] )
+       )&&
+      ( fCascCut[kCascCutDCAPosToPVWeighted][lpos] < 0 ||
+       (lCand.fDCAPosToPrimVtx/TMath::Sqrt(lCand.fPosDCAPVSigmaX2*lCand.fPosDCAPVSigmaX2 + lCand.fPosDCAPVSigmaY2*lCand.fPosDCAPVSigmaY2+1e-6)>fCascCut[kCascCutDCAPosToPVWeighted][lpos] )
+       )&&
+      ( fCascCut[kCascCutDCABachToPVWeighted][lpos] < 0 ||
+       (lCand.fDCABachToPrimVtx/TMath::Sqrt(lCand.fBachDCAPVSigmaX2*lCand.fBachDCAPVSigmaX2 + lCand.fBachDCAPVSigmaY2*lCand.fBachDCAPVSigmaY2+1e-6)>fCascCut[kCascCutDCABachToPVWeighted][lpos] )
+       )
+      )
+     );
+}
+
+//________________________________________________________________
+void AliWeakResultSelector::SelectCascadeCandidates()
+{
+    //Candidates passing each configuration: loosest cuts of the mass
+    //hypothesis first, then the configurations over the survivors only
+    Int_t lNCand = fCascCandidates.size();
+    for(UInt_t lcfg=0; lcfg<fCascSelected.size(); lcfg++) fCascSelected[lcfg].clear();
+    fCascBinYZ.assign(fGroupHisto.size()*lNCand, -1);
+    if( !lNCand ) return;
+
+    fCascPt.resize(lNCand);
+    for(Int_t lcand=0; lcand<lNCand; lcand++) fCascPt[lcand] = fCascCandidates[lcand].fPt;
+    EvaluateVarCuts(fCascVarCosPAPars, kTRUE,  fCascPt, fCascVarCosPAValues);
+    EvaluateVarCuts(fCascVarDCAPars,   kFALSE, fCascPt, fCascVarDCAValues);
+
+    for(Int_t lHypo=0; lHypo<kNCascHypo; lHypo++){
+        Int_t lFirst = fCascHypoStart[lHypo];
+        Int_t lLast  = fCascHypoStart[lHypo+1];
+        if( lFirst == lLast ) continue;
+        fSurvivors.clear();
+        for(Int_t lcand=0; lcand<lNCand; lcand++)
+            if( PassCascadeLoosest(lHypo, fCascCandidates[lcand]) ) fSurvivors.push_back(lcand);
+        Int_t lNSurvivors = fSurvivors.size();
+        fNPairsRejectedEarly += (Long64_t)(lNCand-lNSurvivors)*(lLast-lFirst);
+        fNPairsEvaluated     += (Long64_t)lNSurvivors*(lLast-lFirst);
+        for(Int_t lpos=lFirst; lpos<lLast; lpos++){
+            std::vector<Int_t> &lSelected = fCascSelected[fCascConfig[lpos]];
+            for(Int_t is=0; is<lNSurvivors; is++){
+                Int_t lcand = fSurvivors[is];
+                if( PassCascade(lpos, fCascCandidates[lcand], lcand) ) lSelected.push_back(lcand);
+            }
+        }
+    }
+}
+
+//________________________________________________________________
+Float_t AliWeakResultSelector::GetV0Mass(Int_t lcfg, Int_t lcand) const
+{
+    //Invariant mass of the candidate in the hypothesis of the configuration
+    const V0Candidate &lCand = fV0Candidates[lcand];
+    Int_t lHypo = fV0Hypo[fV0Position[lcfg]];
+    if( lHypo == AliV0Result::kK0Short ) return lCand.fInvMassK0s;
+    if( lHypo == AliV0Result::kLambda  ) return lCand.fInvMassLambda;
+    return lCand.fInvMassAntiLambda;
+}
+
+//________________________________________________________________
+Float_t AliWeakResultSelector::GetCascadeMass(Int_t lcfg, Int_t lcand) const
+{
+    //Invariant mass of the candidate in the hypothesis of the configuration
+    const CascadeCandidate &lCand = fCascCandidates[lcand];
+    Int_t lHypo = fCascHypo[fCascPosition[lcfg]];
+    if( lHypo == AliCascadeResult::kXiMinus || lHypo == AliCascadeResult::kXiPlus ) return lCand.fMassAsXi;
+    return lCand.fMassAsOmega;
+}
+
+//________________________________________________________________
+void AliWeakResultSelector::FillHistogram(Int_t lslot, TH3F *lHisto, Int_t lGroup, Int_t *lBinYZ,
+                                          Double_t lCentrality, Double_t lPt, Double_t lMass)
+{
+    //Equivalent of lHisto->Fill(lCentrality, lPt, lMass). The bin is built
+    //from the cached centrality bin of the binning group and, if lBinYZ is
+    //given, the cached (pt, mass) bin code of the candidate: 2*offset+inrange.
+    //Statistics and entries are accumulated and set in FlushHistograms
+    if( lGroup < 0 ){
+        lHisto->Fill(lCentrality, lPt, lMass);
+        return;
+    }
+    TH3F *lRef = fGroupHisto[lGroup];
+    if( fGroupXBin[lGroup] < 0 || fGroupCentrality[lGroup] != lCentrality ){
+        fGroupXBin[lGroup]       = lRef->GetXaxis()->FindBin(lCentrality);
+        fGroupCentrality[lGroup] = lCentrality;
+    }
+    Int_t lBinX = fGroupXBin[lGroup];
+    Int_t lCode = lBinYZ ? *lBinYZ : -1;
+    if( lCode < 0 ){
+        Int_t lBinY = lRef->GetYaxis()->FindBin(lPt);
+        Int_t lBinZ = lRef->GetZaxis()->FindBin(lMass);
+        Int_t lNx = lRef->GetXaxis()->GetNbins()+2;
+        Int_t lNy = lRef->GetYaxis()->GetNbins()+2;
+        Bool_t lInRange = lBinY > 0 && lBinY < lNy-1 && lBinZ > 0 && lBinZ <= lRef->GetZaxis()->GetNbins();
+        lCode = 2*lNx*(lBinY + lNy*lBinZ) + (lInRange ? 1 : 0);
+        if( lBinYZ ) *lBinYZ = lCode;
+    }
+    Int_t lBin = lBinX + lCode/2;
+    Bool_t lInRange = ( lCode & 1 ) && lBinX > 0 && lBinX <= lRef->GetXaxis()->GetNbins();
+
+    Int_t &lSlot = fHistoSlot[lslot];
+    if( lSlot < 0 ){
+        lSlot = fStatsHisto.size();
+        fStatsHisto.push_back(lHisto);
+        fStatsLoaded.push_back(0);
+        fStatsEntries.push_back(0);
+        fStats.resize(fStats.size()+11, 0.);
+    }
+    Bool_t lUpdateStats = lInRange || TH1::GetStatOverflows();
+    //statistics of the previous events, before the bin contents change
+    if( lUpdateStats && !fStatsLoaded[lSlot] ){
+        lHisto->GetStats(&fStats[11*lSlot]);
+        fStatsLoaded[lSlot] = 1;
+    }
+    lHisto->AddBinContent(lBin);
+    if( lHisto->GetSumw2N() ) lHisto->GetSumw2()->fArray[lBin] += 1;
+    fStatsEntries[lSlot]++;
+    if( !lUpdateStats ) return;
+    Double_t *lStats = &fStats[11*lSlot];
+    lStats[0]  += 1;
+    lStats[1]  += 1;
+    lStats[2]  += lCentrality;
+    lStats[3]  += lCentrality*lCentrality;
+    lStats[4]  += lPt;
+    lStats[5]  += lPt*lPt;
+    lStats[6]  += lCentrality*lPt;
+    lStats[7]  += lMass;
+    lStats[8]  += lMass*lMass;
+    lStats[9]  += lCentrality*lMass;
+    lStats[10] += lPt*lMass;
+}
+
+//________________________________________________________________
+void AliWeakResultSelector::FillV0Histogram(Int_t lcfg, Int_t lcand, Double_t lCentrality)
+{
+    Int_t lpos   = fV0Position[lcfg];
+    Int_t lGroup = fV0BinningGroup[lpos];
+    Int_t *lBinYZ = lGroup >= 0 ? &fV0BinYZ[lGroup*fV0Candidates.size()+lcand] : 0x0;
+    FillHistogram(lcfg, GetV0Result(lcfg)->GetHistogram(), lGroup, lBinYZ,
+                  lCentrality, fV0Candidates[lcand].fPt, GetV0Mass(lcfg, lcand));
+}
+
+//________________________________________________________________
+void AliWeakResultSelector::FillV0Histogram(Int_t lcfg, Int_t lcand, Double_t lCentrality, Double_t lPt)
+{
+    FillHistogram(lcfg, GetV0Result(lcfg)->GetHistogram(), fV0BinningGroup[fV0Position[lcfg]], 0x0,
+                  lCentrality, lPt, GetV0Mass(lcfg, lcand));
+}
+
+//________________________________________________________________
+void AliWeakResultSelector::FillCascadeHistogram(Int_t lcfg, Int_t lcand, Double_t lCentrality)
+{
+    Int_t lpos   = fCascPosition[lcfg];
+    Int_t lGroup = fCascBinningGroup[lpos];
+    Int_t *lBinYZ = lGroup >= 0 ? &fCascBinYZ[lGroup*fCascCandidates.size()+lcand] : 0x0;
+    FillHistogram(fNV0Configs+lcfg, GetCascadeResult(lcfg)->GetHistogram(), lGroup, lBinYZ,
+                  lCentrality, fCascCandidates[lcand].fPt, GetCascadeMass(lcfg, lcand));
+}
+
+//________________________________________________________________
+void AliWeakResultSelector::FillCascadeHistogram(Int_t lcfg, Int_t lcand, Double_t lCentrality, Double_t lPt)
+{
+    FillHistogram(fNV0Configs+lcfg, GetCascadeResult(lcfg)->GetHistogram(), fCascBinningGroup[fCascPosition[lcfg]], 0x0,
+                  lCentrality, lPt, GetCascadeMass(lcfg, lcand));
+}
+
+//________________________________________________________________
+void AliWeakResultSelector::FillV0Histograms(Double_t lCentrality)
+{
+    //Fill all the selected V0 candidates with their reconstructed pt
+    for(Int_t lcfg=0; lcfg<fNV0Configs; lcfg++){
+        const std::vector<Int_t> &lSelected = fV0Selected[lcfg];
+        for(UInt_t is=0; is<lSelected.size(); is++) FillV0Histogram(lcfg, lSelected[is], lCentrality);
+    }
+}
+
+//________________________________________________________________
+void AliWeakResultSelector::FillCascadeHistograms(Double_t lCentrality)
+{
+    //Fill all the selected cascade candidates with their reconstructed pt
+    for(Int_t lcfg=0; lcfg<fNCascConfigs; lcfg++){
+        const std::vector<Int_t> &lSelected = fCascSelected[lcfg];
+        for(UInt_t is=0; is<lSelected.size(); is++) FillCascadeHistogram(lcfg, lSelected[is], lCentrality);
+    }
+}
+
+//________________________________________________________________
+void AliWeakResultSelector::FlushHistograms()
+{
+    //Set the statistics and entries of the histograms filled since the last
+    //flush. To be called at the end of each event, before the output is used
+    for(UInt_t lSlot=0; lSlot<fStatsHisto.size(); lSlot++){
+        TH3F *lHisto = fStatsHisto[lSlot];
+        if( fStatsLoaded[lSlot] ) lHisto->PutStats(&fStats[11*lSlot]);
+        lHisto->SetEntries(lHisto->GetEntries()+fStatsEntries[lSlot]);
+    }
+    fStatsHisto.clear();
+    fStats.clear();
+    fStatsLoaded.clear();
+    fStatsEntries.clear();
+    fHistoSlot.assign(fNV0Configs+fNCascConfigs, -1);
+}
@@ -0,0 +1,328 @@
+#ifndef AliWeakResultSelector_H
+#define AliWeakResultSelector_H
+#include <vector>
+#include <TObject.h>
+#include <TList.h>
+#include <TH3F.h>
+
+class AliV0Result;
+class AliCascadeResult;
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// Batched selection of the V0 and cascade candidates of an event
+// with all the AliV0Result / AliCascadeResult configurations of a task
+//
+// The cuts of the configurations are copied once into arrays (one
+// array per cut, one entry per configuration) ordered by mass
+// hypothesis. The candidates of the event are buffered and, for each
+// mass hypothesis, first checked against the loosest cuts of all the
+// configurations of that hypothesis; only the surviving candidates
+// are checked against each configuration. Variable (pt-dependent) cuts
+// are evaluated once per candidate and distinct parametrization.
+// Histograms are filled with bin indices computed once per candidate
+// and histogram binning.
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+class AliWeakResultSelector : public TObject {
+
+public:
+    //Checks which are not applied by all the tasks using this class
+    enum ESelectionOption {
+        kV0MaxRadius             = BIT(0), //maximum V0 radius
+        kV0276TeVLikedEdx        = BIT(1), //2.76TeV-like baryon dE/dx
+        kV0MCRapidity            = BIT(2), //MC rapidity for configurations using MC properties
+        kCascSwapBachelorCharge  = BIT(3), //bachelor charge swap of the configuration
+        kCascTOF                 = BIT(4), //TOF n-sigma, if requested by the configuration
+        kCascVarDCACascDau       = BIT(5), //variable DCA cascade daughters
+        kCascDCACascadeToPV      = BIT(6), //3D cascade DCA to PV
+        kCascWeightedDCAToPV     = BIT(7), //daughter DCA to PV weighted by its uncertainty
+        kCascMCRapidity          = BIT(8)  //MC rapidity for configurations using MC properties
+    };
+
+    //V0 candidate, as computed in the V0 loop of the tasks
+    struct V0Candidate {
+        Int_t     fOnFlyStatus;
+        Float_t   fPt;
+        Float_t   fNegEta;
+        Float_t   fPosEta;
+        Float_t   fRapK0Short;
+        Float_t   fRapLambda;
+        Float_t   fInvMassK0s;
+        Float_t   fInvMassLambda;
+        Float_t   fInvMassAntiLambda;
+        Float_t   fV0Radius;
+        Float_t   fDcaNegToPrimVertex;
+        Float_t   fDcaPosToPrimVertex;
+        Float_t   fDcaV0Daughters;
+        Float_t   fV0CosineOfPointingAngle;
+        Float_t   fDistOverTotMom;
+        Int_t     fLeastNbrCrossedRows;
+        Float_t   fLeastRatioCrossedRowsOverFindable;
+        Float_t   fPosInnerP;
+        Float_t   fNegInnerP;
+        Float_t   fPosInnerPt;
+        Float_t   fNegInnerPt;
+        Float_t   fNSigmasPosProton;
+        Float_t   fNSigmasPosPion;
+        Float_t   fNSigmasNegProton;
+        Float_t   fNSigmasNegPion;
+        Float_t   fPtArmV0;
+        Float_t   fAlphaV0;
+        ULong64_t fNegTrackStatus;
+        ULong64_t fPosTrackStatus;
+        Float_t   fMaxChi2PerCluster;
+        Float_t   fMinTrackLength;
+        //MC information (MC tasks only)
+        Float_t   fRapMC;
+        Float_t   fPtMC;
+        Float_t   fPtMother;
+        Int_t     fPID;
+        Int_t     fPIDMother;
+        Int_t     fPrimaryStatus;
+        Int_t     fPrimaryStatusMother;
+        Float_t   fMCTransvMomPos;
+        Float_t   fMCTransvMomNeg;
+    };
+
+    //Cascade candidate, as computed in the cascade loop of the tasks
+    struct CascadeCandidate {
+        Int_t     fCharge;
+        Float_t   fPt;
+        Float_t   fMassAsXi;
+        Float_t   fMassAsOmega;
+        Float_t   fRapXi;
+        Float_t   fRapOmega;
+        Float_t   fNegEta;
+        Float_t   fPosEta;
+        Float_t   fBachEta;
+        Float_t   fDCANegToPrimVtx;
+        Float_t   fDCAPosToPrimVtx;
+        Float_t   fDCAV0Daughters;
+        Float_t   fV0CosPointingAngle;
+        Float_t   fV0Radius;
+        Float_t   fDCAV0ToPrimVtx;
+        Float_t   fV0MassLambda;     //V0 mass for XiMinus/OmegaMinus
+        Float_t   fV0MassAntiLambda; //V0 mass for XiPlus/OmegaPlus
+        Float_t   fExpV0Mass;        //parametric V0 mass mean at the V0 pt
+        Float_t   fExpV0Sigma;       //parametric V0 mass sigma at the V0 pt
+        Float_t   f276TeVV0CosPA;    //2.76TeV-like V0 CosPA cut at the V0 momentum
+        Float_t   fDCABachToPrimVtx;
+        Float_t   fDCACascDaughters;
+        Float_t   fCascCosPointingAngle;
+        Float_t   fCascRadius;
+        Float_t   fCascDCAtoPVxy;
+        Float_t   fCascDCAtoPVz;
+        Float_t   fDistOverTotMom;
+        Int_t     fLeastNbrClusters;
+        Float_t   fNegNSigmaPion;
+        Float_t   fNegNSigmaProton;
+        Float_t   fPosNSigmaPion;
+        Float_t   fPosNSigmaProton;
+        Float_t   fBachNSigmaPion;
+        Float_t   fBachNSigmaKaon;
+        Float_t   fNegTOFNSigmaPion;
+        Float_t   fNegTOFNSigmaProton;
+        Float_t   fPosTOFNSigmaPion;
+        Float_t   fPosTOFNSigmaProton;
+        Float_t   fBachTOFNSigmaPion;
+        Float_t   fBachTOFNSigmaKaon;
+        Float_t   fDCABachToBaryon;
+        Float_t   fWrongCosPA;
+        Float_t   fV0Lifetime;
+        ULong64_t fNegTrackStatus;
+        ULong64_t fPosTrackStatus;
+        ULong64_t fBachTrackStatus;
+        Float_t   fMaxChi2PerCluster;
+        Float_t   fMinTrackLength;
+        Float_t   fNegDCAPVSigmaX2;
+        Float_t   fNegDCAPVSigmaY2;
+        Float_t   fPosDCAPVSigmaX2;
+        Float_t   fPosDCAPVSigmaY2;
+        Float_t   fBachDCAPVSigmaX2;
+        Float_t   fBachDCAPVSigmaY2;
+        //MC information (MC tasks only)
+        Float_t   fRapMC;
+        Float_t   fPtMC;
+        Int_t     fPID;
+        Int_t     fIsPhysicalPrimary;
+        Int_t     fPosLabelMother;
+        Int_t     fNegLabelMother;
+        Int_t     fBachLabelMother;
+        Int_t     fPIDBachelorMother;
+        Float_t   fPosTransvMomentumMC;
+        Float_t   fNegTransvMomentumMC;
+    };
+
+    AliWeakResultSelector();
+    AliWeakResultSelector(UInt_t lOptions);
+    ~AliWeakResultSelector();
+
+    void   SetOptions(UInt_t lOptions) { fOptions = lOptions; }
+    UInt_t GetOptions() const          { return fOptions;     }
+
+    //Configurations
+    void   Compile(TList *lListV0, TList *lListCascade);
+    Bool_t IsCompiled(TList *lListV0, TList *lListCascade) const;
+
+    Int_t             GetNV0Configurations     () const { return fNV0Configs;   }
+    Int_t             GetNCascadeConfigurations() const { return fNCascConfigs; }
+    AliV0Result      *GetV0Result     (Int_t lcfg) const;
+    AliCascadeResult *GetCascadeResult(Int_t lcfg) const;
+
+    //Candidates of the event
+    void   ClearV0Candidates();
+    void   ClearCascadeCandidates();
+    Int_t  AddV0Candidate     (const V0Candidate      &lCandidate);
+    Int_t  AddCascadeCandidate(const CascadeCandidate &lCandidate);
+    Int_t  GetNV0Candidates     () const { return fV0Candidates.size();   }
+    Int_t  GetNCascadeCandidates() const { return fCascCandidates.size(); }
+    const V0Candidate      &GetV0Candidate     (Int_t lcand) const { return fV0Candidates[lcand];   }
+    const CascadeCandidate &GetCascadeCandidate(Int_t lcand) const { return fCascCandidates[lcand]; }
+
+    //Selection: candidates passing each configuration, in candidate order
+    void   SelectV0Candidates();
+    void   SelectCascadeCandidates();
+    Int_t  GetNSelectedV0     (Int_t lcfg) const { return fV0Selected[lcfg].size();   }
+    Int_t  GetNSelectedCascade(Int_t lcfg) const { return fCascSelected[lcfg].size(); }
+    Int_t  GetSelectedV0      (Int_t lcfg, Int_t i) const { return fV0Selected[lcfg][i];   }
+    Int_t  GetSelectedCascade (Int_t lcfg, Int_t i) const { return fCascSelected[lcfg][i]; }
+
+    Float_t GetV0Mass     (Int_t lcfg, Int_t lcand) const;
+    Float_t GetCascadeMass(Int_t lcfg, Int_t lcand) const;
+
+    //Filling of (centrality, pt, mass) of the configuration histogram,
+    //with the candidate pt or with another pt (e.g. MC pt)
+    void   FillV0Histogram     (Int_t lcfg, Int_t lcand, Double_t lCentrality);
+    void   FillCascadeHistogram(Int_t lcfg, Int_t lcand, Double_t lCentrality);
+    void   FillV0Histogram     (Int_t lcfg, Int_t lcand, Double_t lCentrality, Double_t lPt);
+    void   FillCascadeHistogram(Int_t lcfg, Int_t lcand, Double_t lCentrality, Double_t lPt);
+    void   FillV0Histograms     (Double_t lCentrality);
+    void   FillCascadeHistograms(Double_t lCentrality);
+    void   FlushHistograms();
+
+    //Counters
+    Long64_t GetNPairsRejectedEarly() const { return fNPairsRejectedEarly; }
+    Long64_t GetNPairsEvaluated    () const { return fNPairsEvaluated;     }
+
+private:
+    //V0 cuts, one array per cut
+    enum EV0Cut {
+        kV0CutMinEtaTracks = 0, kV0CutMaxEtaTracks, kV0CutMinRapidity, kV0CutMaxRapidity,
+        kV0CutV0Radius, kV0CutMaxV0Radius, kV0CutDCANegToPV, kV0CutDCAPosToPV,
+        kV0CutDCAV0Daughters, kV0CutV0CosPA, kV0CutProperLifetime,
+        kV0CutLeastNumberOfCrossedRows, kV0CutLeastNumberOfCrossedRowsOverFindable,
+        kV0CutMinBaryonMomentum, kV0CutTPCdEdx, kV0CutArmenterosParameter,
+        kV0CutMaxChi2PerCluster, kV0CutMinTrackLength,
+        kNV0Cuts
+    };
+    //Cascade cuts, one array per cut
+    enum ECascadeCut {
+        kCascCutMinEtaTracks = 0, kCascCutMaxEtaTracks, kCascCutMinRapidity, kCascCutMaxRapidity,
+        kCascCutDCANegToPV, kCascCutDCAPosToPV, kCascCutDCAV0Daughters, kCascCutV0CosPA,
+        kCascCutV0Radius, kCascCutDCAV0ToPV, kCascCutV0Mass, kCascCutDCABachToPV,
+        kCascCutDCACascDaughters, kCascCutCascCosPA, kCascCutCascRadius, kCascCutV0MassSigma,
+        kCascCutProperLifetime, kCascCutLeastNumberOfClusters, kCascCutTPCdEdx,
+        kCascCutXiRejection, kCascCutDCABachToBaryon, kCascCutBachBaryonCosPA,
+        kCascCutMinV0Lifetime, kCascCutMaxV0Lifetime, kCascCutMaxChi2PerCluster,
+        kCascCutMinTrackLength, kCascCutDCACascadeToPV, kCascCutDCANegToPVWeighted,
+        kCascCutDCAPosToPVWeighted, kCascCutDCABachToPVWeighted,
+        kNCascCuts
+    };
+    //Switches of a configuration
+    enum EConfigFlag {
+        kFlagOnTheFly          = BIT(0),
+        kFlagArmenteros        = BIT(1),
+        kFlagITSRefitTracks    = BIT(2),
+        kFlag276TeVLikedEdx    = BIT(3),
+        kFlagMCUseMCProperties = BIT(4),
+        kFlagUse276TeVV0CosPA  = BIT(5),
+        kFlagUseTOFUnchecked   = BIT(6)
+    };
+
+    static const Int_t kNV0Hypo   = 3;
+    static const Int_t kNCascHypo = 4;
+
+    Int_t  AddVarCutParameters(std::vector<Float_t> &lPars, Float_t p0, Float_t p1, Float_t p2, Float_t p3, Float_t p4);
+    void   EvaluateVarCuts(const std::vector<Float_t> &lPars, Bool_t lCosine, const std::vector<Float_t> &lPt, std::vector<Float_t> &lValues) const;
+    Int_t  FindBinningGroup(TH3F *lHisto, Int_t lHypo);
+    Bool_t PassV0Loosest     (Int_t lHypo, const V0Candidate      &lCand) const;
+    Bool_t PassCascadeLoosest(Int_t lHypo, const CascadeCandidate &lCand) const;
+    Bool_t PassV0     (Int_t lpos, const V0Candidate      &lCand, Int_t lcand) const;
+    Bool_t PassCascade(Int_t lpos, const CascadeCandidate &lCand, Int_t lcand) const;
+    void   FillHistogram(Int_t lslot, TH3F *lHisto, Int_t lGroup, Int_t *lBinYZ,
+                         Double_t lCentrality, Double_t lPt, Double_t lMass);
+
+    UInt_t fOptions; //ESelectionOption bits
+
+    //V0 configurations, ordered by mass hypothesis
+    TList *fListV0;                               //! compiled list, not owned
+    Int_t  fNV0Configs;                           //! number of configurations
+    std::vector<Int_t>    fV0Position;            //! position of each configuration (list order) in the arrays
+    std::vector<Int_t>    fV0Config;              //! configuration of each position
+    std::vector<Int_t>    fV0Hypo;                //! mass hypothesis of each position
+    std::vector<UInt_t>   fV0Flags;               //! EConfigFlag bits of each position
+    std::vector<Double_t> fV0Cut[kNV0Cuts];       //! cut values of each position
+    std::vector<Int_t>    fV0VarCosPA;            //! variable V0 CosPA parameter set of each position, -1 if not used
+    std::vector<Int_t>    fV0BinningGroup;        //! histogram binning group of each position
+    Int_t                 fV0HypoStart[kNV0Hypo+1];   //! first position of each mass hypothesis
+    Double_t              fV0Loosest[kNV0Hypo][kNV0Cuts]; //! loosest cuts of each mass hypothesis
+    Int_t                 fV0OnFly[kNV0Hypo];     //! on-the-fly status common to the hypothesis, -1 if mixed
+    Bool_t                fV0LoosestRap[kNV0Hypo];//! rapidity can be checked with the loosest cuts
+    std::vector<Float_t>  fV0VarPars;             //! distinct variable CosPA parametrizations (5 per set)
+
+    //Cascade configurations, ordered by mass hypothesis
+    TList *fListCascade;                          //! compiled list, not owned
+    Int_t  fNCascConfigs;                         //! number of configurations
+    std::vector<Int_t>    fCascPosition;          //! position of each configuration (list order) in the arrays
+    std::vector<Int_t>    fCascConfig;            //! configuration of each position
+    std::vector<Int_t>    fCascHypo;              //! mass hypothesis of each position
+    std::vector<Int_t>    fCascCharge;            //! expected cascade charge of each position
+    std::vector<UInt_t>   fCascFlags;             //! EConfigFlag bits of each position
+    std::vector<Double_t> fCascCut[kNCascCuts];   //! cut values of each position
+    std::vector<Int_t>    fCascVarCascCosPA;      //! variable cut parameter sets of each position, -1 if not used
+    std::vector<Int_t>    fCascVarV0CosPA;        //!
+    std::vector<Int_t>    fCascVarBBCosPA;        //!
+    std::vector<Int_t>    fCascVarDCACascDau;     //!
+    std::vector<Int_t>    fCascBinningGroup;      //! histogram binning group of each position
+    Int_t                 fCascHypoStart[kNCascHypo+1];       //! first position of each mass hypothesis
+    Double_t              fCascLoosest[kNCascHypo][kNCascCuts]; //! loosest cuts of each mass hypothesis
+    Int_t                 fCascLoosestCharge[kNCascHypo];     //! charge common to the hypothesis, 0 if mixed
+    Bool_t                fCascLoosestRap[kNCascHypo];        //! rapidity can be checked with the loosest cuts
+    std::vector<Float_t>  fCascVarCosPAPars;      //! distinct variable CosPA parametrizations (5 per set)
+    std::vector<Float_t>  fCascVarDCAPars;        //! distinct variable DCA parametrizations (5 per set)
+
+    //Candidates of the event
+    std::vector<V0Candidate>      fV0Candidates;    //!
+    std::vector<CascadeCandidate> fCascCandidates;  //!
+    std::vector<Float_t>          fV0Pt;            //! pt of the V0 candidates
+    std::vector<Float_t>          fCascPt;          //! pt of the cascade candidates
+    std::vector<Float_t>          fV0VarValues;     //! variable cuts per parameter set and V0 candidate
+    std::vector<Float_t>          fCascVarCosPAValues; //! variable cuts per parameter set and cascade candidate
+    std::vector<Float_t>          fCascVarDCAValues;   //!
+    std::vector<Int_t>            fSurvivors;       //! candidates passing the loosest cuts
+    std::vector< std::vector<Int_t> > fV0Selected;  //! selected V0 candidates of each configuration
+    std::vector< std::vector<Int_t> > fCascSelected;//! selected cascade candidates of each configuration
+
+    //Histogram filling
+    std::vector<TH3F*>    fGroupHisto;            //! first histogram of each binning group
+    std::vector<Int_t>    fGroupHypo;             //! mass hypothesis (V0: 0-2, cascade: 10-13) of each binning group
+    std::vector<Double_t> fGroupCentrality;       //! centrality of the cached x bin of each group
+    std::vector<Int_t>    fGroupXBin;             //! cached x bin of each group
+    std::vector<Int_t>    fV0BinYZ;               //! (pt,mass) bin code per binning group and V0 candidate, -1 if not computed
+    std::vector<Int_t>    fCascBinYZ;             //! (pt,mass) bin code per binning group and cascade candidate
+    std::vector<TH3F*>    fStatsHisto;            //! histograms filled in this event (slots)
+    std::vector<Double_t> fStats;                 //! statistics of the histograms filled in this event (11 per slot)
+    std::vector<Char_t>   fStatsLoaded;           //! statistics of the slot taken from the histogram
+    std::vector<Long64_t> fStatsEntries;          //! fills of the histograms filled in this event
+    std::vector<Int_t>    fHistoSlot;             //! slot of each configuration (V0 then cascade), -1 if not filled yet
+
+    Long64_t fNPairsRejectedEarly; //! candidate-configuration pairs rejected by the loosest cuts
+    Long64_t fNPairsEvaluated;     //! candidate-configuration pairs checked against the configuration
+
+    AliWeakResultSelector(const AliWeakResultSelector&);            // not implemented
+    AliWeakResultSelector& operator=(const AliWeakResultSelector&); // not implemented
+
+    ClassDef(AliWeakResultSelector, 1)
+    // 1 - original implementation
+};
+#endif